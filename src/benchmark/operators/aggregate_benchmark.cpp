@@ -4,10 +4,14 @@
 #include "../micro_benchmark_basic_fixture.hpp"
 #include "benchmark/benchmark.h"
 #include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
 #include "operators/aggregate_hash.hpp"
 #include "operators/aggregate_sort.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/immediate_execution_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "synthetic_table_generator.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -147,4 +151,43 @@ BENCHMARK_F(MicroBenchmarkBasicFixture, BM_AggregateSortSortedMultipleGroupBy)(b
   }
 }
 
+static void BM_AggregateHashManyGroups(benchmark::State& state, const DataType groupby_data_type) {
+  // High-cardinality GROUP BY with about four rows per group, similar to TPC-H Q18's GROUP BY l_orderkey. Int keys are
+  // dense and use immediate keys, Long keys are aggregated using hash maps. The chunks are pre-aggregated and the
+  // partitions of the groups are merged in parallel.
+  const size_t row_count = state.range(0);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto column_specifications = std::vector<ColumnSpecification>{
+      ColumnSpecification(ColumnDataDistribution::make_uniform_config(0.0, static_cast<double>(row_count) / 4.0),
+                          groupby_data_type),
+      ColumnSpecification(ColumnDataDistribution::make_uniform_config(0.0, 1'000.0), DataType::Double)};
+  const auto table_wrapper =
+      std::make_shared<TableWrapper>(SyntheticTableGenerator::generate_table(column_specifications, row_count));
+  table_wrapper->execute();
+
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      sum_(pqp_column_(ColumnID{1}, DataType::Double, false, "b")),
+      max_(pqp_column_(ColumnID{1}, DataType::Double, false, "b"))};
+  const auto groupby = std::vector<ColumnID>{ColumnID{0}};
+
+  for (auto _ : state) {
+    auto aggregate = std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby);
+    aggregate->execute();
+  }
+
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+}
+
+static void BM_AggregateHashManyGroupsInt(benchmark::State& state) {
+  BM_AggregateHashManyGroups(state, DataType::Int);
+}
+
+static void BM_AggregateHashManyGroupsLong(benchmark::State& state) {
+  BM_AggregateHashManyGroups(state, DataType::Long);
+}
+
+BENCHMARK(BM_AggregateHashManyGroupsInt)->RangeMultiplier(10)->Range(100'000, 10'000'000);
+BENCHMARK(BM_AggregateHashManyGroupsLong)->RangeMultiplier(10)->Range(100'000, 10'000'000);
+
 }  // namespace opossum
@@ -0,0 +1,107 @@
+#include <memory>
+
+#include "benchmark/benchmark.h"
+
+#include "../micro_benchmark_basic_fixture.hpp"
+#include "expression/evaluation/expression_compiler.hpp"
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The ExpressionEvaluator materializes an ExpressionResult for each of the sub-expressions, while the compiled
+// expressions evaluate all sub-expressions for one block of 1'024 rows after the other.
+
+// (column_1 + column_2) * 2 > 10'000 AND column_1 < 5'000
+std::shared_ptr<AbstractExpression> create_predicate(const Table& table) {
+  const auto a = PQPColumnExpression::from_table(table, "column_1");
+  const auto b = PQPColumnExpression::from_table(table, "column_2");
+  return and_(greater_than_(mul_(add_(a, b), 2), 10'000), less_than_(a, 5'000));
+}
+
+// CASE WHEN column_1 > 5'000 THEN (column_1 + column_2) * 2 ELSE column_1 - column_2 END
+std::shared_ptr<AbstractExpression> create_projection(const Table& table) {
+  const auto a = PQPColumnExpression::from_table(table, "column_1");
+  const auto b = PQPColumnExpression::from_table(table, "column_2");
+  return case_(greater_than_(a, 5'000), mul_(add_(a, b), 2), sub_(a, b));
+}
+
+std::shared_ptr<const CompiledExpression> compile(const std::shared_ptr<AbstractExpression>& expression) {
+  const auto compiled_expression = ExpressionCompiler{}.compile(expression);
+  Assert(compiled_expression, "Expected the expression to be compilable");
+  return compiled_expression;
+}
+
+}  // namespace
+
+namespace opossum {
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_ExpressionEvaluator_Predicate)(benchmark::State& state) {
+  _clear_cache();
+
+  const auto table = _table_wrapper_a->get_output();
+  const auto predicate = create_predicate(*table);
+  const auto chunk_count = table->chunk_count();
+
+  for (auto _ : state) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      auto pos_list = ExpressionEvaluator{table, chunk_id}.evaluate_expression_to_pos_list(*predicate);
+      benchmark::DoNotOptimize(pos_list);
+    }
+  }
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_ExpressionCompiler_Predicate)(benchmark::State& state) {
+  _clear_cache();
+
+  const auto table = _table_wrapper_a->get_output();
+  const auto compiled_predicate = compile(create_predicate(*table));
+  const auto chunk_count = table->chunk_count();
+
+  for (auto _ : state) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      auto pos_list = compiled_predicate->evaluate_to_pos_list(*table, chunk_id);
+      benchmark::DoNotOptimize(pos_list);
+    }
+  }
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_ExpressionEvaluator_Projection)(benchmark::State& state) {
+  _clear_cache();
+
+  const auto table = _table_wrapper_a->get_output();
+  const auto projection = create_projection(*table);
+  const auto chunk_count = table->chunk_count();
+
+  for (auto _ : state) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      auto segment = ExpressionEvaluator{table, chunk_id}.evaluate_expression_to_segment(*projection);
+      benchmark::DoNotOptimize(segment);
+    }
+  }
+}
+
+BENCHMARK_F(MicroBenchmarkBasicFixture, BM_ExpressionCompiler_Projection)(benchmark::State& state) {
+  _clear_cache();
+
+  const auto table = _table_wrapper_a->get_output();
+  const auto compiled_projection = compile(create_projection(*table));
+  const auto chunk_count = table->chunk_count();
+
+  for (auto _ : state) {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      auto segment = compiled_projection->evaluate_to_segment(*table, chunk_id);
+      benchmark::DoNotOptimize(segment);
+    }
+  }
+}
+
+}  // namespace opossum
@@ -7,6 +7,7 @@
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "storage/chunk.hpp"
 #include "storage/index/adaptive_radix_tree/adaptive_radix_tree_index.hpp"
 #include "synthetic_table_generator.hpp"
@@ -99,6 +100,29 @@ void BM_Join_MediumAndMedium(benchmark::State& state) {  // NOLINT 100,000 x 100
   bm_join_impl<C>(state, table_wrapper_left, table_wrapper_right);
 }
 
+template <class C>
+void BM_Join_SkewedProbeSide(benchmark::State& state) {  // NOLINT 100,000 x 10,000,000
+  // Foreign keys often follow a Zipf-like distribution, e.g., a few products account for most of the sales. The
+  // Pareto-distributed probe side has a few heavy-hitter keys, so that a few radix partitions hold most of the rows.
+  // The workers of the scheduler should still be kept busy while probing these partitions.
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto chunk_size = static_cast<ChunkOffset>(TABLE_SIZE_BIG / NUMBER_OF_CHUNKS);
+  const auto probe_table = SyntheticTableGenerator::generate_table(
+      {ColumnSpecification(ColumnDataDistribution::make_pareto_config(), DataType::Int)}, TABLE_SIZE_BIG, chunk_size);
+  const auto build_table = SyntheticTableGenerator::generate_table(
+      {ColumnSpecification(ColumnDataDistribution::make_uniform_config(0.0, TABLE_SIZE_MEDIUM), DataType::Int)},
+      TABLE_SIZE_MEDIUM, chunk_size);
+
+  auto table_wrapper_left = std::make_shared<TableWrapper>(build_table);
+  auto table_wrapper_right = std::make_shared<TableWrapper>(probe_table);
+  table_wrapper_left->execute();
+  table_wrapper_right->execute();
+
+  // Resetting Hyrise at the end of bm_join_impl also restores the default scheduler
+  bm_join_impl<C>(state, table_wrapper_left, table_wrapper_right);
+}
+
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinNestedLoop);
 
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinIndex);
@@ -108,9 +132,11 @@ BENCHMARK_TEMPLATE(BM_Join_MediumAndMedium, JoinIndex);
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinHash);
 BENCHMARK_TEMPLATE(BM_Join_SmallAndBig, JoinHash);
 BENCHMARK_TEMPLATE(BM_Join_MediumAndMedium, JoinHash);
+BENCHMARK_TEMPLATE(BM_Join_SkewedProbeSide, JoinHash);
 
 BENCHMARK_TEMPLATE(BM_Join_SmallAndSmall, JoinSortMerge);
 BENCHMARK_TEMPLATE(BM_Join_SmallAndBig, JoinSortMerge);
 BENCHMARK_TEMPLATE(BM_Join_MediumAndMedium, JoinSortMerge);
+BENCHMARK_TEMPLATE(BM_Join_SkewedProbeSide, JoinSortMerge);
 
 }  // namespace opossum
@@ -7,6 +7,8 @@
 #include "operators/limit.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/immediate_execution_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_translator.hpp"
 #include "synthetic_table_generator.hpp"
@@ -89,11 +91,20 @@ static void BM_SortWithStrings(benchmark::State& state) {
   BM_Sort(state, row_count, DataType::String);
 }
 
+static void BM_SortMultiThreaded(benchmark::State& state) {
+  // The input is sorted chunk by chunk, and the chunks are merged in parallel
+  const size_t row_count = state.range(0);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+  BM_Sort(state, row_count, DataType::Int, 0.0f, true);
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+}
+
 BENCHMARK(BM_Sort)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortTwoColumns)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithNullValues)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithReferenceSegments)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithReferenceSegmentsTwoColumns)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithStrings)->RangeMultiplier(100)->Range(100, 1'000'000);
+BENCHMARK(BM_SortMultiThreaded)->RangeMultiplier(10)->Range(100'000, 10'000'000);
 
 }  // namespace opossum
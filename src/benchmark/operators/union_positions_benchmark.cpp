@@ -9,6 +9,7 @@
 #include "operators/union_positions.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
 #include "types.hpp"
 
 namespace {
@@ -110,6 +111,37 @@ void BM_UnionPositions(::benchmark::State& state) {  // NOLINT
 }
 BENCHMARK(BM_UnionPositions);
 
+/**
+ * Both inputs consist of a single column referencing the same table, as it is the case for OR predicates split into
+ * two TableScans. UnionPositions uses bitmaps instead of sorting here.
+ */
+void BM_UnionPositionsSingleReferencedTable(::benchmark::State& state) {  // NOLINT
+  const auto num_rows = 500000;
+  const auto referenced_table_chunk_size = static_cast<ChunkOffset>(static_cast<float>(num_rows) * 0.2f);
+
+  /**
+   * Unlike above, the bitmaps need to know the sizes of the referenced chunks, so the referenced table contains data
+   */
+  const auto column_definitions = TableColumnDefinitions{{"c0", DataType::Int, false}};
+  auto referenced_table = std::make_shared<Table>(column_definitions, TableType::Data, referenced_table_chunk_size);
+  for (auto chunk_id = ChunkID{0}; chunk_id < REFERENCED_TABLE_CHUNK_COUNT; ++chunk_id) {
+    const auto value_segment =
+        std::make_shared<ValueSegment<int32_t>>(pmr_vector<int32_t>(referenced_table_chunk_size, 0));
+    referenced_table->append_chunk({value_segment});
+  }
+
+  auto table_wrapper_left = std::make_shared<TableWrapper>(create_reference_table(referenced_table, num_rows, 1));
+  table_wrapper_left->execute();
+  auto table_wrapper_right = std::make_shared<TableWrapper>(create_reference_table(referenced_table, num_rows, 1));
+  table_wrapper_right->execute();
+
+  for (auto _ : state) {
+    auto set_union = std::make_shared<UnionPositions>(table_wrapper_left, table_wrapper_right);
+    set_union->execute();
+  }
+}
+BENCHMARK(BM_UnionPositionsSingleReferencedTable);
+
 /**
  * Measure what sorting and merging two pos lists would cost - that's the core of the UnionPositions implementation and sets
  * a performance base line for what UnionPositions could achieve in an overhead-free implementation.
@@ -4,6 +4,8 @@
 
 #include "benchmark_runner.hpp"
 #include "cli_config_parser.hpp"
+#include "hyrise.hpp"
+#include "logging/redo_log.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "tpcc/constants.hpp"
 #include "tpcc/tpcc_benchmark_item_runner.hpp"
@@ -19,7 +21,7 @@ using namespace opossum;  // NOLINT
  * Other limitations (that may be removed in the future):
  *  - No primary / foreign keys are used as they are currently unsupported
  *  - Values that are "retrieved" by the terminal are just selected, but not necessarily materialized
- *  - Data is not persisted as logging is currently unsupported; this means that the durability tests are not executed
+ *  - Data is only persisted if a redo log directory is given (--redo_log); the durability tests are not executed
  *  - As decimals are not supported, we use floats instead
  *  - The delivery transaction is not executed in a "deferred" mode; as such, no delivery result file is written
  *  - We do not execute the isolation tests, as we consider our MVCC tests to be sufficient
@@ -41,12 +43,15 @@ int main(int argc, char* argv[]) {
   cli_options.add_options()
     // We use -s instead of -w for consistency with the options of our other TPC-x binaries.
     ("s,scale", "Scale factor (warehouses)", cxxopts::value<size_t>()->default_value("1")) // NOLINT
-    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("redo_log", "Directory for the redo log and checkpoints. Logging is disabled if empty.", cxxopts::value<std::string>()->default_value("")) // NOLINT
+    ("group_commit_delay", "Time (in microseconds) the redo log waits to collect records for a group commit", cxxopts::value<uint64_t>()->default_value("0")); // NOLINT
   // clang-format on
 
   std::shared_ptr<BenchmarkConfig> config;
   size_t num_warehouses;
   bool consistency_checks;
+  std::string redo_log_directory;
 
   // Parse command line args
   const auto cli_parse_result = cli_options.parse(argc, argv);
@@ -55,6 +60,8 @@ int main(int argc, char* argv[]) {
 
   num_warehouses = cli_parse_result["scale"].as<size_t>();
   consistency_checks = cli_parse_result["consistency_checks"].as<bool>();
+  redo_log_directory = cli_parse_result["redo_log"].as<std::string>();
+  const auto group_commit_delay = std::chrono::microseconds{cli_parse_result["group_commit_delay"].as<uint64_t>()};
 
   config = std::make_shared<BenchmarkConfig>(CLIConfigParser::parse_cli_options(cli_parse_result));
 
@@ -68,12 +75,25 @@ int main(int argc, char* argv[]) {
 
   // Add TPC-C-specific information
   context.emplace("scale_factor", num_warehouses);
+  context.emplace("redo_log", !redo_log_directory.empty());
+  context.emplace("group_commit_delay_us", group_commit_delay.count());
 
   // Run the benchmark
   auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
-  BenchmarkRunner(*config, std::move(item_runner), std::make_unique<TPCCTableGenerator>(num_warehouses, config),
-                  context)
-      .run();
+  auto benchmark_runner = std::make_shared<BenchmarkRunner>(
+      *config, std::move(item_runner), std::make_unique<TPCCTableGenerator>(num_warehouses, config), context);
+  Hyrise::get().benchmark_runner = benchmark_runner;
+
+  // Logging is enabled after the tables have been generated. The initial checkpoint contains the generated data so
+  // that the redo log only has to hold the modifications of the benchmark itself.
+  if (!redo_log_directory.empty()) {
+    std::cout << "- Writing redo log to " << redo_log_directory << std::endl;
+    Hyrise::get().redo_log = std::make_shared<RedoLog>(redo_log_directory, group_commit_delay);
+    Hyrise::get().redo_log->checkpoint();
+    std::cout << "- Initial checkpoint written" << std::endl;
+  }
+
+  benchmark_runner->run();
 
   if (consistency_checks || config->verify) {
     std::cout << "- Running consistency checks at the end of the benchmark" << std::endl;
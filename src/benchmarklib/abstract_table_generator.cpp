@@ -247,7 +247,7 @@ void AbstractTableGenerator::generate_and_store() {
 
       std::cout << "- Writing '" << table_name << "' into binary file " << binary_file_path << " " << std::flush;
       Timer per_table_timer;
-      BinaryWriter::write(*table_info.table, binary_file_path);
+      BinaryWriter::write(*table_info.table, binary_file_path, BinaryFileLayout::PageAligned);
       std::cout << "(" << per_table_timer.lap_formatted() << ")" << std::endl;
     }
     metrics.binary_caching_duration = timer.lap();
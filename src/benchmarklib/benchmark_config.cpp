@@ -8,7 +8,9 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode init_benchmark_mode, const
                                  const Duration& init_warmup_duration,
                                  const std::optional<std::string>& init_output_file_path,
                                  const bool init_enable_scheduler, const uint32_t init_cores,
-                                 const uint32_t init_clients, const bool init_enable_visualization,
+                                 const uint32_t init_clients, const bool init_work_stealing,
+                                 const bool init_morsel_pipelining, const bool init_compile_expressions,
+                                 const bool init_runtime_bloom_filters, const bool init_enable_visualization,
                                  const bool init_verify, const bool init_cache_binary_tables, const bool init_metrics)
     : benchmark_mode(init_benchmark_mode),
       chunk_size(init_chunk_size),
@@ -21,6 +23,10 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode init_benchmark_mode, const
       enable_scheduler(init_enable_scheduler),
       cores(init_cores),
       clients(init_clients),
+      work_stealing(init_work_stealing),
+      morsel_pipelining(init_morsel_pipelining),
+      compile_expressions(init_compile_expressions),
+      runtime_bloom_filters(init_runtime_bloom_filters),
       enable_visualization(init_enable_visualization),
       verify(init_verify),
       cache_binary_tables(init_cache_binary_tables),
@@ -22,7 +22,9 @@ class BenchmarkConfig {
                   const EncodingConfig& init_encoding_config, const bool init_indexes, const int64_t init_max_runs,
                   const Duration& init_max_duration, const Duration& init_warmup_duration,
                   const std::optional<std::string>& init_output_file_path, const bool init_enable_scheduler,
-                  const uint32_t init_cores, const uint32_t init_clients, const bool init_enable_visualization,
+                  const uint32_t init_cores, const uint32_t init_clients, const bool init_work_stealing,
+                  const bool init_morsel_pipelining, const bool init_compile_expressions,
+                  const bool init_runtime_bloom_filters, const bool init_enable_visualization,
                   const bool init_verify, const bool init_cache_binary_tables, const bool init_metrics);
 
   static BenchmarkConfig get_default_config();
@@ -38,6 +40,10 @@ class BenchmarkConfig {
   bool enable_scheduler = false;
   uint32_t cores = 0;
   uint32_t clients = 1;
+  bool work_stealing = false;  // Use per-worker deques in the NodeQueueScheduler
+  bool morsel_pipelining = false;  // Execute chains of scans, validates, and projections morsel by morsel
+  bool compile_expressions = false;  // Set Hyrise::get().expression_compiler
+  bool runtime_bloom_filters = false;  // Set Hyrise::get().runtime_bloom_filters
   bool enable_visualization = false;
   bool verify = false;
   bool cache_binary_tables = false;  // Defaults to false for internal use, but the CLI sets it to true by default
@@ -14,6 +14,7 @@
 
 #include "benchmark_config.hpp"
 #include "constant_mappings.hpp"
+#include "expression/evaluation/expression_compiler.hpp"
 #include "hyrise.hpp"
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
@@ -49,10 +50,16 @@ BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config,
     }
     _context.push_back({"utilized_cores_per_numa_node", numa_cores_per_node});
 
-    const auto scheduler = std::make_shared<NodeQueueScheduler>();
+    const auto scheduler = std::make_shared<NodeQueueScheduler>(config.work_stealing);
     Hyrise::get().set_scheduler(scheduler);
   }
 
+  if (config.compile_expressions) {
+    Hyrise::get().expression_compiler = std::make_shared<ExpressionCompiler>();
+  }
+
+  Hyrise::get().runtime_bloom_filters = config.runtime_bloom_filters;
+
   _table_generator->generate_and_store();
 
   _benchmark_item_runner->on_tables_loaded();
@@ -497,6 +504,10 @@ cxxopts::Options BenchmarkRunner::get_basic_cli_options(const std::string& bench
     ("scheduler", "Enable or disable the scheduler", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("cores", "Specify the number of cores used by the scheduler (if active). 0 means all available cores", cxxopts::value<uint32_t>()->default_value("0")) // NOLINT
     ("clients", "Specify how many items should run in parallel if the scheduler is active", cxxopts::value<uint32_t>()->default_value("1")) // NOLINT
+    ("work_stealing", "Use per-worker work-stealing deques for tasks spawned by workers (if the scheduler is active)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("morsel_pipelining", "Execute chains of scans, validates, and projections morsel by morsel instead of operator at a time", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("compile_expressions", "Evaluate scan and projection expressions with compiled expressions instead of the ExpressionEvaluator where possible", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("runtime_bloom_filters", "Push Bloom filters of hash joins into the table scans of the other join input", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("visualize", "Create a visualization image of one LQP and PQP for each query, do not properly run the benchmark", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("verify", "Verify each query by comparing it with the SQLite result", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("dont_cache_binary_tables", "Do not cache tables as binary files for faster loading on subsequent runs", cxxopts::value<bool>()->default_value("false")) // NOLINT
@@ -538,6 +549,10 @@ nlohmann::json BenchmarkRunner::create_context(const BenchmarkConfig& config) {
       {"using_scheduler", config.enable_scheduler},
       {"cores", config.cores},
       {"clients", config.clients},
+      {"work_stealing", config.work_stealing},
+      {"morsel_pipelining", config.morsel_pipelining},
+      {"compile_expressions", config.compile_expressions},
+      {"runtime_bloom_filters", config.runtime_bloom_filters},
       {"verify", config.verify},
       {"time_unit", "ns"},
       {"GIT-HASH", GIT_HEAD_SHA1 + std::string(GIT_IS_DIRTY ? "-dirty" : "")}};
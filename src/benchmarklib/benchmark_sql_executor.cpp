@@ -8,10 +8,12 @@
 
 namespace opossum {
 BenchmarkSQLExecutor::BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper,
-                                           const std::optional<std::string>& visualize_prefix)
+                                           const std::optional<std::string>& visualize_prefix,
+                                           const bool use_morsel_pipelining)
     : _sqlite_connection(sqlite_wrapper ? std::optional<SQLiteWrapper::Connection>{sqlite_wrapper->new_connection()}
                                         : std::optional<SQLiteWrapper::Connection>{}),
-      _visualize_prefix(visualize_prefix) {
+      _visualize_prefix(visualize_prefix),
+      _use_morsel_pipelining(use_morsel_pipelining) {
   if (_sqlite_connection) {
     _sqlite_connection->raw_execute_query("BEGIN TRANSACTION");
     _sqlite_transaction_open = true;
@@ -22,6 +24,7 @@ std::pair<SQLPipelineStatus, std::shared_ptr<const Table>> BenchmarkSQLExecutor:
     const std::string& sql, const std::shared_ptr<const Table>& expected_result_table) {
   auto pipeline_builder = SQLPipelineBuilder{sql};
   if (transaction_context) pipeline_builder.with_transaction_context(transaction_context);
+  pipeline_builder.with_morsel_pipelining(_use_morsel_pipelining);
 
   auto pipeline = pipeline_builder.create_pipeline();
 
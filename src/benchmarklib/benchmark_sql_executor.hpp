@@ -14,8 +14,9 @@ class BenchmarkSQLExecutor {
  public:
   // @param visualize_prefix    Prefix for the filename of the generated query plans (e.g., "TPC-H_6-").
   //                            The suffix will be "LQP/PQP-<statement_idx>.<extension>"
+  // @param use_morsel_pipelining  See SQLPipelineBuilder::with_morsel_pipelining
   BenchmarkSQLExecutor(const std::shared_ptr<SQLiteWrapper>& sqlite_wrapper,
-                       const std::optional<std::string>& visualize_prefix);
+                       const std::optional<std::string>& visualize_prefix, const bool use_morsel_pipelining = false);
 
   ~BenchmarkSQLExecutor();
 
@@ -48,6 +49,7 @@ class BenchmarkSQLExecutor {
   bool _sqlite_transaction_open{false};
 
   const std::optional<std::string> _visualize_prefix;
+  const bool _use_morsel_pipelining;
   uint64_t _num_visualized_plans{0};
 };
 
@@ -41,6 +41,30 @@ BenchmarkConfig CLIConfigParser::parse_cli_options(const cxxopts::ParseResult& p
     }
   }
 
+  const auto work_stealing = parse_result["work_stealing"].as<bool>();
+  if (work_stealing) {
+    if (enable_scheduler) {
+      std::cout << "- Scheduling tasks spawned by workers on per-worker work-stealing deques" << std::endl;
+    } else {
+      PerformanceWarning("'--work_stealing' specified but ignored, because '--scheduler' is false");
+    }
+  }
+
+  const auto morsel_pipelining = parse_result["morsel_pipelining"].as<bool>();
+  if (morsel_pipelining) {
+    std::cout << "- Executing chains of scans, validates, and projections morsel by morsel" << std::endl;
+  }
+
+  const auto compile_expressions = parse_result["compile_expressions"].as<bool>();
+  if (compile_expressions) {
+    std::cout << "- Evaluating scan and projection expressions with compiled expressions where possible" << std::endl;
+  }
+
+  const auto runtime_bloom_filters = parse_result["runtime_bloom_filters"].as<bool>();
+  if (runtime_bloom_filters) {
+    std::cout << "- Pushing Bloom filters of hash joins into the table scans of their inputs" << std::endl;
+  }
+
   Assert(clients > 0, "Invalid value for --clients");
 
   if (enable_scheduler && clients == 1) {
@@ -133,9 +157,10 @@ BenchmarkConfig CLIConfigParser::parse_cli_options(const cxxopts::ParseResult& p
   }
 
   return BenchmarkConfig{
-      benchmark_mode,  chunk_size,          *encoding_config, indexes, max_runs, timeout_duration,
-      warmup_duration, output_file_path,    enable_scheduler, cores,   clients,  enable_visualization,
-      verify,          cache_binary_tables, metrics};
+      benchmark_mode,       chunk_size,      *encoding_config,    indexes,             max_runs,
+      timeout_duration,     warmup_duration, output_file_path,    enable_scheduler,    cores,
+      clients,              work_stealing,   morsel_pipelining,   compile_expressions, runtime_bloom_filters,
+      enable_visualization, verify,          cache_binary_tables, metrics};
 }
 
 EncodingConfig CLIConfigParser::parse_encoding_config(const std::string& encoding_file_str) {
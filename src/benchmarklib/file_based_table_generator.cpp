@@ -92,7 +92,15 @@ std::unordered_map<std::string, BenchmarkTableInfo> FileBasedTableGenerator::gen
       if (extension == ".tbl") {
         table_info.table = load_table(*table_info.text_file_path, _benchmark_config->chunk_size);
       } else if (extension == ".csv") {
-        table_info.table = CsvParser::parse(*table_info.text_file_path, _benchmark_config->chunk_size);
+        // If all columns use the same encoding, encode the chunks while the rest of the file is parsed. Otherwise, the
+        // tables are encoded by BenchmarkTableEncoder later.
+        const auto& encoding_config = _benchmark_config->encoding_config;
+        auto encoding_spec = std::optional<SegmentEncodingSpec>{};
+        if (encoding_config.type_encoding_mapping.empty() && encoding_config.custom_encoding_mapping.empty()) {
+          encoding_spec = encoding_config.default_encoding_spec;
+        }
+        table_info.table =
+            CsvParser::parse(*table_info.text_file_path, _benchmark_config->chunk_size, std::nullopt, encoding_spec);
       } else {
         Fail("Unknown textual file format. This should have been caught earlier.");
       }
@@ -5,6 +5,8 @@
 
 #include "benchmark_config.hpp"
 #include "cli_config_parser.hpp"
+#include "hyrise.hpp"
+#include "scheduler/admission_control.hpp"
 #include "server/server.hpp"
 #include "tpcc/tpcc_table_generator.hpp"
 #include "tpcds/tpcds_table_generator.hpp"
@@ -63,6 +65,7 @@ cxxopts::Options get_server_cli_options() {
                        "TPC-DS, and TPC-H. The sizing factor determines the scale factor in TPC-DS and TPC-H, and the "
                        "warehouse count in TPC-C.", cxxopts::value<std::string>()) // NOLINT
     ("execution_info", "Send execution information after statement execution", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("max_concurrent_queries", "Maximum number of queries that are executed concurrently, 0 for no limit", cxxopts::value<size_t>()->default_value("0")) // NOLINT
     ;  // NOLINT
   // clang-format on
 
@@ -91,6 +94,11 @@ int main(int argc, char* argv[]) {
     generate_benchmark_data(parsed_options["benchmark_data"].as<std::string>());
   }
 
+  const auto max_concurrent_queries = parsed_options["max_concurrent_queries"].as<size_t>();
+  if (max_concurrent_queries > 0) {
+    opossum::Hyrise::get().admission_control = std::make_shared<opossum::AdmissionControl>(max_concurrent_queries);
+  }
+
   const auto execution_info = parsed_options["execution_info"].as<bool>();
   const auto port = parsed_options["port"].as<uint16_t>();
 
@@ -5,6 +5,8 @@
 
 #include "commit_context.hpp"
 #include "hyrise.hpp"
+#include "logging/redo_log.hpp"
+#include "logging/redo_log_record.hpp"
 #include "operators/abstract_read_write_operator.hpp"
 #include "utils/assert.hpp"
 
@@ -93,7 +95,24 @@ void TransactionContext::commit_async(const std::function<void(TransactionID)>&
     op->commit_records(commit_id());
   }
 
-  _mark_as_pending_and_try_commit(callback);
+  const auto& redo_log = Hyrise::get().redo_log;
+  if (!redo_log) {
+    _mark_as_pending_and_try_commit(callback);
+    return;
+  }
+
+  // Records are logged even if they are empty. This way, every commit ID can be found in the log and recovery can
+  // detect transactions that are missing because their record was not written before a crash.
+  auto record = RedoLogRecord{commit_id()};
+  for (const auto& op : _read_write_operators) {
+    op->log_records(record);
+  }
+
+  // The transaction becomes visible only after its record is durable. Until then, the commit context is not pending,
+  // which also holds back all transactions with a higher commit ID.
+  redo_log->append(record, [context = shared_from_this(), callback]() {
+    context->_mark_as_pending_and_try_commit(callback);
+  });
 }
 
 void TransactionContext::commit() {
@@ -109,6 +109,7 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
   /**
    * Commits the transaction.
    *
+   * If a RedoLog is set, the transaction is committed only after its modifications have been made durable.
    * @param callback called when transaction is actually committed
    */
   void commit_async(const std::function<void(TransactionID)>& callback);
@@ -32,6 +32,14 @@ std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context(
   return std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id, auto_commit);
 }
 
+void TransactionManager::_reset_last_commit_id(const CommitID last_commit_id) {
+  Assert(!get_lowest_active_snapshot_commit_id(), "Cannot reset the last commit ID while transactions are active");
+  Assert(last_commit_id >= _last_commit_id, "The last commit ID must not decrease");
+
+  _last_commit_id = last_commit_id;
+  std::atomic_store(&_last_commit_context, std::make_shared<CommitContext>(last_commit_id));
+}
+
 void TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
   std::lock_guard<std::mutex> lock(_active_snapshot_commit_ids_mutex);
   _active_snapshot_commit_ids.insert(snapshot_commit_id);
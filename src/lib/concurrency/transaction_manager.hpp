@@ -71,6 +71,7 @@ class TransactionManager : public Noncopyable {
   ~TransactionManager();
 
   friend class Hyrise;
+  friend class RedoLog;
   friend class TransactionContext;
 
   TransactionManager& operator=(TransactionManager&& transaction_manager) noexcept;
@@ -78,6 +79,10 @@ class TransactionManager : public Noncopyable {
   std::shared_ptr<CommitContext> _new_commit_context();
   void _try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context);
 
+  // Used by the RedoLog after recovery to continue with the commit IDs of the recovered transactions. Must only be
+  // called while no transaction is active.
+  void _reset_last_commit_id(const CommitID last_commit_id);
+
   /**
    * The TransactionManager keeps track of issued snapshot-commit-ids,
    * which are in use by unfinished transactions.
@@ -0,0 +1,1176 @@
+#include "expression_compiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <boost/hana/type.hpp>
+#include <uninitialized_vector.hpp>
+
+#include "expression/arithmetic_expression.hpp"
+#include "expression/between_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/case_expression.hpp"
+#include "expression/cast_expression.hpp"
+#include "expression/in_expression.hpp"
+#include "expression/is_null_expression.hpp"
+#include "expression/list_expression.hpp"
+#include "expression/logical_expression.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "expression/unary_minus_expression.hpp"
+#include "expression/value_expression.hpp"
+#include "expression_evaluator.hpp"
+#include "like_matcher.hpp"
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// The rows of a chunk are evaluated in blocks of this size. Each node processes a whole block per (virtual) call in a
+// tight loop that the compiler can vectorize. The blocks are small enough for the intermediate results of all nodes to
+// stay in the CPU caches.
+constexpr auto BLOCK_SIZE = ChunkOffset{1'024};
+
+// The results of a node for a block of rows. `values` and `nulls` point either to the node's buffers in the arena of
+// the evaluation or to memory owned by a node or a materialized column. `nulls` is nullptr if no row of the block is
+// NULL. The values of NULL rows are defined but meaningless.
+template <typename T>
+struct Block final {
+  const T* values{nullptr};
+  const uint8_t* nulls{nullptr};
+};
+
+class BaseMaterializedColumn {
+ public:
+  virtual ~BaseMaterializedColumn() = default;
+};
+
+// A decompressed segment accessed by a CompiledExpression
+template <typename T>
+class MaterializedColumn final : public BaseMaterializedColumn {
+ public:
+  std::vector<T> values;
+
+  // Empty if no value of the segment is NULL
+  std::vector<uint8_t> nulls;
+
+  // Only used for string columns, whose values are string_views into these strings
+  std::vector<pmr_string> strings;
+};
+
+// The materialized columns accessed by a CompiledExpression, indexed by ColumnID. Columns that are not accessed are
+// nullptr.
+using MaterializedColumns = std::vector<std::unique_ptr<BaseMaterializedColumn>>;
+
+// The state of a single evaluation of a CompiledExpression for a chunk. As compiled expressions are cached and might
+// be evaluated by multiple threads at the same time, the nodes do not own their buffers. Instead, the buffers of all
+// nodes are placed in an arena that is allocated once per evaluation (see ArenaLayout).
+struct EvaluationContext final {
+  MaterializedColumns columns;
+  uninitialized_vector<std::byte> arena;
+
+  template <typename T>
+  T* buffer(const size_t offset) {
+    return reinterpret_cast<T*>(arena.data() + offset);
+  }
+};
+
+class BaseCompiledExpressionNode {
+ public:
+  virtual ~BaseCompiledExpressionNode() = default;
+
+  // Whether the node might return NULL for rows of the given table
+  virtual bool is_nullable(const Table& table) const = 0;
+};
+
+template <typename T>
+class CompiledExpressionNode : public BaseCompiledExpressionNode {
+ public:
+  // Writes the results for the `size` (at most BLOCK_SIZE) rows starting at `begin` to `result`
+  virtual void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                        Block<T>& result) const = 0;
+};
+
+namespace {
+
+using Bool = ExpressionEvaluator::Bool;
+
+// Strings are passed between the nodes as string_views into the materialized segments or the nodes' literals
+template <typename ColumnDataType>
+using NodeType = std::conditional_t<std::is_same_v<ColumnDataType, pmr_string>, std::string_view, ColumnDataType>;
+
+template <typename T>
+using StorageType = std::conditional_t<std::is_same_v<T, std::string_view>, pmr_string, T>;
+
+template <typename T>
+using NodePtr = std::shared_ptr<const CompiledExpressionNode<T>>;
+
+const auto NO_NULLS = std::array<uint8_t, BLOCK_SIZE>{};
+
+// Allows the loops to handle blocks with and without NULLs alike
+template <typename T>
+const uint8_t* nulls_or_zeros(const Block<T>& block) {
+  return block.nulls ? block.nulls : NO_NULLS.data();
+}
+
+// Assigns the buffers of the nodes their offsets in the arena of an evaluation (see EvaluationContext)
+class ArenaLayout final {
+ public:
+  // Returns the offset of a buffer for BLOCK_SIZE values of type T
+  template <typename T>
+  size_t add_buffer() {
+    static_assert(std::is_trivially_copyable_v<T> && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "The arena is uninitialized memory with the default alignment of operator new");
+    _size = (_size + alignof(T) - 1) / alignof(T) * alignof(T);
+    const auto offset = _size;
+    _size += BLOCK_SIZE * sizeof(T);
+    return offset;
+  }
+
+  size_t size() const { return _size; }
+
+ private:
+  size_t _size{0};
+};
+
+// The buffers of a node for the values and NULLs of its results
+template <typename T>
+class BlockBuffers final {
+ public:
+  explicit BlockBuffers(ArenaLayout& layout)
+      : _value_offset(layout.add_buffer<T>()), _null_offset(layout.add_buffer<uint8_t>()) {}
+
+  T* values(EvaluationContext& context) const { return context.buffer<T>(_value_offset); }
+
+  uint8_t* nulls(EvaluationContext& context) const { return context.buffer<uint8_t>(_null_offset); }
+
+ private:
+  const size_t _value_offset;
+  const size_t _null_offset;
+};
+
+template <typename T, typename Argument>
+void copy_nulls(const Block<Argument>& argument, const ChunkOffset size, uint8_t* const null_buffer, Block<T>& result) {
+  result.nulls = nullptr;
+  if (!argument.nulls) return;
+
+  std::copy_n(argument.nulls, size, null_buffer);
+  result.nulls = null_buffer;
+}
+
+// A row of the result is NULL if it is NULL in either of the arguments
+template <typename T, typename Left, typename Right>
+void merge_nulls(const Block<Left>& left, const Block<Right>& right, const ChunkOffset size,
+                 uint8_t* const null_buffer, Block<T>& result) {
+  if (!left.nulls || !right.nulls) {
+    copy_nulls(left.nulls ? left : right, size, null_buffer, result);
+    return;
+  }
+
+  for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+    null_buffer[offset] = left.nulls[offset] | right.nulls[offset];
+  }
+  result.nulls = null_buffer;
+}
+
+template <typename Functor>
+void resolve_node_type(const DataType data_type, const Functor& functor) {
+  resolve_data_type(data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    functor(boost::hana::type_c<NodeType<ColumnDataType>>);
+  });
+}
+
+// The type in which the ExpressionEvaluator compares two values (see STLComparisonFunctorWrapper) or computes
+// additions, subtractions, multiplications, and modulos (see STLArithmeticFunctorWrapper)
+std::optional<DataType> evaluation_data_type(const DataType lhs, const DataType rhs) {
+  if (lhs == DataType::Null && rhs == DataType::Null) return DataType::Int;
+  if (lhs == DataType::Null) return rhs;
+  if (rhs == DataType::Null) return lhs;
+  if ((lhs == DataType::String) != (rhs == DataType::String)) return std::nullopt;
+  if (lhs == DataType::String) return DataType::String;
+
+  auto data_type = DataType::Null;
+  resolve_data_type(lhs, [&](const auto lhs_data_type_t) {
+    using LhsDataType = typename decltype(lhs_data_type_t)::type;
+    resolve_data_type(rhs, [&](const auto rhs_data_type_t) {
+      using RhsDataType = typename decltype(rhs_data_type_t)::type;
+      if constexpr (std::is_arithmetic_v<LhsDataType> && std::is_arithmetic_v<RhsDataType>) {
+        data_type = data_type_from_type<std::common_type_t<LhsDataType, RhsDataType>>();
+      }
+    });
+  });
+  return data_type;
+}
+
+// References the materialized column without copying it
+template <typename T>
+class ColumnNode final : public CompiledExpressionNode<T> {
+ public:
+  explicit ColumnNode(const ColumnID column_id) : _column_id(column_id) {}
+
+  bool is_nullable(const Table& table) const final { return table.column_is_nullable(_column_id); }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    const auto& column = static_cast<const MaterializedColumn<T>&>(*context.columns[_column_id]);
+    result.values = column.values.data() + begin;
+    result.nulls = column.nulls.empty() ? nullptr : column.nulls.data() + begin;
+  }
+
+ private:
+  const ColumnID _column_id;
+};
+
+// The value is repeated for a full block once, so that evaluating the node costs nothing
+template <typename T>
+class ValueNode final : public CompiledExpressionNode<T> {
+ public:
+  explicit ValueNode(const StorageType<T>& value) : _value(value), _values(BLOCK_SIZE, T{_value}) {}
+
+  bool is_nullable(const Table& table) const final { return false; }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    result.values = _values.data();
+    result.nulls = nullptr;
+  }
+
+ private:
+  const StorageType<T> _value;
+  const std::vector<T> _values;
+};
+
+template <typename T>
+class NullNode final : public CompiledExpressionNode<T> {
+ public:
+  NullNode() : _values(BLOCK_SIZE), _nulls(BLOCK_SIZE, uint8_t{1}) {}
+
+  bool is_nullable(const Table& table) const final { return true; }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    result.values = _values.data();
+    result.nulls = _nulls.data();
+  }
+
+ private:
+  const std::vector<T> _values;
+  const std::vector<uint8_t> _nulls;
+};
+
+template <typename T, typename Argument>
+class CastNode final : public CompiledExpressionNode<T> {
+ public:
+  CastNode(const NodePtr<Argument>& argument, ArenaLayout& layout) : _argument(argument), _buffers(layout) {}
+
+  bool is_nullable(const Table& table) const final { return _argument->is_nullable(table); }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    Block<Argument> argument;
+    _argument->evaluate(context, begin, size, argument);
+
+    auto* const values = _buffers.values(context);
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      values[offset] = static_cast<T>(argument.values[offset]);
+    }
+    result.values = values;
+    copy_nulls(argument, size, _buffers.nulls(context), result);
+  }
+
+ private:
+  const NodePtr<Argument> _argument;
+  const BlockBuffers<T> _buffers;
+};
+
+template <typename T, ArithmeticOperator arithmetic_operator>
+class ArithmeticNode final : public CompiledExpressionNode<T> {
+ public:
+  ArithmeticNode(const NodePtr<T>& left, const NodePtr<T>& right, ArenaLayout& layout)
+      : _left(left), _right(right), _buffers(layout) {}
+
+  bool is_nullable(const Table& table) const final {
+    // Division and Modulo by zero return NULL
+    return arithmetic_operator == ArithmeticOperator::Division || arithmetic_operator == ArithmeticOperator::Modulo ||
+           _left->is_nullable(table) || _right->is_nullable(table);
+  }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    Block<T> left;
+    Block<T> right;
+    _left->evaluate(context, begin, size, left);
+    _right->evaluate(context, begin, size, right);
+    auto* const null_buffer = _buffers.nulls(context);
+    merge_nulls(left, right, size, null_buffer, result);
+
+    const auto* const left_values = left.values;
+    const auto* const right_values = right.values;
+    auto* const values = _buffers.values(context);
+    result.values = values;
+
+    if constexpr (arithmetic_operator == ArithmeticOperator::Addition) {
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        values[offset] = left_values[offset] + right_values[offset];
+      }
+    } else if constexpr (arithmetic_operator == ArithmeticOperator::Subtraction) {
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        values[offset] = left_values[offset] - right_values[offset];
+      }
+    } else if constexpr (arithmetic_operator == ArithmeticOperator::Multiplication) {
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        values[offset] = left_values[offset] * right_values[offset];
+      }
+    } else {
+      if (!result.nulls) {
+        std::fill_n(null_buffer, size, uint8_t{0});
+        result.nulls = null_buffer;
+      }
+
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        const auto divisor_is_zero = right_values[offset] == 0;
+        const auto divisor = divisor_is_zero ? T{1} : right_values[offset];
+        null_buffer[offset] |= divisor_is_zero;
+
+        if constexpr (arithmetic_operator == ArithmeticOperator::Division) {
+          values[offset] = left_values[offset] / divisor;
+        } else if constexpr (std::is_integral_v<T>) {
+          values[offset] = left_values[offset] % divisor;
+        } else {
+          values[offset] = static_cast<T>(std::fmod(left_values[offset], divisor));
+        }
+      }
+    }
+  }
+
+ private:
+  const NodePtr<T> _left;
+  const NodePtr<T> _right;
+  const BlockBuffers<T> _buffers;
+};
+
+template <typename T>
+class UnaryMinusNode final : public CompiledExpressionNode<T> {
+ public:
+  UnaryMinusNode(const NodePtr<T>& argument, ArenaLayout& layout) : _argument(argument), _buffers(layout) {}
+
+  bool is_nullable(const Table& table) const final { return _argument->is_nullable(table); }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    Block<T> argument;
+    _argument->evaluate(context, begin, size, argument);
+
+    auto* const values = _buffers.values(context);
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      values[offset] = -argument.values[offset];
+    }
+    result.values = values;
+    copy_nulls(argument, size, _buffers.nulls(context), result);
+  }
+
+ private:
+  const NodePtr<T> _argument;
+  const BlockBuffers<T> _buffers;
+};
+
+template <typename T, PredicateCondition predicate_condition>
+class ComparisonNode final : public CompiledExpressionNode<Bool> {
+ public:
+  ComparisonNode(const NodePtr<T>& left, const NodePtr<T>& right, ArenaLayout& layout)
+      : _left(left), _right(right), _buffers(layout) {}
+
+  bool is_nullable(const Table& table) const final { return _left->is_nullable(table) || _right->is_nullable(table); }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<Bool>& result) const final {
+    Block<T> left;
+    Block<T> right;
+    _left->evaluate(context, begin, size, left);
+    _right->evaluate(context, begin, size, right);
+    merge_nulls(left, right, size, _buffers.nulls(context), result);
+
+    const auto* const left_values = left.values;
+    const auto* const right_values = right.values;
+    auto* const values = _buffers.values(context);
+    result.values = values;
+
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      const auto& left_value = left_values[offset];
+      const auto& right_value = right_values[offset];
+      if constexpr (predicate_condition == PredicateCondition::Equals) {
+        values[offset] = left_value == right_value;
+      } else if constexpr (predicate_condition == PredicateCondition::NotEquals) {
+        values[offset] = left_value != right_value;
+      } else if constexpr (predicate_condition == PredicateCondition::LessThan) {
+        values[offset] = left_value < right_value;
+      } else if constexpr (predicate_condition == PredicateCondition::LessThanEquals) {
+        values[offset] = left_value <= right_value;
+      } else if constexpr (predicate_condition == PredicateCondition::GreaterThan) {
+        values[offset] = left_value > right_value;
+      } else {
+        values[offset] = left_value >= right_value;
+      }
+    }
+  }
+
+ private:
+  const NodePtr<T> _left;
+  const NodePtr<T> _right;
+  const BlockBuffers<Bool> _buffers;
+};
+
+// SQL's AND and OR with ternary NULL logic over any number of operands (e.g., for `a AND b AND c` or IN lists). Once
+// the evaluated operands determine the result of all rows in a block, e.g., because they are all FALSE for an AND, the
+// remaining operands are not evaluated for that block.
+template <LogicalOperator logical_operator>
+class LogicalNode final : public CompiledExpressionNode<Bool> {
+ public:
+  LogicalNode(std::vector<NodePtr<Bool>> operands, ArenaLayout& layout)
+      : _operands(std::move(operands)), _buffers(layout) {}
+
+  bool is_nullable(const Table& table) const final {
+    return std::any_of(_operands.cbegin(), _operands.cend(),
+                       [&](const auto& operand) { return operand->is_nullable(table); });
+  }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<Bool>& result) const final {
+    // The value that determines the result regardless of the other operands
+    constexpr auto DOMINANT_VALUE = logical_operator == LogicalOperator::Or;
+
+    // Whether any operand of the row was the dominant value or NULL, respectively
+    auto* const is_dominant = _buffers.values(context);
+    auto* const has_null = _buffers.nulls(context);
+    std::fill_n(is_dominant, size, Bool{0});
+    std::fill_n(has_null, size, uint8_t{0});
+
+    Block<Bool> operand;
+    for (const auto& operand_node : _operands) {
+      operand_node->evaluate(context, begin, size, operand);
+      const auto* const operand_nulls = nulls_or_zeros(operand);
+
+      auto dominant_count = ChunkOffset{0};
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        is_dominant[offset] |= !operand_nulls[offset] && (operand.values[offset] != 0) == DOMINANT_VALUE;
+        has_null[offset] |= operand_nulls[offset];
+        dominant_count += is_dominant[offset];
+      }
+      if (dominant_count == size) break;
+    }
+
+    // A row is NULL if no operand is dominant and at least one is NULL
+    auto null_count = ChunkOffset{0};
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      has_null[offset] &= !is_dominant[offset];
+      null_count += has_null[offset];
+      is_dominant[offset] = is_dominant[offset] ? DOMINANT_VALUE : !DOMINANT_VALUE;
+    }
+    result.values = is_dominant;
+    result.nulls = null_count > 0 ? has_null : nullptr;
+  }
+
+ private:
+  const std::vector<NodePtr<Bool>> _operands;
+  const BlockBuffers<Bool> _buffers;
+};
+
+template <typename T>
+class IsNullNode final : public CompiledExpressionNode<Bool> {
+ public:
+  IsNullNode(const NodePtr<T>& operand, const bool is_not_null, ArenaLayout& layout)
+      : _operand(operand), _is_not_null(is_not_null), _value_offset(layout.add_buffer<Bool>()) {}
+
+  bool is_nullable(const Table& table) const final { return false; }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<Bool>& result) const final {
+    Block<T> operand;
+    _operand->evaluate(context, begin, size, operand);
+    const auto* const operand_nulls = nulls_or_zeros(operand);
+
+    auto* const values = context.buffer<Bool>(_value_offset);
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      values[offset] = (operand_nulls[offset] != 0) != _is_not_null;
+    }
+    result.values = values;
+    result.nulls = nullptr;
+  }
+
+ private:
+  const NodePtr<T> _operand;
+  const bool _is_not_null;
+  const size_t _value_offset;
+};
+
+bool matches(const std::string_view& string, const LikeMatcher::StartsWithPattern& pattern) {
+  return string.substr(0, pattern.string.size()) == pattern.string;
+}
+
+bool matches(const std::string_view& string, const LikeMatcher::EndsWithPattern& pattern) {
+  return string.size() >= pattern.string.size() &&
+         string.substr(string.size() - pattern.string.size()) == pattern.string;
+}
+
+bool matches(const std::string_view& string, const LikeMatcher::ContainsPattern& pattern) {
+  return string.find(pattern.string) != std::string_view::npos;
+}
+
+bool matches(const std::string_view& string, const LikeMatcher::MultipleContainsPattern& pattern) {
+  auto position = size_t{0};
+  for (const auto& contained_string : pattern.strings) {
+    position = string.find(contained_string, position);
+    if (position == std::string_view::npos) return false;
+    position += contained_string.size();
+  }
+  return true;
+}
+
+bool matches(const std::string_view& string, const std::regex& regex) {
+  return std::regex_match(string.begin(), string.end(), regex);
+}
+
+// `operand LIKE 'pattern'`. The pattern is resolved once when the expression is compiled.
+template <typename Pattern>
+class LikeNode final : public CompiledExpressionNode<Bool> {
+ public:
+  LikeNode(const NodePtr<std::string_view>& operand, const Pattern& pattern, const bool invert_results,
+           ArenaLayout& layout)
+      : _operand(operand), _pattern(pattern), _invert_results(invert_results), _buffers(layout) {}
+
+  bool is_nullable(const Table& table) const final { return _operand->is_nullable(table); }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<Bool>& result) const final {
+    Block<std::string_view> operand;
+    _operand->evaluate(context, begin, size, operand);
+
+    auto* const values = _buffers.values(context);
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      values[offset] = matches(operand.values[offset], _pattern) != _invert_results;
+    }
+    result.values = values;
+    copy_nulls(operand, size, _buffers.nulls(context), result);
+  }
+
+ private:
+  const NodePtr<std::string_view> _operand;
+  const Pattern _pattern;
+  const bool _invert_results;
+  const BlockBuffers<Bool> _buffers;
+};
+
+// A branch is only evaluated for a block if at least one of the block's rows takes it
+template <typename T>
+class CaseNode final : public CompiledExpressionNode<T> {
+ public:
+  CaseNode(const NodePtr<Bool>& when, const NodePtr<T>& then, const NodePtr<T>& otherwise, ArenaLayout& layout)
+      : _when(when),
+        _then(then),
+        _otherwise(otherwise),
+        _buffers(layout),
+        _takes_then_offset(layout.add_buffer<uint8_t>()) {}
+
+  bool is_nullable(const Table& table) const final {
+    return _then->is_nullable(table) || _otherwise->is_nullable(table);
+  }
+
+  void evaluate(EvaluationContext& context, const ChunkOffset begin, const ChunkOffset size,
+                Block<T>& result) const final {
+    Block<Bool> when;
+    _when->evaluate(context, begin, size, when);
+    const auto* const when_nulls = nulls_or_zeros(when);
+
+    // Rows for which WHEN is NULL take the ELSE branch
+    auto* const takes_then = context.buffer<uint8_t>(_takes_then_offset);
+    auto then_count = ChunkOffset{0};
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      takes_then[offset] = !when_nulls[offset] && when.values[offset];
+      then_count += takes_then[offset];
+    }
+
+    if (then_count == size) {
+      _then->evaluate(context, begin, size, result);
+      return;
+    }
+    if (then_count == 0) {
+      _otherwise->evaluate(context, begin, size, result);
+      return;
+    }
+
+    Block<T> then;
+    Block<T> otherwise;
+    _then->evaluate(context, begin, size, then);
+    _otherwise->evaluate(context, begin, size, otherwise);
+
+    auto* const values = _buffers.values(context);
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      values[offset] = takes_then[offset] ? then.values[offset] : otherwise.values[offset];
+    }
+    result.values = values;
+
+    result.nulls = nullptr;
+    if (then.nulls || otherwise.nulls) {
+      const auto* const then_nulls = nulls_or_zeros(then);
+      const auto* const otherwise_nulls = nulls_or_zeros(otherwise);
+      auto* const null_buffer = _buffers.nulls(context);
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        null_buffer[offset] = takes_then[offset] ? then_nulls[offset] : otherwise_nulls[offset];
+      }
+      result.nulls = null_buffer;
+    }
+  }
+
+ private:
+  const NodePtr<Bool> _when;
+  const NodePtr<T> _then;
+  const NodePtr<T> _otherwise;
+  const BlockBuffers<T> _buffers;
+  const size_t _takes_then_offset;
+};
+
+bool is_null_value(const AbstractExpression& expression) {
+  return expression.type == ExpressionType::Value &&
+         variant_is_null(static_cast<const ValueExpression&>(expression).value);
+}
+
+/**
+ * Translates an expression into a tree of nodes. All compile functions return nullptr if the expression (or one of its
+ * arguments) is not supported.
+ */
+class NodeCompiler {
+ public:
+  std::shared_ptr<const BaseCompiledExpressionNode> compile(const AbstractExpression& expression) {
+    // NULL literals are only supported as arguments, where the required type is known (see compile_as)
+    if (expression.data_type() == DataType::Null) return nullptr;
+
+    switch (expression.type) {
+      case ExpressionType::PQPColumn:
+        return _compile_column(static_cast<const PQPColumnExpression&>(expression));
+      case ExpressionType::Value:
+        return _compile_value(static_cast<const ValueExpression&>(expression));
+      case ExpressionType::Arithmetic:
+        return _compile_arithmetic(static_cast<const ArithmeticExpression&>(expression));
+      case ExpressionType::UnaryMinus:
+        return _compile_unary_minus(static_cast<const UnaryMinusExpression&>(expression));
+      case ExpressionType::Cast:
+        return _compile_cast(static_cast<const CastExpression&>(expression));
+      case ExpressionType::Logical:
+        return _compile_logical(static_cast<const LogicalExpression&>(expression));
+      case ExpressionType::Predicate:
+        return _compile_predicate(static_cast<const AbstractPredicateExpression&>(expression));
+      case ExpressionType::Case:
+        return _compile_case(static_cast<const CaseExpression&>(expression));
+      default:
+        return nullptr;
+    }
+  }
+
+  // Compiles the expression and casts its result to T. Only numeric types can be cast into each other.
+  template <typename T>
+  NodePtr<T> compile_as(const AbstractExpression& expression) {
+    if (is_null_value(expression)) return std::make_shared<NullNode<T>>();
+
+    const auto node = compile(expression);
+    if (!node) return nullptr;
+
+    auto typed_node = NodePtr<T>{};
+    resolve_node_type(expression.data_type(), [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      const auto node_with_type = std::static_pointer_cast<const CompiledExpressionNode<NodeDataType>>(node);
+
+      if constexpr (std::is_same_v<NodeDataType, T>) {
+        typed_node = node_with_type;
+      } else if constexpr (std::is_arithmetic_v<NodeDataType> && std::is_arithmetic_v<T>) {
+        typed_node = std::make_shared<CastNode<T, NodeDataType>>(node_with_type, arena_layout);
+      }
+    });
+    return typed_node;
+  }
+
+  std::vector<ColumnID> column_ids;
+
+  // The buffers of all nodes that have been created so far
+  ArenaLayout arena_layout;
+
+ private:
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_column(const PQPColumnExpression& expression) {
+    column_ids.emplace_back(expression.column_id);
+
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(expression.data_type(), [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      node = std::make_shared<ColumnNode<NodeDataType>>(expression.column_id);
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_value(const ValueExpression& expression) {
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_data_type(expression.data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      node = std::make_shared<ValueNode<NodeType<ColumnDataType>>>(boost::get<ColumnDataType>(expression.value));
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_arithmetic(const ArithmeticExpression& expression) {
+    const auto& left = *expression.left_operand();
+    const auto& right = *expression.right_operand();
+
+    // Like the ExpressionEvaluator, compute the result in the common type of the operands and cast it to the result
+    // type afterwards. Only divisions are computed in the result type.
+    const auto evaluation_type = expression.arithmetic_operator == ArithmeticOperator::Division
+                                     ? std::optional<DataType>{expression.data_type()}
+                                     : evaluation_data_type(left.data_type(), right.data_type());
+    if (!evaluation_type || *evaluation_type == DataType::String) return nullptr;
+
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(*evaluation_type, [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      if constexpr (std::is_arithmetic_v<NodeDataType>) {
+        const auto left_node = compile_as<NodeDataType>(left);
+        const auto right_node = compile_as<NodeDataType>(right);
+        if (!left_node || !right_node) return;
+
+        switch (expression.arithmetic_operator) {
+          case ArithmeticOperator::Addition:
+            node = std::make_shared<ArithmeticNode<NodeDataType, ArithmeticOperator::Addition>>(left_node, right_node,
+                                                                                                 arena_layout);
+            break;
+          case ArithmeticOperator::Subtraction:
+            node = std::make_shared<ArithmeticNode<NodeDataType, ArithmeticOperator::Subtraction>>(
+                left_node, right_node, arena_layout);
+            break;
+          case ArithmeticOperator::Multiplication:
+            node = std::make_shared<ArithmeticNode<NodeDataType, ArithmeticOperator::Multiplication>>(
+                left_node, right_node, arena_layout);
+            break;
+          case ArithmeticOperator::Division:
+            node = std::make_shared<ArithmeticNode<NodeDataType, ArithmeticOperator::Division>>(left_node, right_node,
+                                                                                                 arena_layout);
+            break;
+          case ArithmeticOperator::Modulo:
+            node = std::make_shared<ArithmeticNode<NodeDataType, ArithmeticOperator::Modulo>>(left_node, right_node,
+                                                                                               arena_layout);
+            break;
+        }
+      }
+    });
+    if (!node || *evaluation_type == expression.data_type()) return node;
+
+    return _cast(node, *evaluation_type, expression.data_type());
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_unary_minus(const UnaryMinusExpression& expression) {
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(expression.data_type(), [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      if constexpr (std::is_arithmetic_v<NodeDataType>) {
+        const auto argument_node = compile_as<NodeDataType>(*expression.argument());
+        if (argument_node) node = std::make_shared<UnaryMinusNode<NodeDataType>>(argument_node, arena_layout);
+      }
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_cast(const CastExpression& expression) {
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(expression.data_type(), [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      node = compile_as<NodeDataType>(*expression.argument());
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_logical(const LogicalExpression& expression) {
+    // `a AND b AND c` is compiled into a single node with three operands
+    auto operands = std::vector<NodePtr<Bool>>{};
+    if (!_compile_logical_operands(expression.logical_operator, expression, operands)) return nullptr;
+
+    return _logical_node(expression.logical_operator, std::move(operands));
+  }
+
+  bool _compile_logical_operands(const LogicalOperator logical_operator, const AbstractExpression& expression,
+                                 std::vector<NodePtr<Bool>>& operands) {
+    if (expression.type == ExpressionType::Logical) {
+      const auto& logical_expression = static_cast<const LogicalExpression&>(expression);
+      if (logical_expression.logical_operator == logical_operator) {
+        return _compile_logical_operands(logical_operator, *logical_expression.left_operand(), operands) &&
+               _compile_logical_operands(logical_operator, *logical_expression.right_operand(), operands);
+      }
+    }
+
+    const auto node = compile_as<Bool>(expression);
+    if (!node) return false;
+
+    operands.emplace_back(node);
+    return true;
+  }
+
+  NodePtr<Bool> _logical_node(const LogicalOperator logical_operator, std::vector<NodePtr<Bool>> operands) {
+    if (logical_operator == LogicalOperator::And) {
+      return std::make_shared<LogicalNode<LogicalOperator::And>>(std::move(operands), arena_layout);
+    }
+    return std::make_shared<LogicalNode<LogicalOperator::Or>>(std::move(operands), arena_layout);
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_predicate(const AbstractPredicateExpression& expression) {
+    const auto predicate_condition = expression.predicate_condition;
+
+    switch (predicate_condition) {
+      case PredicateCondition::Equals:
+      case PredicateCondition::NotEquals:
+      case PredicateCondition::LessThan:
+      case PredicateCondition::LessThanEquals:
+      case PredicateCondition::GreaterThan:
+      case PredicateCondition::GreaterThanEquals: {
+        const auto& binary_predicate = static_cast<const BinaryPredicateExpression&>(expression);
+        return _compile_comparison(predicate_condition, *binary_predicate.left_operand(),
+                                   *binary_predicate.right_operand());
+      }
+
+      case PredicateCondition::BetweenInclusive:
+      case PredicateCondition::BetweenLowerExclusive:
+      case PredicateCondition::BetweenUpperExclusive:
+      case PredicateCondition::BetweenExclusive: {
+        // `a BETWEEN b AND c` --> `a >= b AND a <= c`
+        const auto& between = static_cast<const BetweenExpression&>(expression);
+        const auto lower_node = _compile_comparison(is_lower_inclusive_between(predicate_condition)
+                                                        ? PredicateCondition::GreaterThanEquals
+                                                        : PredicateCondition::GreaterThan,
+                                                    *between.value(), *between.lower_bound());
+        const auto upper_node = _compile_comparison(is_upper_inclusive_between(predicate_condition)
+                                                        ? PredicateCondition::LessThanEquals
+                                                        : PredicateCondition::LessThan,
+                                                    *between.value(), *between.upper_bound());
+        if (!lower_node || !upper_node) return nullptr;
+        return _logical_node(LogicalOperator::And, {lower_node, upper_node});
+      }
+
+      case PredicateCondition::In:
+      case PredicateCondition::NotIn:
+        return _compile_in_list(static_cast<const InExpression&>(expression));
+
+      case PredicateCondition::Like:
+      case PredicateCondition::NotLike:
+        return _compile_like(static_cast<const BinaryPredicateExpression&>(expression));
+
+      case PredicateCondition::IsNull:
+      case PredicateCondition::IsNotNull:
+        return _compile_is_null(static_cast<const IsNullExpression&>(expression));
+    }
+    Fail("Invalid enum value");
+  }
+
+  NodePtr<Bool> _compile_comparison(const PredicateCondition predicate_condition, const AbstractExpression& left,
+                                    const AbstractExpression& right) {
+    const auto evaluation_type = evaluation_data_type(left.data_type(), right.data_type());
+    if (!evaluation_type) return nullptr;
+
+    auto node = NodePtr<Bool>{};
+    resolve_node_type(*evaluation_type, [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      const auto left_node = compile_as<NodeDataType>(left);
+      const auto right_node = compile_as<NodeDataType>(right);
+      if (!left_node || !right_node) return;
+
+      const auto create_node = [&](const auto condition_t) {
+        node = std::make_shared<ComparisonNode<NodeDataType, decltype(condition_t)::value>>(left_node, right_node,
+                                                                                            arena_layout);
+      };
+
+      switch (predicate_condition) {
+        case PredicateCondition::Equals:
+          create_node(std::integral_constant<PredicateCondition, PredicateCondition::Equals>{});
+          break;
+        case PredicateCondition::NotEquals:
+          create_node(std::integral_constant<PredicateCondition, PredicateCondition::NotEquals>{});
+          break;
+        case PredicateCondition::LessThan:
+          create_node(std::integral_constant<PredicateCondition, PredicateCondition::LessThan>{});
+          break;
+        case PredicateCondition::LessThanEquals:
+          create_node(std::integral_constant<PredicateCondition, PredicateCondition::LessThanEquals>{});
+          break;
+        case PredicateCondition::GreaterThan:
+          create_node(std::integral_constant<PredicateCondition, PredicateCondition::GreaterThan>{});
+          break;
+        case PredicateCondition::GreaterThanEquals:
+          create_node(std::integral_constant<PredicateCondition, PredicateCondition::GreaterThanEquals>{});
+          break;
+        default:
+          Fail("Expected comparison");
+      }
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_in_list(const InExpression& expression) {
+    // Same rewrite as in the ExpressionEvaluator:
+    //   `a IN (x, y, z)`       --> `a = x OR a = y OR a = z`
+    //   `a NOT IN (x, y, z)`   --> `a != x AND a != y AND a != z`
+    // Elements whose type cannot be compared with `a` are ignored.
+    const auto list_expression = std::dynamic_pointer_cast<ListExpression>(expression.set());
+    if (!list_expression) return nullptr;
+
+    const auto& value = *expression.value();
+    const auto value_is_string = value.data_type() == DataType::String;
+    const auto predicate_condition =
+        expression.is_negated() ? PredicateCondition::NotEquals : PredicateCondition::Equals;
+
+    auto element_nodes = std::vector<NodePtr<Bool>>{};
+    for (const auto& element : list_expression->elements()) {
+      if ((element->data_type() == DataType::String) != value_is_string) continue;
+
+      const auto element_node = _compile_comparison(predicate_condition, value, *element);
+      if (!element_node) return nullptr;
+      element_nodes.emplace_back(element_node);
+    }
+
+    // `5 IN ()` is FALSE as is `NULL IN ()`
+    if (element_nodes.empty()) return std::make_shared<ValueNode<Bool>>(0);
+    if (element_nodes.size() == 1) return element_nodes.front();
+
+    return _logical_node(expression.is_negated() ? LogicalOperator::And : LogicalOperator::Or,
+                         std::move(element_nodes));
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_like(const BinaryPredicateExpression& expression) {
+    // Only constant patterns are supported, so that the pattern is only resolved once
+    const auto& pattern_expression = *expression.right_operand();
+    if (pattern_expression.type != ExpressionType::Value || pattern_expression.data_type() != DataType::String) {
+      return nullptr;
+    }
+    const auto& pattern = boost::get<pmr_string>(static_cast<const ValueExpression&>(pattern_expression).value);
+
+    const auto operand_node = compile_as<std::string_view>(*expression.left_operand());
+    if (!operand_node) return nullptr;
+
+    const auto invert_results = expression.predicate_condition == PredicateCondition::NotLike;
+    return std::visit(
+        [&](const auto& resolved_pattern) -> std::shared_ptr<const BaseCompiledExpressionNode> {
+          using Pattern = std::decay_t<decltype(resolved_pattern)>;
+          return std::make_shared<LikeNode<Pattern>>(operand_node, resolved_pattern, invert_results, arena_layout);
+        },
+        LikeMatcher::pattern_string_to_pattern_variant(pattern));
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_is_null(const IsNullExpression& expression) {
+    const auto is_not_null = expression.predicate_condition == PredicateCondition::IsNotNull;
+    const auto& operand = *expression.operand();
+    if (is_null_value(operand)) return std::make_shared<ValueNode<Bool>>(!is_not_null);
+
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(operand.data_type(), [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      const auto operand_node = compile_as<NodeDataType>(operand);
+      if (operand_node) node = std::make_shared<IsNullNode<NodeDataType>>(operand_node, is_not_null, arena_layout);
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _compile_case(const CaseExpression& expression) {
+    const auto when_node = compile_as<Bool>(*expression.when());
+    if (!when_node) return nullptr;
+
+    auto node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(expression.data_type(), [&](const auto node_type_t) {
+      using NodeDataType = typename decltype(node_type_t)::type;
+      const auto then_node = compile_as<NodeDataType>(*expression.then());
+      const auto otherwise_node = compile_as<NodeDataType>(*expression.otherwise());
+      if (then_node && otherwise_node) {
+        node = std::make_shared<CaseNode<NodeDataType>>(when_node, then_node, otherwise_node, arena_layout);
+      }
+    });
+    return node;
+  }
+
+  std::shared_ptr<const BaseCompiledExpressionNode> _cast(const std::shared_ptr<const BaseCompiledExpressionNode>& node,
+                                                          const DataType from, const DataType to) {
+    auto cast_node = std::shared_ptr<const BaseCompiledExpressionNode>{};
+    resolve_node_type(from, [&](const auto from_type_t) {
+      using FromDataType = typename decltype(from_type_t)::type;
+      resolve_node_type(to, [&](const auto to_type_t) {
+        using ToDataType = typename decltype(to_type_t)::type;
+        if constexpr (std::is_arithmetic_v<FromDataType> && std::is_arithmetic_v<ToDataType>) {
+          cast_node = std::make_shared<CastNode<ToDataType, FromDataType>>(
+              std::static_pointer_cast<const CompiledExpressionNode<FromDataType>>(node), arena_layout);
+        }
+      });
+    });
+    return cast_node;
+  }
+};
+
+MaterializedColumns materialize_columns(const Table& table, const Chunk& chunk,
+                                        const std::vector<ColumnID>& column_ids) {
+  auto columns = MaterializedColumns(chunk.column_count());
+
+  for (const auto column_id : column_ids) {
+    const auto& segment = *chunk.get_segment(column_id);
+    const auto nullable = table.column_is_nullable(column_id);
+
+    resolve_data_type(segment.data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      auto column = std::make_unique<MaterializedColumn<NodeType<ColumnDataType>>>();
+      column->values.resize(segment.size());
+      if (nullable) column->nulls.resize(segment.size());
+      if constexpr (std::is_same_v<ColumnDataType, pmr_string>) column->strings.resize(segment.size());
+
+      auto chunk_offset = ChunkOffset{0};
+      segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+        if (position.is_null()) {
+          DebugAssert(nullable, "Encountered NULL value in non-nullable column");
+          column->nulls[chunk_offset] = 1;
+        } else if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          column->strings[chunk_offset] = position.value();
+          column->values[chunk_offset] = column->strings[chunk_offset];
+        } else {
+          column->values[chunk_offset] = position.value();
+        }
+        ++chunk_offset;
+      });
+
+      columns[column_id] = std::move(column);
+    });
+  }
+
+  return columns;
+}
+
+}  // namespace
+
+CompiledExpression::CompiledExpression(const std::shared_ptr<const BaseCompiledExpressionNode>& root,
+                                       const DataType data_type, const std::vector<ColumnID>& column_ids,
+                                       const size_t arena_size)
+    : _root(root), _data_type(data_type), _column_ids(column_ids), _arena_size(arena_size) {}
+
+DataType CompiledExpression::data_type() const { return _data_type; }
+
+RowIDPosList CompiledExpression::evaluate_to_pos_list(const Table& table, const ChunkID chunk_id) const {
+  Assert(_data_type == ExpressionEvaluator::DataTypeBool,
+         "Only expressions returning Bool can be evaluated to a PosList");
+
+  const auto& chunk = *table.get_chunk(chunk_id);
+  auto context = EvaluationContext{materialize_columns(table, chunk, _column_ids),
+                                   uninitialized_vector<std::byte>(_arena_size)};
+  const auto& root = static_cast<const CompiledExpressionNode<Bool>&>(*_root);
+
+  auto pos_list = RowIDPosList{};
+  const auto chunk_size = chunk.size();
+  Block<Bool> block;
+  for (auto begin = ChunkOffset{0}; begin < chunk_size; begin += BLOCK_SIZE) {
+    const auto size = std::min(chunk_size - begin, BLOCK_SIZE);
+    root.evaluate(context, begin, size, block);
+
+    const auto* const nulls = nulls_or_zeros(block);
+    for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+      if (!nulls[offset] && block.values[offset]) pos_list.emplace_back(RowID{chunk_id, begin + offset});
+    }
+  }
+
+  return pos_list;
+}
+
+std::shared_ptr<BaseValueSegment> CompiledExpression::evaluate_to_segment(const Table& table,
+                                                                          const ChunkID chunk_id) const {
+  const auto& chunk = *table.get_chunk(chunk_id);
+  auto context = EvaluationContext{materialize_columns(table, chunk, _column_ids),
+                                   uninitialized_vector<std::byte>(_arena_size)};
+  const auto nullable = _root->is_nullable(table);
+  const auto chunk_size = chunk.size();
+
+  auto segment = std::shared_ptr<BaseValueSegment>{};
+  resolve_data_type(_data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    const auto& root = static_cast<const CompiledExpressionNode<NodeType<ColumnDataType>>&>(*_root);
+
+    auto values = pmr_vector<ColumnDataType>(chunk_size);
+    auto nulls = pmr_vector<bool>(nullable ? chunk_size : 0);
+
+    Block<NodeType<ColumnDataType>> block;
+    for (auto begin = ChunkOffset{0}; begin < chunk_size; begin += BLOCK_SIZE) {
+      const auto size = std::min(chunk_size - begin, BLOCK_SIZE);
+      root.evaluate(context, begin, size, block);
+
+      for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+        values[begin + offset] = ColumnDataType{block.values[offset]};
+      }
+
+      if (block.nulls) {
+        DebugAssert(nullable, "Expression is not expected to be NULL");
+        for (auto offset = ChunkOffset{0}; offset < size; ++offset) {
+          nulls[begin + offset] = block.nulls[offset];
+        }
+      }
+    }
+
+    if (nullable) {
+      segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(nulls));
+    } else {
+      segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+    }
+  });
+
+  return segment;
+}
+
+ExpressionCompiler::ExpressionCompiler(const size_t cache_capacity) : _cache_capacity(cache_capacity) {
+  Assert(cache_capacity > 0, "Cache capacity must be positive");
+}
+
+std::shared_ptr<const CompiledExpression> ExpressionCompiler::compile(
+    const std::shared_ptr<const AbstractExpression>& expression) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto cache_iter = _cache.find(expression);
+    if (cache_iter != _cache.end()) {
+      // Mark the expression as the most recently used one
+      _lru_list.splice(_lru_list.begin(), _lru_list, cache_iter->second);
+      return cache_iter->second->second;
+    }
+  }
+
+  // Compile without holding the lock. If two threads compile the same expression concurrently, the first result is
+  // kept.
+  auto compiled_expression = std::shared_ptr<const CompiledExpression>{};
+  auto node_compiler = NodeCompiler{};
+  const auto root = node_compiler.compile(*expression);
+  if (root) {
+    auto& column_ids = node_compiler.column_ids;
+    std::sort(column_ids.begin(), column_ids.end());
+    column_ids.erase(std::unique(column_ids.begin(), column_ids.end()), column_ids.end());
+    compiled_expression = std::make_shared<CompiledExpression>(root, expression->data_type(), column_ids,
+                                                               node_compiler.arena_layout.size());
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto cache_iter = _cache.find(expression);
+  if (cache_iter != _cache.end()) return cache_iter->second->second;
+
+  if (_cache.size() >= _cache_capacity) {
+    _cache.erase(_lru_list.back().first);
+    _lru_list.pop_back();
+  }
+  _lru_list.emplace_front(expression, compiled_expression);
+  _cache.emplace(expression, _lru_list.begin());
+  return compiled_expression;
+}
+
+size_t ExpressionCompiler::cache_size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _cache.size();
+}
+
+}  // namespace opossum
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "expression/abstract_expression.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseCompiledExpressionNode;
+class BaseValueSegment;
+class Table;
+
+/**
+ * An expression that has been compiled by the ExpressionCompiler. Each sub-expression is represented by a node that is
+ * specialized for the data types and the operator of the sub-expression. Evaluating the expression for a chunk first
+ * decompresses the accessed segments and then processes the chunk in blocks of rows. For each block, every node runs
+ * one tight loop over the rows, which keeps the virtual calls per row negligible. Unlike in the ExpressionEvaluator,
+ * no ExpressionResult is materialized for the sub-expressions, the intermediate results of a block stay in the CPU
+ * caches, and operands of AND, OR, and CASE that do not influence the block's result are not evaluated.
+ *
+ * The results are equal to those of the ExpressionEvaluator.
+ */
+class CompiledExpression final {
+ public:
+  CompiledExpression(const std::shared_ptr<const BaseCompiledExpressionNode>& root, const DataType data_type,
+                     const std::vector<ColumnID>& column_ids, const size_t arena_size);
+
+  DataType data_type() const;
+
+  // See ExpressionEvaluator::evaluate_expression_to_pos_list(). Only for expressions returning Bool.
+  RowIDPosList evaluate_to_pos_list(const Table& table, const ChunkID chunk_id) const;
+
+  // See ExpressionEvaluator::evaluate_expression_to_segment()
+  std::shared_ptr<BaseValueSegment> evaluate_to_segment(const Table& table, const ChunkID chunk_id) const;
+
+ private:
+  const std::shared_ptr<const BaseCompiledExpressionNode> _root;
+  const DataType _data_type;
+
+  // The columns that are accessed by the expression
+  const std::vector<ColumnID> _column_ids;
+
+  // The size in bytes of the buffers for the intermediate results of all nodes, which are allocated at once for each
+  // evaluation
+  const size_t _arena_size;
+};
+
+/**
+ * Compiles expressions into CompiledExpressions. When it is set in Hyrise::get().expression_compiler, the TableScan
+ * (for predicates without a specialized scan implementation) and the Projection use compiled expressions instead of
+ * the ExpressionEvaluator whenever possible.
+ *
+ * Compiled expressions are cached by their (deep) hash, so that repeated executions of a query, or of different
+ * queries with the same expressions, do not have to compile them again. Once the cache is full, the least recently
+ * used expression is evicted.
+ *
+ * Columns, values, arithmetics, comparisons (including BETWEEN, IN with lists, LIKE, and IS NULL), logical
+ * expressions, CASE, casts between numeric types, and unary minus are supported. For expressions containing anything
+ * else (e.g., functions, subqueries, or parameters), compile() returns nullptr and the ExpressionEvaluator is used.
+ */
+class ExpressionCompiler : public Noncopyable {
+ public:
+  static constexpr auto DEFAULT_CACHE_CAPACITY = size_t{1'024};
+
+  explicit ExpressionCompiler(const size_t cache_capacity = DEFAULT_CACHE_CAPACITY);
+
+  // Returns nullptr if the expression cannot be compiled
+  std::shared_ptr<const CompiledExpression> compile(const std::shared_ptr<const AbstractExpression>& expression);
+
+  size_t cache_size() const;
+
+ private:
+  const size_t _cache_capacity;
+
+  mutable std::mutex _mutex;
+
+  // The cached expressions, ordered from the most to the least recently used one. Expressions that cannot be compiled
+  // are cached as nullptr.
+  using CacheEntry = std::pair<std::shared_ptr<const AbstractExpression>, std::shared_ptr<const CompiledExpression>>;
+  std::list<CacheEntry> _lru_list;
+
+  ConstExpressionUnorderedMap<std::list<CacheEntry>::iterator> _cache;
+};
+
+}  // namespace opossum
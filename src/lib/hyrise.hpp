@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include <boost/container/pmr/memory_resource.hpp>
 
 #include "concurrency/transaction_manager.hpp"
@@ -16,7 +18,10 @@
 namespace opossum {
 
 class AbstractScheduler;
+class AdmissionControl;
 class BenchmarkRunner;
+class ExpressionCompiler;
+class RedoLog;
 
 // This should be the only singleton in the src/lib world. It provides a unified way of accessing components like the
 // storage manager, the transaction manager, and more. Encapsulating this in one class avoids the static initialization
@@ -53,6 +58,26 @@ class Hyrise : public Singleton<Hyrise> {
   std::shared_ptr<SQLPhysicalPlanCache> default_pqp_cache;
   std::shared_ptr<SQLLogicalPlanCache> default_lqp_cache;
 
+  // If set, transactions only become visible once their modifications have been written to the redo log. nullptr
+  // disables logging. It is placed after the TransactionManager so that it is destructed (and pending log records are
+  // flushed) first.
+  std::shared_ptr<RedoLog> redo_log;
+
+  // If set, limits the number of queries that are executed concurrently. nullptr admits all queries immediately.
+  std::shared_ptr<AdmissionControl> admission_control;
+
+  // If set, the TableScan and the Projection evaluate expressions that it can compile with compiled expressions.
+  // nullptr uses the ExpressionEvaluator for all expressions.
+  std::shared_ptr<ExpressionCompiler> expression_compiler;
+
+  // If set, the LQPTranslator passes this memory budget (in bytes) to operators that can spill to disk (i.e., Sort and
+  // AggregateHash). std::nullopt does not limit their memory usage.
+  std::optional<size_t> operator_memory_budget;
+
+  // If set, the SQLPipelineStatement pushes Bloom filters of hash joins into the TableScans of their inputs (see
+  // JoinHash::push_down_bloom_filters).
+  bool runtime_bloom_filters = false;
+
   // The BenchmarkRunner is available here so that non-benchmark components can add information to the benchmark
   // result JSON.
   std::weak_ptr<BenchmarkRunner> benchmark_runner;
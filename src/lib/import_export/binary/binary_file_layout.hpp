@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Layouts of binary table files. Both layouts share the fields described in BinaryWriter. They only differ in where
+ * the buffers of values (i.e., all fields that are arrays) start.
+ */
+enum class BinaryFileLayout : uint8_t {
+  // All fields are written back to back.
+  Packed,
+  // Buffers of at least PAGE_ALIGNED_BUFFER_MIN_SIZE bytes start at a multiple of BINARY_FILE_PAGE_SIZE and are
+  // preceded by zero padding. The BinaryParser maps these buffers into the segments instead of copying them. Smaller
+  // buffers are written back to back, as they would waste most of a page and each mapping costs a page fault.
+  PageAligned
+};
+
+// Packed files start with the chunk size, which can never be INVALID_CHUNK_OFFSET. Page-aligned files start with this
+// marker, followed by the layout (as uint8_t) and the fields of packed files.
+constexpr auto PAGE_ALIGNED_BINARY_FILE_MARKER = INVALID_CHUNK_OFFSET;
+
+constexpr size_t BINARY_FILE_PAGE_SIZE = 4096;
+constexpr size_t PAGE_ALIGNED_BUFFER_MIN_SIZE = 16 * BINARY_FILE_PAGE_SIZE;
+
+inline bool is_page_aligned_buffer(const BinaryFileLayout layout, const size_t bytes) {
+  return layout == BinaryFileLayout::PageAligned && bytes >= PAGE_ALIGNED_BUFFER_MIN_SIZE;
+}
+
+}  // namespace opossum
@@ -1,15 +1,18 @@
 #include "binary_parser.hpp"
 
 #include <cstdint>
-#include <fstream>
+#include <cstring>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
+#include "import_export/mapped_file.hpp"
+#include "memory/mapped_pages_memory_resource.hpp"
 #include "resolve_type.hpp"
 #include "storage/chunk.hpp"
 #include "storage/encoding_type.hpp"
@@ -21,9 +24,10 @@
 namespace opossum {
 
 std::shared_ptr<Table> BinaryParser::parse(const std::string& filename) {
-  std::ifstream file;
-  file.open(filename, std::ios::binary);
-  file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  const auto mapped_file = MappedFile{filename};
+  mapped_file.advise_sequential_access();
+  auto file = MappedFileCursor{mapped_file.data(), mapped_file.data(), mapped_file.data() + mapped_file.size(),
+                               mapped_file.file_descriptor()};
 
   auto [table, chunk_count] = _read_header(file);
   for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
@@ -33,45 +37,97 @@ std::shared_ptr<Table> BinaryParser::parse(const std::string& filename) {
   return table;
 }
 
+const char* BinaryParser::MappedFileCursor::read(const size_t bytes) {
+  Assert(static_cast<size_t>(end - position) >= bytes, "Unexpected end of binary file");
+  const auto data = position;
+  position += bytes;
+  return data;
+}
+
+const char* BinaryParser::MappedFileCursor::read_buffer(const size_t bytes) {
+  if (is_page_aligned_buffer(layout, bytes)) {
+    const auto offset = static_cast<size_t>(position - begin);
+    read((BINARY_FILE_PAGE_SIZE - offset % BINARY_FILE_PAGE_SIZE) % BINARY_FILE_PAGE_SIZE);
+  }
+  return read(bytes);
+}
+
+bool BinaryParser::MappedFileCursor::can_map(const char* buffer, const size_t bytes) const {
+  // If the OS uses pages larger than those of the file format, only some of the buffers can be mapped.
+  return is_page_aligned_buffer(layout, bytes) &&
+         static_cast<size_t>(buffer - begin) % MappedPagesMemoryResource::page_size() == 0;
+}
+
 template <typename T>
-pmr_compact_vector BinaryParser::_read_values_compact_vector(std::ifstream& file, const size_t count) {
+pmr_compact_vector BinaryParser::_read_values_compact_vector(MappedFileCursor& file, const size_t count) {
   const auto bit_width = _read_value<uint8_t>(file);
-  auto values = pmr_compact_vector(bit_width, count);
-  file.read(reinterpret_cast<char*>(values.get()), values.bytes());
+
+  // The exact size of the vector's buffer is only known once it is allocated, so the resource is chosen based on an
+  // estimate. If the buffer cannot be mapped, the values are copied into it.
+  const auto estimated_bytes = (count * bit_width + 63) / 64 * sizeof(uint64_t);
+  auto& mapped_pages_resource = MappedPagesMemoryResource::get();
+  auto* const resource = is_page_aligned_buffer(file.layout, estimated_bytes)
+                             ? &mapped_pages_resource
+                             : boost::container::pmr::get_default_resource();
+
+  auto values = pmr_compact_vector(bit_width, count, PolymorphicAllocator<uint64_t>{resource});
+  const auto bytes = values.bytes();
+  const auto data = file.read_buffer(bytes);
+  if (resource == &mapped_pages_resource && file.can_map(data, bytes)) {
+    mapped_pages_resource.map_file_pages(values.get(), bytes, file.file_descriptor,
+                                         static_cast<size_t>(data - file.begin));
+  } else if (bytes > 0) {
+    std::memcpy(values.get(), data, bytes);
+  }
   return values;
 }
 
 template <typename T>
-pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<T> BinaryParser::_read_values(MappedFileCursor& file, const size_t count) {
+  static_assert(std::is_trivially_copyable_v<T>, "Values can only be copied or mapped from the file byte by byte");
+  const auto bytes = count * sizeof(T);
+  const auto data = file.read_buffer(bytes);
+
+  if (file.can_map(data, bytes)) {
+    auto& mapped_pages_resource = MappedPagesMemoryResource::get();
+    auto values = pmr_vector<T>(count, PolymorphicAllocator<T>{&mapped_pages_resource});
+    mapped_pages_resource.map_file_pages(values.data(), bytes, file.file_descriptor,
+                                         static_cast<size_t>(data - file.begin));
+    return values;
+  }
+
+  // Packed files do not guarantee any alignment, so the values cannot be accessed in place.
   pmr_vector<T> values(count);
-  file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+  if (count > 0) std::memcpy(values.data(), data, bytes);
   return values;
 }
 
 // specialized implementation for string values
 template <>
-pmr_vector<pmr_string> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_values(MappedFileCursor& file, const size_t count) {
   return _read_string_values(file, count);
 }
 
 // specialized implementation for bool values
 template <>
-pmr_vector<bool> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
-  pmr_vector<BoolAsByteType> readable_bools(count);
-  file.read(reinterpret_cast<char*>(readable_bools.data()), readable_bools.size() * sizeof(BoolAsByteType));
-  return pmr_vector<bool>(readable_bools.begin(), readable_bools.end());
+pmr_vector<bool> BinaryParser::_read_values(MappedFileCursor& file, const size_t count) {
+  // std::vector<bool> stores bits, so the bytes of the file always have to be converted.
+  const auto readable_bools =
+      reinterpret_cast<const BoolAsByteType*>(file.read_buffer(count * sizeof(BoolAsByteType)));
+  return pmr_vector<bool>(readable_bools, readable_bools + count);
 }
 
-pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_string_values(MappedFileCursor& file, const size_t count) {
   const auto string_lengths = _read_values<size_t>(file, count);
   const auto total_length = std::accumulate(string_lengths.cbegin(), string_lengths.cend(), static_cast<size_t>(0));
-  const auto buffer = _read_values<char>(file, total_length);
+  // The characters are copied from the mapped file into the strings.
+  const auto buffer = file.read_buffer(total_length);
 
   pmr_vector<pmr_string> values(count);
   size_t start = 0;
 
   for (size_t i = 0; i < count; ++i) {
-    values[i] = pmr_string(buffer.data() + start, buffer.data() + start + string_lengths[i]);
+    values[i] = pmr_string(buffer + start, buffer + start + string_lengths[i]);
     start += string_lengths[i];
   }
 
@@ -79,14 +135,20 @@ pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, co
 }
 
 template <typename T>
-T BinaryParser::_read_value(std::ifstream& file) {
+T BinaryParser::_read_value(MappedFileCursor& file) {
   T result;
-  file.read(reinterpret_cast<char*>(&result), sizeof(T));
+  std::memcpy(&result, file.read(sizeof(T)), sizeof(T));
   return result;
 }
 
-std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstream& file) {
-  const auto chunk_size = _read_value<ChunkOffset>(file);
+std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(MappedFileCursor& file) {
+  auto chunk_size = _read_value<ChunkOffset>(file);
+  if (chunk_size == PAGE_ALIGNED_BINARY_FILE_MARKER) {
+    file.layout = _read_value<BinaryFileLayout>(file);
+    Assert(file.layout == BinaryFileLayout::PageAligned, "Unknown binary file layout");
+    chunk_size = _read_value<ChunkOffset>(file);
+  }
+
   const auto chunk_count = _read_value<ChunkID>(file);
   const auto column_count = _read_value<ColumnID>(file);
   const auto column_data_types = _read_values<pmr_string>(file, column_count);
@@ -105,7 +167,7 @@ std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstr
   return std::make_pair(table, chunk_count);
 }
 
-void BinaryParser::_import_chunk(std::ifstream& file, std::shared_ptr<Table>& table) {
+void BinaryParser::_import_chunk(MappedFileCursor& file, std::shared_ptr<Table>& table) {
   const auto row_count = _read_value<ChunkOffset>(file);
 
   // Import sort column definitions
@@ -129,7 +191,7 @@ void BinaryParser::_import_chunk(std::ifstream& file, std::shared_ptr<Table>& ta
   if (num_sorted_columns > 0) table->last_chunk()->set_individually_sorted_by(sorted_columns);
 }
 
-std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(MappedFileCursor& file, ChunkOffset row_count,
                                                                DataType data_type, bool column_is_nullable) {
   std::shared_ptr<AbstractSegment> result;
   resolve_data_type(data_type, [&](auto type) {
@@ -141,7 +203,7 @@ std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& fi
 }
 
 template <typename ColumnDataType>
-std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(MappedFileCursor& file, ChunkOffset row_count,
                                                                bool column_is_nullable) {
   const auto column_type = _read_value<EncodingType>(file);
 
@@ -168,13 +230,34 @@ std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& fi
       }
     case EncodingType::LZ4:
       return _import_lz4_segment<ColumnDataType>(file, row_count);
+    case EncodingType::FSST:
+      if constexpr (encoding_supports_data_type(enum_c<EncodingType, EncodingType::FSST>,
+                                                hana::type_c<ColumnDataType>)) {
+        return _import_fsst_segment(file, row_count);
+      } else {
+        Fail("Unsupported data type for FSST encoding");
+      }
+    case EncodingType::Delta:
+      if constexpr (encoding_supports_data_type(enum_c<EncodingType, EncodingType::Delta>,
+                                                hana::type_c<ColumnDataType>)) {
+        return _import_delta_segment<ColumnDataType>(file, row_count);
+      } else {
+        Fail("Unsupported data type for Delta encoding");
+      }
+    case EncodingType::ALP:
+      if constexpr (encoding_supports_data_type(enum_c<EncodingType, EncodingType::ALP>,
+                                                hana::type_c<ColumnDataType>)) {
+        return _import_alp_segment<ColumnDataType>(file, row_count);
+      } else {
+        Fail("Unsupported data type for ALP encoding");
+      }
   }
 
   Fail("Invalid EncodingType");
 }
 
 template <typename T>
-std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(MappedFileCursor& file, ChunkOffset row_count,
                                                                      bool column_is_nullable) {
   if (column_is_nullable) {
     const auto segment_is_nullable = _read_value<bool>(file);
@@ -190,7 +273,7 @@ std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstre
 }
 
 template <typename T>
-std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::ifstream& file,
+std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(MappedFileCursor& file,
                                                                                ChunkOffset row_count) {
   const auto compressed_vector_type_id = _read_value<CompressedVectorTypeID>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
@@ -202,7 +285,7 @@ std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(s
 }
 
 std::shared_ptr<FixedStringDictionarySegment<pmr_string>> BinaryParser::_import_fixed_string_dictionary_segment(
-    std::ifstream& file, ChunkOffset row_count) {
+    MappedFileCursor& file, ChunkOffset row_count) {
   const auto compressed_vector_type_id = _read_value<CompressedVectorTypeID>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
   auto dictionary = _import_fixed_string_vector(file, dictionary_size);
@@ -212,7 +295,7 @@ std::shared_ptr<FixedStringDictionarySegment<pmr_string>> BinaryParser::_import_
 }
 
 template <typename T>
-std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::ifstream& file,
+std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(MappedFileCursor& file,
                                                                               ChunkOffset row_count) {
   const auto size = _read_value<uint32_t>(file);
   const auto values = std::make_shared<pmr_vector<T>>(_read_values<T>(file, size));
@@ -223,12 +306,20 @@ std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(st
 }
 
 template <typename T>
-std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::ifstream& file,
+std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(MappedFileCursor& file,
                                                                                              ChunkOffset row_count) {
   const auto compressed_vector_type_id = _read_value<CompressedVectorTypeID>(file);
   const auto block_count = _read_value<uint32_t>(file);
   const auto block_minima = pmr_vector<T>(_read_values<T>(file, block_count));
 
+  auto exception_positions = pmr_vector<ChunkOffset>{};
+  auto exception_values = pmr_vector<T>{};
+  if constexpr (std::is_same_v<T, int64_t>) {
+    const auto exception_count = _read_value<uint32_t>(file);
+    exception_positions = _read_values<ChunkOffset>(file, exception_count);
+    exception_values = _read_values<T>(file, exception_count);
+  }
+
   const auto null_values_stored = _read_value<BoolAsByteType>(file);
   std::optional<pmr_vector<bool>> null_values;
   if (null_values_stored) {
@@ -237,11 +328,13 @@ std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_refer
 
   auto offset_values = _import_offset_value_vector(file, row_count, compressed_vector_type_id);
 
-  return std::make_shared<FrameOfReferenceSegment<T>>(block_minima, null_values, std::move(offset_values));
+  return std::make_shared<FrameOfReferenceSegment<T>>(block_minima, std::move(exception_positions),
+                                                      std::move(exception_values), null_values,
+                                                      std::move(offset_values));
 }
 
 template <typename T>
-std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream& file, ChunkOffset row_count) {
+std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(MappedFileCursor& file, ChunkOffset row_count) {
   const auto num_elements = _read_value<uint32_t>(file);
   const auto block_count = _read_value<uint32_t>(file);
   const auto block_size = _read_value<uint32_t>(file);
@@ -285,8 +378,81 @@ std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream&
   }
 }
 
+std::shared_ptr<FSSTSegment<pmr_string>> BinaryParser::_import_fsst_segment(MappedFileCursor& file,
+                                                                           ChunkOffset row_count) {
+  const auto compressed_vector_type_id = _read_value<CompressedVectorTypeID>(file);
+
+  const auto symbol_count = _read_value<uint32_t>(file);
+  auto symbol_lengths = _read_values<uint8_t>(file, symbol_count);
+  auto symbols = _read_values<FSSTSymbolTable::Symbol>(file, symbol_count);
+  auto symbol_table = FSSTSymbolTable{std::move(symbols), std::move(symbol_lengths)};
+
+  const auto compressed_values_size = _read_value<uint32_t>(file);
+  auto compressed_values = _read_values<char>(file, compressed_values_size);
+
+  const auto null_values_stored = _read_value<BoolAsByteType>(file);
+  std::optional<pmr_vector<bool>> null_values;
+  if (null_values_stored) {
+    null_values = pmr_vector<bool>(_read_values<bool>(file, row_count));
+  }
+
+  // FSSTSegments store one offset more than they have rows
+  auto offsets = _import_offset_value_vector(file, row_count + 1, compressed_vector_type_id);
+
+  return std::make_shared<FSSTSegment<pmr_string>>(std::move(symbol_table), std::move(compressed_values),
+                                                   std::move(offsets), std::move(null_values));
+}
+
+template <typename T>
+std::shared_ptr<DeltaSegment<T>> BinaryParser::_import_delta_segment(MappedFileCursor& file, ChunkOffset row_count) {
+  const auto compressed_vector_type_id = _read_value<CompressedVectorTypeID>(file);
+  const auto block_count = _read_value<uint32_t>(file);
+  auto block_bases = _read_values<T>(file, block_count);
+  auto block_minimum_deltas = _read_values<T>(file, block_count);
+
+  const auto exception_count = _read_value<uint32_t>(file);
+  auto exception_positions = _read_values<ChunkOffset>(file, exception_count);
+  auto exception_values = _read_values<T>(file, exception_count);
+
+  const auto null_values_stored = _read_value<BoolAsByteType>(file);
+  std::optional<pmr_vector<bool>> null_values;
+  if (null_values_stored) {
+    null_values = pmr_vector<bool>(_read_values<bool>(file, row_count));
+  }
+
+  auto offset_values = _import_offset_value_vector(file, row_count, compressed_vector_type_id);
+
+  return std::make_shared<DeltaSegment<T>>(std::move(block_bases), std::move(block_minimum_deltas),
+                                           std::move(exception_positions), std::move(exception_values),
+                                           std::move(null_values), std::move(offset_values));
+}
+
+template <typename T>
+std::shared_ptr<ALPSegment<T>> BinaryParser::_import_alp_segment(MappedFileCursor& file, ChunkOffset row_count) {
+  const auto compressed_vector_type_id = _read_value<CompressedVectorTypeID>(file);
+  const auto exponent = _read_value<uint8_t>(file);
+  const auto block_count = _read_value<uint32_t>(file);
+  auto block_minima = _read_values<int64_t>(file, block_count);
+
+  const auto exception_count = _read_value<uint32_t>(file);
+  auto exception_positions = _read_values<ChunkOffset>(file, exception_count);
+  auto exception_values = _read_values<T>(file, exception_count);
+
+  const auto null_values_stored = _read_value<BoolAsByteType>(file);
+  std::optional<pmr_vector<bool>> null_values;
+  if (null_values_stored) {
+    null_values = pmr_vector<bool>(_read_values<bool>(file, row_count));
+  }
+
+  auto offset_values = _import_offset_value_vector(file, row_count, compressed_vector_type_id);
+
+  return std::make_shared<ALPSegment<T>>(exponent, std::move(block_minima), std::move(exception_positions),
+                                         std::move(exception_values), std::move(null_values),
+                                         std::move(offset_values));
+}
+
 std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
-    std::ifstream& file, const ChunkOffset row_count, const CompressedVectorTypeID compressed_vector_type_id) {
+    MappedFileCursor& file, const ChunkOffset row_count, const CompressedVectorTypeID compressed_vector_type_id) {
   const auto compressed_vector_type = static_cast<CompressedVectorType>(compressed_vector_type_id);
   switch (compressed_vector_type) {
     case CompressedVectorType::BitPacking:
@@ -304,7 +470,7 @@ std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
 }
 
 std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_vector(
-    std::ifstream& file, const ChunkOffset row_count, const CompressedVectorTypeID compressed_vector_type_id) {
+    MappedFileCursor& file, const ChunkOffset row_count, const CompressedVectorTypeID compressed_vector_type_id) {
   const auto compressed_vector_type = static_cast<CompressedVectorType>(compressed_vector_type_id);
   switch (compressed_vector_type) {
     case CompressedVectorType::BitPacking:
@@ -321,10 +487,10 @@ std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_v
   }
 }
 
-std::shared_ptr<FixedStringVector> BinaryParser::_import_fixed_string_vector(std::ifstream& file, const size_t count) {
+std::shared_ptr<FixedStringVector> BinaryParser::_import_fixed_string_vector(MappedFileCursor& file,
+                                                                             const size_t count) {
   const auto string_length = _read_value<uint32_t>(file);
-  pmr_vector<char> values(string_length * count);
-  file.read(values.data(), values.size());
+  auto values = _read_values<char>(file, string_length * count);
   return std::make_shared<FixedStringVector>(std::move(values), string_length);
 }
 
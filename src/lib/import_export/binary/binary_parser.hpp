@@ -1,17 +1,20 @@
 #pragma once
 
-#include <fstream>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "import_export/binary/binary_file_layout.hpp"
 #include "storage/abstract_segment.hpp"
+#include "storage/alp_segment.hpp"
+#include "storage/delta_segment.hpp"
 #include "storage/dictionary_segment.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/fixed_string_dictionary_segment.hpp"
 #include "storage/frame_of_reference_segment.hpp"
+#include "storage/fsst_segment.hpp"
 #include "storage/lz4_segment.hpp"
 #include "storage/run_length_segment.hpp"
 #include "storage/table.hpp"
@@ -23,6 +26,13 @@ namespace opossum {
 /*
  * This parser reads an Opossum binary file and creates a table from that input.
  * Documentation of the file formats can be found in BinaryWriter header file.
+ *
+ * The file is memory-mapped (see MappedFile) instead of being read through an std::ifstream. For packed files, all
+ * values are copied (or decoded) from the mapping into the segments. For page-aligned files (see BinaryFileLayout), the
+ * large buffers of fixed-size values (e.g., values of ValueSegments, dictionaries, attribute vectors) are not copied.
+ * Instead, their pages of the file are mapped into the segments through the MappedPagesMemoryResource. The buffers are
+ * still allocated and zero-initialized by their vectors before the file is mapped over them, but their values are
+ * only read from disk when they are accessed, and the OS can evict them from memory like any cached file.
  */
 class BinaryParser {
  public:
@@ -40,12 +50,30 @@ class BinaryParser {
   static std::shared_ptr<Table> parse(const std::string& filename);
 
  private:
+  // Position in the memory-mapped file. Reading beyond the end of the file fails.
+  struct MappedFileCursor {
+    // Returns a pointer to the next `bytes` bytes of the file and advances the position by as many bytes.
+    const char* read(const size_t bytes);
+
+    // Like read, but first skips the padding that precedes buffers of this size in the file's layout.
+    const char* read_buffer(const size_t bytes);
+
+    // Whether a buffer returned by read_buffer can be mapped into a segment instead of being copied.
+    bool can_map(const char* buffer, const size_t bytes) const;
+
+    const char* begin;
+    const char* position;
+    const char* end;
+    int file_descriptor;
+    BinaryFileLayout layout{BinaryFileLayout::Packed};
+  };
+
   /*
    * Reads the header from the given file.
    * Creates an empty table from the extracted information and
    * returns that table and the number of chunks.
    */
-  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::ifstream& file);
+  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(MappedFileCursor& file);
 
   /*
    * Creates a chunk from chunk information from the given file and adds it to the given table.
@@ -59,58 +87,68 @@ class BinaryParser {
    *
    * ¹Number of columns is provided in the binary header
    */
-  static void _import_chunk(std::ifstream& file, std::shared_ptr<Table>& table);
+  static void _import_chunk(MappedFileCursor& file, std::shared_ptr<Table>& table);
 
   // Calls the right _import_column<ColumnDataType> depending on the given data_type.
-  static std::shared_ptr<AbstractSegment> _import_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<AbstractSegment> _import_segment(MappedFileCursor& file, ChunkOffset row_count,
                                                           DataType data_type, bool column_is_nullable);
 
   template <typename ColumnDataType>
   // Reads the column type from the given file and chooses a segment import function from it.
-  static std::shared_ptr<AbstractSegment> _import_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<AbstractSegment> _import_segment(MappedFileCursor& file, ChunkOffset row_count,
                                                           bool column_is_nullable);
 
   template <typename T>
-  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<ValueSegment<T>> _import_value_segment(MappedFileCursor& file, ChunkOffset row_count,
                                                                 bool column_is_nullable);
   template <typename T>
-  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(MappedFileCursor& file,
+                                                                          ChunkOffset row_count);
 
   static std::shared_ptr<FixedStringDictionarySegment<pmr_string>> _import_fixed_string_dictionary_segment(
-      std::ifstream& file, ChunkOffset row_count);
+      MappedFileCursor& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(MappedFileCursor& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::ifstream& file,
+  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(MappedFileCursor& file,
                                                                                         ChunkOffset row_count);
   template <typename T>
-  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(MappedFileCursor& file, ChunkOffset row_count);
+
+  static std::shared_ptr<FSSTSegment<pmr_string>> _import_fsst_segment(MappedFileCursor& file, ChunkOffset row_count);
+
+  template <typename T>
+  static std::shared_ptr<DeltaSegment<T>> _import_delta_segment(MappedFileCursor& file, ChunkOffset row_count);
+
+  template <typename T>
+  static std::shared_ptr<ALPSegment<T>> _import_alp_segment(MappedFileCursor& file, ChunkOffset row_count);
 
   // Calls the _import_attribute_vector<uintX_t> function that corresponds to the given compressed_vector_type_id.
   static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(
-      std::ifstream& file, ChunkOffset row_count, CompressedVectorTypeID compressed_vector_type_id);
+      MappedFileCursor& file, ChunkOffset row_count, CompressedVectorTypeID compressed_vector_type_id);
 
   static std::unique_ptr<const BaseCompressedVector> _import_offset_value_vector(
-      std::ifstream& file, ChunkOffset row_count, CompressedVectorTypeID compressed_vector_type_id);
+      MappedFileCursor& file, ChunkOffset row_count, CompressedVectorTypeID compressed_vector_type_id);
 
-  static std::shared_ptr<FixedStringVector> _import_fixed_string_vector(std::ifstream& file, const size_t count);
+  static std::shared_ptr<FixedStringVector> _import_fixed_string_vector(MappedFileCursor& file, const size_t count);
 
-  // Reads row_count many values from type T and returns them in a vector
+  // Reads row_count many values from type T and returns them in a vector. If possible, the vector references the
+  // mapped pages of the file instead of a copy of the values.
   template <typename T>
-  static pmr_vector<T> _read_values(std::ifstream& file, const size_t count);
+  static pmr_vector<T> _read_values(MappedFileCursor& file, const size_t count);
 
   // Reads bit width and row_count many values and returns them in a bitpacked compact_vector of type T
   template <typename T>
-  static pmr_compact_vector _read_values_compact_vector(std::ifstream& file, const size_t count);
+  static pmr_compact_vector _read_values_compact_vector(MappedFileCursor& file, const size_t count);
 
   // Reads row_count many strings from input file. String lengths are encoded in type T.
-  static pmr_vector<pmr_string> _read_string_values(std::ifstream& file, const size_t count);
+  static pmr_vector<pmr_string> _read_string_values(MappedFileCursor& file, const size_t count);
 
   // Reads a single value of type T from the input file.
   template <typename T>
-  static T _read_value(std::ifstream& file);
+  static T _read_value(MappedFileCursor& file);
 };
 
 }  // namespace opossum
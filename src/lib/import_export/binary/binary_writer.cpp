@@ -1,11 +1,14 @@
 #include "binary_writer.hpp"
 
+#include <array>
 #include <cstring>
 #include <fstream>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
+#include "import_export/binary/binary_file_layout.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/vector_compression/bitpacking/bitpacking_vector.hpp"
@@ -21,6 +24,23 @@ namespace {
 
 using namespace opossum;  // NOLINT
 
+// The layout is stored in the stream (see std::ios_base::iword) so that the functions writing buffers can align them
+// without passing the layout through all of the writer's functions.
+int layout_index() {
+  static const auto index = std::ios_base::xalloc();
+  return index;
+}
+
+// Pads the file so that a buffer of the given size starts at a page boundary if the layout requires it.
+void align_buffer(std::ofstream& ofstream, const size_t bytes) {
+  const auto layout = static_cast<BinaryFileLayout>(ofstream.iword(layout_index()));
+  if (!is_page_aligned_buffer(layout, bytes)) return;
+
+  static const auto zeros = std::array<char, BINARY_FILE_PAGE_SIZE>{};
+  const auto position = static_cast<size_t>(ofstream.tellp());
+  ofstream.write(zeros.data(), (BINARY_FILE_PAGE_SIZE - position % BINARY_FILE_PAGE_SIZE) % BINARY_FILE_PAGE_SIZE);
+}
+
 // Writes the content of the vector to the ofstream
 template <typename T, typename Alloc>
 void export_values(std::ofstream& ofstream, const std::vector<T, Alloc>& values);
@@ -60,10 +80,12 @@ void export_string_values(std::ofstream& ofstream, const pmr_vector<pmr_string>&
 
 template <typename T, typename Alloc>
 void export_values(std::ofstream& ofstream, const std::vector<T, Alloc>& values) {
+  align_buffer(ofstream, values.size() * sizeof(T));
   ofstream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
 }
 
 void export_values(std::ofstream& ofstream, const FixedStringVector& values) {
+  align_buffer(ofstream, values.size() * values.string_length());
   ofstream.write(values.data(), values.size() * values.string_length());
 }
 
@@ -89,6 +111,7 @@ void export_value(std::ofstream& ofstream, const T& value) {
 
 void export_compact_vector(std::ofstream& ofstream, const pmr_compact_vector& values) {
   export_value(ofstream, static_cast<uint8_t>(values.bits()));
+  align_buffer(ofstream, values.bytes());
   ofstream.write(reinterpret_cast<const char*>(values.get()), values.bytes());
 }
 
@@ -96,11 +119,17 @@ void export_compact_vector(std::ofstream& ofstream, const pmr_compact_vector& va
 
 namespace opossum {
 
-void BinaryWriter::write(const Table& table, const std::string& filename) {
+void BinaryWriter::write(const Table& table, const std::string& filename, const BinaryFileLayout layout) {
   std::ofstream ofstream;
   ofstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
   ofstream.open(filename, std::ios::binary);
 
+  if (layout != BinaryFileLayout::Packed) {
+    export_value(ofstream, PAGE_ALIGNED_BINARY_FILE_MARKER);
+    export_value(ofstream, layout);
+  }
+  ofstream.iword(layout_index()) = static_cast<long>(layout);  // NOLINT(runtime/int)
+
   _write_header(table, ofstream);
 
   for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); chunk_id++) {
@@ -188,11 +217,13 @@ void BinaryWriter::_write_segment(const ReferenceSegment& reference_segment, boo
       });
 
       export_values(ofstream, string_lengths);
+      align_buffer(ofstream, std::accumulate(string_lengths.cbegin(), string_lengths.cend(), size_t{0}));
       ofstream << values.rdbuf();
 
     } else {
       // Unfortunately, we have to iterate over all values of the reference segment
       // to materialize its contents. Then we can write them to the file
+      align_buffer(ofstream, reference_segment.size() * sizeof(SegmentDataType));
       iterable.for_each([&](const auto& value) { export_value(ofstream, value.value()); });
     }
   });
@@ -253,19 +284,26 @@ void BinaryWriter::_write_segment(const RunLengthSegment<T>& run_length_segment,
   export_values(ofstream, *run_length_segment.end_positions());
 }
 
-template <>
-void BinaryWriter::_write_segment(const FrameOfReferenceSegment<int32_t>& frame_of_reference_segment,
-                                  bool column_is_nullable, std::ofstream& ofstream) {
+template <typename T>
+void BinaryWriter::_write_segment(const FrameOfReferenceSegment<T>& frame_of_reference_segment, bool column_is_nullable,
+                                  std::ofstream& ofstream) {
   export_value(ofstream, EncodingType::FrameOfReference);
 
   // Write attribute vector compression id
-  const auto compressed_vector_type_id = _compressed_vector_type_id<int32_t>(frame_of_reference_segment);
+  const auto compressed_vector_type_id = _compressed_vector_type_id<T>(frame_of_reference_segment);
   export_value(ofstream, compressed_vector_type_id);
 
   // Write number of blocks and block minima
   export_value(ofstream, static_cast<uint32_t>(frame_of_reference_segment.block_minima().size()));
   export_values(ofstream, frame_of_reference_segment.block_minima());
 
+  // Write exceptions, which only int64_t segments can have
+  if constexpr (std::is_same_v<T, int64_t>) {
+    export_value(ofstream, static_cast<uint32_t>(frame_of_reference_segment.exception_positions().size()));
+    export_values(ofstream, frame_of_reference_segment.exception_positions());
+    export_values(ofstream, frame_of_reference_segment.exception_values());
+  }
+
   // Write flag if optional NULL value vector is written
   export_value(ofstream, static_cast<BoolAsByteType>(frame_of_reference_segment.null_values().has_value()));
   if (frame_of_reference_segment.null_values()) {
@@ -295,6 +333,7 @@ void BinaryWriter::_write_segment(const LZ4Segment<T>& lz4_segment, bool column_
   export_value(ofstream, static_cast<uint32_t>(lz4_segment.last_block_size()));
 
   // Write compressed size for each LZ4 Block
+  align_buffer(ofstream, lz4_segment.lz4_blocks().size() * sizeof(uint32_t));
   for (const auto& lz4_block : lz4_segment.lz4_blocks()) {
     export_value(ofstream, static_cast<uint32_t>(lz4_block.size()));
   }
@@ -331,6 +370,95 @@ void BinaryWriter::_write_segment(const LZ4Segment<T>& lz4_segment, bool column_
   }
 }
 
+template <typename T>
+void BinaryWriter::_write_segment(const FSSTSegment<T>& fsst_segment, bool column_is_nullable,
+                                  std::ofstream& ofstream) {
+  export_value(ofstream, EncodingType::FSST);
+
+  // Write offsets compression id
+  const auto compressed_vector_type_id = _compressed_vector_type_id<T>(fsst_segment);
+  export_value(ofstream, compressed_vector_type_id);
+
+  // Write symbol table
+  const auto& symbol_table = fsst_segment.symbol_table();
+  export_value(ofstream, static_cast<uint32_t>(symbol_table.symbols().size()));
+  export_values(ofstream, symbol_table.symbol_lengths());
+  export_values(ofstream, symbol_table.symbols());
+
+  // Write compressed values
+  export_value(ofstream, static_cast<uint32_t>(fsst_segment.compressed_values().size()));
+  export_values(ofstream, fsst_segment.compressed_values());
+
+  // Write flag if optional NULL value vector is written
+  export_value(ofstream, static_cast<BoolAsByteType>(fsst_segment.null_values().has_value()));
+  if (fsst_segment.null_values()) {
+    // Write NULL values
+    export_values(ofstream, *fsst_segment.null_values());
+  }
+
+  // Write offsets
+  _export_compressed_vector(ofstream, *fsst_segment.compressed_vector_type(), fsst_segment.offsets());
+}
+
+template <typename T>
+void BinaryWriter::_write_segment(const DeltaSegment<T>& delta_segment, bool column_is_nullable,
+                                  std::ofstream& ofstream) {
+  export_value(ofstream, EncodingType::Delta);
+
+  // Write offsets compression id
+  const auto compressed_vector_type_id = _compressed_vector_type_id<T>(delta_segment);
+  export_value(ofstream, compressed_vector_type_id);
+
+  // Write number of blocks, block bases, and minimum deltas
+  export_value(ofstream, static_cast<uint32_t>(delta_segment.block_bases().size()));
+  export_values(ofstream, delta_segment.block_bases());
+  export_values(ofstream, delta_segment.block_minimum_deltas());
+
+  // Write exceptions
+  export_value(ofstream, static_cast<uint32_t>(delta_segment.exception_positions().size()));
+  export_values(ofstream, delta_segment.exception_positions());
+  export_values(ofstream, delta_segment.exception_values());
+
+  // Write flag if optional NULL value vector is written
+  export_value(ofstream, static_cast<BoolAsByteType>(delta_segment.null_values().has_value()));
+  if (delta_segment.null_values()) {
+    // Write NULL values
+    export_values(ofstream, *delta_segment.null_values());
+  }
+
+  // Write offset values
+  _export_compressed_vector(ofstream, *delta_segment.compressed_vector_type(), delta_segment.offset_values());
+}
+
+template <typename T>
+void BinaryWriter::_write_segment(const ALPSegment<T>& alp_segment, bool column_is_nullable, std::ofstream& ofstream) {
+  export_value(ofstream, EncodingType::ALP);
+
+  // Write offsets compression id
+  const auto compressed_vector_type_id = _compressed_vector_type_id<T>(alp_segment);
+  export_value(ofstream, compressed_vector_type_id);
+
+  // Write exponent, number of blocks, and block minima
+  export_value(ofstream, alp_segment.exponent());
+  export_value(ofstream, static_cast<uint32_t>(alp_segment.block_minima().size()));
+  export_values(ofstream, alp_segment.block_minima());
+
+  // Write exceptions
+  export_value(ofstream, static_cast<uint32_t>(alp_segment.exception_positions().size()));
+  export_values(ofstream, alp_segment.exception_positions());
+  export_values(ofstream, alp_segment.exception_values());
+
+  // Write flag if optional NULL value vector is written
+  export_value(ofstream, static_cast<BoolAsByteType>(alp_segment.null_values().has_value()));
+  if (alp_segment.null_values()) {
+    // Write NULL values
+    export_values(ofstream, *alp_segment.null_values());
+  }
+
+  // Write offset values
+  _export_compressed_vector(ofstream, *alp_segment.compressed_vector_type(), alp_segment.offset_values());
+}
+
 template <typename T>
 CompressedVectorTypeID BinaryWriter::_compressed_vector_type_id(
     const AbstractEncodedSegment& abstract_encoded_segment) {
@@ -4,9 +4,13 @@
 #include <string>
 #include <vector>
 
+#include "import_export/binary/binary_file_layout.hpp"
+#include "storage/alp_segment.hpp"
+#include "storage/delta_segment.hpp"
 #include "storage/dictionary_segment.hpp"
 #include "storage/fixed_string_dictionary_segment.hpp"
 #include "storage/frame_of_reference_segment.hpp"
+#include "storage/fsst_segment.hpp"
 #include "storage/lz4_segment.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/run_length_segment.hpp"
@@ -20,7 +24,10 @@ enum class CompressedVectorType : uint8_t;
 
 class BinaryWriter {
  public:
-  static void write(const Table& table, const std::string& filename);
+  // Page-aligned files are larger, but the BinaryParser can map their buffers instead of copying them (see
+  // BinaryFileLayout).
+  static void write(const Table& table, const std::string& filename,
+                    const BinaryFileLayout layout = BinaryFileLayout::Packed);
 
  private:
   /**
@@ -28,6 +35,8 @@ class BinaryWriter {
    *
    * Description                 | Type                                | Size in bytes
    * --------------------------------------------------------------------------------------------------------
+   * Page-aligned file marker¹   | ChunkOffset                         | 4
+   * Layout¹                     | BinaryFileLayout                    | 1
    * Chunk size                  | ChunkOffset                         | 4
    * Chunk count                 | ChunkID                             | 4
    * Column count                | ColumnID                            | 2
@@ -35,6 +44,9 @@ class BinaryWriter {
    * Column nullable             | bool (stored as BoolAsByteType)     | Column Count * 1
    * Column name lengths         | size_t array                        | Column Count * 1
    * Column names                | std::string array                   | Sum of lengths of all names
+   *
+   * ¹: These fields are only written for page-aligned files. In these files, large arrays of values are preceded by
+   *    padding as described in BinaryFileLayout.
    */
   static void _write_header(const Table& table, std::ofstream& ofstream);
 
@@ -174,6 +186,9 @@ class BinaryWriter {
    * Attribute vector compr. ID. | CompressedVectorTypeID              | 1
    * Number of Blocks            | uint32_t                            | 4
    * Block minima                | T                                   | Number of blocks * sizeof(T)
+   * Number of exceptions⁴       | uint32_t                            | 4
+   * Exception positions⁴        | ChunkOffset                         | Number of exceptions * 4
+   * Exception values⁴           | T                                   | Number of exceptions * sizeof(T)
    * Stores NULL values          | bool (stored as BoolAsByteType)     | 1
    * NULL values¹                | vector<bool> (BoolAsByteType)       | size * 1
    * Vector compress. bit width² | uint8_t                             | 1
@@ -187,6 +202,7 @@ class BinaryWriter {
    * ¹: This field is only written when the optional NULL values are stored
    * ²: This field is only written if the vector compression is BitPacking
    * ³: This field is only written if the vector compression is FixedWidthInteger
+   * ⁴: These fields are only written for int64_t segments, int32_t segments cannot have exceptions
    */
   template <typename T>
   static void _write_segment(const FrameOfReferenceSegment<T>& frame_of_reference_segment, bool column_is_nullable,
@@ -223,6 +239,95 @@ class BinaryWriter {
   template <typename T>
   static void _write_segment(const LZ4Segment<T>& lz4_segment, bool column_is_nullable, std::ofstream& ofstream);
 
+  /**
+   * FSSTSegments are dumped with the following layout:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Encoding Type               | EncodingType                        | 1
+   * Offsets compr. ID.          | CompressedVectorTypeID              | 1
+   * Number of symbols           | uint32_t                            | 4
+   * Symbol lengths              | vector<uint8_t>                     | Number of symbols * 1
+   * Symbols                     | vector<array<char, 8>>              | Number of symbols * 8
+   * Compressed values size      | uint32_t                            | 4
+   * Compressed values           | vector<char>                        | Compressed values size * 1
+   * Stores NULL values          | bool (stored as BoolAsByteType)     | 1
+   * NULL values¹                | vector<bool> (BoolAsByteType)       | Rows * 1
+   * Vector compress. bit width² | uint8_t                             | 1
+   * Offset values²              | uint8_t                             | (Rows + 1) * (vector compr. bit width) / 8
+   *                                                                     rounded up to next multiple of word (8 byte)
+   * Offset values³              | uint(8|16|32)_t                     | (Rows + 1) * width of offset vector
+   *
+   * Please note that the number of rows are written in the header of the chunk.
+   * The type of the column can be found in the global header of the file.
+   *
+   * ¹: This field is only written when the optional NULL values are stored
+   * ²: This field is only written if the vector compression is BitPacking
+   * ³: This field is only written if the vector compression is FixedWidthInteger
+   */
+  template <typename T>
+  static void _write_segment(const FSSTSegment<T>& fsst_segment, bool column_is_nullable, std::ofstream& ofstream);
+
+  /**
+   * DeltaSegments are dumped with the following layout:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Encoding Type               | EncodingType                        | 1
+   * Offsets compr. ID.          | CompressedVectorTypeID              | 1
+   * Number of Blocks            | uint32_t                            | 4
+   * Block bases                 | T                                   | Number of blocks * sizeof(T)
+   * Block minimum deltas        | T                                   | Number of blocks * sizeof(T)
+   * Number of exceptions        | uint32_t                            | 4
+   * Exception positions         | ChunkOffset                         | Number of exceptions * 4
+   * Exception values            | T                                   | Number of exceptions * sizeof(T)
+   * Stores NULL values          | bool (stored as BoolAsByteType)     | 1
+   * NULL values¹                | vector<bool> (BoolAsByteType)       | Rows * 1
+   * Vector compress. bit width² | uint8_t                             | 1
+   * Offset values²              | uint8_t                             | Rows * (vector compr. bit width) / 8
+   *                                                                     rounded up to next multiple of word (8 byte)
+   * Offset values³              | uint(8|16|32)_t                     | Rows * width of offset vector
+   *
+   * Please note that the number of rows are written in the header of the chunk.
+   * The type of the column can be found in the global header of the file.
+   *
+   * ¹: This field is only written when the optional NULL values are stored
+   * ²: This field is only written if the vector compression is BitPacking
+   * ³: This field is only written if the vector compression is FixedWidthInteger
+   */
+  template <typename T>
+  static void _write_segment(const DeltaSegment<T>& delta_segment, bool column_is_nullable, std::ofstream& ofstream);
+
+  /**
+   * ALPSegments are dumped with the following layout:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Encoding Type               | EncodingType                        | 1
+   * Offsets compr. ID.          | CompressedVectorTypeID              | 1
+   * Exponent                    | uint8_t                             | 1
+   * Number of Blocks            | uint32_t                            | 4
+   * Block minima                | int64_t                             | Number of blocks * 8
+   * Number of exceptions        | uint32_t                            | 4
+   * Exception positions         | ChunkOffset                         | Number of exceptions * 4
+   * Exception values            | T                                   | Number of exceptions * sizeof(T)
+   * Stores NULL values          | bool (stored as BoolAsByteType)     | 1
+   * NULL values¹                | vector<bool> (BoolAsByteType)       | Rows * 1
+   * Vector compress. bit width² | uint8_t                             | 1
+   * Offset values²              | uint8_t                             | Rows * (vector compr. bit width) / 8
+   *                                                                     rounded up to next multiple of word (8 byte)
+   * Offset values³              | uint(8|16|32)_t                     | Rows * width of offset vector
+   *
+   * Please note that the number of rows are written in the header of the chunk.
+   * The type of the column can be found in the global header of the file.
+   *
+   * ¹: This field is only written when the optional NULL values are stored
+   * ²: This field is only written if the vector compression is BitPacking
+   * ³: This field is only written if the vector compression is FixedWidthInteger
+   */
+  template <typename T>
+  static void _write_segment(const ALPSegment<T>& alp_segment, bool column_is_nullable, std::ofstream& ofstream);
+
   template <typename T>
   static CompressedVectorTypeID _compressed_vector_type_id(const AbstractEncodedSegment& abstract_encoded_segment);
 
@@ -1,6 +1,7 @@
 #include "csv_parser.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <deque>
 #include <list>
 #include <memory>
 #include <optional>
@@ -13,8 +14,10 @@
 #include "hyrise.hpp"
 #include "import_export/csv/csv_converter.hpp"
 #include "import_export/csv/csv_meta.hpp"
+#include "import_export/mapped_file.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/job_task.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
 #include "utils/load_table.hpp"
@@ -22,7 +25,8 @@
 namespace opossum {
 
 std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const ChunkOffset chunk_size,
-                                        const std::optional<CsvMeta>& csv_meta) {
+                                        const std::optional<CsvMeta>& csv_meta,
+                                        const std::optional<SegmentEncodingSpec>& encoding_spec) {
   // If no meta info is given as a parameter, look for a json file
   CsvMeta meta;
   if (csv_meta == std::nullopt) {
@@ -35,38 +39,43 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
 
   auto table = _create_table_from_meta(chunk_size, meta);
 
-  std::ifstream csvfile{filename};
+  MappedFile csvfile{filename};
+  csvfile.advise_sequential_access();
+  auto content_view = csvfile.view();
 
   // return empty table if input file is empty
-  if (!csvfile || csvfile.peek() == EOF || csvfile.peek() == '\r' || csvfile.peek() == '\n') return table;
+  if (content_view.empty() || content_view.front() == '\r' || content_view.front() == '\n') return table;
 
-  {
-    std::string line;
-    std::getline(csvfile, line);
-    Assert(line.find('\r') == std::string::npos, "Windows encoding is not supported, use dos2unix");
-  }
+  Assert(content_view.substr(0, content_view.find('\n')).find('\r') == std::string_view::npos,
+         "Windows encoding is not supported, use dos2unix");
 
   /**
-   * Load the whole file(!) into a std::string using the, hopefully, fastest method to do so.
-   * TODO(anybody) Maybe use mmap() in the future. The current approach needs to have the entire file in RAM, mmap might
-   *               be cleverer, dunno.
+   * The file is parsed as a stream of chunks: the main thread finds the field ends of the next chunk (which requires a
+   * sequential pass because of quoting) and hands the chunk to a parsing task, which creates and optionally encodes
+   * its segments. The file is read directly from the memory mapping, so it is never copied into memory as a whole. To
+   * keep the memory consumption independent of the file size, at most max_chunks_in_flight chunks are parsed
+   * concurrently. Finished chunks are appended to the table in file order.
    */
-  csvfile.seekg(0, std::ios::end);
-  const auto csvfile_size = csvfile.tellg();
-  std::string content(csvfile_size, ' ');
-  csvfile.seekg(0);
-  csvfile.read(content.data(), csvfile_size);
-
-  // make sure content ends with a delimiter for better row processing later
-  if (content.back() != meta.config.delimiter) content.push_back(meta.config.delimiter);
-
-  std::string_view content_view{content.c_str(), content.size()};
+  const auto max_chunks_in_flight = std::max(size_t{2}, 2 * Hyrise::get().topology.num_cpus());
 
   // Save chunks in list to avoid memory relocation
   std::list<Segments> segments_by_chunks;
-  std::vector<std::shared_ptr<AbstractTask>> tasks;
+  std::deque<std::shared_ptr<AbstractTask>> tasks;
   std::vector<size_t> field_ends;
   std::mutex append_chunk_mutex;
+
+  const auto append_oldest_chunk = [&]() {
+    Hyrise::get().scheduler()->wait_for_tasks({tasks.front()});
+    tasks.pop_front();
+
+    auto& segments = segments_by_chunks.front();
+    DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
+    const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
+    table->append_chunk(segments, mvcc_data);
+    table->last_chunk()->finalize();
+    segments_by_chunks.pop_front();
+  };
+
   while (_find_fields_in_chunk(content_view, *table, field_ends, meta)) {
     // create empty chunk
     segments_by_chunks.emplace_back();
@@ -75,24 +84,22 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
     // Only pass the part of the string that is actually needed to the parsing task
     std::string_view relevant_content = content_view.substr(0, field_ends.back());
 
-    // Remove processed part of the csv content
-    content_view = content_view.substr(field_ends.back() + 1);
+    // Remove processed part of the csv content. The last field of the file might not be followed by a delimiter.
+    content_view = content_view.substr(std::min(field_ends.back() + 1, content_view.size()));
 
     // create and start parsing task to fill chunk
     tasks.emplace_back(std::make_shared<JobTask>([relevant_content, field_ends, &table, &segments, &meta,
-                                                  &escaped_linebreak, &append_chunk_mutex]() {
-      _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak, append_chunk_mutex);
+                                                  &escaped_linebreak, &append_chunk_mutex, &encoding_spec]() {
+      _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak, append_chunk_mutex,
+                        encoding_spec);
     }));
     tasks.back()->schedule();
-  }
 
-  Hyrise::get().scheduler()->wait_for_tasks(tasks);
+    if (tasks.size() >= max_chunks_in_flight) append_oldest_chunk();
+  }
 
-  for (auto& segments : segments_by_chunks) {
-    DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
-    const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
-    table->append_chunk(segments, mvcc_data);
-    table->last_chunk()->finalize();
+  while (!tasks.empty()) {
+    append_oldest_chunk();
   }
 
   return table;
@@ -138,6 +145,10 @@ bool CsvParser::_find_fields_in_chunk(std::string_view csv_content, const Table&
     // Find either of row separator, column delimiter, quote identifier
     auto pos = csv_content.find_first_of(search_for, from);
     if (std::string::npos == pos) {
+      // The file is not necessarily terminated by a delimiter. In that case, the end of the file ends the last row.
+      if (csv_content.back() != meta.config.delimiter) {
+        field_ends.push_back(csv_content.size());
+      }
       break;
     }
     from = pos + 1;
@@ -176,7 +187,8 @@ bool CsvParser::_find_fields_in_chunk(std::string_view csv_content, const Table&
 
 size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends,
                                     const Table& table, Segments& segments, const CsvMeta& meta,
-                                    const std::string& escaped_linebreak, std::mutex& append_chunk_mutex) {
+                                    const std::string& escaped_linebreak, std::mutex& append_chunk_mutex,
+                                    const std::optional<SegmentEncodingSpec>& encoding_spec) {
   // For each csv column, create a CsvConverter which builds up a ValueSegment
   const auto column_count = table.column_count();
   const auto row_count = field_ends.size() / column_count;
@@ -220,12 +232,20 @@ size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vecto
                            std::to_string(column_id) + ":\n" + exception.what());
   }
 
-  // Transform the field_offsets to segments and add segments to chunk.
+  // Transform the field_offsets to segments and add segments to chunk. Encoding the segments right away frees the
+  // ValueSegments while the rest of the file is still being parsed.
+  Segments chunk_segments;
+  for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+    auto segment = std::shared_ptr<AbstractSegment>{converters[column_id]->finish()};
+    if (encoding_spec && encoding_supports_data_type(encoding_spec->encoding_type, table.column_data_type(column_id))) {
+      segment = ChunkEncoder::encode_segment(segment, table.column_data_type(column_id), *encoding_spec);
+    }
+    chunk_segments.push_back(segment);
+  }
+
   {
     std::lock_guard<std::mutex> lock(append_chunk_mutex);
-    for (auto& converter : converters) {
-      segments.push_back(converter->finish());
-    }
+    segments = std::move(chunk_segments);
   }
 
   return row_count;
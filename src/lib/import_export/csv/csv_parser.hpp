@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/csv/csv_meta.hpp"
+#include "storage/encoding_type.hpp"
 
 namespace opossum {
 
@@ -21,19 +22,23 @@ class Chunk;
  * For non-RFC 4180, all linebreaks within quoted strings are further escaped with an escape character.
  * For the structure of the meta csv file see export_csv.hpp
  *
- * This parser reads the whole csv file and iterates over it to separate the data into chunks that are aligned with the
- * csv rows.
- * Each data chunk is parsed and converted into a opossum chunk. In the end all chunks are combined to the final table.
+ * This parser maps the csv file into memory and iterates over it to separate the data into chunks that are aligned with
+ * the csv rows.
+ * Each data chunk is parsed (and optionally encoded) by its own task while the next chunks are being separated. Only a
+ * bounded number of chunks is parsed concurrently, finished chunks are appended to the table in file order.
  */
 class CsvParser {
  public:
   /*
    * @param filename      Path to the input file.
    * @param csv_meta      Custom csv meta information which will be used instead of the default "filename" + ".json" meta.
+   * @param encoding_spec Optional. If set, the segments of each chunk are encoded as soon as the chunk is parsed.
+   *                      Segments of data types that are not supported by the encoding are left unencoded.
    * @returns             The table that was created from the csv file.
    */
   static std::shared_ptr<Table> parse(const std::string& filename, const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE,
-                                      const std::optional<CsvMeta>& csv_meta = std::nullopt);
+                                      const std::optional<CsvMeta>& csv_meta = std::nullopt,
+                                      const std::optional<SegmentEncodingSpec>& encoding_spec = std::nullopt);
   static std::shared_ptr<Table> create_table_from_meta_file(const std::string& filename,
                                                             const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
 
@@ -48,6 +53,7 @@ class CsvParser {
    * @param      table       Empty table created by _process_meta_file.
    * @param[out] field_ends  Empty vector, to be filled with positions of the field ends for one chunk found in \p
    * csv_content.
+   * If \p csv_content does not end with a delimiter, its end is treated as the end of the last row.
    * @returns                False if \p csv_content is empty or chunk_size set to 0, True otherwise.
    */
   static bool _find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends,
@@ -58,11 +64,13 @@ class CsvParser {
    * @param      field_ends Positions of the field ends of the given \p csv_chunk.
    * @param      table      Empty table created by _process_meta_file.
    * @param[out] segments   The segments of the chunk, to be populated with data
+   * @param encoding_spec   If set, the segments are encoded with it before they are stored in \p segments
    * @returns               The number of rows in the chunk
    */
   static size_t _parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends, const Table& table,
                                   Segments& segments, const CsvMeta& meta, const std::string& escaped_linebreak,
-                                  std::mutex& append_chunk_mutex);
+                                  std::mutex& append_chunk_mutex,
+                                  const std::optional<SegmentEncodingSpec>& encoding_spec);
 
   /*
    * @param field The field that needs to be modified to be RFC 4180 compliant.
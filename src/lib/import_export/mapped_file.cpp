@@ -0,0 +1,51 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MappedFile::MappedFile(const std::string& filename) {
+  _file_descriptor = open(filename.c_str(), O_RDONLY);
+  Assert(_file_descriptor >= 0, "Could not open file " + filename);
+
+  struct stat file_stat {};
+  const auto stat_result = fstat(_file_descriptor, &file_stat);
+  if (stat_result != 0) {
+    close(_file_descriptor);
+    Fail("Could not determine the size of file " + filename);
+  }
+
+  _size = static_cast<size_t>(file_stat.st_size);
+  if (_size == 0) return;
+
+  const auto address = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file_descriptor, 0);
+  if (address == MAP_FAILED) {
+    close(_file_descriptor);
+    Fail("Could not map file " + filename);
+  }
+  _data = static_cast<const char*>(address);
+}
+
+MappedFile::~MappedFile() {
+  if (_data) munmap(const_cast<char*>(_data), _size);
+  close(_file_descriptor);
+}
+
+const char* MappedFile::data() const { return _data; }
+
+size_t MappedFile::size() const { return _size; }
+
+std::string_view MappedFile::view() const { return {_data, _size}; }
+
+int MappedFile::file_descriptor() const { return _file_descriptor; }
+
+void MappedFile::advise_sequential_access() const {
+  if (_data) madvise(const_cast<char*>(_data), _size, MADV_SEQUENTIAL);
+}
+
+}  // namespace opossum
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Read-only memory mapping of an entire file. Compared to reading the file through an std::ifstream, the parsers read
+ * directly from the page cache instead of from a stream buffer. Whatever a parser keeps from the file has to be either
+ * copied out of the mapping, which is unmapped on destruction, or mapped again through the file descriptor (see
+ * MappedPagesMemoryResource). Empty files are represented by an empty view.
+ */
+class MappedFile : public Noncopyable {
+ public:
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  const char* data() const;
+  size_t size() const;
+  std::string_view view() const;
+
+  // The descriptor stays open for the lifetime of the MappedFile.
+  int file_descriptor() const;
+
+  // Hints the OS that the file is read front to back so that it reads ahead aggressively and drops consumed pages
+  // early.
+  void advise_sequential_access() const;
+
+ private:
+  int _file_descriptor{-1};
+  const char* _data{nullptr};
+  size_t _size{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,404 @@
+#include "checkpoint.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "hyrise.hpp"
+#include "import_export/binary/binary_parser.hpp"
+#include "import_export/binary/binary_writer.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+void write_value(std::ofstream& ofstream, const T& value) {
+  ofstream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void write_string(std::ofstream& ofstream, const std::string& string) {
+  write_value(ofstream, static_cast<uint32_t>(string.size()));
+  ofstream.write(string.data(), static_cast<std::streamsize>(string.size()));
+}
+
+void write_offsets(std::ofstream& ofstream, const std::vector<ChunkOffset>& offsets) {
+  write_value(ofstream, static_cast<uint32_t>(offsets.size()));
+  ofstream.write(reinterpret_cast<const char*>(offsets.data()),
+                 static_cast<std::streamsize>(offsets.size() * sizeof(ChunkOffset)));
+}
+
+template <typename T>
+T read_value(std::ifstream& ifstream) {
+  auto value = T{};
+  ifstream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+std::string read_string(std::ifstream& ifstream) {
+  auto string = std::string(read_value<uint32_t>(ifstream), '\0');
+  ifstream.read(string.data(), static_cast<std::streamsize>(string.size()));
+  return string;
+}
+
+std::vector<ChunkOffset> read_offsets(std::ifstream& ifstream) {
+  auto offsets = std::vector<ChunkOffset>(read_value<uint32_t>(ifstream));
+  ifstream.read(reinterpret_cast<char*>(offsets.data()),
+                static_cast<std::streamsize>(offsets.size() * sizeof(ChunkOffset)));
+  return offsets;
+}
+
+// Copies the first row_count values of a mutable chunk. Concurrent inserts only write to rows behind row_count or to
+// rows that are not visible for the checkpoint's snapshot, so no lock is required. If the chunk has been finalized and
+// encoded in the meantime, its values are read from the encoded segments.
+Segments copy_mutable_segments(const Table& table, const Chunk& chunk, const ChunkOffset row_count) {
+  auto segments = Segments{};
+  const auto column_count = table.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto nullable = table.column_is_nullable(column_id);
+      const auto segment = chunk.get_segment(column_id);
+      if (const auto value_segment = std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(segment)) {
+        const auto& values = value_segment->values();
+        auto values_copy = pmr_vector<ColumnDataType>(values.begin(), values.begin() + row_count);
+        if (nullable) {
+          const auto& null_values = value_segment->null_values();
+          auto null_values_copy = pmr_vector<bool>(null_values.begin(), null_values.begin() + row_count);
+          segments.emplace_back(
+              std::make_shared<ValueSegment<ColumnDataType>>(std::move(values_copy), std::move(null_values_copy)));
+        } else {
+          segments.emplace_back(std::make_shared<ValueSegment<ColumnDataType>>(std::move(values_copy)));
+        }
+        return;
+      }
+
+      auto values_copy = pmr_vector<ColumnDataType>(row_count);
+      auto null_values_copy = pmr_vector<bool>(nullable ? row_count : 0);
+      segment_iterate<ColumnDataType>(*segment, [&](const auto& position) {
+        const auto chunk_offset = position.chunk_offset();
+        if (chunk_offset >= row_count) return;
+        if (position.is_null()) {
+          null_values_copy[chunk_offset] = true;
+        } else {
+          values_copy[chunk_offset] = position.value();
+        }
+      });
+      if (nullable) {
+        segments.emplace_back(
+            std::make_shared<ValueSegment<ColumnDataType>>(std::move(values_copy), std::move(null_values_copy)));
+      } else {
+        segments.emplace_back(std::make_shared<ValueSegment<ColumnDataType>>(std::move(values_copy)));
+      }
+    });
+  }
+  return segments;
+}
+
+// Creates ValueSegments that can take up to target_chunk_size rows and that contain the values of the given segments.
+Segments make_mutable_segments(const Table& table, const Chunk& chunk) {
+  auto segments = Segments{};
+  const auto row_count = chunk.size();
+  const auto column_count = table.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto source_segment =
+          std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(chunk.get_segment(column_id));
+      Assert(source_segment, "Mutable chunks are expected to be stored as ValueSegments");
+
+      const auto nullable = table.column_is_nullable(column_id);
+      auto target_segment = std::make_shared<ValueSegment<ColumnDataType>>(nullable, table.target_chunk_size());
+      if (row_count > 0) {
+        target_segment->resize(row_count);
+        std::copy(source_segment->values().begin(), source_segment->values().end(), target_segment->values().begin());
+        for (auto chunk_offset = ChunkOffset{0}; nullable && chunk_offset < row_count; ++chunk_offset) {
+          if (source_segment->is_null(chunk_offset)) target_segment->set_null_value(chunk_offset);
+        }
+      }
+      segments.emplace_back(target_segment);
+    });
+  }
+  return segments;
+}
+
+}  // namespace
+
+namespace opossum {
+
+void Checkpoint::write(const std::filesystem::path& directory, const CommitID snapshot_commit_id) {
+  const auto temporary_directory = std::filesystem::path{directory.string() + ".tmp"};
+  std::filesystem::remove_all(temporary_directory);
+  std::filesystem::create_directories(temporary_directory);
+
+  // Per chunk, the information that is stored in the manifest and, for immutable chunks, the written segments
+  struct ChunkInfo {
+    ChunkState state{ChunkState::Removed};
+    ChunkOffset row_count{0};
+    std::vector<ChunkOffset> deleted_offsets;
+    std::vector<ChunkOffset> uncommitted_offsets;
+    std::optional<WrittenChunk> written_chunk;
+  };
+
+  const auto stored_tables = Hyrise::get().storage_manager.tables();
+  const auto tables = std::vector<std::pair<std::string, std::shared_ptr<Table>>>(stored_tables.begin(),
+                                                                                  stored_tables.end());
+  const auto table_count = static_cast<uint32_t>(tables.size());
+
+  auto chunk_infos = std::vector<std::vector<ChunkInfo>>(table_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto table_index = uint32_t{0}; table_index < table_count; ++table_index) {
+    const auto& stored_table = tables[table_index].second;
+    Assert(stored_table->uses_mvcc() == UseMvcc::Yes, "Stored tables are expected to use MVCC");
+
+    // Chunks appended from now on only contain rows that are not visible for the snapshot.
+    const auto chunk_count = stored_table->chunk_count();
+    chunk_infos[table_index].resize(chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, table_index, chunk_id]() {
+        const auto& [table_name, table] = tables[table_index];
+        auto& chunk_info = chunk_infos[table_index][chunk_id];
+
+        const auto chunk = table->get_chunk(chunk_id);
+        if (!chunk) return;
+
+        // The state and size have to be determined before the MVCC data is read. Rows that are appended afterwards
+        // are not visible for the snapshot anyway.
+        const auto is_mutable = chunk->is_mutable();
+        const auto row_count = chunk->size();
+
+        const auto& mvcc_data = chunk->mvcc_data();
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+          if (mvcc_data->get_begin_cid(chunk_offset) > snapshot_commit_id) {
+            chunk_info.uncommitted_offsets.emplace_back(chunk_offset);
+          } else if (mvcc_data->get_end_cid(chunk_offset) <= snapshot_commit_id) {
+            chunk_info.deleted_offsets.emplace_back(chunk_offset);
+          }
+        }
+
+        chunk_info.state = is_mutable ? ChunkState::Mutable : ChunkState::Immutable;
+        chunk_info.row_count = row_count;
+        if (row_count == 0) return;
+
+        const auto file_path = _chunk_file_path(temporary_directory, table_index, chunk_id);
+        auto chunks = std::vector<std::shared_ptr<Chunk>>{};
+
+        if (is_mutable) {
+          chunks.emplace_back(std::make_shared<Chunk>(copy_mutable_segments(*table, *chunk, row_count)));
+          BinaryWriter::write(Table{table->column_definitions(), TableType::Data, std::move(chunks)}, file_path);
+          sync(file_path);
+          return;
+        }
+
+        auto segments = Segments{};
+        const auto column_count = chunk->column_count();
+        for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+          segments.emplace_back(chunk->get_segment(column_id));
+        }
+        const auto sorted_by = chunk->individually_sorted_by();
+
+        // Reuse the file of the previous checkpoint if the chunk has neither been re-encoded nor sorted since.
+        const auto previous_chunk = _written_chunks.find({table_name, chunk_id});
+        const auto unchanged = previous_chunk != _written_chunks.end() &&
+                               previous_chunk->second.sorted_by == sorted_by &&
+                               std::equal(segments.begin(), segments.end(), previous_chunk->second.segments.begin(),
+                                          previous_chunk->second.segments.end(),
+                                          [](const auto& segment, const auto& previous_segment) {
+                                            return segment == previous_segment.lock();
+                                          }) &&
+                               std::filesystem::exists(previous_chunk->second.file_path);
+
+        // Files of previous checkpoints have already been synced.
+        if (unchanged) {
+          std::filesystem::create_hard_link(previous_chunk->second.file_path, file_path);
+        } else {
+          const auto chunk_copy = std::make_shared<Chunk>(segments);
+          chunk_copy->finalize();
+          if (!sorted_by.empty()) chunk_copy->set_individually_sorted_by(sorted_by);
+          chunks.emplace_back(chunk_copy);
+          BinaryWriter::write(Table{table->column_definitions(), TableType::Data, std::move(chunks)}, file_path);
+          sync(file_path);
+        }
+
+        chunk_info.written_chunk = WrittenChunk{{segments.begin(), segments.end()},
+                                                sorted_by,
+                                                _chunk_file_path(directory, table_index, chunk_id)};
+      }));
+    }
+  }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  auto manifest = std::ofstream{};
+  manifest.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+  manifest.open(temporary_directory / MANIFEST_FILE_NAME, std::ios::binary);
+
+  write_value(manifest, snapshot_commit_id);
+  write_value(manifest, table_count);
+
+  auto written_chunks = std::map<std::pair<std::string, ChunkID>, WrittenChunk>{};
+  for (auto table_index = uint32_t{0}; table_index < table_count; ++table_index) {
+    const auto& [table_name, table] = tables[table_index];
+
+    write_string(manifest, table_name);
+    write_value(manifest, table->target_chunk_size());
+
+    const auto column_count = table->column_count();
+    write_value(manifest, static_cast<ColumnID::base_type>(column_count));
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      write_string(manifest, table->column_name(column_id));
+      write_string(manifest, data_type_to_string.left.at(table->column_data_type(column_id)));
+      write_value(manifest, static_cast<BoolAsByteType>(table->column_is_nullable(column_id)));
+    }
+
+    const auto chunk_count = static_cast<ChunkID::base_type>(chunk_infos[table_index].size());
+    write_value(manifest, chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      auto& chunk_info = chunk_infos[table_index][chunk_id];
+      write_value(manifest, chunk_info.state);
+      if (chunk_info.state == ChunkState::Removed) continue;
+
+      write_value(manifest, chunk_info.row_count);
+      write_offsets(manifest, chunk_info.deleted_offsets);
+      write_offsets(manifest, chunk_info.uncommitted_offsets);
+
+      if (chunk_info.written_chunk) {
+        written_chunks.emplace(std::make_pair(table_name, chunk_id), std::move(*chunk_info.written_chunk));
+      }
+    }
+  }
+
+  manifest.close();
+  sync(temporary_directory / MANIFEST_FILE_NAME);
+
+  // The checkpoint must only get its final name once all of its files are durable. Otherwise, a crash could leave
+  // behind a complete-looking checkpoint with missing or partial files, while its log files have been removed.
+  sync(temporary_directory);
+
+  std::filesystem::remove_all(directory);
+  std::filesystem::rename(temporary_directory, directory);
+
+  _written_chunks = std::move(written_chunks);
+}
+
+CommitID Checkpoint::load(const std::filesystem::path& directory) {
+  auto manifest = std::ifstream{};
+  manifest.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  manifest.open(directory / MANIFEST_FILE_NAME, std::ios::binary);
+
+  const auto snapshot_commit_id = read_value<CommitID>(manifest);
+  const auto table_count = read_value<uint32_t>(manifest);
+
+  for (auto table_index = uint32_t{0}; table_index < table_count; ++table_index) {
+    const auto table_name = read_string(manifest);
+    const auto target_chunk_size = read_value<ChunkOffset>(manifest);
+
+    const auto column_count = read_value<ColumnID::base_type>(manifest);
+    auto column_definitions = TableColumnDefinitions{};
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      const auto column_name = read_string(manifest);
+      const auto data_type = data_type_to_string.right.at(read_string(manifest));
+      const auto nullable = static_cast<bool>(read_value<BoolAsByteType>(manifest));
+      column_definitions.emplace_back(column_name, data_type, nullable);
+    }
+
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, target_chunk_size, UseMvcc::Yes);
+
+    const auto chunk_count = ChunkID{read_value<ChunkID::base_type>(manifest)};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk_state = read_value<ChunkState>(manifest);
+      if (chunk_state == ChunkState::Removed) {
+        // Keep the ChunkIDs of the following chunks stable by adding a placeholder that is removed right away.
+        table->append_mutable_chunk();
+        table->remove_chunk(chunk_id);
+        continue;
+      }
+
+      const auto row_count = read_value<ChunkOffset>(manifest);
+      const auto deleted_offsets = read_offsets(manifest);
+      const auto uncommitted_offsets = read_offsets(manifest);
+
+      if (row_count == 0) {
+        DebugAssert(chunk_state == ChunkState::Mutable, "Only mutable chunks can be empty");
+        table->append_mutable_chunk();
+        continue;
+      }
+
+      const auto chunk_table = BinaryParser::parse(_chunk_file_path(directory, table_index, chunk_id));
+      Assert(chunk_table->chunk_count() == 1 && chunk_table->row_count() == row_count, "Checkpoint is inconsistent");
+      const auto parsed_chunk = chunk_table->get_chunk(ChunkID{0});
+
+      // Rows that were visible for the snapshot are treated as if they had been there from the beginning of time.
+      // Rows that were uncommitted keep MAX_COMMIT_ID. They are either replayed from the redo log or rolled back
+      // at the end of the recovery (see RedoLogReplayer::finish).
+      const auto mvcc_data_size = chunk_state == ChunkState::Mutable ? target_chunk_size : row_count;
+      const auto mvcc_data = std::make_shared<MvccData>(mvcc_data_size, MvccData::MAX_COMMIT_ID);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+        mvcc_data->set_begin_cid(chunk_offset, CommitID{0});
+      }
+      for (const auto chunk_offset : deleted_offsets) {
+        mvcc_data->set_end_cid(chunk_offset, CommitID{0});
+      }
+      for (const auto chunk_offset : uncommitted_offsets) {
+        mvcc_data->set_begin_cid(chunk_offset, MvccData::MAX_COMMIT_ID);
+      }
+
+      if (chunk_state == ChunkState::Mutable) {
+        table->append_chunk(make_mutable_segments(*table, *parsed_chunk), mvcc_data);
+      } else {
+        auto segments = Segments{};
+        for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+          segments.emplace_back(parsed_chunk->get_segment(column_id));
+        }
+        table->append_chunk(segments, mvcc_data);
+
+        // The uncommitted rows are accounted for when they are replayed or rolled back.
+        mvcc_data->max_begin_cid = CommitID{0};
+        const auto chunk = table->last_chunk();
+        chunk->finalize();
+        const auto& sorted_by = parsed_chunk->individually_sorted_by();
+        if (!sorted_by.empty()) chunk->set_individually_sorted_by(sorted_by);
+      }
+
+      table->last_chunk()->increase_invalid_row_count(static_cast<ChunkOffset>(deleted_offsets.size()));
+    }
+
+    auto& storage_manager = Hyrise::get().storage_manager;
+    if (storage_manager.has_table(table_name)) storage_manager.drop_table(table_name);
+    storage_manager.add_table(table_name, table);
+  }
+
+  return snapshot_commit_id;
+}
+
+void Checkpoint::sync(const std::filesystem::path& path) {
+  const auto file_descriptor = open(path.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0, "Could not open " + path.string());
+  const auto result = fsync(file_descriptor);
+  close(file_descriptor);
+  Assert(result == 0, "Could not sync " + path.string());
+}
+
+std::filesystem::path Checkpoint::_chunk_file_path(const std::filesystem::path& directory, const uint32_t table_index,
+                                                   const ChunkID chunk_id) {
+  return directory / (std::to_string(table_index) + "_" + std::to_string(chunk_id) + ".bin");
+}
+
+}  // namespace opossum
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+
+/**
+ * A checkpoint is a transaction-consistent copy of all tables stored in the StorageManager as they are visible for a
+ * snapshot commit ID. Together with the redo log records of transactions that committed after that snapshot, it
+ * allows restoring the database after a restart (see RedoLog::recover).
+ *
+ * Checkpoints preserve the physical layout of the tables, i.e., every row keeps its RowID. This is required because
+ * redo log records reference the RowIDs written by Insert and Delete. Rows that were not visible for the snapshot are
+ * written as well, but flagged as deleted or uncommitted. Writing a checkpoint does not block writers: values of
+ * visible rows never change and MVCC data is only read.
+ *
+ * A checkpoint directory contains:
+ *   - manifest.bin: the snapshot commit ID and, per table, its name, target chunk size, column definitions, and per
+ *                   chunk its state (removed, immutable, or mutable), row count, and the offsets of deleted and
+ *                   uncommitted rows
+ *   - <table index>_<chunk id>.bin: the segments of a single chunk in the format of the BinaryWriter
+ *
+ * Chunks are written in parallel, one JobTask per chunk. The segments of immutable chunks only change when they are
+ * re-encoded. Thus, a Checkpoint object remembers the segments that it has written. If an immutable chunk still holds
+ * the same segments in the next checkpoint, its file is hard-linked from the previous checkpoint instead of being
+ * written again. Only the manifest, which holds the MVCC information, and mutable chunks are written every time.
+ *
+ * Soft key constraints, indexes, and clustering information are not part of the checkpoint. Statistics are
+ * regenerated when the tables are added to the StorageManager.
+ */
+class Checkpoint {
+ public:
+  /**
+   * Writes all tables stored in the StorageManager as they are visible for the given snapshot commit ID. The
+   * checkpoint is first written into a temporary directory, which is renamed to `directory` once all of its files
+   * and the temporary directory itself have been synced to disk. Thus, a crash while writing the checkpoint does not
+   * leave an incomplete checkpoint behind. The caller has to sync the parent directory to make the rename durable.
+   * Checkpoints written by the same object must not be written concurrently.
+   */
+  void write(const std::filesystem::path& directory, const CommitID snapshot_commit_id);
+
+  // Restores the tables of a checkpoint into the StorageManager and returns the checkpoint's snapshot commit ID.
+  static CommitID load(const std::filesystem::path& directory);
+
+  static constexpr auto MANIFEST_FILE_NAME = "manifest.bin";
+
+  // Flushes the contents of a file or the entries of a directory to disk (fsync)
+  static void sync(const std::filesystem::path& path);
+
+ protected:
+  enum class ChunkState : uint8_t { Removed, Immutable, Mutable };
+
+  // An immutable chunk as it was written by the previous checkpoint
+  struct WrittenChunk {
+    std::vector<std::weak_ptr<const AbstractSegment>> segments;
+    std::vector<SortColumnDefinition> sorted_by;
+    std::filesystem::path file_path;
+  };
+
+  static std::filesystem::path _chunk_file_path(const std::filesystem::path& directory, const uint32_t table_index,
+                                                const ChunkID chunk_id);
+
+  // Immutable chunks written by the previous call to write(), identified by table name and ChunkID
+  std::map<std::pair<std::string, ChunkID>, WrittenChunk> _written_chunks;
+};
+
+}  // namespace opossum
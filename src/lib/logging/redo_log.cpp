@@ -0,0 +1,285 @@
+#include "redo_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <boost/crc.hpp>
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "redo_log_record.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns the number following the prefix if the file name has the form <prefix><number>[suffix].
+std::optional<uint64_t> parse_numbered_file_name(const std::string& file_name, const std::string& prefix,
+                                                 const std::string& suffix) {
+  if (file_name.size() <= prefix.size() + suffix.size() || file_name.compare(0, prefix.size(), prefix) != 0 ||
+      file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+    return std::nullopt;
+  }
+
+  const auto number = file_name.substr(prefix.size(), file_name.size() - prefix.size() - suffix.size());
+  if (!std::all_of(number.begin(), number.end(), [](const auto character) { return std::isdigit(character); })) {
+    return std::nullopt;
+  }
+  return std::stoull(number);
+}
+
+}  // namespace
+
+namespace opossum {
+
+RedoLog::RedoLog(const std::filesystem::path& directory, const std::chrono::microseconds group_commit_delay)
+    : _directory{directory}, _group_commit_delay{group_commit_delay} {
+  std::filesystem::create_directories(_directory);
+
+  for (const auto& entry : std::filesystem::directory_iterator(_directory)) {
+    const auto log_file_index = parse_numbered_file_name(entry.path().filename().string(), LOG_FILE_PREFIX, ".bin");
+    if (!log_file_index || !entry.is_regular_file()) continue;
+
+    _recoverable_log_file_indexes.emplace_back(static_cast<uint32_t>(*log_file_index));
+    // Until recover() has read them, nothing is known about the contents of existing log files. If no recovery
+    // happens, the next checkpoint supersedes them.
+    _max_commit_id_per_log_file[static_cast<uint32_t>(*log_file_index)] = CommitID{0};
+  }
+  std::sort(_recoverable_log_file_indexes.begin(), _recoverable_log_file_indexes.end());
+
+  _log_file_index = _recoverable_log_file_indexes.empty() ? 0 : _recoverable_log_file_indexes.back() + 1;
+  _open_next_log_file();
+
+  _flush_thread = std::thread{&RedoLog::_flush_loop, this};
+}
+
+RedoLog::~RedoLog() {
+  {
+    const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+    _shutdown_requested = true;
+  }
+  _buffer_condition_variable.notify_one();
+  _flush_thread.join();
+
+  close(_file_descriptor);
+}
+
+void RedoLog::append(RedoLogRecord& record, std::function<void()> on_durable) {
+  const auto& serialized_record = record.serialize();
+
+  {
+    const auto lock = std::lock_guard<std::mutex>{_buffer_mutex};
+    _buffer.insert(_buffer.end(), serialized_record.begin(), serialized_record.end());
+    _callbacks.emplace_back(std::move(on_durable));
+    _buffer_max_commit_id = std::max(_buffer_max_commit_id, record.commit_id());
+  }
+  _buffer_condition_variable.notify_one();
+}
+
+void RedoLog::checkpoint() {
+  const auto checkpoint_lock = std::lock_guard<std::mutex>{_checkpoint_mutex};
+
+  // The transaction context registers the snapshot commit ID as active so that no rows visible for it are cleaned up
+  // (e.g., by the MvccDeletePlugin) while the checkpoint is written. It does not modify any data.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
+  const auto snapshot_commit_id = transaction_context->snapshot_commit_id();
+
+  // All records of transactions up to snapshot_commit_id have been synced before snapshot_commit_id became visible.
+  // Thus, they are stored in the current or in previous log files. Records written from now on go to a new file.
+  {
+    const auto file_lock = std::lock_guard<std::mutex>{_file_mutex};
+    _open_next_log_file();
+  }
+
+  const auto checkpoint_directory = _directory / (CHECKPOINT_PREFIX + std::to_string(snapshot_commit_id));
+  if (!std::filesystem::exists(checkpoint_directory)) {
+    _checkpoint.write(checkpoint_directory, snapshot_commit_id);
+    Checkpoint::sync(_directory);
+  }
+
+  // Remove log files that are completely covered by the new checkpoint, followed by older checkpoints. This is only
+  // safe once the checkpoint's files and its rename have been synced.
+  {
+    const auto file_lock = std::lock_guard<std::mutex>{_file_mutex};
+    for (auto iter = _max_commit_id_per_log_file.begin(); iter != _max_commit_id_per_log_file.end();) {
+      if (iter->first != _log_file_index && iter->second <= snapshot_commit_id) {
+        std::filesystem::remove(_log_file_path(iter->first));
+        iter = _max_commit_id_per_log_file.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  for (const auto& entry : std::filesystem::directory_iterator(_directory)) {
+    if (entry.is_directory() && entry.path().filename().string().starts_with(CHECKPOINT_PREFIX) &&
+        entry.path() != checkpoint_directory) {
+      std::filesystem::remove_all(entry.path());
+    }
+  }
+
+  transaction_context->commit();
+}
+
+CommitID RedoLog::recover() {
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  Assert(!transaction_manager.get_lowest_active_snapshot_commit_id(), "Cannot recover while transactions are active");
+
+  // Load the latest complete checkpoint. Incomplete checkpoints still have their temporary name.
+  auto last_commit_id = transaction_manager.last_commit_id();
+  auto checkpoint_directory = std::optional<std::filesystem::path>{};
+  auto checkpoint_commit_id = CommitID{0};
+  for (const auto& entry : std::filesystem::directory_iterator(_directory)) {
+    const auto commit_id = parse_numbered_file_name(entry.path().filename().string(), CHECKPOINT_PREFIX, "");
+    if (!commit_id || !entry.is_directory() || *commit_id < checkpoint_commit_id) continue;
+
+    checkpoint_commit_id = static_cast<CommitID>(*commit_id);
+    checkpoint_directory = entry.path();
+  }
+
+  if (checkpoint_directory) {
+    last_commit_id = std::max(last_commit_id, Checkpoint::load(*checkpoint_directory));
+  }
+
+  // Read all intact records. A record that was only partially written before the crash (or that is corrupted) ends
+  // the respective log file.
+  auto log_file_contents = std::vector<std::vector<char>>{};
+  log_file_contents.reserve(_recoverable_log_file_indexes.size());
+  auto payloads = std::vector<std::pair<const char*, size_t>>{};
+  for (const auto log_file_index : _recoverable_log_file_indexes) {
+    auto log_file = std::ifstream{_log_file_path(log_file_index), std::ios::binary};
+    auto& content = log_file_contents.emplace_back(std::istreambuf_iterator<char>{log_file},
+                                                   std::istreambuf_iterator<char>{});
+
+    auto max_commit_id = CommitID{0};
+    auto position = size_t{0};
+    while (position + RedoLogRecord::HEADER_SIZE <= content.size()) {
+      auto payload_size = uint32_t{};
+      auto checksum = uint32_t{};
+      std::memcpy(&payload_size, content.data() + position, sizeof(payload_size));
+      std::memcpy(&checksum, content.data() + position + sizeof(payload_size), sizeof(checksum));
+      const auto payload_position = position + RedoLogRecord::HEADER_SIZE;
+      if (payload_size < sizeof(CommitID) || payload_position + payload_size > content.size()) break;
+
+      auto crc = boost::crc_32_type{};
+      crc.process_bytes(content.data() + payload_position, payload_size);
+      if (crc.checksum() != checksum) break;
+
+      const auto payload = content.data() + payload_position;
+      max_commit_id = std::max(max_commit_id, RedoLogReplayer::commit_id(payload));
+      payloads.emplace_back(payload, payload_size);
+      position = payload_position + payload_size;
+    }
+
+    _max_commit_id_per_log_file[log_file_index] = max_commit_id;
+  }
+
+  // Group commits may have written records out of commit order. Only replay the gapless sequence following the
+  // checkpoint: transactions behind a gap have never become visible, as their predecessor never committed.
+  std::stable_sort(payloads.begin(), payloads.end(), [](const auto& lhs, const auto& rhs) {
+    return RedoLogReplayer::commit_id(lhs.first) < RedoLogReplayer::commit_id(rhs.first);
+  });
+
+  auto replayed_payloads = std::vector<std::pair<const char*, size_t>>{};
+  for (const auto& payload : payloads) {
+    const auto commit_id = RedoLogReplayer::commit_id(payload.first);
+    if (commit_id <= last_commit_id) continue;
+    if (commit_id != last_commit_id + 1) break;
+
+    replayed_payloads.emplace_back(payload);
+    last_commit_id = commit_id;
+  }
+
+  auto replayer = RedoLogReplayer{};
+  for (const auto& [payload, payload_size] : replayed_payloads) {
+    replayer.allocate(payload, payload_size);
+  }
+  replayer.finish_allocation();
+  for (const auto& [payload, payload_size] : replayed_payloads) {
+    replayer.apply(payload, payload_size);
+  }
+  replayer.finish();
+
+  transaction_manager._reset_last_commit_id(last_commit_id);
+
+  return last_commit_id;
+}
+
+const std::filesystem::path& RedoLog::directory() const { return _directory; }
+
+void RedoLog::_flush_loop() {
+  auto buffer = std::vector<char>{};
+  auto callbacks = std::vector<std::function<void()>>{};
+
+  while (true) {
+    auto max_commit_id = CommitID{0};
+    {
+      auto lock = std::unique_lock<std::mutex>{_buffer_mutex};
+      _buffer_condition_variable.wait(lock, [&] { return !_callbacks.empty() || _shutdown_requested; });
+      // Pending records are flushed before shutting down.
+      if (_callbacks.empty()) return;
+
+      if (_group_commit_delay.count() > 0) {
+        _buffer_condition_variable.wait_for(lock, _group_commit_delay, [&] { return _shutdown_requested; });
+      }
+
+      std::swap(buffer, _buffer);
+      std::swap(callbacks, _callbacks);
+      max_commit_id = _buffer_max_commit_id;
+      _buffer_max_commit_id = CommitID{0};
+    }
+
+    {
+      const auto file_lock = std::lock_guard<std::mutex>{_file_mutex};
+
+      auto bytes_written = size_t{0};
+      while (bytes_written < buffer.size()) {
+        const auto result = ::write(_file_descriptor, buffer.data() + bytes_written, buffer.size() - bytes_written);
+        Assert(result >= 0, "Could not write to redo log file");
+        bytes_written += static_cast<size_t>(result);
+      }
+      Assert(fdatasync(_file_descriptor) == 0, "Could not sync redo log file");
+
+      auto& file_max_commit_id = _max_commit_id_per_log_file[_log_file_index];
+      file_max_commit_id = std::max(file_max_commit_id, max_commit_id);
+    }
+
+    for (const auto& callback : callbacks) {
+      callback();
+    }
+
+    buffer.clear();
+    callbacks.clear();
+  }
+}
+
+void RedoLog::_open_next_log_file() {
+  if (_file_descriptor >= 0) {
+    close(_file_descriptor);
+    ++_log_file_index;
+  }
+
+  const auto path = _log_file_path(_log_file_index);
+  _file_descriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  Assert(_file_descriptor >= 0, "Could not open redo log file " + path.string());
+  _max_commit_id_per_log_file.emplace(_log_file_index, CommitID{0});
+
+  // Make sure that the file itself survives a crash, not only its contents.
+  Checkpoint::sync(_directory);
+}
+
+std::filesystem::path RedoLog::_log_file_path(const uint32_t log_file_index) const {
+  return _directory / (LOG_FILE_PREFIX + std::to_string(log_file_index) + ".bin");
+}
+
+}  // namespace opossum
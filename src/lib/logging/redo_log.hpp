@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "checkpoint.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class RedoLogRecord;
+
+/**
+ * The RedoLog makes committed transactions durable. When it is set in Hyrise::get().redo_log, every transaction with
+ * read/write operators serializes its modifications into a RedoLogRecord during TransactionContext::commit_async and
+ * hands it to append(). The transaction only becomes visible (and its commit callback is only called) after the record
+ * has been written and synced to disk.
+ *
+ * Records are written by a dedicated flusher thread (group commit): while one batch is synced, the records of
+ * concurrently committing transactions are collected and written with the next, single fdatasync. Optionally, the
+ * flusher waits for group_commit_delay before writing a batch to collect more records under low contention.
+ *
+ * The log directory contains numbered log files (redo_log_<n>.bin) and checkpoints (checkpoint_<snapshot commit id>).
+ * checkpoint() writes a new checkpoint and deletes all log files and checkpoints that are no longer required.
+ * recover() restores the latest checkpoint and replays the log records of all transactions that committed after it.
+ *
+ * Only tables registered in the StorageManager are logged. Dropping, creating, or re-encoding tables is not logged;
+ * such changes become durable with the next checkpoint.
+ */
+class RedoLog : public Noncopyable {
+ public:
+  explicit RedoLog(const std::filesystem::path& directory,
+                   const std::chrono::microseconds group_commit_delay = std::chrono::microseconds{0});
+  ~RedoLog();
+
+  /**
+   * Adds the record to the next group commit. on_durable is called by the flusher thread once the record has been
+   * synced to disk. Records may be written in a different order than their commit IDs, recovery sorts them.
+   */
+  void append(RedoLogRecord& record, std::function<void()> on_durable);
+
+  /**
+   * Writes a checkpoint of all stored tables as they are visible for the current last commit ID and removes log files
+   * that only contain records of transactions included in the checkpoint. Can be called while transactions commit.
+   */
+  void checkpoint();
+
+  /**
+   * Restores the database from the latest checkpoint in the log directory and replays the records of the log files
+   * that existed when the RedoLog was created. Replaying stops at the first missing commit ID, i.e., only a gapless
+   * sequence of transactions is recovered. Has to be called before the first transaction is committed and while no
+   * transaction is active. Returns the last recovered commit ID.
+   */
+  CommitID recover();
+
+  const std::filesystem::path& directory() const;
+
+  static constexpr auto LOG_FILE_PREFIX = "redo_log_";
+  static constexpr auto CHECKPOINT_PREFIX = "checkpoint_";
+
+ private:
+  void _flush_loop();
+
+  // Closes the current log file and opens the next one. Expects the caller to hold _file_mutex.
+  void _open_next_log_file();
+
+  std::filesystem::path _log_file_path(const uint32_t log_file_index) const;
+
+  const std::filesystem::path _directory;
+  const std::chrono::microseconds _group_commit_delay;
+
+  // Records and callbacks collected for the next group commit
+  std::mutex _buffer_mutex;
+  std::condition_variable _buffer_condition_variable;
+  std::vector<char> _buffer;
+  std::vector<std::function<void()>> _callbacks;
+  CommitID _buffer_max_commit_id{0};
+  bool _shutdown_requested{false};
+
+  // The log file that is currently written to and, per log file, the largest commit ID it contains
+  std::mutex _file_mutex;
+  int _file_descriptor{-1};
+  uint32_t _log_file_index{0};
+  std::map<uint32_t, CommitID> _max_commit_id_per_log_file;
+
+  // Log files that existed when the RedoLog was created. Only these are read by recover().
+  std::vector<uint32_t> _recoverable_log_file_indexes;
+
+  // Serializes checkpoints. The Checkpoint object remembers the chunks it has written so that unchanged chunks are
+  // not written again.
+  std::mutex _checkpoint_mutex;
+  Checkpoint _checkpoint;
+
+  std::thread _flush_thread;
+};
+
+}  // namespace opossum
@@ -0,0 +1,356 @@
+#include "redo_log_record.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/crc.hpp>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/pos_lists/abstract_pos_list.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Sequentially reads values from a serialized record payload.
+class PayloadReader {
+ public:
+  PayloadReader(const char* payload, const size_t payload_size) : _position{payload}, _end{payload + payload_size} {}
+
+  template <typename T>
+  T read_value() {
+    if constexpr (std::is_same_v<T, pmr_string> || std::is_same_v<T, std::string>) {
+      const auto length = read_value<uint32_t>();
+      Assert(_position + length <= _end, "Redo log record is truncated");
+      auto string = T{_position, length};
+      _position += length;
+      return string;
+    } else {
+      Assert(_position + sizeof(T) <= _end, "Redo log record is truncated");
+      auto value = T{};
+      std::memcpy(&value, _position, sizeof(T));
+      _position += sizeof(T);
+      return value;
+    }
+  }
+
+  bool at_end() const { return _position == _end; }
+
+ private:
+  const char* _position;
+  const char* const _end;
+};
+
+/**
+ * Parses the entries of a record payload. For insert entries, on_insert(table_name, table, chunk_id, begin_offset,
+ * end_offset, reader) is called and is responsible for consuming the values. For delete entries,
+ * on_delete(table, row_ids) is called.
+ */
+template <typename OnInsert, typename OnDelete>
+void for_each_entry(const char* payload, const size_t payload_size, const OnInsert& on_insert,
+                    const OnDelete& on_delete) {
+  auto reader = PayloadReader{payload, payload_size};
+  reader.read_value<CommitID>();
+  const auto entry_count = reader.read_value<uint32_t>();
+
+  for (auto entry_id = uint32_t{0}; entry_id < entry_count; ++entry_id) {
+    const auto entry_type = reader.read_value<RedoLogEntryType>();
+    const auto table_name = reader.read_value<std::string>();
+    Assert(Hyrise::get().storage_manager.has_table(table_name),
+           "Redo log references table '" + table_name + "', which has not been restored");
+    const auto table = Hyrise::get().storage_manager.get_table(table_name);
+
+    switch (entry_type) {
+      case RedoLogEntryType::Insert: {
+        const auto chunk_id = reader.read_value<ChunkID>();
+        const auto begin_chunk_offset = reader.read_value<ChunkOffset>();
+        const auto end_chunk_offset = reader.read_value<ChunkOffset>();
+        on_insert(table_name, table, chunk_id, begin_chunk_offset, end_chunk_offset, reader);
+      } break;
+
+      case RedoLogEntryType::Delete: {
+        const auto row_count = reader.read_value<uint32_t>();
+        auto row_ids = std::vector<RowID>(row_count);
+        for (auto& row_id : row_ids) {
+          row_id.chunk_id = reader.read_value<ChunkID>();
+          row_id.chunk_offset = reader.read_value<ChunkOffset>();
+        }
+        on_delete(table, row_ids);
+      } break;
+
+      default:
+        Fail("Unknown redo log entry type");
+    }
+  }
+
+  Assert(reader.at_end(), "Redo log record has trailing data");
+}
+
+// Consumes the values of an insert entry. If target_chunk is set, the values are written to its ValueSegments.
+void read_inserted_values(PayloadReader& reader, const Table& table, const std::shared_ptr<Chunk>& target_chunk,
+                          const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset) {
+  const auto column_count = table.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto nullable = table.column_is_nullable(column_id);
+
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      // Chunks that have been encoded after the logged transaction committed already contain its values. We only have
+      // to write values to ValueSegments.
+      auto value_segment = std::shared_ptr<ValueSegment<ColumnDataType>>{};
+      if (target_chunk) {
+        value_segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(target_chunk->get_segment(column_id));
+      }
+
+      for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+        const auto is_null = nullable && reader.read_value<BoolAsByteType>();
+        auto value = reader.read_value<ColumnDataType>();
+        if (!value_segment) continue;
+
+        value_segment->values()[chunk_offset] = std::move(value);
+        if (is_null) value_segment->set_null_value(chunk_offset);
+      }
+    });
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+RedoLogRecord::RedoLogRecord(const CommitID commit_id) : _commit_id{commit_id} {
+  // Reserve space for the header, which is only known after all entries have been added.
+  _buffer.resize(HEADER_SIZE);
+  _write_value(_commit_id);
+  _write_value(_entry_count);
+}
+
+CommitID RedoLogRecord::commit_id() const { return _commit_id; }
+
+bool RedoLogRecord::empty() const { return _entry_count == 0; }
+
+void RedoLogRecord::add_insert(const std::string& table_name, const Table& table, const ChunkID chunk_id,
+                               const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset) {
+  const auto chunk = table.get_chunk(chunk_id);
+  Assert(chunk, "Cannot log inserts into a physically deleted chunk");
+
+  _write_value(RedoLogEntryType::Insert);
+  _write_string(table_name);
+  _write_value(chunk_id);
+  _write_value(begin_chunk_offset);
+  _write_value(end_chunk_offset);
+
+  const auto column_count = table.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto nullable = table.column_is_nullable(column_id);
+
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto value_segment =
+          std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(chunk->get_segment(column_id));
+      Assert(value_segment, "Inserted rows are expected to be stored in ValueSegments");
+
+      const auto& values = value_segment->values();
+      for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+        if (nullable) _write_value(static_cast<BoolAsByteType>(value_segment->is_null(chunk_offset)));
+
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          _write_string(values[chunk_offset]);
+        } else {
+          _write_value(values[chunk_offset]);
+        }
+      }
+    });
+  }
+
+  ++_entry_count;
+}
+
+void RedoLogRecord::add_delete(const std::shared_ptr<const Table>& table, const AbstractPosList& pos_list) {
+  const auto table_name = _stored_table_name(table);
+  if (!table_name) return;
+
+  _write_value(RedoLogEntryType::Delete);
+  _write_string(*table_name);
+  _write_value(static_cast<uint32_t>(pos_list.size()));
+  for (const auto& row_id : pos_list) {
+    _write_value(row_id.chunk_id);
+    _write_value(row_id.chunk_offset);
+  }
+
+  ++_entry_count;
+}
+
+const std::vector<char>& RedoLogRecord::serialize() {
+  // Update the entry count, which follows the header and the commit ID.
+  std::memcpy(_buffer.data() + HEADER_SIZE + sizeof(CommitID), &_entry_count, sizeof(_entry_count));
+
+  const auto payload_size = static_cast<uint32_t>(_buffer.size() - HEADER_SIZE);
+  auto crc = boost::crc_32_type{};
+  crc.process_bytes(_buffer.data() + HEADER_SIZE, payload_size);
+  const auto checksum = static_cast<uint32_t>(crc.checksum());
+
+  std::memcpy(_buffer.data(), &payload_size, sizeof(payload_size));
+  std::memcpy(_buffer.data() + sizeof(payload_size), &checksum, sizeof(checksum));
+
+  return _buffer;
+}
+
+template <typename T>
+void RedoLogRecord::_write_value(const T& value) {
+  const auto* const bytes = reinterpret_cast<const char*>(&value);
+  _buffer.insert(_buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void RedoLogRecord::_write_string(const std::string_view string) {
+  _write_value(static_cast<uint32_t>(string.size()));
+  _buffer.insert(_buffer.end(), string.begin(), string.end());
+}
+
+std::optional<std::string> RedoLogRecord::_stored_table_name(const std::shared_ptr<const Table>& table) {
+  if (table == _last_looked_up_table) return _last_looked_up_table_name;
+
+  _last_looked_up_table = table;
+  _last_looked_up_table_name = std::nullopt;
+  for (const auto& [table_name, stored_table] : Hyrise::get().storage_manager.tables()) {
+    if (stored_table == table) {
+      _last_looked_up_table_name = table_name;
+      break;
+    }
+  }
+
+  return _last_looked_up_table_name;
+}
+
+void RedoLogReplayer::allocate(const char* payload, const size_t payload_size) {
+  for_each_entry(
+      payload, payload_size,
+      [&](const auto& table_name, const auto& table, const auto chunk_id, const auto begin_chunk_offset,
+          const auto end_chunk_offset, auto& reader) {
+        // Only the row ranges are needed in this pass, the values are skipped.
+        read_inserted_values(reader, *table, nullptr, begin_chunk_offset, end_chunk_offset);
+
+        auto& required_chunk_size = _required_chunk_sizes[table_name][chunk_id];
+        required_chunk_size = std::max(required_chunk_size, end_chunk_offset);
+      },
+      [](const auto& /*table*/, const auto& /*row_ids*/) {});
+}
+
+void RedoLogReplayer::finish_allocation() {
+  for (const auto& [table_name, required_chunk_sizes] : _required_chunk_sizes) {
+    const auto table = Hyrise::get().storage_manager.get_table(table_name);
+    const auto max_chunk_id = required_chunk_sizes.rbegin()->first;
+
+    for (auto chunk_id = ChunkID{0}; chunk_id <= max_chunk_id; ++chunk_id) {
+      const auto required_chunk_size_iter = required_chunk_sizes.find(chunk_id);
+      const auto required_chunk_size =
+          required_chunk_size_iter != required_chunk_sizes.end() ? required_chunk_size_iter->second : ChunkOffset{0};
+
+      if (chunk_id == table->chunk_count()) {
+        table->append_mutable_chunk();
+
+        // Chunks whose rows were all rolled back or never committed do not show up in the log. As no entry will write
+        // to them, we can remove them right away. This also keeps the invariant that only the last chunk may be empty.
+        if (required_chunk_size == 0) {
+          table->remove_chunk(chunk_id);
+          continue;
+        }
+      }
+
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk || chunk->size() >= required_chunk_size) continue;
+
+      Assert(chunk->is_mutable(), "Redo log writes beyond the end of an immutable chunk");
+      const auto column_count = chunk->column_count();
+      for (auto reverse_column_id = ColumnID{0}; reverse_column_id < column_count; ++reverse_column_id) {
+        const auto column_id = static_cast<ColumnID>(column_count - reverse_column_id - 1);
+
+        resolve_data_type(table->column_data_type(column_id), [&](const auto data_type_t) {
+          using ColumnDataType = typename decltype(data_type_t)::type;
+
+          const auto value_segment =
+              std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(chunk->get_segment(column_id));
+          Assert(value_segment, "Mutable chunks are expected to consist of ValueSegments");
+          value_segment->resize(required_chunk_size);
+        });
+      }
+    }
+  }
+
+  _required_chunk_sizes.clear();
+}
+
+void RedoLogReplayer::apply(const char* payload, const size_t payload_size) {
+  const auto commit_id = RedoLogReplayer::commit_id(payload);
+
+  for_each_entry(
+      payload, payload_size,
+      [&](const auto& /*table_name*/, const auto& table, const auto chunk_id, const auto begin_chunk_offset,
+          const auto end_chunk_offset, auto& reader) {
+        const auto chunk = table->get_chunk(chunk_id);
+        Assert(chunk, "Redo log writes to a physically deleted chunk");
+        read_inserted_values(reader, *table, chunk, begin_chunk_offset, end_chunk_offset);
+
+        const auto& mvcc_data = chunk->mvcc_data();
+        for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+          mvcc_data->set_begin_cid(chunk_offset, commit_id);
+          mvcc_data->set_tid(chunk_offset, INVALID_TRANSACTION_ID, std::memory_order_relaxed);
+        }
+
+        // Immutable chunks restored from a checkpoint may contain rows that were committed after the checkpoint.
+        if (mvcc_data->max_begin_cid) mvcc_data->max_begin_cid = std::max(*mvcc_data->max_begin_cid, commit_id);
+      },
+      [&](const auto& table, const auto& row_ids) {
+        for (const auto& row_id : row_ids) {
+          // Chunks that have been removed by the MvccDeletePlugin were fully invalidated before.
+          const auto chunk = table->get_chunk(row_id.chunk_id);
+          if (!chunk) continue;
+
+          chunk->mvcc_data()->set_end_cid(row_id.chunk_offset, commit_id);
+          chunk->increase_invalid_row_count(1);
+        }
+      });
+}
+
+void RedoLogReplayer::finish() {
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    if (table->uses_mvcc() != UseMvcc::Yes) continue;
+
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      // Rows that are still marked as uncommitted were written by transactions that did not commit before the
+      // crash. Treat them like rolled back rows (see Insert::_on_rollback_records).
+      const auto& mvcc_data = chunk->mvcc_data();
+      const auto chunk_size = chunk->size();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        if (mvcc_data->get_begin_cid(chunk_offset) != MvccData::MAX_COMMIT_ID) continue;
+
+        mvcc_data->set_end_cid(chunk_offset, CommitID{0});
+        mvcc_data->set_begin_cid(chunk_offset, CommitID{0});
+        mvcc_data->set_tid(chunk_offset, INVALID_TRANSACTION_ID, std::memory_order_relaxed);
+        chunk->increase_invalid_row_count(1);
+      }
+    }
+  }
+}
+
+CommitID RedoLogReplayer::commit_id(const char* payload) {
+  auto commit_id = CommitID{};
+  std::memcpy(&commit_id, payload, sizeof(CommitID));
+  return commit_id;
+}
+
+}  // namespace opossum
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractPosList;
+class Table;
+
+enum class RedoLogEntryType : uint8_t { Insert, Delete };
+
+/**
+ * A RedoLogRecord holds the serialized modifications of a single committed transaction. It is filled by the
+ * AbstractReadWriteOperators of the transaction (see AbstractReadWriteOperator::log_records) and handed to the
+ * RedoLog, which makes it durable as part of a group commit.
+ *
+ * Records are physical: they reference the RowIDs that Insert and Delete wrote to. As Hyrise never updates rows in
+ * place and never moves rows between positions, a record can be applied to a table that has been restored from a
+ * checkpoint with the same chunk layout (see Checkpoint).
+ *
+ * Serialized format of a record:
+ *
+ * Description                 | Type                                | Size in bytes
+ * --------------------------------------------------------------------------------------------------------
+ * Payload size                | uint32_t                            | 4
+ * Payload checksum (CRC32)    | uint32_t                            | 4
+ * Commit ID                   | CommitID                            | 4
+ * Entry count                 | uint32_t                            | 4
+ * Entries                     | see below                           | Payload size - 8
+ *
+ * Each entry starts with its RedoLogEntryType (1 byte) and the name of the modified table (uint32_t length followed
+ * by the characters). Insert entries then store the ChunkID, the begin and end ChunkOffset of the written range, and
+ * the values column by column. For nullable columns, each value is preceded by a NULL flag (BoolAsByteType). Strings
+ * are stored as uint32_t length followed by the characters, all other types as their raw bytes. Delete entries store
+ * the number of deleted rows followed by their RowIDs.
+ */
+class RedoLogRecord {
+ public:
+  static constexpr auto HEADER_SIZE = sizeof(uint32_t) * 2;
+
+  explicit RedoLogRecord(const CommitID commit_id);
+
+  CommitID commit_id() const;
+
+  // Returns true if no entries have been added, i.e., there is nothing to be logged.
+  bool empty() const;
+
+  /**
+   * Logs the rows [begin_chunk_offset, end_chunk_offset) of the given chunk of a stored table. The values are read
+   * from the table's ValueSegments, which Insert has finished writing to before commit.
+   */
+  void add_insert(const std::string& table_name, const Table& table, const ChunkID chunk_id,
+                  const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset);
+
+  /**
+   * Logs the deletion of the given rows of a stored table. Tables that are not registered in the StorageManager
+   * cannot be recovered and are skipped.
+   */
+  void add_delete(const std::shared_ptr<const Table>& table, const AbstractPosList& pos_list);
+
+  // Finalizes the header (size and checksum) and returns the serialized record.
+  const std::vector<char>& serialize();
+
+ private:
+  template <typename T>
+  void _write_value(const T& value);
+
+  void _write_string(const std::string_view string);
+
+  // Returns the name under which the table is registered in the StorageManager.
+  std::optional<std::string> _stored_table_name(const std::shared_ptr<const Table>& table);
+
+  const CommitID _commit_id;
+  uint32_t _entry_count{0};
+  std::vector<char> _buffer;
+
+  // Delete operators mostly reference a single table. Remember the last lookup to avoid scanning the StorageManager.
+  std::shared_ptr<const Table> _last_looked_up_table;
+  std::optional<std::string> _last_looked_up_table_name;
+};
+
+/**
+ * Applies serialized records to the tables stored in the StorageManager during recovery. Replaying happens in two
+ * phases: First, all records are passed to allocate() so that the rows they reference can be created in ascending
+ * chunk order and with their final size. Then, the records are passed to apply() in commit order, which writes values
+ * and MVCC data. Finally, finish() marks all rows that no replayed transaction committed as rolled back.
+ */
+class RedoLogReplayer {
+ public:
+  // The payload is the serialized record without its header (see RedoLogRecord::HEADER_SIZE).
+  void allocate(const char* payload, const size_t payload_size);
+  void finish_allocation();
+
+  void apply(const char* payload, const size_t payload_size);
+  void finish();
+
+  // Returns the commit ID stored in a record payload without parsing its entries.
+  static CommitID commit_id(const char* payload);
+
+ private:
+  std::map<std::string, std::map<ChunkID, ChunkOffset>> _required_chunk_sizes;
+};
+
+}  // namespace opossum
@@ -58,6 +58,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_all.hpp"
 #include "operators/union_positions.hpp"
 #include "operators/update.hpp"
@@ -298,8 +299,13 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
   const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
   auto input_operator = translate_node(node->left_input());
 
-  std::shared_ptr<AbstractOperator> current_pqp = input_operator;
-  const auto& pqp_expressions = _translate_expressions(sort_node->node_expressions, node->left_input());
+  return std::make_shared<Sort>(input_operator, _translate_sort_column_definitions(sort_node), Chunk::DEFAULT_SIZE,
+                                Sort::ForceMaterialization::No, Hyrise::get().operator_memory_budget);
+}
+
+std::vector<SortColumnDefinition> LQPTranslator::_translate_sort_column_definitions(
+    const std::shared_ptr<SortNode>& sort_node) const {
+  const auto& pqp_expressions = _translate_expressions(sort_node->node_expressions, sort_node->left_input());
 
   auto pqp_expression_iter = pqp_expressions.begin();
   auto sort_mode_iter = sort_node->sort_modes.begin();
@@ -314,9 +320,8 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
 
     column_definitions.emplace_back(SortColumnDefinition{pqp_column_expression->column_id, *sort_mode_iter});
   }
-  current_pqp = std::make_shared<Sort>(current_pqp, column_definitions);
 
-  return current_pqp;
+  return column_definitions;
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
@@ -410,15 +415,26 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     group_by_column_ids.emplace_back(*column_id);
   }
 
-  return std::make_shared<AggregateHash>(input_operator, pqp_aggregate_expressions, group_by_column_ids);
+  return std::make_shared<AggregateHash>(input_operator, pqp_aggregate_expressions, group_by_column_ids,
+                                         Hyrise::get().operator_memory_budget);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_limit_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_input());
   auto limit_node = std::dynamic_pointer_cast<LimitNode>(node);
-  return std::make_shared<Limit>(
-      input_operator, _translate_expressions({limit_node->num_rows_expression()}, node->left_input()).front());
+  const auto row_count_expression =
+      _translate_expressions({limit_node->num_rows_expression()}, node->left_input()).front();
+
+  // A Limit on top of a Sort (i.e., ORDER BY ... LIMIT) is translated to a TopK, which does not sort the entire input.
+  // If the sort node has other outputs, its sorted result is needed anyway and the Sort is kept.
+  if (const auto sort_node = std::dynamic_pointer_cast<SortNode>(node->left_input());
+      sort_node && sort_node->outputs().size() == 1) {
+    const auto input_operator = translate_node(sort_node->left_input());
+    return std::make_shared<TopK>(input_operator, _translate_sort_column_definitions(sort_node), row_count_expression);
+  }
+
+  const auto input_operator = translate_node(node->left_input());
+  return std::make_shared<Limit>(input_operator, row_count_expression);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_insert_node(
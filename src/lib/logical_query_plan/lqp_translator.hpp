@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "abstract_lqp_node.hpp"
 #include "all_type_variant.hpp"
@@ -13,6 +14,7 @@ class AbstractOperator;
 class TransactionContext;
 class AbstractExpression;
 class PredicateNode;
+class SortNode;
 class TableScan;
 struct OperatorScanPredicate;
 struct OperatorJoinPredicate;
@@ -40,6 +42,8 @@ class LQPTranslator {
   std::shared_ptr<AbstractOperator> _translate_alias_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_projection_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_sort_node(const std::shared_ptr<AbstractLQPNode>& node) const;
+  std::vector<SortColumnDefinition> _translate_sort_column_definitions(
+      const std::shared_ptr<SortNode>& sort_node) const;
   std::shared_ptr<AbstractOperator> _translate_join_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_aggregate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_limit_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -0,0 +1,62 @@
+#include "mapped_pages_memory_resource.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "utils/assert.hpp"
+
+namespace {
+
+// Empty allocations occupy a page as well, since mmap does not accept a length of zero.
+size_t round_up_to_pages(const size_t bytes) {
+  const auto page_size = opossum::MappedPagesMemoryResource::page_size();
+  return std::max((bytes + page_size - 1) / page_size * page_size, page_size);
+}
+
+}  // namespace
+
+namespace opossum {
+
+MappedPagesMemoryResource& MappedPagesMemoryResource::get() {
+  static auto* instance = new MappedPagesMemoryResource();  // NOLINT
+  return *instance;
+}
+
+size_t MappedPagesMemoryResource::page_size() {
+  static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+void MappedPagesMemoryResource::map_file_pages(void* buffer, size_t bytes, int file_descriptor, size_t file_offset) {
+  Assert(reinterpret_cast<uintptr_t>(buffer) % page_size() == 0, "Buffer was not allocated from this resource");
+  Assert(file_offset % page_size() == 0, "File pages can only be mapped from page-aligned offsets");
+  if (bytes == 0) return;
+
+  // MAP_PRIVATE allows writes to the buffer (even though the file is opened read-only) without them reaching the file.
+  // The last page may extend beyond the requested bytes or the end of the file. Beyond the end of the file, the OS
+  // fills it with zeros.
+  const auto address = mmap(buffer, round_up_to_pages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                            file_descriptor, static_cast<off_t>(file_offset));
+  Assert(address == buffer, "Could not map file pages into buffer");
+}
+
+void* MappedPagesMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  DebugAssert(alignment <= page_size(), "Alignment exceeds page size");
+  const auto address =
+      mmap(nullptr, round_up_to_pages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (address == MAP_FAILED) throw std::bad_alloc{};
+  return address;
+}
+
+void MappedPagesMemoryResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+  // Unmaps both the anonymous pages and file pages mapped by map_file_pages.
+  munmap(pointer, round_up_to_pages(bytes));
+}
+
+bool MappedPagesMemoryResource::do_is_equal(const memory_resource& other) const noexcept { return &other == this; }
+
+}  // namespace opossum
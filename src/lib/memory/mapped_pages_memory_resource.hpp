@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Memory resource that serves every allocation from its own anonymous, page-aligned mapping. The BinaryParser uses it
+ * for the buffers of segments that it loads from page-aligned binary files: once a buffer is allocated, the matching
+ * pages of the file are mapped over it (see map_file_pages). The buffer then references the page cache instead of a
+ * private copy, so the OS reads its pages on first access and can evict them again when memory gets scarce. Writes to
+ * such a buffer only modify private copies of the affected pages, never the file.
+ *
+ * As each allocation occupies at least one page and one mapping, the resource is only meant for large buffers.
+ */
+class MappedPagesMemoryResource : public boost::container::pmr::memory_resource, public Noncopyable {
+ public:
+  // Similar to the default resource, the instance is never destroyed because segments allocated from it may be
+  // destroyed at any point until the process exits.
+  static MappedPagesMemoryResource& get();
+
+  static size_t page_size();
+
+  // Replaces the pages backing the first `bytes` bytes of `buffer`, which must have been allocated from this resource,
+  // with the pages of the file that start at `file_offset`. `file_offset` must be a multiple of the page size.
+  void map_file_pages(void* buffer, size_t bytes, int file_descriptor, size_t file_offset);
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const memory_resource& other) const noexcept override;
+
+ private:
+  MappedPagesMemoryResource() = default;
+};
+
+}  // namespace opossum
@@ -40,12 +40,14 @@ enum class OperatorType {
   JoinSortMerge,
   JoinVerification,
   Limit,
+  MorselPipeline,
   Print,
   Product,
   Projection,
   Sort,
   TableScan,
   TableWrapper,
+  TopK,
   UnionAll,
   UnionPositions,
   Update,
@@ -51,6 +51,12 @@ void AbstractReadWriteOperator::rollback_records() {
   _rw_state = ReadWriteOperatorState::RolledBack;
 }
 
+void AbstractReadWriteOperator::log_records(RedoLogRecord& record) const {
+  Assert(_rw_state == ReadWriteOperatorState::Committed, "Only committed operators can be logged.");
+
+  _on_log_records(record);
+}
+
 bool AbstractReadWriteOperator::execute_failed() const {
   return _rw_state == ReadWriteOperatorState::Conflicted || _rw_state == ReadWriteOperatorState::RolledBack;
 }
@@ -13,6 +13,8 @@
 
 namespace opossum {
 
+class RedoLogRecord;
+
 enum class ReadWriteOperatorState {
   Pending,     // The operator has been instantiated.
   Executed,    // Execution succeeded.
@@ -48,6 +50,12 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   void rollback_records();
 
+  /**
+   * Adds the committed modifications of the operator to the transaction's redo log record. Called after
+   * commit_records if a RedoLog is set.
+   */
+  void log_records(RedoLogRecord& record) const;
+
   /**
    * Returns true if a previous call to _on_execute produced an error.
    */
@@ -80,6 +88,11 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   virtual void _on_rollback_records() = 0;
 
+  /**
+   * Called by log_records. Operators that modify stored tables override this to log their modifications.
+   */
+  virtual void _on_log_records(RedoLogRecord& record) const {}
+
   /**
    * This method is used in sub classes in their _on_execute() method.
    *
@@ -1,7 +1,13 @@
 #include "aggregate_hash.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -19,121 +25,282 @@
 #include "storage/segment_iterate.hpp"
 #include "utils/aligned_size.hpp"
 #include "utils/assert.hpp"
+#include "utils/format_bytes.hpp"
 #include "utils/performance_warning.hpp"
+#include "utils/spill_file.hpp"
 #include "utils/timer.hpp"
 
 namespace {
 using namespace opossum;  // NOLINT
 
-// `get_or_add_result` is called once per row when iterating over a column that is to be aggregated. The row's `key` has
-// been calculated as part of `_partition_by_groupby_keys`. We also pass in the `row_id` of that row. This row id is
-// stored in `Results` so that we can later use it to reconstruct the values in the group-by columns. If the operator
-// calculates multiple aggregate functions, we only need to perform this lookup as part of the first aggregate function.
-// By setting CacheResultIds to true_type, we can store the result of the lookup in the AggregateKey. Following
-// aggregate functions can then retrieve the index from the AggregateKey.
-constexpr auto CACHE_MASK = AggregateKeyEntry{1} << 63u;  // See explanation below
-
-template <typename CacheResultIds, typename ResultIds, typename Results, typename AggregateKey>
-typename Results::reference get_or_add_result(CacheResultIds, ResultIds& result_ids, Results& results,
-                                              AggregateKey& key, const RowID& row_id) {
-  if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
-    // No GROUP BY columns are defined for this aggregate operator. We still want to keep most code paths similar and
-    // avoid special handling. Thus, get_or_add_result is still called, however, we always return the same result
-    // reference.
-    if (results.empty()) {
-      results.emplace_back();
-      results[0].row_id = row_id;
-    }
-    return results[0];
-  } else {
-    // As described above, we may store the index into the results vector in the AggregateKey. If the AggregateKey
-    // contains multiple entries, we use the first one. As such, we store a (non-owning, raw) pointer to either the only
-    // or the first entry in first_key_entry. We need a raw pointer as a reference cannot be null or reset.
-    AggregateKeyEntry* first_key_entry;
-    if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
-      first_key_entry = &key;
-    } else {
-      first_key_entry = &key[0];
+/*
+Visitor context that holds the AggregateResults of one aggregate function. In AggregateHash::_contexts_per_column, it
+is stored type-erased as a SegmentVisitorContext.
+*/
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+struct AggregateResultContext : SegmentVisitorContext {
+  using AggregateResultAllocator = PolymorphicAllocator<AggregateResults<ColumnDataType, aggregate_function>>;
+
+  // In cases where we know how many values to expect, we can preallocate the context in order to avoid later
+  // re-allocations.
+  explicit AggregateResultContext(const size_t preallocated_size = 0)
+      : results(preallocated_size, AggregateResultAllocator{&buffer}) {}
+
+  boost::container::pmr::monotonic_buffer_resource buffer;
+  AggregateResults<ColumnDataType, aggregate_function> results;
+};
+
+// Result of pre-aggregating the rows of a single chunk, see AggregateHash::_aggregate()
+template <typename AggregateKey>
+struct PartialAggregation {
+  // The keys of the chunk's groups, indexed by the AggregateResultId of the group within the chunk
+  std::vector<AggregateKey> group_keys;
+
+  // The AggregateResultIds of the chunk's groups, ordered by their radix partition. The groups of partition p are
+  // found in [partition_offsets[p], partition_offsets[p + 1]).
+  std::vector<AggregateResultId> partitioned_group_ids;
+  std::vector<size_t> partition_offsets;
+
+  // One AggregateResultContext for each entry in _contexts_per_column, holding the partial results of the groups
+  std::vector<std::shared_ptr<SegmentVisitorContext>> contexts;
+
+  // Estimated memory held by the group keys and the partial results, used to enforce the memory budget
+  size_t size_in_bytes{0};
+};
+
+// The groups are radix-partitioned so that the partial results of different partitions can be merged in parallel. A
+// partition should hold enough groups to make its merge task worthwhile.
+constexpr auto MIN_GROUPS_PER_PARTITION = size_t{16'384};
+constexpr auto MAX_PARTITION_COUNT = size_t{64};
+
+// With a memory budget, more partitions might be needed so that each spilled partition can be merged within the budget
+constexpr auto MAX_SPILL_PARTITION_COUNT = size_t{1'024};
+
+size_t calculate_partition_count(const size_t estimated_group_count) {
+  auto partition_count = size_t{1};
+  while (partition_count < MAX_PARTITION_COUNT &&
+         estimated_group_count / (partition_count * 2) >= MIN_GROUPS_PER_PARTITION) {
+    partition_count *= 2;
+  }
+  return partition_count;
+}
+
+// std::hash is the identity for integers and the group keys' hash combines the hashes of their entries, so the lower
+// bits of these hashes are often equal for many groups (e.g., for keys that are multiples of the partition count).
+// Before selecting a partition with the lower bits, we spread the hash with the finalizer of MurmurHash3 (as the
+// BloomFilter does).
+size_t mix_hash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// The AggregateResultContexts are type-erased. This calls `functor` with the ColumnDataType (as a hana type) and the
+// AggregateFunction (as an integral_constant) of the context that belongs to the aggregate at `context_index`. An
+// index past the last aggregate denotes the dummy context of the DISTINCT implementation, which is the only context
+// using DistinctColumnType.
+template <typename Functor>
+void resolve_aggregate_context_type(const std::vector<std::shared_ptr<AggregateExpression>>& aggregates,
+                                    const Table& input_table, const size_t context_index, const Functor& functor) {
+  if (context_index == aggregates.size()) {
+    functor(boost::hana::type_c<DistinctColumnType>,
+            std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+    return;
+  }
+
+  const auto& aggregate = *aggregates[context_index];
+  const auto input_column_id = static_cast<const PQPColumnExpression&>(*aggregate.argument()).column_id;
+  if (input_column_id == INVALID_COLUMN_ID) {
+    // SELECT COUNT(*) - we know the template arguments, so we don't need to resolve the column's data type
+    functor(boost::hana::type_c<CountColumnType>,
+            std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+    return;
+  }
+
+  resolve_data_type(input_table.column_data_type(input_column_id), [&](const auto type) {
+    switch (aggregate.aggregate_function) {
+      case AggregateFunction::Min:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+        break;
+      case AggregateFunction::Max:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Max>{});
+        break;
+      case AggregateFunction::Sum:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Sum>{});
+        break;
+      case AggregateFunction::Avg:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Avg>{});
+        break;
+      case AggregateFunction::Count:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+        break;
+      case AggregateFunction::CountDistinct:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::CountDistinct>{});
+        break;
+      case AggregateFunction::StandardDeviationSample:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::StandardDeviationSample>{});
+        break;
+      case AggregateFunction::Any:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Any>{});
+        break;
     }
+  });
+}
 
-    // Explanation for CACHE_MASK (placed here because it has to be defined outside but the explanation makes more sense
-    // at this place):
-    // If we store the result of the hashmap lookup (i.e., the index into results) in the AggregateKeyEntry, we do this
-    // by storing the index in the lower 63 bits of first_key_entry and setting the most significant bit to 1 as a
-    // marker that the AggregateKeyEntry now contains a cached result. We can do this because AggregateKeyEntry can not
-    // become larger than the maximum size of a table (i.e., the maximum representable RowID), which is 2^31 * 2^31 ==
-    // 2^62. This avoids making the AggregateKey bigger: Adding another 64-bit value (for an index of 2^62 values) for
-    // the cached value would double the size of the AggregateKey in the case of a single group-by column, thus halving
-    // the utilization of the CPU cache. Same for a discriminating union, where the data structure alignment would also
-    // result in another 8 bytes being used.
-    static_assert(std::is_same_v<AggregateKeyEntry, uint64_t>,
-                  "Expected AggregateKeyEntry to be unsigned 64-bit value");
-
-    // Check if the AggregateKey already contains a stored index.
-    if constexpr (std::is_same_v<CacheResultIds, std::true_type>) {
-      if (*first_key_entry & CACHE_MASK) {
-        // The most significant bit is a 1, remove it by XORing the mask gives us the index into the results vector.
-        const auto result_id = *first_key_entry ^ CACHE_MASK;
-
-        // If we have not seen this index as part of the current aggregate function, the results vector may not yet have
-        // the correct size. Resize it if necessary and write the current row_id so that we can recover the GroupBy
-        // column(s) later. By default, the newly created values have a NULL_ROW_ID and are later ignored. We grow
-        // the vector slightly more than necessary. Otherwise, monotonically increasing keys would lead to one resize
-        // per row.
-        if (result_id >= results.size()) {
-          results.resize(static_cast<size_t>(static_cast<double>(result_id + 1) * 1.5));
-        }
-        results[result_id].row_id = row_id;
+// Aggregates the values of a segment into `results`, which holds one entry per group of the chunk. `group_ids` holds
+// the group of each row.
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+__attribute__((hot)) void aggregate_segment(const AbstractSegment& abstract_segment,
+                                            const std::vector<AggregateResultId>& group_ids,
+                                            AggregateResults<ColumnDataType, aggregate_function>& results) {
+  using AggregateType = typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType;
 
-        return results[result_id];
+  auto aggregator =
+      AggregateFunctionBuilder<ColumnDataType, AggregateType, aggregate_function>().get_aggregate_function();
+
+  auto chunk_offset = ChunkOffset{0};
+  segment_iterate<ColumnDataType>(abstract_segment, [&](const auto& position) {
+    // If the value is NULL, the current aggregate value does not change.
+    if (!position.is_null()) {
+      auto& result = results[group_ids[chunk_offset]];
+      if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+        // For the case of CountDistinct, insert the current value into the set to keep track of distinct values
+        result.accumulator.emplace(position.value());
+      } else {
+        aggregator(ColumnDataType{position.value()}, result.aggregate_count, result.accumulator);
       }
-    } else {
-      Assert(!(*first_key_entry & CACHE_MASK),
-             "CacheResultIds is set to false, but a cached or immediate key shortcut entry was found");
+
+      ++result.aggregate_count;
     }
 
-    // Lookup the key in the result_ids map
-    auto it = result_ids.find(key);
-    if (it != result_ids.end()) {
-      // We have already seen this group and need to return a reference to the group's result.
-      const auto result_id = it->second;
-      if constexpr (std::is_same_v<CacheResultIds, std::true_type>) {
-        // If requested, store the index the the first_key_entry and set the most significant bit to 1.
-        *first_key_entry = CACHE_MASK | result_id;
+    ++chunk_offset;
+  });
+}
+
+// Merges the partial result of a group into the group's result. The partial result must have been calculated on rows
+// that follow the rows of `result` so that `result.row_id` keeps pointing to the group's first row.
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+void merge_aggregate_result(AggregateResult<ColumnDataType, aggregate_function>& result,
+                            AggregateResult<ColumnDataType, aggregate_function>& partial_result) {
+  if (result.row_id.is_null()) {
+    // This is the first partial result of the group
+    result = std::move(partial_result);
+    return;
+  }
+
+  // No non-NULL values contributed to the partial result
+  if (partial_result.aggregate_count == 0) return;
+
+  if constexpr (aggregate_function == AggregateFunction::Min) {
+    if (result.aggregate_count == 0 || value_smaller(partial_result.accumulator, result.accumulator)) {
+      result.accumulator = std::move(partial_result.accumulator);
+    }
+  } else if constexpr (aggregate_function == AggregateFunction::Max) {
+    if (result.aggregate_count == 0 || value_greater(partial_result.accumulator, result.accumulator)) {
+      result.accumulator = std::move(partial_result.accumulator);
+    }
+  } else if constexpr (aggregate_function == AggregateFunction::Sum || aggregate_function == AggregateFunction::Avg) {
+    // AVG divides the sum by aggregate_count when writing the output
+    result.accumulator += partial_result.accumulator;
+  } else if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+    result.accumulator.insert(partial_result.accumulator.begin(), partial_result.accumulator.end());
+  } else if constexpr (aggregate_function == AggregateFunction::StandardDeviationSample) {
+    if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+      // Combine the counts, means, and squared distances from the mean of both parts, see the parallel algorithm in
+      // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm. The accumulators are
+      // laid out as described in AggregateFunctionBuilder.
+      auto& accumulator = result.accumulator;
+      const auto& partial_accumulator = partial_result.accumulator;
+
+      const auto count = accumulator[0] + partial_accumulator[0];
+      const auto delta = partial_accumulator[1] - accumulator[1];
+      accumulator[1] += delta * partial_accumulator[0] / count;
+      accumulator[2] += partial_accumulator[2] + delta * delta * accumulator[0] * partial_accumulator[0] / count;
+      accumulator[0] = count;
+
+      if (count > 1) {
+        accumulator[3] = std::sqrt(accumulator[2] / (count - 1));
       }
-      return results[result_id];
+    } else {
+      Fail("StandardDeviationSample not available for non-arithmetic types.");
     }
+  }
 
-    // We are seeing this group (i.e., this AggregateKey) for the first time, so we need to add it to the list of
-    // results and set the row_id needed for restoring the GroupBy column(s).
-    const auto result_id = results.size();
-    result_ids.emplace_hint(it, key, result_id);
-
-    results.emplace_back();
-    results[result_id].row_id = row_id;
+  // COUNT only needs the aggregate_count, ANY does not use its results at all.
+  result.aggregate_count += partial_result.aggregate_count;
+}
 
-    if constexpr (std::is_same_v<CacheResultIds, std::true_type>) {
-      // If requested, store the index the the first_key_entry and set the most significant bit to 1.
-      *first_key_entry = CACHE_MASK | result_id;
+// Serialization of group keys and partial results for spilling them to a SpillFile. Values are appended to `buffer`
+// and read back in the same order, advancing `data`.
+template <typename T>
+void write_spill_value(std::vector<char>& buffer, const T& value) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    write_spill_value(buffer, value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+  } else if constexpr (std::is_same_v<T, AggregateKeySmallVector>) {
+    write_spill_value(buffer, value.size());
+    for (const auto entry : value) {
+      write_spill_value(buffer, entry);
     }
+  } else {
+    static_assert(std::is_trivially_copyable_v<T>, "Cannot spill values of this type");
+    const auto* const bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+}
 
-    return results[result_id];
+template <typename T>
+void read_spill_value(const char*& data, T& value) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    auto size = size_t{0};
+    read_spill_value(data, size);
+    value.assign(data, size);
+    data += size;
+  } else if constexpr (std::is_same_v<T, AggregateKeySmallVector>) {
+    auto size = size_t{0};
+    read_spill_value(data, size);
+    value.resize(size);
+    for (auto& entry : value) {
+      read_spill_value(data, entry);
+    }
+  } else {
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
   }
 }
 
-template <typename AggregateKey>
-AggregateKey& get_aggregate_key([[maybe_unused]] KeysPerChunk<AggregateKey>& keys_per_chunk,
-                                [[maybe_unused]] const ChunkID chunk_id,
-                                [[maybe_unused]] const ChunkOffset chunk_offset) {
-  if constexpr (!std::is_same_v<AggregateKey, EmptyAggregateKey>) {
-    auto& hash_keys = keys_per_chunk[chunk_id];
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+void write_spill_result(std::vector<char>& buffer, const AggregateResult<ColumnDataType, aggregate_function>& result) {
+  write_spill_value(buffer, result.row_id);
+  write_spill_value(buffer, result.aggregate_count);
+  if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+    write_spill_value(buffer, result.accumulator.size());
+    for (const auto& value : result.accumulator) {
+      write_spill_value(buffer, value);
+    }
+  } else {
+    write_spill_value(buffer, result.accumulator);
+  }
+}
 
-    return hash_keys[chunk_offset];
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+void read_spill_result(const char*& data, AggregateResult<ColumnDataType, aggregate_function>& result) {
+  read_spill_value(data, result.row_id);
+  read_spill_value(data, result.aggregate_count);
+  if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+    auto size = size_t{0};
+    read_spill_value(data, size);
+    result.accumulator.reserve(size);
+    auto value = ColumnDataType{};
+    for (auto index = size_t{0}; index < size; ++index) {
+      read_spill_value(data, value);
+      result.accumulator.emplace(std::move(value));
+    }
   } else {
-    // We have to return a reference to something, so we create a static EmptyAggregateKey here which is used by
-    // every call.
-    static EmptyAggregateKey empty_aggregate_key;
-    return empty_aggregate_key;
+    read_spill_value(data, result.accumulator);
   }
 }
 
@@ -143,15 +310,19 @@ namespace opossum {
 
 AggregateHash::AggregateHash(const std::shared_ptr<AbstractOperator>& in,
                              const std::vector<std::shared_ptr<AggregateExpression>>& aggregates,
-                             const std::vector<ColumnID>& groupby_column_ids)
-    : AbstractAggregateOperator(in, aggregates, groupby_column_ids,
-                                std::make_unique<OperatorPerformanceData<OperatorSteps>>()) {
+                             const std::vector<ColumnID>& groupby_column_ids,
+                             const std::optional<size_t> memory_budget)
+    : AbstractAggregateOperator(in, aggregates, groupby_column_ids, std::make_unique<PerformanceData>()),
+      _memory_budget(memory_budget) {
+  DebugAssert(!_memory_budget || *_memory_budget > 0, "Memory budget must be positive");
   _has_aggregate_functions =
       !_aggregates.empty() && !std::all_of(_aggregates.begin(), _aggregates.end(), [](const auto aggregate_expression) {
         return aggregate_expression->aggregate_function == AggregateFunction::Any;
       });
 }
 
+std::optional<size_t> AggregateHash::memory_budget() const { return _memory_budget; }
+
 const std::string& AggregateHash::name() const {
   static const auto name = std::string{"AggregateHash"};
   return name;
@@ -161,97 +332,13 @@ std::shared_ptr<AbstractOperator> AggregateHash::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
-  return std::make_shared<AggregateHash>(copied_left_input, _aggregates, _groupby_column_ids);
+  return std::make_shared<AggregateHash>(copied_left_input, _aggregates, _groupby_column_ids, _memory_budget);
 }
 
 void AggregateHash::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
 void AggregateHash::_on_cleanup() { _contexts_per_column.clear(); }
 
-/*
-Visitor context for the AggregateVisitor. The AggregateResultContext can be used without knowing the
-AggregateKey, the AggregateContext is the "full" version.
-*/
-template <typename ColumnDataType, AggregateFunction aggregate_function>
-struct AggregateResultContext : SegmentVisitorContext {
-  using AggregateResultAllocator = PolymorphicAllocator<AggregateResults<ColumnDataType, aggregate_function>>;
-
-  // In cases where we know how many values to expect, we can preallocate the context in order to avoid later
-  // re-allocations.
-  explicit AggregateResultContext(const size_t preallocated_size = 0)
-      : results(preallocated_size, AggregateResultAllocator{&buffer}) {}
-
-  boost::container::pmr::monotonic_buffer_resource buffer;
-  AggregateResults<ColumnDataType, aggregate_function> results;
-};
-
-template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-struct AggregateContext : public AggregateResultContext<ColumnDataType, aggregate_function> {
-  explicit AggregateContext(const size_t preallocated_size = 0)
-      : AggregateResultContext<ColumnDataType, aggregate_function>(preallocated_size) {
-    auto allocator = AggregateResultIdMapAllocator<AggregateKey>{&this->buffer};
-
-    // Unused if AggregateKey == EmptyAggregateKey, but we initialize it anyway to reduce the number of diverging code
-    // paths.
-    // NOLINTNEXTLINE(clang-analyzer-core.CallAndMessage) - false warning: called C++ object (result_ids) is null
-    result_ids = std::make_unique<AggregateResultIdMap<AggregateKey>>(allocator);
-  }
-
-  std::unique_ptr<AggregateResultIdMap<AggregateKey>> result_ids;
-};
-
-template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-__attribute__((hot)) void AggregateHash::_aggregate_segment(ChunkID chunk_id, ColumnID column_index,
-                                                            const AbstractSegment& abstract_segment,
-                                                            KeysPerChunk<AggregateKey>& keys_per_chunk) {
-  using AggregateType = typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType;
-
-  auto aggregator =
-      AggregateFunctionBuilder<ColumnDataType, AggregateType, aggregate_function>().get_aggregate_function();
-
-  auto& context = *std::static_pointer_cast<AggregateContext<ColumnDataType, aggregate_function, AggregateKey>>(
-      _contexts_per_column[column_index]);
-
-  auto& result_ids = *context.result_ids;
-  auto& results = context.results;
-
-  ChunkOffset chunk_offset{0};
-
-  // CacheResultIds is a boolean type parameter that is forwarded to get_or_add_result, see the documentation over there
-  // for details.
-  const auto process_position = [&](const auto cache_result_ids, const auto& position) {
-    auto& result = get_or_add_result(cache_result_ids, result_ids, results,
-                                     get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                     RowID{chunk_id, chunk_offset});
-
-    // If the value is NULL, the current aggregate value does not change.
-    if (!position.is_null()) {
-      if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
-        // For the case of CountDistinct, insert the current value into the set to keep track of distinct values
-        result.accumulator.emplace(position.value());
-      } else {
-        aggregator(ColumnDataType{position.value()}, result.aggregate_count, result.accumulator);
-      }
-
-      ++result.aggregate_count;
-    }
-
-    ++chunk_offset;
-  };
-
-  // Pass true_type into get_or_add_result to enable certain optimizations: If we have more than one aggregate function
-  // (and thus more than one context), it makes sense to cache the results indexes, see get_or_add_result for details.
-  // Furthermore, if we use the immediate key shortcut (which uses the same code path as caching), we need to pass
-  // true_type so that the aggregate keys are checked for immediate access values.
-  if (_contexts_per_column.size() > 1 || _use_immediate_key_shortcut) {
-    segment_iterate<ColumnDataType>(abstract_segment,
-                                    [&](const auto& position) { process_position(std::true_type{}, position); });
-  } else {
-    segment_iterate<ColumnDataType>(abstract_segment,
-                                    [&](const auto& position) { process_position(std::false_type{}, position); });
-  }
-}
-
 /**
  * Partition the input chunks by the given group key(s). This is done by creating a vector that contains the
  * AggregateKey for each row. It is gradually built by visitors, one for each group segment.
@@ -379,20 +466,17 @@ KeysPerChunk<AggregateKey> AggregateHash::_partition_by_groupby_keys() {
                 _expected_result_size = static_cast<size_t>(max_key - min_key) + 2;
                 _use_immediate_key_shortcut = true;
 
-                // Rewrite the keys and (1) subtract min so that we can also handle consecutive keys that do not start
-                // at 1* and (2) set the first bit which indicates that the key is an immediate index into the result
-                // vector (see get_or_add_result).
+                // Rewrite the keys and subtract min so that we can also handle consecutive keys that do not start
+                // at 1*. Afterwards, each key is an immediate index into the results (see AggregateHash::_aggregate).
                 // *) Note: Because of int_to_uint above, the values do not start at 1, anyway.
 
                 for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
                   const auto chunk_size = input_table->get_chunk(chunk_id)->size();
                   for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
                     auto& key = keys_per_chunk[chunk_id][chunk_offset];
-                    if (key == 0) {
-                      // Key that denotes NULL, do not rewrite but set the cached flag
-                      key = key | CACHE_MASK;
-                    } else {
-                      key = (key - min_key + 1) | CACHE_MASK;
+                    // The key that denotes NULL is not rewritten
+                    if (key != 0) {
+                      key = key - min_key + 1;
                     }
                   }
                 }
@@ -551,217 +635,500 @@ void AggregateHash::_aggregate() {
   // Check for invalid aggregates
   _validate_aggregates();
 
-  auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
+  auto& step_performance_data = dynamic_cast<PerformanceData&>(*performance_data);
   Timer timer;
 
   /**
    * PARTITIONING STEP
    */
-  auto keys_per_chunk = _partition_by_groupby_keys<AggregateKey>();
+  const auto keys_per_chunk = _partition_by_groupby_keys<AggregateKey>();
   step_performance_data.set_step_runtime(OperatorSteps::GroupByKeyPartitioning, timer.lap());
 
   /**
-   * AGGREGATION STEP
+   * We create one AggregateResultContext for each aggregate. Contexts of ANY pseudo-aggregates remain empty as ANY is
+   * handled by _write_groupby_output.
+   *
+   * In Opossum we handle the SQL keyword DISTINCT by using an aggregate operator with grouping but without aggregate
+   * functions. All input columns (either explicitly specified as `SELECT DISTINCT a, b, c` OR implicitly as
+   * `SELECT DISTINCT *` are passed as `groupby_column_ids`). In that case, we add a dummy context using
+   * `AggregateFunction::Min` as a fake aggregate function whose results only serve to list the groups. That way, there
+   * is always at least one context with results, which is important later on when we write the group keys into the
+   * table.
    */
-  _contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
-
-  if (!_has_aggregate_functions) {
-    /*
-    Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
-    This is important later on when we write the group keys into the table.
-    The template parameters (int32_t, AggregateFunction::Min) do not matter, as we do not calculate an aggregate anyway.
-    */
-    auto context =
-        std::make_shared<AggregateContext<int32_t, AggregateFunction::Min, AggregateKey>>(_expected_result_size);
-
-    _contexts_per_column.push_back(context);
+  const auto context_count = _aggregates.size() + (_has_aggregate_functions ? 0 : 1);
+
+  // Memory held per group by the pre-aggregated chunks, not including the values of COUNT(DISTINCT)
+  auto bytes_per_group = sizeof(AggregateKey);
+  for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+    resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type, const auto function) {
+      using ColumnDataType = typename decltype(type)::type;
+      constexpr auto aggregate_function = decltype(function)::value;
+      if constexpr (aggregate_function != AggregateFunction::Any) {
+        bytes_per_group += sizeof(AggregateResult<ColumnDataType, aggregate_function>);
+      }
+    });
   }
 
   /**
-   * Create an AggregateContext for each column in the input table that a normal (i.e. non-DISTINCT) aggregate is
-   * created on. We do this here, and not in the per-chunk-loop below, because there might be no Chunks in the input
-   * and _write_aggregate_output() needs these contexts anyway.
+   * The groups are radix-partitioned by their AggregateKey. If we use the immediate key shortcut (see
+   * _partition_by_groupby_keys), the keys are indexes into the results and we partition by ranges of these indexes. Not
+   * only are no hash maps needed for the partitions then, but the results also keep the order of the keys.
+   *
+   * If a memory budget is given, we might have to spill the partitions. We then need enough partitions so that one
+   * partition's results are expected to fit into the budget.
    */
-  for (ColumnID aggregate_idx{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
-    const auto& aggregate = _aggregates[aggregate_idx];
-
-    const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
-    const auto input_column_id = pqp_column.column_id;
-
-    if (input_column_id == INVALID_COLUMN_ID) {
-      Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
-      auto context = std::make_shared<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
-          _expected_result_size);
-
-      _contexts_per_column[aggregate_idx] = context;
-      continue;
+  const auto expected_result_size = _expected_result_size.load();
+  auto partition_count = size_t{1};
+  if constexpr (!std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+    const auto estimated_group_count = expected_result_size > 0 ? expected_result_size : input_table->row_count();
+    partition_count = calculate_partition_count(estimated_group_count);
+    if (_memory_budget) {
+      while (partition_count < MAX_SPILL_PARTITION_COUNT &&
+             estimated_group_count * bytes_per_group / partition_count > *_memory_budget) {
+        partition_count *= 2;
+      }
     }
-    const auto data_type = input_table->column_data_type(input_column_id);
-    _contexts_per_column[aggregate_idx] =
-        _create_aggregate_context<AggregateKey>(data_type, aggregate->aggregate_function);
   }
+  const auto immediate_partition_size = (expected_result_size + partition_count - 1) / partition_count;
+
+  const auto partition_of = [&](const AggregateKey& key) -> size_t {
+    if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+      return 0;
+    } else {
+      if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+        if (_use_immediate_key_shortcut) return key / immediate_partition_size;
+      }
+      return mix_hash(std::hash<AggregateKey>{}(key)) & (partition_count - 1);
+    }
+  };
 
-  // Process Chunks and perform aggregations
+  /**
+   * PRE-AGGREGATION STEP
+   *
+   * Each chunk is aggregated on its own (and, thus, in parallel to the others) using a hash map of the chunk's groups.
+   * As a chunk has a bounded number of rows, this hash map and the results stay small enough to be mostly cache
+   * resident. For each row, we first look up its group. Then, the segments of the aggregated columns are iterated and
+   * aggregated into the group's partial results. Finally, the chunk's groups are sorted by their partition.
+   */
   const auto chunk_count = input_table->chunk_count();
-  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-    const auto chunk_in = input_table->get_chunk(chunk_id);
-    if (!chunk_in) continue;
+  auto partial_aggregations = std::vector<PartialAggregation<AggregateKey>>(chunk_count);
 
-    // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
+  const auto pre_aggregate_chunk = [&](const ChunkID chunk_id, const std::shared_ptr<const Chunk>& chunk_in) {
+    auto& partial_aggregation = partial_aggregations[chunk_id];
+    auto& group_keys = partial_aggregation.group_keys;
     const auto input_chunk_size = chunk_in->size();
 
-    if (!_has_aggregate_functions) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by using an aggregate operator with grouping but without 
-       * aggregate functions. All input columns (either explicitly specified as `SELECT DISTINCT a, b, c` OR implicitly
-       * as `SELECT DISTINCT *` are passed as `groupby_column_ids`).
-       *
-       * As the grouping happens as part of the aggregation but no aggregate function exists, we use
-       * `AggregateFunction::Min` as a fake aggregate function whose result will be discarded. From here on, the steps
-       * are the same as they are for a regular grouped aggregate.
-       */
-
-      auto context =
-          std::static_pointer_cast<AggregateContext<DistinctColumnType, AggregateFunction::Min, AggregateKey>>(
-              _contexts_per_column[0]);
-
-      auto& result_ids = *context->result_ids;
-      auto& results = context->results;
+    auto group_ids = std::vector<AggregateResultId>(input_chunk_size);
+    auto group_first_offsets = std::vector<ChunkOffset>{};
 
-      // Add value or combination of values is added to the list of distinct value(s). This is done by calling
-      // get_or_add_result, which adds the corresponding entry in the list of GROUP BY values.
-      if (_use_immediate_key_shortcut) {
-        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-          // We are able to use immediate keys, so pass true_type so that the combined caching/immediate key code path
-          // is enabled in get_or_add_result.
-          get_or_add_result(std::true_type{}, result_ids, results,
-                            get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                            RowID{chunk_id, chunk_offset});
-        }
-      } else {
-        // Same as above, but we do not have immediate keys, so we disable that code path to reduce the complexity of
-        // get_aggregate_key.
-        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-          get_or_add_result(std::false_type{}, result_ids, results,
-                            get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                            RowID{chunk_id, chunk_offset});
-        }
+    if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+      // Not grouped by anything, all rows belong to the same group
+      if (input_chunk_size > 0) {
+        group_keys.emplace_back();
+        group_first_offsets.emplace_back(ChunkOffset{0});
       }
     } else {
-      ColumnID aggregate_idx{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then go through the keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
+      auto buffer = boost::container::pmr::monotonic_buffer_resource{};
+      auto result_ids = AggregateResultIdMap<AggregateKey>{AggregateResultIdMapAllocator<AggregateKey>{&buffer}};
+
+      const auto& keys = keys_per_chunk[chunk_id];
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < input_chunk_size; ++chunk_offset) {
+        const auto& key = keys[chunk_offset];
+        const auto [iter, inserted] = result_ids.emplace(key, group_keys.size());
+        if (inserted) {
+          group_keys.emplace_back(key);
+          group_first_offsets.emplace_back(chunk_offset);
+        }
+        group_ids[chunk_offset] = iter->second;
+      }
+    }
 
-        const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
-        const auto input_column_id = pqp_column.column_id;
+    const auto group_count = group_keys.size();
+    partial_aggregation.size_in_bytes = group_count * bytes_per_group;
+
+    // Sort the group ids by partition (i.e., a counting sort on the partitions)
+    auto& partition_offsets = partial_aggregation.partition_offsets;
+    partition_offsets.resize(partition_count + 1);
+    auto group_partitions = std::vector<size_t>(group_count);
+    for (auto group_id = AggregateResultId{0}; group_id < group_count; ++group_id) {
+      group_partitions[group_id] = partition_of(group_keys[group_id]);
+      ++partition_offsets[group_partitions[group_id] + 1];
+    }
+    std::partial_sum(partition_offsets.begin(), partition_offsets.end(), partition_offsets.begin());
 
-        if (input_column_id == INVALID_COLUMN_ID) {
-          Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-          auto context =
-              std::static_pointer_cast<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
-                  _contexts_per_column[aggregate_idx]);
+    auto write_offsets = std::vector<size_t>(partition_offsets.begin(), partition_offsets.end() - 1);
+    partial_aggregation.partitioned_group_ids.resize(group_count);
+    for (auto group_id = AggregateResultId{0}; group_id < group_count; ++group_id) {
+      partial_aggregation.partitioned_group_ids[write_offsets[group_partitions[group_id]]++] = group_id;
+    }
 
-          auto& result_ids = *context->result_ids;
-          auto& results = context->results;
+    // Calculate the partial results of each aggregate
+    partial_aggregation.contexts.resize(context_count);
+    for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+      resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type,
+                                                                                   const auto function) {
+        using ColumnDataType = typename decltype(type)::type;
+        constexpr auto aggregate_function = decltype(function)::value;
 
-          if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
-            // Not grouped by anything, simply count the number of rows
-            results.resize(1);
-            results[0].aggregate_count += input_chunk_size;
+        auto context = std::make_shared<AggregateResultContext<ColumnDataType, aggregate_function>>();
+        partial_aggregation.contexts[context_index] = context;
 
-            // We need to set any RowID because the default value (NULL_ROW_ID) would later be skipped. As we are not
-            // reconstructing the GROUP BY values later, the exact value of this row_id does not matter, as long as it
-            // not NULL_ROW_ID.
-            results[0].row_id = RowID{ChunkID{0}, ChunkOffset{0}};
-          } else {
-            // Count occurrences for each group key -  If we have more than one aggregate function (and thus more than
-            // one context), it makes sense to cache the results indexes, see get_or_add_result for details.
-            if (_contexts_per_column.size() > 1 || _use_immediate_key_shortcut) {
-              for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-                // Use CacheResultIds==true_type if we have more than one group by column or if the cached result ids
-                // have been written by the immediate key shortcut
-                auto& result =
-                    get_or_add_result(std::true_type{}, result_ids, results,
-                                      get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                      RowID{chunk_id, chunk_offset});
-                ++result.aggregate_count;
+        if constexpr (aggregate_function != AggregateFunction::Any) {
+          auto& results = context->results;
+          results.resize(group_count);
+          for (auto group_id = AggregateResultId{0}; group_id < group_count; ++group_id) {
+            results[group_id].row_id = RowID{chunk_id, group_first_offsets[group_id]};
+          }
+
+          // The dummy context of the DISTINCT implementation only lists the groups
+          if constexpr (!std::is_same_v<ColumnDataType, DistinctColumnType>) {
+            const auto& pqp_column = static_cast<const PQPColumnExpression&>(*_aggregates[context_index]->argument());
+            const auto input_column_id = pqp_column.column_id;
+
+            if (input_column_id == INVALID_COLUMN_ID) {
+              // Special COUNT(*) implementation: Because COUNT(*) does not have a specific target column, we count
+              // the occurrences of each group. The results are saved in the regular aggregate_count variable so that
+              // we don't need a specific output logic for COUNT(*).
+              for (const auto group_id : group_ids) {
+                ++results[group_id].aggregate_count;
               }
             } else {
-              for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-                auto& result =
-                    get_or_add_result(std::false_type{}, result_ids, results,
-                                      get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                      RowID{chunk_id, chunk_offset});
-                ++result.aggregate_count;
+              aggregate_segment<ColumnDataType, aggregate_function>(*chunk_in->get_segment(input_column_id),
+                                                                    group_ids, results);
+            }
+
+            if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+              for (const auto& result : results) {
+                partial_aggregation.size_in_bytes += result.accumulator.size() * sizeof(ColumnDataType);
               }
             }
           }
-
-          ++aggregate_idx;
-          continue;
         }
+      });
+    }
+  };
 
-        const auto abstract_segment = chunk_in->get_segment(input_column_id);
-        const auto data_type = input_table->column_data_type(input_column_id);
-
-        /*
-        Invoke correct aggregator for each segment
-        */
+  /**
+   * SPILLING
+   *
+   * Once the pre-aggregated chunks exceed the memory budget, they are written to one SpillFile per partition and
+   * freed, and so are all chunks that are pre-aggregated afterwards. Each chunk adds one record to the file of each
+   * partition, consisting of the record's size, the number of groups, their keys, and the groups' partial results of
+   * all aggregates (see write_spill_value).
+   */
+  auto spill_files = std::vector<std::unique_ptr<SpillFile>>{};
+
+  const auto spill_chunk = [&](const ChunkID chunk_id) {
+    auto& partial_aggregation = partial_aggregations[chunk_id];
+    auto buffer = std::vector<char>{};
+
+    for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+      const auto begin = partial_aggregation.partition_offsets[partition_id];
+      const auto end = partial_aggregation.partition_offsets[partition_id + 1];
+      if (begin == end) continue;
+
+      buffer.clear();
+      write_spill_value(buffer, size_t{0});  // Placeholder for the record's size
+      write_spill_value(buffer, end - begin);
+      for (auto index = begin; index < end; ++index) {
+        write_spill_value(buffer,
+                          partial_aggregation.group_keys[partial_aggregation.partitioned_group_ids[index]]);
+      }
 
-        resolve_data_type(data_type, [&, aggregate](auto type) {
+      for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+        resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type,
+                                                                                     const auto function) {
           using ColumnDataType = typename decltype(type)::type;
-
-          switch (aggregate->aggregate_function) {
-            case AggregateFunction::Min:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::StandardDeviationSample:
-              _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Any:
-              // ANY is a pseudo-function and is handled by _write_groupby_output
-              break;
+          constexpr auto aggregate_function = decltype(function)::value;
+          using Context = AggregateResultContext<ColumnDataType, aggregate_function>;
+
+          if constexpr (aggregate_function != AggregateFunction::Any) {
+            const auto& partial_context = static_cast<const Context&>(*partial_aggregation.contexts[context_index]);
+            const auto& partial_results = partial_context.results;
+            for (auto index = begin; index < end; ++index) {
+              write_spill_result(buffer, partial_results[partial_aggregation.partitioned_group_ids[index]]);
+            }
           }
         });
+      }
+
+      const auto record_size = buffer.size() - sizeof(size_t);
+      std::memcpy(buffer.data(), &record_size, sizeof(size_t));
+      spill_files[partition_id]->write(buffer.data(), buffer.size());
+    }
+
+    // Keep the (now empty) partition offsets so that the chunk is not mistaken for a skipped one
+    partial_aggregation.group_keys = {};
+    partial_aggregation.partitioned_group_ids = {};
+    partial_aggregation.contexts = {};
+    partial_aggregation.size_in_bytes = 0;
+  };
+
+  // Without a memory budget, all chunks are pre-aggregated at once. Otherwise, we pre-aggregate batches of chunks
+  // whose rows would fit into the budget even if each row formed its own group.
+  constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+  const auto batch_row_count =
+      _memory_budget ? std::max(*_memory_budget / bytes_per_group, size_t{1}) : std::numeric_limits<size_t>::max();
+
+  auto held_bytes = size_t{0};
+  auto first_held_chunk_id = ChunkID{0};
+  auto batch_begin_chunk_id = ChunkID{0};
+  while (batch_begin_chunk_id < chunk_count) {
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    auto batch_rows = size_t{0};
+    auto chunk_id = batch_begin_chunk_id;
+    for (; chunk_id < chunk_count && (chunk_id == batch_begin_chunk_id || batch_rows < batch_row_count); ++chunk_id) {
+      const auto chunk_in = input_table->get_chunk(chunk_id);
+      if (!chunk_in) continue;
+
+      batch_rows += chunk_in->size();
+      if (chunk_in->size() > JOB_SPAWN_THRESHOLD) {
+        jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id, chunk_in]() {
+          pre_aggregate_chunk(chunk_id, chunk_in);
+        }));
+      } else {
+        pre_aggregate_chunk(chunk_id, chunk_in);
+      }
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+    const auto batch_end_chunk_id = chunk_id;
+
+    if (_memory_budget) {
+      for (auto held_chunk_id = batch_begin_chunk_id; held_chunk_id < batch_end_chunk_id; ++held_chunk_id) {
+        held_bytes += partial_aggregations[held_chunk_id].size_in_bytes;
+      }
 
-        ++aggregate_idx;
+      if (!spill_files.empty() || held_bytes > *_memory_budget) {
+        if (spill_files.empty()) {
+          spill_files.reserve(partition_count);
+          for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+            spill_files.emplace_back(std::make_unique<SpillFile>());
+          }
+        }
+
+        // Chunks are spilled in order, so that the partial results in the spill files are ordered by their rows
+        for (auto held_chunk_id = first_held_chunk_id; held_chunk_id < batch_end_chunk_id; ++held_chunk_id) {
+          if (partial_aggregations[held_chunk_id].partition_offsets.empty()) continue;
+          spill_chunk(held_chunk_id);
+        }
+        first_held_chunk_id = batch_end_chunk_id;
+        held_bytes = 0;
       }
     }
+
+    batch_begin_chunk_id = batch_end_chunk_id;
   }
   step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
-}  // NOLINT(readability/fn_size)
+
+  /**
+   * MERGE STEP
+   *
+   * Each partition is merged on its own, without any synchronization with other partitions. The partial results are
+   * visited in the order of the chunks, so that the first partial result of a group also holds the group's first row.
+   * For every group of the partition found in a chunk, its AggregateResultId in the partition is looked up (or, with
+   * immediate keys, calculated). Then, the chunk's partial results are merged into the partition's results.
+   *
+   * Without spilling, one task per partition merges the in-memory partial results. Spilled partitions are merged one
+   * after another. Each merged partition is written to its own output chunk and freed before the next one is merged,
+   * so that only one partition's results are held in memory.
+   */
+  auto partition_contexts = std::vector<std::vector<std::shared_ptr<SegmentVisitorContext>>>(partition_count);
+
+  const auto create_partition_contexts = [&](const size_t partition_id) {
+    auto& contexts = partition_contexts[partition_id];
+    contexts.resize(context_count);
+
+    const auto immediate_partition_begin = partition_id * immediate_partition_size;
+    auto preallocated_size = size_t{0};
+    if (_use_immediate_key_shortcut && immediate_partition_begin < expected_result_size) {
+      preallocated_size = std::min(immediate_partition_size, expected_result_size - immediate_partition_begin);
+    }
+
+    for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+      resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type,
+                                                                                   const auto function) {
+        using ColumnDataType = typename decltype(type)::type;
+        constexpr auto aggregate_function = decltype(function)::value;
+        contexts[context_index] =
+            std::make_shared<AggregateResultContext<ColumnDataType, aggregate_function>>(preallocated_size);
+      });
+    }
+  };
+
+  // Returns the AggregateResultId of a group within its partition
+  const auto get_partition_result_id = [&](const size_t partition_id, AggregateResultIdMap<AggregateKey>& result_ids,
+                                           [[maybe_unused]] const AggregateKey& key) -> AggregateResultId {
+    if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+      return 0;
+    } else {
+      if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+        if (_use_immediate_key_shortcut) return key - partition_id * immediate_partition_size;
+      }
+      return result_ids.emplace(key, result_ids.size()).first->second;
+    }
+  };
+
+  // Merges a partial result into the partition's result with the given AggregateResultId
+  const auto merge_into_partition = [](auto& results, const AggregateResultId result_id, auto& partial_result) {
+    if (result_id >= results.size()) {
+      results.resize(result_id + 1);
+    }
+    merge_aggregate_result(results[result_id], partial_result);
+  };
+
+  if (spill_files.empty()) {
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+      const auto merge_partition = [&, partition_id]() {
+        create_partition_contexts(partition_id);
+        const auto& contexts = partition_contexts[partition_id];
+
+        auto buffer = boost::container::pmr::monotonic_buffer_resource{};
+        auto result_ids = AggregateResultIdMap<AggregateKey>{AggregateResultIdMapAllocator<AggregateKey>{&buffer}};
+
+        // The AggregateResultIds in the partition of the current chunk's groups (in the order of partitioned_group_ids)
+        auto partition_result_ids = std::vector<AggregateResultId>{};
+
+        for (const auto& partial_aggregation : partial_aggregations) {
+          // Chunk was skipped in the pre-aggregation
+          if (partial_aggregation.partition_offsets.empty()) continue;
+
+          const auto begin = partial_aggregation.partition_offsets[partition_id];
+          const auto end = partial_aggregation.partition_offsets[partition_id + 1];
+
+          partition_result_ids.resize(end - begin);
+          for (auto index = begin; index < end; ++index) {
+            const auto& key = partial_aggregation.group_keys[partial_aggregation.partitioned_group_ids[index]];
+            partition_result_ids[index - begin] = get_partition_result_id(partition_id, result_ids, key);
+          }
+
+          for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+            resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type,
+                                                                                         const auto function) {
+              using ColumnDataType = typename decltype(type)::type;
+              constexpr auto aggregate_function = decltype(function)::value;
+              using Context = AggregateResultContext<ColumnDataType, aggregate_function>;
+
+              if constexpr (aggregate_function != AggregateFunction::Any) {
+                auto& results = static_cast<Context&>(*contexts[context_index]).results;
+                auto& partial_results = static_cast<Context&>(*partial_aggregation.contexts[context_index]).results;
+
+                for (auto index = begin; index < end; ++index) {
+                  merge_into_partition(results, partition_result_ids[index - begin],
+                                       partial_results[partial_aggregation.partitioned_group_ids[index]]);
+                }
+              }
+            });
+          }
+        }
+      };
+
+      if (partition_count > 1) {
+        jobs.emplace_back(std::make_shared<JobTask>(merge_partition));
+      } else {
+        merge_partition();
+      }
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+  } else {
+    partial_aggregations.clear();
+
+    auto merging_duration = std::chrono::nanoseconds{};
+    auto record = std::vector<char>{};
+    auto partition_result_ids = std::vector<AggregateResultId>{};
+    for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+      auto& spill_file = *spill_files[partition_id];
+      spill_file.finish_writing();
+      step_performance_data.spilled_bytes += spill_file.size();
+
+      create_partition_contexts(partition_id);
+      const auto& contexts = partition_contexts[partition_id];
+
+      auto buffer = boost::container::pmr::monotonic_buffer_resource{};
+      auto result_ids = AggregateResultIdMap<AggregateKey>{AggregateResultIdMapAllocator<AggregateKey>{&buffer}};
+
+      auto record_size = size_t{0};
+      while (spill_file.read(&record_size, sizeof(size_t)) == sizeof(size_t)) {
+        record.resize(record_size);
+        Assert(spill_file.read(record.data(), record_size) == record_size, "Spill file ended unexpectedly");
+        const auto* data = record.data();
+
+        auto group_count = size_t{0};
+        read_spill_value(data, group_count);
+        partition_result_ids.resize(group_count);
+        auto key = AggregateKey{};
+        for (auto index = size_t{0}; index < group_count; ++index) {
+          read_spill_value(data, key);
+          partition_result_ids[index] = get_partition_result_id(partition_id, result_ids, key);
+        }
+
+        for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+          resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type,
+                                                                                       const auto function) {
+            using ColumnDataType = typename decltype(type)::type;
+            constexpr auto aggregate_function = decltype(function)::value;
+            using Context = AggregateResultContext<ColumnDataType, aggregate_function>;
+
+            if constexpr (aggregate_function != AggregateFunction::Any) {
+              auto& results = static_cast<Context&>(*contexts[context_index]).results;
+              for (const auto result_id : partition_result_ids) {
+                auto partial_result = AggregateResult<ColumnDataType, aggregate_function>{};
+                read_spill_result(data, partial_result);
+                merge_into_partition(results, result_id, partial_result);
+              }
+            }
+          });
+        }
+        DebugAssert(data == record.data() + record_size, "Spilled record was not read completely");
+      }
+
+      spill_files[partition_id].reset();
+
+      // Write the partition's output chunk right away, so that its results (including the sets of COUNT(DISTINCT))
+      // are freed before the next partition is merged.
+      merging_duration += timer.lap();
+      _contexts_per_column = std::move(partition_contexts[partition_id]);
+      _write_output();
+      _contexts_per_column.clear();
+      timer.lap();
+    }
+
+    step_performance_data.spilled_partition_count = partition_count;
+    step_performance_data.set_step_runtime(OperatorSteps::Merging, merging_duration + timer.lap());
+    return;
+  }
+
+  // Concatenate the partitions' results. We also do this if there are no chunks in the input, because
+  // _write_aggregate_output() needs the contexts anyway.
+  _contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(context_count);
+  for (auto context_index = size_t{0}; context_index < context_count; ++context_index) {
+    resolve_aggregate_context_type(_aggregates, *input_table, context_index, [&](const auto type,
+                                                                                 const auto function) {
+      using ColumnDataType = typename decltype(type)::type;
+      constexpr auto aggregate_function = decltype(function)::value;
+      using Context = AggregateResultContext<ColumnDataType, aggregate_function>;
+
+      auto context = std::make_shared<Context>();
+      auto& results = context->results;
+
+      auto result_count = size_t{0};
+      for (const auto& contexts : partition_contexts) {
+        result_count += static_cast<const Context&>(*contexts[context_index]).results.size();
+      }
+      results.reserve(result_count);
+
+      for (const auto& contexts : partition_contexts) {
+        auto& partition_results = static_cast<Context&>(*contexts[context_index]).results;
+        std::move(partition_results.begin(), partition_results.end(), std::back_inserter(results));
+      }
+
+      _contexts_per_column[context_index] = context;
+    });
+  }
+  step_performance_data.set_step_runtime(OperatorSteps::Merging, timer.lap());
+
+  _write_output();
+}
 
 std::shared_ptr<const Table> AggregateHash::_on_execute() {
   // We do not want the overhead of a vector with heap storage when we have a limited number of aggregate columns.
@@ -783,6 +1150,26 @@ std::shared_ptr<const Table> AggregateHash::_on_execute() {
       break;
   }
 
+  // Write the output
+  Timer timer;
+  auto output = std::make_shared<Table>(_output_column_definitions, TableType::Data);
+  for (const auto& segments : _output_chunks) {
+    output->append_chunk(segments);
+  }
+  _output_chunks.clear();
+
+  // _aggregate has its own internal timer. As groupby/aggregate column writing can be interleaved, the runtime is
+  // stored in members and later written to the operator performance data struct.
+  auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
+  step_performance_data.set_step_runtime(OperatorSteps::OutputWriting, timer.lap());
+
+  step_performance_data.set_step_runtime(OperatorSteps::GroupByColumnsWriting, groupby_columns_writing_duration);
+  step_performance_data.set_step_runtime(OperatorSteps::AggregateColumnsWriting, aggregate_columns_writing_duration);
+
+  return output;
+}
+
+void AggregateHash::_write_output() {
   const auto num_output_columns = _groupby_column_ids.size() + _aggregates.size();
   _output_column_definitions.resize(num_output_columns);
   _output_segments.resize(num_output_columns);
@@ -794,8 +1181,9 @@ std::shared_ptr<const Table> AggregateHash::_on_execute() {
    * Otherwise, it is called by the first call to _write_aggregate_output.
    **/
   if (!_has_aggregate_functions) {
+    // The dummy context of the DISTINCT implementation is the last one, see _aggregate()
     auto context = std::static_pointer_cast<AggregateResultContext<DistinctColumnType, AggregateFunction::Min>>(
-        _contexts_per_column[0]);
+        _contexts_per_column.back());
     auto pos_list = RowIDPosList();
     pos_list.reserve(context->results.size());
     for (const auto& result : context->results) {
@@ -827,22 +1215,9 @@ std::shared_ptr<const Table> AggregateHash::_on_execute() {
     ++aggregate_idx;
   }
 
-  // Write the output
-  Timer timer;
-  auto output = std::make_shared<Table>(_output_column_definitions, TableType::Data);
   if (_output_segments.at(0)->size() > 0) {
-    output->append_chunk(_output_segments);
+    _output_chunks.emplace_back(_output_segments);
   }
-
-  // _aggregate has its own internal timer. As groupby/aggregate column writing can be interleaved, the runtime is
-  // stored in members and later written to the operator performance data struct.
-  auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
-  step_performance_data.set_step_runtime(OperatorSteps::OutputWriting, timer.lap());
-
-  step_performance_data.set_step_runtime(OperatorSteps::GroupByColumnsWriting, groupby_columns_writing_duration);
-  step_performance_data.set_step_runtime(OperatorSteps::AggregateColumnsWriting, aggregate_columns_writing_duration);
-
-  return output;
 }
 
 /*
@@ -1160,44 +1535,13 @@ void AggregateHash::write_aggregate_output(ColumnID aggregate_index) {
   aggregate_columns_writing_duration += timer.lap() - excluded_time;
 }
 
-template <typename AggregateKey>
-std::shared_ptr<SegmentVisitorContext> AggregateHash::_create_aggregate_context(
-    const DataType data_type, const AggregateFunction aggregate_function) const {
-  std::shared_ptr<SegmentVisitorContext> context;
-  resolve_data_type(data_type, [&](auto type) {
-    const auto size = _expected_result_size.load();
-    using ColumnDataType = typename decltype(type)::type;
-    switch (aggregate_function) {
-      case AggregateFunction::Min:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Min, AggregateKey>>(size);
-        break;
-      case AggregateFunction::Max:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Max, AggregateKey>>(size);
-        break;
-      case AggregateFunction::Sum:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Sum, AggregateKey>>(size);
-        break;
-      case AggregateFunction::Avg:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Avg, AggregateKey>>(size);
-        break;
-      case AggregateFunction::Count:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Count, AggregateKey>>(size);
-        break;
-      case AggregateFunction::CountDistinct:
-        context =
-            std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>>(size);
-        break;
-      case AggregateFunction::StandardDeviationSample:
-        context = std::make_shared<
-            AggregateContext<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>>(size);
-        break;
-      case AggregateFunction::Any:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Any, AggregateKey>>(size);
-        break;
-    }
-  });
+void AggregateHash::PerformanceData::output_to_stream(std::ostream& stream, DescriptionMode description_mode) const {
+  OperatorPerformanceData<OperatorSteps>::output_to_stream(stream, description_mode);
 
-  return context;
+  if (spilled_partition_count > 0) {
+    stream << (description_mode == DescriptionMode::SingleLine ? " " : "\n") << "Spilled " << spilled_partition_count
+           << " partition" << (spilled_partition_count > 1 ? "s" : "") << " (" << format_bytes(spilled_bytes) << ").";
+  }
 }
 
 }  // namespace opossum
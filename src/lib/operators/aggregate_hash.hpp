@@ -44,6 +44,12 @@ Operator to aggregate columns by certain functions, such as min, max, sum, avera
  i.e. your sorting order.
 
 For implementation details, please check the wiki: https://github.com/hyrise/hyrise/wiki/Operators_Aggregate
+
+The aggregation runs in two phases. First, each chunk is pre-aggregated on its own, in parallel to the other chunks,
+into small hash maps that are mostly cache resident. The groups of each chunk are radix-partitioned by their keys.
+Second, the partial results of all chunks are merged, with one task per partition. As such, GROUP BYs with many
+groups scale with the number of cores. If the partial results exceed the memory budget, they are spilled to one
+temporary file per partition, and the partitions are merged one after another.
 */
 
 /*
@@ -138,9 +144,16 @@ using DistinctAggregateType = int8_t;
 
 class AggregateHash : public AbstractAggregateOperator {
  public:
+  // memory_budget limits the memory used for the groups' partial results (in bytes, not including the input, the
+  // materialized GROUP BY keys, and the output table). If it is exceeded, the partial results are radix-partitioned
+  // to temporary files and merged partition by partition. Each merged partition is written to its own output chunk
+  // before the next one is merged, so that only one partition's results are held in memory.
   AggregateHash(const std::shared_ptr<AbstractOperator>& in,
                 const std::vector<std::shared_ptr<AggregateExpression>>& aggregates,
-                const std::vector<ColumnID>& groupby_column_ids);
+                const std::vector<ColumnID>& groupby_column_ids,
+                const std::optional<size_t> memory_budget = std::nullopt);
+
+  std::optional<size_t> memory_budget() const;
 
   const std::string& name() const override;
 
@@ -151,11 +164,19 @@ class AggregateHash : public AbstractAggregateOperator {
   enum class OperatorSteps : uint8_t {
     GroupByKeyPartitioning,
     Aggregating,
+    Merging,
     GroupByColumnsWriting,
     AggregateColumnsWriting,
     OutputWriting
   };
 
+  struct PerformanceData : public OperatorPerformanceData<OperatorSteps> {
+    void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override;
+
+    size_t spilled_partition_count{0};
+    size_t spilled_bytes{0};
+  };
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
@@ -180,18 +201,16 @@ class AggregateHash : public AbstractAggregateOperator {
 
   void _write_groupby_output(RowIDPosList& pos_list);
 
-  template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-  void _aggregate_segment(ChunkID chunk_id, ColumnID column_index, const AbstractSegment& abstract_segment,
-                          KeysPerChunk<AggregateKey>& keys_per_chunk);
-
-  template <typename AggregateKey>
-  std::shared_ptr<SegmentVisitorContext> _create_aggregate_context(const DataType data_type,
-                                                                   const AggregateFunction aggregate_function) const;
+  // Writes the results in _contexts_per_column to an output chunk in _output_chunks
+  void _write_output();
 
   std::vector<std::shared_ptr<BaseValueSegment>> _groupby_segments;
   std::vector<std::shared_ptr<SegmentVisitorContext>> _contexts_per_column;
+  std::vector<Segments> _output_chunks;
   bool _has_aggregate_functions;
 
+  const std::optional<size_t> _memory_budget;
+
   std::atomic_size_t _expected_result_size{};
   bool _use_immediate_key_shortcut{};
 
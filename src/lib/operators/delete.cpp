@@ -5,6 +5,7 @@
 #include <utility>
 
 #include "concurrency/transaction_context.hpp"
+#include "logging/redo_log_record.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/reference_segment.hpp"
@@ -130,6 +131,17 @@ void Delete::_on_rollback_records() {
   }
 }
 
+void Delete::_on_log_records(RedoLogRecord& record) const {
+  for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
+       ++referencing_chunk_id) {
+    const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
+    const auto referencing_segment =
+        std::static_pointer_cast<const ReferenceSegment>(referencing_chunk->get_segment(ColumnID{0}));
+
+    record.add_delete(referencing_segment->referenced_table(), *referencing_segment->pos_list());
+  }
+}
+
 std::shared_ptr<AbstractOperator> Delete::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -29,6 +29,7 @@ class Delete : public AbstractReadWriteOperator {
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
   void _on_commit_records(const CommitID commit_id) override;
   void _on_rollback_records() override;
+  void _on_log_records(RedoLogRecord& record) const override;
 
  private:
   TransactionID _transaction_id;
@@ -7,6 +7,7 @@
 
 #include "concurrency/transaction_context.hpp"
 #include "hyrise.hpp"
+#include "logging/redo_log_record.hpp"
 #include "resolve_type.hpp"
 #include "storage/abstract_encoded_segment.hpp"
 #include "storage/segment_iterate.hpp"
@@ -72,8 +73,11 @@ void copy_value_range(const std::shared_ptr<const AbstractSegment>& source_abstr
 
 namespace opossum {
 
-Insert::Insert(const std::string& target_table_name, const std::shared_ptr<const AbstractOperator>& values_to_insert)
-    : AbstractReadWriteOperator(OperatorType::Insert, values_to_insert), _target_table_name(target_table_name) {}
+Insert::Insert(const std::string& target_table_name, const std::shared_ptr<const AbstractOperator>& values_to_insert,
+               const InsertChunkAllocation chunk_allocation)
+    : AbstractReadWriteOperator(OperatorType::Insert, values_to_insert),
+      _target_table_name(target_table_name),
+      _chunk_allocation(chunk_allocation) {}
 
 const std::string& Insert::name() const {
   static const auto name = std::string{"Insert"};
@@ -105,6 +109,15 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     if (_target_table->chunk_count() == 0) {
       _target_table->append_mutable_chunk();
     }
+
+    const auto use_fresh_chunks = _chunk_allocation == InsertChunkAllocation::FreshChunks && remaining_rows > 0;
+    if (use_fresh_chunks) {
+      const auto last_chunk = _target_table->last_chunk();
+      if (!last_chunk->is_mutable() || last_chunk->size() > 0) {
+        _target_table->append_mutable_chunk();
+      }
+    }
+
     while (remaining_rows > 0) {
       auto target_chunk_id = ChunkID{_target_table->chunk_count() - 1};
       auto target_chunk = _target_table->get_chunk(target_chunk_id);
@@ -169,6 +182,11 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
 
       remaining_rows -= num_rows_for_target_chunk;
     }
+
+    // Following Inserts must not write to the remaining rows of the last fresh chunk
+    if (use_fresh_chunks && _target_table->last_chunk()->size() < _target_table->target_chunk_size()) {
+      _target_table->append_mutable_chunk();
+    }
   }
 
   /**
@@ -273,11 +291,18 @@ void Insert::_on_rollback_records() {
   }
 }
 
+void Insert::_on_log_records(RedoLogRecord& record) const {
+  for (const auto& target_chunk_range : _target_chunk_ranges) {
+    record.add_insert(_target_table_name, *_target_table, target_chunk_range.chunk_id,
+                      target_chunk_range.begin_chunk_offset, target_chunk_range.end_chunk_offset);
+  }
+}
+
 std::shared_ptr<AbstractOperator> Insert::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
-  return std::make_shared<Insert>(_target_table_name, copied_left_input);
+  return std::make_shared<Insert>(_target_table_name, copied_left_input, _chunk_allocation);
 }
 
 void Insert::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
@@ -12,6 +12,13 @@ namespace opossum {
 
 class TransactionContext;
 
+/**
+ * By default, Insert writes to the last chunk of the target table and appends new chunks when it is full. With
+ * FreshChunks, the rows are written to chunks that only contain rows of this Insert. This is used to keep rows that
+ * have been sorted before in chunks of their own (see DeltaMergePlugin).
+ */
+enum class InsertChunkAllocation { LastChunk, FreshChunks };
+
 /**
  * Operator that inserts a number of rows from one table into another.
  * Expects the table name of the table to insert into as a string and
@@ -22,7 +29,8 @@ class TransactionContext;
 class Insert : public AbstractReadWriteOperator {
  public:
   explicit Insert(const std::string& target_table_name,
-                  const std::shared_ptr<const AbstractOperator>& values_to_insert);
+                  const std::shared_ptr<const AbstractOperator>& values_to_insert,
+                  const InsertChunkAllocation chunk_allocation = InsertChunkAllocation::LastChunk);
 
   const std::string& name() const override;
 
@@ -35,9 +43,11 @@ class Insert : public AbstractReadWriteOperator {
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
   void _on_commit_records(const CommitID cid) override;
   void _on_rollback_records() override;
+  void _on_log_records(RedoLogRecord& record) const override;
 
  private:
   const std::string _target_table_name;
+  const InsertChunkAllocation _chunk_allocation;
 
   // Ranges of rows to which the inserted values are written
   struct ChunkRange {
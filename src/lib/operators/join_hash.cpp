@@ -1,5 +1,6 @@
 #include "join_hash.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <numeric>
@@ -14,13 +15,40 @@
 #include "join_hash/join_hash_steps.hpp"
 #include "join_hash/join_hash_traits.hpp"
 #include "join_helper/join_output_writing.hpp"
+#include "operators/pqp_utils.hpp"
+#include "operators/table_scan.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
+#include "statistics/cardinality_estimator.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
 #include "utils/format_duration.hpp"
 #include "utils/timer.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns the topmost TableScan of a chain of TableScans and Validates on top of a GetTable. As the runtime Bloom
+// filter drops rows from the scan's output, no operator of the chain may have another consumer. Returns nullptr if no
+// such TableScan exists.
+std::shared_ptr<TableScan> find_base_table_scan(const std::shared_ptr<AbstractOperator>& op) {
+  auto table_scan = std::shared_ptr<TableScan>{};
+  for (auto chain_op = op; chain_op; chain_op = chain_op->mutable_left_input()) {
+    if (chain_op->type() == OperatorType::GetTable) return table_scan;
+    if (chain_op->executed() || chain_op->consumer_count() != 1) return nullptr;
+
+    if (chain_op->type() == OperatorType::TableScan) {
+      if (!table_scan) table_scan = std::static_pointer_cast<TableScan>(chain_op);
+    } else if (chain_op->type() != OperatorType::Validate) {
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 namespace opossum {
 
 bool JoinHash::supports(const JoinConfiguration config) {
@@ -53,6 +81,40 @@ std::string JoinHash::description(DescriptionMode description_mode) const {
   return stream.str();
 }
 
+void JoinHash::push_down_bloom_filters(const std::shared_ptr<AbstractOperator>& pqp) {
+  visit_pqp(pqp, [](const auto& op) {
+    if (op->type() != OperatorType::JoinHash || op->executed()) return PQPVisitation::VisitInputs;
+    const auto& join_hash = static_cast<const JoinHash&>(*op);
+
+    // Only the rows of inputs that do not keep rows without a join partner can be filtered
+    auto filter_left_input = true;
+    if (join_hash.mode() == JoinMode::Inner) {
+      if (!join_hash.lqp_node) return PQPVisitation::VisitInputs;
+
+      const auto cardinality_estimator = CardinalityEstimator{};
+      const auto left_cardinality = cardinality_estimator.estimate_cardinality(join_hash.lqp_node->left_input());
+      const auto right_cardinality = cardinality_estimator.estimate_cardinality(join_hash.lqp_node->right_input());
+      if (left_cardinality == right_cardinality) return PQPVisitation::VisitInputs;
+      filter_left_input = left_cardinality > right_cardinality;
+    } else if (join_hash.mode() != JoinMode::Semi) {
+      return PQPVisitation::VisitInputs;
+    }
+
+    const auto& column_ids = join_hash.primary_predicate().column_ids;
+    if (filter_left_input) {
+      if (const auto table_scan = find_base_table_scan(op->mutable_left_input())) {
+        table_scan->set_runtime_bloom_filter(op->mutable_right_input(), column_ids.second, column_ids.first);
+      }
+    } else {
+      if (const auto table_scan = find_base_table_scan(op->mutable_right_input())) {
+        table_scan->set_runtime_bloom_filter(op->mutable_left_input(), column_ids.first, column_ids.second);
+      }
+    }
+
+    return PQPVisitation::VisitInputs;
+  });
+}
+
 std::shared_ptr<AbstractOperator> JoinHash::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -353,24 +415,63 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
       }
     };
 
+    /**
+     * The Bloom filters are sized from the smaller input. This holds all values of the side that is materialized first.
+     * Values of the other side are only inserted if they pass the first side's filter. Thus, they mostly have a join
+     * partner on the first side (unless that filter was not applied, in which case most values had a partner anyway).
+     *
+     * A filter is only built if it can be applied (i.e., if the other side does not keep all values as for outer or
+     * anti joins). Before applying a filter to a side, we probe it with the side's first morsel. If most values pass,
+     * the filter is not worth the cost of probing it for every value and an empty filter is passed instead.
+     */
+    const auto bloom_filter_value_count = std::min(_build_input_table->row_count(), _probe_input_table->row_count());
+    const auto no_bloom_filter = BloomFilter{};
+
     Timer timer_materialization;
     if (_build_input_table->row_count() < _probe_input_table->row_count()) {
-      // When materializing the first side (here: the build side), we do not yet have a Bloom filter. To keep the number
-      // of code paths low, materialize_*_side always expects a Bloom filter. For the first step, we thus pass in a
-      // Bloom filter that returns true for every probe.
-      materialize_build_side(ALL_TRUE_BLOOM_FILTER);
+      // When materializing the first side (here: the build side), we do not yet have a Bloom filter. The probe side's
+      // Bloom filter is later applied to the build side during radix partitioning or in build().
+      if (!keep_nulls_probe_column) {
+        build_side_bloom_filter = BloomFilter{bloom_filter_value_count};
+      }
+      if (!keep_nulls_build_column) {
+        probe_side_bloom_filter = BloomFilter{bloom_filter_value_count};
+      }
+
+      materialize_build_side(no_bloom_filter);
       _performance_data.set_step_runtime(OperatorSteps::BuildSideMaterializing, timer_materialization.lap());
-      materialize_probe_side(build_side_bloom_filter);
+
+      _performance_data.build_side_bloom_filter_applied =
+          !build_side_bloom_filter.empty() &&
+          bloom_filter_pass_rate<ProbeColumnType, HashedType>(*_probe_input_table, _column_ids.second,
+                                                              build_side_bloom_filter) <= BLOOM_FILTER_MAX_PASS_RATE;
+      materialize_probe_side(_performance_data.build_side_bloom_filter_applied ? build_side_bloom_filter
+                                                                               : no_bloom_filter);
       _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_materialization.lap());
     } else {
       // Here, we first materialize the probe side and use the resulting Bloom filter in the materialization of the
-      // build side. Consequently, the Bloom filter later passed into build() will have no effect as it has already
-      // been used here to filter non-matching values.
-      materialize_probe_side(ALL_TRUE_BLOOM_FILTER);
+      // build side. A Bloom filter for the build side is not needed, as the probe side has already been materialized.
+      if (!keep_nulls_build_column) {
+        probe_side_bloom_filter = BloomFilter{bloom_filter_value_count};
+      }
+
+      materialize_probe_side(no_bloom_filter);
       _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_materialization.lap());
-      materialize_build_side(probe_side_bloom_filter);
+
+      _performance_data.probe_side_bloom_filter_applied =
+          !probe_side_bloom_filter.empty() &&
+          bloom_filter_pass_rate<BuildColumnType, HashedType>(*_build_input_table, _column_ids.first,
+                                                              probe_side_bloom_filter) <= BLOOM_FILTER_MAX_PASS_RATE;
+      materialize_build_side(_performance_data.probe_side_bloom_filter_applied ? probe_side_bloom_filter
+                                                                               : no_bloom_filter);
       _performance_data.set_step_runtime(OperatorSteps::BuildSideMaterializing, timer_materialization.lap());
+
+      // Whether or not it was applied, the probe side's Bloom filter is not used for the build side anymore
+      _performance_data.probe_side_bloom_filter_size = probe_side_bloom_filter.size();
+      probe_side_bloom_filter = BloomFilter{};
     }
+    _performance_data.build_side_bloom_filter_size = build_side_bloom_filter.size();
+    build_side_bloom_filter = BloomFilter{};
 
     // Store the number of materialized values. Depending on the order of materialization (which depends on the input
     // sizes), each side might or might not be filtered by the Bloom filter.
@@ -382,11 +483,20 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     }
 
     /**
-     * 2. Perform radix partitioning for build and probe sides. The Bloom filters are not used in this step. Future work
-     *    could use them on the build side to exclude them for values that are not seen on the probe side. That would
-     *    reduce the size of the intermediary results, but would require an adapted calculation of the output offsets
-     *    within partition_by_radix.
+     * 2. Perform radix partitioning for build and probe sides. If the build side was materialized first, the probe
+     *    side's Bloom filter is applied to the build side here (unless its first morsel shows that it is not worth it).
+     *    This reduces the size of the intermediary results and makes using the Bloom filter in build() unnecessary.
      */
+    if (!probe_side_bloom_filter.empty()) {
+      _performance_data.probe_side_bloom_filter_size = probe_side_bloom_filter.size();
+      if (bloom_filter_pass_rate<BuildColumnType, HashedType>(*_build_input_table, _column_ids.first,
+                                                              probe_side_bloom_filter) <= BLOOM_FILTER_MAX_PASS_RATE) {
+        _performance_data.probe_side_bloom_filter_applied = true;
+      } else {
+        probe_side_bloom_filter = BloomFilter{};
+      }
+    }
+
     if (_radix_bits > 0) {
       Timer timer_clustering;
       auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
@@ -395,10 +505,10 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
         // radix partition the build table
         if (keep_nulls_build_column) {
           radix_build_column = partition_by_radix<BuildColumnType, HashedType, true>(
-              materialized_build_column, histograms_build_column, _radix_bits);
+              materialized_build_column, histograms_build_column, _radix_bits, probe_side_bloom_filter);
         } else {
           radix_build_column = partition_by_radix<BuildColumnType, HashedType, false>(
-              materialized_build_column, histograms_build_column, _radix_bits);
+              materialized_build_column, histograms_build_column, _radix_bits, probe_side_bloom_filter);
         }
 
         // After the data in materialized_build_column has been partitioned, it is not needed anymore.
@@ -424,6 +534,11 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
       histograms_build_column.clear();
       histograms_probe_column.clear();
 
+      if (!probe_side_bloom_filter.empty()) {
+        _performance_data.probe_side_bloom_filter_applied_in_clustering = true;
+        probe_side_bloom_filter = BloomFilter{};
+      }
+
       _performance_data.set_step_runtime(OperatorSteps::Clustering, timer_clustering.lap());
     } else {
       // short cut: skip radix partitioning and use materialized data directly
@@ -436,8 +551,8 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
      *    In the case of semi or anti joins, we do not need to track all rows on the hashed side, just one per value.
      *    value. However, if we have secondary predicates, those might fail on that single row. In that case, we DO need
      *    all rows.
-     *    We use the probe side's Bloom filter to exclude values from the hash table that will not be accessed in the
-     *    probe step.
+     *    If it has not been applied yet, we use the probe side's Bloom filter to exclude values from the hash table
+     *    that will not be accessed in the probe step.
      */
     Timer timer_hash_map_building;
     if (_secondary_predicates.empty() &&
@@ -489,51 +604,52 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     /**
      * 4. Probe step
      */
+    // Partitions that are much larger than the others (e.g., because they hold heavy-hitter keys) are split into
+    // several ranges that are probed concurrently. Each range gets its own pos lists.
+    const auto probe_ranges = split_probe_partitions(radix_probe_column);
+    _performance_data.probe_range_count = probe_ranges.size();
+    for (const auto& probe_range : probe_ranges) {
+      if (probe_range.begin == 0 && probe_range.end < radix_probe_column[probe_range.partition_idx].elements.size()) {
+        ++_performance_data.skewed_probe_partition_count;
+      }
+    }
+
     std::vector<RowIDPosList> build_side_pos_lists;
     std::vector<RowIDPosList> probe_side_pos_lists;
-    const size_t partition_count = radix_probe_column.size();
-    build_side_pos_lists.resize(partition_count);
-    probe_side_pos_lists.resize(partition_count);
-
-    // simple heuristic: half of the rows of the probe side will match
-    const size_t result_rows_per_partition =
-        _probe_input_table->row_count() > 0 ? _probe_input_table->row_count() / partition_count / 2 : 0;
-    for (size_t i = 0; i < partition_count; i++) {
-      build_side_pos_lists[i].reserve(result_rows_per_partition);
-      probe_side_pos_lists[i].reserve(result_rows_per_partition);
-    }
+    build_side_pos_lists.resize(probe_ranges.size());
+    probe_side_pos_lists.resize(probe_ranges.size());
 
     Timer timer_probing;
     switch (_mode) {
       case JoinMode::Inner:
-        probe<ProbeColumnType, HashedType, false>(radix_probe_column, hash_tables, build_side_pos_lists,
-                                                  probe_side_pos_lists, _mode, *_build_input_table, *_probe_input_table,
-                                                  _secondary_predicates);
+        probe<ProbeColumnType, HashedType, false>(radix_probe_column, probe_ranges, hash_tables, build_side_pos_lists,
+                                                  probe_side_pos_lists, _mode, *_build_input_table,
+                                                  *_probe_input_table, _secondary_predicates);
         break;
 
       case JoinMode::Left:
       case JoinMode::Right:
-        probe<ProbeColumnType, HashedType, true>(radix_probe_column, hash_tables, build_side_pos_lists,
+        probe<ProbeColumnType, HashedType, true>(radix_probe_column, probe_ranges, hash_tables, build_side_pos_lists,
                                                  probe_side_pos_lists, _mode, *_build_input_table, *_probe_input_table,
                                                  _secondary_predicates);
         break;
 
       case JoinMode::Semi:
-        probe_semi_anti<ProbeColumnType, HashedType, JoinMode::Semi>(radix_probe_column, hash_tables,
-                                                                     probe_side_pos_lists, *_build_input_table,
-                                                                     *_probe_input_table, _secondary_predicates);
+        probe_semi_anti<ProbeColumnType, HashedType, JoinMode::Semi>(
+            radix_probe_column, probe_ranges, hash_tables, probe_side_pos_lists, *_build_input_table,
+            *_probe_input_table, _secondary_predicates);
         break;
 
       case JoinMode::AntiNullAsTrue:
         probe_semi_anti<ProbeColumnType, HashedType, JoinMode::AntiNullAsTrue>(
-            radix_probe_column, hash_tables, probe_side_pos_lists, *_build_input_table, *_probe_input_table,
-            _secondary_predicates);
+            radix_probe_column, probe_ranges, hash_tables, probe_side_pos_lists, *_build_input_table,
+            *_probe_input_table, _secondary_predicates);
         break;
 
       case JoinMode::AntiNullAsFalse:
         probe_semi_anti<ProbeColumnType, HashedType, JoinMode::AntiNullAsFalse>(
-            radix_probe_column, hash_tables, probe_side_pos_lists, *_build_input_table, *_probe_input_table,
-            _secondary_predicates);
+            radix_probe_column, probe_ranges, hash_tables, probe_side_pos_lists, *_build_input_table,
+            *_probe_input_table, _secondary_predicates);
         break;
 
       default:
@@ -580,6 +696,21 @@ void JoinHash::PerformanceData::output_to_stream(std::ostream& stream, Descripti
   const auto* const separator = description_mode == DescriptionMode::SingleLine ? " " : "\n";
   stream << separator << "Radix bits: " << radix_bits << ".";
   stream << separator << "Build side is " << (left_input_is_build_side ? "left." : "right.");
+
+  const auto describe_bloom_filter = [&](const size_t size, const bool applied) {
+    if (size == 0) {
+      stream << "not built";
+      return;
+    }
+    stream << size << " bits, " << (applied ? "applied" : "not applied");
+  };
+  stream << separator << "Bloom filters: build side ";
+  describe_bloom_filter(build_side_bloom_filter_size, build_side_bloom_filter_applied);
+  stream << ", probe side ";
+  describe_bloom_filter(probe_side_bloom_filter_size, probe_side_bloom_filter_applied);
+  stream << (probe_side_bloom_filter_applied_in_clustering ? " during radix partitioning." : ".");
+  stream << separator << "Probe ranges: " << probe_range_count << " (" << skewed_probe_partition_count
+         << " skewed partitions split).";
 }
 
 }  // namespace opossum
@@ -36,6 +36,19 @@ class JoinHash : public AbstractJoinOperator {
 
   static size_t calculate_radix_bits(const size_t build_side_size, const size_t probe_side_size, const JoinMode mode);
 
+  /**
+   * Adds runtime join filters to the given unexecuted PQP (sideways information passing): For inner and semi hash
+   * joins, a Bloom filter is built from the join column of one input and applied in a TableScan of the other input.
+   * Thus, rows that will not find a join partner are dropped before they are passed through the remaining operators
+   * of that input. For semi joins, the left input is filtered. For inner joins, the input with the higher estimated
+   * cardinality is filtered, which requires the join's LQP node.
+   *
+   * The filter is applied in the topmost TableScan of a chain of TableScans and Validates on top of a GetTable whose
+   * operators are not consumed by any other operator. As the scan has to wait for the other input to be executed,
+   * the two inputs are not executed concurrently anymore.
+   */
+  static void push_down_bloom_filters(const std::shared_ptr<AbstractOperator>& pqp);
+
   enum class OperatorSteps : uint8_t {
     BuildSideMaterializing,
     ProbeSideMaterializing,
@@ -64,6 +77,21 @@ class JoinHash : public AbstractJoinOperator {
     // build_side_position_count (see order of materialization in hash_join.cpp).
     size_t hash_tables_distinct_value_count{0};
     std::optional<size_t> hash_tables_position_count;
+
+    // Size (in bits) of the Bloom filters, 0 if a filter was not built. The filter of the side that is materialized
+    // first is applied to the other side unless the other side's first morsel shows that most values pass it anyway.
+    // If the build side is materialized first, the probe side's filter is applied to the build side during radix
+    // partitioning (if it is performed) or in build().
+    size_t build_side_bloom_filter_size{0};
+    size_t probe_side_bloom_filter_size{0};
+    bool build_side_bloom_filter_applied{false};
+    bool probe_side_bloom_filter_applied{false};
+    bool probe_side_bloom_filter_applied_in_clustering{false};
+
+    // Number of ranges that the probe partitions were split into and number of partitions that were split into more
+    // than one range because they are considerably larger than the average partition (see split_probe_partitions).
+    size_t probe_range_count{0};
+    size_t skewed_probe_partition_count{0};
   };
 
  protected:
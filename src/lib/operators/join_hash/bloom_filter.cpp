@@ -0,0 +1,24 @@
+#include "bloom_filter.hpp"
+
+#include <algorithm>
+
+namespace opossum {
+
+BloomFilter::BloomFilter(const size_t value_count) {
+  const auto bit_count = std::clamp(value_count * BITS_PER_VALUE, MIN_SIZE, MAX_SIZE);
+
+  // Round up to a power of two so that the word can be selected with a mask
+  auto word_count = size_t{1};
+  while (word_count * 64 < bit_count) {
+    word_count *= 2;
+  }
+
+  _words.resize(word_count);
+  _word_mask = word_count - 1;
+}
+
+bool BloomFilter::empty() const { return _words.empty(); }
+
+size_t BloomFilter::size() const { return _words.size() * 64; }
+
+}  // namespace opossum
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// Bloom filter used by the hash join to skip values that will not find a join partner. It is register-blocked: all
+// bits of a value are set in the same 64-bit word, so that inserting or probing a value costs a single memory access.
+// Within that word, HASH_FUNCTION_COUNT bits are set. For the same size, the false positive rate is slightly higher
+// than that of a standard Bloom filter, but probing is considerably cheaper.
+//
+// The filter is sized from the number of (not necessarily distinct) values that are expected to be inserted. A
+// default-constructed filter is empty, i.e., it has no bits and must not be used. The hash join uses empty filters to
+// denote that no filter was built or that a filter should not be applied.
+class BloomFilter {
+ public:
+  static constexpr auto BITS_PER_VALUE = size_t{8};
+  static constexpr auto HASH_FUNCTION_COUNT = size_t{3};
+
+  // Limits for the size in bits. The maximum corresponds to 128 MB.
+  static constexpr auto MIN_SIZE = size_t{1} << 12;
+  static constexpr auto MAX_SIZE = size_t{1} << 30;
+
+  BloomFilter() = default;
+  explicit BloomFilter(const size_t value_count);
+
+  // Adds the value with the given hash. Can be called concurrently, e.g., by the jobs materializing different chunks.
+  void insert(const size_t hash) {
+    const auto mixed_hash = _mix(hash);
+    auto& word = _words[mixed_hash & _word_mask];
+    const auto mask = _mask(mixed_hash);
+
+    // Duplicates are common in join columns. Checking first avoids the more expensive atomic write for them.
+    if ((__atomic_load_n(&word, __ATOMIC_RELAXED) & mask) != mask) {
+      __atomic_fetch_or(&word, mask, __ATOMIC_RELAXED);
+    }
+  }
+
+  // Returns false if no value with the given hash has been inserted. Must not be called concurrently with insert().
+  bool contains(const size_t hash) const {
+    const auto mixed_hash = _mix(hash);
+    const auto mask = _mask(mixed_hash);
+    return (_words[mixed_hash & _word_mask] & mask) == mask;
+  }
+
+  bool empty() const;
+
+  // Size in bits
+  size_t size() const;
+
+ private:
+  // The hashes of the join (i.e., std::hash) are the identity for integers. To spread them over the filter, we use the
+  // finalizer of MurmurHash3.
+  static uint64_t _mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // The lower bits of the mixed hash select the word (see MAX_SIZE), the upper bits select the bits within the word
+  static uint64_t _mask(const uint64_t mixed_hash) {
+    return (uint64_t{1} << ((mixed_hash >> 40) & 63)) | (uint64_t{1} << ((mixed_hash >> 46) & 63)) |
+           (uint64_t{1} << ((mixed_hash >> 52) & 63));
+  }
+
+  std::vector<uint64_t> _words;
+  uint64_t _word_mask{0};
+};
+
+}  // namespace opossum
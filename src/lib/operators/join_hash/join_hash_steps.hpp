@@ -3,10 +3,10 @@
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 #include <boost/container/pmr/unsynchronized_pool_resource.hpp>
 #include <boost/container/small_vector.hpp>
-#include <boost/dynamic_bitset.hpp>
 #include <boost/lexical_cast.hpp>
 #include <uninitialized_vector.hpp>
 
+#include "bloom_filter.hpp"
 #include "bytell_hash_map.hpp"
 #include "hyrise.hpp"
 #include "operators/join_hash.hpp"
@@ -222,47 +222,61 @@ class PosHashTable {
   std::optional<UnifiedPosList> _unified_pos_list{};
 };
 
-// The Bloom filter (with k=1) is used during the materialization and build phases. It contains `true` for each
-// `hash_function(value) % BLOOM_FILTER_SIZE`. Much of how the Bloom filter is used in the hash join could be improved:
-// (1) Dynamically check whether Bloom filters are worth the memory and computational costs. This could be based on the
-//     input table sizes, the expected cardinalities, the hardware characteristics, or other factors.
-// (2) Choosing an appropriate filter size. 2^20 was experimentally found to be good for TPC-H SF 10, but is certainly
-//     not optimal in every situation.
-// (3) Evaluate whether using multiple hash functions (k>1) brings any improvement. In a first experiment, however, we
-//     saw no benefits for single-threaded TPC-H SF 10.
-// (4) Use the probe side Bloom filter when partitioning the build side. By doing that, we reduce the size of the
-//     intermediary results. When a Bloom filter-supported partitioning has been done (i.e., partitioning has not
-//     been skipped), we do not need to use a Bloom filter in the build phase anymore.
-// Some of these points could be addressed with relatively low effort and should bring additional, significant benefits.
-// We did not yet work on this because the Bloom filter was a byproduct of a research project and we have not had the
-// resources to optimize it at the time.
-static constexpr auto BLOOM_FILTER_SIZE = 1 << 20;
-static constexpr auto BLOOM_FILTER_MASK = BLOOM_FILTER_SIZE - 1;
-
-// Using dynamic_bitset because, different from vector<bool>, it has an efficient operator| implementation, which is
-// needed for merging partial Bloom filters created by different threads. Note that the dynamic_bitset(n, value)
-// constructor does not do what you would expect it to, so try to avoid it.
-using BloomFilter = boost::dynamic_bitset<>;
-
-// ALL_TRUE_BLOOM_FILTER is initialized by creating a BloomFilter with every value being false and using bitwise
-// negation (~x). As the negation is surprisingly expensive, we create a static empty Bloom filter and reference
-// it where needed. Having a Bloom filter that always returns true avoids a branch in the hot loop.
-static const auto ALL_TRUE_BLOOM_FILTER = ~BloomFilter(BLOOM_FILTER_SIZE);
+// Bloom filters are used during the materialization, radix partitioning, and build phases to skip values that will
+// not find a join partner. The filter of the side that is materialized first is applied when materializing the other
+// side. If the build side is materialized first, the probe side's filter is applied to the build side when it is radix
+// partitioned (or, without radix partitioning, in build()). A filter is not applied if the first morsel of the other
+// side shows that most of its values pass the filter anyway (see bloom_filter_pass_rate()).
+static constexpr auto BLOOM_FILTER_MAX_PASS_RATE = 0.8;
+
+// Number of non-NULL values that bloom_filter_pass_rate() probes
+static constexpr auto BLOOM_FILTER_SAMPLE_SIZE = size_t{1'000};
+
+// Returns the share of the first BLOOM_FILTER_SAMPLE_SIZE non-NULL values of the column that pass the Bloom filter. If
+// the column has no non-NULL values, 0.0 is returned.
+template <typename T, typename HashedType>
+double bloom_filter_pass_rate(const Table& in_table, const ColumnID column_id, const BloomFilter& bloom_filter) {
+  DebugAssert(!bloom_filter.empty(), "Expected a Bloom filter");
+
+  const std::hash<HashedType> hash_function;
+  auto sampled_value_count = size_t{0};
+  auto passed_value_count = size_t{0};
+
+  const auto chunk_count = in_table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count && sampled_value_count < BLOOM_FILTER_SAMPLE_SIZE;
+       ++chunk_id) {
+    const auto chunk = in_table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    segment_with_iterators<T>(*chunk->get_segment(column_id), [&](auto it, const auto end) {
+      for (; it != end && sampled_value_count < BLOOM_FILTER_SAMPLE_SIZE; ++it) {
+        if (it->is_null()) continue;
+
+        ++sampled_value_count;
+        if (bloom_filter.contains(hash_function(static_cast<HashedType>(it->value())))) {
+          ++passed_value_count;
+        }
+      }
+    });
+  }
+
+  if (sampled_value_count == 0) return 0.0;
+  return static_cast<double>(passed_value_count) / static_cast<double>(sampled_value_count);
+}
 
 // @param in_table             Table to materialize
 // @param column_id            Column within that table to materialize
 // @param histograms           Out: If radix_bits > 0, contains one histogram per chunk where each histogram contains
 //                             1 << radix_bits slots
 // @param radix_bits           Number of radix_bits, needed only for histogram calculation
-// @param output_bloom_filter  Out: A filled BloomFilter where `value & BLOOM_FILTER_MASK == true` for each value
-//                             encountered in the input column
-// @param input_bloom_filter   Optional: Materialization is skipped for each value where the corresponding slot in the
-//                             Bloom filter is false
+// @param output_bloom_filter  Out: Unless empty, each value encountered in the input column is inserted
+// @param input_bloom_filter   Optional: Unless empty, materialization is skipped for each value that the Bloom filter
+//                             does not contain
 template <typename T, typename HashedType, bool keep_null_values>
 RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table, const ColumnID column_id,
                                     std::vector<std::vector<size_t>>& histograms, const size_t radix_bits,
                                     BloomFilter& output_bloom_filter,
-                                    const BloomFilter& input_bloom_filter = ALL_TRUE_BLOOM_FILTER) {
+                                    const BloomFilter& input_bloom_filter = BloomFilter{}) {
   // Retrieve input chunk_count as it might change during execution if we work on a non-reference table
   auto chunk_count = in_table->chunk_count();
 
@@ -278,11 +292,10 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
   const auto pass = size_t{0};
   const auto radix_mask = static_cast<size_t>(pow(2, radix_bits * (pass + 1)) - 1);
 
-  Assert(output_bloom_filter.empty(), "output_bloom_filter should be empty");
-  output_bloom_filter.resize(BLOOM_FILTER_SIZE);
-  std::mutex output_bloom_filter_mutex;
-
-  Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE, "Invalid input_bloom_filter");
+  // Values are only skipped if they cannot be part of the output. If NULL values are kept (e.g., for the outer side of
+  // outer joins), this also holds for values without a join partner.
+  const auto use_input_bloom_filter = !input_bloom_filter.empty() && !keep_null_values;
+  const auto fill_output_bloom_filter = !output_bloom_filter.empty();
 
   // Create histograms per chunk
   histograms.resize(chunk_count);
@@ -296,14 +309,6 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
     const auto num_rows = chunk_in->size();
 
     const auto materialize = [&, chunk_in, chunk_id, num_rows]() {
-      auto local_output_bloom_filter = BloomFilter{};
-      std::reference_wrapper<BloomFilter> used_output_bloom_filter = output_bloom_filter;
-      if (Hyrise::get().is_multi_threaded()) {
-        // We cannot write to BloomFilter concurrently, so we build a local one first.
-        local_output_bloom_filter = BloomFilter(BLOOM_FILTER_SIZE, false);
-        used_output_bloom_filter = local_output_bloom_filter;
-      }
-
       // Skip chunks that were physically deleted
       if (!chunk_in) return;
 
@@ -347,14 +352,16 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
             const Hash hashed_value = hash_function(static_cast<HashedType>(value.value()));
 
             auto skip = false;
-            if (!value.is_null() && !input_bloom_filter[hashed_value & BLOOM_FILTER_MASK] && !keep_null_values) {
+            if (use_input_bloom_filter && !value.is_null() && !input_bloom_filter.contains(hashed_value)) {
               // Value in not present in input bloom filter and can be skipped
               skip = true;
             }
 
             if (!skip) {
-              // Fill the corresponding slot in the bloom filter
-              used_output_bloom_filter.get()[hashed_value & BLOOM_FILTER_MASK] = true;
+              // BloomFilter::insert() can be called concurrently by the jobs of different chunks
+              if (fill_output_bloom_filter) {
+                output_bloom_filter.insert(hashed_value);
+              }
 
               /*
               For ReferenceSegments we do not use the RowIDs from the referenced tables.
@@ -398,12 +405,6 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
       null_values.resize(std::distance(null_values.begin(), null_values_iter));
 
       histograms[chunk_id] = std::move(histogram);
-
-      if (Hyrise::get().is_multi_threaded()) {
-        // Merge the local_output_bloom_filter into output_bloom_filter
-        std::lock_guard<std::mutex> lock{output_bloom_filter_mutex};
-        output_bloom_filter |= local_output_bloom_filter;
-      }
     };
     if (JoinHash::JOB_SPAWN_THRESHOLD > num_rows) {
       materialize();
@@ -417,14 +418,15 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
 }
 
 /*
-Build all the hash tables for the partitions of the build column. One job per partition
+Build all the hash tables for the partitions of the build column. One job per partition. Unless input_bloom_filter is
+empty, values that it does not contain are not inserted.
 */
 
 template <typename BuildColumnType, typename HashedType>
 std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<BuildColumnType>& radix_container,
                                                            const JoinHashBuildMode mode, const size_t radix_bits,
                                                            const BloomFilter& input_bloom_filter) {
-  Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE, "invalid input_bloom_filter");
+  const auto use_input_bloom_filter = !input_bloom_filter.empty();
 
   if (radix_container.empty()) return {};
 
@@ -469,7 +471,7 @@ std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<
         DebugAssert(!(element.row_id == NULL_ROW_ID), "No NULL_ROW_IDs should make it to this point");
 
         const Hash hashed_value = hash_function(static_cast<HashedType>(element.value));
-        if (!input_bloom_filter[hashed_value & BLOOM_FILTER_MASK]) {
+        if (use_input_bloom_filter && !input_bloom_filter.contains(hashed_value)) {
           continue;
         }
 
@@ -499,10 +501,11 @@ std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<
   return hash_tables;
 }
 
+// Unless input_bloom_filter is empty, values that it does not contain are dropped. NULL values are always kept.
 template <typename T, typename HashedType, bool keep_null_values>
 RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
                                      std::vector<std::vector<size_t>>& histograms, const size_t radix_bits,
-                                     const BloomFilter& input_bloom_filter = ALL_TRUE_BLOOM_FILTER) {
+                                     const BloomFilter& input_bloom_filter = BloomFilter{}) {
   if (radix_container.empty()) return radix_container;
 
   if constexpr (keep_null_values) {
@@ -526,6 +529,48 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
   Assert(histograms.size() == input_partition_count, "Expected one histogram per input partition");
   Assert(histograms[0].size() == output_partition_count, "Expected one histogram bucket per output partition");
 
+  const auto use_input_bloom_filter = !input_bloom_filter.empty();
+
+  // Returns whether the element at input_idx of the input partition is written to the output
+  const auto keep_element = [&](const Partition<T>& input_partition, const size_t input_idx, const Hash hashed_value) {
+    if (!use_input_bloom_filter) return true;
+    if constexpr (keep_null_values) {
+      if (input_partition.null_values[input_idx]) return true;
+    }
+    return input_bloom_filter.contains(hashed_value);
+  };
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(input_partition_count);
+
+  // The histograms were created during the materialization. When values are dropped because of the Bloom filter, the
+  // histograms are recalculated for the remaining values.
+  if (use_input_bloom_filter) {
+    for (auto input_partition_idx = size_t{0}; input_partition_idx < input_partition_count; ++input_partition_idx) {
+      const auto elements_count = radix_container[input_partition_idx].elements.size();
+
+      const auto recalculate_histogram = [&, input_partition_idx, elements_count]() {
+        const auto& input_partition = radix_container[input_partition_idx];
+        auto& histogram = histograms[input_partition_idx];
+        std::fill(histogram.begin(), histogram.end(), size_t{0});
+
+        for (auto input_idx = size_t{0}; input_idx < elements_count; ++input_idx) {
+          const Hash hashed_value = hash_function(static_cast<HashedType>(input_partition.elements[input_idx].value));
+          if (keep_element(input_partition, input_idx, hashed_value)) {
+            ++histogram[hashed_value & radix_mask];
+          }
+        }
+      };
+      if (JoinHash::JOB_SPAWN_THRESHOLD > elements_count) {
+        recalculate_histogram();
+      } else {
+        jobs.emplace_back(std::make_shared<JobTask>(recalculate_histogram));
+      }
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+    jobs.clear();
+  }
+
   // Writing to std::vector<bool> is not thread-safe if the same byte is being written to. For now, we temporarily
   // use a std::vector<char> and compress it into an std::vector<bool> later.
   auto null_values_as_char = std::vector<std::vector<char>>(output_partition_count);
@@ -548,9 +593,6 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
     }
   }
 
-  std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(input_partition_count);
-
   for (auto input_partition_idx = ChunkID{0}; input_partition_idx < input_partition_count; ++input_partition_idx) {
     const auto& input_partition = radix_container[input_partition_idx];
     const auto& elements = input_partition.elements;
@@ -564,7 +606,10 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
           DebugAssert(!(element.row_id == NULL_ROW_ID), "NULL_ROW_ID should not have made it this far");
         }
 
-        const size_t radix = hash_function(static_cast<HashedType>(element.value)) & radix_mask;
+        const Hash hashed_value = hash_function(static_cast<HashedType>(element.value));
+        if (!keep_element(input_partition, input_idx, hashed_value)) continue;
+
+        const size_t radix = hashed_value & radix_mask;
 
         auto& output_idx = output_offsets_by_input_partition[input_partition_idx][radix];
         DebugAssert(output_idx < output[radix].elements.size(), "output_idx is completely out-of-bounds");
@@ -610,19 +655,73 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
   return output;
 }
 
+// A range of elements of a probe partition that is probed by a single job
+struct ProbeRange {
+  size_t partition_idx;
+  size_t begin;
+  size_t end;
+};
+
+// Radix partitioning assumes that the join keys are roughly uniformly distributed. Under skew (e.g., Zipf-distributed
+// foreign keys), the partitions that hold heavy-hitter keys are much larger than the others. If each partition was
+// probed by a single job, one worker would do most of the work while the others idle. Thus, partitions that hold more
+// than SKEWED_PARTITION_FACTOR times the average number of elements are split into ranges of the average size (but at
+// least MIN_PROBE_RANGE_SIZE elements), which are probed by separate jobs. The hash table is only read while probing,
+// so the jobs can share it.
+static constexpr auto SKEWED_PARTITION_FACTOR = size_t{4};
+static constexpr auto MIN_PROBE_RANGE_SIZE = size_t{10'000};
+
+// Returns the ranges that the probe partitions are split into. Empty partitions are skipped to avoid empty output
+// chunks. The ranges of a partition are consecutive.
+template <typename T>
+std::vector<ProbeRange> split_probe_partitions(const RadixContainer<T>& radix_container) {
+  auto element_count = size_t{0};
+  auto non_empty_partition_count = size_t{0};
+  for (const auto& partition : radix_container) {
+    element_count += partition.elements.size();
+    if (!partition.elements.empty()) ++non_empty_partition_count;
+  }
+
+  auto probe_ranges = std::vector<ProbeRange>{};
+  if (element_count == 0) return probe_ranges;
+  probe_ranges.reserve(non_empty_partition_count);
+
+  const auto range_size = std::max(element_count / non_empty_partition_count, MIN_PROBE_RANGE_SIZE);
+  for (auto partition_idx = size_t{0}; partition_idx < radix_container.size(); ++partition_idx) {
+    const auto partition_size = radix_container[partition_idx].elements.size();
+    if (partition_size == 0) continue;
+
+    if (partition_size <= SKEWED_PARTITION_FACTOR * range_size) {
+      probe_ranges.emplace_back(ProbeRange{partition_idx, 0, partition_size});
+      continue;
+    }
+
+    for (auto begin = size_t{0}; begin < partition_size; begin += range_size) {
+      probe_ranges.emplace_back(ProbeRange{partition_idx, begin, std::min(begin + range_size, partition_size)});
+    }
+  }
+
+  return probe_ranges;
+}
+
 /*
   In the probe phase we take all partitions from the probe partition, iterate over them and compare each join candidate
   with the values in the hash table. Since build and probe are hashed using the same hash function, we can reduce the
   number of hash tables that need to be looked into to just 1.
+  The partitions are probed in the given ranges (see split_probe_partitions). The matches of the n-th range are written
+  to the n-th pos lists.
   */
 template <typename ProbeColumnType, typename HashedType, bool keep_null_values>
-void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
+void probe(const RadixContainer<ProbeColumnType>& probe_radix_container, const std::vector<ProbeRange>& probe_ranges,
            const std::vector<std::optional<PosHashTable<HashedType>>>& hash_tables,
            std::vector<RowIDPosList>& pos_lists_build_side, std::vector<RowIDPosList>& pos_lists_probe_side,
            const JoinMode mode, const Table& build_table, const Table& probe_table,
            const std::vector<OperatorJoinPredicate>& secondary_join_predicates) {
+  DebugAssert(pos_lists_build_side.size() == probe_ranges.size() && pos_lists_probe_side.size() == probe_ranges.size(),
+              "Expected one pos list per probe range");
+
   std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(probe_radix_container.size());
+  jobs.reserve(probe_ranges.size());
 
   /*
     NUMA notes:
@@ -632,17 +731,16 @@ void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
     and the job that probes that partition should also be on that NUMA node.
   */
 
-  for (size_t partition_idx = 0; partition_idx < probe_radix_container.size(); ++partition_idx) {
-    // Skip empty partitions to avoid empty output chunks
-    if (probe_radix_container[partition_idx].elements.empty()) {
-      continue;
-    }
+  for (auto range_idx = size_t{0}; range_idx < probe_ranges.size(); ++range_idx) {
+    const auto partition_idx = probe_ranges[range_idx].partition_idx;
+    const auto range_begin = probe_ranges[range_idx].begin;
+    const auto range_end = probe_ranges[range_idx].end;
 
     const auto& partition = probe_radix_container[partition_idx];
     const auto& elements = partition.elements;
-    const auto elements_count = elements.size();
+    const auto elements_count = range_end - range_begin;
 
-    const auto probe_partition = [&, partition_idx, elements_count]() {
+    const auto probe_partition = [&, partition_idx, range_idx, range_begin, range_end, elements_count]() {
       const auto& null_values = partition.null_values;
 
       RowIDPosList pos_list_build_side_local;
@@ -666,11 +764,11 @@ void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
 
         // Simple heuristic to estimate result size: half of the partition's rows will match
         // a more conservative pre-allocation would be the size of the build cluster
-        const size_t expected_output_size = static_cast<size_t>(std::max(10.0, std::ceil(elements.size() / 2)));
+        const size_t expected_output_size = static_cast<size_t>(std::max(10.0, std::ceil(elements_count / 2)));
         pos_list_build_side_local.reserve(static_cast<size_t>(expected_output_size));
         pos_list_probe_side_local.reserve(static_cast<size_t>(expected_output_size));
 
-        for (auto partition_offset = size_t{0}; partition_offset < elements_count; ++partition_offset) {
+        for (auto partition_offset = range_begin; partition_offset < range_end; ++partition_offset) {
           const auto& probe_column_element = elements[partition_offset];
 
           if (mode == JoinMode::Inner && probe_column_element.row_id == NULL_ROW_ID) {
@@ -753,7 +851,7 @@ void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
           pos_list_build_side_local.reserve(elements_count);
           pos_list_probe_side_local.reserve(elements_count);
 
-          for (auto partition_offset = size_t{0}; partition_offset < elements_count; ++partition_offset) {
+          for (auto partition_offset = range_begin; partition_offset < range_end; ++partition_offset) {
             const auto& element = elements[partition_offset];
             pos_list_build_side_local.emplace_back(NULL_ROW_ID);
             pos_list_probe_side_local.emplace_back(element.row_id);
@@ -761,8 +859,8 @@ void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
         }
       }
 
-      pos_lists_build_side[partition_idx] = std::move(pos_list_build_side_local);
-      pos_lists_probe_side[partition_idx] = std::move(pos_list_probe_side_local);
+      pos_lists_build_side[range_idx] = std::move(pos_list_build_side_local);
+      pos_lists_probe_side[range_idx] = std::move(pos_list_probe_side_local);
     };
 
     if (JoinHash::JOB_SPAWN_THRESHOLD > elements_count) {
@@ -777,23 +875,25 @@ void probe(const RadixContainer<ProbeColumnType>& probe_radix_container,
 
 template <typename ProbeColumnType, typename HashedType, JoinMode mode>
 void probe_semi_anti(const RadixContainer<ProbeColumnType>& probe_radix_container,
+                     const std::vector<ProbeRange>& probe_ranges,
                      const std::vector<std::optional<PosHashTable<HashedType>>>& hash_tables,
                      std::vector<RowIDPosList>& pos_lists, const Table& build_table, const Table& probe_table,
                      const std::vector<OperatorJoinPredicate>& secondary_join_predicates) {
+  DebugAssert(pos_lists.size() == probe_ranges.size(), "Expected one pos list per probe range");
+
   std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(probe_radix_container.size());
+  jobs.reserve(probe_ranges.size());
 
-  for (size_t partition_idx = 0; partition_idx < probe_radix_container.size(); ++partition_idx) {
-    // Skip empty partitions to avoid empty output chunks
-    if (probe_radix_container[partition_idx].elements.empty()) {
-      continue;
-    }
+  for (auto range_idx = size_t{0}; range_idx < probe_ranges.size(); ++range_idx) {
+    const auto partition_idx = probe_ranges[range_idx].partition_idx;
+    const auto range_begin = probe_ranges[range_idx].begin;
+    const auto range_end = probe_ranges[range_idx].end;
 
     const auto& partition = probe_radix_container[partition_idx];
     const auto& elements = partition.elements;
-    const auto elements_count = elements.size();
+    const auto elements_count = range_end - range_begin;
 
-    const auto probe_partition = [&, partition_idx, elements_count]() {
+    const auto probe_partition = [&, partition_idx, range_idx, range_begin, range_end, elements_count]() {
       // Get information from work queue
       const auto& null_values = partition.null_values;
 
@@ -808,7 +908,7 @@ void probe_semi_anti(const RadixContainer<ProbeColumnType>& probe_radix_containe
         MultiPredicateJoinEvaluator multi_predicate_join_evaluator(build_table, probe_table, mode,
                                                                    secondary_join_predicates);
 
-        for (auto partition_offset = size_t{0}; partition_offset < elements_count; ++partition_offset) {
+        for (auto partition_offset = range_begin; partition_offset < range_end; ++partition_offset) {
           const auto& probe_column_element = elements[partition_offset];
 
           if constexpr (mode == JoinMode::Semi) {
@@ -859,8 +959,8 @@ void probe_semi_anti(const RadixContainer<ProbeColumnType>& probe_radix_containe
       } else if constexpr (mode == JoinMode::AntiNullAsFalse) {  // NOLINT - doesn't like `else if`
         // no hash table on other side, but we are in AntiNullAsFalse mode which means all tuples from the probing side
         // get emitted.
-        pos_list_local.reserve(elements.size());
-        for (auto partition_offset = size_t{0}; partition_offset < elements_count; ++partition_offset) {
+        pos_list_local.reserve(elements_count);
+        for (auto partition_offset = range_begin; partition_offset < range_end; ++partition_offset) {
           auto& probe_column_element = elements[partition_offset];
           pos_list_local.emplace_back(probe_column_element.row_id);
         }
@@ -869,7 +969,7 @@ void probe_semi_anti(const RadixContainer<ProbeColumnType>& probe_radix_containe
         // get emitted. That is, except NULL values, which only get emitted if the build table is empty.
         const auto build_table_is_empty = build_table.row_count() == 0;
         pos_list_local.reserve(elements_count);
-        for (auto partition_offset = size_t{0}; partition_offset < elements_count; ++partition_offset) {
+        for (auto partition_offset = range_begin; partition_offset < range_end; ++partition_offset) {
           auto& probe_column_element = elements[partition_offset];
           // A NULL on the probe side never gets emitted, except when the build table is empty.
           // This is because `NULL NOT IN <empty list>` is actually true
@@ -880,7 +980,7 @@ void probe_semi_anti(const RadixContainer<ProbeColumnType>& probe_radix_containe
         }
       }
 
-      pos_lists[partition_idx] = std::move(pos_list_local);
+      pos_lists[range_idx] = std::move(pos_list_local);
     };
 
     if (JoinHash::JOB_SPAWN_THRESHOLD > elements_count) {
@@ -1,11 +1,17 @@
 #include "join_nested_loop.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/segment_iterables/any_segment_iterable.hpp"
 #include "storage/segment_iterate.hpp"
@@ -68,6 +74,337 @@ join_two_typed_segments(const BinaryFunctor& func, LeftIterator left_it, LeftIte
     }
   }
 }
+
+// Non-NULL values of a join column of one chunk, stored densely so that the comparisons can be vectorized
+template <typename T>
+struct MaterializedChunk {
+  std::vector<T> values;
+  std::vector<ChunkOffset> chunk_offsets;
+};
+
+template <typename T>
+MaterializedChunk<T> materialize_chunk(const AbstractSegment& segment) {
+  auto materialized_chunk = MaterializedChunk<T>{};
+  materialized_chunk.values.reserve(segment.size());
+  materialized_chunk.chunk_offsets.reserve(segment.size());
+
+  segment_iterate<T>(segment, [&](const auto& position) {
+    if (position.is_null()) {
+      return;
+    }
+    materialized_chunk.values.emplace_back(position.value());
+    materialized_chunk.chunk_offsets.emplace_back(position.chunk_offset());
+  });
+
+  return materialized_chunk;
+}
+
+// Compares the values of two materialized chunks block by block, so that a block of the right chunk stays in the cache
+// while it is compared with all values of a block of the left chunk. For each left value, the primary predicate is
+// first evaluated for the entire right block without branches, which allows the compiler to vectorize the loop.
+template <typename BinaryFunctor, typename T>
+void __attribute__((noinline))
+join_materialized_chunks(const BinaryFunctor& func, const MaterializedChunk<T>& left, const MaterializedChunk<T>& right,
+                         const ChunkID chunk_id_left, const ChunkID chunk_id_right,
+                         const JoinNestedLoop::JoinParams& params) {
+  constexpr auto BLOCK_SIZE = JoinNestedLoop::BLOCK_SIZE;
+
+  // Semi and anti joins only need to know whether a left row has a match. Once it has one, it is not compared again.
+  const auto skip_matched_left_rows = !params.write_pos_lists;
+
+  auto matches = std::array<uint8_t, BLOCK_SIZE>{};
+
+  const auto left_size = left.values.size();
+  const auto right_size = right.values.size();
+  for (auto left_block_begin = size_t{0}; left_block_begin < left_size; left_block_begin += BLOCK_SIZE) {
+    const auto left_block_end = std::min(left_block_begin + BLOCK_SIZE, left_size);
+
+    for (auto right_block_begin = size_t{0}; right_block_begin < right_size; right_block_begin += BLOCK_SIZE) {
+      const auto right_block_size = std::min(BLOCK_SIZE, right_size - right_block_begin);
+      const auto* const right_values = right.values.data() + right_block_begin;
+
+      for (auto left_idx = left_block_begin; left_idx < left_block_end; ++left_idx) {
+        const auto left_chunk_offset = left.chunk_offsets[left_idx];
+        if (skip_matched_left_rows && params.left_matches[left_chunk_offset]) {
+          continue;
+        }
+
+        const auto left_value = left.values[left_idx];
+        auto match_count = size_t{0};
+        for (auto right_idx = size_t{0}; right_idx < right_block_size; ++right_idx) {
+          const auto match = static_cast<uint8_t>(func(left_value, right_values[right_idx]));
+          matches[right_idx] = match;
+          match_count += match;
+        }
+
+        if (match_count == 0) {
+          continue;
+        }
+
+        const auto left_row_id = RowID{chunk_id_left, left_chunk_offset};
+        for (auto right_idx = size_t{0}; right_idx < right_block_size; ++right_idx) {
+          if (!matches[right_idx]) {
+            continue;
+          }
+
+          const auto right_row_id = RowID{chunk_id_right, right.chunk_offsets[right_block_begin + right_idx]};
+          if (params.secondary_predicate_evaluator.satisfies_all_predicates(left_row_id, right_row_id)) {
+            process_match(left_row_id, right_row_id, params);
+            if (skip_matched_left_rows) {
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Blocked nested loop join of two columns of the same arithmetic data type. NULLs never match, so the join must not be
+// a full outer join (which would need to track the matches of the right input) or an AntiNullAsTrue join. The matches
+// of each left chunk are written to the pos lists of that chunk.
+template <typename T>
+void join_blocked(const Table& left_table, const ColumnID left_column_id, const Table& right_table,
+                  const ColumnID right_column_id, const PredicateCondition predicate_condition, const JoinMode mode,
+                  const std::vector<OperatorJoinPredicate>& secondary_predicates,
+                  std::vector<RowIDPosList>& pos_lists_left, std::vector<RowIDPosList>& pos_lists_right,
+                  std::vector<std::vector<bool>>& left_matches_by_chunk) {
+  DebugAssert(mode != JoinMode::FullOuter && mode != JoinMode::AntiNullAsTrue,
+              "Blocked nested loop join does not support this join mode");
+
+  const auto is_outer_join = mode == JoinMode::Left || mode == JoinMode::Right;
+  const auto is_semi_or_anti_join = mode == JoinMode::Semi || mode == JoinMode::AntiNullAsFalse;
+  const auto track_left_matches = is_outer_join || is_semi_or_anti_join;
+
+  // The right input is compared with every left chunk, so it is materialized once upfront
+  const auto chunk_count_right = right_table.chunk_count();
+  auto materialized_right_chunks = std::vector<MaterializedChunk<T>>(chunk_count_right);
+  for (auto chunk_id_right = ChunkID{0}; chunk_id_right < chunk_count_right; ++chunk_id_right) {
+    const auto chunk_right = right_table.get_chunk(chunk_id_right);
+    Assert(chunk_right, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    materialized_right_chunks[chunk_id_right] = materialize_chunk<T>(*chunk_right->get_segment(right_column_id));
+  }
+
+  const auto right_row_count = static_cast<size_t>(right_table.row_count());
+
+  const auto chunk_count_left = left_table.chunk_count();
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto chunk_id_left = ChunkID{0}; chunk_id_left < chunk_count_left; ++chunk_id_left) {
+    const auto chunk_left = left_table.get_chunk(chunk_id_left);
+    Assert(chunk_left, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    const auto join_left_chunk = [&, chunk_id_left, chunk_left]() {
+      const auto materialized_left_chunk = materialize_chunk<T>(*chunk_left->get_segment(left_column_id));
+
+      auto& pos_list_left = pos_lists_left[chunk_id_left];
+      auto& pos_list_right = pos_lists_right[chunk_id_left];
+      auto& left_matches = left_matches_by_chunk[chunk_id_left];
+      if (track_left_matches) {
+        left_matches.resize(chunk_left->size());
+      }
+
+      // Only needed to construct the JoinParams, as the matches of the right input are not tracked
+      auto right_matches = std::vector<bool>{};
+
+      // Accessors are not thread-safe, so we create one evaluator per job
+      auto secondary_predicate_evaluator =
+          MultiPredicateJoinEvaluator{left_table, right_table, mode, secondary_predicates};
+
+      with_comparator(predicate_condition, [&](auto comparator) {
+        for (auto chunk_id_right = ChunkID{0}; chunk_id_right < chunk_count_right; ++chunk_id_right) {
+          JoinNestedLoop::JoinParams params{pos_list_left,
+                                            pos_list_right,
+                                            left_matches,
+                                            right_matches,
+                                            track_left_matches,
+                                            false,
+                                            mode,
+                                            predicate_condition,
+                                            secondary_predicate_evaluator,
+                                            !is_semi_or_anti_join};
+          join_materialized_chunks(comparator, materialized_left_chunk, materialized_right_chunks[chunk_id_right],
+                                   chunk_id_left, chunk_id_right, params);
+        }
+      });
+
+      if (is_outer_join) {
+        // Add unmatched rows on the left for Left (and swapped Right) outer joins
+        const auto chunk_size = chunk_left->size();
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+          if (!left_matches[chunk_offset]) {
+            pos_list_left.emplace_back(RowID{chunk_id_left, chunk_offset});
+            pos_list_right.emplace_back(NULL_ROW_ID);
+          }
+        }
+      }
+    };
+
+    if (static_cast<size_t>(chunk_left->size()) * right_row_count > JoinNestedLoop::JOB_SPAWN_THRESHOLD) {
+      jobs.emplace_back(std::make_shared<JobTask>(join_left_chunk));
+    } else {
+      join_left_chunk();
+    }
+  }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+}
+
+// A row of an input of the IEJoin with the values of both join columns
+template <typename X, typename Y>
+struct IEJoinRow {
+  X x;
+  Y y;
+  RowID row_id;
+};
+
+// Materializes the rows in which neither join column is NULL. Rows with NaN values are skipped as well, as they do not
+// satisfy any inequality predicate.
+template <typename X, typename Y>
+std::vector<IEJoinRow<X, Y>> materialize_ie_join_rows(const Table& table, const ColumnID x_column_id,
+                                                      const ColumnID y_column_id) {
+  auto rows = std::vector<IEJoinRow<X, Y>>{};
+  rows.reserve(table.row_count());
+
+  auto x_values = std::vector<std::optional<X>>{};
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    x_values.assign(chunk->size(), std::nullopt);
+    segment_iterate<X>(*chunk->get_segment(x_column_id), [&](const auto& position) {
+      if (position.is_null()) {
+        return;
+      }
+      if constexpr (std::is_floating_point_v<X>) {
+        if (std::isnan(position.value())) {
+          return;
+        }
+      }
+      x_values[position.chunk_offset()] = position.value();
+    });
+
+    segment_iterate<Y>(*chunk->get_segment(y_column_id), [&](const auto& position) {
+      const auto& x_value = x_values[position.chunk_offset()];
+      if (position.is_null() || !x_value) {
+        return;
+      }
+      if constexpr (std::is_floating_point_v<Y>) {
+        if (std::isnan(position.value())) {
+          return;
+        }
+      }
+      rows.emplace_back(IEJoinRow<X, Y>{*x_value, position.value(), RowID{chunk_id, position.chunk_offset()}});
+    });
+  }
+
+  return rows;
+}
+
+/**
+ * Inner join with two inequality predicates `left.x θ1 right.x AND left.y θ2 right.y`, inspired by IEJoin (Khayyat et
+ * al., "Lightning Fast and Space Efficient Inequality Joins", VLDB 2015). Instead of comparing all pairs of rows, the
+ * left rows are visited in the order of x so that the set of right rows that satisfy the first predicate only grows.
+ * These right rows are marked in a bit vector that is ordered by y. The right rows that satisfy the second predicate
+ * form a contiguous range in this bit vector, so the matches of a left row are found by scanning that range.
+ */
+template <typename X, typename Y>
+void ie_join(const Table& left_table, const Table& right_table, const OperatorJoinPredicate& x_predicate,
+             const OperatorJoinPredicate& y_predicate, RowIDPosList& pos_list_left, RowIDPosList& pos_list_right) {
+  auto left_rows = materialize_ie_join_rows<X, Y>(left_table, x_predicate.column_ids.first,
+                                                  y_predicate.column_ids.first);
+  auto right_rows = materialize_ie_join_rows<X, Y>(right_table, x_predicate.column_ids.second,
+                                                   y_predicate.column_ids.second);
+
+  // The position of a right row in right_rows is its bit in the bit vector
+  std::sort(right_rows.begin(), right_rows.end(), [](const auto& lhs, const auto& rhs) { return lhs.y < rhs.y; });
+  const auto right_row_count = right_rows.size();
+
+  // For `left.x < right.x` (or <=), the right rows that satisfy the first predicate for a left row also satisfy it for
+  // all left rows with a smaller x. Thus, both inputs are visited in descending order of x. For > and >=, they are
+  // visited in ascending order.
+  const auto x_condition = x_predicate.predicate_condition;
+  const auto descending = x_condition == PredicateCondition::LessThan ||
+                          x_condition == PredicateCondition::LessThanEquals;
+  const auto x_order = [descending](const auto& lhs, const auto& rhs) { return descending ? lhs > rhs : lhs < rhs; };
+
+  std::sort(left_rows.begin(), left_rows.end(),
+            [&](const auto& lhs, const auto& rhs) { return x_order(lhs.x, rhs.x); });
+
+  auto right_rows_by_x = std::vector<size_t>(right_row_count);
+  std::iota(right_rows_by_x.begin(), right_rows_by_x.end(), size_t{0});
+  std::sort(right_rows_by_x.begin(), right_rows_by_x.end(),
+            [&](const auto lhs, const auto rhs) { return x_order(right_rows[lhs].x, right_rows[rhs].x); });
+
+  auto bit_vector = std::vector<uint64_t>((right_row_count + 63) / 64);
+  auto next_right_row = size_t{0};
+
+  with_comparator(x_condition, [&](auto x_comparator) {
+    for (const auto& left_row : left_rows) {
+      while (next_right_row < right_row_count &&
+             x_comparator(left_row.x, right_rows[right_rows_by_x[next_right_row]].x)) {
+        const auto bit = right_rows_by_x[next_right_row];
+        bit_vector[bit / 64] |= uint64_t{1} << (bit % 64);
+        ++next_right_row;
+      }
+
+      // Determine the range of right rows (ordered by y) that satisfy the second predicate
+      const auto lower_bound = static_cast<size_t>(
+          std::lower_bound(right_rows.begin(), right_rows.end(), left_row.y,
+                           [](const auto& right_row, const auto& value) { return right_row.y < value; }) -
+          right_rows.begin());
+      const auto upper_bound = static_cast<size_t>(
+          std::upper_bound(right_rows.begin(), right_rows.end(), left_row.y,
+                           [](const auto& value, const auto& right_row) { return value < right_row.y; }) -
+          right_rows.begin());
+
+      auto begin = size_t{0};
+      auto end = right_row_count;
+      switch (y_predicate.predicate_condition) {
+        case PredicateCondition::LessThan:
+          begin = upper_bound;
+          break;
+        case PredicateCondition::LessThanEquals:
+          begin = lower_bound;
+          break;
+        case PredicateCondition::GreaterThan:
+          end = lower_bound;
+          break;
+        case PredicateCondition::GreaterThanEquals:
+          end = upper_bound;
+          break;
+        default:
+          Fail("Unsupported predicate condition for IEJoin");
+      }
+
+      // Scan the range word by word and emit the set bits
+      for (auto word_idx = begin / 64; word_idx * 64 < end; ++word_idx) {
+        auto word = bit_vector[word_idx];
+        if (word_idx == begin / 64) {
+          word &= ~uint64_t{0} << (begin % 64);
+        }
+        if ((word_idx + 1) * 64 > end) {
+          word &= ~uint64_t{0} >> ((word_idx + 1) * 64 - end);
+        }
+
+        while (word) {
+          const auto bit = word_idx * 64 + static_cast<size_t>(__builtin_ctzll(word));
+          pos_list_left.emplace_back(left_row.row_id);
+          pos_list_right.emplace_back(right_rows[bit].row_id);
+          word &= word - 1;
+        }
+      }
+    }
+  });
+}
+
+bool is_inequality(const PredicateCondition predicate_condition) {
+  return predicate_condition == PredicateCondition::LessThan ||
+         predicate_condition == PredicateCondition::LessThanEquals ||
+         predicate_condition == PredicateCondition::GreaterThan ||
+         predicate_condition == PredicateCondition::GreaterThanEquals;
+}
 }  // namespace
 
 namespace opossum {
@@ -148,53 +485,110 @@ std::shared_ptr<const Table> JoinNestedLoop::_on_execute() {
     right_matches_by_chunk[chunk_id_right].resize(chunk_right->size());
   }
 
-  auto secondary_predicate_evaluator =
-      MultiPredicateJoinEvaluator{*left_table, *right_table, _mode, maybe_flipped_secondary_predicates};
-
-  // Scan all chunks from left input
   const auto chunk_count_left = left_table->chunk_count();
-  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < chunk_count_left; ++chunk_id_left) {
-    const auto chunk_left = left_table->get_chunk(chunk_id_left);
-    Assert(chunk_left, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
-    auto segment_left = chunk_left->get_segment(left_column_id);
+  const auto left_data_type = left_table->column_data_type(left_column_id);
+  const auto right_data_type = right_table->column_data_type(right_column_id);
+  const auto use_blocked_join = left_data_type == right_data_type && left_data_type != DataType::String &&
+                                _mode != JoinMode::FullOuter && _mode != JoinMode::AntiNullAsTrue;
+
+  auto use_ie_join = _mode == JoinMode::Inner && _secondary_predicates.size() == 1 && use_blocked_join &&
+                     is_inequality(_primary_predicate.predicate_condition);
+  if (use_ie_join) {
+    const auto& secondary_predicate = _secondary_predicates.front();
+    const auto secondary_data_type = left_table->column_data_type(secondary_predicate.column_ids.first);
+    use_ie_join = is_inequality(secondary_predicate.predicate_condition) &&
+                  secondary_data_type == right_table->column_data_type(secondary_predicate.column_ids.second) &&
+                  secondary_data_type != DataType::String;
+  }
 
-    std::vector<bool> left_matches;
+  if (use_ie_join) {
+    const auto& secondary_predicate = _secondary_predicates.front();
+    resolve_data_type(left_data_type, [&](const auto x_data_type_t) {
+      using XType = typename decltype(x_data_type_t)::type;
+      resolve_data_type(left_table->column_data_type(secondary_predicate.column_ids.first), [&](const auto y_type_t) {
+        using YType = typename decltype(y_type_t)::type;
+        if constexpr (!std::is_same_v<XType, pmr_string> && !std::is_same_v<YType, pmr_string>) {
+          ie_join<XType, YType>(*left_table, *right_table, _primary_predicate, secondary_predicate, *pos_list_left,
+                                *pos_list_right);
+        }
+      });
+    });
+  } else if (use_blocked_join) {
+    auto pos_lists_left = std::vector<RowIDPosList>(chunk_count_left);
+    auto pos_lists_right = std::vector<RowIDPosList>(chunk_count_left);
 
-    if (track_left_matches) {
-      left_matches.resize(segment_left->size());
+    resolve_data_type(left_data_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      if constexpr (!std::is_same_v<ColumnDataType, pmr_string>) {
+        join_blocked<ColumnDataType>(*left_table, left_column_id, *right_table, right_column_id,
+                                     maybe_flipped_predicate_condition, _mode, maybe_flipped_secondary_predicates,
+                                     pos_lists_left, pos_lists_right, left_matches_by_chunk);
+      }
+    });
+
+    // Concatenate the matches in the order of the left chunks
+    auto match_count = size_t{0};
+    for (const auto& pos_list : pos_lists_left) {
+      match_count += pos_list.size();
     }
+    pos_list_left->reserve(match_count);
+    pos_list_right->reserve(match_count);
+    for (auto chunk_id_left = ChunkID{0}; chunk_id_left < chunk_count_left; ++chunk_id_left) {
+      pos_list_left->insert(pos_list_left->end(), pos_lists_left[chunk_id_left].begin(),
+                            pos_lists_left[chunk_id_left].end());
+      pos_list_right->insert(pos_list_right->end(), pos_lists_right[chunk_id_left].begin(),
+                             pos_lists_right[chunk_id_left].end());
+    }
+  } else {
+    auto secondary_predicate_evaluator =
+        MultiPredicateJoinEvaluator{*left_table, *right_table, _mode, maybe_flipped_secondary_predicates};
 
-    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < chunk_count_right; ++chunk_id_right) {
-      const auto chunk_right = right_table->get_chunk(chunk_id_right);
-      Assert(chunk_right, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+    // Scan all chunks from left input
+    for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < chunk_count_left; ++chunk_id_left) {
+      const auto chunk_left = left_table->get_chunk(chunk_id_left);
+      Assert(chunk_left, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
-      const auto segment_right = chunk_right->get_segment(right_column_id);
-
-      JoinParams params{*pos_list_left,
-                        *pos_list_right,
-                        left_matches,
-                        right_matches_by_chunk[chunk_id_right],
-                        track_left_matches,
-                        track_right_matches,
-                        _mode,
-                        maybe_flipped_predicate_condition,
-                        secondary_predicate_evaluator,
-                        !is_semi_or_anti_join};
-      _join_two_untyped_segments(*segment_left, *segment_right, chunk_id_left, chunk_id_right, params);
-    }
+      auto segment_left = chunk_left->get_segment(left_column_id);
+
+      std::vector<bool> left_matches;
+
+      if (track_left_matches) {
+        left_matches.resize(segment_left->size());
+      }
+
+      for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < chunk_count_right; ++chunk_id_right) {
+        const auto chunk_right = right_table->get_chunk(chunk_id_right);
+        Assert(chunk_right, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+        const auto segment_right = chunk_right->get_segment(right_column_id);
+
+        JoinParams params{*pos_list_left,
+                          *pos_list_right,
+                          left_matches,
+                          right_matches_by_chunk[chunk_id_right],
+                          track_left_matches,
+                          track_right_matches,
+                          _mode,
+                          maybe_flipped_predicate_condition,
+                          secondary_predicate_evaluator,
+                          !is_semi_or_anti_join};
+        _join_two_untyped_segments(*segment_left, *segment_right, chunk_id_left, chunk_id_right, params);
+      }
 
-    if (is_outer_join) {
-      // Add unmatched rows on the left for Left and Full Outer joins
-      for (ChunkOffset chunk_offset{0}; chunk_offset < static_cast<ChunkOffset>(left_matches.size()); ++chunk_offset) {
-        if (!left_matches[chunk_offset]) {
-          pos_list_left->emplace_back(RowID{chunk_id_left, chunk_offset});
-          pos_list_right->emplace_back(NULL_ROW_ID);
+      if (is_outer_join) {
+        // Add unmatched rows on the left for Left and Full Outer joins
+        const auto left_matches_size = static_cast<ChunkOffset>(left_matches.size());
+        for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches_size; ++chunk_offset) {
+          if (!left_matches[chunk_offset]) {
+            pos_list_left->emplace_back(RowID{chunk_id_left, chunk_offset});
+            pos_list_right->emplace_back(NULL_ROW_ID);
+          }
         }
       }
-    }
 
-    left_matches_by_chunk[chunk_id_left] = std::move(left_matches);
+      left_matches_by_chunk[chunk_id_left] = std::move(left_matches);
+    }
   }
 
   // For Full Outer we need to add all unmatched rows for the right side.
@@ -15,10 +15,29 @@ namespace opossum {
 
 class JoinIndex;
 
+/**
+ * Joins two tables by comparing all pairs of rows. Supports all join modes and predicate conditions.
+ *
+ * Depending on the join, one of three implementations is used:
+ *   - Inner joins with two inequality predicates on arithmetic columns (e.g., band joins such as
+ *     `a.x BETWEEN b.lower AND b.upper`) are evaluated IEJoin-style. Both inputs are sorted and only the pairs that
+ *     satisfy both predicates are visited.
+ *   - If the primary join columns have the same arithmetic data type, the join columns are materialized into dense
+ *     arrays and compared block-wise (blocked nested loop join). Each chunk of the left input is joined in a separate
+ *     job. Full outer and AntiNullAsTrue joins are not supported by this implementation.
+ *   - Otherwise, the segments are compared pairwise using their iterators.
+ */
 class JoinNestedLoop : public AbstractJoinOperator {
  public:
   static bool supports(const JoinConfiguration config);
 
+  // The blocked nested loop join processes a chunk of the left input in a separate job if the number of comparisons
+  // for that chunk is above JOB_SPAWN_THRESHOLD. If not, the chunk is processed directly.
+  static constexpr auto JOB_SPAWN_THRESHOLD = size_t{100'000};
+
+  // Number of values of each input that are compared block-wise. A block of the right input fits into the L1 cache.
+  static constexpr auto BLOCK_SIZE = size_t{1'024};
+
   JoinNestedLoop(const std::shared_ptr<const AbstractOperator>& left,
                  const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
                  const OperatorJoinPredicate& primary_predicate,
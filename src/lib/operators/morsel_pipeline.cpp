@@ -0,0 +1,413 @@
+#include "morsel_pipeline.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/pos_lists/entire_chunk_pos_list.hpp"
+#include "storage/pos_lists/selection_vector_pos_list.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+using CopiedOperators = std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>;
+
+bool is_pipelineable(const AbstractOperator& op) {
+  if (op.executed()) return false;
+
+  // Operators with subqueries are not pipelined: Uncorrelated subqueries must be executed once and not once per morsel,
+  // correlated subqueries would be copied for every morsel. The same holds for the sources of runtime Bloom filters.
+  switch (op.type()) {
+    case OperatorType::Validate:
+      return true;
+    case OperatorType::TableScan: {
+      const auto& table_scan = static_cast<const TableScan&>(op);
+      return find_pqp_subquery_expressions(table_scan.predicate()).empty() &&
+             !table_scan.runtime_bloom_filter_source();
+    }
+    case OperatorType::Projection: {
+      const auto& expressions = static_cast<const Projection&>(op).expressions;
+      return std::all_of(expressions.begin(), expressions.end(), [](const auto& expression) {
+        return find_pqp_subquery_expressions(expression).empty();
+      });
+    }
+    default:
+      return false;
+  }
+}
+
+std::shared_ptr<AbstractOperator> fuse_pipelines_recursively(const std::shared_ptr<AbstractOperator>& op,
+                                                             CopiedOperators& copied_ops) {
+  const auto copied_ops_iter = copied_ops.find(op.get());
+  if (copied_ops_iter != copied_ops.end()) return copied_ops_iter->second;
+
+  // Collect the longest chain of pipelineable operators that ends with `op`, ordered from top to bottom. All operators
+  // but the topmost one must not have any other consumer.
+  auto chain = std::vector<std::shared_ptr<AbstractOperator>>{};
+  for (auto chain_op = op; chain_op && is_pipelineable(*chain_op) && (chain.empty() || chain_op->consumer_count() == 1);
+       chain_op = chain_op->mutable_left_input()) {
+    chain.emplace_back(chain_op);
+
+    // Excluded chunks refer to the chunks of the scan's input table, which is only known for the bottommost operator.
+    if (chain_op->type() == OperatorType::TableScan && !static_cast<TableScan&>(*chain_op).excluded_chunk_ids.empty()) {
+      break;
+    }
+  }
+
+  // The pipeline turns the input into a reference table. A Projection that operates on a data table would thus produce
+  // a different output, so the chain must start with a TableScan or Validate.
+  while (!chain.empty() && chain.back()->type() == OperatorType::Projection) {
+    chain.pop_back();
+  }
+
+  if (chain.size() < 2) {
+    if (op->left_input()) fuse_pipelines_recursively(op->mutable_left_input(), copied_ops);
+    if (op->right_input()) fuse_pipelines_recursively(op->mutable_right_input(), copied_ops);
+    // The inputs have already been copied, so this only copies `op` and its subqueries
+    return op->deep_copy(copied_ops);
+  }
+
+  const auto& input_operator = chain.back()->mutable_left_input();
+  const auto copied_input_operator = fuse_pipelines_recursively(input_operator, copied_ops);
+
+  // Copy the chain on top of a placeholder input
+  auto operator_copies = CopiedOperators{{input_operator.get(), std::make_shared<TableWrapper>(nullptr)}};
+  chain.front()->deep_copy(operator_copies);
+
+  auto pipeline_operators = std::vector<std::shared_ptr<AbstractOperator>>{};
+  for (auto chain_iter = chain.rbegin(); chain_iter != chain.rend(); ++chain_iter) {
+    pipeline_operators.emplace_back(operator_copies.at(chain_iter->get()));
+  }
+
+  const auto pipeline = std::make_shared<MorselPipeline>(copied_input_operator, pipeline_operators);
+  if (chain.back()->type() == OperatorType::TableScan) {
+    pipeline->excluded_chunk_ids = static_cast<const TableScan&>(*chain.back()).excluded_chunk_ids;
+  }
+  pipeline->lqp_node = op->lqp_node;
+  if (op->transaction_context_is_set()) pipeline->set_transaction_context(op->transaction_context());
+
+  copied_ops.emplace(op.get(), pipeline);
+  return pipeline;
+}
+
+std::shared_ptr<const AbstractPosList> shift_chunk_ids(const std::shared_ptr<const AbstractPosList>& pos_list,
+                                                       const ChunkID::base_type chunk_id_offset) {
+  if (const auto entire_chunk_pos_list = std::dynamic_pointer_cast<const EntireChunkPosList>(pos_list)) {
+    return std::make_shared<EntireChunkPosList>(ChunkID{entire_chunk_pos_list->common_chunk_id() + chunk_id_offset},
+                                                static_cast<ChunkOffset>(entire_chunk_pos_list->size()));
+  }
+
+  if (const auto selection_vector_pos_list = std::dynamic_pointer_cast<const SelectionVectorPosList>(pos_list)) {
+    auto chunk_offsets = selection_vector_pos_list->chunk_offsets();
+    return std::make_shared<SelectionVectorPosList>(
+        ChunkID{selection_vector_pos_list->common_chunk_id() + chunk_id_offset}, std::move(chunk_offsets));
+  }
+
+  const auto pos_list_size = pos_list->size();
+  auto shifted_pos_list = std::make_shared<RowIDPosList>(pos_list_size);
+  for (auto index = size_t{0}; index < pos_list_size; ++index) {
+    const auto row_id = (*pos_list)[index];
+    (*shifted_pos_list)[index] =
+        row_id.is_null() ? row_id : RowID{ChunkID{row_id.chunk_id + chunk_id_offset}, row_id.chunk_offset};
+  }
+  if (pos_list->references_single_chunk()) shifted_pos_list->guarantee_single_chunk();
+  return shifted_pos_list;
+}
+
+/**
+ * Projections that add new columns to a reference table store these columns in an internal table and reference it
+ * (see Projection::_on_execute). As every morsel is projected separately, the ReferenceSegments of a new column point
+ * to a different table for every morsel. Consumers of a reference table (e.g., the joins) expect all segments of a
+ * column to reference the same table, so we concatenate the referenced tables and rewrite the ReferenceSegments.
+ */
+void unify_referenced_tables(std::vector<std::shared_ptr<Chunk>>& chunks) {
+  if (chunks.size() < 2) return;
+
+  const auto column_count = chunks.front()->column_count();
+  auto output_segments_by_chunk = std::vector<Segments>(chunks.size());
+  for (auto chunk_index = size_t{0}; chunk_index < chunks.size(); ++chunk_index) {
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      output_segments_by_chunk[chunk_index].emplace_back(chunks[chunk_index]->get_segment(column_id));
+    }
+  }
+
+  // Columns of the same Projection reference the same sequence of tables and share the concatenated table
+  auto concatenated_tables = std::map<std::vector<std::shared_ptr<const Table>>, std::shared_ptr<const Table>>{};
+  // The shifted PosLists are shared between the columns of a chunk, as are the original ones
+  auto shifted_pos_lists = std::map<std::pair<const AbstractPosList*, ChunkID::base_type>,
+                                    std::shared_ptr<const AbstractPosList>>{};
+  auto any_segment_replaced = false;
+
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    auto referenced_tables = std::vector<std::shared_ptr<const Table>>{};
+    for (const auto& chunk : chunks) {
+      const auto& reference_segment = static_cast<const ReferenceSegment&>(*chunk->get_segment(column_id));
+      referenced_tables.emplace_back(reference_segment.referenced_table());
+    }
+
+    if (std::all_of(referenced_tables.begin(), referenced_tables.end(),
+                    [&](const auto& table) { return table == referenced_tables.front(); })) {
+      continue;
+    }
+
+    // The first ChunkID of each referenced table in the concatenated table
+    auto chunk_id_offsets = std::map<std::shared_ptr<const Table>, ChunkID::base_type>{};
+    auto& concatenated_table = concatenated_tables[referenced_tables];
+    if (!concatenated_table) {
+      auto column_definitions = referenced_tables.front()->column_definitions();
+      auto concatenated_chunks = std::vector<std::shared_ptr<Chunk>>{};
+      for (const auto& table : referenced_tables) {
+        if (chunk_id_offsets.contains(table)) continue;
+        chunk_id_offsets.emplace(table, static_cast<ChunkID::base_type>(concatenated_chunks.size()));
+
+        for (auto referenced_column_id = ColumnID{0}; referenced_column_id < table->column_count();
+             ++referenced_column_id) {
+          if (table->column_is_nullable(referenced_column_id)) {
+            column_definitions[referenced_column_id].nullable = true;
+          }
+        }
+        const auto chunk_count = table->chunk_count();
+        for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+          concatenated_chunks.emplace_back(std::const_pointer_cast<Chunk>(table->get_chunk(chunk_id)));
+        }
+      }
+      concatenated_table = std::make_shared<Table>(column_definitions, TableType::Data, std::move(concatenated_chunks),
+                                                   referenced_tables.front()->uses_mvcc());
+    } else {
+      auto chunk_id_offset = ChunkID::base_type{0};
+      for (const auto& table : referenced_tables) {
+        if (chunk_id_offsets.emplace(table, chunk_id_offset).second) chunk_id_offset += table->chunk_count();
+      }
+    }
+
+    for (auto chunk_index = size_t{0}; chunk_index < chunks.size(); ++chunk_index) {
+      const auto& reference_segment =
+          static_cast<const ReferenceSegment&>(*chunks[chunk_index]->get_segment(column_id));
+      const auto chunk_id_offset = chunk_id_offsets.at(referenced_tables[chunk_index]);
+
+      auto& shifted_pos_list = shifted_pos_lists[{reference_segment.pos_list().get(), chunk_id_offset}];
+      if (!shifted_pos_list) shifted_pos_list = shift_chunk_ids(reference_segment.pos_list(), chunk_id_offset);
+
+      output_segments_by_chunk[chunk_index][column_id] = std::make_shared<ReferenceSegment>(
+          concatenated_table, reference_segment.referenced_column_id(), shifted_pos_list);
+    }
+    any_segment_replaced = true;
+  }
+
+  if (!any_segment_replaced) return;
+
+  for (auto chunk_index = size_t{0}; chunk_index < chunks.size(); ++chunk_index) {
+    auto chunk = std::make_shared<Chunk>(std::move(output_segments_by_chunk[chunk_index]));
+    chunk->finalize();
+    const auto& sorted_by = chunks[chunk_index]->individually_sorted_by();
+    if (!sorted_by.empty()) chunk->set_individually_sorted_by(sorted_by);
+    chunks[chunk_index] = chunk;
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+MorselPipeline::MorselPipeline(const std::shared_ptr<const AbstractOperator>& input_operator,
+                               const std::vector<std::shared_ptr<AbstractOperator>>& operators)
+    : AbstractReadOnlyOperator(OperatorType::MorselPipeline, input_operator), _operators(operators) {
+  Assert(!_operators.empty(), "MorselPipeline requires at least one operator");
+  for (auto operator_index = size_t{1}; operator_index < _operators.size(); ++operator_index) {
+    Assert(_operators[operator_index]->left_input() == _operators[operator_index - 1],
+           "Operators of a MorselPipeline must form a chain");
+  }
+}
+
+const std::string& MorselPipeline::name() const {
+  static const auto name = std::string{"MorselPipeline"};
+  return name;
+}
+
+std::string MorselPipeline::description(DescriptionMode description_mode) const {
+  const auto* const separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+  stream << AbstractOperator::description(description_mode);
+  for (const auto& op : _operators) {
+    stream << separator << "[" << op->description(DescriptionMode::SingleLine) << "]";
+  }
+  return stream.str();
+}
+
+const std::vector<std::shared_ptr<AbstractOperator>>& MorselPipeline::operators() const { return _operators; }
+
+std::shared_ptr<AbstractOperator> MorselPipeline::fuse_pipelines(const std::shared_ptr<AbstractOperator>& pqp) {
+  auto copied_ops = CopiedOperators{};
+  return fuse_pipelines_recursively(pqp, copied_ops);
+}
+
+std::shared_ptr<AbstractOperator> MorselPipeline::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_left_input,
+    const std::shared_ptr<AbstractOperator>& copied_right_input,
+    std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
+  // The operators do not share any subplans with the remaining PQP (see is_pipelineable), so they are copied separately
+  auto operator_copies = CopiedOperators{};
+  _operators.back()->deep_copy(operator_copies);
+
+  auto copied_operators = std::vector<std::shared_ptr<AbstractOperator>>{};
+  for (const auto& op : _operators) {
+    copied_operators.emplace_back(operator_copies.at(op.get()));
+  }
+
+  const auto copied_pipeline = std::make_shared<MorselPipeline>(copied_left_input, copied_operators);
+  copied_pipeline->excluded_chunk_ids = excluded_chunk_ids;
+  return copied_pipeline;
+}
+
+void MorselPipeline::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  _operators.back()->set_parameters(parameters);
+}
+
+void MorselPipeline::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  _operators.back()->set_transaction_context_recursively(transaction_context);
+}
+
+std::shared_ptr<const Table> MorselPipeline::_on_execute() { return _on_execute(nullptr); }
+
+std::shared_ptr<const Table> MorselPipeline::_on_execute(std::shared_ptr<TransactionContext> transaction_context) {
+  const auto input_table = left_input_table();
+
+  const auto excluded_chunk_set = std::unordered_set<ChunkID>{excluded_chunk_ids.cbegin(), excluded_chunk_ids.cend()};
+  auto morsel_chunk_ids = std::vector<ChunkID>{};
+  const auto chunk_count = input_table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (!excluded_chunk_set.contains(chunk_id)) morsel_chunk_ids.emplace_back(chunk_id);
+  }
+
+  auto morsel_outputs = std::vector<std::shared_ptr<const Table>>(morsel_chunk_ids.size());
+  if (morsel_chunk_ids.size() == 1) {
+    const auto morsel = _create_morsel(input_table, morsel_chunk_ids.front());
+    morsel_outputs.front() = _execute_morsel(morsel, transaction_context);
+  } else {
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(morsel_chunk_ids.size());
+    for (auto morsel_index = size_t{0}; morsel_index < morsel_chunk_ids.size(); ++morsel_index) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, morsel_index]() {
+        const auto morsel = _create_morsel(input_table, morsel_chunk_ids[morsel_index]);
+        morsel_outputs[morsel_index] = _execute_morsel(morsel, transaction_context);
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+  }
+
+  // A morsel has no output only if the transaction was aborted while the morsels were executed (e.g., by a conflict of
+  // a concurrently executed Delete). As for any other operator of an aborted transaction, the pipeline has no output
+  // then. Merging the remaining morsels would silently drop their rows.
+  const auto morsel_output_is_missing = [](const auto& morsel_output) { return !morsel_output; };
+  if (std::any_of(morsel_outputs.begin(), morsel_outputs.end(), morsel_output_is_missing)) {
+    Assert(transaction_context && transaction_context->aborted(), "Every morsel must produce an output");
+    return nullptr;
+  }
+
+  if (morsel_outputs.empty()) {
+    // Execute the operators on an empty table to obtain the output's column definitions
+    return _execute_morsel(_create_morsel(input_table, std::nullopt), transaction_context);
+  }
+
+  return _merge_morsel_outputs(morsel_outputs);
+}
+
+std::shared_ptr<const Table> MorselPipeline::_create_morsel(const std::shared_ptr<const Table>& input_table,
+                                                            const std::optional<ChunkID> chunk_id) {
+  auto morsel_chunks = std::vector<std::shared_ptr<Chunk>>{};
+
+  if (chunk_id) {
+    const auto input_chunk = input_table->get_chunk(*chunk_id);
+    Assert(input_chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    const auto column_count = input_table->column_count();
+    auto segments = Segments{};
+    segments.reserve(column_count);
+    if (input_table->type() == TableType::References) {
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        segments.emplace_back(input_chunk->get_segment(column_id));
+      }
+    } else {
+      // Reference the input table so that the operators' output is the same as without pipelining. Iterating over an
+      // EntireChunkPosList decays to iterating over the referenced segment.
+      const auto pos_list = std::make_shared<EntireChunkPosList>(*chunk_id, input_chunk->size());
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        segments.emplace_back(std::make_shared<ReferenceSegment>(input_table, column_id, pos_list));
+      }
+    }
+
+    auto morsel_chunk = std::make_shared<Chunk>(std::move(segments));
+    morsel_chunk->finalize();
+    if (!input_chunk->individually_sorted_by().empty()) {
+      morsel_chunk->set_individually_sorted_by(input_chunk->individually_sorted_by());
+    }
+    morsel_chunks.emplace_back(std::move(morsel_chunk));
+  }
+
+  return std::make_shared<Table>(input_table->column_definitions(), TableType::References, std::move(morsel_chunks));
+}
+
+std::shared_ptr<const Table> MorselPipeline::_execute_morsel(
+    const std::shared_ptr<const Table>& morsel, const std::shared_ptr<TransactionContext>& transaction_context) const {
+  const auto table_wrapper = std::make_shared<TableWrapper>(morsel);
+  auto operator_copies = CopiedOperators{{_operators.front()->left_input().get(), table_wrapper}};
+  _operators.back()->deep_copy(operator_copies);
+
+  table_wrapper->execute();
+  for (const auto& op : _operators) {
+    const auto& morsel_operator = operator_copies.at(op.get());
+    if (transaction_context) morsel_operator->set_transaction_context(transaction_context);
+    // Executing the next operator clears the previous operator's output, so that the morsel's intermediate results are
+    // freed right away.
+    morsel_operator->execute();
+    if (!morsel_operator->executed()) return nullptr;
+  }
+
+  return operator_copies.at(_operators.back().get())->get_output();
+}
+
+std::shared_ptr<const Table> MorselPipeline::_merge_morsel_outputs(
+    const std::vector<std::shared_ptr<const Table>>& morsel_outputs) {
+  const auto& first_output = *morsel_outputs.front();
+  auto column_definitions = first_output.column_definitions();
+
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  for (const auto& morsel_output : morsel_outputs) {
+    DebugAssert(morsel_output->type() == first_output.type(), "Morsels produced tables of different types");
+
+    // Projections determine the nullability of new columns based on the values of the morsel
+    for (auto column_id = ColumnID{0}; column_id < morsel_output->column_count(); ++column_id) {
+      if (morsel_output->column_is_nullable(column_id)) column_definitions[column_id].nullable = true;
+    }
+
+    const auto chunk_count = morsel_output->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      output_chunks.emplace_back(std::const_pointer_cast<Chunk>(morsel_output->get_chunk(chunk_id)));
+    }
+  }
+
+  if (first_output.type() == TableType::References) unify_referenced_tables(output_chunks);
+
+  return std::make_shared<Table>(column_definitions, first_output.type(), std::move(output_chunks),
+                                 first_output.uses_mvcc());
+}
+
+}  // namespace opossum
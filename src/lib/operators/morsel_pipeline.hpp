@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Executes a chain of chunk-local operators (TableScan, Validate, and Projection) morsel by morsel. Instead of having
+ * each operator materialize its complete output before the next one starts, one job takes a single chunk of the input
+ * table (a morsel) through all operators of the chain. Thus, the intermediate PosLists and ReferenceSegments are still
+ * in the worker's caches when they are consumed and can be freed right away.
+ *
+ * For every morsel, the pipeline executes a copy of the operator chain on a reference table that wraps the morsel's
+ * input chunk. Its ReferenceSegments point to the original input table, so the output is equivalent to that of the
+ * operator-at-a-time execution, except for the order of the output chunks, which follows the order of the input
+ * chunks.
+ *
+ * MorselPipelines are not created by the LQPTranslator, but by fuse_pipelines() on an already translated PQP.
+ */
+class MorselPipeline : public AbstractReadOnlyOperator {
+  friend class OperatorsMorselPipelineTest;
+
+ public:
+  /**
+   * @param operators the operator chain, ordered from bottom to top. Each operator's left input is the previous
+   *                  operator. The left input of the first operator is a placeholder that is never executed but
+   *                  replaced with the morsel's input. These operators are not executed themselves.
+   */
+  MorselPipeline(const std::shared_ptr<const AbstractOperator>& input_operator,
+                 const std::vector<std::shared_ptr<AbstractOperator>>& operators);
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+  const std::vector<std::shared_ptr<AbstractOperator>>& operators() const;
+
+  /**
+   * Returns a copy of the given unexecuted PQP in which every chain of at least two pipelineable operators is replaced
+   * by a MorselPipeline. Operators that consume uncorrelated subqueries or whose output is consumed by more than one
+   * operator end a chain.
+   */
+  static std::shared_ptr<AbstractOperator> fuse_pipelines(const std::shared_ptr<AbstractOperator>& pqp);
+
+  // Chunks of the input table that are not processed, see TableScan::excluded_chunk_ids
+  std::vector<ChunkID> excluded_chunk_ids;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute(std::shared_ptr<TransactionContext> transaction_context) override;
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_left_input,
+      const std::shared_ptr<AbstractOperator>& copied_right_input,
+      std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+
+  // Creates a single-chunk reference table for the morsel. If no chunk_id is given, the table is empty.
+  static std::shared_ptr<const Table> _create_morsel(const std::shared_ptr<const Table>& input_table,
+                                                     const std::optional<ChunkID> chunk_id);
+
+  // Executes a copy of the operator chain on the morsel. Returns nullptr if the transaction was aborted.
+  std::shared_ptr<const Table> _execute_morsel(const std::shared_ptr<const Table>& morsel,
+                                               const std::shared_ptr<TransactionContext>& transaction_context) const;
+
+  // Concatenates the chunks of the morsels' results
+  static std::shared_ptr<const Table> _merge_morsel_outputs(
+      const std::vector<std::shared_ptr<const Table>>& morsel_outputs);
+
+  const std::vector<std::shared_ptr<AbstractOperator>> _operators;
+};
+
+}  // namespace opossum
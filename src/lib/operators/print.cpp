@@ -234,6 +234,18 @@ std::string Print::_segment_type(const std::shared_ptr<AbstractSegment>& segment
         segment_type += "LZ4";
         break;
       }
+      case EncodingType::FSST: {
+        segment_type += "FSST";
+        break;
+      }
+      case EncodingType::Delta: {
+        segment_type += "Dlt";
+        break;
+      }
+      case EncodingType::ALP: {
+        segment_type += "ALP";
+        break;
+      }
     }
     if (encoded_segment->compressed_vector_type()) {
       switch (*encoded_segment->compressed_vector_type()) {
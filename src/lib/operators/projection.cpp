@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "expression/evaluation/expression_compiler.hpp"
 #include "expression/evaluation/expression_evaluator.hpp"
 #include "expression/expression_utils.hpp"
 #include "expression/pqp_column_expression.hpp"
@@ -140,6 +141,15 @@ std::shared_ptr<const Table> Projection::_on_execute() {
   const auto expression_count = expressions.size();
   const auto forwarded_pqp_columns = _determine_forwarded_columns(output_table_type);
 
+  // If an ExpressionCompiler is set, newly generated columns are computed by compiled expressions where possible
+  auto compiled_expressions = std::vector<std::shared_ptr<const CompiledExpression>>(expression_count);
+  if (const auto& expression_compiler = Hyrise::get().expression_compiler) {
+    for (auto column_id = ColumnID{0}; column_id < expression_count; ++column_id) {
+      if (forwarded_pqp_columns.contains(expressions[column_id])) continue;
+      compiled_expressions[column_id] = expression_compiler->compile(expressions[column_id]);
+    }
+  }
+
   // NULLability information is either forwarded or collected during the execution of the ExpressionEvaluator. The
   // vector stores atomic bool values. This allows parallel write operation per thread.
   auto column_is_nullable = std::vector<std::atomic_bool>(expressions.size());
@@ -177,7 +187,8 @@ std::shared_ptr<const Table> Projection::_on_execute() {
 
     // Defines the job that performs the evaluation if the columns are newly generated.
     auto perform_projection_evaluation = [this, chunk_id, &uncorrelated_subquery_results, expression_count,
-                                          &output_segments_by_chunk, &column_is_nullable, &forwarded_pqp_columns]() {
+                                          &output_segments_by_chunk, &column_is_nullable, &forwarded_pqp_columns,
+                                          &compiled_expressions]() {
       auto evaluator = ExpressionEvaluator{left_input_table(), chunk_id, uncorrelated_subquery_results};
 
       for (auto column_id = ColumnID{0}; column_id < expression_count; ++column_id) {
@@ -185,7 +196,10 @@ std::shared_ptr<const Table> Projection::_on_execute() {
 
         if (!forwarded_pqp_columns.contains(expression)) {
           // Newly generated column - the expression needs to be evaluated
-          auto output_segment = evaluator.evaluate_expression_to_segment(*expression);
+          const auto& compiled_expression = compiled_expressions[column_id];
+          auto output_segment = compiled_expression
+                                    ? compiled_expression->evaluate_to_segment(*left_input_table(), chunk_id)
+                                    : evaluator.evaluate_expression_to_segment(*expression);
           column_is_nullable[column_id] = column_is_nullable[column_id] || output_segment->is_nullable();
           // Storing the result in output_segments_by_chunk means that the vector for the separate chunks may contain
           // both ReferenceSegments and ValueSegments. We deal with this later.
@@ -195,9 +209,10 @@ std::shared_ptr<const Table> Projection::_on_execute() {
     };
     // Evaluate the expression immediately if it contains less than `JOB_SPAWN_THRESHOLD` rows, otherwise wrap
     // it into a task. The upper bound of the chunk size, which defines if it will be executed in parallel or not,
-    // still needs to be re-evaluated over time to find the value which gives the best performance.
+    // still needs to be re-evaluated over time to find the value which gives the best performance. A single chunk is
+    // evaluated directly (see TableScan).
     constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
-    if (input_chunk->size() >= JOB_SPAWN_THRESHOLD) {
+    if (input_chunk->size() >= JOB_SPAWN_THRESHOLD && chunk_count > 1) {
       auto job_task = std::make_shared<JobTask>(perform_projection_evaluation);
       jobs.push_back(job_task);
     } else {
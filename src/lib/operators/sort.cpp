@@ -1,14 +1,444 @@
 #include "sort.hpp"
 
+#include <cstring>
+
+#include "hyrise.hpp"
+#include "operators/sort_helper/sort_column_comparator.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/segment_iterate.hpp"
+#include "utils/format_bytes.hpp"
+#include "utils/spill_file.hpp"
 #include "utils/timer.hpp"
 
 namespace {
 
 using namespace opossum;  // NOLINT
 
+// Number of leading bytes of a string that are part of its normalized key
+constexpr auto STRING_PREFIX_LENGTH = size_t{8};
+
+// Number of key bytes that are stored in the SortEntry itself
+constexpr auto KEY_PREFIX_WIDTH = sizeof(uint64_t);
+
+// A normalized key encodes the values of a row in the sort columns so that comparing two keys byte-wise (i.e., with
+// memcmp) yields the same result as comparing the rows column by column. Each column is encoded as a NULL byte (0 for
+// NULL, 1 otherwise, so that NULLs come first independent of the sort mode), followed by the value's bytes in an
+// order-preserving big-endian encoding, which is inverted for descending columns.
+//
+// Strings are only encoded with their first STRING_PREFIX_LENGTH bytes. Thus, the encoding ends with the first string
+// column. If two keys are equal, that string column and all following ones are compared on their actual values.
+struct NormalizedKeyLayout {
+  NormalizedKeyLayout(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions) {
+    for (const auto& sort_definition : sort_definitions) {
+      const auto data_type = table.column_data_type(sort_definition.column);
+      resolve_data_type(data_type, [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+        column_offsets.emplace_back(key_width);
+        key_width += 1 + (std::is_same_v<ColumnDataType, pmr_string> ? STRING_PREFIX_LENGTH : sizeof(ColumnDataType));
+      });
+
+      if (data_type == DataType::String) {
+        ends_with_string_prefix = true;
+        break;
+      }
+    }
+  }
+
+  // Offset of each encoded column within a key. Columns following the first string column are not encoded.
+  std::vector<size_t> column_offsets;
+  size_t key_width{0};
+  bool ends_with_string_prefix{false};
+};
+
+// Writes the order-preserving encoding of value to key
+template <typename T>
+void encode_value(const T& value, uint8_t* const key) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    // Remaining bytes are zero, so that shorter strings are ordered first
+    std::memcpy(key, value.data(), std::min(value.size(), STRING_PREFIX_LENGTH));
+  } else {
+    using Bits = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    constexpr auto SIGN_BIT = Bits{1} << (sizeof(T) * 8 - 1);
+
+    auto bits = Bits{};
+    if constexpr (std::is_floating_point_v<T>) {
+      // -0.0 and 0.0 are equal and must not be distinguished, as rows with equal values keep their order
+      const auto normalized_value = value == T{0} ? T{0} : value;
+      std::memcpy(&bits, &normalized_value, sizeof(T));
+      // For negative values, larger magnitudes come first. Positive values come after all negative ones.
+      bits = (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+    } else {
+      bits = static_cast<Bits>(value) ^ SIGN_BIT;
+    }
+
+    for (auto byte_index = size_t{0}; byte_index < sizeof(T); ++byte_index) {
+      key[byte_index] = static_cast<uint8_t>(bits >> ((sizeof(T) - 1 - byte_index) * 8));
+    }
+  }
+}
+
+// A row to be sorted. key_prefix holds the first KEY_PREFIX_WIDTH bytes of its normalized key as a big-endian integer,
+// so that most comparisons do not have to access the full key.
+struct SortEntry {
+  uint64_t key_prefix;
+  RowID row_id;
+};
+
+// The normalized keys and the SortEntries of the rows of the chunks [begin_chunk_id, begin_chunk_id + run_count). The
+// rows of each chunk form a run, which begins at row_begins[chunk_id - begin_chunk_id].
+struct EncodedRows {
+  size_t run_count() const { return row_begins.size() - 1; }
+
+  const uint8_t* key(const RowID& row_id) const {
+    return keys.data() + (row_begins[row_id.chunk_id - begin_chunk_id] + row_id.chunk_offset) * key_width;
+  }
+
+  ChunkID begin_chunk_id{0};
+  size_t key_width{0};
+  std::vector<size_t> row_begins;
+  std::vector<uint8_t> keys;
+  std::vector<SortEntry> entries;
+};
+
+// Encodes the keys of all rows of a chunk. keys and entries point to the chunk's first key and entry.
+void encode_chunk(const Table& table, const ChunkID chunk_id, const std::vector<SortColumnDefinition>& sort_definitions,
+                  const NormalizedKeyLayout& key_layout, uint8_t* const keys, SortEntry* const entries) {
+  const auto& chunk = *table.get_chunk(chunk_id);
+  const auto key_width = key_layout.key_width;
+
+  const auto encoded_column_count = key_layout.column_offsets.size();
+  for (auto sort_definition_id = size_t{0}; sort_definition_id < encoded_column_count; ++sort_definition_id) {
+    const auto& sort_definition = sort_definitions[sort_definition_id];
+    const auto& segment = *chunk.get_segment(sort_definition.column);
+    auto* const column_keys = keys + key_layout.column_offsets[sort_definition_id];
+
+    resolve_data_type(segment.data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      constexpr auto VALUE_WIDTH =
+          std::is_same_v<ColumnDataType, pmr_string> ? STRING_PREFIX_LENGTH : sizeof(ColumnDataType);
+      const auto invert = sort_definition.sort_mode == SortMode::Descending;
+
+      segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+        // NULLs keep the zero-initialized key bytes
+        if (position.is_null()) return;
+
+        auto* const key = column_keys + position.chunk_offset() * key_width;
+        key[0] = 1;
+        encode_value(position.value(), key + 1);
+        if (invert) {
+          for (auto byte_index = size_t{1}; byte_index <= VALUE_WIDTH; ++byte_index) {
+            key[byte_index] = ~key[byte_index];
+          }
+        }
+      });
+    });
+  }
+
+  const auto prefix_width = std::min(key_width, KEY_PREFIX_WIDTH);
+  const auto chunk_size = chunk.size();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    const auto* const key = keys + chunk_offset * key_width;
+    auto key_prefix = uint64_t{0};
+    for (auto byte_index = size_t{0}; byte_index < KEY_PREFIX_WIDTH; ++byte_index) {
+      key_prefix = (key_prefix << 8) | (byte_index < prefix_width ? key[byte_index] : uint8_t{0});
+    }
+    entries[chunk_offset] = SortEntry{key_prefix, RowID{chunk_id, chunk_offset}};
+  }
+}
+
+// Orders rows by their normalized keys, then by the sort columns that are not (fully) part of the keys, and finally by
+// their position in the input table, which makes the sort stable. Not thread-safe (see BaseSortColumnComparator).
+class RowComparator {
+ public:
+  RowComparator(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+                const NormalizedKeyLayout& key_layout)
+      : _key_width{key_layout.key_width},
+        _column_comparators{create_sort_column_comparators(
+            table, sort_definitions, key_layout.column_offsets.size() - (key_layout.ends_with_string_prefix ? 1 : 0))} {
+  }
+
+  // The first equal_key_width bytes of the keys are known to be equal and are not compared
+  bool rows_ordered_before(const uint8_t* const lhs_key, const RowID& lhs_row_id, const uint8_t* const rhs_key,
+                           const RowID& rhs_row_id, const size_t equal_key_width = 0) const {
+    if (_key_width > equal_key_width) {
+      const auto result =
+          std::memcmp(lhs_key + equal_key_width, rhs_key + equal_key_width, _key_width - equal_key_width);
+      if (result != 0) return result < 0;
+    }
+
+    for (const auto& column_comparator : _column_comparators) {
+      const auto result = column_comparator->compare(lhs_row_id, rhs_row_id);
+      if (result != 0) return result < 0;
+    }
+
+    return lhs_row_id < rhs_row_id;
+  }
+
+  bool entries_ordered_before(const EncodedRows& rows, const SortEntry& lhs, const SortEntry& rhs) const {
+    if (lhs.key_prefix != rhs.key_prefix) return lhs.key_prefix < rhs.key_prefix;
+    return rows_ordered_before(rows.key(lhs.row_id), lhs.row_id, rows.key(rhs.row_id), rhs.row_id, KEY_PREFIX_WIDTH);
+  }
+
+ private:
+  const size_t _key_width;
+  const SortColumnComparators _column_comparators;
+};
+
+// Calls function for the chunks [begin_chunk_id, end_chunk_id), spawning a job for each large chunk
+template <typename Function>
+void for_each_chunk(const Table& table, const ChunkID begin_chunk_id, const ChunkID end_chunk_id,
+                    const Function& function) {
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto chunk_id = begin_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+    // As in the TableScan, small chunks are processed directly, as a job would only add scheduling overhead
+    constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+    if (table.get_chunk(chunk_id)->size() >= JOB_SPAWN_THRESHOLD && end_chunk_id - begin_chunk_id > 1) {
+      jobs.emplace_back(std::make_shared<JobTask>([&function, chunk_id]() { function(chunk_id); }));
+    } else {
+      function(chunk_id);
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+}
+
+// Encodes the rows of the chunks [begin_chunk_id, end_chunk_id) in parallel
+EncodedRows encode_rows(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+                        const NormalizedKeyLayout& key_layout, const ChunkID begin_chunk_id,
+                        const ChunkID end_chunk_id) {
+  auto rows = EncodedRows{begin_chunk_id, key_layout.key_width, std::vector<size_t>(end_chunk_id - begin_chunk_id + 1),
+                          {}, {}};
+  for (auto chunk_id = begin_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+    const auto run_id = chunk_id - begin_chunk_id;
+    rows.row_begins[run_id + 1] = rows.row_begins[run_id] + table.get_chunk(chunk_id)->size();
+  }
+
+  const auto row_count = rows.row_begins.back();
+  rows.keys.resize(row_count * key_layout.key_width);
+  rows.entries.resize(row_count);
+
+  for_each_chunk(table, begin_chunk_id, end_chunk_id, [&](const ChunkID chunk_id) {
+    const auto row_begin = rows.row_begins[chunk_id - begin_chunk_id];
+    encode_chunk(table, chunk_id, sort_definitions, key_layout, &rows.keys[row_begin * key_layout.key_width],
+                 &rows.entries[row_begin]);
+  });
+
+  return rows;
+}
+
+// Sorts each run of the encoded rows in parallel
+void sort_runs(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+               const NormalizedKeyLayout& key_layout, EncodedRows& rows) {
+  const auto end_chunk_id = static_cast<ChunkID>(rows.begin_chunk_id + rows.run_count());
+  for_each_chunk(table, rows.begin_chunk_id, end_chunk_id, [&](const ChunkID chunk_id) {
+    const auto comparator = RowComparator{table, sort_definitions, key_layout};
+    const auto run_id = chunk_id - rows.begin_chunk_id;
+    std::sort(rows.entries.begin() + rows.row_begins[run_id], rows.entries.begin() + rows.row_begins[run_id + 1],
+              [&](const auto& lhs, const auto& rhs) { return comparator.entries_ordered_before(rows, lhs, rhs); });
+  });
+}
+
+// Merges the sorted runs of the encoded rows into a single PosList. The output is split into partitions of roughly
+// MERGE_PARTITION_SIZE rows, which are merged in parallel. The partitions are determined by splitters that are sampled
+// from the runs: Each run contributes the entries between the lower bounds of two adjacent splitters to a partition,
+// and the partition is written to the output at the sum of the preceding contributions.
+RowIDPosList merge_runs(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+                        const NormalizedKeyLayout& key_layout, const EncodedRows& rows) {
+  constexpr auto MERGE_PARTITION_SIZE = size_t{Chunk::DEFAULT_SIZE};
+
+  const auto& entries = rows.entries;
+  const auto& run_begins = rows.row_begins;
+  const auto row_count = entries.size();
+  const auto run_count = rows.run_count();
+  const auto partition_count = std::max(row_count / MERGE_PARTITION_SIZE, size_t{1});
+
+  // Choose partition_count - 1 splitters from evenly spaced samples of all runs
+  const auto comparator = RowComparator{table, sort_definitions, key_layout};
+  const auto entry_comparator = [&](const auto& lhs, const auto& rhs) {
+    return comparator.entries_ordered_before(rows, lhs, rhs);
+  };
+
+  auto samples = std::vector<SortEntry>{};
+  if (partition_count > 1) {
+    samples.reserve(run_count * partition_count);
+    for (auto run_id = size_t{0}; run_id < run_count; ++run_id) {
+      const auto run_size = run_begins[run_id + 1] - run_begins[run_id];
+      for (auto sample_id = size_t{0}; sample_id < std::min(partition_count, run_size); ++sample_id) {
+        samples.emplace_back(entries[run_begins[run_id] + (2 * sample_id + 1) * run_size / (2 * partition_count)]);
+      }
+    }
+    std::sort(samples.begin(), samples.end(), entry_comparator);
+  }
+
+  // partition_bounds[partition_id * run_count + run_id] is the begin of the run's contribution to the partition
+  auto partition_bounds = std::vector<size_t>((partition_count + 1) * run_count);
+  for (auto run_id = size_t{0}; run_id < run_count; ++run_id) {
+    partition_bounds[run_id] = run_begins[run_id];
+    partition_bounds[partition_count * run_count + run_id] = run_begins[run_id + 1];
+    for (auto partition_id = size_t{1}; partition_id < partition_count; ++partition_id) {
+      const auto& splitter = samples[partition_id * samples.size() / partition_count];
+      partition_bounds[partition_id * run_count + run_id] = static_cast<size_t>(
+          std::lower_bound(entries.begin() + run_begins[run_id], entries.begin() + run_begins[run_id + 1], splitter,
+                           entry_comparator) -
+          entries.begin());
+    }
+  }
+
+  auto pos_list = RowIDPosList(row_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto output_offset = size_t{0};
+  for (auto partition_id = size_t{0}; partition_id < partition_count; ++partition_id) {
+    // Cursors to the next and the end entry of each run's contribution
+    auto cursors = std::vector<std::pair<size_t, size_t>>{};
+    for (auto run_id = size_t{0}; run_id < run_count; ++run_id) {
+      const auto begin = partition_bounds[partition_id * run_count + run_id];
+      const auto end = partition_bounds[(partition_id + 1) * run_count + run_id];
+      if (begin < end) cursors.emplace_back(begin, end);
+    }
+
+    auto merge_partition = [&, cursors = std::move(cursors), output_offset]() mutable {
+      const auto partition_comparator = RowComparator{table, sort_definitions, key_layout};
+
+      // Min-heap of the cursors, ordered by their next entry
+      const auto cursor_comparator = [&](const auto& lhs, const auto& rhs) {
+        return partition_comparator.entries_ordered_before(rows, entries[rhs.first], entries[lhs.first]);
+      };
+      std::make_heap(cursors.begin(), cursors.end(), cursor_comparator);
+
+      while (!cursors.empty()) {
+        std::pop_heap(cursors.begin(), cursors.end(), cursor_comparator);
+        auto& cursor = cursors.back();
+        pos_list[output_offset++] = entries[cursor.first++].row_id;
+        if (cursor.first == cursor.second) {
+          cursors.pop_back();
+        } else {
+          std::push_heap(cursors.begin(), cursors.end(), cursor_comparator);
+        }
+      }
+    };
+
+    for (auto run_id = size_t{0}; run_id < run_count; ++run_id) {
+      output_offset += partition_bounds[(partition_id + 1) * run_count + run_id] -
+                       partition_bounds[partition_id * run_count + run_id];
+    }
+
+    if (partition_count > 1) {
+      jobs.emplace_back(std::make_shared<JobTask>(merge_partition));
+    } else {
+      merge_partition();
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  return pos_list;
+}
+
+// Size of the buffers used for writing and reading spilled runs
+constexpr auto SPILL_BUFFER_SIZE = size_t{1} << 20;
+
+// Writes the sorted rows to a spill file. Each record consists of the row's normalized key followed by its RowID.
+void spill_run(const EncodedRows& rows, const RowIDPosList& sorted_row_ids, SpillFile& spill_file) {
+  const auto record_width = rows.key_width + sizeof(RowID);
+  const auto records_per_buffer = std::max(SPILL_BUFFER_SIZE / record_width, size_t{1});
+
+  auto buffer = std::vector<uint8_t>(records_per_buffer * record_width);
+  auto buffered_record_count = size_t{0};
+  for (const auto& row_id : sorted_row_ids) {
+    auto* const record = buffer.data() + buffered_record_count * record_width;
+    std::memcpy(record, rows.key(row_id), rows.key_width);
+    std::memcpy(record + rows.key_width, &row_id, sizeof(RowID));
+
+    if (++buffered_record_count == records_per_buffer) {
+      spill_file.write(buffer.data(), buffered_record_count * record_width);
+      buffered_record_count = 0;
+    }
+  }
+  spill_file.write(buffer.data(), buffered_record_count * record_width);
+  spill_file.finish_writing();
+}
+
+// Reads the records of a spilled run (see spill_run) block-wise
+class SpilledRunReader {
+ public:
+  SpilledRunReader(SpillFile& spill_file, const size_t key_width, const size_t records_per_buffer)
+      : _spill_file{spill_file}, _key_width{key_width}, _buffer((key_width + sizeof(RowID)) * records_per_buffer) {
+    _refill();
+  }
+
+  bool has_record() const { return _position < _buffer_end; }
+
+  const uint8_t* key() const { return _buffer.data() + _position; }
+
+  RowID row_id() const {
+    auto row_id = RowID{};
+    std::memcpy(&row_id, _buffer.data() + _position + _key_width, sizeof(RowID));
+    return row_id;
+  }
+
+  void next() {
+    _position += _key_width + sizeof(RowID);
+    if (_position == _buffer_end) _refill();
+  }
+
+ private:
+  void _refill() {
+    _position = 0;
+    _buffer_end = _spill_file.read(_buffer.data(), _buffer.size());
+    DebugAssert(_buffer_end % (_key_width + sizeof(RowID)) == 0, "Spilled run ends with an incomplete record");
+  }
+
+  SpillFile& _spill_file;
+  const size_t _key_width;
+  std::vector<uint8_t> _buffer;
+  size_t _position{0};
+  size_t _buffer_end{0};
+};
+
+// Merges the spilled runs in a streaming fashion. Only one buffer per run is held in memory.
+RowIDPosList merge_spilled_runs(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+                                const NormalizedKeyLayout& key_layout,
+                                std::vector<std::unique_ptr<SpillFile>>& spill_files, const size_t memory_budget) {
+  const auto record_width = key_layout.key_width + sizeof(RowID);
+  const auto records_per_buffer =
+      std::clamp(memory_budget / (spill_files.size() * record_width), size_t{1}, SPILL_BUFFER_SIZE / record_width);
+
+  auto readers = std::vector<SpilledRunReader>{};
+  readers.reserve(spill_files.size());
+  for (auto& spill_file : spill_files) {
+    readers.emplace_back(*spill_file, key_layout.key_width, records_per_buffer);
+  }
+
+  // Min-heap of the readers that have records left, ordered by their next record
+  const auto comparator = RowComparator{table, sort_definitions, key_layout};
+  const auto reader_comparator = [&](const auto lhs, const auto rhs) {
+    return comparator.rows_ordered_before(readers[rhs].key(), readers[rhs].row_id(), readers[lhs].key(),
+                                          readers[lhs].row_id());
+  };
+
+  auto heap = std::vector<size_t>{};
+  for (auto reader_id = size_t{0}; reader_id < readers.size(); ++reader_id) {
+    if (readers[reader_id].has_record()) heap.emplace_back(reader_id);
+  }
+  std::make_heap(heap.begin(), heap.end(), reader_comparator);
+
+  auto pos_list = RowIDPosList{};
+  pos_list.reserve(table.row_count());
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), reader_comparator);
+    auto& reader = readers[heap.back()];
+    pos_list.emplace_back(reader.row_id());
+    reader.next();
+    if (reader.has_record()) {
+      std::push_heap(heap.begin(), heap.end(), reader_comparator);
+    } else {
+      heap.pop_back();
+    }
+  }
+
+  return pos_list;
+}
+
 // Given an unsorted_table and a pos_list that defines the output order, this materializes all columns in the table,
-// creating chunks of output_chunk_size rows at maximum.
+// creating chunks of output_chunk_size rows at maximum. The pos_list may only contain a subset of the rows (see TopK).
 std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<const Table>& unsorted_table,
                                                        RowIDPosList pos_list, const ChunkOffset output_chunk_size) {
   // First, we create a new table as the output
@@ -22,14 +452,14 @@ std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<con
   // Ceiling of integer division
   const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
   const auto output_chunk_count = div_ceil(pos_list.size(), output_chunk_size);
-  Assert(pos_list.size() == unsorted_table->row_count(), "Mismatching size of input table and PosList");
+  Assert(pos_list.size() <= unsorted_table->row_count(), "PosList has more entries than the input table has rows");
 
   // Vector of segments for each chunk
   std::vector<Segments> output_segments_by_chunk(output_chunk_count);
 
   // Materialize column by column, starting a new ValueSegment whenever output_chunk_size is reached
   const auto input_chunk_count = unsorted_table->chunk_count();
-  const auto row_count = unsorted_table->row_count();
+  const auto row_count = pos_list.size();
   for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
     const auto column_data_type = output->column_data_type(column_id);
     const auto column_is_nullable = unsorted_table->column_is_nullable(column_id);
@@ -133,7 +563,8 @@ std::shared_ptr<Table> write_reference_output_table(const std::shared_ptr<const
   // Ceiling of integer division
   const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
   const auto output_chunk_count = div_ceil(input_pos_list.size(), output_chunk_size);
-  Assert(input_pos_list.size() == unsorted_table->row_count(), "Mismatching size of input table and PosList");
+  Assert(input_pos_list.size() <= unsorted_table->row_count(),
+         "PosList has more entries than the input table has rows");
 
   // Vector of segments for each chunk
   auto output_segments_by_chunk = std::vector<Segments>(output_chunk_count, Segments(column_count));
@@ -220,17 +651,21 @@ std::shared_ptr<Table> write_reference_output_table(const std::shared_ptr<const
 namespace opossum {
 
 Sort::Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
-           const ChunkOffset output_chunk_size, const ForceMaterialization force_materialization)
-    : AbstractReadOnlyOperator(OperatorType::Sort, in, nullptr,
-                               std::make_unique<OperatorPerformanceData<OperatorSteps>>()),
+           const ChunkOffset output_chunk_size, const ForceMaterialization force_materialization,
+           const std::optional<size_t> memory_budget)
+    : AbstractReadOnlyOperator(OperatorType::Sort, in, nullptr, std::make_unique<PerformanceData>()),
       _sort_definitions(sort_definitions),
       _output_chunk_size(output_chunk_size),
-      _force_materialization(force_materialization) {
+      _force_materialization(force_materialization),
+      _memory_budget(memory_budget) {
   DebugAssert(!_sort_definitions.empty(), "Expected at least one sort criterion");
+  DebugAssert(!_memory_budget || *_memory_budget > 0, "Memory budget must be positive");
 }
 
 const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
 
+std::optional<size_t> Sort::memory_budget() const { return _memory_budget; }
+
 const std::string& Sort::name() const {
   static const auto name = std::string{"Sort"};
   return name;
@@ -240,67 +675,22 @@ std::shared_ptr<AbstractOperator> Sort::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
-  return std::make_shared<Sort>(copied_left_input, _sort_definitions, _output_chunk_size, _force_materialization);
+  return std::make_shared<Sort>(copied_left_input, _sort_definitions, _output_chunk_size, _force_materialization,
+                                _memory_budget);
 }
 
 void Sort::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
-std::shared_ptr<const Table> Sort::_on_execute() {
-  const auto& input_table = left_input_table();
-
-  for (const auto& column_sort_definition : _sort_definitions) {
-    Assert(column_sort_definition.column != INVALID_COLUMN_ID, "Sort: Invalid column in sort definition");
-    Assert(column_sort_definition.column < input_table->column_count(),
-           "Sort: Column ID is greater than table's column count");
-  }
-
-  if (input_table->row_count() == 0) {
-    if (_force_materialization == ForceMaterialization::Yes && input_table->type() == TableType::References) {
-      return Table::create_dummy_table(input_table->column_definitions());
-    } else {
-      return input_table;
-    }
-  }
-
-  std::shared_ptr<Table> sorted_table;
-
-  // After the first (least significant) sort operation has been completed, this holds the order of the table as it has
-  // been determined so far. This is not a completely proper PosList on the input table as it might point to
-  // ReferenceSegments.
-  auto previously_sorted_pos_list = std::optional<RowIDPosList>{};
-
-  auto total_materialization_time = std::chrono::nanoseconds{};
-  auto total_temporary_result_writing_time = std::chrono::nanoseconds{};
-  auto total_sort_time = std::chrono::nanoseconds{};
-
-  for (auto sort_step = static_cast<int64_t>(_sort_definitions.size() - 1); sort_step >= 0; --sort_step) {
-    const auto& sort_definition = _sort_definitions[sort_step];
-    const auto data_type = input_table->column_data_type(sort_definition.column);
-
-    resolve_data_type(data_type, [&](auto type) {
-      using ColumnDataType = typename decltype(type)::type;
-
-      auto sort_impl = SortImpl<ColumnDataType>(input_table, sort_definition.column, sort_definition.sort_mode);
-      previously_sorted_pos_list = sort_impl.sort(previously_sorted_pos_list);
-
-      total_materialization_time += sort_impl.materialization_time;
-      total_temporary_result_writing_time += sort_impl.temporary_result_writing_time;
-      total_sort_time += sort_impl.sort_time;
-    });
-  }
-
-  auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
-  step_performance_data.set_step_runtime(OperatorSteps::MaterializeSortColumns, total_materialization_time);
-  step_performance_data.set_step_runtime(OperatorSteps::TemporaryResultWriting, total_temporary_result_writing_time);
-  step_performance_data.set_step_runtime(OperatorSteps::Sort, total_sort_time);
-
+std::shared_ptr<Table> Sort::write_output_table(const std::shared_ptr<const Table>& input_table, RowIDPosList pos_list,
+                                                const std::vector<SortColumnDefinition>& sort_definitions,
+                                                const ChunkOffset output_chunk_size,
+                                                const ForceMaterialization force_materialization) {
   // We have to materialize the output (i.e., write ValueSegments) if
   //  (a) it is requested by the user,
   //  (b) a column in the table references multiple tables (see write_reference_output_table for details), or
   //  (c) a column in the table references multiple columns in the same table (which is an unlikely edge case).
   // Cases (b) and (c) can only occur if there is more than one ReferenceSegment in an input chunk.
-  Timer timer;
-  auto must_materialize = _force_materialization == ForceMaterialization::Yes;
+  auto must_materialize = force_materialization == ForceMaterialization::Yes;
   const auto input_chunk_count = input_table->chunk_count();
   if (!must_materialize && input_table->type() == TableType::References && input_chunk_count > 1) {
     const auto input_column_count = input_table->column_count();
@@ -326,15 +716,14 @@ std::shared_ptr<const Table> Sort::_on_execute() {
     }
   }
 
+  auto sorted_table = std::shared_ptr<Table>{};
   if (must_materialize) {
-    sorted_table =
-        write_materialized_output_table(input_table, std::move(*previously_sorted_pos_list), _output_chunk_size);
+    sorted_table = write_materialized_output_table(input_table, std::move(pos_list), output_chunk_size);
   } else {
-    sorted_table =
-        write_reference_output_table(input_table, std::move(*previously_sorted_pos_list), _output_chunk_size);
+    sorted_table = write_reference_output_table(input_table, std::move(pos_list), output_chunk_size);
   }
 
-  const auto& final_sort_definition = _sort_definitions[0];
+  const auto& final_sort_definition = sort_definitions[0];
   // Set the sorted_by attribute of the output's chunks according to the most significant sort operation, which is the
   // column the table was sorted by last.
   const auto output_chunk_count = sorted_table->chunk_count();
@@ -344,127 +733,109 @@ std::shared_ptr<const Table> Sort::_on_execute() {
     output_chunk->set_individually_sorted_by(final_sort_definition);
   }
 
-  step_performance_data.set_step_runtime(OperatorSteps::WriteOutput, timer.lap());
   return sorted_table;
 }
 
-template <typename SortColumnType>
-class Sort::SortImpl {
- public:
-  using RowIDValuePair = std::pair<RowID, SortColumnType>;
-
-  std::chrono::nanoseconds materialization_time{};
-  std::chrono::nanoseconds temporary_result_writing_time{};
-  std::chrono::nanoseconds sort_time{};
-
-  SortImpl(const std::shared_ptr<const Table>& table_in, const ColumnID column_id,
-           const SortMode sort_mode = SortMode::Ascending)
-      : _table_in(table_in), _column_id(column_id), _sort_mode(sort_mode) {
-    const auto row_count = _table_in->row_count();
-    _row_id_value_vector.reserve(row_count);
-    _null_value_rows.reserve(row_count);
-  }
-
-  // Sorts table_in, potentially taking the pre-existing order of previously_sorted_pos_list into account.
-  // Returns a PosList, which can either be used as an input to the next call of sort or for materializing the
-  // output table.
-  RowIDPosList sort(const std::optional<RowIDPosList>& previously_sorted_pos_list) {
-    Timer timer;
-    // 1. Prepare Sort: Creating RowID-value-Structure
-    _materialize_sort_column(previously_sorted_pos_list);
-    materialization_time = timer.lap();
-
-    // 2. After we got our ValueRowID Map we sort the map by the value of the pair
-    const auto sort_with_comparator = [&](auto comparator) {
-      std::stable_sort(_row_id_value_vector.begin(), _row_id_value_vector.end(),
-                       [comparator](RowIDValuePair a, RowIDValuePair b) { return comparator(a.second, b.second); });
-    };
-    if (_sort_mode == SortMode::Ascending) {
-      sort_with_comparator(std::less<>{});
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto& input_table = left_input_table();
+
+  for (const auto& column_sort_definition : _sort_definitions) {
+    Assert(column_sort_definition.column != INVALID_COLUMN_ID, "Sort: Invalid column in sort definition");
+    Assert(column_sort_definition.column < input_table->column_count(),
+           "Sort: Column ID is greater than table's column count");
+  }
+
+  if (input_table->row_count() == 0) {
+    if (_force_materialization == ForceMaterialization::Yes && input_table->type() == TableType::References) {
+      return Table::create_dummy_table(input_table->column_definitions());
     } else {
-      sort_with_comparator(std::greater<>{});
-    }
-    sort_time = timer.lap();
-
-    // 2b. Insert null rows in front of all non-NULL rows
-    if (!_null_value_rows.empty()) {
-      // NULLs come before all values. The SQL standard allows for this to be implementation-defined. We used to have
-      // a NULLS LAST mode, but never used it over multiple years. Different databases have different behaviors, and
-      // storing NULLs first even for descending orders is somewhat uncommon:
-      //   https://docs.mendix.com/refguide/null-ordering-behavior
-      // For Hyrise, we found that storing NULLs first is the method that requires the least amount of code.
-      _row_id_value_vector.insert(_row_id_value_vector.begin(), _null_value_rows.begin(), _null_value_rows.end());
+      return input_table;
     }
+  }
 
-    RowIDPosList pos_list{};
-    pos_list.reserve(_row_id_value_vector.size());
-    for (const auto& [row_id, _] : _row_id_value_vector) {
-      pos_list.emplace_back(row_id);
-    }
-    temporary_result_writing_time = timer.lap();
-    return pos_list;
-  }
-
- protected:
-  // completely materializes the sort column to create a vector of RowID-Value pairs
-  void _materialize_sort_column(const std::optional<RowIDPosList>& previously_sorted_pos_list) {
-    // If there was no PosList passed, this is the first sorting run and we simply fill our values and nulls data
-    // structures from our input table. Otherwise we will materialize according to the PosList which is the result of
-    // the last run.
-    if (previously_sorted_pos_list) {
-      _materialize_column_from_pos_list(*previously_sorted_pos_list);
-    } else {
-      const auto chunk_count = _table_in->chunk_count();
-      for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-        const auto chunk = _table_in->get_chunk(chunk_id);
-        Assert(chunk, "Did not expect deleted chunk here.");  // see https://github.com/hyrise/hyrise/issues/1686
+  auto& sort_performance_data = static_cast<PerformanceData&>(*performance_data);
+  auto encoding_time = std::chrono::nanoseconds{};
+  auto sorting_time = std::chrono::nanoseconds{};
+  auto merging_time = std::chrono::nanoseconds{};
+  auto spilling_time = std::chrono::nanoseconds{};
+  Timer timer;
 
-        auto abstract_segment = chunk->get_segment(_column_id);
+  // Sorts the rows of the chunks [begin_chunk_id, end_chunk_id): First, the sort columns of every row are encoded into
+  // a normalized key. Then, the rows of every chunk, which form one run each, are sorted. Finally, the runs are merged.
+  const auto key_layout = NormalizedKeyLayout{*input_table, _sort_definitions};
+  const auto sort_chunks = [&](const ChunkID begin_chunk_id, const ChunkID end_chunk_id, EncodedRows& rows) {
+    rows = encode_rows(*input_table, _sort_definitions, key_layout, begin_chunk_id, end_chunk_id);
+    encoding_time += timer.lap();
 
-        segment_iterate<SortColumnType>(*abstract_segment, [&](const auto& position) {
-          if (position.is_null()) {
-            _null_value_rows.emplace_back(RowID{chunk_id, position.chunk_offset()}, SortColumnType{});
-          } else {
-            _row_id_value_vector.emplace_back(RowID{chunk_id, position.chunk_offset()}, position.value());
-          }
-        });
-      }
-    }
-  }
+    sort_runs(*input_table, _sort_definitions, key_layout, rows);
+    sorting_time += timer.lap();
 
-  // When there was a preceding sorting run, we materialize by retaining the order of the values in the passed PosList.
-  void _materialize_column_from_pos_list(const RowIDPosList& pos_list) {
-    const auto input_chunk_count = _table_in->chunk_count();
-    auto accessor_by_chunk_id =
-        std::vector<std::unique_ptr<AbstractSegmentAccessor<SortColumnType>>>(input_chunk_count);
-    for (auto input_chunk_id = ChunkID{0}; input_chunk_id < input_chunk_count; ++input_chunk_id) {
-      const auto& abstract_segment = _table_in->get_chunk(input_chunk_id)->get_segment(_column_id);
-      accessor_by_chunk_id[input_chunk_id] = create_segment_accessor<SortColumnType>(abstract_segment);
-    }
+    auto sorted_row_ids = merge_runs(*input_table, _sort_definitions, key_layout, rows);
+    merging_time += timer.lap();
+    return sorted_row_ids;
+  };
+
+  const auto chunk_count = input_table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    Assert(input_table->get_chunk(chunk_id), "Did not expect deleted chunk here.");  // see #1686
+  }
 
-    for (auto row_id : pos_list) {
-      const auto [chunk_id, chunk_offset] = row_id;
+  // Memory needed per row for its key, its SortEntry, and its RowID in the merged output
+  const auto bytes_per_row = key_layout.key_width + sizeof(SortEntry) + sizeof(RowID);
+  auto pos_list = RowIDPosList{};
+  auto rows = EncodedRows{};
 
-      auto& accessor = accessor_by_chunk_id[chunk_id];
-      const auto typed_value = accessor->access(chunk_offset);
-      if (!typed_value) {
-        _null_value_rows.emplace_back(row_id, SortColumnType{});
-      } else {
-        _row_id_value_vector.emplace_back(row_id, typed_value.value());
+  if (!_memory_budget || input_table->row_count() * bytes_per_row <= *_memory_budget) {
+    pos_list = sort_chunks(ChunkID{0}, chunk_count, rows);
+  } else {
+    // External sort: The input chunks are sorted in batches that fit into the memory budget, each of which is written
+    // to a spill file as a sorted run. The spilled runs are then merged. As the output references the input rows, the
+    // final PosList is still held in memory.
+    auto spill_files = std::vector<std::unique_ptr<SpillFile>>{};
+    auto begin_chunk_id = ChunkID{0};
+    while (begin_chunk_id < chunk_count) {
+      auto end_chunk_id = static_cast<ChunkID>(begin_chunk_id + 1);
+      auto batch_row_count = size_t{input_table->get_chunk(begin_chunk_id)->size()};
+      while (end_chunk_id < chunk_count &&
+             (batch_row_count + input_table->get_chunk(end_chunk_id)->size()) * bytes_per_row <= *_memory_budget) {
+        batch_row_count += input_table->get_chunk(end_chunk_id)->size();
+        ++end_chunk_id;
       }
+
+      const auto sorted_row_ids = sort_chunks(begin_chunk_id, end_chunk_id, rows);
+      spill_files.emplace_back(std::make_unique<SpillFile>());
+      spill_run(rows, sorted_row_ids, *spill_files.back());
+      sort_performance_data.spilled_bytes += spill_files.back()->size();
+      spilling_time += timer.lap();
+
+      begin_chunk_id = end_chunk_id;
     }
+    rows = EncodedRows{};
+
+    sort_performance_data.spilled_run_count = spill_files.size();
+    pos_list = merge_spilled_runs(*input_table, _sort_definitions, key_layout, spill_files, *_memory_budget);
+    merging_time += timer.lap();
   }
 
-  const std::shared_ptr<const Table> _table_in;
+  sort_performance_data.set_step_runtime(OperatorSteps::MaterializeSortColumns, encoding_time);
+  sort_performance_data.set_step_runtime(OperatorSteps::Sort, sorting_time);
+  sort_performance_data.set_step_runtime(OperatorSteps::Merge, merging_time);
+  sort_performance_data.set_step_runtime(OperatorSteps::SpillRuns, spilling_time);
 
-  // column to sort by
-  const ColumnID _column_id;
-  const SortMode _sort_mode;
+  const auto sorted_table = write_output_table(input_table, std::move(pos_list), _sort_definitions,
+                                               _output_chunk_size, _force_materialization);
+  sort_performance_data.set_step_runtime(OperatorSteps::WriteOutput, timer.lap());
 
-  std::vector<RowIDValuePair> _row_id_value_vector;
+  return sorted_table;
+}
 
-  // Stored as RowIDValuePair for better type compatibility even if value is unused
-  std::vector<RowIDValuePair> _null_value_rows;
-};
+void Sort::PerformanceData::output_to_stream(std::ostream& stream, DescriptionMode description_mode) const {
+  OperatorPerformanceData<OperatorSteps>::output_to_stream(stream, description_mode);
+
+  if (spilled_run_count > 0) {
+    stream << (description_mode == DescriptionMode::SingleLine ? " " : "\n") << "Spilled " << spilled_run_count
+           << " sorted run" << (spilled_run_count > 1 ? "s" : "") << " (" << format_bytes(spilled_bytes) << ").";
+  }
+}
 
 }  // namespace opossum
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,21 +19,49 @@ namespace opossum {
  * Operator to sort a table by one or multiple columns. This implements a stable sort, i.e., rows that share the same
  * value will maintain their relative order.
  * By passing multiple sort column definitions it is possible to sort multiple columns with one operator run.
+ *
+ * All sort columns of a row are encoded into a single normalized key that can be compared byte-wise (see sort.cpp).
+ * The rows of each input chunk are sorted in parallel jobs, and the sorted chunks are then merged in parallel by
+ * splitting the output into independent partitions. If a memory budget is given and the input does not fit into it,
+ * the chunks are sorted in batches that are spilled to disk and merged in a streaming fashion (external sort).
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
   enum class ForceMaterialization : bool { Yes = true, No = false };
 
-  enum class OperatorSteps : uint8_t { MaterializeSortColumns, Sort, TemporaryResultWriting, WriteOutput };
+  enum class OperatorSteps : uint8_t { MaterializeSortColumns, Sort, Merge, SpillRuns, WriteOutput };
 
+  struct PerformanceData : public OperatorPerformanceData<OperatorSteps> {
+    void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override;
+
+    size_t spilled_run_count{0};
+    size_t spilled_bytes{0};
+  };
+
+  // memory_budget limits the memory used for sorting (in bytes, not including the input and the output table). If
+  // the rows' normalized keys exceed it, sorted runs are spilled to temporary files and merged from there.
   Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
        const ChunkOffset output_chunk_size = Chunk::DEFAULT_SIZE,
-       const ForceMaterialization force_materialization = ForceMaterialization::No);
+       const ForceMaterialization force_materialization = ForceMaterialization::No,
+       const std::optional<size_t> memory_budget = std::nullopt);
 
   const std::vector<SortColumnDefinition>& sort_definitions() const;
 
+  std::optional<size_t> memory_budget() const;
+
   const std::string& name() const override;
 
+  /**
+   * Writes the rows of input_table in the order given by pos_list, which references input_table and may only contain
+   * a subset of its rows, into chunks of output_chunk_size rows. The chunks are marked as sorted by the first sort
+   * definition. If possible, the output is a reference table, otherwise it is materialized. Also used by TopK.
+   */
+  static std::shared_ptr<Table> write_output_table(const std::shared_ptr<const Table>& input_table,
+                                                   RowIDPosList pos_list,
+                                                   const std::vector<SortColumnDefinition>& sort_definitions,
+                                                   const ChunkOffset output_chunk_size,
+                                                   const ForceMaterialization force_materialization);
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
   std::shared_ptr<AbstractOperator> _on_deep_copy(
@@ -41,15 +70,10 @@ class Sort : public AbstractReadOnlyOperator {
       std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
-  template <typename SortColumnType>
-  class SortImpl;
-
-  template <typename SortColumnType>
-  class SortImplMaterializeOutput;
-
   const std::vector<SortColumnDefinition> _sort_definitions;
   const ChunkOffset _output_chunk_size;
   const ForceMaterialization _force_materialization;
+  const std::optional<size_t> _memory_budget;
 };
 
 }  // namespace opossum
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Compares two rows of a table by a single sort column, ordering NULLs before all values independent of the sort mode
+ * (see Sort). Used by Sort and TopK for the sort columns that are not compared on materialized values.
+ *
+ * compare() returns a negative value, zero, or a positive value if the row lhs is ordered before, equal to, or after
+ * the row rhs. Segment accessors are created lazily for the accessed chunks, so comparators are not thread-safe and
+ * every job has to create its own ones.
+ */
+class BaseSortColumnComparator {
+ public:
+  virtual ~BaseSortColumnComparator() = default;
+  virtual int compare(const RowID& lhs, const RowID& rhs) const = 0;
+};
+
+template <typename T>
+class SortColumnComparator : public BaseSortColumnComparator {
+ public:
+  SortColumnComparator(const Table& table, const SortColumnDefinition& sort_definition)
+      : _table{table}, _sort_definition{sort_definition}, _accessors(table.chunk_count()) {}
+
+  int compare(const RowID& lhs, const RowID& rhs) const final {
+    const auto lhs_value = _accessor(lhs.chunk_id).access(lhs.chunk_offset);
+    const auto rhs_value = _accessor(rhs.chunk_id).access(rhs.chunk_offset);
+    if (!lhs_value || !rhs_value) {
+      return static_cast<int>(lhs_value.has_value()) - static_cast<int>(rhs_value.has_value());
+    }
+    if (*lhs_value == *rhs_value) return 0;
+    return (*lhs_value < *rhs_value) == (_sort_definition.sort_mode == SortMode::Ascending) ? -1 : 1;
+  }
+
+ private:
+  AbstractSegmentAccessor<T>& _accessor(const ChunkID chunk_id) const {
+    auto& accessor = _accessors[chunk_id];
+    if (!accessor) {
+      accessor = create_segment_accessor<T>(_table.get_chunk(chunk_id)->get_segment(_sort_definition.column));
+    }
+    return *accessor;
+  }
+
+  const Table& _table;
+  const SortColumnDefinition _sort_definition;
+  mutable std::vector<std::unique_ptr<AbstractSegmentAccessor<T>>> _accessors;
+};
+
+using SortColumnComparators = std::vector<std::unique_ptr<BaseSortColumnComparator>>;
+
+// Creates comparators for the sort definitions in [first_sort_definition_id, sort_definitions.size())
+inline SortColumnComparators create_sort_column_comparators(const Table& table,
+                                                            const std::vector<SortColumnDefinition>& sort_definitions,
+                                                            const size_t first_sort_definition_id) {
+  auto comparators = SortColumnComparators{};
+  for (auto sort_definition_id = first_sort_definition_id; sort_definition_id < sort_definitions.size();
+       ++sort_definition_id) {
+    const auto& sort_definition = sort_definitions[sort_definition_id];
+    resolve_data_type(table.column_data_type(sort_definition.column), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      comparators.emplace_back(std::make_unique<SortColumnComparator<ColumnDataType>>(table, sort_definition));
+    });
+  }
+  return comparators;
+}
+
+}  // namespace opossum
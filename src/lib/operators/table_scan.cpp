@@ -1,5 +1,6 @@
 #include "table_scan.hpp"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -21,12 +22,17 @@
 #include "expression/value_expression.hpp"
 #include "hyrise.hpp"
 #include "lossless_cast.hpp"
+#include "operators/join_hash/join_hash_steps.hpp"
 #include "operators/operator_scan_predicate.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/chunk.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/pos_lists/selection_vector_pos_list.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
 #include "table_scan/column_between_table_scan_impl.hpp"
 #include "table_scan/column_is_null_table_scan_impl.hpp"
@@ -38,6 +44,29 @@
 #include "utils/lossless_predicate_cast.hpp"
 #include "utils/performance_warning.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Removes the matches whose value in the segment is NULL or not contained in the Bloom filter
+void filter_matches_by_bloom_filter(pmr_vector<ChunkOffset>& matches,
+                                    const std::shared_ptr<const AbstractSegment>& segment,
+                                    const BloomFilter& bloom_filter) {
+  resolve_data_type(segment->data_type(), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto hash_function = std::hash<ColumnDataType>{};
+    const auto accessor = create_segment_accessor<ColumnDataType>(segment);
+    const auto filtered_end = std::remove_if(matches.begin(), matches.end(), [&](const auto chunk_offset) {
+      const auto value = accessor->access(chunk_offset);
+      return !value || !bloom_filter.contains(hash_function(*value));
+    });
+    matches.erase(filtered_end, matches.end());
+  });
+}
+
+}  // namespace
+
 namespace opossum {
 
 TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in,
@@ -64,6 +93,23 @@ TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in,
 
 const std::shared_ptr<AbstractExpression>& TableScan::predicate() const { return _predicate; }
 
+void TableScan::set_runtime_bloom_filter(const std::shared_ptr<AbstractOperator>& source,
+                                         const ColumnID source_column_id, const ColumnID column_id) {
+  Assert(!_runtime_bloom_filter_source, "TableScan already has a runtime Bloom filter.");
+  Assert(!executed(), "Cannot set a runtime Bloom filter after the TableScan has been executed.");
+
+  // Like uncorrelated subqueries, the source is registered as a consumer so that its output is not cleared before the
+  // Bloom filter has been built.
+  source->register_consumer();
+  _runtime_bloom_filter_source = source;
+  _runtime_bloom_filter_source_column_id = source_column_id;
+  _runtime_bloom_filter_column_id = column_id;
+}
+
+const std::shared_ptr<AbstractOperator>& TableScan::runtime_bloom_filter_source() const {
+  return _runtime_bloom_filter_source;
+}
+
 const std::string& TableScan::name() const {
   static const auto name = std::string{"TableScan"};
   return name;
@@ -93,7 +139,13 @@ std::shared_ptr<AbstractOperator> TableScan::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
     std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
-  return std::make_shared<TableScan>(copied_left_input, _predicate->deep_copy(copied_ops));
+  const auto copied_table_scan = std::make_shared<TableScan>(copied_left_input, _predicate->deep_copy(copied_ops));
+  if (_runtime_bloom_filter_source) {
+    copied_table_scan->set_runtime_bloom_filter(_runtime_bloom_filter_source->deep_copy(copied_ops),
+                                                _runtime_bloom_filter_source_column_id,
+                                                _runtime_bloom_filter_column_id);
+  }
+  return copied_table_scan;
 }
 
 std::shared_ptr<const Table> TableScan::_on_execute() {
@@ -102,6 +154,10 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   _impl = create_impl();
   _impl_description = _impl->description();
 
+  const auto runtime_bloom_filter =
+      _runtime_bloom_filter_source ? _build_runtime_bloom_filter(*in_table) : BloomFilter{};
+  auto& scan_performance_data = dynamic_cast<PerformanceData&>(*performance_data);
+
   std::mutex output_mutex;
 
   const auto excluded_chunk_set = std::unordered_set<ChunkID>{excluded_chunk_ids.cbegin(), excluded_chunk_ids.cend()};
@@ -119,18 +175,28 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
     Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
     // chunk_in – Copy by value since copy by reference is not possible due to the limited scope of the for-iteration.
-    auto perform_table_scan = [this, chunk_id, chunk_in, &in_table, &output_mutex, &output_chunks]() {
+    auto perform_table_scan = [this, chunk_id, chunk_in, &in_table, &output_mutex, &output_chunks,
+                               &runtime_bloom_filter, &scan_performance_data]() {
       // The actual scan happens in the sub classes of BaseTableScanImpl
-      const auto matches_out = _impl->scan_chunk(chunk_id);
-      if (matches_out->empty()) return;
+      auto matches_out = _impl->scan_chunk(chunk_id);
+
+      // Drop the matches that will not find a join partner
+      if (!runtime_bloom_filter.empty() && !matches_out.empty()) {
+        const auto match_count = matches_out.size();
+        filter_matches_by_bloom_filter(matches_out, chunk_in->get_segment(_runtime_bloom_filter_column_id),
+                                       runtime_bloom_filter);
+        scan_performance_data.num_rows_pruned_by_runtime_bloom_filter += match_count - matches_out.size();
+      }
+
+      if (matches_out.empty()) return;
 
       Segments out_segments;
       out_segments.reserve(in_table->column_count());
 
       /**
-       * matches_out contains a list of row IDs into this chunk. If this is not a reference table, we can directly use
+       * matches_out contains a list of offsets into this chunk. If this is not a reference table, we can directly use
        * the matches to construct the reference segments of the output. If it is a reference segment, we need to
-       * resolve the row IDs so that they reference the physical data segments (value, dictionary) instead, since we
+       * resolve the offsets so that they reference the physical data segments (value, dictionary) instead, since we
        * don’t allow multi-level referencing. To save time and space, we want to share position lists between segments
        * as much as possible. Position lists can be shared between two segments iff (a) they point to the same table
        * and (b) the reference segments of the input table point to the same positions in the same order (i.e. they
@@ -138,14 +204,15 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
        */
       auto keep_chunk_sort_order = true;
       if (in_table->type() == TableType::References) {
-        if (matches_out->size() == chunk_in->size()) {
+        if (matches_out.size() == chunk_in->size()) {
           // Shortcut - the entire input reference segment matches, so we can simply forward that chunk
           for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
             const auto segment_in = chunk_in->get_segment(column_id);
             out_segments.emplace_back(segment_in);
           }
         } else {
-          auto filtered_pos_lists = std::map<std::shared_ptr<const AbstractPosList>, std::shared_ptr<RowIDPosList>>{};
+          auto filtered_pos_lists =
+              std::map<std::shared_ptr<const AbstractPosList>, std::shared_ptr<const AbstractPosList>>{};
 
           for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
             const auto segment_in = chunk_in->get_segment(column_id);
@@ -161,22 +228,31 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
             auto& filtered_pos_list = filtered_pos_lists[pos_list_in];
 
             if (!filtered_pos_list) {
-              filtered_pos_list = std::make_shared<RowIDPosList>(matches_out->size());
               if (pos_list_in->references_single_chunk()) {
-                filtered_pos_list->guarantee_single_chunk();
+                // All matches reference the same chunk, so only their ChunkOffsets are stored
+                auto chunk_offsets = pmr_vector<ChunkOffset>(matches_out.size());
+                size_t offset = 0;
+                for (const auto match : matches_out) {
+                  chunk_offsets[offset] = (*pos_list_in)[match].chunk_offset;
+                  ++offset;
+                }
+                filtered_pos_list =
+                    std::make_shared<SelectionVectorPosList>(pos_list_in->common_chunk_id(), std::move(chunk_offsets));
               } else {
                 // When segments reference multiple chunks, we do not keep the sort order of the input chunk. The main
                 // reason is that several table scan implementations split the pos lists by chunks (see
                 // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment) and thus shuffle the data. While
                 // this does not affect all scan implementations, we chose the safe and defensive path for now.
                 keep_chunk_sort_order = false;
-              }
 
-              size_t offset = 0;
-              for (const auto& match : *matches_out) {
-                const auto row_id = (*pos_list_in)[match.chunk_offset];
-                (*filtered_pos_list)[offset] = row_id;
-                ++offset;
+                auto row_id_pos_list = std::make_shared<RowIDPosList>(matches_out.size());
+                size_t offset = 0;
+                for (const auto match : matches_out) {
+                  const auto row_id = (*pos_list_in)[match];
+                  (*row_id_pos_list)[offset] = row_id;
+                  ++offset;
+                }
+                filtered_pos_list = row_id_pos_list;
               }
             }
 
@@ -186,13 +262,14 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
           }
         }
       } else {
-        matches_out->guarantee_single_chunk();
-
-        // If the entire chunk is matched, create an EntireChunkPosList instead
-        const auto output_pos_list = matches_out->size() == chunk_in->size()
-                                         ? static_cast<std::shared_ptr<AbstractPosList>>(
-                                               std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size()))
-                                         : static_cast<std::shared_ptr<AbstractPosList>>(matches_out);
+        // If the entire chunk is matched, create an EntireChunkPosList instead. Otherwise, the ChunkOffsets of the
+        // matches are moved into the PosList that is shared by all output segments.
+        auto output_pos_list = std::shared_ptr<AbstractPosList>{};
+        if (matches_out.size() == chunk_in->size()) {
+          output_pos_list = std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size());
+        } else {
+          output_pos_list = std::make_shared<SelectionVectorPosList>(chunk_id, std::move(matches_out));
+        }
 
         for (auto column_id = ColumnID{0u}; column_id < in_table->column_count(); ++column_id) {
           const auto ref_segment_out = std::make_shared<ReferenceSegment>(in_table, column_id, output_pos_list);
@@ -209,9 +286,10 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
       output_chunks.emplace_back(chunk);
     };
     // Spawn job when chunk sufficiently large. The upper bound of the chunk size, still needs to be re-evaluated over
-    // time to find the value which gives the best performance.
+    // time to find the value which gives the best performance. A single chunk (e.g., a morsel of a MorselPipeline) is
+    // scanned directly, as a job would only add scheduling overhead and might move the data to another worker.
     constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
-    if (chunk_in->size() >= JOB_SPAWN_THRESHOLD) {
+    if (chunk_in->size() >= JOB_SPAWN_THRESHOLD && chunk_count - excluded_chunk_set.size() > 1) {
       auto job_task = std::make_shared<JobTask>(perform_table_scan);
       jobs.push_back(job_task);
     } else {
@@ -221,7 +299,6 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
 
   Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
-  auto& scan_performance_data = dynamic_cast<PerformanceData&>(*performance_data);
   scan_performance_data.num_chunks_with_early_out = _impl->num_chunks_with_early_out.load();
   scan_performance_data.num_chunks_with_all_rows_matching = _impl->num_chunks_with_all_rows_matching.load();
   scan_performance_data.num_chunks_with_binary_search = _impl->num_chunks_with_binary_search.load();
@@ -229,6 +306,59 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   return std::make_shared<Table>(in_table->column_definitions(), TableType::References, std::move(output_chunks));
 }
 
+BloomFilter TableScan::_build_runtime_bloom_filter(const Table& in_table) {
+  Assert(_runtime_bloom_filter_source->executed(), "Source of the runtime Bloom filter has not been executed yet.");
+  const auto source_table = _runtime_bloom_filter_source->get_output();
+  auto& scan_performance_data = dynamic_cast<PerformanceData&>(*performance_data);
+
+  auto bloom_filter = BloomFilter{};
+  const auto data_type = in_table.column_data_type(_runtime_bloom_filter_column_id);
+
+  // For columns of different data types (e.g., int and long), the hashes of equal values might differ
+  if (source_table->column_data_type(_runtime_bloom_filter_source_column_id) == data_type) {
+    resolve_data_type(data_type, [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      bloom_filter = BloomFilter{source_table->row_count()};
+      const auto hash_function = std::hash<ColumnDataType>{};
+
+      auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+      const auto chunk_count = source_table->chunk_count();
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto chunk = source_table->get_chunk(chunk_id);
+        if (!chunk) continue;
+
+        auto insert_values = [&, chunk]() {
+          segment_iterate<ColumnDataType>(*chunk->get_segment(_runtime_bloom_filter_source_column_id),
+                                          [&](const auto& position) {
+                                            if (position.is_null()) return;
+                                            bloom_filter.insert(hash_function(position.value()));
+                                          });
+        };
+
+        // Same threshold as for the scan jobs in _on_execute()
+        if (chunk->size() >= ChunkOffset{500} && chunk_count > 1) {
+          jobs.emplace_back(std::make_shared<JobTask>(insert_values));
+        } else {
+          insert_values();
+        }
+      }
+      Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+      scan_performance_data.runtime_bloom_filter_size = bloom_filter.size();
+      scan_performance_data.runtime_bloom_filter_applied =
+          bloom_filter_pass_rate<ColumnDataType, ColumnDataType>(in_table, _runtime_bloom_filter_column_id,
+                                                                 bloom_filter) <= BLOOM_FILTER_MAX_PASS_RATE;
+      if (!scan_performance_data.runtime_bloom_filter_applied) bloom_filter = BloomFilter{};
+    });
+  }
+
+  // The Bloom filter has been built, so the source's output is not needed anymore
+  _runtime_bloom_filter_source->deregister_consumer();
+
+  return bloom_filter;
+}
+
 std::shared_ptr<const AbstractExpression> TableScan::_resolve_uncorrelated_subqueries(
     const std::shared_ptr<const AbstractExpression>& predicate) {
   /**
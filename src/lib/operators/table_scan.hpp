@@ -8,6 +8,7 @@
 #include "abstract_read_only_operator.hpp"
 #include "all_parameter_variant.hpp"
 #include "expression/abstract_expression.hpp"
+#include "join_hash/bloom_filter.hpp"
 #include "table_scan/abstract_table_scan_impl.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -51,11 +52,28 @@ class TableScan : public AbstractReadOnlyOperator {
    */
   std::vector<ChunkID> excluded_chunk_ids;
 
+  /**
+   * Sets a runtime join filter (see JoinHash::push_down_bloom_filters). Before the scan is executed, a Bloom filter is
+   * built from the column `source_column_id` of the output of `source`, which therefore has to be executed first. Rows
+   * whose value in `column_id` is NULL or is not contained in the filter are dropped from the scan's result, unless
+   * a sample of the input shows that most values pass the filter anyway.
+   */
+  void set_runtime_bloom_filter(const std::shared_ptr<AbstractOperator>& source, const ColumnID source_column_id,
+                                const ColumnID column_id);
+
+  // The operator whose output the runtime Bloom filter is built from, nullptr if no filter is set
+  const std::shared_ptr<AbstractOperator>& runtime_bloom_filter_source() const;
+
   struct PerformanceData : public OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps> {
     std::atomic_size_t num_chunks_with_early_out{0};
     std::atomic_size_t num_chunks_with_all_rows_matching{0};
     std::atomic_size_t num_chunks_with_binary_search{0};
 
+    // Size (in bits) of the runtime Bloom filter, 0 if no filter was set
+    size_t runtime_bloom_filter_size{0};
+    bool runtime_bloom_filter_applied{false};
+    std::atomic_size_t num_rows_pruned_by_runtime_bloom_filter{0};
+
     void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override {
       OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps>::output_to_stream(stream, description_mode);
 
@@ -63,6 +81,15 @@ class TableScan : public AbstractReadOnlyOperator {
       stream << separator << "Chunks: " << num_chunks_with_early_out.load() << " skipped with no results, ";
       stream << separator << num_chunks_with_all_rows_matching.load() << " skipped with all matching, ";
       stream << num_chunks_with_binary_search.load() << " scanned using binary search.";
+
+      if (runtime_bloom_filter_size > 0) {
+        stream << separator << "Runtime Bloom filter: " << runtime_bloom_filter_size << " bits, ";
+        if (runtime_bloom_filter_applied) {
+          stream << num_rows_pruned_by_runtime_bloom_filter.load() << " rows pruned.";
+        } else {
+          stream << "not applied.";
+        }
+      }
     }
   };
 
@@ -84,12 +111,19 @@ class TableScan : public AbstractReadOnlyOperator {
   std::shared_ptr<const AbstractExpression> _resolve_uncorrelated_subqueries(
       const std::shared_ptr<const AbstractExpression>& predicate);
 
+  // Builds the runtime Bloom filter from the output of its source. Returns an empty filter if it should not be applied.
+  BloomFilter _build_runtime_bloom_filter(const Table& in_table);
+
  private:
   const std::shared_ptr<AbstractExpression> _predicate;
   std::vector<std::shared_ptr<PQPSubqueryExpression>> _uncorrelated_subquery_expressions;
 
   std::unique_ptr<AbstractTableScanImpl> _impl;
 
+  std::shared_ptr<AbstractOperator> _runtime_bloom_filter_source;
+  ColumnID _runtime_bloom_filter_source_column_id{INVALID_COLUMN_ID};
+  ColumnID _runtime_bloom_filter_column_id{INVALID_COLUMN_ID};
+
   // The description of the impl, so that it still available after the _impl is resetted in _on_cleanup()
   std::string _impl_description{"Unset"};
 };
@@ -19,23 +19,24 @@ AbstractDereferencedColumnTableScanImpl::AbstractDereferencedColumnTableScanImpl
     const PredicateCondition init_predicate_condition)
     : predicate_condition(init_predicate_condition), _in_table(in_table), _column_id(column_id) {}
 
-std::shared_ptr<RowIDPosList> AbstractDereferencedColumnTableScanImpl::scan_chunk(const ChunkID chunk_id) {
+pmr_vector<ChunkOffset> AbstractDereferencedColumnTableScanImpl::scan_chunk(const ChunkID chunk_id) {
   const auto chunk = _in_table->get_chunk(chunk_id);
   const auto& segment = chunk->get_segment(_column_id);
 
-  auto matches = std::make_shared<RowIDPosList>();
+  auto matches = pmr_vector<ChunkOffset>{};
 
   if (const auto& reference_segment = std::dynamic_pointer_cast<ReferenceSegment>(segment)) {
-    _scan_reference_segment(*reference_segment, chunk_id, *matches);
+    _scan_reference_segment(*reference_segment, chunk_id, matches);
   } else {
-    _scan_non_reference_segment(*segment, chunk_id, *matches, nullptr);
+    _scan_non_reference_segment(*segment, chunk_id, matches, nullptr);
   }
 
   return matches;
 }
 
 void AbstractDereferencedColumnTableScanImpl::_scan_reference_segment(const ReferenceSegment& segment,
-                                                                      const ChunkID chunk_id, RowIDPosList& matches) {
+                                                                      const ChunkID chunk_id,
+                                                                      pmr_vector<ChunkOffset>& matches) {
   const auto& pos_list = segment.pos_list();
 
   if (pos_list->references_single_chunk() && !pos_list->empty()) {
@@ -70,7 +71,7 @@ void AbstractDereferencedColumnTableScanImpl::_scan_reference_segment(const Refe
     // that:
     for (auto match_idx = static_cast<ChunkOffset>(num_previous_matches);
          match_idx < static_cast<ChunkOffset>(matches.size()); ++match_idx) {
-      matches[match_idx].chunk_offset = sub_pos_list.original_positions[matches[match_idx].chunk_offset];
+      matches[match_idx] = sub_pos_list.original_positions[matches[match_idx]];
     }
   }
 }
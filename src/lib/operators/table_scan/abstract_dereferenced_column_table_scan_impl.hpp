@@ -27,19 +27,20 @@ class AbstractDereferencedColumnTableScanImpl : public AbstractTableScanImpl {
   AbstractDereferencedColumnTableScanImpl(const std::shared_ptr<const Table>& in_table, const ColumnID column_id,
                                           const PredicateCondition init_predicate_condition);
 
-  std::shared_ptr<RowIDPosList> scan_chunk(const ChunkID chunk_id) override;
+  pmr_vector<ChunkOffset> scan_chunk(const ChunkID chunk_id) override;
 
   const PredicateCondition predicate_condition;
 
  protected:
-  void _scan_reference_segment(const ReferenceSegment& segment, const ChunkID chunk_id, RowIDPosList& matches);
+  void _scan_reference_segment(const ReferenceSegment& segment, const ChunkID chunk_id,
+                               pmr_vector<ChunkOffset>& matches);
 
   // Implemented by the separate Impls. They do not need to deal with ReferenceSegments anymore, as this class
   // takes care of that. We take `matches` as an in/out parameter instead of returning it because scans on multiple
   // referenced segments of a single ReferenceSegment should result in only one PosList. Storing it as a member is
   // no option because it would break multithreading.
   virtual void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id,
-                                           RowIDPosList& matches,
+                                           pmr_vector<ChunkOffset>& matches,
                                            const std::shared_ptr<const AbstractPosList>& position_filter) = 0;
 
   const std::shared_ptr<const Table> _in_table;
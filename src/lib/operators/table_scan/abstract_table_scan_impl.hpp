@@ -8,7 +8,6 @@
 #include <atomic>
 
 #include "operators/operator_performance_data.hpp"
-#include "storage/pos_lists/row_id_pos_list.hpp"
 #include "storage/segment_iterables.hpp"
 #include "storage/segment_iterables/any_segment_iterator.hpp"
 #include "types.hpp"
@@ -25,7 +24,9 @@ class AbstractTableScanImpl {
 
   virtual std::string description() const = 0;
 
-  virtual std::shared_ptr<RowIDPosList> scan_chunk(ChunkID chunk_id) = 0;
+  // Returns the offsets of the matching rows. As all matches are part of the scanned chunk, their ChunkID is not
+  // stored, so that the TableScan can use the offsets for its output PosList without copying them.
+  virtual pmr_vector<ChunkOffset> scan_chunk(ChunkID chunk_id) = 0;
 
   std::atomic_size_t num_chunks_with_early_out{0};
   std::atomic_size_t num_chunks_with_all_rows_matching{0};
@@ -39,10 +40,10 @@ class AbstractTableScanImpl {
 
   template <bool CheckForNull, typename BinaryFunctor, typename LeftIterator>
   static void _scan_with_iterators(const BinaryFunctor func, LeftIterator left_it, const LeftIterator left_end,
-                                   const ChunkID chunk_id, RowIDPosList& matches_out) {
+                                   pmr_vector<ChunkOffset>& matches_out) {
     // Can't use a default argument for this because default arguments are non-type deduced contexts
     auto false_type = std::false_type{};
-    _scan_with_iterators<CheckForNull>(func, left_it, left_end, chunk_id, matches_out, false_type);
+    _scan_with_iterators<CheckForNull>(func, left_it, left_end, matches_out, false_type);
   }
 
   template <bool CheckForNull, typename BinaryFunctor, typename LeftIterator, typename RightIterator>
@@ -51,14 +52,14 @@ class AbstractTableScanImpl {
   // itself.
   static void __attribute__((hot, flatten, noinline))
   _scan_with_iterators(const BinaryFunctor func, LeftIterator left_it, const LeftIterator left_end,
-                       const ChunkID chunk_id, RowIDPosList& matches_out, [[maybe_unused]] RightIterator right_it) {
+                       pmr_vector<ChunkOffset>& matches_out, [[maybe_unused]] RightIterator right_it) {
     // The major part of the table is scanned using SIMD. Only the remainder is handled in this method.
     // For a description of the SIMD code, have a look at the comments in that method.
     // To reduce compile time, SIMD scanning is not used for for ColumnVsColumnScans. Also, string comparisons are more
     // expensive than the scan itself, so we disable SIMD for these, too.
     if constexpr (std::is_same_v<RightIterator, std::false_type> &&
                   !std::is_same_v<std::decay_t<decltype(left_it->value())>, pmr_string>) {
-      _simd_scan_with_iterators<CheckForNull>(func, left_it, left_end, chunk_id, matches_out, right_it);
+      _simd_scan_with_iterators<CheckForNull>(func, left_it, left_end, matches_out, right_it);
     }
 
     // Do the remainder the easy way. If we did not use the SIMD optimization above, left_it was not yet touched, so we
@@ -67,12 +68,12 @@ class AbstractTableScanImpl {
       const auto left = *left_it;
       if constexpr (std::is_same_v<RightIterator, std::false_type>) {
         if ((!CheckForNull || !left.is_null()) && func(left)) {
-          matches_out.emplace_back(RowID{chunk_id, left.chunk_offset()});
+          matches_out.emplace_back(left.chunk_offset());
         }
       } else {
         const auto right = *right_it;
         if ((!CheckForNull || (!left.is_null() && !right.is_null())) && func(left, right)) {
-          matches_out.emplace_back(RowID{chunk_id, left.chunk_offset()});
+          matches_out.emplace_back(left.chunk_offset());
         }
         ++right_it;
       }
@@ -81,7 +82,7 @@ class AbstractTableScanImpl {
 
   template <bool CheckForNull, typename BinaryFunctor, typename LeftIterator, typename RightIterator>
   static void _simd_scan_with_iterators(const BinaryFunctor func, LeftIterator& left_it, const LeftIterator left_end,
-                                        const ChunkID chunk_id, RowIDPosList& matches_out,
+                                        pmr_vector<ChunkOffset>& matches_out,
                                         [[maybe_unused]] RightIterator& right_it) {
     // Concept: Partition the vector into blocks of BLOCK_SIZE entries. The remainder is handled by the caller without
     // optimization. We first check if the rows match and set the `mask` to 1 at the appropriate positions.
@@ -109,7 +110,7 @@ class AbstractTableScanImpl {
     auto matches_out_index = matches_out.size();
 
     // Make sure that we have enough space for the first iteration. We might resize later on.
-    matches_out.resize(matches_out.size() + BLOCK_SIZE, RowID{chunk_id, 0});
+    matches_out.resize(matches_out.size() + BLOCK_SIZE);
 
     // As we access the offsets after we already moved the iterator, we need a copy of it. Creating this copy outside
     // of the while loop keeps the surprisingly high costs for copying an iterator to a minimum.
@@ -192,7 +193,7 @@ class AbstractTableScanImpl {
       // "Slow" path for non-AVX512VL systems
       for (auto i = size_t{0}; i < BLOCK_SIZE; ++i) {
         if (mask >> i & 1) {
-          matches_out[matches_out_index++].chunk_offset = offsets[i];
+          matches_out[matches_out_index++] = offsets[i];
         }
       }
 
@@ -216,7 +217,7 @@ class AbstractTableScanImpl {
       #pragma omp simd safelen(BLOCK_SIZE)
       // clang-format on
       for (auto i = size_t{0}; i < BLOCK_SIZE; ++i) {
-        matches_out[matches_out_index + i].chunk_offset = (reinterpret_cast<ChunkOffset*>(&offsets_simd))[i];
+        matches_out[matches_out_index + i] = (reinterpret_cast<ChunkOffset*>(&offsets_simd))[i];
       }
 
       // Count the number of matches and increase the index of the next write to matches_out accordingly
@@ -226,7 +227,7 @@ class AbstractTableScanImpl {
       // As we write directly into the matches_out vector, we have to make sure that is big enough. We grow the vector
       // more aggressively than its default behavior as the potentially wasted space is only ephemeral.
       if (matches_out_index + BLOCK_SIZE >= matches_out.size()) {
-        matches_out.resize((BLOCK_SIZE + matches_out.size()) * 3, RowID{chunk_id, 0});
+        matches_out.resize((BLOCK_SIZE + matches_out.size()) * 3);
       }
     }
 
@@ -0,0 +1,150 @@
+#include "attribute_vector_scan.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Number of rows whose matches are collected in one bitmap
+constexpr auto BLOCK_SIZE = size_t{64};
+
+struct ValueIDRangePredicate {
+  bool matches(const uint32_t value_id) const {
+    // (x >= a && x < b) === ((x - a) < (b - a)), see ColumnBetweenTableScanImpl::_scan_dictionary_segment()
+    return ((value_id - begin_value_id < range_size) != invert) & (value_id != null_value_id);
+  }
+
+  uint32_t begin_value_id;
+  uint32_t range_size;
+  bool invert;
+  uint32_t null_value_id;
+};
+
+// Returns the match bitmap for the BLOCK_SIZE rows starting at `block_offset`
+template <typename GetValueID>
+uint64_t scan_block(const GetValueID& get_value_id, const size_t block_offset,
+                    const ValueIDRangePredicate& predicate) {
+  auto bitmap = uint64_t{0};
+
+  // We do not use the OpenMP runtime, but only the compiler pragmas (see AbstractTableScanImpl).
+  // NOLINTNEXTLINE
+  {}  // clang-format off
+  #pragma omp simd reduction(|:bitmap)
+  // clang-format on
+  for (auto index = size_t{0}; index < BLOCK_SIZE; ++index) {
+    bitmap |= static_cast<uint64_t>(predicate.matches(get_value_id(block_offset + index))) << index;
+  }
+
+  return bitmap;
+}
+
+// Scans the first `block_count` blocks with `get_block_value_id` and the remaining rows with `get_value_id`
+template <typename GetBlockValueID, typename GetValueID>
+void scan_rows(const GetBlockValueID& get_block_value_id, const size_t block_count, const GetValueID& get_value_id,
+               const size_t row_count, const ValueIDRangePredicate& predicate, pmr_vector<ChunkOffset>& matches) {
+  auto matches_index = matches.size();
+
+  for (auto block_id = size_t{0}; block_id < block_count; ++block_id) {
+    const auto block_offset = block_id * BLOCK_SIZE;
+    auto bitmap = scan_block(get_block_value_id, block_offset, predicate);
+    if (!bitmap) continue;
+
+    // Instead of calling emplace_back for every match, resize once per block and write the matches directly
+    matches.resize(matches_index + __builtin_popcountll(bitmap));
+    while (bitmap) {
+      const auto offset = block_offset + __builtin_ctzll(bitmap);
+      matches[matches_index++] = static_cast<ChunkOffset>(offset);
+      bitmap &= bitmap - 1;
+    }
+  }
+
+  for (auto offset = block_count * BLOCK_SIZE; offset < row_count; ++offset) {
+    if (predicate.matches(get_value_id(offset))) {
+      matches.emplace_back(static_cast<ChunkOffset>(offset));
+    }
+  }
+}
+
+template <typename UnsignedIntType>
+void scan_fixed_width_integer_vector(const FixedWidthIntegerVector<UnsignedIntType>& vector,
+                                     const ValueIDRangePredicate& predicate, pmr_vector<ChunkOffset>& matches) {
+  const auto* const data = vector.data().data();
+  const auto get_value_id = [data](const size_t offset) { return static_cast<uint32_t>(data[offset]); };
+
+  const auto row_count = vector.size();
+  scan_rows(get_value_id, row_count / BLOCK_SIZE, get_value_id, row_count, predicate, matches);
+}
+
+template <uint32_t BitWidth>
+void scan_bit_packing_vector(const pmr_compact_vector& data, const ValueIDRangePredicate& predicate,
+                             pmr_vector<ChunkOffset>& matches) {
+  constexpr auto WORD_BITS = size_t{64};
+  constexpr auto MASK = (uint64_t{1} << BitWidth) - 1;
+
+  // The compact_vector stores the values LSB-first in consecutive 64-bit words. A value that does not fit into the
+  // remainder of a word continues in the lowest bits of the next word.
+  const auto* const words = data.get();
+  const auto word_count = data.bytes() / sizeof(uint64_t);
+
+  const auto get_block_value_id = [words](const size_t offset) {
+    const auto bit_offset = offset * BitWidth;
+    const auto word_offset = bit_offset / WORD_BITS;
+    const auto shift = bit_offset % WORD_BITS;
+
+    // Always reading the next word keeps the loop branch-free. Excess bits are masked out. Shifting in two steps avoids
+    // the undefined shift by 64 bits if the value starts at a word boundary.
+    const auto value = (words[word_offset] >> shift) | ((words[word_offset + 1] << 1) << (WORD_BITS - 1 - shift));
+    return static_cast<uint32_t>(value & MASK);
+  };
+
+  const auto get_value_id = [&data](const size_t offset) { return static_cast<uint32_t>(data[offset]); };
+
+  // A block of 64 rows occupies exactly BitWidth words. As get_block_value_id reads the word after the last one of the
+  // block, only blocks that are followed by another word are scanned block-wise.
+  const auto row_count = data.size();
+  const auto block_count = word_count > 0 ? std::min(row_count / BLOCK_SIZE, (word_count - 1) / BitWidth) : size_t{0};
+  scan_rows(get_block_value_id, block_count, get_value_id, row_count, predicate, matches);
+}
+
+template <uint32_t... BitWidthIndices>
+void resolve_bit_width(const pmr_compact_vector& data, const ValueIDRangePredicate& predicate,
+                       pmr_vector<ChunkOffset>& matches,
+                       std::integer_sequence<uint32_t, BitWidthIndices...> /* bit_widths */) {
+  const auto bit_width = static_cast<uint32_t>(data.bits());
+  const auto resolved = ((bit_width == BitWidthIndices + 1 &&
+                          (scan_bit_packing_vector<BitWidthIndices + 1>(data, predicate, matches), true)) ||
+                         ...);
+  Assert(resolved, "Unexpected bit width of BitPackingVector");
+}
+
+}  // namespace
+
+namespace opossum {
+
+void scan_attribute_vector(const BaseCompressedVector& attribute_vector, const ValueID begin_value_id,
+                           const ValueID end_value_id, const bool invert, const ValueID null_value_id,
+                           pmr_vector<ChunkOffset>& matches) {
+  DebugAssert(begin_value_id <= end_value_id, "Invalid value ID range");
+
+  const auto predicate = ValueIDRangePredicate{static_cast<uint32_t>(begin_value_id),
+                                               static_cast<uint32_t>(end_value_id - begin_value_id), invert,
+                                               static_cast<uint32_t>(null_value_id)};
+
+  resolve_compressed_vector_type(attribute_vector, [&](const auto& vector) {
+    using VectorType = std::decay_t<decltype(vector)>;
+
+    if constexpr (std::is_same_v<VectorType, BitPackingVector>) {
+      resolve_bit_width(vector.data(), predicate, matches, std::make_integer_sequence<uint32_t, 32>{});
+    } else {
+      scan_fixed_width_integer_vector(vector, predicate, matches);
+    }
+  });
+}
+
+}  // namespace opossum
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseCompressedVector;
+
+/**
+ * Scans the attribute vector of a dictionary segment for the value IDs in [begin_value_id, end_value_id) or, if
+ * `invert` is set, for those outside of this range. Rows with the null_value_id never match. Matches are appended to
+ * `matches`. Every predicate of the ColumnVsValue and ColumnBetween scans on dictionary segments can be expressed this
+ * way (e.g., `column != value` is the inverted range [vid, vid + 1)).
+ *
+ * Unlike the iterator-based scan, this works directly on the compressed data: The rows are processed in blocks of 64,
+ * for which the predicate is evaluated in a branch-free loop that the compiler vectorizes. Its result is a 64-bit
+ * match bitmap, of which only the set bits are turned into ChunkOffsets. For BitPackingVectors, the loop is
+ * instantiated for every bit width, so that the positions of the value IDs within a block (which always starts at a
+ * word boundary) are compile-time constants. This follows the idea of SIMD-Scan (Willhalm et al., VLDB 2009).
+ */
+void scan_attribute_vector(const BaseCompressedVector& attribute_vector, const ValueID begin_value_id,
+                           const ValueID end_value_id, const bool invert, const ValueID null_value_id,
+                           pmr_vector<ChunkOffset>& matches);
+
+}  // namespace opossum
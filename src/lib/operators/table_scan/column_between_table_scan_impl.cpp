@@ -4,6 +4,7 @@
 #include <string>
 #include <type_traits>
 
+#include "attribute_vector_scan.hpp"
 #include "expression/between_expression.hpp"
 #include "sorted_segment_search.hpp"
 #include "storage/chunk.hpp"
@@ -35,7 +36,7 @@ ColumnBetweenTableScanImpl::ColumnBetweenTableScanImpl(const std::shared_ptr<con
 std::string ColumnBetweenTableScanImpl::description() const { return "ColumnBetween"; }
 
 void ColumnBetweenTableScanImpl::_scan_non_reference_segment(
-    const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const AbstractSegment& segment, const ChunkID chunk_id, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) {
   const auto& chunk_sorted_by = _in_table->get_chunk(chunk_id)->individually_sorted_by();
 
@@ -48,7 +49,7 @@ void ColumnBetweenTableScanImpl::_scan_non_reference_segment(
       !(dictionary_segment && position_filter && _in_table->column_data_type(_column_id) == DataType::String)) {
     for (const auto& sorted_by : chunk_sorted_by) {
       if (sorted_by.column == _column_id) {
-        _scan_sorted_segment(segment, chunk_id, matches, position_filter, sorted_by.sort_mode);
+        _scan_sorted_segment(segment, matches, position_filter, sorted_by.sort_mode);
         return;
       }
     }
@@ -56,14 +57,14 @@ void ColumnBetweenTableScanImpl::_scan_non_reference_segment(
 
   // Select optimized or generic scanning implementation based on segment type
   if (dictionary_segment) {
-    _scan_dictionary_segment(*dictionary_segment, chunk_id, matches, position_filter);
+    _scan_dictionary_segment(*dictionary_segment, matches, position_filter);
   } else {
-    _scan_generic_segment(segment, chunk_id, matches, position_filter);
+    _scan_generic_segment(segment, matches, position_filter);
   }
 }
 
 void ColumnBetweenTableScanImpl::_scan_generic_segment(
-    const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) const {
   segment_with_iterators_filtered(segment, position_filter, [&](auto it, [[maybe_unused]] const auto end) {
     using ColumnDataType = typename decltype(it)::ValueType;
@@ -80,7 +81,7 @@ void ColumnBetweenTableScanImpl::_scan_generic_segment(
         auto between_comparator = [&](const auto& position) {
           return between_comparator_function(position.value(), typed_left_value, typed_right_value);
         };
-        _scan_with_iterators<true>(between_comparator, it, end, chunk_id, matches);
+        _scan_with_iterators<true>(between_comparator, it, end, matches);
       });
     } else {
       Fail("Dictionary and Reference segments have their own code paths and should be handled there");
@@ -89,7 +90,7 @@ void ColumnBetweenTableScanImpl::_scan_generic_segment(
 }
 
 void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
-    const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const BaseDictionarySegment& segment, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) {
   ValueID lower_bound_value_id;
   if (is_lower_inclusive_between(predicate_condition)) {
@@ -116,7 +117,7 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
       // We still have to check for NULLs
       attribute_vector_iterable.with_iterators(position_filter, [&](auto left_it, auto left_end) {
         static const auto always_true = [](const auto&) { return true; };
-        _scan_with_iterators<true>(always_true, left_it, left_end, chunk_id, matches);
+        _scan_with_iterators<true>(always_true, left_it, left_end, matches);
       });
     } else {
       // No NULLs, all entries match.
@@ -134,7 +135,7 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
       for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(output_size); ++chunk_offset) {
         // `matches` might already contain entries if it is called multiple times by
         // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment.
-        matches[output_start_offset + chunk_offset] = RowID{chunk_id, chunk_offset};
+        matches[output_start_offset + chunk_offset] = chunk_offset;
       }
     }
 
@@ -159,6 +160,13 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
     upper_bound_value_id = segment.unique_values_count();
   }
 
+  if (!position_filter) {
+    // Scan the compressed attribute vector block-wise, see scan_attribute_vector()
+    scan_attribute_vector(*segment.attribute_vector(), lower_bound_value_id, upper_bound_value_id, false,
+                          segment.null_value_id(), matches);
+    return;
+  }
+
   const auto value_id_diff = upper_bound_value_id - lower_bound_value_id;
   const auto comparator = [lower_bound_value_id, value_id_diff](const auto& position) {
     // Using < here because the right value id is the upper_bound. Also, because the value ids are integers, we can do
@@ -169,12 +177,11 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
 
   attribute_vector_iterable.with_iterators(position_filter, [&](auto left_it, auto left_end) {
     // No need to check for NULL because NULL would be represented as a value ID outside of our range
-    _scan_with_iterators<false>(comparator, left_it, left_end, chunk_id, matches);
+    _scan_with_iterators<false>(comparator, left_it, left_end, matches);
   });
 }
 
-void ColumnBetweenTableScanImpl::_scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id,
-                                                      RowIDPosList& matches,
+void ColumnBetweenTableScanImpl::_scan_sorted_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                                                       const std::shared_ptr<const AbstractPosList>& position_filter,
                                                       const SortMode sort_mode) {
   resolve_data_and_segment_type(segment, [&](const auto type, const auto& typed_segment) {
@@ -191,7 +198,7 @@ void ColumnBetweenTableScanImpl::_scan_sorted_segment(const AbstractSegment& seg
                                                          predicate_condition, typed_left_value, typed_right_value);
 
         sorted_segment_search.scan_sorted_segment([&](auto begin, auto end) {
-          sorted_segment_search._write_rows_to_matches(begin, end, chunk_id, matches, position_filter);
+          sorted_segment_search._write_rows_to_matches(begin, end, matches, position_filter);
         });
 
         if (sorted_segment_search.no_rows_matching) {
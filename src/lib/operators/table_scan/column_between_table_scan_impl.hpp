@@ -33,17 +33,18 @@ class ColumnBetweenTableScanImpl : public AbstractDereferencedColumnTableScanImp
   const AllTypeVariant right_value;
 
  protected:
-  void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id,
+                                   pmr_vector<ChunkOffset>& matches,
                                    const std::shared_ptr<const AbstractPosList>& position_filter) override;
 
-  void _scan_generic_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_generic_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                              const std::shared_ptr<const AbstractPosList>& position_filter) const;
 
   // Optimized scan on DictionarySegments
-  void _scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_dictionary_segment(const BaseDictionarySegment& segment, pmr_vector<ChunkOffset>& matches,
                                 const std::shared_ptr<const AbstractPosList>& position_filter);
 
-  void _scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_sorted_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                             const std::shared_ptr<const AbstractPosList>& position_filter, const SortMode sort_mode);
 
  private:
@@ -24,44 +24,45 @@ ColumnIsNullTableScanImpl::ColumnIsNullTableScanImpl(const std::shared_ptr<const
 
 std::string ColumnIsNullTableScanImpl::description() const { return "IsNullScan"; }
 
-std::shared_ptr<RowIDPosList> ColumnIsNullTableScanImpl::scan_chunk(const ChunkID chunk_id) {
+pmr_vector<ChunkOffset> ColumnIsNullTableScanImpl::scan_chunk(const ChunkID chunk_id) {
   const auto& chunk = _in_table->get_chunk(chunk_id);
   const auto& segment = chunk->get_segment(_column_id);
 
-  auto matches = std::make_shared<RowIDPosList>();
+  auto matches = pmr_vector<ChunkOffset>{};
 
   if (const auto value_segment = std::dynamic_pointer_cast<BaseValueSegment>(segment)) {
-    _scan_value_segment(*value_segment, chunk_id, *matches);
+    _scan_value_segment(*value_segment, matches);
   } else {
     const auto& chunk_sorted_by = chunk->individually_sorted_by();
     if (!chunk_sorted_by.empty()) {
       for (const auto& sorted_by : chunk_sorted_by) {
         if (sorted_by.column == _column_id) {
-          _scan_generic_sorted_segment(*segment, chunk_id, *matches, sorted_by.sort_mode);
+          _scan_generic_sorted_segment(*segment, matches, sorted_by.sort_mode);
           ++num_chunks_with_binary_search;
           return matches;
         }
       }
     }
-    _scan_generic_segment(*segment, chunk_id, *matches);
+    _scan_generic_segment(*segment, matches);
   }
 
   return matches;
 }
 
-void ColumnIsNullTableScanImpl::_scan_generic_segment(const AbstractSegment& segment, const ChunkID chunk_id,
-                                                      RowIDPosList& matches) const {
+void ColumnIsNullTableScanImpl::_scan_generic_segment(const AbstractSegment& segment,
+                                                      pmr_vector<ChunkOffset>& matches) const {
   segment_with_iterators(segment, [&](auto it, [[maybe_unused]] const auto end) {
     // This may also be called for a ValueSegment if `segment` is a ReferenceSegment pointing to a single ValueSegment.
     const auto invert = _predicate_condition == PredicateCondition::IsNotNull;
     const auto functor = [&](const auto& value) { return invert ^ value.is_null(); };
 
-    _scan_with_iterators<false>(functor, it, end, chunk_id, matches);
+    _scan_with_iterators<false>(functor, it, end, matches);
   });
 }
 
-void ColumnIsNullTableScanImpl::_scan_generic_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id,
-                                                             RowIDPosList& matches, const SortMode sorted_by) const {
+void ColumnIsNullTableScanImpl::_scan_generic_sorted_segment(const AbstractSegment& segment,
+                                                             pmr_vector<ChunkOffset>& matches,
+                                                             const SortMode sorted_by) const {
   const bool is_nulls_first = sorted_by == SortMode::Ascending || sorted_by == SortMode::Descending;
   const bool predicate_is_null = _predicate_condition == PredicateCondition::IsNull;
   segment_with_iterators(segment, [&](auto begin, auto end) {
@@ -87,15 +88,14 @@ void ColumnIsNullTableScanImpl::_scan_generic_sorted_segment(const AbstractSegme
     size_t output_idx = matches.size();
     matches.resize(matches.size() + std::distance(begin, end));
     for (auto segment_it = begin; segment_it != end; ++segment_it) {
-      matches[output_idx++] = RowID{chunk_id, segment_it->chunk_offset()};
+      matches[output_idx++] = segment_it->chunk_offset();
     }
   });
 }
 
-void ColumnIsNullTableScanImpl::_scan_value_segment(const BaseValueSegment& segment, const ChunkID chunk_id,
-                                                    RowIDPosList& matches) {
+void ColumnIsNullTableScanImpl::_scan_value_segment(const BaseValueSegment& segment, pmr_vector<ChunkOffset>& matches) {
   if (_matches_all(segment)) {
-    _add_all(chunk_id, matches, segment.size());
+    _add_all(matches, segment.size());
     return;
   }
 
@@ -110,7 +110,7 @@ void ColumnIsNullTableScanImpl::_scan_value_segment(const BaseValueSegment& segm
 
   const auto invert = _predicate_condition == PredicateCondition::IsNotNull;
   const auto functor = [&](const auto& value) { return invert ^ value.is_null(); };
-  iterable.with_iterators([&](auto it, auto end) { _scan_with_iterators<false>(functor, it, end, chunk_id, matches); });
+  iterable.with_iterators([&](auto it, auto end) { _scan_with_iterators<false>(functor, it, end, matches); });
 }
 
 bool ColumnIsNullTableScanImpl::_matches_all(const BaseValueSegment& segment) const {
@@ -139,10 +139,10 @@ bool ColumnIsNullTableScanImpl::_matches_none(const BaseValueSegment& segment) c
   }
 }
 
-void ColumnIsNullTableScanImpl::_add_all(const ChunkID chunk_id, RowIDPosList& matches, const size_t segment_size) {
+void ColumnIsNullTableScanImpl::_add_all(pmr_vector<ChunkOffset>& matches, const size_t segment_size) {
   const auto num_rows = segment_size;
   for (auto chunk_offset = 0u; chunk_offset < num_rows; ++chunk_offset) {
-    matches.emplace_back(RowID{chunk_id, chunk_offset});
+    matches.emplace_back(chunk_offset);
   }
 }
 
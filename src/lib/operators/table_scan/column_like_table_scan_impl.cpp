@@ -7,9 +7,11 @@
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "fsst_segment_scan.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 #include "storage/resolve_encoded_segment_type.hpp"
 #include "storage/segment_iterables/create_iterable_from_attribute_vector.hpp"
@@ -24,26 +26,34 @@ ColumnLikeTableScanImpl::ColumnLikeTableScanImpl(const std::shared_ptr<const Tab
                                                  const pmr_string& pattern)
     : AbstractDereferencedColumnTableScanImpl{in_table, column_id, init_predicate_condition},
       _matcher{pattern},
-      _invert_results(predicate_condition == PredicateCondition::NotLike) {}
+      _invert_results(predicate_condition == PredicateCondition::NotLike) {
+  const auto pattern_variant = LikeMatcher::pattern_string_to_pattern_variant(pattern);
+  if (std::holds_alternative<LikeMatcher::StartsWithPattern>(pattern_variant)) {
+    _starts_with_prefix = std::get<LikeMatcher::StartsWithPattern>(pattern_variant).string;
+  }
+}
 
 std::string ColumnLikeTableScanImpl::description() const { return "ColumnLike"; }
 
 void ColumnLikeTableScanImpl::_scan_non_reference_segment(
-    const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const AbstractSegment& segment, const ChunkID chunk_id, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) {
   // For dictionary segments where the number of unique values is not higher than the number of (potentially filtered)
   // input rows, use an optimized implementation.
   if (const auto* dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(&segment);
       dictionary_segment &&
       (!position_filter || dictionary_segment->unique_values_count() <= position_filter->size())) {
-    _scan_dictionary_segment(*dictionary_segment, chunk_id, matches, position_filter);
+    _scan_dictionary_segment(*dictionary_segment, matches, position_filter);
+  } else if (const auto* fsst_segment = dynamic_cast<const FSSTSegment<pmr_string>*>(&segment);
+             fsst_segment && _starts_with_prefix) {
+    _scan_fsst_segment(*fsst_segment, matches, position_filter);
   } else {
-    _scan_generic_segment(segment, chunk_id, matches, position_filter);
+    _scan_generic_segment(segment, matches, position_filter);
   }
 }
 
 void ColumnLikeTableScanImpl::_scan_generic_segment(
-    const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) const {
   segment_with_iterators_filtered(segment, position_filter, [&](auto it, [[maybe_unused]] const auto end) {
     // Don't instantiate this for ReferenceSegments to save compile time as ReferenceSegments are handled
@@ -54,7 +64,7 @@ void ColumnLikeTableScanImpl::_scan_generic_segment(
       if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
         _matcher.resolve(_invert_results, [&](const auto& resolved_matcher) {
           const auto functor = [&](const auto& position) { return resolved_matcher(position.value()); };
-          _scan_with_iterators<true>(functor, it, end, chunk_id, matches);
+          _scan_with_iterators<true>(functor, it, end, matches);
         });
       } else {
         Fail("Can only handle strings");
@@ -65,8 +75,19 @@ void ColumnLikeTableScanImpl::_scan_generic_segment(
   });
 }
 
-void ColumnLikeTableScanImpl::_scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id,
-                                                       RowIDPosList& matches,
+void ColumnLikeTableScanImpl::_scan_fsst_segment(const FSSTSegment<pmr_string>& segment,
+                                                 pmr_vector<ChunkOffset>& matches,
+                                                 const std::shared_ptr<const AbstractPosList>& position_filter) const {
+  // Prefixes are compared symbol by symbol, so that only the codes covering the prefix are looked at
+  const auto& symbol_table = segment.symbol_table();
+  const auto& prefix = *_starts_with_prefix;
+  scan_fsst_segment(segment, matches, position_filter, [&](const std::string_view codes) {
+    return symbol_table.starts_with(codes, prefix) != _invert_results;
+  });
+}
+
+void ColumnLikeTableScanImpl::_scan_dictionary_segment(const BaseDictionarySegment& segment,
+                                                       pmr_vector<ChunkOffset>& matches,
                                                        const std::shared_ptr<const AbstractPosList>& position_filter) {
   // First, build a bitmap containing 1s/0s for matching/non-matching dictionary values. Second, iterate over the
   // attribute vector and check against the bitmap. If too many input rows have already been removed (are not part of
@@ -90,7 +111,7 @@ void ColumnLikeTableScanImpl::_scan_dictionary_segment(const BaseDictionarySegme
   if (match_count == dictionary_matches.size()) {
     attribute_vector_iterable.with_iterators(position_filter, [&](auto it, auto end) {
       static const auto always_true = [](const auto&) { return true; };
-      _scan_with_iterators<true>(always_true, it, end, chunk_id, matches);
+      _scan_with_iterators<true>(always_true, it, end, matches);
     });
 
     return;
@@ -107,7 +128,7 @@ void ColumnLikeTableScanImpl::_scan_dictionary_segment(const BaseDictionarySegme
   };
 
   attribute_vector_iterable.with_iterators(position_filter, [&](auto it, auto end) {
-    _scan_with_iterators<true>(dictionary_lookup, it, end, chunk_id, matches);
+    _scan_with_iterators<true>(dictionary_lookup, it, end, matches);
   });
 }
 
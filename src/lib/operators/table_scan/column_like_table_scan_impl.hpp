@@ -2,6 +2,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <regex>
 #include <string>
 #include <utility>
@@ -18,6 +19,9 @@ namespace opossum {
 
 class Table;
 
+template <typename T>
+class FSSTSegment;
+
 /**
  * @brief Implements a column scan using the LIKE operator
  *
@@ -26,6 +30,7 @@ class Table;
  * - For dictionary segments, we check the values in the dictionary and store the matches in a vector
  *   in order to avoid having to look up each value ID of the attribute vector in the dictionary. This also
  *   enables us to detect if all or none of the values in the segment satisfy the expression.
+ * - For FSST segments, StartsWithPatterns are evaluated on the compressed codes of the values.
  *
  * Performance Notes: Uses std::regex as a slow fallback and resorts to much faster Pattern matchers for special cases,
  *                    e.g., StartsWithPattern. 
@@ -38,13 +43,16 @@ class ColumnLikeTableScanImpl : public AbstractDereferencedColumnTableScanImpl {
   std::string description() const override;
 
  protected:
-  void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id,
+                                   pmr_vector<ChunkOffset>& matches,
                                    const std::shared_ptr<const AbstractPosList>& position_filter) override;
 
-  void _scan_generic_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_generic_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                              const std::shared_ptr<const AbstractPosList>& position_filter) const;
-  void _scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_dictionary_segment(const BaseDictionarySegment& segment, pmr_vector<ChunkOffset>& matches,
                                 const std::shared_ptr<const AbstractPosList>& position_filter);
+  void _scan_fsst_segment(const FSSTSegment<pmr_string>& segment, pmr_vector<ChunkOffset>& matches,
+                          const std::shared_ptr<const AbstractPosList>& position_filter) const;
 
   /**
    * Used for dictionary segments
@@ -57,6 +65,9 @@ class ColumnLikeTableScanImpl : public AbstractDereferencedColumnTableScanImpl {
 
   // For NOT LIKE support
   const bool _invert_results;
+
+  // Set if the pattern is a StartsWithPattern, which can be evaluated on FSST-compressed values
+  std::optional<pmr_string> _starts_with_prefix;
 };
 
 }  // namespace opossum
@@ -29,7 +29,7 @@ class ColumnVsColumnTableScanImpl : public AbstractTableScanImpl {
 
   std::string description() const override;
 
-  std::shared_ptr<RowIDPosList> scan_chunk(ChunkID chunk_id) override;
+  pmr_vector<ChunkOffset> scan_chunk(ChunkID chunk_id) override;
 
  private:
   const std::shared_ptr<const Table> _in_table;
@@ -38,13 +38,13 @@ class ColumnVsColumnTableScanImpl : public AbstractTableScanImpl {
   const ColumnID _right_column_id;
 
   template <EraseTypes erase_comparator_type, typename LeftIterable, typename RightIterable>
-  std::shared_ptr<RowIDPosList> _typed_scan_chunk_with_iterables(ChunkID chunk_id, const LeftIterable& left_iterable,
-                                                                 const RightIterable& right_iterable) const;
+  pmr_vector<ChunkOffset> _typed_scan_chunk_with_iterables(const LeftIterable& left_iterable,
+                                                           const RightIterable& right_iterable) const;
 
   template <EraseTypes erase_comparator_type, typename LeftIterator, typename RightIterator>
-  std::shared_ptr<RowIDPosList> _typed_scan_chunk_with_iterators(ChunkID chunk_id, LeftIterator& left_it,
-                                                                 const LeftIterator& left_end, RightIterator& right_it,
-                                                                 const RightIterator& right_end) const;
+  pmr_vector<ChunkOffset> _typed_scan_chunk_with_iterators(LeftIterator& left_it, const LeftIterator& left_end,
+                                                           RightIterator& right_it,
+                                                           const RightIterator& right_end) const;
 };
 
 }  // namespace opossum
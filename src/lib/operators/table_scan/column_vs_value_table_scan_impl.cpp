@@ -1,9 +1,12 @@
 #include "column_vs_value_table_scan_impl.hpp"
 
 #include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "attribute_vector_scan.hpp"
+#include "fsst_segment_scan.hpp"
 #include "sorted_segment_search.hpp"
 #include "storage/base_dictionary_segment.hpp"
 #include "storage/create_iterable_from_segment.hpp"
@@ -31,14 +34,14 @@ ColumnVsValueTableScanImpl::ColumnVsValueTableScanImpl(const std::shared_ptr<con
 std::string ColumnVsValueTableScanImpl::description() const { return "ColumnVsValue"; }
 
 void ColumnVsValueTableScanImpl::_scan_non_reference_segment(
-    const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const AbstractSegment& segment, const ChunkID chunk_id, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) {
   const auto& chunk_sorted_by = _in_table->get_chunk(chunk_id)->individually_sorted_by();
 
   if (!chunk_sorted_by.empty()) {
     for (const auto& sorted_by : chunk_sorted_by) {
       if (sorted_by.column == _column_id) {
-        _scan_sorted_segment(segment, chunk_id, matches, position_filter, sorted_by.sort_mode);
+        _scan_sorted_segment(segment, matches, position_filter, sorted_by.sort_mode);
         ++num_chunks_with_binary_search;
         return;
       }
@@ -46,14 +49,18 @@ void ColumnVsValueTableScanImpl::_scan_non_reference_segment(
   }
 
   if (const auto* dictionary_segment = dynamic_cast<const BaseDictionarySegment*>(&segment)) {
-    _scan_dictionary_segment(*dictionary_segment, chunk_id, matches, position_filter);
+    _scan_dictionary_segment(*dictionary_segment, matches, position_filter);
+  } else if (const auto* fsst_segment = dynamic_cast<const FSSTSegment<pmr_string>*>(&segment);
+             fsst_segment && (predicate_condition == PredicateCondition::Equals ||
+                              predicate_condition == PredicateCondition::NotEquals)) {
+    _scan_fsst_segment(*fsst_segment, matches, position_filter);
   } else {
-    _scan_generic_segment(segment, chunk_id, matches, position_filter);
+    _scan_generic_segment(segment, matches, position_filter);
   }
 }
 
 void ColumnVsValueTableScanImpl::_scan_generic_segment(
-    const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) const {
   segment_with_iterators_filtered(segment, position_filter, [&](auto it, [[maybe_unused]] const auto end) {
     // Don't instantiate this for this for DictionarySegments and ReferenceSegments to save compile time.
@@ -69,7 +76,7 @@ void ColumnVsValueTableScanImpl::_scan_generic_segment(
         auto comparator = [predicate_comparator, typed_value](const auto& position) {
           return predicate_comparator(position.value(), typed_value);
         };
-        _scan_with_iterators<true>(comparator, it, end, chunk_id, matches);
+        _scan_with_iterators<true>(comparator, it, end, matches);
       });
     } else {
       Fail("Dictionary- and ReferenceSegments have their own code paths and should be handled there");
@@ -77,8 +84,22 @@ void ColumnVsValueTableScanImpl::_scan_generic_segment(
   });
 }
 
+void ColumnVsValueTableScanImpl::_scan_fsst_segment(
+    const FSSTSegment<pmr_string>& segment, pmr_vector<ChunkOffset>& matches,
+    const std::shared_ptr<const AbstractPosList>& position_filter) const {
+  // As FSST compresses deterministically, a value equals the search value iff their codes are equal. Thus, the search
+  // value is compressed once instead of decompressing every value of the segment.
+  auto search_codes_vector = pmr_vector<char>{};
+  segment.symbol_table().compress(boost::get<pmr_string>(value), search_codes_vector);
+  const auto search_codes = std::string_view{search_codes_vector.data(), search_codes_vector.size()};
+
+  const auto invert = predicate_condition == PredicateCondition::NotEquals;
+  scan_fsst_segment(segment, matches, position_filter,
+                    [&](const std::string_view codes) { return (codes == search_codes) != invert; });
+}
+
 void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
-    const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+    const BaseDictionarySegment& segment, pmr_vector<ChunkOffset>& matches,
     const std::shared_ptr<const AbstractPosList>& position_filter) {
   /**
    * ValueID search_vid;              // left value id
@@ -117,7 +138,7 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
       // We still have to check for NULLs
       iterable.with_iterators(position_filter, [&](auto it, auto end) {
         static const auto always_true = [](const auto&) { return true; };
-        _scan_with_iterators<true>(always_true, it, end, chunk_id, matches);
+        _scan_with_iterators<true>(always_true, it, end, matches);
       });
     } else {
       // No NULLs, all rows match.
@@ -135,7 +156,7 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
       for (auto chunk_offset = ChunkOffset{0}; chunk_offset < static_cast<ChunkOffset>(output_size); ++chunk_offset) {
         // `matches` might already contain entries if it is called multiple times by
         // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment.
-        matches[output_start_offset + chunk_offset] = RowID{chunk_id, chunk_offset};
+        matches[output_start_offset + chunk_offset] = chunk_offset;
       }
     }
 
@@ -147,6 +168,33 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
     return;
   }
 
+  if (!position_filter) {
+    // Without a position filter, the attribute vector can be scanned block-wise on its compressed data. The predicate
+    // is translated into the range of matching value IDs (see table above).
+    const auto null_value_id = segment.null_value_id();
+    switch (predicate_condition) {
+      case PredicateCondition::Equals:
+      case PredicateCondition::NotEquals:
+        scan_attribute_vector(*segment.attribute_vector(), search_value_id, ValueID{search_value_id + 1},
+                              predicate_condition == PredicateCondition::NotEquals, null_value_id, matches);
+        return;
+
+      case PredicateCondition::LessThan:
+      case PredicateCondition::LessThanEquals:
+        scan_attribute_vector(*segment.attribute_vector(), ValueID{0}, search_value_id, false, null_value_id, matches);
+        return;
+
+      case PredicateCondition::GreaterThan:
+      case PredicateCondition::GreaterThanEquals:
+        scan_attribute_vector(*segment.attribute_vector(), search_value_id, null_value_id, false, null_value_id,
+                              matches);
+        return;
+
+      default:
+        Fail("Unsupported comparison type encountered");
+    }
+  }
+
   _with_operator_for_dict_segment_scan([&](auto predicate_comparator) {
     auto comparator = [predicate_comparator, search_value_id](const auto& position) {
       return predicate_comparator(position.value(), search_value_id);
@@ -159,16 +207,15 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
       if (predicate_condition == PredicateCondition::Equals ||
           predicate_condition == PredicateCondition::LessThanEquals ||
           predicate_condition == PredicateCondition::LessThan) {
-        _scan_with_iterators<false>(comparator, it, end, chunk_id, matches);
+        _scan_with_iterators<false>(comparator, it, end, matches);
       } else {
-        _scan_with_iterators<true>(comparator, it, end, chunk_id, matches);
+        _scan_with_iterators<true>(comparator, it, end, matches);
       }
     });
   });
 }
 
-void ColumnVsValueTableScanImpl::_scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id,
-                                                      RowIDPosList& matches,
+void ColumnVsValueTableScanImpl::_scan_sorted_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                                                       const std::shared_ptr<const AbstractPosList>& position_filter,
                                                       const SortMode sort_mode) const {
   resolve_data_and_segment_type(segment, [&](const auto type, const auto& typed_segment) {
@@ -183,7 +230,7 @@ void ColumnVsValueTableScanImpl::_scan_sorted_segment(const AbstractSegment& seg
                                                          predicate_condition, boost::get<ColumnDataType>(value));
 
         sorted_segment_search.scan_sorted_segment([&](auto begin, auto end) {
-          sorted_segment_search._write_rows_to_matches(begin, end, chunk_id, matches, position_filter);
+          sorted_segment_search._write_rows_to_matches(begin, end, matches, position_filter);
         });
       });
     }
@@ -14,6 +14,9 @@
 
 namespace opossum {
 
+template <typename T>
+class FSSTSegment;
+
 /**
  * @brief Compares one column to a literal (i.e., an AllTypeVariant)
  *
@@ -21,6 +24,7 @@ namespace opossum {
  * - For dictionary segments, we basically look up the value ID of the constant value in the dictionary
  *   in order to avoid having to look up each value ID of the attribute vector in the dictionary. This also
  *   enables us to detect if all or none of the values in the segment satisfy the expression.
+ * - For FSST segments, (in)equality is evaluated on the compressed codes of the values
  */
 class ColumnVsValueTableScanImpl : public AbstractDereferencedColumnTableScanImpl {
  public:
@@ -32,15 +36,18 @@ class ColumnVsValueTableScanImpl : public AbstractDereferencedColumnTableScanImp
   const AllTypeVariant value;
 
  protected:
-  void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_non_reference_segment(const AbstractSegment& segment, const ChunkID chunk_id,
+                                   pmr_vector<ChunkOffset>& matches,
                                    const std::shared_ptr<const AbstractPosList>& position_filter) override;
 
-  void _scan_generic_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_generic_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                              const std::shared_ptr<const AbstractPosList>& position_filter) const;
-  void _scan_dictionary_segment(const BaseDictionarySegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_dictionary_segment(const BaseDictionarySegment& segment, pmr_vector<ChunkOffset>& matches,
                                 const std::shared_ptr<const AbstractPosList>& position_filter);
+  void _scan_fsst_segment(const FSSTSegment<pmr_string>& segment, pmr_vector<ChunkOffset>& matches,
+                          const std::shared_ptr<const AbstractPosList>& position_filter) const;
 
-  void _scan_sorted_segment(const AbstractSegment& segment, const ChunkID chunk_id, RowIDPosList& matches,
+  void _scan_sorted_segment(const AbstractSegment& segment, pmr_vector<ChunkOffset>& matches,
                             const std::shared_ptr<const AbstractPosList>& position_filter,
                             const SortMode sort_mode) const;
 
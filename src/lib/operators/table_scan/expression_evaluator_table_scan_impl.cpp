@@ -1,19 +1,47 @@
 #include "expression_evaluator_table_scan_impl.hpp"
 
+#include <algorithm>
+
 #include "expression/evaluation/expression_evaluator.hpp"
 #include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// The ExpressionEvaluator and the compiled expressions produce RowIDs, all of which reference the scanned chunk
+pmr_vector<ChunkOffset> to_chunk_offsets(const RowIDPosList& pos_list) {
+  auto chunk_offsets = pmr_vector<ChunkOffset>(pos_list.size());
+  std::transform(pos_list.cbegin(), pos_list.cend(), chunk_offsets.begin(),
+                 [](const auto& row_id) { return row_id.chunk_offset; });
+  return chunk_offsets;
+}
+
+}  // namespace
 
 namespace opossum {
 
 ExpressionEvaluatorTableScanImpl::ExpressionEvaluatorTableScanImpl(
     const std::shared_ptr<const Table>& in_table, const std::shared_ptr<const AbstractExpression>& expression,
     const std::shared_ptr<const ExpressionEvaluator::UncorrelatedSubqueryResults>& uncorrelated_subquery_results)
-    : _in_table(in_table), _expression(expression), _uncorrelated_subquery_results(uncorrelated_subquery_results) {}
+    : _in_table(in_table), _expression(expression), _uncorrelated_subquery_results(uncorrelated_subquery_results) {
+  if (const auto& expression_compiler = Hyrise::get().expression_compiler) {
+    _compiled_expression = expression_compiler->compile(_expression);
+  }
+}
+
+std::string ExpressionEvaluatorTableScanImpl::description() const {
+  return _compiled_expression ? "CompiledExpression" : "ExpressionEvaluator";
+}
 
-std::string ExpressionEvaluatorTableScanImpl::description() const { return "ExpressionEvaluator"; }
+pmr_vector<ChunkOffset> ExpressionEvaluatorTableScanImpl::scan_chunk(ChunkID chunk_id) {
+  if (_compiled_expression) {
+    return to_chunk_offsets(_compiled_expression->evaluate_to_pos_list(*_in_table, chunk_id));
+  }
 
-std::shared_ptr<RowIDPosList> ExpressionEvaluatorTableScanImpl::scan_chunk(ChunkID chunk_id) {
-  return std::make_shared<RowIDPosList>(
+  return to_chunk_offsets(
       ExpressionEvaluator{_in_table, chunk_id, _uncorrelated_subquery_results}.evaluate_expression_to_pos_list(
           *_expression));
 }
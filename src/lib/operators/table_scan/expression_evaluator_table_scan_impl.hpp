@@ -2,6 +2,7 @@
 
 #include "abstract_table_scan_impl.hpp"
 #include "expression/abstract_expression.hpp"
+#include "expression/evaluation/expression_compiler.hpp"
 #include "expression/evaluation/expression_evaluator.hpp"
 
 namespace opossum {
@@ -13,6 +14,8 @@ class UncorrelatedSubqueryResults;
  * Uses the ExpressionEvaluator::evaluate_expression_to_pos_list() for a fallback implementation of the
  * AbstractTableScanImpl. This is likely slower than any specialized `AbstractTableScanImpl` and should thus only be
  * used if a particular expression type doesn't have a specialized `AbstractTableScanImpl`.
+ *
+ * If Hyrise::get().expression_compiler is set and can compile the expression, the compiled expression is used instead.
  */
 class ExpressionEvaluatorTableScanImpl : public AbstractTableScanImpl {
  public:
@@ -21,12 +24,13 @@ class ExpressionEvaluatorTableScanImpl : public AbstractTableScanImpl {
       const std::shared_ptr<const ExpressionEvaluator::UncorrelatedSubqueryResults>& uncorrelated_subquery_results);
 
   std::string description() const override;
-  std::shared_ptr<RowIDPosList> scan_chunk(ChunkID chunk_id) override;
+  pmr_vector<ChunkOffset> scan_chunk(ChunkID chunk_id) override;
 
  private:
   std::shared_ptr<const Table> _in_table;
   std::shared_ptr<const AbstractExpression> _expression;
   const std::shared_ptr<const ExpressionEvaluator::UncorrelatedSubqueryResults> _uncorrelated_subquery_results;
+  std::shared_ptr<const CompiledExpression> _compiled_expression;
 };
 
 }  // namespace opossum
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include "storage/fsst_segment.hpp"
+#include "storage/pos_lists/abstract_pos_list.hpp"
+#include "storage/segment_access_counter.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Scans an FSSTSegment on the codes of its values (see FSSTSegment::compressed_value()) instead of decompressing them.
+ * `predicate` is called with the codes of every non-null row, null values never match. Like in _scan_with_iterators,
+ * the matches are appended to `matches` with their position in `position_filter` as the chunk offset, if one is given.
+ */
+template <typename Predicate>
+void scan_fsst_segment(const FSSTSegment<pmr_string>& segment, pmr_vector<ChunkOffset>& matches,
+                       const std::shared_ptr<const AbstractPosList>& position_filter, const Predicate& predicate) {
+  const auto& null_values = segment.null_values();
+
+  if (!position_filter) {
+    const auto segment_size = segment.size();
+    segment.access_counter[SegmentAccessCounter::AccessType::Sequential] += segment_size;
+
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+      if (null_values && (*null_values)[chunk_offset]) continue;
+      if (predicate(segment.compressed_value(chunk_offset))) {
+        matches.emplace_back(chunk_offset);
+      }
+    }
+    return;
+  }
+
+  const auto position_filter_size = static_cast<ChunkOffset>(position_filter->size());
+  segment.access_counter[SegmentAccessCounter::access_type(*position_filter)] += position_filter_size;
+
+  for (auto offset_in_poslist = ChunkOffset{0}; offset_in_poslist < position_filter_size; ++offset_in_poslist) {
+    const auto chunk_offset = (*position_filter)[offset_in_poslist].chunk_offset;
+    if (null_values && (*null_values)[chunk_offset]) continue;
+    if (predicate(segment.compressed_value(chunk_offset))) {
+      matches.emplace_back(offset_in_poslist);
+    }
+  }
+}
+
+}  // namespace opossum
@@ -9,7 +9,6 @@
 
 #include "all_type_variant.hpp"
 #include "constant_mappings.hpp"
-#include "storage/pos_lists/row_id_pos_list.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -265,8 +264,7 @@ class SortedSegmentSearch {
   }
 
   template <typename ResultIteratorType>
-  void _write_rows_to_matches(ResultIteratorType begin, ResultIteratorType end, const ChunkID chunk_id,
-                              RowIDPosList& matches,
+  void _write_rows_to_matches(ResultIteratorType begin, ResultIteratorType end, pmr_vector<ChunkOffset>& matches,
                               const std::shared_ptr<const AbstractPosList>& position_filter) const {
     if (begin == end) return;
 
@@ -287,14 +285,14 @@ class SortedSegmentSearch {
      */
     if (position_filter || _predicate_condition == PredicateCondition::NotEquals) {
       for (; begin != end; ++begin) {
-        matches[output_idx++] = RowID{chunk_id, begin->chunk_offset()};
+        matches[output_idx++] = begin->chunk_offset();
       }
     } else {
       const auto first_offset = begin->chunk_offset();
       const auto distance = std::distance(begin, end);
 
       for (auto chunk_offset = 0; chunk_offset < distance; ++chunk_offset) {
-        matches[output_idx++] = RowID{chunk_id, first_offset + chunk_offset};
+        matches[output_idx++] = first_offset + chunk_offset;
       }
     }
   }
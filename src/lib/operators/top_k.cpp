@@ -0,0 +1,245 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "operators/sort.hpp"
+#include "operators/sort_helper/sort_column_comparator.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns a negative value, zero, or a positive value if lhs is ordered before, equal to, or after rhs. As in the Sort
+// operator, NULLs are ordered before all values, independent of the sort mode.
+template <typename T>
+int compare_values(const bool lhs_is_null, const T& lhs, const bool rhs_is_null, const T& rhs,
+                   const SortMode sort_mode) {
+  if (lhs_is_null || rhs_is_null) return static_cast<int>(!lhs_is_null) - static_cast<int>(!rhs_is_null);
+  if (lhs == rhs) return 0;
+  return (lhs < rhs) == (sort_mode == SortMode::Ascending) ? -1 : 1;
+}
+
+// A row that might be part of the result, together with its value in the first sort column
+template <typename T>
+struct Candidate {
+  RowID row_id;
+  bool is_null;
+  T value;
+};
+
+// Orders rows by all sort columns and, if they are equal in all of them, by their position in the input table. The
+// latter makes the result equal to that of the (stable) Sort. Not thread-safe, as the accessors are created lazily.
+template <typename T>
+class RowComparator {
+ public:
+  RowComparator(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions)
+      : _first_sort_mode{sort_definitions.front().sort_mode},
+        _column_comparators{create_sort_column_comparators(table, sort_definitions, 1)} {}
+
+  bool ordered_before(const bool lhs_is_null, const T& lhs_value, const RowID& lhs_row_id, const bool rhs_is_null,
+                      const T& rhs_value, const RowID& rhs_row_id) const {
+    const auto first_column_result = compare_values(lhs_is_null, lhs_value, rhs_is_null, rhs_value, _first_sort_mode);
+    if (first_column_result != 0) return first_column_result < 0;
+
+    for (const auto& column_comparator : _column_comparators) {
+      const auto result = column_comparator->compare(lhs_row_id, rhs_row_id);
+      if (result != 0) return result < 0;
+    }
+
+    return lhs_row_id < rhs_row_id;
+  }
+
+  bool operator()(const Candidate<T>& lhs, const Candidate<T>& rhs) const {
+    return ordered_before(lhs.is_null, lhs.value, lhs.row_id, rhs.is_null, rhs.value, rhs.row_id);
+  }
+
+ private:
+  const SortMode _first_sort_mode;
+  const SortColumnComparators _column_comparators;
+};
+
+// Returns the (at most) row_count candidates of the chunk that are ordered first, in no particular order
+template <typename T>
+std::vector<Candidate<T>> select_chunk_candidates(const Table& table, const ChunkID chunk_id,
+                                                  const std::vector<SortColumnDefinition>& sort_definitions,
+                                                  const size_t row_count) {
+  const auto comparator = RowComparator<T>{table, sort_definitions};
+  const auto heap_comparator = [&comparator](const auto& lhs, const auto& rhs) { return comparator(lhs, rhs); };
+
+  const auto& chunk = *table.get_chunk(chunk_id);
+
+  // Max-heap of the candidates found so far. Its top is the candidate that is ordered last and the first one to be
+  // replaced by a better row.
+  auto heap = std::vector<Candidate<T>>{};
+  heap.reserve(std::min(row_count, static_cast<size_t>(chunk.size())));
+
+  segment_iterate<T>(*chunk.get_segment(sort_definitions.front().column), [&](const auto& position) {
+    const auto row_id = RowID{chunk_id, position.chunk_offset()};
+
+    if (heap.size() == row_count) {
+      // As rows are visited in the order of their positions, a row that equals the top in all sort columns is rejected
+      const auto& top = heap.front();
+      if (!comparator.ordered_before(position.is_null(), position.value(), row_id, top.is_null, top.value,
+                                     top.row_id)) {
+        return;
+      }
+      std::pop_heap(heap.begin(), heap.end(), heap_comparator);
+      heap.pop_back();
+    }
+
+    heap.push_back(Candidate<T>{row_id, position.is_null(), position.value()});
+    std::push_heap(heap.begin(), heap.end(), heap_comparator);
+  });
+
+  return heap;
+}
+
+// Returns the positions of the first row_count rows of the table in sort order
+template <typename T>
+RowIDPosList select_rows(const Table& table, const std::vector<SortColumnDefinition>& sort_definitions,
+                         const size_t row_count) {
+  const auto chunk_count = table.chunk_count();
+  auto candidates_by_chunk = std::vector<std::vector<Candidate<T>>>(chunk_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    const auto select_candidates = [&, chunk_id]() {
+      candidates_by_chunk[chunk_id] = select_chunk_candidates<T>(table, chunk_id, sort_definitions, row_count);
+    };
+
+    // As in the TableScan, small chunks are processed directly, as a job would only add scheduling overhead
+    constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+    if (chunk->size() >= JOB_SPAWN_THRESHOLD && chunk_count > 1) {
+      jobs.emplace_back(std::make_shared<JobTask>(select_candidates));
+    } else {
+      select_candidates();
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  // Merge the candidates of all chunks
+  auto candidates = std::vector<Candidate<T>>{};
+  for (auto& chunk_candidates : candidates_by_chunk) {
+    candidates.insert(candidates.end(), std::make_move_iterator(chunk_candidates.begin()),
+                      std::make_move_iterator(chunk_candidates.end()));
+  }
+
+  const auto output_row_count = std::min(row_count, candidates.size());
+  const auto comparator = RowComparator<T>{table, sort_definitions};
+  std::partial_sort(candidates.begin(), candidates.begin() + output_row_count, candidates.end(),
+                    [&comparator](const auto& lhs, const auto& rhs) { return comparator(lhs, rhs); });
+
+  auto pos_list = RowIDPosList(output_row_count);
+  for (auto row_index = size_t{0}; row_index < output_row_count; ++row_index) {
+    pos_list[row_index] = candidates[row_index].row_id;
+  }
+  return pos_list;
+}
+
+}  // namespace
+
+namespace opossum {
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const std::shared_ptr<AbstractExpression>& row_count_expression, const ChunkOffset output_chunk_size)
+    : AbstractReadOnlyOperator(OperatorType::TopK, in),
+      _sort_definitions(sort_definitions),
+      _row_count_expression(row_count_expression),
+      _output_chunk_size(output_chunk_size) {
+  DebugAssert(!_sort_definitions.empty(), "Expected at least one sort criterion");
+}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+std::shared_ptr<AbstractExpression> TopK::row_count_expression() const { return _row_count_expression; }
+
+const std::string& TopK::name() const {
+  static const auto name = std::string{"TopK"};
+  return name;
+}
+
+std::string TopK::description(DescriptionMode description_mode) const {
+  const auto* const separator = description_mode == DescriptionMode::SingleLine ? " " : "\n";
+
+  std::stringstream stream;
+  stream << AbstractOperator::description(description_mode) << separator << "Rows: "
+         << _row_count_expression->as_column_name() << separator << "Sort:";
+  for (const auto& sort_definition : _sort_definitions) {
+    stream << " " << sort_definition.column << " " << sort_definition.sort_mode;
+  }
+  return stream.str();
+}
+
+std::shared_ptr<AbstractOperator> TopK::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_left_input,
+    const std::shared_ptr<AbstractOperator>& copied_right_input,
+    std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
+  return std::make_shared<TopK>(copied_left_input, _sort_definitions, _row_count_expression->deep_copy(copied_ops),
+                                _output_chunk_size);
+}
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto input_table = left_input_table();
+
+  for (const auto& sort_definition : _sort_definitions) {
+    Assert(sort_definition.column < input_table->column_count(), "TopK: Invalid column in sort definition");
+  }
+
+  // Evaluate the _row_count_expression as in the Limit operator
+  auto row_count = size_t{};
+  resolve_data_type(_row_count_expression->data_type(), [&](const auto data_type_t) {
+    using LimitDataType = typename decltype(data_type_t)::type;
+
+    if constexpr (std::is_integral_v<LimitDataType>) {
+      const auto row_count_expression_result =
+          ExpressionEvaluator{}.evaluate_expression_to_result<LimitDataType>(*_row_count_expression);
+      Assert(row_count_expression_result->size() == 1, "Expected exactly one row for TopK");
+      Assert(!row_count_expression_result->is_null(0), "Expected non-null for TopK");
+
+      const auto signed_row_count = row_count_expression_result->value(0);
+      Assert(signed_row_count >= 0, "Can't TopK to a negative number of Rows");
+
+      row_count = static_cast<size_t>(signed_row_count);
+    } else {
+      Fail("Non-integral types not allowed in TopK");
+    }
+  });
+
+  if (row_count == 0 || input_table->row_count() == 0) {
+    return std::make_shared<Table>(input_table->column_definitions(), TableType::References);
+  }
+
+  auto pos_list = RowIDPosList{};
+  resolve_data_type(input_table->column_data_type(_sort_definitions.front().column), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+    pos_list = select_rows<ColumnDataType>(*input_table, _sort_definitions, row_count);
+  });
+
+  return Sort::write_output_table(input_table, std::move(pos_list), _sort_definitions, _output_chunk_size,
+                                  Sort::ForceMaterialization::No);
+}
+
+void TopK::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  expression_set_parameters(_row_count_expression, parameters);
+}
+
+void TopK::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  expression_set_transaction_context(_row_count_expression, transaction_context);
+}
+
+}  // namespace opossum
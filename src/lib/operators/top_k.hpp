@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "expression/abstract_expression.hpp"
+#include "storage/chunk.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Returns the first `row_count` rows of the input in the order given by the sort definitions. The result is equal to
+ * that of a Sort followed by a Limit, including the stability of the Sort and NULLs being ordered before all values.
+ *
+ * Instead of sorting the entire input, every chunk is scanned once, during which a bounded heap keeps the chunk's best
+ * `row_count` rows. Most rows are rejected by a single comparison with the top of the heap. The chunks are processed
+ * in parallel, and their candidates are merged by a partial sort. Thus, the memory consumption is O(row_count) per
+ * chunk instead of O(input rows).
+ *
+ * The LQPTranslator creates a TopK for a LimitNode on top of a SortNode.
+ */
+class TopK : public AbstractReadOnlyOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const std::shared_ptr<AbstractExpression>& row_count_expression,
+       const ChunkOffset output_chunk_size = Chunk::DEFAULT_SIZE);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+  std::shared_ptr<AbstractExpression> row_count_expression() const;
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_left_input,
+      const std::shared_ptr<AbstractOperator>& copied_right_input,
+      std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const std::shared_ptr<AbstractExpression> _row_count_expression;
+  const ChunkOffset _output_chunk_size;
+};
+
+}  // namespace opossum
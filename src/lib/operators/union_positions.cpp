@@ -10,6 +10,8 @@
 
 #include <boost/sort/sort.hpp>
 
+#include "hyrise.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/chunk.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
@@ -49,11 +51,23 @@
  *      _column_cluster_offsets = {0, 2, 3}
  *
  *
+ * ### Sorting
+ * The sorting is the most expensive part of this operator. Each VirtualPosList is split into runs, one per chunk of
+ * the input table. The runs are sorted in parallel and then merged pairwise, again in parallel. Runs that are already
+ * in order (e.g., the outputs of two TableScans on consecutive chunks) are not merged at all.
+ *
+ *
+ * ### Bitmaps
+ * If both inputs consist of a single ColumnCluster, i.e., they reference a single table with one pos list per chunk
+ * (as it is the case for OR predicates that were split into two TableScans), sorting is avoided altogether. Instead,
+ * each RowID of both inputs is marked in a bitmap per chunk of the referenced table. The bitmaps are then scanned in
+ * order, which yields the RowIDs sorted and without duplicates. Since the bitmaps are scanned completely, they are only
+ * used if the inputs hold a considerable number of rows compared to the referenced table (see BITMAP_MIN_DENSITY).
+ *
+ *
  * ### TODO(anybody) for potential performance improvements
  * Instead of using a ReferenceMatrix, consider using a linked list of RowIDs for each row. Since most of the sorting
  *      will depend on the leftmost column, this way most of the time no remote memory would need to be accessed
- *
- * The sorting, which is the most expensive part of this operator, could probably be parallelized.
  */
 namespace opossum {
 
@@ -85,46 +99,12 @@ std::shared_ptr<const Table> UnionPositions::_on_execute() {
 
   const auto& left_in_table = *left_input_table();
 
-  /**
-   * For each input, create a ReferenceMatrix
-   */
-  auto reference_matrix_left = _build_reference_matrix(left_input_table());
-  auto reference_matrix_right = _build_reference_matrix(right_input_table());
-
-  /**
-   * Init the virtual pos lists
-   */
-  VirtualPosList virtual_pos_list_left(left_in_table.row_count(), 0u);
-  std::iota(virtual_pos_list_left.begin(), virtual_pos_list_left.end(), 0u);
-  VirtualPosList virtual_pos_list_right(right_input_table()->row_count(), 0u);
-  std::iota(virtual_pos_list_right.begin(), virtual_pos_list_right.end(), 0u);
-
-  /**
-   * Sort the virtual pos lists so that they bring the rows in their respective ReferenceMatrix into order.
-   * This is necessary for merging them.
-   * Performance note: These sorts take the vast majority of time spent in this operator. Using boost's pdqsort helps
-   * a lot over std::sort, but there is probably still room for improvement (see comment above about other data
-   * structures). The reason why pdqsort can be much faster than std::sort is that is more efficient for already sorted
-   * data, which happens when no "shuffling" operators (e.g., inner joins) occur before the UnionPosition so the
-   * position lists are already sorted. For cases where the input is not sorted, pdqsort is usually still more than 20%
-   * faster than std::sort.
-   */
-  boost::sort::pdqsort(virtual_pos_list_left.begin(), virtual_pos_list_left.end(),
-                       VirtualPosListCmpContext{reference_matrix_left});
-  boost::sort::pdqsort(virtual_pos_list_right.begin(), virtual_pos_list_right.end(),
-                       VirtualPosListCmpContext{reference_matrix_right});
-
   /**
    * Build result table
    */
-  auto left_idx = size_t{0};
-  auto right_idx = size_t{0};
-  const auto num_rows_left = virtual_pos_list_left.size();
-  const auto num_rows_right = virtual_pos_list_right.size();
-
   auto out_table = std::make_shared<Table>(left_in_table.column_definitions(), TableType::References);
 
-  std::vector<std::shared_ptr<RowIDPosList>> pos_lists(reference_matrix_left.size());
+  std::vector<std::shared_ptr<RowIDPosList>> pos_lists(_column_cluster_offsets.size());
   std::generate(pos_lists.begin(), pos_lists.end(), [&] { return std::make_shared<RowIDPosList>(); });
 
   // Adds the row `row_idx` from `reference_matrix` to the pos_lists we're currently building
@@ -153,31 +133,98 @@ std::shared_ptr<const Table> UnionPositions::_on_execute() {
     out_table->append_chunk(output_segments);
   };
 
+  const auto out_chunk_size = Chunk::DEFAULT_SIZE;
+  size_t chunk_row_idx = 0;
+
+  // Emits a chunk once it has been filled
+  const auto finish_row = [&]() {
+    ++chunk_row_idx;
+
+    if (chunk_row_idx == out_chunk_size && out_chunk_size != 0) {
+      emit_chunk();
+
+      chunk_row_idx = 0;
+      std::generate(pos_lists.begin(), pos_lists.end(), [&] { return std::make_shared<RowIDPosList>(); });
+    }
+  };
+
+  const auto referenced_row_count = static_cast<size_t>(_referenced_tables.front()->row_count());
+  if (_column_cluster_offsets.size() == 1 &&
+      left_in_table.row_count() + right_input_table()->row_count() >= referenced_row_count / BITMAP_MIN_DENSITY) {
+    for (const auto& row_id : _union_by_bitmaps()) {
+      pos_lists.front()->emplace_back(row_id);
+      finish_row();
+    }
+
+    if (chunk_row_idx != 0) {
+      emit_chunk();
+    }
+
+    return out_table;
+  }
+
+  /**
+   * For each input, create a ReferenceMatrix
+   */
+  auto reference_matrix_left = _build_reference_matrix(left_input_table());
+  auto reference_matrix_right = _build_reference_matrix(right_input_table());
+
+  /**
+   * Init the virtual pos lists
+   */
+  VirtualPosList virtual_pos_list_left(left_in_table.row_count(), 0u);
+  std::iota(virtual_pos_list_left.begin(), virtual_pos_list_left.end(), 0u);
+  VirtualPosList virtual_pos_list_right(right_input_table()->row_count(), 0u);
+  std::iota(virtual_pos_list_right.begin(), virtual_pos_list_right.end(), 0u);
+
+  /**
+   * Sort the virtual pos lists so that they bring the rows in their respective ReferenceMatrix into order.
+   * This is necessary for merging them. See _sort_virtual_pos_list().
+   */
+  _sort_virtual_pos_list(virtual_pos_list_left, reference_matrix_left, left_in_table);
+  _sort_virtual_pos_list(virtual_pos_list_right, reference_matrix_right, *right_input_table());
+
+  auto left_idx = size_t{0};
+  auto right_idx = size_t{0};
+  const auto num_rows_left = virtual_pos_list_left.size();
+  const auto num_rows_right = virtual_pos_list_right.size();
+
   /**
    * This loop merges reference_matrix_left and reference_matrix_right into the result table. The implementation is
-   * derived from std::set_union() and only differs from it insofar as that it builds the output table at the same
-   * time as merging the two ReferenceMatrices
+   * derived from std::set_union() and differs from it insofar as that it builds the output table at the same time as
+   * merging the two ReferenceMatrices and that it also drops duplicates within one input (as the bitmaps do).
    */
+  const ReferenceMatrix* previous_reference_matrix = nullptr;
+  auto previous_row_idx = size_t{0};
+  const auto emit_unique_row = [&](const ReferenceMatrix& reference_matrix, size_t row_idx) {
+    // The rows are emitted in order, so a duplicate is equal to the previously emitted row
+    if (previous_reference_matrix && !_compare_reference_matrix_rows(*previous_reference_matrix, previous_row_idx,
+                                                                     reference_matrix, row_idx)) {
+      return;
+    }
+    previous_reference_matrix = &reference_matrix;
+    previous_row_idx = row_idx;
 
-  const auto out_chunk_size = Chunk::DEFAULT_SIZE;
+    emit_row(reference_matrix, row_idx);
+    finish_row();
+  };
 
-  size_t chunk_row_idx = 0;
   for (; left_idx < num_rows_left || right_idx < num_rows_right;) {
     /**
      * Begin derived from std::union()
      */
     if (left_idx == num_rows_left) {  // NOLINT(bugprone-branch-clone)
-      emit_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
+      emit_unique_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
       ++right_idx;
     } else if (right_idx == num_rows_right) {
-      emit_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
+      emit_unique_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
       ++left_idx;
     } else if (_compare_reference_matrix_rows(reference_matrix_right, virtual_pos_list_right[right_idx],
                                               reference_matrix_left, virtual_pos_list_left[left_idx])) {
-      emit_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
+      emit_unique_row(reference_matrix_right, virtual_pos_list_right[right_idx]);
       ++right_idx;
     } else {
-      emit_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
+      emit_unique_row(reference_matrix_left, virtual_pos_list_left[left_idx]);
 
       if (!_compare_reference_matrix_rows(reference_matrix_left, virtual_pos_list_left[left_idx],
                                           reference_matrix_right, virtual_pos_list_right[right_idx])) {
@@ -185,20 +232,9 @@ std::shared_ptr<const Table> UnionPositions::_on_execute() {
       }
       ++left_idx;
     }
-    ++chunk_row_idx;
     /**
      * End derived from std::union()
      */
-
-    /**
-     * Emit a completed chunk
-     */
-    if (chunk_row_idx == out_chunk_size && out_chunk_size != 0) {
-      emit_chunk();
-
-      chunk_row_idx = 0;
-      std::generate(pos_lists.begin(), pos_lists.end(), [&] { return std::make_shared<RowIDPosList>(); });
-    }
   }
 
   if (chunk_row_idx != 0) {
@@ -347,6 +383,143 @@ UnionPositions::ReferenceMatrix UnionPositions::_build_reference_matrix(
   return reference_matrix;
 }
 
+void UnionPositions::_sort_virtual_pos_list(VirtualPosList& virtual_pos_list,
+                                            const ReferenceMatrix& reference_matrix, const Table& input_table) {
+  /**
+   * Performance note: Using boost's pdqsort helps a lot over std::sort. The reason why pdqsort can be much faster than
+   * std::sort is that is more efficient for already sorted data, which happens when no "shuffling" operators (e.g.,
+   * inner joins) occur before the UnionPosition so the position lists are already sorted. For cases where the input is
+   * not sorted, pdqsort is usually still more than 20% faster than std::sort.
+   */
+  const auto comparator = VirtualPosListCmpContext{reference_matrix};
+
+  // The rows of each input chunk form a run. Its first row is at run_offsets[run_idx].
+  auto run_offsets = std::vector<size_t>{0};
+  const auto chunk_count = input_table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = input_table.get_chunk(chunk_id);
+    Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    if (chunk->size() > 0) {
+      run_offsets.emplace_back(run_offsets.back() + chunk->size());
+    }
+  }
+  DebugAssert(run_offsets.back() == virtual_pos_list.size(), "Runs do not cover the virtual pos list");
+
+  const auto begin = virtual_pos_list.begin();
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto run_idx = size_t{0}; run_idx + 1 < run_offsets.size(); ++run_idx) {
+    const auto run_begin = run_offsets[run_idx];
+    const auto run_end = run_offsets[run_idx + 1];
+    const auto sort_run = [&, run_begin, run_end]() {
+      boost::sort::pdqsort(begin + run_begin, begin + run_end, comparator);
+    };
+
+    if (run_end - run_begin > JOB_SPAWN_THRESHOLD) {
+      jobs.emplace_back(std::make_shared<JobTask>(sort_run));
+    } else {
+      sort_run();
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  // Merge neighboring runs until a single run is left. In each round, the pairs of runs are merged in parallel.
+  while (run_offsets.size() > 2) {
+    jobs.clear();
+    auto merged_run_offsets = std::vector<size_t>{};
+    merged_run_offsets.reserve(run_offsets.size() / 2 + 2);
+
+    for (auto run_idx = size_t{0}; run_idx + 1 < run_offsets.size(); run_idx += 2) {
+      merged_run_offsets.emplace_back(run_offsets[run_idx]);
+      if (run_idx + 2 >= run_offsets.size()) {
+        // Odd number of runs, the last run is merged in a later round
+        break;
+      }
+
+      const auto first = run_offsets[run_idx];
+      const auto middle = run_offsets[run_idx + 1];
+      const auto last = run_offsets[run_idx + 2];
+
+      // Skip runs that are already in order
+      if (!comparator(*(begin + middle), *(begin + middle - 1))) {
+        continue;
+      }
+
+      const auto merge_runs = [&, first, middle, last]() {
+        std::inplace_merge(begin + first, begin + middle, begin + last, comparator);
+      };
+
+      if (last - first > JOB_SPAWN_THRESHOLD) {
+        jobs.emplace_back(std::make_shared<JobTask>(merge_runs));
+      } else {
+        merge_runs();
+      }
+    }
+    merged_run_offsets.emplace_back(run_offsets.back());
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+    run_offsets = std::move(merged_run_offsets);
+  }
+}
+
+RowIDPosList UnionPositions::_union_by_bitmaps() const {
+  DebugAssert(_column_cluster_offsets.size() == 1, "Bitmaps can only be used for a single ColumnCluster");
+
+  const auto& referenced_table = *_referenced_tables.front();
+  auto bitmaps = std::vector<std::vector<uint64_t>>(referenced_table.chunk_count());
+  auto contains_null = false;
+
+  const auto mark_rows = [&](const Table& input_table) {
+    const auto chunk_count = input_table.chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto segment = input_table.get_chunk(chunk_id)->get_segment(ColumnID{0});
+      const auto pos_list = std::static_pointer_cast<const ReferenceSegment>(segment)->pos_list();
+
+      for (const auto& row_id : *pos_list) {
+        if (row_id.is_null()) {
+          contains_null = true;
+          continue;
+        }
+
+        // The bitmaps are only allocated for the chunks that are referenced
+        auto& bitmap = bitmaps[row_id.chunk_id];
+        if (bitmap.empty()) {
+          const auto referenced_chunk = referenced_table.get_chunk(row_id.chunk_id);
+          Assert(referenced_chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+          bitmap.resize((referenced_chunk->size() + 63) / 64);
+        }
+        bitmap[row_id.chunk_offset / 64] |= uint64_t{1} << (row_id.chunk_offset % 64);
+      }
+    }
+  };
+  mark_rows(*left_input_table());
+  mark_rows(*right_input_table());
+
+  auto row_ids = RowIDPosList{};
+  row_ids.reserve(std::max(left_input_table()->row_count(), right_input_table()->row_count()));
+
+  const auto chunk_count = static_cast<ChunkID::base_type>(bitmaps.size());
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto& bitmap = bitmaps[chunk_id];
+    for (auto word_idx = size_t{0}; word_idx < bitmap.size(); ++word_idx) {
+      auto word = bitmap[word_idx];
+      while (word) {
+        const auto bit = static_cast<ChunkOffset>(word_idx * 64 + __builtin_ctzll(word));
+        row_ids.emplace_back(RowID{chunk_id, bit});
+        word &= word - 1;
+      }
+    }
+  }
+
+  // NULL_ROW_ID is ordered after all other RowIDs
+  if (contains_null) {
+    row_ids.emplace_back(NULL_ROW_ID);
+  }
+
+  return row_ids;
+}
+
 bool UnionPositions::_compare_reference_matrix_rows(const ReferenceMatrix& left_matrix, size_t left_row_idx,
                                                     const ReferenceMatrix& right_matrix, size_t right_row_idx) {
   for (size_t column_idx = 0; column_idx < left_matrix.size(); ++column_idx) {
@@ -74,6 +74,14 @@ class UnionPositions : public AbstractReadOnlyOperator {
 
   const std::string& name() const override;
 
+  // The runs of the virtual pos lists are sorted and merged in separate jobs if they have more than
+  // JOB_SPAWN_THRESHOLD rows. If not, they are sorted and merged directly.
+  static constexpr auto JOB_SPAWN_THRESHOLD = size_t{10'000};
+
+  // Bitmaps are used if the inputs reference a single table and hold at least one row per BITMAP_MIN_DENSITY rows of
+  // that table. See the docs at the top of the cpp.
+  static constexpr auto BITMAP_MIN_DENSITY = size_t{64};
+
  private:
   // See docs at the top of the cpp
   using ReferenceMatrix = std::vector<opossum::RowIDPosList>;
@@ -84,7 +92,7 @@ class UnionPositions : public AbstractReadOnlyOperator {
    * Needs to know about the ReferenceMatrix that the VirtualPosList references and is thus dubbed a "Context".
    */
   struct VirtualPosListCmpContext {
-    ReferenceMatrix& reference_matrix;
+    const ReferenceMatrix& reference_matrix;
     bool operator()(size_t left, size_t right) const;
   };
 
@@ -111,6 +119,14 @@ class UnionPositions : public AbstractReadOnlyOperator {
   std::shared_ptr<const Table> _prepare_operator();
 
   UnionPositions::ReferenceMatrix _build_reference_matrix(const std::shared_ptr<const Table>& input_table) const;
+
+  // Sorts the rows of each input chunk in parallel and merges them afterwards
+  static void _sort_virtual_pos_list(VirtualPosList& virtual_pos_list, const ReferenceMatrix& reference_matrix,
+                                     const Table& input_table);
+
+  // Returns the sorted RowIDs of both inputs without duplicates. Requires a single ColumnCluster.
+  RowIDPosList _union_by_bitmaps() const;
+
   static bool _compare_reference_matrix_rows(const ReferenceMatrix& left_matrix, size_t left_row_idx,
                                              const ReferenceMatrix& right_matrix, size_t right_row_idx);
 
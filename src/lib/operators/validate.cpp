@@ -10,6 +10,7 @@
 #include "operators/delete.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/pos_lists/entire_chunk_pos_list.hpp"
+#include "storage/pos_lists/selection_vector_pos_list.hpp"
 #include "storage/reference_segment.hpp"
 #include "utils/assert.hpp"
 
@@ -193,14 +194,16 @@ void Validate::_validate_chunks(const std::shared_ptr<const Table>& in_table, co
           // this shortcut to keep the code short.
           pos_list_out = pos_list_in;
         } else {
-          RowIDPosList temp_pos_list;
-          temp_pos_list.guarantee_single_chunk();
+          // All visible rows are in the same chunk, so only their ChunkOffsets are stored
+          auto chunk_offsets = pmr_vector<ChunkOffset>{};
+          chunk_offsets.reserve(pos_list_in->size());
           for (auto row_id : *pos_list_in) {
             if (opossum::is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_data)) {
-              temp_pos_list.emplace_back(row_id);
+              chunk_offsets.emplace_back(row_id.chunk_offset);
             }
           }
-          pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
+          pos_list_out =
+              std::make_shared<const SelectionVectorPosList>(pos_list_in->common_chunk_id(), std::move(chunk_offsets));
         }
       } else {
         // Slow path - we are looking at multiple referenced chunks and have to look at each row individually. We first
@@ -259,17 +262,16 @@ void Validate::_validate_chunks(const std::shared_ptr<const Table>& in_table, co
         pos_list_out = std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size());
       } else {
         const auto mvcc_data = chunk_in->mvcc_data();
-        RowIDPosList temp_pos_list;
-        temp_pos_list.reserve(expected_number_of_valid_rows);
-        temp_pos_list.guarantee_single_chunk();
+        auto chunk_offsets = pmr_vector<ChunkOffset>{};
+        chunk_offsets.reserve(expected_number_of_valid_rows);
         // Generate pos_list_out.
         auto chunk_size = chunk_in->size();  // The compiler fails to optimize this in the for clause :(
         for (auto i = 0u; i < chunk_size; i++) {
           if (opossum::is_row_visible(our_tid, snapshot_commit_id, i, *mvcc_data)) {
-            temp_pos_list.emplace_back(RowID{chunk_id, i});
+            chunk_offsets.emplace_back(i);
           }
         }
-        pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
+        pos_list_out = std::make_shared<const SelectionVectorPosList>(chunk_id, std::move(chunk_offsets));
       }
 
       // Create actual ReferenceSegment objects.
@@ -17,6 +17,7 @@
 #include "utils/assert.hpp"
 
 #include "storage/pos_lists/entire_chunk_pos_list.hpp"
+#include "storage/pos_lists/selection_vector_pos_list.hpp"
 
 namespace opossum {
 
@@ -146,6 +147,9 @@ void resolve_pos_list_type(const std::shared_ptr<const AbstractPosList>& untyped
     } else if (const auto entire_chunk_pos_list =
                    std::dynamic_pointer_cast<const EntireChunkPosList>(untyped_pos_list)) {
       functor(entire_chunk_pos_list);
+    } else if (const auto selection_vector_pos_list =
+                   std::dynamic_pointer_cast<const SelectionVectorPosList>(untyped_pos_list)) {
+      functor(selection_vector_pos_list);
     } else {
       Fail("Unrecognized PosList type encountered");
     }
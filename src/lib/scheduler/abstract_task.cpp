@@ -13,6 +13,31 @@
 
 #include "utils/assert.hpp"
 
+namespace {
+
+// The priority of the task that is currently executed by this thread (see AbstractTask::schedule).
+thread_local auto current_task_priority = opossum::SchedulePriority::Default;
+
+// Sets current_task_priority for the lifetime of the object. The previous priority is restored even if the task
+// throws, so that tasks executed later by the same thread are not scheduled with the failed task's priority.
+class CurrentTaskPriorityGuard {
+ public:
+  explicit CurrentTaskPriorityGuard(const opossum::SchedulePriority priority)
+      : _previous_priority(current_task_priority) {
+    current_task_priority = priority;
+  }
+
+  ~CurrentTaskPriorityGuard() { current_task_priority = _previous_priority; }
+
+  CurrentTaskPriorityGuard(const CurrentTaskPriorityGuard&) = delete;
+  CurrentTaskPriorityGuard& operator=(const CurrentTaskPriorityGuard&) = delete;
+
+ private:
+  const opossum::SchedulePriority _previous_priority;
+};
+
+}  // namespace
+
 namespace opossum {
 
 AbstractTask::AbstractTask(SchedulePriority priority, bool stealable) : _priority(priority), _stealable(stealable) {}
@@ -27,6 +52,13 @@ bool AbstractTask::is_done() const { return _state == TaskState::Done; }
 
 bool AbstractTask::is_stealable() const { return _stealable; }
 
+SchedulePriority AbstractTask::priority() const { return _priority; }
+
+void AbstractTask::set_priority(SchedulePriority priority) {
+  DebugAssert(!is_scheduled(), "Possible race: Don't set priority after the Task was scheduled");
+  _priority = priority;
+}
+
 bool AbstractTask::is_scheduled() const { return _state >= TaskState::Scheduled; }
 
 std::string AbstractTask::description() const {
@@ -81,6 +113,12 @@ void AbstractTask::schedule(NodeID preferred_node_id) {
   // Atomically marks the task as scheduled or returns if another thread has already scheduled it.
   if (!_try_transition_to(TaskState::Scheduled)) return;
 
+  // Tasks spawned by a low-priority task, e.g., the jobs of an operator of a low-priority query, must not compete with
+  // the tasks of other queries at the default priority.
+  if (_priority == SchedulePriority::Default && current_task_priority == SchedulePriority::Low) {
+    _priority = SchedulePriority::Low;
+  }
+
   Hyrise::get().scheduler()->schedule(shared_from_this(), preferred_node_id, _priority);
 }
 
@@ -107,7 +145,10 @@ void AbstractTask::execute() {
   // _is_scheduled and this assert (potentially in "thread" B) reads it, it is guaranteed that no writes of whoever
   // spawned the task are pushed down to a point where this thread is already running.
 
-  _on_execute();
+  {
+    const auto priority_guard = CurrentTaskPriorityGuard{_priority};
+    _on_execute();
+  }
 
   {
     auto success_done = _try_transition_to(TaskState::Done);
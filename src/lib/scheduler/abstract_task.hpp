@@ -107,6 +107,15 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
    */
   bool is_stealable() const;
 
+  SchedulePriority priority() const;
+
+  /**
+   * Changes the priority of a task that has not been scheduled yet, e.g., to assign a query's priority to all of its
+   * OperatorTasks. Tasks with SchedulePriority::Default that are scheduled while a task with SchedulePriority::Low is
+   * executed on the same thread inherit the low priority.
+   */
+  void set_priority(SchedulePriority priority);
+
   /**
    * Description for debugging purposes
    */
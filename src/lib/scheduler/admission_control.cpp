@@ -0,0 +1,82 @@
+#include "admission_control.hpp"
+
+#include <memory>
+#include <mutex>
+
+#include "utils/assert.hpp"
+#include "worker.hpp"
+
+namespace opossum {
+
+AdmissionControl::AdmissionControl(const size_t max_concurrent_queries)
+    : _max_concurrent_queries(max_concurrent_queries) {
+  Assert(max_concurrent_queries > 0, "At least one query must be admitted");
+}
+
+size_t AdmissionControl::max_concurrent_queries() const { return _max_concurrent_queries; }
+
+size_t AdmissionControl::admitted_query_count() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _admitted_query_count;
+}
+
+void AdmissionControl::admit(const SchedulePriority priority) {
+  auto lock = std::unique_lock<std::mutex>{_mutex};
+  if (_try_admit(priority)) return;
+
+  const auto priority_level = static_cast<size_t>(priority);
+  ++_waiting_query_counts[priority_level];
+
+  const auto worker = Worker::get_this_thread_worker();
+  if (worker) {
+    // Blocking the worker could deadlock the system if all workers wait for admission. Instead, help executing the
+    // tasks of other (admitted) queries.
+    while (!_try_admit(priority)) {
+      lock.unlock();
+      worker->_work();
+      lock.lock();
+    }
+  } else {
+    _released.wait(lock, [&]() { return _try_admit(priority); });
+  }
+
+  --_waiting_query_counts[priority_level];
+
+  // Queries of a lower priority might have been waiting for this one to be admitted first.
+  _released.notify_all();
+}
+
+void AdmissionControl::release() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Assert(_admitted_query_count > 0, "No query has been admitted");
+    --_admitted_query_count;
+  }
+  _released.notify_all();
+}
+
+bool AdmissionControl::_try_admit(const SchedulePriority priority) {
+  if (priority != SchedulePriority::High) {
+    if (_admitted_query_count >= _max_concurrent_queries) return false;
+
+    // Do not overtake waiting queries with a more urgent priority
+    for (auto priority_level = size_t{0}; priority_level < static_cast<size_t>(priority); ++priority_level) {
+      if (_waiting_query_counts[priority_level] > 0) return false;
+    }
+  }
+
+  ++_admitted_query_count;
+  return true;
+}
+
+AdmissionGuard::AdmissionGuard(const std::shared_ptr<AdmissionControl>& admission_control,
+                               const SchedulePriority priority)
+    : _admission_control(admission_control) {
+  if (_admission_control) _admission_control->admit(priority);
+}
+
+AdmissionGuard::~AdmissionGuard() {
+  if (_admission_control) _admission_control->release();
+}
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "scheduler/task_queue.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Limits the number of queries that are executed concurrently. When it is set in Hyrise::get().admission_control, the
+ * SQLPipelineStatement calls admit() before it schedules the tasks of a query and release() once they are done.
+ * Without a limit, a few large queries could flood the TaskQueues with their jobs, so that short queries that arrive
+ * later have to wait for many unrelated tasks before their own tasks are pulled.
+ *
+ * Queries with SchedulePriority::High are always admitted immediately (but count towards the limit). Waiting queries
+ * are admitted in the order of their priority, i.e., Default queries before Low ones.
+ *
+ * A worker thread that waits for admission (e.g., a benchmark client executing a query from within a JobTask)
+ * executes other tasks while it waits, so that the admitted queries can make progress. Other threads block.
+ */
+class AdmissionControl : public Noncopyable {
+ public:
+  explicit AdmissionControl(const size_t max_concurrent_queries);
+
+  size_t max_concurrent_queries() const;
+
+  // Number of queries that have been admitted but not yet released
+  size_t admitted_query_count() const;
+
+  void admit(const SchedulePriority priority);
+  void release();
+
+ private:
+  bool _try_admit(const SchedulePriority priority);
+
+  const size_t _max_concurrent_queries;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _released;
+  size_t _admitted_query_count{0};
+  std::array<size_t, TaskQueue::NUM_PRIORITY_LEVELS> _waiting_query_counts{};
+};
+
+/**
+ * Admits a query when it is created and releases it when it is destroyed, so that a query whose execution throws does
+ * not keep its slot. Does nothing if admission_control is nullptr (i.e., no limit is configured).
+ */
+class AdmissionGuard : public Noncopyable {
+ public:
+  AdmissionGuard(const std::shared_ptr<AdmissionControl>& admission_control, const SchedulePriority priority);
+  ~AdmissionGuard();
+
+ private:
+  const std::shared_ptr<AdmissionControl> _admission_control;
+};
+
+}  // namespace opossum
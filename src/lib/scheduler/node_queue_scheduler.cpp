@@ -7,6 +7,7 @@
 
 #include "abstract_task.hpp"
 #include "hyrise.hpp"
+#include "task_deque.hpp"
 #include "task_queue.hpp"
 #include "worker.hpp"
 
@@ -15,7 +16,9 @@
 
 namespace opossum {
 
-NodeQueueScheduler::NodeQueueScheduler() { _worker_id_allocator = std::make_shared<UidAllocator>(); }
+NodeQueueScheduler::NodeQueueScheduler(const bool use_worker_deques) : _use_worker_deques(use_worker_deques) {
+  _worker_id_allocator = std::make_shared<UidAllocator>();
+}
 
 NodeQueueScheduler::~NodeQueueScheduler() {
   if (HYRISE_DEBUG && _active) {
@@ -28,18 +31,43 @@ NodeQueueScheduler::~NodeQueueScheduler() {
 void NodeQueueScheduler::begin() {
   DebugAssert(!_active, "Scheduler is already active");
 
+  const auto& topology_nodes = Hyrise::get().topology.nodes();
   _workers.reserve(Hyrise::get().topology.num_cpus());
-  _queues.reserve(Hyrise::get().topology.nodes().size());
+  _queues.reserve(topology_nodes.size());
+
+  if (_use_worker_deques) {
+    // One deque per worker, created upfront so that every worker knows the deques it can steal from.
+    _deques.reserve(Hyrise::get().topology.num_cpus());
+    for (auto node_id = NodeID{0}; node_id < topology_nodes.size(); node_id++) {
+      for (auto cpu_index = size_t{0}; cpu_index < topology_nodes[node_id].cpus.size(); ++cpu_index) {
+        _deques.emplace_back(std::make_shared<TaskDeque>(node_id));
+      }
+    }
+  }
 
-  for (auto node_id = NodeID{0}; node_id < Hyrise::get().topology.nodes().size(); node_id++) {
+  for (auto node_id = NodeID{0}; node_id < topology_nodes.size(); node_id++) {
     auto queue = std::make_shared<TaskQueue>(node_id);
 
     _queues.emplace_back(queue);
 
-    const auto& topology_node = Hyrise::get().topology.nodes()[node_id];
-
-    for (const auto& topology_cpu : topology_node.cpus) {
-      _workers.emplace_back(std::make_shared<Worker>(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id));
+    for (const auto& topology_cpu : topology_nodes[node_id].cpus) {
+      if (!_use_worker_deques) {
+        _workers.emplace_back(std::make_shared<Worker>(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id));
+        continue;
+      }
+
+      // Workers steal from the deques of their own node before they access remote nodes.
+      const auto& deque = _deques[_workers.size()];
+      auto steal_victims = std::vector<std::shared_ptr<TaskDeque>>{};
+      for (const auto& other_deque : _deques) {
+        if (other_deque != deque && other_deque->node_id() == node_id) steal_victims.emplace_back(other_deque);
+      }
+      for (const auto& other_deque : _deques) {
+        if (other_deque->node_id() != node_id) steal_victims.emplace_back(other_deque);
+      }
+
+      _workers.emplace_back(std::make_shared<Worker>(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id,
+                                                     deque, steal_victims));
     }
   }
 
@@ -81,6 +109,7 @@ void NodeQueueScheduler::finish() {
 
   _workers = {};
   _queues = {};
+  _deques = {};
   _task_counter = 0;
 }
 
@@ -88,6 +117,8 @@ bool NodeQueueScheduler::active() const { return _active; }
 
 const std::vector<std::shared_ptr<TaskQueue>>& NodeQueueScheduler::queues() const { return _queues; }
 
+bool NodeQueueScheduler::uses_worker_deques() const { return _use_worker_deques; }
+
 void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id,
                                   SchedulePriority priority) {
   /**
@@ -104,6 +135,11 @@ void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID pre
   // Lookup node id for current worker.
   if (preferred_node_id == CURRENT_NODE_ID) {
     auto worker = Worker::get_this_thread_worker();
+    if (worker && worker->has_deque() && priority == SchedulePriority::Default && task->is_stealable()) {
+      worker->push_to_deque(task);
+      return;
+    }
+
     if (worker) {
       preferred_node_id = worker->queue()->node_id();
     } else {
@@ -70,9 +70,20 @@ namespace opossum {
  * Afterwards, the current worker is checking its local queue gain.
  *
  * [1] http://frankdenneman.nl/2016/07/13/numa-deep-dive-4-local-memory-optimization/
+ *
+ *
+ * WORKER DEQUES
+ *
+ * Optionally (use_worker_deques), each worker additionally owns a lock-free TaskDeque (Chase-Lev). Stealable tasks with
+ * the default priority that are scheduled from within a worker, e.g., the JobTasks spawned by an operator, are pushed
+ * to the worker's own deque instead of the node's TaskQueue. The worker executes them in LIFO order, which keeps their
+ * data in its caches and avoids contention on the shared queue. Idle workers steal the oldest tasks (FIFO) from the
+ * deques of the workers of their own node first, then from those of other nodes, and finally from the TaskQueues of
+ * other nodes. Tasks scheduled from outside of the workers (e.g., by clients) still go through the TaskQueues.
  */
 
 class Worker;
+class TaskDeque;
 class TaskQueue;
 class UidAllocator;
 
@@ -81,7 +92,7 @@ class UidAllocator;
  */
 class NodeQueueScheduler : public AbstractScheduler {
  public:
-  NodeQueueScheduler();
+  explicit NodeQueueScheduler(const bool use_worker_deques = false);
   ~NodeQueueScheduler() override;
 
   /**
@@ -96,6 +107,8 @@ class NodeQueueScheduler : public AbstractScheduler {
 
   const std::vector<std::shared_ptr<TaskQueue>>& queues() const override;
 
+  bool uses_worker_deques() const;
+
   /**
    * @param task
    * @param preferred_node_id The Task will be initially added to this node, but might get stolen by other Nodes later
@@ -116,6 +129,8 @@ class NodeQueueScheduler : public AbstractScheduler {
   std::atomic<TaskID> _task_counter{TaskID{0}};
   std::shared_ptr<UidAllocator> _worker_id_allocator;
   std::vector<std::shared_ptr<TaskQueue>> _queues;
+  const bool _use_worker_deques;
+  std::vector<std::shared_ptr<TaskDeque>> _deques;
   std::vector<std::shared_ptr<Worker>> _workers;
   std::atomic_bool _active{false};
 };
@@ -6,6 +6,7 @@
 
 #include "operators/abstract_operator.hpp"
 #include "operators/abstract_read_write_operator.hpp"
+#include "operators/table_scan.hpp"
 
 #include "scheduler/job_task.hpp"
 #include "utils/tracing/probes.hpp"
@@ -37,6 +38,13 @@ std::shared_ptr<OperatorTask> add_operator_tasks_recursively(const std::shared_p
     }
   }
 
+  // A TableScan with a runtime Bloom filter (see JoinHash::push_down_bloom_filters) has to wait for the filter's source
+  if (const auto table_scan = std::dynamic_pointer_cast<TableScan>(op)) {
+    if (const auto& source = table_scan->runtime_bloom_filter_source()) {
+      add_operator_tasks_recursively(source, tasks)->set_as_predecessor_of(task);
+    }
+  }
+
   return task;
 }
 
@@ -0,0 +1,118 @@
+#include "task_deque.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "abstract_task.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+TaskDeque::Buffer::Buffer(size_t init_capacity)
+    : capacity(init_capacity), elements(std::make_unique<std::atomic<Element>[]>(init_capacity)) {
+  DebugAssert(capacity > 0 && (capacity & (capacity - 1)) == 0, "Capacity must be a power of two");
+}
+
+TaskDeque::Element TaskDeque::Buffer::get(int64_t index) const {
+  return elements[static_cast<size_t>(index) & (capacity - 1)].load(std::memory_order_relaxed);
+}
+
+void TaskDeque::Buffer::put(int64_t index, Element element) {
+  elements[static_cast<size_t>(index) & (capacity - 1)].store(element, std::memory_order_relaxed);
+}
+
+TaskDeque::TaskDeque(NodeID node_id, size_t initial_capacity) : _node_id(node_id) {
+  _buffers.emplace_back(std::make_unique<Buffer>(initial_capacity));
+  _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+TaskDeque::~TaskDeque() {
+  // Tasks that were never removed, e.g., because they were executed directly by a Worker that waited for them, are
+  // still owned by the deque.
+  const auto top = _top.load(std::memory_order_relaxed);
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto* buffer = _buffer.load(std::memory_order_relaxed);
+  for (auto index = top; index < bottom; ++index) {
+    delete buffer->get(index);
+  }
+}
+
+NodeID TaskDeque::node_id() const { return _node_id; }
+
+bool TaskDeque::empty() const {
+  return _bottom.load(std::memory_order_relaxed) <= _top.load(std::memory_order_relaxed);
+}
+
+void TaskDeque::push(const std::shared_ptr<AbstractTask>& task) {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_acquire);
+  auto* buffer = _buffer.load(std::memory_order_relaxed);
+
+  if (bottom - top > static_cast<int64_t>(buffer->capacity) - 1) {
+    buffer = _grow(buffer, bottom, top);
+  }
+
+  buffer->put(bottom, new std::shared_ptr<AbstractTask>(task));
+  std::atomic_thread_fence(std::memory_order_release);
+  _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<AbstractTask> TaskDeque::pop() {
+  const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  auto* buffer = _buffer.load(std::memory_order_relaxed);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top = _top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // The deque was empty
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  auto* element = buffer->get(bottom);
+  if (top == bottom) {
+    // Last element, we compete with thieves for it
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      element = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  if (!element) return nullptr;
+
+  auto task = std::move(*element);
+  delete element;
+  return task;
+}
+
+std::shared_ptr<AbstractTask> TaskDeque::steal() {
+  auto top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto bottom = _bottom.load(std::memory_order_acquire);
+
+  if (top >= bottom) return nullptr;
+
+  const auto* buffer = _buffer.load(std::memory_order_acquire);
+  auto* element = buffer->get(top);
+  if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    // Another thief or the owner was faster
+    return nullptr;
+  }
+
+  auto task = std::move(*element);
+  delete element;
+  return task;
+}
+
+TaskDeque::Buffer* TaskDeque::_grow(Buffer* buffer, int64_t bottom, int64_t top) {
+  _buffers.emplace_back(std::make_unique<Buffer>(buffer->capacity * 2));
+  auto* new_buffer = _buffers.back().get();
+  for (auto index = top; index < bottom; ++index) {
+    new_buffer->put(index, buffer->get(index));
+  }
+  _buffer.store(new_buffer, std::memory_order_release);
+  return new_buffer;
+}
+
+}  // namespace opossum
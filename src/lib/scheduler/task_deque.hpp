@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractTask;
+
+/**
+ * Lock-free work-stealing deque as described by Chase and Lev [1], using the memory orderings of Lê et al. [2].
+ * Exactly one Worker (the owner) pushes and pops tasks at the bottom of the deque, i.e., it executes the tasks it
+ * spawned in LIFO order while their data is still in its caches. Any other Worker may steal the oldest task from the
+ * top of the deque (FIFO), which tends to be the largest unit of remaining work.
+ *
+ * The deque stores pointers to heap-allocated shared_ptrs. Only the thread that successfully removes an element from
+ * the deque (via pop or steal) takes ownership of it. When the deque grows, the previous buffers are kept until the
+ * deque is destroyed because thieves might still read from them.
+ *
+ * [1] Chase, Lev: Dynamic Circular Work-Stealing Deque, SPAA 2005
+ * [2] Lê, Pop, Cohen, Zappa Nardelli: Correct and Efficient Work-Stealing for Weak Memory Models, PPoPP 2013
+ */
+class TaskDeque : public Noncopyable {
+ public:
+  explicit TaskDeque(NodeID node_id, size_t initial_capacity = 64);
+  ~TaskDeque();
+
+  NodeID node_id() const;
+
+  // Approximation, the deque might be modified concurrently
+  bool empty() const;
+
+  // Only to be called by the owning Worker
+  void push(const std::shared_ptr<AbstractTask>& task);
+
+  // Removes the most recently pushed task. Only to be called by the owning Worker. Returns nullptr if empty.
+  std::shared_ptr<AbstractTask> pop();
+
+  // Removes the least recently pushed task. Can be called by any thread. Returns nullptr if the deque is empty or if
+  // another thread removed the task concurrently.
+  std::shared_ptr<AbstractTask> steal();
+
+ private:
+  using Element = std::shared_ptr<AbstractTask>*;
+
+  // Circular buffer whose capacity is a power of two
+  struct Buffer {
+    explicit Buffer(size_t init_capacity);
+
+    Element get(int64_t index) const;
+    void put(int64_t index, Element element);
+
+    const size_t capacity;
+    std::unique_ptr<std::atomic<Element>[]> elements;
+  };
+
+  // Replaces the buffer with one of twice the capacity. Only called by the owner.
+  Buffer* _grow(Buffer* buffer, int64_t bottom, int64_t top);
+
+  const NodeID _node_id;
+
+  // Top and bottom are placed in different cache lines as they are written by different threads
+  alignas(64) std::atomic<int64_t> _top{0};
+  alignas(64) std::atomic<int64_t> _bottom{0};
+  std::atomic<Buffer*> _buffer;
+
+  // All buffers ever used by this deque, only accessed by the owner
+  std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+}  // namespace opossum
@@ -33,6 +33,14 @@ void TaskQueue::push(const std::shared_ptr<AbstractTask>& task, uint32_t priorit
 
 std::shared_ptr<AbstractTask> TaskQueue::pull() {
   std::shared_ptr<AbstractTask> task;
+
+  // Relaxed, as the interval does not need to be exact
+  if (_pull_count.fetch_add(1, std::memory_order_relaxed) % STARVATION_PREVENTION_INTERVAL == 0) {
+    if (_queues.back().try_pop(task)) {
+      return task;
+    }
+  }
+
   for (auto& queue : _queues) {
     if (queue.try_pop(task)) {
       return task;
@@ -18,7 +18,11 @@ class AbstractTask;
  */
 class TaskQueue {
  public:
-  static constexpr uint32_t NUM_PRIORITY_LEVELS = 2;
+  static constexpr uint32_t NUM_PRIORITY_LEVELS = 3;
+
+  // Every STARVATION_PREVENTION_INTERVAL-th pull serves the lowest priority level first. Thus, tasks with a low
+  // priority still get a guaranteed share of the workers when there is a constant flow of more urgent tasks.
+  static constexpr uint32_t STARVATION_PREVENTION_INTERVAL = 8;
 
   explicit TaskQueue(NodeID node_id);
 
@@ -29,7 +33,8 @@ class TaskQueue {
   void push(const std::shared_ptr<AbstractTask>& task, uint32_t priority);
 
   /**
-   * Returns a Tasks that is ready to be executed and removes it from the queue
+   * Returns a Tasks that is ready to be executed and removes it from the queue. Tasks are usually taken in the order of
+   * their priority, see STARVATION_PREVENTION_INTERVAL for the exception.
    */
   std::shared_ptr<AbstractTask> pull();
 
@@ -51,6 +56,7 @@ class TaskQueue {
  private:
   NodeID _node_id;
   std::array<tbb::concurrent_queue<std::shared_ptr<AbstractTask>>, NUM_PRIORITY_LEVELS> _queues;
+  std::atomic_uint32_t _pull_count{0};
 };
 
 }  // namespace opossum
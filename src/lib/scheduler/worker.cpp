@@ -15,6 +15,7 @@
 #include "abstract_scheduler.hpp"
 #include "abstract_task.hpp"
 #include "hyrise.hpp"
+#include "task_deque.hpp"
 #include "task_queue.hpp"
 
 namespace {
@@ -33,8 +34,9 @@ namespace opossum {
 
 std::shared_ptr<Worker> Worker::get_this_thread_worker() { return ::this_thread_worker.lock(); }
 
-Worker::Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id)
-    : _queue(queue), _id(id), _cpu_id(cpu_id) {
+Worker::Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id,
+               const std::shared_ptr<TaskDeque>& deque, const std::vector<std::shared_ptr<TaskDeque>>& steal_victims)
+    : _queue(queue), _deque(deque), _steal_victims(steal_victims), _id(id), _cpu_id(cpu_id) {
   // Generate a random distribution from 0-99 for later use, see below
   _random.resize(100);
   std::iota(_random.begin(), _random.end(), 0);
@@ -66,18 +68,17 @@ void Worker::_work() {
     task = std::move(_next_task);
     _next_task = nullptr;
   } else {
-    task = _queue->pull();
+    // Tasks spawned by this worker are executed first and in LIFO order, as their data is most likely still cached.
+    if (_deque) task = _deque->pop();
+    if (!task) task = _queue->pull();
   }
 
   if (!task) {
-    // Simple work stealing without explicitly transferring data between nodes.
+    // Simple work stealing without explicitly transferring data between nodes. The deques of other workers are
+    // checked first. Their oldest tasks are taken, which tend to be the largest units of work.
     auto work_stealing_successful = false;
-    for (const auto& queue : Hyrise::get().scheduler()->queues()) {
-      if (queue == _queue) {
-        continue;
-      }
-
-      task = queue->steal();
+    for (const auto& deque : _steal_victims) {
+      task = deque->steal();
       if (task) {
         task->set_node_id(_queue->node_id());
         work_stealing_successful = true;
@@ -85,6 +86,21 @@ void Worker::_work() {
       }
     }
 
+    if (!work_stealing_successful) {
+      for (const auto& queue : Hyrise::get().scheduler()->queues()) {
+        if (queue == _queue) {
+          continue;
+        }
+
+        task = queue->steal();
+        if (task) {
+          task->set_node_id(_queue->node_id());
+          work_stealing_successful = true;
+          break;
+        }
+      }
+    }
+
     // If there is no ready task neither in our queue nor in any other, worker waits for a new task to be pushed to the
     // own queue or returns after timer exceeded (whatever occurs first).
     if (!work_stealing_successful) {
@@ -125,11 +141,29 @@ void Worker::execute_next(const std::shared_ptr<AbstractTask>& task) {
     }
     Assert(successfully_enqueued, "Task was already enqueued, expected to be solely responsible for execution");
     _next_task = task;
+  } else if (_deque && task->is_stealable()) {
+    push_to_deque(task);
   } else {
     _queue->push(task, static_cast<uint32_t>(SchedulePriority::Default));
   }
 }
 
+void Worker::push_to_deque(const std::shared_ptr<AbstractTask>& task) {
+  DebugAssert(_deque, "Worker does not have a deque");
+  DebugAssert(&*get_this_thread_worker() == this, "Only the owning worker may push to its deque");
+
+  // Someone else was first to enqueue this task? No problem!
+  if (!task->try_mark_as_enqueued()) return;
+
+  task->set_node_id(_queue->node_id());
+  _deque->push(task);
+
+  // Idle workers of this node wait on the queue's condition variable. Wake one of them up so that it can steal.
+  _queue->new_task.notify_one();
+}
+
+bool Worker::has_deque() const { return static_cast<bool>(_deque); }
+
 void Worker::start() { _thread = std::thread(&Worker::operator(), this); }
 
 void Worker::join() {
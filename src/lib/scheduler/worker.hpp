@@ -11,6 +11,7 @@
 
 namespace opossum {
 
+class TaskDeque;
 class TaskQueue;
 
 /**
@@ -19,11 +20,19 @@ class TaskQueue;
  */
 class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable {
   friend class AbstractScheduler;
+  friend class AdmissionControl;
 
  public:
   static std::shared_ptr<Worker> get_this_thread_worker();
 
-  Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id);
+  /**
+   * @param deque         If set, tasks that are scheduled by this worker are pushed to this deque instead of the queue
+   *                      (see NodeQueueScheduler).
+   * @param steal_victims The deques of the other workers. Those of the same node should be listed first.
+   */
+  Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id,
+         const std::shared_ptr<TaskDeque>& deque = nullptr,
+         const std::vector<std::shared_ptr<TaskDeque>>& steal_victims = {});
 
   /**
    * Unique ID of a worker. Currently not in use, but really helpful for debugging.
@@ -42,6 +51,12 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
   // so that they are worked on as soon as possible by either this or another worker.
   void execute_next(const std::shared_ptr<AbstractTask>& task);
 
+  // Pushes a ready task to the worker's deque, from which it is executed in LIFO order or stolen by other workers.
+  // Must be called from the thread of this worker.
+  void push_to_deque(const std::shared_ptr<AbstractTask>& task);
+
+  bool has_deque() const;
+
   uint64_t num_finished_tasks() const;
 
   void operator=(const Worker&) = delete;
@@ -62,6 +77,8 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
 
   std::shared_ptr<AbstractTask> _next_task{};
   std::shared_ptr<TaskQueue> _queue;
+  std::shared_ptr<TaskDeque> _deque;
+  std::vector<std::shared_ptr<TaskDeque>> _steal_victims;
   WorkerID _id;
   CpuID _cpu_id;
   std::thread _thread;
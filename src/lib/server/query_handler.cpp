@@ -2,6 +2,7 @@
 
 #include "expression/value_expression.hpp"
 #include "optimizer/optimizer.hpp"
+#include "scheduler/admission_control.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_translator.hpp"
 
@@ -97,7 +98,10 @@ std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const Prepare
 std::shared_ptr<const Table> QueryHandler::execute_prepared_plan(
     const std::shared_ptr<AbstractOperator>& physical_plan) {
   const auto& [tasks, root_operator_task] = OperatorTask::make_tasks_from_operator(physical_plan);
-  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+  {
+    const auto admission_guard = AdmissionGuard{Hyrise::get().admission_control, SchedulePriority::Default};
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+  }
   return root_operator_task->get_operator()->get_output();
 }
 
@@ -18,7 +18,8 @@ namespace opossum {
 SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<TransactionContext>& transaction_context,
                          const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
                          const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-                         const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache)
+                         const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache,
+                         const SchedulePriority priority, const bool use_morsel_pipelining)
     : pqp_cache(init_pqp_cache),
       lqp_cache(init_lqp_cache),
       _sql(sql),
@@ -83,7 +84,8 @@ SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<Transacti
     sql_string_offset += statement_string_length;
 
     auto pipeline_statement = std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement),
-                                                                     use_mvcc, optimizer, pqp_cache, lqp_cache);
+                                                                     use_mvcc, optimizer, pqp_cache, lqp_cache,
+                                                                     priority, use_morsel_pipelining);
     _sql_pipeline_statements.emplace_back(std::move(pipeline_statement));
   }
 
@@ -35,7 +35,8 @@ class SQLPipeline : public Noncopyable {
   SQLPipeline(const std::string& sql, const std::shared_ptr<TransactionContext>& transaction_context,
               const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
               const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-              const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache);
+              const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache,
+              const SchedulePriority priority = SchedulePriority::Default, const bool use_morsel_pipelining = false);
 
   // Returns the original SQL string
   const std::string& get_sql() const;
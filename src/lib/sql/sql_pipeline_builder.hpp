@@ -28,6 +28,8 @@ class Optimizer;
  * Defaults:
  *  - MVCC is enabled
  *  - The default Optimizer (Optimizer::create_default_optimizer()) is used.
+ *  - SchedulePriority::Default is used.
+ *  - Operators are executed one at a time (no morsel pipelining).
  *
  * Favour this interface over calling the SQLPipeline[Statement] constructors with their long parameter list.
  * See SQLPipeline[Statement] doc for these classes, in short SQLPipeline ist for queries with multiple statement,
@@ -43,6 +45,17 @@ class SQLPipelineBuilder final {
   SQLPipelineBuilder& with_pqp_cache(const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache);
   SQLPipelineBuilder& with_lqp_cache(const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache);
 
+  /**
+   * The priority of all tasks executing the pipeline's statements. Use SchedulePriority::Low for long-running queries
+   * that should not delay short ones.
+   */
+  SQLPipelineBuilder& with_priority(const SchedulePriority priority);
+
+  /**
+   * Execute chains of TableScans, Validates, and Projections morsel by morsel (see MorselPipeline)
+   */
+  SQLPipelineBuilder& with_morsel_pipelining(const bool use_morsel_pipelining = true);
+
   /**
    * Short for with_mvcc(UseMvcc::No)
    */
@@ -58,6 +71,8 @@ class SQLPipelineBuilder final {
   std::shared_ptr<Optimizer> _optimizer;
   std::shared_ptr<SQLPhysicalPlanCache> _pqp_cache;
   std::shared_ptr<SQLLogicalPlanCache> _lqp_cache;
+  SchedulePriority _priority{SchedulePriority::Default};
+  bool _use_morsel_pipelining{false};
 };
 
 }  // namespace opossum
@@ -14,12 +14,15 @@
 #include "logical_query_plan/lqp_utils.hpp"
 #include "operators/export.hpp"
 #include "operators/import.hpp"
+#include "operators/join_hash.hpp"
 #include "operators/maintenance/create_prepared_plan.hpp"
 #include "operators/maintenance/create_table.hpp"
 #include "operators/maintenance/create_view.hpp"
 #include "operators/maintenance/drop_table.hpp"
 #include "operators/maintenance/drop_view.hpp"
+#include "operators/morsel_pipeline.hpp"
 #include "optimizer/optimizer.hpp"
+#include "scheduler/admission_control.hpp"
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_plan_cache.hpp"
@@ -32,11 +35,14 @@ namespace opossum {
 SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
                                            const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
                                            const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-                                           const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache)
+                                           const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache,
+                                           const SchedulePriority priority, const bool use_morsel_pipelining)
     : pqp_cache(init_pqp_cache),
       lqp_cache(init_lqp_cache),
       _sql_string(sql),
       _use_mvcc(use_mvcc),
+      _priority(priority),
+      _use_morsel_pipelining(use_morsel_pipelining),
       _optimizer(optimizer),
       _parsed_sql_statement(std::move(parsed_sql)),
       _metrics(std::make_shared<SQLPipelineStatementMetrics>()) {
@@ -188,6 +194,9 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
     // Reset time to exclude previous pipeline steps
     started = std::chrono::high_resolution_clock::now();
     _physical_plan = LQPTranslator{}.translate_node(lqp);
+
+    // Runtime Bloom filters are added before caching, so that cached plans already contain them
+    if (Hyrise::get().runtime_bloom_filters) JoinHash::push_down_bloom_filters(_physical_plan);
   }
 
   done = std::chrono::high_resolution_clock::now();
@@ -199,6 +208,9 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
     pqp_cache->set(_sql_string, _physical_plan);
   }
 
+  // Pipelines are fused after caching so that the cached plan can be used with and without morsel pipelining
+  if (_use_morsel_pipelining) _physical_plan = MorselPipeline::fuse_pipelines(_physical_plan);
+
   _metrics->lqp_translation_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
 
   return _physical_plan;
@@ -215,6 +227,11 @@ const std::vector<std::shared_ptr<AbstractTask>>& SQLPipelineStatement::get_task
     _precheck_ddl_operators(get_physical_plan());
     std::tie(_tasks, _root_operator_task) = OperatorTask::make_tasks_from_operator(get_physical_plan());
   }
+
+  for (const auto& task : _tasks) {
+    // Tasks of operators that have already been executed (e.g., uncorrelated subqueries) are already done.
+    if (!task->is_scheduled()) task->set_priority(_priority);
+  }
   return _tasks;
 }
 
@@ -272,7 +289,12 @@ std::pair<SQLPipelineStatus, const std::shared_ptr<const Table>&> SQLPipelineSta
   DTRACE_PROBE3(HYRISE, TASKS_PER_STATEMENT, reinterpret_cast<uintptr_t>(&tasks), _sql_string.c_str(),
                 reinterpret_cast<uintptr_t>(this));
 
-  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+  // Limit the number of concurrently executed queries (if configured). Queries are only admitted (and released) here,
+  // as all other steps of the pipeline are executed by the calling thread and do not occupy the workers.
+  {
+    const auto admission_guard = AdmissionGuard{Hyrise::get().admission_control, _priority};
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+  }
 
   if (has_failed()) {
     return {SQLPipelineStatus::Failure, _result_table};
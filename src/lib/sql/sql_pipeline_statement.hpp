@@ -57,7 +57,9 @@ class SQLPipelineStatement : public Noncopyable {
   SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
                        const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
                        const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-                       const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache);
+                       const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache,
+                       const SchedulePriority priority = SchedulePriority::Default,
+                       const bool use_morsel_pipelining = false);
 
   // Set the transaction context if this SQLPipelineStatement should not auto-commit.
   void set_transaction_context(const std::shared_ptr<TransactionContext>& transaction_context);
@@ -79,10 +81,10 @@ class SQLPipelineStatement : public Noncopyable {
 
   // Returns the PQP for this statement.
   // The physical plan is either retrieved from the SQLPhysicalPlanCache or, if unavailable, translated from the
-  // optimized LQP.
+  // optimized LQP. With morsel pipelining, chains of pipelineable operators are replaced by MorselPipelines.
   const std::shared_ptr<AbstractOperator>& get_physical_plan();
 
-  // Returns all tasks that need to be executed for this query.
+  // Returns all tasks that need to be executed for this query. They are assigned the priority of the statement.
   const std::vector<std::shared_ptr<AbstractTask>>& get_tasks();
 
   // Executes all tasks, waits for them to finish, and returns
@@ -116,6 +118,8 @@ class SQLPipelineStatement : public Noncopyable {
 
   const std::string _sql_string;
   const UseMvcc _use_mvcc;
+  const SchedulePriority _priority;
+  const bool _use_morsel_pipelining;
 
   const std::shared_ptr<Optimizer> _optimizer;
 
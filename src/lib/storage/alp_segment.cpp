@@ -0,0 +1,163 @@
+#include "alp_segment.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/vector_compression/base_compressed_vector.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+template <typename T, typename U>
+ALPSegment<T, U>::ALPSegment(uint8_t exponent, pmr_vector<int64_t> block_minima,
+                             pmr_vector<ChunkOffset> exception_positions, pmr_vector<T> exception_values,
+                             std::optional<pmr_vector<bool>> null_values,
+                             std::unique_ptr<const BaseCompressedVector> offset_values)
+    : AbstractEncodedSegment{data_type_from_type<T>()},
+      _exponent{exponent},
+      _block_minima{std::move(block_minima)},
+      _exception_positions{std::move(exception_positions)},
+      _exception_values{std::move(exception_values)},
+      _null_values{std::move(null_values)},
+      _offset_values{std::move(offset_values)},
+      _decompressor{_offset_values->create_base_decompressor()} {
+  Assert(_exponent <= max_exponent, "Invalid exponent");
+  Assert(_exception_positions.size() == _exception_values.size(), "Expected one value per exception");
+  DebugAssert(std::is_sorted(_exception_positions.cbegin(), _exception_positions.cend()),
+              "Exception positions must be sorted");
+}
+
+template <typename T, typename U>
+uint8_t ALPSegment<T, U>::exponent() const {
+  return _exponent;
+}
+
+template <typename T, typename U>
+const pmr_vector<int64_t>& ALPSegment<T, U>::block_minima() const {
+  return _block_minima;
+}
+
+template <typename T, typename U>
+const pmr_vector<ChunkOffset>& ALPSegment<T, U>::exception_positions() const {
+  return _exception_positions;
+}
+
+template <typename T, typename U>
+const pmr_vector<T>& ALPSegment<T, U>::exception_values() const {
+  return _exception_values;
+}
+
+template <typename T, typename U>
+const std::optional<pmr_vector<bool>>& ALPSegment<T, U>::null_values() const {
+  return _null_values;
+}
+
+template <typename T, typename U>
+const BaseCompressedVector& ALPSegment<T, U>::offset_values() const {
+  return *_offset_values;
+}
+
+template <typename T, typename U>
+AllTypeVariant ALPSegment<T, U>::operator[](const ChunkOffset chunk_offset) const {
+  PerformanceWarning("operator[] used");
+  DebugAssert(chunk_offset < size(), "Passed chunk offset must be valid.");
+
+  const auto typed_value = get_typed_value(chunk_offset);
+  if (!typed_value) {
+    return NULL_VALUE;
+  }
+  return *typed_value;
+}
+
+template <typename T, typename U>
+std::vector<T> ALPSegment<T, U>::decompress() const {
+  const auto segment_size = size();
+  auto offsets = std::vector<uint32_t>(segment_size);
+  resolve_compressed_vector_type(*_offset_values, [&](const auto& offset_values) {
+    std::copy(offset_values.cbegin(), offset_values.cend(), offsets.begin());
+  });
+
+  auto values = std::vector<T>(segment_size);
+  const auto power_of_ten = powers_of_ten[_exponent];
+  for (auto block_begin = ChunkOffset{0}; block_begin < segment_size; block_begin += block_size) {
+    const auto block_end = std::min(block_begin + block_size, segment_size);
+    const auto block_minimum = _block_minima[block_begin / block_size];
+
+    // The loop has no dependencies between iterations, so that the compiler can vectorize it.
+    // This empty block is used to convince clang-format to keep the pragma indented.
+    // NOLINTNEXTLINE
+    {}  // clang-format off
+    #pragma omp simd
+    // clang-format on
+    for (auto chunk_offset = block_begin; chunk_offset < block_end; ++chunk_offset) {
+      values[chunk_offset] = decode(static_cast<int64_t>(offsets[chunk_offset]) + block_minimum, power_of_ten);
+    }
+  }
+
+  const auto exception_count = _exception_positions.size();
+  for (auto exception_index = size_t{0}; exception_index < exception_count; ++exception_index) {
+    values[_exception_positions[exception_index]] = _exception_values[exception_index];
+  }
+
+  return values;
+}
+
+template <typename T, typename U>
+ChunkOffset ALPSegment<T, U>::size() const {
+  return static_cast<ChunkOffset>(_offset_values->size());
+}
+
+template <typename T, typename U>
+std::shared_ptr<AbstractSegment> ALPSegment<T, U>::copy_using_allocator(
+    const PolymorphicAllocator<size_t>& alloc) const {
+  auto new_block_minima = pmr_vector<int64_t>(_block_minima, alloc);
+  auto new_exception_positions = pmr_vector<ChunkOffset>(_exception_positions, alloc);
+  auto new_exception_values = pmr_vector<T>(_exception_values, alloc);
+  auto new_offset_values = _offset_values->copy_using_allocator(alloc);
+
+  std::optional<pmr_vector<bool>> null_values;
+  if (_null_values) {
+    null_values = pmr_vector<bool>(*_null_values, alloc);
+  }
+
+  auto copy = std::make_shared<ALPSegment>(_exponent, std::move(new_block_minima), std::move(new_exception_positions),
+                                           std::move(new_exception_values), std::move(null_values),
+                                           std::move(new_offset_values));
+  copy->access_counter = access_counter;
+  return copy;
+}
+
+template <typename T, typename U>
+size_t ALPSegment<T, U>::memory_usage(const MemoryUsageCalculationMode) const {
+  // MemoryUsageCalculationMode ignored since full calculation is efficient.
+  size_t segment_size = sizeof(*this) + sizeof(int64_t) * _block_minima.capacity() +
+                        sizeof(ChunkOffset) * _exception_positions.capacity() +
+                        sizeof(T) * _exception_values.capacity() + _offset_values->data_size() + sizeof(_null_values);
+
+  if (_null_values) {
+    segment_size += _null_values->capacity() / CHAR_BIT;
+  }
+
+  return segment_size;
+}
+
+template <typename T, typename U>
+EncodingType ALPSegment<T, U>::encoding_type() const {
+  return EncodingType::ALP;
+}
+
+template <typename T, typename U>
+std::optional<CompressedVectorType> ALPSegment<T, U>::compressed_vector_type() const {
+  return _offset_values->type();
+}
+
+template class ALPSegment<float>;
+template class ALPSegment<double>;
+
+}  // namespace opossum
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include <boost/hana/contains.hpp>
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/type.hpp>
+
+#include "abstract_encoded_segment.hpp"
+#include "storage/vector_compression/base_compressed_vector.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseCompressedVector;
+
+/**
+ * @brief Segment implementing a simplified version of ALP (Adaptive Lossless floating-Point compression, Afroozeh et
+ *        al., SIGMOD 2024) for float and double
+ *
+ * Floating-point columns often hold decimals with few digits (e.g., prices or measurements). Such a value can be
+ * stored as an integer, the digits, together with a decimal exponent e of the segment: value = digits / 10^e. The
+ * digits are then encoded like in the FrameOfReferenceSegment, i.e., as offsets from the minimum of their block, which
+ * are compressed using vector compression.
+ *
+ * A value is only encoded as digits if decoding them results in exactly the same value (including the sign of zero).
+ * All other values (e.g., NaN, infinity, or values with more decimal places than e) are stored as exceptions, i.e.,
+ * their position and their original value are stored separately. The exponent is chosen by the encoder such that a
+ * sample of the segment has as few exceptions as possible.
+ *
+ * Decoding a value is a conversion and a division, which compilers vectorize when the segment is decompressed as a
+ * whole (see decompress()). Afterwards, the exceptions are patched in.
+ *
+ * Null values are stored in a separate vector. Their offset is zero.
+ *
+ * See FrameOfReferenceSegment for why std::enable_if_t is used.
+ */
+template <typename T, typename = std::enable_if_t<encoding_supports_data_type(enum_c<EncodingType, EncodingType::ALP>,
+                                                                               hana::type_c<T>)>>
+class ALPSegment : public AbstractEncodedSegment {
+ public:
+  static constexpr auto block_size = 2048u;
+
+  static constexpr auto powers_of_ten =
+      std::array<double, 19>{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                             1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+
+  // Largest exponent tried by the encoder. Floats do not have more than nine significant decimal digits.
+  static constexpr auto max_exponent = uint8_t{std::is_same_v<T, float> ? 10 : 18};
+
+  explicit ALPSegment(uint8_t exponent, pmr_vector<int64_t> block_minima, pmr_vector<ChunkOffset> exception_positions,
+                      pmr_vector<T> exception_values, std::optional<pmr_vector<bool>> null_values,
+                      std::unique_ptr<const BaseCompressedVector> offset_values);
+
+  uint8_t exponent() const;
+  const pmr_vector<int64_t>& block_minima() const;
+
+  // The positions of the exceptions are sorted
+  const pmr_vector<ChunkOffset>& exception_positions() const;
+  const pmr_vector<T>& exception_values() const;
+
+  const std::optional<pmr_vector<bool>>& null_values() const;
+  const BaseCompressedVector& offset_values() const;
+
+  // Both the encoder and the segment use these functions, so that the exact same arithmetic is used for verifying that
+  // a value can be encoded and for decoding it.
+  static T decode(const int64_t digits, const double power_of_ten) {
+    return static_cast<T>(static_cast<double>(digits) / power_of_ten);
+  }
+
+  // Returns the digits of the value for the exponent or std::nullopt if the value has to be stored as an exception
+  static std::optional<int64_t> encode(const T value, const uint8_t exponent) {
+    if (!std::isfinite(value)) {
+      return std::nullopt;
+    }
+
+    const auto power_of_ten = powers_of_ten[exponent];
+    const auto scaled_value = static_cast<double>(value) * power_of_ten;
+
+    // Integers with an absolute value above 2^53 cannot be represented exactly by a double
+    if (std::abs(scaled_value) >= 9007199254740992.0) {
+      return std::nullopt;
+    }
+
+    const auto digits = static_cast<int64_t>(std::llround(scaled_value));
+    const auto decoded_value = decode(digits, power_of_ten);
+    if (decoded_value != value || std::signbit(decoded_value) != std::signbit(value)) {
+      return std::nullopt;
+    }
+    return digits;
+  }
+
+  /**
+   * @defgroup AbstractSegment interface
+   * @{
+   */
+
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
+
+  std::optional<T> get_typed_value(const ChunkOffset chunk_offset) const {
+    // performance critical - not in cpp to help with inlining
+    if (_null_values && (*_null_values)[chunk_offset]) {
+      return std::nullopt;
+    }
+
+    if (!_exception_positions.empty()) {
+      const auto exception_it =
+          std::lower_bound(_exception_positions.cbegin(), _exception_positions.cend(), chunk_offset);
+      if (exception_it != _exception_positions.cend() && *exception_it == chunk_offset) {
+        return _exception_values[std::distance(_exception_positions.cbegin(), exception_it)];
+      }
+    }
+
+    const auto offset = static_cast<int64_t>(_decompressor->get(chunk_offset));
+    return decode(_block_minima[chunk_offset / block_size] + offset, powers_of_ten[_exponent]);
+  }
+
+  // Decompresses all values of the segment. The values of null values are undefined.
+  std::vector<T> decompress() const;
+
+  ChunkOffset size() const final;
+
+  std::shared_ptr<AbstractSegment> copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const final;
+
+  size_t memory_usage(const MemoryUsageCalculationMode) const final;
+
+  /**@}*/
+
+  /**
+   * @defgroup AbstractEncodedSegment interface
+   * @{
+   */
+
+  EncodingType encoding_type() const final;
+  std::optional<CompressedVectorType> compressed_vector_type() const final;
+
+  /**@}*/
+
+ private:
+  const uint8_t _exponent;
+  const pmr_vector<int64_t> _block_minima;
+  const pmr_vector<ChunkOffset> _exception_positions;
+  const pmr_vector<T> _exception_values;
+  const std::optional<pmr_vector<bool>> _null_values;
+  const std::unique_ptr<const BaseCompressedVector> _offset_values;
+  std::unique_ptr<BaseVectorDecompressor> _decompressor;
+};
+
+extern template class ALPSegment<float>;
+extern template class ALPSegment<double>;
+
+}  // namespace opossum
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "storage/base_segment_encoder.hpp"
+
+#include "storage/alp_segment.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/value_segment/value_segment_iterable.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+#include "types.hpp"
+#include "utils/enum_constant.hpp"
+
+namespace opossum {
+
+class ALPEncoder : public SegmentEncoder<ALPEncoder> {
+ public:
+  static constexpr auto _encoding_type = enum_c<EncodingType, EncodingType::ALP>;
+  static constexpr auto _uses_vector_compression = true;  // see base_segment_encoder.hpp for details
+
+  // Number of values used to choose the exponent of a segment
+  static constexpr auto sample_size = size_t{1024};
+
+  template <typename T>
+  std::shared_ptr<AbstractEncodedSegment> _on_encode(const AnySegmentIterable<T> segment_iterable,
+                                                     const PolymorphicAllocator<T>& allocator) {
+    static constexpr auto block_size = ALPSegment<T>::block_size;
+
+    auto values = std::vector<T>{};
+    auto null_values = pmr_vector<bool>{allocator};
+    auto segment_contains_null_values = false;
+
+    segment_iterable.with_iterators([&](auto segment_it, auto segment_end) {
+      const auto size = std::distance(segment_it, segment_end);
+      values.reserve(size);
+      null_values.reserve(size);
+
+      for (; segment_it != segment_end; ++segment_it) {
+        const auto segment_value = *segment_it;
+        const auto value_is_null = segment_value.is_null();
+        values.push_back(value_is_null ? T{0} : segment_value.value());
+        null_values.push_back(value_is_null);
+        segment_contains_null_values |= value_is_null;
+      }
+    });
+
+    const auto exponent = _choose_exponent(values, null_values);
+
+    auto block_minima = pmr_vector<int64_t>{allocator};
+    auto exception_positions = pmr_vector<ChunkOffset>{allocator};
+    auto exception_values = pmr_vector<T>{allocator};
+    auto offset_values = pmr_vector<uint32_t>(values.size(), allocator);
+    auto max_offset = uint32_t{0u};
+
+    const auto segment_size = static_cast<ChunkOffset>(values.size());
+    auto digits = std::vector<std::optional<int64_t>>(block_size);
+    for (auto block_begin = ChunkOffset{0}; block_begin < segment_size; block_begin += block_size) {
+      const auto block_end = std::min(block_begin + block_size, segment_size);
+
+      // Encode all values of the block and find the minimum of the digits that are not exceptions
+      auto block_minimum = std::optional<int64_t>{};
+      for (auto chunk_offset = block_begin; chunk_offset < block_end; ++chunk_offset) {
+        auto& current_digits = digits[chunk_offset - block_begin];
+        current_digits =
+            null_values[chunk_offset] ? std::nullopt : ALPSegment<T>::encode(values[chunk_offset], exponent);
+        if (current_digits) {
+          block_minimum = block_minimum ? std::min(*block_minimum, *current_digits) : *current_digits;
+        }
+      }
+      block_minima.push_back(block_minimum.value_or(0));
+
+      for (auto chunk_offset = block_begin; chunk_offset < block_end; ++chunk_offset) {
+        if (null_values[chunk_offset]) {
+          continue;
+        }
+
+        // Values whose offset does not fit into uint32_t (required for vector compression) are stored as exceptions
+        const auto& current_digits = digits[chunk_offset - block_begin];
+        if (!current_digits || *current_digits - *block_minimum > std::numeric_limits<uint32_t>::max()) {
+          exception_positions.push_back(chunk_offset);
+          exception_values.push_back(values[chunk_offset]);
+          continue;
+        }
+
+        const auto offset = static_cast<uint32_t>(*current_digits - *block_minimum);
+        offset_values[chunk_offset] = offset;
+        max_offset = std::max(max_offset, offset);
+      }
+    }
+
+    auto compressed_offset_values = compress_vector(offset_values, vector_compression_type(), allocator, {max_offset});
+
+    auto optional_null_values =
+        segment_contains_null_values ? std::optional<pmr_vector<bool>>{std::move(null_values)} : std::nullopt;
+    return std::make_shared<ALPSegment<T>>(exponent, std::move(block_minima), std::move(exception_positions),
+                                           std::move(exception_values), std::move(optional_null_values),
+                                           std::move(compressed_offset_values));
+  }
+
+ private:
+  // Chooses the exponent that results in the fewest exceptions for an evenly spaced sample of the non-null values. If
+  // several exponents are equally good, the smallest one is chosen, as it results in the smallest offsets.
+  template <typename T>
+  static uint8_t _choose_exponent(const std::vector<T>& values, const pmr_vector<bool>& null_values) {
+    auto sample = std::vector<T>{};
+    const auto step = std::max(size_t{1}, values.size() / sample_size);
+    for (auto index = size_t{0}; index < values.size() && sample.size() < sample_size; index += step) {
+      if (!null_values[index]) {
+        sample.push_back(values[index]);
+      }
+    }
+
+    auto best_exponent = uint8_t{0};
+    auto best_exception_count = std::numeric_limits<size_t>::max();
+    for (auto exponent = uint8_t{0}; exponent <= ALPSegment<T>::max_exponent; ++exponent) {
+      const auto exception_count = static_cast<size_t>(std::count_if(
+          sample.cbegin(), sample.cend(), [&](const T value) { return !ALPSegment<T>::encode(value, exponent); }));
+
+      if (exception_count < best_exception_count) {
+        best_exponent = exponent;
+        best_exception_count = exception_count;
+      }
+
+      if (best_exception_count == 0) {
+        break;
+      }
+    }
+
+    return best_exponent;
+  }
+};
+
+}  // namespace opossum
@@ -22,6 +22,15 @@ class FrameOfReferenceSegment;
 template <typename T>
 class LZ4Segment;
 
+template <typename T>
+class FSSTSegment;
+
+template <typename T, typename>
+class DeltaSegment;
+
+template <typename T, typename>
+class ALPSegment;
+
 class ReferenceSegment;
 template <typename T, EraseReferencedSegmentType>
 class ReferenceSegmentIterable;
@@ -68,6 +77,27 @@ auto create_iterable_from_segment(const FrameOfReferenceSegment<T, Enabled>& seg
 template <typename T, bool EraseSegmentType = true>
 auto create_iterable_from_segment(const LZ4Segment<T>& segment);
 
+template <typename T, bool EraseSegmentType = true>
+auto create_iterable_from_segment(const FSSTSegment<T>& segment);
+
+template <typename T, typename Enabled, bool EraseSegmentType = true>
+auto create_iterable_from_segment(const DeltaSegment<T, Enabled>& segment);
+
+// Fix template deduction so that we can call `create_iterable_from_segment<T, false>` on DeltaSegments
+template <typename T, bool EraseSegmentType, typename Enabled>
+auto create_iterable_from_segment(const DeltaSegment<T, Enabled>& segment) {
+  return create_iterable_from_segment<T, Enabled, EraseSegmentType>(segment);
+}
+
+template <typename T, typename Enabled, bool EraseSegmentType = true>
+auto create_iterable_from_segment(const ALPSegment<T, Enabled>& segment);
+
+// Fix template deduction so that we can call `create_iterable_from_segment<T, false>` on ALPSegments
+template <typename T, bool EraseSegmentType, typename Enabled>
+auto create_iterable_from_segment(const ALPSegment<T, Enabled>& segment) {
+  return create_iterable_from_segment<T, Enabled, EraseSegmentType>(segment);
+}
+
 template <typename T, bool EraseSegmentType = HYRISE_DEBUG,
           EraseReferencedSegmentType = (HYRISE_DEBUG ? EraseReferencedSegmentType::Yes
                                                      : EraseReferencedSegmentType::No)>
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "storage/alp_segment/alp_segment_iterable.hpp"
+#include "storage/delta_segment/delta_segment_iterable.hpp"
 #include "storage/dictionary_segment/dictionary_segment_iterable.hpp"
 #include "storage/frame_of_reference_segment/frame_of_reference_segment_iterable.hpp"
+#include "storage/fsst_segment/fsst_segment_iterable.hpp"
 #include "storage/lz4_segment/lz4_segment_iterable.hpp"
 #include "storage/run_length_segment/run_length_segment_iterable.hpp"
 #include "storage/segment_iterables/any_segment_iterable.hpp"
@@ -81,4 +84,23 @@ auto create_iterable_from_segment(const LZ4Segment<T>& segment) {
   return AnySegmentIterable<T>(LZ4SegmentIterable<T>(segment));
 }
 
+template <typename T, bool EraseSegmentType>
+auto create_iterable_from_segment(const FSSTSegment<T>& segment) {
+  // Like LZ4Segments, FSSTSegments always get erased. Decompressing the strings dominates the virtual function calls.
+  return AnySegmentIterable<T>(FSSTSegmentIterable<T>(segment));
+}
+
+template <typename T, typename Enabled, bool EraseSegmentType>
+auto create_iterable_from_segment(const DeltaSegment<T, Enabled>& segment) {
+  // DeltaSegments always get erased. Their values are decoded one after another, so that the virtual function calls
+  // hardly matter, while an additional iterable type would increase the compile time of every operator.
+  return AnySegmentIterable<T>(DeltaSegmentIterable<T>(segment));
+}
+
+template <typename T, typename Enabled, bool EraseSegmentType>
+auto create_iterable_from_segment(const ALPSegment<T, Enabled>& segment) {
+  // ALPSegments always get erased. Sequential iteration runs over the decompressed values anyway.
+  return AnySegmentIterable<T>(ALPSegmentIterable<T>(segment));
+}
+
 }  // namespace opossum
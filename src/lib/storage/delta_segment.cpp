@@ -0,0 +1,136 @@
+#include "delta_segment.hpp"
+
+#include "resolve_type.hpp"
+#include "storage/vector_compression/base_compressed_vector.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+template <typename T, typename U>
+DeltaSegment<T, U>::DeltaSegment(pmr_vector<T> block_bases, pmr_vector<T> block_minimum_deltas,
+                                 pmr_vector<ChunkOffset> exception_positions, pmr_vector<T> exception_values,
+                                 std::optional<pmr_vector<bool>> null_values,
+                                 std::unique_ptr<const BaseCompressedVector> offset_values)
+    : AbstractEncodedSegment{data_type_from_type<T>()},
+      _block_bases{std::move(block_bases)},
+      _block_minimum_deltas{std::move(block_minimum_deltas)},
+      _exception_positions{std::move(exception_positions)},
+      _exception_values{std::move(exception_values)},
+      _null_values{std::move(null_values)},
+      _offset_values{std::move(offset_values)},
+      _decompressor{_offset_values->create_base_decompressor()} {
+  Assert(_block_bases.size() == _block_minimum_deltas.size(), "Expected one base and one minimum delta per block");
+  Assert(_exception_positions.size() == _exception_values.size(), "Expected one value per exception position");
+
+  const auto block_count = _block_bases.size();
+  _block_exception_indices.resize(block_count + 1);
+  auto exception_index = ChunkOffset{0};
+  for (auto block_index = size_t{0}; block_index <= block_count; ++block_index) {
+    while (exception_index < _exception_positions.size() &&
+           _exception_positions[exception_index] < block_index * block_size) {
+      ++exception_index;
+    }
+    _block_exception_indices[block_index] = exception_index;
+  }
+}
+
+template <typename T, typename U>
+const pmr_vector<T>& DeltaSegment<T, U>::block_bases() const {
+  return _block_bases;
+}
+
+template <typename T, typename U>
+const pmr_vector<T>& DeltaSegment<T, U>::block_minimum_deltas() const {
+  return _block_minimum_deltas;
+}
+
+template <typename T, typename U>
+const pmr_vector<ChunkOffset>& DeltaSegment<T, U>::exception_positions() const {
+  return _exception_positions;
+}
+
+template <typename T, typename U>
+const pmr_vector<T>& DeltaSegment<T, U>::exception_values() const {
+  return _exception_values;
+}
+
+template <typename T, typename U>
+const std::optional<pmr_vector<bool>>& DeltaSegment<T, U>::null_values() const {
+  return _null_values;
+}
+
+template <typename T, typename U>
+const BaseCompressedVector& DeltaSegment<T, U>::offset_values() const {
+  return *_offset_values;
+}
+
+template <typename T, typename U>
+AllTypeVariant DeltaSegment<T, U>::operator[](const ChunkOffset chunk_offset) const {
+  PerformanceWarning("operator[] used");
+  DebugAssert(chunk_offset < size(), "Passed chunk offset must be valid.");
+
+  const auto typed_value = get_typed_value(chunk_offset);
+  if (!typed_value) {
+    return NULL_VALUE;
+  }
+  return *typed_value;
+}
+
+template <typename T, typename U>
+ChunkOffset DeltaSegment<T, U>::size() const {
+  return static_cast<ChunkOffset>(_offset_values->size());
+}
+
+template <typename T, typename U>
+std::shared_ptr<AbstractSegment> DeltaSegment<T, U>::copy_using_allocator(
+    const PolymorphicAllocator<size_t>& alloc) const {
+  auto new_block_bases = pmr_vector<T>(_block_bases, alloc);
+  auto new_block_minimum_deltas = pmr_vector<T>(_block_minimum_deltas, alloc);
+  auto new_exception_positions = pmr_vector<ChunkOffset>(_exception_positions, alloc);
+  auto new_exception_values = pmr_vector<T>(_exception_values, alloc);
+  auto new_offset_values = _offset_values->copy_using_allocator(alloc);
+
+  std::optional<pmr_vector<bool>> null_values;
+  if (_null_values) {
+    null_values = pmr_vector<bool>(*_null_values, alloc);
+  }
+
+  auto copy = std::make_shared<DeltaSegment>(std::move(new_block_bases), std::move(new_block_minimum_deltas),
+                                             std::move(new_exception_positions), std::move(new_exception_values),
+                                             std::move(null_values), std::move(new_offset_values));
+  copy->access_counter = access_counter;
+  return copy;
+}
+
+template <typename T, typename U>
+size_t DeltaSegment<T, U>::memory_usage(const MemoryUsageCalculationMode) const {
+  // MemoryUsageCalculationMode ignored since full calculation is efficient.
+  size_t segment_size = sizeof(*this) + sizeof(T) * _block_bases.capacity() +
+                        sizeof(T) * _block_minimum_deltas.capacity() +
+                        sizeof(ChunkOffset) * _exception_positions.capacity() +
+                        sizeof(T) * _exception_values.capacity() +
+                        sizeof(ChunkOffset) * _block_exception_indices.capacity() + _offset_values->data_size() +
+                        sizeof(_null_values);
+
+  if (_null_values) {
+    segment_size += _null_values->capacity() / CHAR_BIT;
+  }
+
+  return segment_size;
+}
+
+template <typename T, typename U>
+EncodingType DeltaSegment<T, U>::encoding_type() const {
+  return EncodingType::Delta;
+}
+
+template <typename T, typename U>
+std::optional<CompressedVectorType> DeltaSegment<T, U>::compressed_vector_type() const {
+  return _offset_values->type();
+}
+
+template class DeltaSegment<int32_t>;
+template class DeltaSegment<int64_t>;
+
+}  // namespace opossum
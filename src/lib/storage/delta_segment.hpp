@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+#include <boost/hana/contains.hpp>
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/type.hpp>
+
+#include "abstract_encoded_segment.hpp"
+#include "storage/vector_compression/base_compressed_vector.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseCompressedVector;
+
+/**
+ * @brief Segment implementing delta encoding
+ *
+ * Delta encoding stores the differences between consecutive values instead of the values themselves. For sorted or
+ * otherwise monotonic segments (e.g., auto-incremented keys or timestamps), these differences are much smaller than
+ * the offsets of frame-of-reference encoding, which grow with the value range of a block.
+ *
+ * The segment is divided into fixed-size blocks. For each block, the first value (block base) and the minimum delta
+ * within the block are stored. The delta of each following row is then stored as an offset from that minimum delta,
+ * so that also decreasing (i.e., negative) deltas can be compressed using vector compression. The offset of the first
+ * row of each block is unused and zero. Thus, the value of a row is its block's base plus the sum of the (minimum
+ * delta + offset) of all following rows of the block up to the row. Point access has to sum up to block_size - 1
+ * offsets, which is why the blocks are much smaller than those of the FrameOfReferenceSegment. All differences are
+ * calculated modulo 2^n (i.e., on the unsigned type), so that overflows do not lead to undefined behavior.
+ *
+ * As vector compression handles 32 bit values only, the offsets must fit into uint32_t. If the range of the deltas
+ * within a block is larger, the encoder chooses the minimum delta such that as many deltas as possible fit. Rows whose
+ * delta does not fit are stored as exceptions, i.e., their position and their value are stored separately (like in
+ * the ALPSegment). Their offset is zero, and the following rows of the block continue from the exception's value.
+ *
+ * Null values are stored in a separate vector. Their delta is zero, i.e., they repeat the previous value (or, at the
+ * beginning of a block, the first non-null value of the block) so that they do not increase the range of deltas.
+ *
+ * See FrameOfReferenceSegment for why std::enable_if_t is used.
+ */
+template <typename T, typename = std::enable_if_t<encoding_supports_data_type(enum_c<EncodingType, EncodingType::Delta>,
+                                                                               hana::type_c<T>)>>
+class DeltaSegment : public AbstractEncodedSegment {
+ public:
+  static constexpr auto block_size = 128u;
+
+  explicit DeltaSegment(pmr_vector<T> block_bases, pmr_vector<T> block_minimum_deltas,
+                        pmr_vector<ChunkOffset> exception_positions, pmr_vector<T> exception_values,
+                        std::optional<pmr_vector<bool>> null_values,
+                        std::unique_ptr<const BaseCompressedVector> offset_values);
+
+  const pmr_vector<T>& block_bases() const;
+  const pmr_vector<T>& block_minimum_deltas() const;
+
+  // The positions of the exceptions are sorted. The first row of a block is never an exception.
+  const pmr_vector<ChunkOffset>& exception_positions() const;
+  const pmr_vector<T>& exception_values() const;
+  const std::optional<pmr_vector<bool>>& null_values() const;
+  const BaseCompressedVector& offset_values() const;
+
+  /**
+   * @defgroup AbstractSegment interface
+   * @{
+   */
+
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
+
+  std::optional<T> get_typed_value(const ChunkOffset chunk_offset) const {
+    // performance critical - not in cpp to help with inlining
+    if (_null_values && (*_null_values)[chunk_offset]) {
+      return std::nullopt;
+    }
+
+    using UnsignedT = std::make_unsigned_t<T>;
+
+    const auto block_index = chunk_offset / block_size;
+    const auto minimum_delta = static_cast<UnsignedT>(_block_minimum_deltas[block_index]);
+    auto value = static_cast<UnsignedT>(_block_bases[block_index]);
+    auto current_offset = ChunkOffset{block_index * block_size + 1};
+
+    // Continue from the last exception of the block up to the row, if there is one. Only the block's own exceptions
+    // are visited, which are none for most blocks.
+    const auto block_exceptions_end = _block_exception_indices[block_index + 1];
+    for (auto exception_index = _block_exception_indices[block_index];
+         exception_index < block_exceptions_end && _exception_positions[exception_index] <= chunk_offset;
+         ++exception_index) {
+      value = static_cast<UnsignedT>(_exception_values[exception_index]);
+      current_offset = _exception_positions[exception_index] + 1;
+    }
+
+    for (; current_offset <= chunk_offset; ++current_offset) {
+      value += minimum_delta + static_cast<UnsignedT>(_decompressor->get(current_offset));
+    }
+    return static_cast<T>(value);
+  }
+
+  ChunkOffset size() const final;
+
+  std::shared_ptr<AbstractSegment> copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const final;
+
+  size_t memory_usage(const MemoryUsageCalculationMode) const final;
+
+  /**@}*/
+
+  /**
+   * @defgroup AbstractEncodedSegment interface
+   * @{
+   */
+
+  EncodingType encoding_type() const final;
+  std::optional<CompressedVectorType> compressed_vector_type() const final;
+
+  /**@}*/
+
+ private:
+  const pmr_vector<T> _block_bases;
+  const pmr_vector<T> _block_minimum_deltas;
+  const pmr_vector<ChunkOffset> _exception_positions;
+  const pmr_vector<T> _exception_values;
+  const std::optional<pmr_vector<bool>> _null_values;
+  const std::unique_ptr<const BaseCompressedVector> _offset_values;
+  std::unique_ptr<BaseVectorDecompressor> _decompressor;
+
+  // For each block, the index of its first exception in _exception_positions, followed by the number of exceptions
+  pmr_vector<ChunkOffset> _block_exception_indices;
+};
+
+extern template class DeltaSegment<int32_t>;
+extern template class DeltaSegment<int64_t>;
+
+}  // namespace opossum
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "storage/base_segment_encoder.hpp"
+
+#include "storage/delta_segment.hpp"
+#include "storage/frame_of_reference_segment/frame_of_reference_encoder.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/value_segment/value_segment_iterable.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/enum_constant.hpp"
+
+namespace opossum {
+
+class DeltaEncoder : public SegmentEncoder<DeltaEncoder> {
+ public:
+  static constexpr auto _encoding_type = enum_c<EncodingType, EncodingType::Delta>;
+  static constexpr auto _uses_vector_compression = true;  // see base_segment_encoder.hpp for details
+
+  template <typename T>
+  std::shared_ptr<AbstractEncodedSegment> _on_encode(const AnySegmentIterable<T> segment_iterable,
+                                                     const PolymorphicAllocator<T>& allocator) {
+    static constexpr auto block_size = DeltaSegment<T>::block_size;
+
+    // Deltas are calculated on unsigned values, as they might overflow T
+    using UnsignedT = std::make_unsigned_t<T>;
+
+    // Ceiling of integer division
+    const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
+
+    // hold the first value and the minimum delta of each block
+    auto block_bases = pmr_vector<T>{allocator};
+    auto block_minimum_deltas = pmr_vector<T>{allocator};
+
+    // holds the positions and values of rows whose delta does not fit into the frame of their block
+    auto exception_positions = pmr_vector<ChunkOffset>{allocator};
+    auto exception_values = pmr_vector<T>{allocator};
+
+    // holds the uncompressed offsets of the deltas from the minimum delta of their block
+    auto offset_values = pmr_vector<uint32_t>{allocator};
+
+    // holds whether a segment value is null
+    auto null_values = pmr_vector<bool>{allocator};
+
+    // used as optional input for the compression of the offset values
+    auto max_offset = uint32_t{0u};
+
+    auto segment_contains_null_values = false;
+
+    segment_iterable.with_iterators([&](auto segment_it, auto segment_end) {
+      const auto size = std::distance(segment_it, segment_end);
+      const auto num_blocks = div_ceil(size, block_size);
+
+      block_bases.reserve(num_blocks);
+      block_minimum_deltas.reserve(num_blocks);
+      offset_values.reserve(size);
+      null_values.reserve(size);
+
+      // temporary storage to hold the values and null flags of one block
+      auto current_value_block = std::array<T, block_size>{};
+      auto current_null_block = std::array<bool, block_size>{};
+
+      auto block_begin = ChunkOffset{0};
+
+      while (segment_it != segment_end) {
+        auto block_value_count = size_t{0};
+        auto first_non_null_value = std::optional<T>{};
+        for (; block_value_count < block_size && segment_it != segment_end; ++block_value_count, ++segment_it) {
+          const auto segment_value = *segment_it;
+          const auto value_is_null = segment_value.is_null();
+
+          current_value_block[block_value_count] = value_is_null ? T{0} : segment_value.value();
+          current_null_block[block_value_count] = value_is_null;
+          null_values.push_back(value_is_null);
+          segment_contains_null_values |= value_is_null;
+
+          if (!value_is_null && !first_non_null_value) {
+            first_non_null_value = segment_value.value();
+          }
+        }
+
+        // Null values repeat the previous value, so that their delta is zero
+        auto previous_value = first_non_null_value.value_or(T{0});
+        for (auto index = size_t{0}; index < block_value_count; ++index) {
+          if (current_null_block[index]) {
+            current_value_block[index] = previous_value;
+          }
+          previous_value = current_value_block[index];
+        }
+
+        // The deltas are interpreted as signed values to find the minimum. As they are calculated modulo 2^n, this
+        // also works if the difference of two values does not fit into T.
+        auto min_delta = T{0};
+        auto max_delta = T{0};
+        for (auto index = size_t{1}; index < block_value_count; ++index) {
+          const auto delta = static_cast<T>(static_cast<UnsignedT>(current_value_block[index]) -
+                                            static_cast<UnsignedT>(current_value_block[index - 1]));
+          if (index == 1) {
+            min_delta = delta;
+            max_delta = delta;
+          }
+          min_delta = std::min(min_delta, delta);
+          max_delta = std::max(max_delta, delta);
+        }
+
+        // The offsets have to fit into uint32_t (required for vector compression). Otherwise, the minimum delta is
+        // chosen such that as many deltas as possible fit, the others become exceptions.
+        if (static_cast<UnsignedT>(max_delta) - static_cast<UnsignedT>(min_delta) >
+            std::numeric_limits<uint32_t>::max()) {
+          auto deltas = std::vector<T>(block_value_count - 1);
+          for (auto index = size_t{1}; index < block_value_count; ++index) {
+            deltas[index - 1] = static_cast<T>(static_cast<UnsignedT>(current_value_block[index]) -
+                                               static_cast<UnsignedT>(current_value_block[index - 1]));
+          }
+          min_delta = FrameOfReferenceEncoder::frame_minimum(std::move(deltas));
+        }
+
+        block_bases.push_back(current_value_block[0]);
+        block_minimum_deltas.push_back(min_delta);
+
+        offset_values.push_back(0u);
+        for (auto index = size_t{1}; index < block_value_count; ++index) {
+          const auto delta = static_cast<UnsignedT>(current_value_block[index]) -
+                             static_cast<UnsignedT>(current_value_block[index - 1]);
+          const auto offset = delta - static_cast<UnsignedT>(min_delta);
+          if (offset > std::numeric_limits<uint32_t>::max()) {
+            exception_positions.push_back(static_cast<ChunkOffset>(block_begin + index));
+            exception_values.push_back(current_value_block[index]);
+            offset_values.push_back(0u);
+            continue;
+          }
+
+          offset_values.push_back(static_cast<uint32_t>(offset));
+          max_offset = std::max(max_offset, static_cast<uint32_t>(offset));
+        }
+        block_begin += static_cast<ChunkOffset>(block_value_count);
+      }
+    });
+
+    auto compressed_offset_values = compress_vector(offset_values, vector_compression_type(), allocator, {max_offset});
+
+    if (segment_contains_null_values) {
+      return std::make_shared<DeltaSegment<T>>(std::move(block_bases), std::move(block_minimum_deltas),
+                                               std::move(exception_positions), std::move(exception_values),
+                                               std::move(null_values), std::move(compressed_offset_values));
+    }
+    return std::make_shared<DeltaSegment<T>>(std::move(block_bases), std::move(block_minimum_deltas),
+                                             std::move(exception_positions), std::move(exception_values),
+                                             std::nullopt, std::move(compressed_offset_values));
+  }
+};
+
+}  // namespace opossum
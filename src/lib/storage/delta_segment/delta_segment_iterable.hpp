@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <type_traits>
+
+#include "storage/abstract_segment.hpp"
+#include "storage/delta_segment.hpp"
+#include "storage/segment_iterables.hpp"
+#include "storage/vector_compression/resolve_compressed_vector_type.hpp"
+
+namespace opossum {
+
+template <typename T>
+class DeltaSegmentIterable : public PointAccessibleSegmentIterable<DeltaSegmentIterable<T>> {
+ public:
+  using ValueType = T;
+
+  explicit DeltaSegmentIterable(const DeltaSegment<T>& segment) : _segment{segment} {}
+
+  template <typename Functor>
+  void _on_with_iterators(const Functor& functor) const {
+    _segment.access_counter[SegmentAccessCounter::AccessType::Sequential] += _segment.size();
+    resolve_compressed_vector_type(_segment.offset_values(), [&](const auto& offset_values) {
+      using OffsetValueDecompressor = std::decay_t<decltype(offset_values.create_decompressor())>;
+
+      auto begin = Iterator<OffsetValueDecompressor>{
+          &_segment.null_values(), ValueDecoder<OffsetValueDecompressor>{_segment, offset_values.create_decompressor()},
+          ChunkOffset{0}};
+
+      auto end = Iterator<OffsetValueDecompressor>{
+          &_segment.null_values(), ValueDecoder<OffsetValueDecompressor>{_segment, offset_values.create_decompressor()},
+          static_cast<ChunkOffset>(_segment.size())};
+
+      functor(begin, end);
+    });
+  }
+
+  template <typename Functor, typename PosListType>
+  void _on_with_iterators(const std::shared_ptr<PosListType>& position_filter, const Functor& functor) const {
+    _segment.access_counter[SegmentAccessCounter::access_type(*position_filter)] += position_filter->size();
+    resolve_compressed_vector_type(_segment.offset_values(), [&](const auto& offset_values) {
+      using OffsetValueDecompressor = std::decay_t<decltype(offset_values.create_decompressor())>;
+      using PosListIteratorType = std::decay_t<decltype(position_filter->cbegin())>;
+
+      auto begin = PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>{
+          &_segment.null_values(), ValueDecoder<OffsetValueDecompressor>{_segment, offset_values.create_decompressor()},
+          position_filter->cbegin(), position_filter->cbegin()};
+
+      auto end = PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>{
+          &_segment.null_values(), ValueDecoder<OffsetValueDecompressor>{_segment, offset_values.create_decompressor()},
+          position_filter->cbegin(), position_filter->cend()};
+
+      functor(begin, end);
+    });
+  }
+
+  size_t _on_size() const { return _segment.size(); }
+
+ private:
+  const DeltaSegment<T>& _segment;
+
+ private:
+  /**
+   * Decodes the value at a chunk offset. As the value depends on all previous values of its block, the decoder
+   * remembers the last decoded value. If the next requested offset lies behind it in the same block (which is the
+   * case for sequential iteration and for sorted position filters), decoding continues from there instead of from the
+   * beginning of the block. The decoder also remembers the next exception, so that exceptions are only looked up when
+   * decoding restarts at the beginning of a block.
+   */
+  template <typename OffsetValueDecompressor>
+  class ValueDecoder {
+   public:
+    using UnsignedT = std::make_unsigned_t<T>;
+    static constexpr auto block_size = DeltaSegment<T>::block_size;
+
+    ValueDecoder(const DeltaSegment<T>& segment, OffsetValueDecompressor offset_value_decompressor)
+        : _block_bases{&segment.block_bases()},
+          _block_minimum_deltas{&segment.block_minimum_deltas()},
+          _exception_positions{&segment.exception_positions()},
+          _exception_values{&segment.exception_values()},
+          _offset_value_decompressor{std::move(offset_value_decompressor)} {}
+
+    T decode(const ChunkOffset chunk_offset) {
+      const auto block_index = chunk_offset / block_size;
+      const auto minimum_delta = static_cast<UnsignedT>((*_block_minimum_deltas)[block_index]);
+
+      if (!_last_chunk_offset || *_last_chunk_offset / block_size != block_index ||
+          *_last_chunk_offset > chunk_offset) {
+        _last_chunk_offset = block_index * block_size;
+        _last_value = static_cast<UnsignedT>((*_block_bases)[block_index]);
+        _next_exception_index = static_cast<size_t>(std::distance(
+            _exception_positions->cbegin(),
+            std::upper_bound(_exception_positions->cbegin(), _exception_positions->cend(), *_last_chunk_offset)));
+      }
+
+      for (auto current_offset = *_last_chunk_offset + 1; current_offset <= chunk_offset; ++current_offset) {
+        if (_next_exception_index < _exception_positions->size() &&
+            (*_exception_positions)[_next_exception_index] == current_offset) {
+          _last_value = static_cast<UnsignedT>((*_exception_values)[_next_exception_index]);
+          ++_next_exception_index;
+          continue;
+        }
+        _last_value += minimum_delta + static_cast<UnsignedT>(_offset_value_decompressor.get(current_offset));
+      }
+      _last_chunk_offset = chunk_offset;
+
+      return static_cast<T>(_last_value);
+    }
+
+   private:
+    const pmr_vector<T>* _block_bases;
+    const pmr_vector<T>* _block_minimum_deltas;
+    const pmr_vector<ChunkOffset>* _exception_positions;
+    const pmr_vector<T>* _exception_values;
+    OffsetValueDecompressor _offset_value_decompressor;
+    std::optional<ChunkOffset> _last_chunk_offset;
+    UnsignedT _last_value{0};
+    size_t _next_exception_index{0};
+  };
+
+  template <typename OffsetValueDecompressor>
+  class Iterator : public AbstractSegmentIterator<Iterator<OffsetValueDecompressor>, SegmentPosition<T>> {
+   public:
+    using ValueType = T;
+    using IterableType = DeltaSegmentIterable<T>;
+
+   public:
+    explicit Iterator(const std::optional<pmr_vector<bool>>* null_values,
+                      ValueDecoder<OffsetValueDecompressor> value_decoder, ChunkOffset chunk_offset)
+        : _null_values{null_values}, _value_decoder{std::move(value_decoder)}, _chunk_offset{chunk_offset} {}
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    void increment() { ++_chunk_offset; }
+
+    void decrement() { --_chunk_offset; }
+
+    void advance(std::ptrdiff_t n) { _chunk_offset += n; }
+
+    bool equal(const Iterator& other) const { return _chunk_offset == other._chunk_offset; }
+
+    std::ptrdiff_t distance_to(const Iterator& other) const {
+      return static_cast<std::ptrdiff_t>(other._chunk_offset) - _chunk_offset;
+    }
+
+    SegmentPosition<T> dereference() const {
+      const auto is_null = *_null_values ? (**_null_values)[_chunk_offset] : false;
+      const auto value = _value_decoder.decode(_chunk_offset);
+
+      return SegmentPosition<T>{value, is_null, _chunk_offset};
+    }
+
+   private:
+    const std::optional<pmr_vector<bool>>* _null_values;
+    mutable ValueDecoder<OffsetValueDecompressor> _value_decoder;
+    ChunkOffset _chunk_offset;
+  };
+
+  template <typename OffsetValueDecompressor, typename PosListIteratorType>
+  class PointAccessIterator
+      : public AbstractPointAccessSegmentIterator<PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>,
+                                                  SegmentPosition<T>, PosListIteratorType> {
+   public:
+    using ValueType = T;
+    using IterableType = DeltaSegmentIterable<T>;
+
+    PointAccessIterator(const std::optional<pmr_vector<bool>>* null_values,
+                        ValueDecoder<OffsetValueDecompressor> value_decoder, PosListIteratorType position_filter_begin,
+                        PosListIteratorType position_filter_it)
+        : AbstractPointAccessSegmentIterator<PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>,
+                                             SegmentPosition<T>, PosListIteratorType>{std::move(position_filter_begin),
+                                                                                      std::move(position_filter_it)},
+          _null_values{null_values},
+          _value_decoder{std::move(value_decoder)} {}
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    SegmentPosition<T> dereference() const {
+      const auto& chunk_offsets = this->chunk_offsets();
+      const auto current_offset = chunk_offsets.offset_in_referenced_chunk;
+
+      const auto is_null = *_null_values ? (**_null_values)[current_offset] : false;
+      const auto value = _value_decoder.decode(current_offset);
+
+      return SegmentPosition<T>{value, is_null, chunk_offsets.offset_in_poslist};
+    }
+
+   private:
+    const std::optional<pmr_vector<bool>>* _null_values;
+    mutable ValueDecoder<OffsetValueDecompressor> _value_decoder;
+  };
+};
+
+}  // namespace opossum
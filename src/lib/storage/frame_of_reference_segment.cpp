@@ -9,19 +9,35 @@ namespace opossum {
 
 template <typename T, typename U>
 FrameOfReferenceSegment<T, U>::FrameOfReferenceSegment(pmr_vector<T> block_minima,
+                                                       pmr_vector<ChunkOffset> exception_positions,
+                                                       pmr_vector<T> exception_values,
                                                        std::optional<pmr_vector<bool>> null_values,
                                                        std::unique_ptr<const BaseCompressedVector> offset_values)
     : AbstractEncodedSegment{data_type_from_type<T>()},
       _block_minima{std::move(block_minima)},
+      _exception_positions{std::move(exception_positions)},
+      _exception_values{std::move(exception_values)},
       _null_values{std::move(null_values)},
       _offset_values{std::move(offset_values)},
-      _decompressor{_offset_values->create_base_decompressor()} {}
+      _decompressor{_offset_values->create_base_decompressor()} {
+  Assert(_exception_positions.size() == _exception_values.size(), "Expected one value per exception position");
+}
 
 template <typename T, typename U>
 const pmr_vector<T>& FrameOfReferenceSegment<T, U>::block_minima() const {
   return _block_minima;
 }
 
+template <typename T, typename U>
+const pmr_vector<ChunkOffset>& FrameOfReferenceSegment<T, U>::exception_positions() const {
+  return _exception_positions;
+}
+
+template <typename T, typename U>
+const pmr_vector<T>& FrameOfReferenceSegment<T, U>::exception_values() const {
+  return _exception_values;
+}
+
 template <typename T, typename U>
 const std::optional<pmr_vector<bool>>& FrameOfReferenceSegment<T, U>::null_values() const {
   return _null_values;
@@ -53,6 +69,8 @@ template <typename T, typename U>
 std::shared_ptr<AbstractSegment> FrameOfReferenceSegment<T, U>::copy_using_allocator(
     const PolymorphicAllocator<size_t>& alloc) const {
   auto new_block_minima = pmr_vector<T>(_block_minima, alloc);
+  auto new_exception_positions = pmr_vector<ChunkOffset>(_exception_positions, alloc);
+  auto new_exception_values = pmr_vector<T>(_exception_values, alloc);
   auto new_offset_values = _offset_values->copy_using_allocator(alloc);
 
   std::optional<pmr_vector<bool>> null_values;
@@ -60,7 +78,9 @@ std::shared_ptr<AbstractSegment> FrameOfReferenceSegment<T, U>::copy_using_alloc
     null_values = pmr_vector<bool>(*_null_values, alloc);
   }
 
-  auto copy = std::make_shared<FrameOfReferenceSegment>(std::move(new_block_minima), std::move(null_values),
+  auto copy = std::make_shared<FrameOfReferenceSegment>(std::move(new_block_minima),
+                                                        std::move(new_exception_positions),
+                                                        std::move(new_exception_values), std::move(null_values),
                                                         std::move(new_offset_values));
   copy->access_counter = access_counter;
   return copy;
@@ -69,8 +89,9 @@ std::shared_ptr<AbstractSegment> FrameOfReferenceSegment<T, U>::copy_using_alloc
 template <typename T, typename U>
 size_t FrameOfReferenceSegment<T, U>::memory_usage(const MemoryUsageCalculationMode) const {
   // MemoryUsageCalculationMode ignored since full calculation is efficient.
-  size_t segment_size =
-      sizeof(*this) + sizeof(T) * _block_minima.capacity() + _offset_values->data_size() + sizeof(_null_values);
+  size_t segment_size = sizeof(*this) + sizeof(T) * _block_minima.capacity() +
+                        sizeof(ChunkOffset) * _exception_positions.capacity() +
+                        sizeof(T) * _exception_values.capacity() + _offset_values->data_size() + sizeof(_null_values);
 
   if (_null_values) {
     segment_size += _null_values->capacity() / CHAR_BIT;
@@ -90,7 +111,6 @@ std::optional<CompressedVectorType> FrameOfReferenceSegment<T, U>::compressed_ve
 }
 
 template class FrameOfReferenceSegment<int32_t>;
-// int64_t disabled for now, as vector compression cannot handle 64 bit values - also in reference_segment_iterable.hpp
-// template class FrameOfReferenceSegment<int64_t>;
+template class FrameOfReferenceSegment<int64_t>;
 
 }  // namespace opossum
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <type_traits>
@@ -27,13 +28,20 @@ class BaseCompressedVector;
  * FOR encoding on its own without vector compression does not
  * add any benefit.
  *
+ * As vector compression handles 32 bit values only, the offsets must
+ * fit into uint32_t. This always holds for int32_t. For int64_t blocks
+ * with a larger value range, the encoder chooses the minimum such that
+ * as many values as possible fit. The remaining values are stored as
+ * exceptions, i.e., their position and their value are stored
+ * separately (like in the ALPSegment). Their offset is zero.
+ *
  * Null values are stored in a separate vector. Note, for correct
  * offset handling, the minimum of each frame is stored in the
  * offset_values vector at each position that is NULL.
  *
  * std::enable_if_t must be used here and cannot be replaced by a
  * static_assert in order to prevent instantiation of
- * FrameOfReferenceSegment<T> with T other than int32_t. Otherwise,
+ * FrameOfReferenceSegment<T> with T other than int32_t or int64_t. Otherwise,
  * the compiler might instantiate FrameOfReferenceSegment with other
  * types even if they are never actually needed.
  * "If the function selected by overload resolution can be determined
@@ -54,10 +62,16 @@ class FrameOfReferenceSegment : public AbstractEncodedSegment {
    */
   static constexpr auto block_size = 2048u;
 
-  explicit FrameOfReferenceSegment(pmr_vector<T> block_minima, std::optional<pmr_vector<bool>> null_values,
+  explicit FrameOfReferenceSegment(pmr_vector<T> block_minima, pmr_vector<ChunkOffset> exception_positions,
+                                   pmr_vector<T> exception_values, std::optional<pmr_vector<bool>> null_values,
                                    std::unique_ptr<const BaseCompressedVector> offset_values);
 
   const pmr_vector<T>& block_minima() const;
+
+  // The positions of the exceptions are sorted. Only int64_t segments can have exceptions.
+  const pmr_vector<ChunkOffset>& exception_positions() const;
+  const pmr_vector<T>& exception_values() const;
+
   const std::optional<pmr_vector<bool>>& null_values() const;
   const BaseCompressedVector& offset_values() const;
 
@@ -73,6 +87,15 @@ class FrameOfReferenceSegment : public AbstractEncodedSegment {
     if (_null_values && (*_null_values)[chunk_offset]) {
       return std::nullopt;
     }
+
+    if (!_exception_positions.empty()) {
+      const auto exception_it =
+          std::lower_bound(_exception_positions.cbegin(), _exception_positions.cend(), chunk_offset);
+      if (exception_it != _exception_positions.cend() && *exception_it == chunk_offset) {
+        return _exception_values[std::distance(_exception_positions.cbegin(), exception_it)];
+      }
+    }
+
     const auto minimum = _block_minima[chunk_offset / block_size];
     const auto value = static_cast<T>(_decompressor->get(chunk_offset)) + minimum;
     return value;
@@ -98,11 +121,14 @@ class FrameOfReferenceSegment : public AbstractEncodedSegment {
 
  private:
   const pmr_vector<T> _block_minima;
+  const pmr_vector<ChunkOffset> _exception_positions;
+  const pmr_vector<T> _exception_values;
   const std::optional<pmr_vector<bool>> _null_values;
   const std::unique_ptr<const BaseCompressedVector> _offset_values;
   std::unique_ptr<BaseVectorDecompressor> _decompressor;
 };
 
 extern template class FrameOfReferenceSegment<int32_t>;
+extern template class FrameOfReferenceSegment<int64_t>;
 
 }  // namespace opossum
@@ -4,6 +4,8 @@
 #include <array>
 #include <limits>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 #include "storage/base_segment_encoder.hpp"
 
@@ -12,6 +14,7 @@
 #include "storage/value_segment/value_segment_iterable.hpp"
 #include "storage/vector_compression/vector_compression.hpp"
 #include "types.hpp"
+#include "utils/assert.hpp"
 #include "utils/enum_constant.hpp"
 
 namespace opossum {
@@ -21,17 +24,52 @@ class FrameOfReferenceEncoder : public SegmentEncoder<FrameOfReferenceEncoder> {
   static constexpr auto _encoding_type = enum_c<EncodingType, EncodingType::FrameOfReference>;
   static constexpr auto _uses_vector_compression = true;  // see base_segment_encoder.hpp for details
 
+  /**
+   * Returns the minimum of the frame [minimum, minimum + 2^32 - 1] that contains as many of the (non-empty) values as
+   * possible, so that they can be stored as uint32_t offsets. Values outside of the frame have to be stored as
+   * exceptions. Used for blocks whose value range exceeds uint32_t, which is only possible for 64 bit types.
+   */
+  template <typename T>
+  static T frame_minimum(std::vector<T> values) {
+    using UnsignedT = std::make_unsigned_t<T>;
+
+    std::sort(values.begin(), values.end());
+
+    auto best_begin = size_t{0};
+    auto best_count = size_t{0};
+    auto begin = size_t{0};
+    for (auto end = size_t{0}; end < values.size(); ++end) {
+      while (static_cast<UnsignedT>(values[end]) - static_cast<UnsignedT>(values[begin]) >
+             std::numeric_limits<uint32_t>::max()) {
+        ++begin;
+      }
+      if (end - begin + 1 > best_count) {
+        best_begin = begin;
+        best_count = end - begin + 1;
+      }
+    }
+
+    return values[best_begin];
+  }
+
   template <typename T>
   std::shared_ptr<AbstractEncodedSegment> _on_encode(const AnySegmentIterable<T> segment_iterable,
                                                      const PolymorphicAllocator<T>& allocator) {
     static constexpr auto block_size = FrameOfReferenceSegment<T>::block_size;
 
+    // Differences are calculated on unsigned values, as they might overflow T
+    using UnsignedT = std::make_unsigned_t<T>;
+
     // Ceiling of integer division
     const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
 
     // holds the minimum of each block
     auto block_minima = pmr_vector<T>{allocator};
 
+    // holds the positions and values of values that do not fit into the frame of their block
+    auto exception_positions = pmr_vector<ChunkOffset>{allocator};
+    auto exception_values = pmr_vector<T>{allocator};
+
     // holds the uncompressed offset values
     auto offset_values = pmr_vector<uint32_t>{allocator};
 
@@ -57,6 +95,8 @@ class FrameOfReferenceEncoder : public SegmentEncoder<FrameOfReferenceEncoder> {
       // store iterator to the null values written within this block
       auto current_block_null_values_it = null_values.end();
 
+      auto block_begin = ChunkOffset{0};
+
       while (segment_it != segment_end) {
         auto min_value = std::numeric_limits<T>::max();
         auto max_value = std::numeric_limits<T>::lowest();
@@ -83,37 +123,59 @@ class FrameOfReferenceEncoder : public SegmentEncoder<FrameOfReferenceEncoder> {
         // The last value block might not be filled completely
         const auto this_value_block_end = value_block_it;
 
-        if (block_contains_values) {
-          // Make sure that the largest offset fits into uint32_t (required for vector compression).
-          Assert(static_cast<std::make_unsigned_t<T>>(max_value - min_value) <= std::numeric_limits<uint32_t>::max(),
-                 "Value range in block must fit into uint32_t.");
+        // The offsets have to fit into uint32_t (required for vector compression). This always holds for int32_t,
+        // but not necessarily for int64_t. In that case, the minimum is chosen such that as many values as possible
+        // fit, the others become exceptions.
+        if (block_contains_values && static_cast<UnsignedT>(max_value) - static_cast<UnsignedT>(min_value) >
+                                         std::numeric_limits<uint32_t>::max()) {
+          auto non_null_values = std::vector<T>{};
+          non_null_values.reserve(block_size);
+          auto null_value_it = current_block_null_values_it;
+          for (value_block_it = current_value_block.begin(); value_block_it != this_value_block_end;
+               ++value_block_it, ++null_value_it) {
+            if (!*null_value_it) non_null_values.push_back(*value_block_it);
+          }
+          min_value = frame_minimum(std::move(non_null_values));
         }
 
         block_minima.push_back(min_value);
 
+        auto chunk_offset = block_begin;
         value_block_it = current_value_block.begin();
-        for (; value_block_it != this_value_block_end; ++value_block_it, ++current_block_null_values_it) {
-          auto value = *value_block_it;
+        for (; value_block_it != this_value_block_end;
+             ++value_block_it, ++current_block_null_values_it, ++chunk_offset) {
+          // To ensure NULL values do not interfere with the min/max calculation (needed to calculate (i) the frame
+          // offset and (ii) the required width of the compressed vector), their offset is zero.
           if (*current_block_null_values_it) {
-            // To ensure NULL values do not interfere with the min/max calculation (needed to calculate (i) the frame
-            // offset and (ii) the required width of the compressed vector), we set them to the minimum value. As NULL
-            // values are stored as zeros, we might run in an overflow of the uint32_t when minimum > 0.
-            value = min_value;
+            offset_values.push_back(0u);
+            continue;
           }
-          const auto offset = static_cast<uint32_t>(value - min_value);
-          offset_values.push_back(offset);
-          max_offset = std::max(max_offset, offset);
+
+          const auto value = *value_block_it;
+          const auto offset = static_cast<UnsignedT>(value) - static_cast<UnsignedT>(min_value);
+          if (offset > std::numeric_limits<uint32_t>::max()) {
+            exception_positions.push_back(chunk_offset);
+            exception_values.push_back(value);
+            offset_values.push_back(0u);
+            continue;
+          }
+
+          offset_values.push_back(static_cast<uint32_t>(offset));
+          max_offset = std::max(max_offset, static_cast<uint32_t>(offset));
         }
+        block_begin = chunk_offset;
       }
     });
 
     auto compressed_offset_values = compress_vector(offset_values, vector_compression_type(), allocator, {max_offset});
 
     if (segment_contains_null_values) {
-      return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minima), std::move(null_values),
+      return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minima), std::move(exception_positions),
+                                                          std::move(exception_values), std::move(null_values),
                                                           std::move(compressed_offset_values));
     }
-    return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minima), std::nullopt,
+    return std::make_shared<FrameOfReferenceSegment<T>>(std::move(block_minima), std::move(exception_positions),
+                                                        std::move(exception_values), std::nullopt,
                                                         std::move(compressed_offset_values));
   }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
 
 #include "storage/abstract_segment.hpp"
@@ -22,11 +23,9 @@ class FrameOfReferenceSegmentIterable : public PointAccessibleSegmentIterable<Fr
     resolve_compressed_vector_type(_segment.offset_values(), [&](const auto& offset_values) {
       using OffsetValueDecompressor = std::decay_t<decltype(offset_values.create_decompressor())>;
 
-      auto begin = Iterator<OffsetValueDecompressor>{&_segment.block_minima(), &_segment.null_values(),
-                                                     offset_values.create_decompressor(), ChunkOffset{0}};
+      auto begin = Iterator<OffsetValueDecompressor>{&_segment, offset_values.create_decompressor(), ChunkOffset{0}};
 
-      auto end = Iterator<OffsetValueDecompressor>{&_segment.block_minima(), &_segment.null_values(),
-                                                   offset_values.create_decompressor(),
+      auto end = Iterator<OffsetValueDecompressor>{&_segment, offset_values.create_decompressor(),
                                                    static_cast<ChunkOffset>(_segment.size())};
 
       functor(begin, end);
@@ -41,12 +40,10 @@ class FrameOfReferenceSegmentIterable : public PointAccessibleSegmentIterable<Fr
       using PosListIteratorType = std::decay_t<decltype(position_filter->cbegin())>;
 
       auto begin = PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>{
-          &_segment.block_minima(), &_segment.null_values(), offset_values.create_decompressor(),
-          position_filter->cbegin(), position_filter->cbegin()};
+          &_segment, offset_values.create_decompressor(), position_filter->cbegin(), position_filter->cbegin()};
 
       auto end = PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>{
-          &_segment.block_minima(), &_segment.null_values(), offset_values.create_decompressor(),
-          position_filter->cbegin(), position_filter->cend()};
+          &_segment, offset_values.create_decompressor(), position_filter->cbegin(), position_filter->cend()};
 
       functor(begin, end);
     });
@@ -57,6 +54,30 @@ class FrameOfReferenceSegmentIterable : public PointAccessibleSegmentIterable<Fr
  private:
   const FrameOfReferenceSegment<T>& _segment;
 
+  // Returns the index of the first exception at or after the chunk offset
+  static size_t _find_exception_index(const FrameOfReferenceSegment<T>& segment, const ChunkOffset chunk_offset) {
+    const auto& exception_positions = segment.exception_positions();
+    return static_cast<size_t>(std::distance(
+        exception_positions.cbegin(),
+        std::lower_bound(exception_positions.cbegin(), exception_positions.cend(), chunk_offset)));
+  }
+
+  // Decodes the value at a chunk offset, given the index of the first exception at or after it
+  template <typename OffsetValueDecompressor>
+  static T _decode(const FrameOfReferenceSegment<T>& segment, OffsetValueDecompressor& offset_value_decompressor,
+                   const ChunkOffset chunk_offset, const size_t exception_index) {
+    static constexpr auto block_size = FrameOfReferenceSegment<T>::block_size;
+
+    const auto& exception_positions = segment.exception_positions();
+    if (exception_index < exception_positions.size() && exception_positions[exception_index] == chunk_offset) {
+      return segment.exception_values()[exception_index];
+    }
+
+    const auto block_minimum = segment.block_minima()[chunk_offset / block_size];
+    const auto offset_value = offset_value_decompressor.get(chunk_offset);
+    return static_cast<T>(offset_value) + block_minimum;
+  }
+
  private:
   template <typename OffsetValueDecompressor>
   class Iterator : public AbstractSegmentIterator<Iterator<OffsetValueDecompressor>, SegmentPosition<T>> {
@@ -65,21 +86,38 @@ class FrameOfReferenceSegmentIterable : public PointAccessibleSegmentIterable<Fr
     using IterableType = FrameOfReferenceSegmentIterable<T>;
 
    public:
-    explicit Iterator(const pmr_vector<T>* block_minima, const std::optional<pmr_vector<bool>>* null_values,
-                      OffsetValueDecompressor offset_value_decompressor, ChunkOffset chunk_offset)
-        : _block_minima{block_minima},
-          _null_values{null_values},
+    explicit Iterator(const FrameOfReferenceSegment<T>* segment, OffsetValueDecompressor offset_value_decompressor,
+                      ChunkOffset chunk_offset)
+        : _segment{segment},
           _offset_value_decompressor{std::move(offset_value_decompressor)},
-          _chunk_offset{chunk_offset} {}
+          _chunk_offset{chunk_offset},
+          _exception_index{_find_exception_index(*segment, chunk_offset)} {}
 
    private:
     friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
 
-    void increment() { ++_chunk_offset; }
+    // The cursor into the sorted exception positions moves along with the chunk offset, so that sequential access does
+    // not have to search for exceptions
+    void increment() {
+      ++_chunk_offset;
+      const auto& exception_positions = _segment->exception_positions();
+      if (_exception_index < exception_positions.size() && exception_positions[_exception_index] < _chunk_offset) {
+        ++_exception_index;
+      }
+    }
 
-    void decrement() { --_chunk_offset; }
+    void decrement() {
+      --_chunk_offset;
+      const auto& exception_positions = _segment->exception_positions();
+      if (_exception_index > 0 && exception_positions[_exception_index - 1] >= _chunk_offset) {
+        --_exception_index;
+      }
+    }
 
-    void advance(std::ptrdiff_t n) { _chunk_offset += n; }
+    void advance(std::ptrdiff_t n) {
+      _chunk_offset += n;
+      _exception_index = _find_exception_index(*_segment, _chunk_offset);
+    }
 
     bool equal(const Iterator& other) const { return _chunk_offset == other._chunk_offset; }
 
@@ -88,21 +126,18 @@ class FrameOfReferenceSegmentIterable : public PointAccessibleSegmentIterable<Fr
     }
 
     SegmentPosition<T> dereference() const {
-      static constexpr auto block_size = FrameOfReferenceSegment<T>::block_size;
-
-      const auto is_null = *_null_values ? (**_null_values)[_chunk_offset] : false;
-      const auto block_minimum = (*_block_minima)[_chunk_offset / block_size];
-      const auto offset_value = _offset_value_decompressor.get(_chunk_offset);
-      const auto value = static_cast<T>(offset_value) + block_minimum;
+      const auto& null_values = _segment->null_values();
+      const auto is_null = null_values ? (*null_values)[_chunk_offset] : false;
+      const auto value = _decode(*_segment, _offset_value_decompressor, _chunk_offset, _exception_index);
 
       return SegmentPosition<T>{value, is_null, _chunk_offset};
     }
 
    private:
-    const pmr_vector<T>* _block_minima;
-    const std::optional<pmr_vector<bool>>* _null_values;
+    const FrameOfReferenceSegment<T>* _segment;
     mutable OffsetValueDecompressor _offset_value_decompressor;
     ChunkOffset _chunk_offset;
+    size_t _exception_index;
   };
 
   template <typename OffsetValueDecompressor, typename PosListIteratorType>
@@ -113,36 +148,31 @@ class FrameOfReferenceSegmentIterable : public PointAccessibleSegmentIterable<Fr
     using ValueType = T;
     using IterableType = FrameOfReferenceSegmentIterable<T>;
 
-    PointAccessIterator(const pmr_vector<T>* block_minima, const std::optional<pmr_vector<bool>>* null_values,
-                        OffsetValueDecompressor offset_value_decompressor, PosListIteratorType position_filter_begin,
-                        PosListIteratorType position_filter_it)
+    PointAccessIterator(const FrameOfReferenceSegment<T>* segment, OffsetValueDecompressor offset_value_decompressor,
+                        PosListIteratorType position_filter_begin, PosListIteratorType position_filter_it)
         : AbstractPointAccessSegmentIterator<PointAccessIterator<OffsetValueDecompressor, PosListIteratorType>,
                                              SegmentPosition<T>, PosListIteratorType>{std::move(position_filter_begin),
                                                                                       std::move(position_filter_it)},
-          _block_minima{block_minima},
-          _null_values{null_values},
+          _segment{segment},
           _offset_value_decompressor{std::move(offset_value_decompressor)} {}
 
    private:
     friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
 
     SegmentPosition<T> dereference() const {
-      static constexpr auto block_size = FrameOfReferenceSegment<T>::block_size;
-
       const auto& chunk_offsets = this->chunk_offsets();
       const auto current_offset = chunk_offsets.offset_in_referenced_chunk;
 
-      const auto is_null = *_null_values ? (**_null_values)[current_offset] : false;
-      const auto block_minimum = (*_block_minima)[current_offset / block_size];
-      const auto offset_value = _offset_value_decompressor.get(current_offset);
-      const auto value = static_cast<T>(offset_value) + block_minimum;
+      const auto& null_values = _segment->null_values();
+      const auto is_null = null_values ? (*null_values)[current_offset] : false;
+      const auto value = _decode(*_segment, _offset_value_decompressor, current_offset,
+                                 _find_exception_index(*_segment, current_offset));
 
       return SegmentPosition<T>{value, is_null, chunk_offsets.offset_in_poslist};
     }
 
    private:
-    const pmr_vector<T>* _block_minima;
-    const std::optional<pmr_vector<bool>>* _null_values;
+    const FrameOfReferenceSegment<T>* _segment;
     mutable OffsetValueDecompressor _offset_value_decompressor;
   };
 };
@@ -0,0 +1,117 @@
+#include "fsst_segment.hpp"
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/vector_compression/base_compressed_vector.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+template <typename T>
+FSSTSegment<T>::FSSTSegment(FSSTSymbolTable symbol_table, pmr_vector<char> compressed_values,
+                            std::unique_ptr<const BaseCompressedVector> offsets,
+                            std::optional<pmr_vector<bool>> null_values)
+    : AbstractEncodedSegment{data_type_from_type<T>()},
+      _symbol_table{std::move(symbol_table)},
+      _compressed_values{std::move(compressed_values)},
+      _offsets{std::move(offsets)},
+      _null_values{std::move(null_values)},
+      _decompressor{_offsets->create_base_decompressor()} {
+  Assert(_offsets->size() > 0, "FSSTSegment expects size() + 1 offsets");
+}
+
+template <typename T>
+const FSSTSymbolTable& FSSTSegment<T>::symbol_table() const {
+  return _symbol_table;
+}
+
+template <typename T>
+const pmr_vector<char>& FSSTSegment<T>::compressed_values() const {
+  return _compressed_values;
+}
+
+template <typename T>
+const BaseCompressedVector& FSSTSegment<T>::offsets() const {
+  return *_offsets;
+}
+
+template <typename T>
+const std::optional<pmr_vector<bool>>& FSSTSegment<T>::null_values() const {
+  return _null_values;
+}
+
+template <typename T>
+AllTypeVariant FSSTSegment<T>::operator[](const ChunkOffset chunk_offset) const {
+  PerformanceWarning("operator[] used");
+  DebugAssert(chunk_offset < size(), "Passed chunk offset must be valid.");
+
+  const auto typed_value = get_typed_value(chunk_offset);
+  if (!typed_value) {
+    return NULL_VALUE;
+  }
+  return *typed_value;
+}
+
+template <typename T>
+std::vector<T> FSSTSegment<T>::decompress() const {
+  const auto segment_size = size();
+  auto values = std::vector<T>(segment_size);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+    values[chunk_offset] = _symbol_table.decompress(compressed_value(chunk_offset));
+  }
+  return values;
+}
+
+template <typename T>
+ChunkOffset FSSTSegment<T>::size() const {
+  return static_cast<ChunkOffset>(_offsets->size() - 1);
+}
+
+template <typename T>
+std::shared_ptr<AbstractSegment> FSSTSegment<T>::copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const {
+  auto new_compressed_values = pmr_vector<char>(_compressed_values, alloc);
+  auto new_offsets = _offsets->copy_using_allocator(alloc);
+
+  std::optional<pmr_vector<bool>> new_null_values;
+  if (_null_values) {
+    new_null_values = pmr_vector<bool>(*_null_values, alloc);
+  }
+
+  auto copy = std::make_shared<FSSTSegment<T>>(_symbol_table.copy_using_allocator(alloc),
+                                               std::move(new_compressed_values), std::move(new_offsets),
+                                               std::move(new_null_values));
+  copy->access_counter = access_counter;
+  return copy;
+}
+
+template <typename T>
+size_t FSSTSegment<T>::memory_usage(const MemoryUsageCalculationMode) const {
+  // MemoryUsageCalculationMode ignored since full calculation is efficient.
+  auto segment_size = sizeof(*this) + _symbol_table.memory_usage() - sizeof(_symbol_table) +
+                      _compressed_values.capacity() + _offsets->data_size();
+
+  if (_null_values) {
+    segment_size += _null_values->capacity() / CHAR_BIT;
+  }
+
+  return segment_size;
+}
+
+template <typename T>
+EncodingType FSSTSegment<T>::encoding_type() const {
+  return EncodingType::FSST;
+}
+
+template <typename T>
+std::optional<CompressedVectorType> FSSTSegment<T>::compressed_vector_type() const {
+  return _offsets->type();
+}
+
+template class FSSTSegment<pmr_string>;
+
+}  // namespace opossum
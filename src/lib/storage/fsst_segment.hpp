@@ -0,0 +1,97 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "abstract_encoded_segment.hpp"
+#include "storage/fsst_segment/fsst_symbol_table.hpp"
+#include "storage/vector_compression/base_compressed_vector.hpp"
+#include "storage/vector_compression/base_vector_decompressor.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseCompressedVector;
+
+/**
+ * @brief Segment implementing FSST (Fast Static Symbol Table) string compression
+ *
+ * The strings of the segment are compressed with a symbol table that is built for the segment (see FSSTSymbolTable).
+ * The codes of all strings are stored back to back in compressed_values. The codes of the string at chunk_offset are
+ * [offsets[chunk_offset], offsets[chunk_offset + 1]), i.e., offsets holds size() + 1 entries. The offsets are
+ * compressed using vector compression.
+ *
+ * Unlike for LZ4, each string can be decompressed individually. Furthermore, equality and prefix comparisons can be
+ * evaluated on the codes without decompressing the strings (see compressed_value() and FSSTSymbolTable).
+ *
+ * Null values are stored in a separate vector, which is only present if the segment contains null values. The codes
+ * of null values are empty.
+ */
+template <typename T>
+class FSSTSegment : public AbstractEncodedSegment {
+ public:
+  explicit FSSTSegment(FSSTSymbolTable symbol_table, pmr_vector<char> compressed_values,
+                       std::unique_ptr<const BaseCompressedVector> offsets,
+                       std::optional<pmr_vector<bool>> null_values);
+
+  const FSSTSymbolTable& symbol_table() const;
+  const pmr_vector<char>& compressed_values() const;
+  const BaseCompressedVector& offsets() const;
+  const std::optional<pmr_vector<bool>>& null_values() const;
+
+  // Returns the codes of the value at chunk_offset, which are empty for null values
+  std::string_view compressed_value(const ChunkOffset chunk_offset) const {
+    const auto begin = _decompressor->get(chunk_offset);
+    const auto end = _decompressor->get(chunk_offset + 1);
+    return {_compressed_values.data() + begin, end - begin};
+  }
+
+  /**
+   * @defgroup AbstractSegment interface
+   * @{
+   */
+
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
+
+  std::optional<T> get_typed_value(const ChunkOffset chunk_offset) const {
+    // performance critical - not in cpp to help with inlining
+    if (_null_values && (*_null_values)[chunk_offset]) {
+      return std::nullopt;
+    }
+    return _symbol_table.decompress(compressed_value(chunk_offset));
+  }
+
+  // Decompresses all values of the segment. Null values are returned as empty strings.
+  std::vector<T> decompress() const;
+
+  ChunkOffset size() const final;
+
+  std::shared_ptr<AbstractSegment> copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const final;
+
+  size_t memory_usage(const MemoryUsageCalculationMode mode) const final;
+
+  /**@}*/
+
+  /**
+   * @defgroup AbstractEncodedSegment interface
+   * @{
+   */
+
+  EncodingType encoding_type() const final;
+  std::optional<CompressedVectorType> compressed_vector_type() const final;
+
+  /**@}*/
+
+ private:
+  const FSSTSymbolTable _symbol_table;
+  const pmr_vector<char> _compressed_values;
+  const std::unique_ptr<const BaseCompressedVector> _offsets;
+  const std::optional<pmr_vector<bool>> _null_values;
+  std::unique_ptr<BaseVectorDecompressor> _decompressor;
+};
+
+extern template class FSSTSegment<pmr_string>;
+
+}  // namespace opossum
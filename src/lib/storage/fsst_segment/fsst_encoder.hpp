@@ -0,0 +1,84 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "storage/base_segment_encoder.hpp"
+
+#include "storage/fsst_segment.hpp"
+#include "storage/fsst_segment/fsst_symbol_table.hpp"
+#include "storage/segment_encoding_exception.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/value_segment/value_segment_iterable.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "utils/enum_constant.hpp"
+
+namespace opossum {
+
+/**
+ * Encodes a string segment with FSST. First, a symbol table is built from a sample of the segment's strings. Then,
+ * all strings are compressed with that table. See FSSTSegment and FSSTSymbolTable for details.
+ */
+class FSSTEncoder : public SegmentEncoder<FSSTEncoder> {
+ public:
+  static constexpr auto _encoding_type = enum_c<EncodingType, EncodingType::FSST>;
+  static constexpr auto _uses_vector_compression = true;  // see base_segment_encoder.hpp for details
+
+  template <typename T>
+  std::shared_ptr<AbstractEncodedSegment> _on_encode(const AnySegmentIterable<T> segment_iterable,
+                                                     const PolymorphicAllocator<T>& allocator) {
+    // The symbol table has to be known before the first string can be compressed, so the values are materialized
+    auto values = std::vector<T>{};
+    auto null_values = pmr_vector<bool>{allocator};
+    auto segment_contains_null_values = false;
+
+    segment_iterable.with_iterators([&](auto it, const auto end) {
+      const auto segment_size = static_cast<size_t>(std::distance(it, end));
+      values.reserve(segment_size);
+      null_values.reserve(segment_size);
+
+      for (; it != end; ++it) {
+        const auto segment_value = *it;
+        const auto value_is_null = segment_value.is_null();
+        values.emplace_back(value_is_null ? T{} : segment_value.value());
+        null_values.push_back(value_is_null);
+        segment_contains_null_values |= value_is_null;
+      }
+    });
+
+    // Null values are represented by empty strings and thus do not influence the symbol table
+    const auto strings = std::vector<std::string_view>(values.cbegin(), values.cend());
+    auto symbol_table = FSSTSymbolTable::build(strings).copy_using_allocator(allocator);
+
+    auto compressed_values = pmr_vector<char>{allocator};
+    auto offsets = pmr_vector<uint32_t>{allocator};
+    offsets.reserve(strings.size() + 1);
+    offsets.emplace_back(0);
+
+    for (const auto& string : strings) {
+      symbol_table.compress(string, compressed_values);
+      if (compressed_values.size() > std::numeric_limits<uint32_t>::max()) {
+        throw SegmentEncodingException("Compressed values of FSSTSegment must not exceed 4 GB.");
+      }
+      offsets.emplace_back(static_cast<uint32_t>(compressed_values.size()));
+    }
+
+    // Growing the vector by emplace_back leaves unused capacity - hand that memory back to the system
+    compressed_values.shrink_to_fit();
+
+    auto compressed_offsets = compress_vector(offsets, vector_compression_type(), allocator, {offsets.back()});
+
+    if (segment_contains_null_values) {
+      return std::make_shared<FSSTSegment<T>>(std::move(symbol_table), std::move(compressed_values),
+                                              std::move(compressed_offsets), std::move(null_values));
+    }
+    return std::make_shared<FSSTSegment<T>>(std::move(symbol_table), std::move(compressed_values),
+                                            std::move(compressed_offsets), std::nullopt);
+  }
+};
+
+}  // namespace opossum
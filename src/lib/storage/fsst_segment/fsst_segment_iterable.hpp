@@ -0,0 +1,154 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "storage/fsst_segment.hpp"
+#include "storage/segment_iterables.hpp"
+
+namespace opossum {
+
+/**
+ * Sequential iteration decompresses the segment as a whole, point access decompresses only the requested strings.
+ * Both store the decompressed strings in a vector over which the iterators run.
+ */
+template <typename T>
+class FSSTSegmentIterable : public PointAccessibleSegmentIterable<FSSTSegmentIterable<T>> {
+ public:
+  using ValueType = T;
+
+  explicit FSSTSegmentIterable(const FSSTSegment<T>& segment) : _segment{segment} {}
+
+  template <typename Functor>
+  void _on_with_iterators(const Functor& functor) const {
+    using ValueIterator = typename std::vector<T>::const_iterator;
+
+    const auto decompressed_segment = _segment.decompress();
+    _segment.access_counter[SegmentAccessCounter::AccessType::Sequential] += decompressed_segment.size();
+
+    auto null_value_it = std::optional<NullValueIterator>{};
+    if (_segment.null_values()) {
+      null_value_it = _segment.null_values()->cbegin();
+    }
+
+    auto begin = Iterator<ValueIterator>{decompressed_segment.cbegin(), null_value_it, ChunkOffset{0u}};
+    auto end = Iterator<ValueIterator>{decompressed_segment.cend(), null_value_it,
+                                       static_cast<ChunkOffset>(decompressed_segment.size())};
+    functor(begin, end);
+  }
+
+  template <typename Functor, typename PosListType>
+  void _on_with_iterators(const std::shared_ptr<PosListType>& position_filter, const Functor& functor) const {
+    const auto position_filter_size = position_filter->size();
+    _segment.access_counter[SegmentAccessCounter::access_type(*position_filter)] += position_filter_size;
+
+    // The first value in that vector (index 0) is the value for the chunk offset at index 0 in the position list
+    auto decompressed_filtered_segment = std::vector<ValueType>(position_filter_size);
+    for (auto index = size_t{0u}; index < position_filter_size; ++index) {
+      const auto chunk_offset = (*position_filter)[index].chunk_offset;
+      const auto codes = _segment.compressed_value(chunk_offset);
+      decompressed_filtered_segment[index] = _segment.symbol_table().decompress(codes);
+    }
+
+    auto null_value_it = std::optional<NullValueIterator>{};
+    if (_segment.null_values()) {
+      null_value_it = _segment.null_values()->cbegin();
+    }
+
+    using PosListIteratorType = decltype(position_filter->cbegin());
+    auto begin = PointAccessIterator<PosListIteratorType>{decompressed_filtered_segment.cbegin(), null_value_it,
+                                                          position_filter->cbegin(), position_filter->cbegin()};
+    auto end = PointAccessIterator<PosListIteratorType>{decompressed_filtered_segment.cbegin(), null_value_it,
+                                                        position_filter->cbegin(), position_filter->cend()};
+    functor(begin, end);
+  }
+
+  size_t _on_size() const { return _segment.size(); }
+
+ private:
+  using NullValueIterator = typename pmr_vector<bool>::const_iterator;
+
+  const FSSTSegment<T>& _segment;
+
+ private:
+  template <typename ValueIterator>
+  class Iterator : public AbstractSegmentIterator<Iterator<ValueIterator>, SegmentPosition<T>> {
+   public:
+    using ValueType = T;
+    using IterableType = FSSTSegmentIterable<T>;
+
+   public:
+    // Begin and End Iterator
+    explicit Iterator(ValueIterator data_it, std::optional<NullValueIterator> null_value_it, ChunkOffset chunk_offset)
+        : _chunk_offset{chunk_offset}, _data_it{std::move(data_it)}, _null_value_it{std::move(null_value_it)} {}
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    void increment() {
+      ++_chunk_offset;
+      ++_data_it;
+    }
+
+    void decrement() {
+      --_chunk_offset;
+      --_data_it;
+    }
+
+    void advance(std::ptrdiff_t n) {
+      _chunk_offset += n;
+      _data_it += n;
+    }
+
+    bool equal(const Iterator& other) const { return _data_it == other._data_it; }
+
+    std::ptrdiff_t distance_to(const Iterator& other) const {
+      return std::ptrdiff_t{other._chunk_offset} - std::ptrdiff_t{_chunk_offset};
+    }
+
+    SegmentPosition<T> dereference() const {
+      const auto is_null = _null_value_it && *(*_null_value_it + _chunk_offset);
+      return SegmentPosition<T>{*_data_it, is_null, _chunk_offset};
+    }
+
+   private:
+    ChunkOffset _chunk_offset;
+    ValueIterator _data_it;
+    std::optional<NullValueIterator> _null_value_it;
+  };
+
+  template <typename PosListIteratorType>
+  class PointAccessIterator : public AbstractPointAccessSegmentIterator<PointAccessIterator<PosListIteratorType>,
+                                                                        SegmentPosition<T>, PosListIteratorType> {
+   public:
+    using ValueType = T;
+    using IterableType = FSSTSegmentIterable<T>;
+    using DataIteratorType = typename std::vector<T>::const_iterator;
+
+    // Begin Iterator
+    PointAccessIterator(DataIteratorType data_it, std::optional<NullValueIterator> null_value_it,
+                        PosListIteratorType position_filter_begin, PosListIteratorType position_filter_it)
+        : AbstractPointAccessSegmentIterator<PointAccessIterator<PosListIteratorType>, SegmentPosition<T>,
+                                             PosListIteratorType>{std::move(position_filter_begin),
+                                                                  std::move(position_filter_it)},
+          _data_it{std::move(data_it)},
+          _null_value_it{std::move(null_value_it)} {}
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    SegmentPosition<T> dereference() const {
+      const auto& chunk_offsets = this->chunk_offsets();
+      const auto& value = *(_data_it + chunk_offsets.offset_in_poslist);
+      const auto is_null = _null_value_it && *(*_null_value_it + chunk_offsets.offset_in_referenced_chunk);
+      return SegmentPosition<T>{value, is_null, chunk_offsets.offset_in_poslist};
+    }
+
+   private:
+    DataIteratorType _data_it;
+    std::optional<NullValueIterator> _null_value_it;
+  };
+};
+
+}  // namespace opossum
@@ -0,0 +1,177 @@
+#include "fsst_symbol_table.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace {
+
+// Number of times the symbol table is refined by compressing the sample and counting the (combined) symbols
+constexpr auto GENERATION_COUNT = 5;
+
+}  // namespace
+
+namespace opossum {
+
+FSSTSymbolTable::FSSTSymbolTable(pmr_vector<Symbol>&& symbols, pmr_vector<uint8_t>&& symbol_lengths)
+    : _symbols{std::move(symbols)}, _symbol_lengths{std::move(symbol_lengths)} {
+  Assert(_symbols.size() == _symbol_lengths.size(), "Expected one length per symbol");
+  Assert(_symbols.size() <= MAX_SYMBOL_COUNT, "Too many symbols");
+
+  auto code = size_t{0};
+  for (auto byte = size_t{0}; byte < 256; ++byte) {
+    _first_code_by_byte[byte] = static_cast<uint8_t>(code);
+    while (code < _symbols.size() && static_cast<uint8_t>(_symbols[code][0]) == byte) {
+      Assert(_symbol_lengths[code] > 0 && _symbol_lengths[code] <= sizeof(Symbol), "Invalid symbol length");
+      DebugAssert(code == _first_code_by_byte[byte] || _symbol_lengths[code - 1] >= _symbol_lengths[code],
+                  "Symbols with the same first byte are not sorted by descending length");
+      ++code;
+    }
+  }
+  _first_code_by_byte[256] = static_cast<uint8_t>(code);
+  Assert(code == _symbols.size(), "Symbols are not sorted by their first byte");
+}
+
+FSSTSymbolTable FSSTSymbolTable::build(const std::vector<std::string_view>& strings) {
+  // Sample every n-th string so that the sample is spread over the entire input
+  auto total_size = size_t{0};
+  for (const auto& string : strings) {
+    total_size += string.size();
+  }
+  const auto stride = std::max(size_t{1}, (total_size + SAMPLE_SIZE - 1) / SAMPLE_SIZE);
+
+  auto sample = std::vector<std::string_view>{};
+  sample.reserve(strings.size() / stride + 1);
+  for (auto string_idx = size_t{0}; string_idx < strings.size(); string_idx += stride) {
+    sample.emplace_back(strings[string_idx]);
+  }
+
+  auto symbol_table = FSSTSymbolTable{};
+  for (auto generation = 0; generation < GENERATION_COUNT; ++generation) {
+    // Compress the sample with the current symbol table. Count how many bytes each symbol (or escaped byte) and each
+    // concatenation of two consecutive symbols would cover. The latter are the candidates for longer symbols.
+    auto gains = std::unordered_map<std::string_view, size_t>{};
+    for (const auto& string : sample) {
+      auto previous_length = size_t{0};
+      auto position = size_t{0};
+      while (position < string.size()) {
+        const auto length = symbol_table._longest_match(string, position).second;
+        gains[string.substr(position, length)] += length;
+
+        if (previous_length > 0 && previous_length + length <= sizeof(Symbol)) {
+          gains[string.substr(position - previous_length, previous_length + length)] += previous_length + length;
+        }
+
+        previous_length = length;
+        position += length;
+      }
+    }
+
+    auto candidates = std::vector<std::pair<std::string_view, size_t>>{gains.begin(), gains.end()};
+    const auto candidate_count = std::min(candidates.size(), MAX_SYMBOL_COUNT);
+    std::partial_sort(candidates.begin(), candidates.begin() + candidate_count, candidates.end(),
+                      [](const auto& lhs, const auto& rhs) {
+                        return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first);
+                      });
+    candidates.resize(candidate_count);
+
+    // Sort the symbols by their first byte and by descending length, see class comment
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+      // The lengths are swapped to sort them in descending order
+      return std::tuple{static_cast<uint8_t>(lhs.first[0]), rhs.first.size(), lhs.first} <
+             std::tuple{static_cast<uint8_t>(rhs.first[0]), lhs.first.size(), rhs.first};
+    });
+
+    auto symbols = pmr_vector<Symbol>(candidate_count);
+    auto symbol_lengths = pmr_vector<uint8_t>(candidate_count);
+    for (auto code = size_t{0}; code < candidate_count; ++code) {
+      const auto& symbol = candidates[code].first;
+      std::memcpy(symbols[code].data(), symbol.data(), symbol.size());
+      symbol_lengths[code] = static_cast<uint8_t>(symbol.size());
+    }
+
+    symbol_table = FSSTSymbolTable{std::move(symbols), std::move(symbol_lengths)};
+  }
+
+  return symbol_table;
+}
+
+const pmr_vector<FSSTSymbolTable::Symbol>& FSSTSymbolTable::symbols() const { return _symbols; }
+
+const pmr_vector<uint8_t>& FSSTSymbolTable::symbol_lengths() const { return _symbol_lengths; }
+
+void FSSTSymbolTable::compress(std::string_view string, pmr_vector<char>& compressed_values) const {
+  auto position = size_t{0};
+  while (position < string.size()) {
+    const auto [code, length] = _longest_match(string, position);
+    compressed_values.emplace_back(static_cast<char>(code));
+    if (code == ESCAPE_CODE) {
+      compressed_values.emplace_back(string[position]);
+    }
+    position += length;
+  }
+}
+
+pmr_string FSSTSymbolTable::decompress(std::string_view codes) const {
+  auto string = pmr_string{};
+  for (auto code_idx = size_t{0}; code_idx < codes.size(); ++code_idx) {
+    const auto code = static_cast<uint8_t>(codes[code_idx]);
+    if (code == ESCAPE_CODE) {
+      ++code_idx;
+      string.push_back(codes[code_idx]);
+    } else {
+      string.append(_symbols[code].data(), _symbol_lengths[code]);
+    }
+  }
+  return string;
+}
+
+bool FSSTSymbolTable::starts_with(std::string_view codes, std::string_view prefix) const {
+  auto position = size_t{0};
+  for (auto code_idx = size_t{0}; code_idx < codes.size() && position < prefix.size(); ++code_idx) {
+    const auto code = static_cast<uint8_t>(codes[code_idx]);
+    if (code == ESCAPE_CODE) {
+      ++code_idx;
+      if (prefix[position] != codes[code_idx]) {
+        return false;
+      }
+      ++position;
+    } else {
+      // The last symbol may extend beyond the prefix
+      const auto length = std::min(size_t{_symbol_lengths[code]}, prefix.size() - position);
+      if (std::memcmp(_symbols[code].data(), prefix.data() + position, length) != 0) {
+        return false;
+      }
+      position += length;
+    }
+  }
+  return position == prefix.size();
+}
+
+FSSTSymbolTable FSSTSymbolTable::copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const {
+  return FSSTSymbolTable{pmr_vector<Symbol>(_symbols, alloc), pmr_vector<uint8_t>(_symbol_lengths, alloc)};
+}
+
+size_t FSSTSymbolTable::memory_usage() const {
+  return sizeof(*this) + _symbols.capacity() * sizeof(Symbol) + _symbol_lengths.capacity();
+}
+
+std::pair<uint8_t, size_t> FSSTSymbolTable::_longest_match(std::string_view string, size_t position) const {
+  const auto remaining_length = string.size() - position;
+  const auto first_byte = static_cast<uint8_t>(string[position]);
+  for (auto code = size_t{_first_code_by_byte[first_byte]}; code < _first_code_by_byte[first_byte + 1]; ++code) {
+    const auto length = size_t{_symbol_lengths[code]};
+    if (length <= remaining_length && std::memcmp(_symbols[code].data(), string.data() + position, length) == 0) {
+      return {static_cast<uint8_t>(code), length};
+    }
+  }
+  return {ESCAPE_CODE, 1};
+}
+
+}  // namespace opossum
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Symbol table of the Fast Static Symbol Table (FSST) compression scheme (Boncz et al., VLDB 2020).
+ *
+ * A symbol is a sequence of one to eight bytes. Each of the (up to 255) symbols is represented by a one-byte code.
+ * Strings are compressed by greedily replacing the longest symbol matching at the current position by its code. Bytes
+ * not covered by any symbol are written as ESCAPE_CODE followed by the byte itself.
+ *
+ * As the compression is deterministic, two strings are equal iff their compressed codes are equal. This allows
+ * equality predicates to be evaluated without decompressing the stored values.
+ *
+ * The symbols are stored sorted by their first byte and, within the same first byte, by descending length. Thus, the
+ * candidates for a position form a contiguous range, of which the first matching symbol is the longest.
+ */
+class FSSTSymbolTable {
+ public:
+  using Symbol = std::array<char, 8>;
+
+  static constexpr auto MAX_SYMBOL_COUNT = size_t{255};
+  static constexpr auto ESCAPE_CODE = uint8_t{255};
+
+  // Number of bytes that are sampled from the input strings to build the symbol table
+  static constexpr auto SAMPLE_SIZE = size_t{16384};
+
+  FSSTSymbolTable() = default;
+
+  // Symbols and their lengths have to be sorted as described above
+  FSSTSymbolTable(pmr_vector<Symbol>&& symbols, pmr_vector<uint8_t>&& symbol_lengths);
+
+  // Builds a symbol table for the given strings, of which up to SAMPLE_SIZE bytes are sampled
+  static FSSTSymbolTable build(const std::vector<std::string_view>& strings);
+
+  const pmr_vector<Symbol>& symbols() const;
+  const pmr_vector<uint8_t>& symbol_lengths() const;
+
+  // Appends the codes of the compressed string to compressed_values
+  void compress(std::string_view string, pmr_vector<char>& compressed_values) const;
+
+  pmr_string decompress(std::string_view codes) const;
+
+  // Checks whether the compressed string starts with prefix without decompressing it as a whole
+  bool starts_with(std::string_view codes, std::string_view prefix) const;
+
+  FSSTSymbolTable copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const;
+
+  size_t memory_usage() const;
+
+ private:
+  // Returns the code and the length of the longest symbol at the position, or ESCAPE_CODE and 1 if there is none
+  std::pair<uint8_t, size_t> _longest_match(std::string_view string, size_t position) const;
+
+  pmr_vector<Symbol> _symbols;
+  pmr_vector<uint8_t> _symbol_lengths;
+
+  // The codes of the symbols starting with byte b are [_first_code_by_byte[b], _first_code_by_byte[b + 1])
+  std::array<uint8_t, 257> _first_code_by_byte{};
+};
+
+}  // namespace opossum
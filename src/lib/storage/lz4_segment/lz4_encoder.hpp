@@ -11,6 +11,7 @@
 
 #include "storage/base_segment_encoder.hpp"
 #include "storage/lz4_segment.hpp"
+#include "storage/segment_encoding_exception.hpp"
 #include "storage/value_segment.hpp"
 #include "storage/value_segment/value_segment_iterable.hpp"
 #include "storage/vector_compression/vector_compression.hpp"
@@ -195,8 +196,9 @@ class LZ4Encoder : public SegmentEncoder<LZ4Encoder> {
           const auto value = segment_element.value();
           const auto string_length = value.size();
           values.insert(values.cend(), value.begin(), value.end());
-          Assert(string_length <= std::numeric_limits<uint32_t>::max(),
-                 "The size of string row value exceeds the maximum of uint32 in LZ4 encoding.");
+          if (string_length > std::numeric_limits<uint32_t>::max()) {
+            throw SegmentEncodingException("The size of a string value exceeds the maximum of uint32 in LZ4 encoding.");
+          }
           offset += static_cast<uint32_t>(string_length);
           sample_size = string_length;
         }
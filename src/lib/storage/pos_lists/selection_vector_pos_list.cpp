@@ -0,0 +1,34 @@
+#include "selection_vector_pos_list.hpp"
+
+namespace opossum {
+
+bool SelectionVectorPosList::references_single_chunk() const { return true; }
+
+ChunkID SelectionVectorPosList::common_chunk_id() const { return _common_chunk_id; }
+
+const pmr_vector<ChunkOffset>& SelectionVectorPosList::chunk_offsets() const { return _chunk_offsets; }
+
+bool SelectionVectorPosList::empty() const { return _chunk_offsets.empty(); }
+
+size_t SelectionVectorPosList::size() const { return _chunk_offsets.size(); }
+
+size_t SelectionVectorPosList::memory_usage(const MemoryUsageCalculationMode) const {
+  // Ignoring MemoryUsageCalculationMode because accurate calculation is efficient.
+  return size() * sizeof(ChunkOffset);
+}
+
+AbstractPosList::PosListIterator<SelectionVectorPosList, RowID> SelectionVectorPosList::begin() const {
+  return PosListIterator<SelectionVectorPosList, RowID>(this, ChunkOffset{0});
+}
+
+AbstractPosList::PosListIterator<SelectionVectorPosList, RowID> SelectionVectorPosList::end() const {
+  return PosListIterator<SelectionVectorPosList, RowID>(this, static_cast<ChunkOffset>(size()));
+}
+
+AbstractPosList::PosListIterator<SelectionVectorPosList, RowID> SelectionVectorPosList::cbegin() const {
+  return begin();
+}
+
+AbstractPosList::PosListIterator<SelectionVectorPosList, RowID> SelectionVectorPosList::cend() const { return end(); }
+
+}  // namespace opossum
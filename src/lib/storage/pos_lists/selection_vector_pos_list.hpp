@@ -0,0 +1,43 @@
+#pragma once
+
+#include <utility>
+
+#include "abstract_pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// The SelectionVectorPosList references rows of a single chunk. As all entries share the ChunkID, it only stores their
+// ChunkOffsets, so it requires half the memory of a RowIDPosList. It is used by operators that filter the rows of a
+// chunk, i.e., the TableScan and the Validate, if not all rows of the chunk match (see EntireChunkPosList). Like
+// other PosLists that reference a single chunk, it cannot contain NULLs.
+class SelectionVectorPosList : public AbstractPosList {
+ public:
+  SelectionVectorPosList(const ChunkID common_chunk_id, pmr_vector<ChunkOffset>&& chunk_offsets)
+      : _common_chunk_id(common_chunk_id), _chunk_offsets(std::move(chunk_offsets)) {
+    DebugAssert(_common_chunk_id != INVALID_CHUNK_ID, "Cannot create SelectionVectorPosList for INVALID_CHUNK_ID");
+  }
+
+  bool references_single_chunk() const final;
+  ChunkID common_chunk_id() const final;
+
+  // Implemented in hpp for performance reasons (to allow inlining)
+  RowID operator[](const size_t index) const final { return RowID{_common_chunk_id, _chunk_offsets[index]}; }
+
+  const pmr_vector<ChunkOffset>& chunk_offsets() const;
+
+  bool empty() const final;
+  size_t size() const final;
+  size_t memory_usage(const MemoryUsageCalculationMode) const final;
+
+  PosListIterator<SelectionVectorPosList, RowID> begin() const;
+  PosListIterator<SelectionVectorPosList, RowID> end() const;
+  PosListIterator<SelectionVectorPosList, RowID> cbegin() const;
+  PosListIterator<SelectionVectorPosList, RowID> cend() const;
+
+ private:
+  const ChunkID _common_chunk_id;
+  const pmr_vector<ChunkOffset> _chunk_offsets;
+};
+
+}  // namespace opossum
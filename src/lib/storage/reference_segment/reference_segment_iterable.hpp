@@ -67,7 +67,7 @@ class ReferenceSegmentIterable : public SegmentIterable<ReferenceSegmentIterable
 #endif
 
 #ifdef HYRISE_ERASE_FRAMEOFREFERENCE
-          if constexpr (std::is_same_v<T, int32_t>) {
+          if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
             if constexpr (std::is_same_v<SegmentType, FrameOfReferenceSegment<T>>) return;
           }
 #endif
@@ -75,6 +75,17 @@ class ReferenceSegmentIterable : public SegmentIterable<ReferenceSegmentIterable
           // Always erase LZ4Segment accessors
           if constexpr (std::is_same_v<SegmentType, LZ4Segment<T>>) return;
 
+          // Always erase FSSTSegment accessors
+          if constexpr (std::is_same_v<SegmentType, FSSTSegment<T>>) return;
+
+          // Always erase DeltaSegment and ALPSegment accessors
+          if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+            if constexpr (std::is_same_v<SegmentType, DeltaSegment<T>>) return;
+          }
+          if constexpr (std::is_floating_point_v<T>) {
+            if constexpr (std::is_same_v<SegmentType, ALPSegment<T>>) return;
+          }
+
           if constexpr (!std::is_same_v<SegmentType, ReferenceSegment>) {
             const auto segment_iterable = create_iterable_from_segment<T>(typed_segment);
             segment_iterable.with_iterators(position_filter, functor);
@@ -8,9 +8,12 @@
 #include <boost/hana/value.hpp>
 
 // Include your encoded segment file here!
+#include "storage/alp_segment.hpp"
+#include "storage/delta_segment.hpp"
 #include "storage/dictionary_segment.hpp"
 #include "storage/fixed_string_dictionary_segment.hpp"
 #include "storage/frame_of_reference_segment.hpp"
+#include "storage/fsst_segment.hpp"
 #include "storage/lz4_segment.hpp"
 #include "storage/run_length_segment.hpp"
 
@@ -34,7 +37,10 @@ constexpr auto encoded_segment_for_type = hana::make_map(
     hana::make_pair(enum_c<EncodingType, EncodingType::FixedStringDictionary>,
                     template_c<FixedStringDictionarySegment>),
     hana::make_pair(enum_c<EncodingType, EncodingType::FrameOfReference>, template_c<FrameOfReferenceSegment>),
-    hana::make_pair(enum_c<EncodingType, EncodingType::LZ4>, template_c<LZ4Segment>));
+    hana::make_pair(enum_c<EncodingType, EncodingType::LZ4>, template_c<LZ4Segment>),
+    hana::make_pair(enum_c<EncodingType, EncodingType::FSST>, template_c<FSSTSegment>),
+    hana::make_pair(enum_c<EncodingType, EncodingType::Delta>, template_c<DeltaSegment>),
+    hana::make_pair(enum_c<EncodingType, EncodingType::ALP>, template_c<ALPSegment>));
 // When adding something here, please also append all_segment_encoding_specs in the BaseTest class.
 
 /**
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace opossum {
+
+/*
+ * Thrown by segment encoders if the encoding cannot represent the values of a segment (e.g., because they exceed a
+ * size limit of the encoded format). Unlike failed assertions, it does not indicate a bug, so callers that try
+ * several encodings can catch it and fall back to another encoding.
+ */
+class SegmentEncodingException : public std::runtime_error {
+ public:
+  explicit SegmentEncodingException(const std::string& what_arg) : std::runtime_error(what_arg) {}
+};
+
+}  // namespace opossum
@@ -3,8 +3,11 @@
 #include <map>
 #include <memory>
 
+#include "storage/alp_segment/alp_encoder.hpp"
+#include "storage/delta_segment/delta_encoder.hpp"
 #include "storage/dictionary_segment/dictionary_encoder.hpp"
 #include "storage/frame_of_reference_segment/frame_of_reference_encoder.hpp"
+#include "storage/fsst_segment/fsst_encoder.hpp"
 #include "storage/lz4_segment/lz4_encoder.hpp"
 #include "storage/run_length_segment/run_length_encoder.hpp"
 
@@ -25,7 +28,10 @@ const auto encoder_for_type = std::map<EncodingType, std::shared_ptr<BaseSegment
     {EncodingType::RunLength, std::make_shared<RunLengthEncoder>()},
     {EncodingType::FixedStringDictionary, std::make_shared<DictionaryEncoder<EncodingType::FixedStringDictionary>>()},
     {EncodingType::FrameOfReference, std::make_shared<FrameOfReferenceEncoder>()},
-    {EncodingType::LZ4, std::make_shared<LZ4Encoder>()}};
+    {EncodingType::LZ4, std::make_shared<LZ4Encoder>()},
+    {EncodingType::FSST, std::make_shared<FSSTEncoder>()},
+    {EncodingType::Delta, std::make_shared<DeltaEncoder>()},
+    {EncodingType::ALP, std::make_shared<ALPEncoder>()}};
 
 }  // namespace
 
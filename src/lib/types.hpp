@@ -157,10 +157,13 @@ const RowID NULL_ROW_ID = RowID{INVALID_CHUNK_ID, INVALID_CHUNK_OFFSET};  // TOD
 
 constexpr ValueID INVALID_VALUE_ID{std::numeric_limits<ValueID::base_type>::max()};
 
-// The Scheduler currently supports just these 3 priorities, subject to change.
+// The Scheduler currently supports just these 3 priorities, subject to change. Low is meant for entire queries (e.g.,
+// long-running analytical ones) and is inherited by the tasks that their operators spawn. Besides, the concurrent
+// execution of Low and Default queries is limited by the AdmissionControl, which does not hold back High ones.
 enum class SchedulePriority {
   Default = 1,  // Schedule task at the end of the queue
-  High = 0      // Schedule task at the beginning of the queue
+  High = 0,     // Schedule task at the beginning of the queue
+  Low = 2       // Schedule task after all other tasks, but do not starve it (see TaskQueue::pull)
 };
 
 enum class PredicateCondition {
@@ -0,0 +1,96 @@
+#include "chunk_rewriter.hpp"
+
+#include <algorithm>
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/validate.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+bool ChunkRewriter::rewrite_chunks(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                   const OrderRows& order_rows,
+                                   const std::shared_ptr<TransactionContext>& transaction_context,
+                                   const InsertChunkAllocation chunk_allocation) {
+  const auto table = Hyrise::get().storage_manager.get_table(table_name);
+  DebugAssert(std::is_sorted(chunk_ids.cbegin(), chunk_ids.cend()), "Expected sorted vector of ChunkIDs");
+
+  // Create a temporary referencing table that contains the given chunks only
+  auto excluded_chunk_ids = std::vector<ChunkID>{};
+  auto chunk_ids_iter = chunk_ids.cbegin();
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (chunk_ids_iter != chunk_ids.cend() && *chunk_ids_iter == chunk_id) {
+      ++chunk_ids_iter;
+      continue;
+    }
+    excluded_chunk_ids.emplace_back(chunk_id);
+  }
+
+  auto get_table = std::make_shared<GetTable>(table_name, excluded_chunk_ids, std::vector<ColumnID>());
+  get_table->set_transaction_context(transaction_context);
+  get_table->execute();
+
+  auto validate = std::make_shared<Validate>(get_table);
+  validate->set_transaction_context(transaction_context);
+  validate->never_clear_output();
+  validate->execute();
+
+  const auto rows_to_insert = order_rows ? order_rows(validate) : std::shared_ptr<AbstractOperator>{validate};
+  rows_to_insert->execute();
+
+  auto delete_op = std::make_shared<Delete>(validate);
+  delete_op->set_transaction_context(transaction_context);
+  delete_op->execute();
+
+  if (delete_op->execute_failed()) {
+    // The Delete is not run by an OperatorTask, which would otherwise roll back the failed transaction
+    transaction_context->rollback(RollbackReason::Conflict);
+    return false;
+  }
+
+  auto insert = std::make_shared<Insert>(table_name, rows_to_insert, chunk_allocation);
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+
+  transaction_context->commit();
+
+  for (const auto chunk_id : chunk_ids) {
+    table->get_chunk(chunk_id)->set_cleanup_commit_id(transaction_context->commit_id());
+  }
+  return true;
+}
+
+void ChunkRewriter::queue_physical_delete(const std::shared_ptr<Table>& table, const std::vector<ChunkID>& chunk_ids) {
+  std::lock_guard<std::mutex> lock(_physical_delete_queue_mutex);
+  for (const auto chunk_id : chunk_ids) {
+    _physical_delete_queue.emplace(table, chunk_id);
+  }
+}
+
+void ChunkRewriter::delete_chunks_physically() {
+  std::lock_guard<std::mutex> lock(_physical_delete_queue_mutex);
+
+  while (!_physical_delete_queue.empty()) {
+    const auto& [table, chunk_id] = _physical_delete_queue.front();
+    const auto chunk = table->get_chunk(chunk_id);
+    DebugAssert(chunk && chunk->get_cleanup_commit_id(), "Only logically deleted chunks can be deleted physically.");
+
+    // As the queue is ordered by cleanup commit ID, the following chunks cannot be removed either
+    const auto lowest_snapshot_commit_id = Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
+    if (lowest_snapshot_commit_id && *chunk->get_cleanup_commit_id() > *lowest_snapshot_commit_id) return;
+
+    table->remove_chunk(chunk_id);
+    _physical_delete_queue.pop();
+  }
+}
+
+void ChunkRewriter::clear_physical_delete_queue() {
+  std::lock_guard<std::mutex> lock(_physical_delete_queue_mutex);
+  _physical_delete_queue = {};
+}
+
+}  // namespace opossum
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "operators/abstract_operator.hpp"
+#include "operators/insert.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class TransactionContext;
+
+/**
+ * Reorganizes the rows of a table chunk by chunk, as done by the MvccDeletePlugin, the DeltaMergePlugin, and the
+ * ClusteringPlugin. Within a single transaction, the valid rows of the given chunks are deleted and reinserted at the
+ * end of the table, and the rewritten chunks are marked as logically deleted. As transactions that started before the
+ * rewrite might still read these chunks, they are removed physically once no active snapshot precedes their cleanup
+ * commit ID.
+ */
+class ChunkRewriter {
+ public:
+  // Receives the executed Validate operator that outputs the valid rows of the chunks and returns the operator whose
+  // output is reinserted, e.g., a Sort. Returning its input keeps the order of the rows.
+  using OrderRows = std::function<std::shared_ptr<AbstractOperator>(const std::shared_ptr<AbstractOperator>&)>;
+
+  // Rewrites the chunks (sorted by ID) and commits the transaction. Returns false if the transaction was rolled back
+  // because of a conflict, in which case the chunks are left unchanged.
+  static bool rewrite_chunks(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                             const OrderRows& order_rows,
+                             const std::shared_ptr<TransactionContext>& transaction_context,
+                             InsertChunkAllocation chunk_allocation = InsertChunkAllocation::FreshChunks);
+
+  // Chunks have to be queued in the order of their cleanup commit IDs
+  void queue_physical_delete(const std::shared_ptr<Table>& table, const std::vector<ChunkID>& chunk_ids);
+
+  // Removes the queued chunks that no active transaction can see anymore
+  void delete_chunks_physically();
+
+  void clear_physical_delete_queue();
+
+ private:
+  using TableAndChunkID = std::pair<const std::shared_ptr<Table>, ChunkID>;
+
+  std::mutex _physical_delete_queue_mutex;
+  std::queue<TableAndChunkID> _physical_delete_queue;
+};
+
+}  // namespace opossum
@@ -20,6 +20,8 @@ class MetaTableManager : public Noncopyable {
   const std::vector<std::string>& table_names() const;
 
   void add_table(const std::shared_ptr<AbstractMetaTable>& table);
+  // Used by plugins to remove their meta tables before they are unloaded
+  void remove_table(const std::string& table_name);
   bool has_table(const std::string& table_name) const;
   std::shared_ptr<AbstractMetaTable> get_table(const std::string& table_name) const;
 
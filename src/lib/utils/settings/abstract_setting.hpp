@@ -13,7 +13,8 @@ namespace opossum {
  * If a component ends its lifecycle (e.g., a plugin in unloaded) and does not deregister its settings,
  * this might lead to undefined behavior.
  *
- * Settings provide a getter/setter that returns/requires a std::string.
+ * Settings provide a getter/setter that returns/requires a std::string. The getter returns a copy, as settings might
+ * be changed concurrently (see AbstractSynchronizedSetting).
  * When the set(...) method is called, a setting can invoke a method of its owning component
  * that triggers the immediate appliance of the changed value.
  *
@@ -28,7 +29,7 @@ class AbstractSetting : public Noncopyable, public std::enable_shared_from_this<
 
   virtual const std::string& description() const = 0;
 
-  virtual const std::string& get() = 0;
+  virtual std::string get() = 0;
 
   virtual void set(const std::string& value) = 0;
 
@@ -0,0 +1,22 @@
+#include "abstract_synchronized_setting.hpp"
+
+namespace opossum {
+
+AbstractSynchronizedSetting::AbstractSynchronizedSetting(const std::string& init_name,
+                                                         const std::string& initial_value)
+    : AbstractSetting(init_name), _value(initial_value) {}
+
+std::string AbstractSynchronizedSetting::get() { return _current_value(); }
+
+void AbstractSynchronizedSetting::set(const std::string& value) {
+  _validate(value);
+  std::lock_guard<std::mutex> lock(_mutex);
+  _value = value;
+}
+
+std::string AbstractSynchronizedSetting::_current_value() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _value;
+}
+
+}  // namespace opossum
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "abstract_setting.hpp"
+
+namespace opossum {
+
+/**
+ * Base class for settings whose value is read by a component's background thread while it might be changed
+ * concurrently (e.g., via the meta_settings table). The value is stored as a string and guarded by a mutex. get()
+ * returns a copy, so that a concurrent set() cannot change the string while the caller reads it.
+ *
+ * Subclasses check new values in _validate() and parse the value returned by _current_value().
+ */
+class AbstractSynchronizedSetting : public AbstractSetting {
+ public:
+  explicit AbstractSynchronizedSetting(const std::string& init_name, const std::string& initial_value = "");
+
+  std::string get() final;
+
+  void set(const std::string& value) final;
+
+ protected:
+  // Called by set() before the value is stored. Throws (e.g., by a failing Assert) if the value is invalid.
+  virtual void _validate(const std::string& value) const = 0;
+
+  std::string _current_value() const;
+
+ private:
+  mutable std::mutex _mutex;
+  std::string _value;
+};
+
+}  // namespace opossum
@@ -0,0 +1,62 @@
+#include "spill_file.hpp"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+std::filesystem::path unique_spill_file_path() {
+  // The process ID distinguishes files of concurrently running Hyrise processes
+  static auto next_file_id = std::atomic<uint64_t>{0};
+  return std::filesystem::temp_directory_path() /
+         ("hyrise_spill_" + std::to_string(::getpid()) + "_" + std::to_string(next_file_id++));
+}
+
+}  // namespace
+
+namespace opossum {
+
+SpillFile::SpillFile() : _path{unique_spill_file_path()} {
+  _stream.open(_path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  Assert(_stream.is_open(), "Could not create spill file " + _path.string());
+}
+
+SpillFile::~SpillFile() {
+  _stream.close();
+  auto error_code = std::error_code{};
+  std::filesystem::remove(_path, error_code);
+}
+
+void SpillFile::write(const void* data, const size_t size) {
+  DebugAssert(_is_writing, "Cannot write to a spill file after finish_writing()");
+  _stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  Assert(_stream.good(), "Could not write to spill file " + _path.string());
+  _size += size;
+}
+
+void SpillFile::finish_writing() {
+  DebugAssert(_is_writing, "finish_writing() was already called");
+  _stream.flush();
+  _stream.seekg(0);
+  Assert(_stream.good(), "Could not rewind spill file " + _path.string());
+  _is_writing = false;
+}
+
+size_t SpillFile::read(void* data, const size_t size) {
+  DebugAssert(!_is_writing, "Call finish_writing() before reading from a spill file");
+  _stream.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+  Assert(_stream.good() || _stream.eof(), "Could not read from spill file " + _path.string());
+  return static_cast<size_t>(_stream.gcount());
+}
+
+size_t SpillFile::size() const { return _size; }
+
+const std::filesystem::path& SpillFile::path() const { return _path; }
+
+}  // namespace opossum
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * A temporary file to which operators write intermediate results that exceed their memory budget. The file is created
+ * in std::filesystem::temp_directory_path() and removed when the SpillFile is destroyed. Data is first appended with
+ * write() and, after finish_writing(), read back sequentially from the beginning.
+ */
+class SpillFile : public Noncopyable {
+ public:
+  SpillFile();
+  ~SpillFile();
+
+  void write(const void* data, const size_t size);
+
+  // Flushes the written data and moves to the beginning of the file for reading
+  void finish_writing();
+
+  // Reads up to size bytes and returns the number of bytes read, which is smaller than size only at the end of the file
+  size_t read(void* data, const size_t size);
+
+  // Number of bytes written to the file
+  size_t size() const;
+
+  const std::filesystem::path& path() const;
+
+ private:
+  const std::filesystem::path _path;
+  std::fstream _stream;
+  size_t _size{0};
+  bool _is_writing{true};
+};
+
+}  // namespace opossum
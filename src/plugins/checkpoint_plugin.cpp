@@ -0,0 +1,37 @@
+#include "checkpoint_plugin.hpp"
+
+#include "logging/redo_log.hpp"
+
+namespace opossum {
+
+std::string CheckpointPlugin::description() const { return "Periodic checkpoint plugin"; }
+
+void CheckpointPlugin::start() {
+  _loop_thread_checkpoint =
+      std::make_unique<PausableLoopThread>(IDLE_DELAY_CHECKPOINT, [&](size_t) { _checkpoint_loop(); });
+}
+
+void CheckpointPlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_checkpoint.reset();
+  _last_checkpoint_commit_id = std::nullopt;
+}
+
+void CheckpointPlugin::_checkpoint_loop() {
+  const auto redo_log = Hyrise::get().redo_log;
+  if (!redo_log) return;
+
+  // The checkpoint's snapshot is at least as recent as this commit ID.
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  if (_last_checkpoint_commit_id == last_commit_id) return;
+
+  redo_log->checkpoint();
+  _last_checkpoint_commit_id = last_commit_id;
+
+  Hyrise::get().log_manager.add_message(
+      "CheckpointPlugin", "Wrote checkpoint for commit ID " + std::to_string(last_commit_id), LogLevel::Info);
+}
+
+EXPORT_PLUGIN(CheckpointPlugin)
+
+}  // namespace opossum
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "gtest/gtest_prod.h"
+#include "hyrise.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace opossum {
+
+/*
+ * Periodically writes a checkpoint of all stored tables into the directory of the RedoLog (see Hyrise::redo_log).
+ * Checkpoints are taken for an MVCC snapshot, so writers are not stopped while a checkpoint is written. The chunks are
+ * written in parallel and unchanged immutable chunks are reused from the previous checkpoint (see Checkpoint). As
+ * every checkpoint allows the RedoLog to remove older log files, it bounds both the size of the log and the time it
+ * takes to recover after a restart.
+ *
+ * If no RedoLog is set or if no transaction has committed since the last checkpoint, nothing is written.
+ */
+class CheckpointPlugin : public AbstractPlugin {
+  friend class CheckpointPluginTest;
+
+ public:
+  std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  /**
+   * IDLE_DELAY_CHECKPOINT: sleep between two checkpoints
+   */
+  constexpr static std::chrono::milliseconds IDLE_DELAY_CHECKPOINT = std::chrono::milliseconds(60'000);
+
+ private:
+  void _checkpoint_loop();
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_checkpoint;
+
+  std::optional<CommitID> _last_checkpoint_commit_id;
+};
+
+}  // namespace opossum
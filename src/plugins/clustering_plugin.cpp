@@ -0,0 +1,423 @@
+#include "clustering_plugin.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+#include "concurrency/transaction_context.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_wrapper.hpp"
+#include "resolve_type.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+std::vector<std::string> split(const std::string& value, const char delimiter) {
+  auto parts = std::vector<std::string>{};
+  auto part_begin = size_t{0};
+  while (part_begin <= value.size()) {
+    const auto part_end = std::min(value.find(delimiter, part_begin), value.size());
+    parts.emplace_back(value.substr(part_begin, part_end - part_begin));
+    part_begin = part_end + 1;
+  }
+  return parts;
+}
+
+// Returns std::nullopt if the value is malformed
+std::optional<std::map<std::string, ClusteringSpec>> parse_clustering_specs(const std::string& value) {
+  auto clustering_specs = std::map<std::string, ClusteringSpec>{};
+  if (value.empty()) return clustering_specs;
+
+  for (const auto& entry : split(value, ';')) {
+    const auto parts = split(entry, ':');
+    if (parts.size() != 3 || parts[0].empty()) return std::nullopt;
+
+    auto spec = ClusteringSpec{};
+    if (parts[1] == "sorted") {
+      spec.type = ClusteringType::Sorted;
+    } else if (parts[1] == "zorder") {
+      spec.type = ClusteringType::ZOrder;
+    } else if (parts[1] == "hilbert") {
+      spec.type = ClusteringType::Hilbert;
+    } else {
+      return std::nullopt;
+    }
+
+    spec.column_names = split(parts[2], ',');
+    const auto has_empty_column_name = std::any_of(spec.column_names.cbegin(), spec.column_names.cend(),
+                                                   [](const auto& column_name) { return column_name.empty(); });
+    if (has_empty_column_name || !clustering_specs.emplace(parts[0], std::move(spec)).second) return std::nullopt;
+  }
+
+  return clustering_specs;
+}
+
+// Replaces the values of a column by their rank among the column's distinct values (NULLs first), scaled to
+// [0, 2^bits). Ranks are used instead of the values, so that every column uses the full range of the coordinates.
+std::vector<uint32_t> scaled_ranks(const Table& table, const ColumnID column_id, const uint32_t bits) {
+  const auto row_count = table.row_count();
+  auto ranks = std::vector<uint32_t>(row_count);
+
+  resolve_data_type(table.column_data_type(column_id), [&](const auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    auto values = std::vector<ColumnDataType>{};
+    auto null_values = std::vector<bool>{};
+    values.reserve(row_count);
+    null_values.reserve(row_count);
+
+    const auto chunk_count = table.chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      segment_iterate<ColumnDataType>(*table.get_chunk(chunk_id)->get_segment(column_id), [&](const auto& position) {
+        values.emplace_back(position.is_null() ? ColumnDataType{} : position.value());
+        null_values.emplace_back(position.is_null());
+      });
+    }
+
+    auto row_indices = std::vector<size_t>(row_count);
+    std::iota(row_indices.begin(), row_indices.end(), size_t{0});
+    const auto less = [&](const size_t lhs, const size_t rhs) {
+      if (null_values[rhs]) return false;
+      if (null_values[lhs]) return true;
+      return values[lhs] < values[rhs];
+    };
+    std::sort(row_indices.begin(), row_indices.end(), less);
+
+    auto dense_ranks = std::vector<uint64_t>(row_count);
+    auto rank = uint64_t{0};
+    for (auto index = size_t{0}; index < row_count; ++index) {
+      if (index > 0 && less(row_indices[index - 1], row_indices[index])) ++rank;
+      dense_ranks[row_indices[index]] = rank;
+    }
+
+    const auto distinct_count = rank + 1;
+    for (auto row_index = size_t{0}; row_index < row_count; ++row_index) {
+      ranks[row_index] = static_cast<uint32_t>((dense_ranks[row_index] << bits) / distinct_count);
+    }
+  });
+
+  return ranks;
+}
+
+}  // namespace
+
+namespace opossum {
+
+bool operator==(const ClusteringSpec& lhs, const ClusteringSpec& rhs) {
+  return lhs.type == rhs.type && lhs.column_names == rhs.column_names;
+}
+
+ClusteringSetting::ClusteringSetting() : AbstractSynchronizedSetting("ClusteringPlugin.clustering") {}
+
+const std::string& ClusteringSetting::description() const {
+  static const auto description = std::string{
+      "Semicolon-separated list of table_name:type:column_name,... with type sorted, zorder, or hilbert, the tables "
+      "are clustered by"};
+  return description;
+}
+
+std::map<std::string, ClusteringSpec> ClusteringSetting::clustering_specs() const {
+  return *parse_clustering_specs(_current_value());
+}
+
+void ClusteringSetting::_validate(const std::string& value) const {
+  Assert(parse_clustering_specs(value), "Clustering must be given as table_name:type:column_name,..., separated by "
+                                        "semicolons, with one entry per table.");
+}
+
+std::string ClusteringPlugin::description() const { return "Clustering plugin"; }
+
+void ClusteringPlugin::start() {
+  _clustering_setting = std::make_shared<ClusteringSetting>();
+  _clustering_setting->register_at_settings_manager();
+
+  _loop_thread_clustering =
+      std::make_unique<PausableLoopThread>(IDLE_DELAY_CLUSTERING, [&](size_t) { _clustering_loop(); });
+
+  _loop_thread_physical_delete = std::make_unique<PausableLoopThread>(
+      IDLE_DELAY_PHYSICAL_DELETE, [&](size_t) { _chunk_rewriter.delete_chunks_physically(); });
+}
+
+void ClusteringPlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_clustering.reset();
+  _loop_thread_physical_delete.reset();
+  _chunk_rewriter.clear_physical_delete_queue();
+  _applied_clustering_specs.clear();
+
+  _clustering_setting->unregister_at_settings_manager();
+  _clustering_setting.reset();
+}
+
+uint64_t ClusteringPlugin::z_order_key(const std::vector<uint32_t>& coordinates, const uint32_t bits_per_dimension) {
+  DebugAssert(bits_per_dimension * coordinates.size() <= 64, "Key does not fit into 64 bits");
+
+  // Interleave the bits of the coordinates, starting with the most significant ones
+  auto key = uint64_t{0};
+  for (auto bit = bits_per_dimension; bit > 0; --bit) {
+    for (const auto coordinate : coordinates) {
+      key = (key << 1) | ((coordinate >> (bit - 1)) & 1);
+    }
+  }
+  return key;
+}
+
+uint64_t ClusteringPlugin::hilbert_key(std::vector<uint32_t> coordinates, const uint32_t bits_per_dimension) {
+  DebugAssert(bits_per_dimension > 0, "Key needs at least one bit per dimension");
+
+  // Transforms the coordinates so that interleaving their bits yields the position on the Hilbert curve (see John
+  // Skilling, "Programming the Hilbert curve", AIP Conference Proceedings 707, 2004).
+  const auto dimension_count = coordinates.size();
+  if (dimension_count == 1) return coordinates.front();
+
+  const auto most_significant_bit = uint32_t{1} << (bits_per_dimension - 1);
+
+  for (auto bit = most_significant_bit; bit > 1; bit >>= 1) {
+    const auto lower_bits = bit - 1;
+    for (auto dimension = size_t{0}; dimension < dimension_count; ++dimension) {
+      if (coordinates[dimension] & bit) {
+        // Invert the lower bits of the first coordinate
+        coordinates[0] ^= lower_bits;
+      } else {
+        // Exchange the lower bits of the first and the current coordinate
+        const auto exchanged_bits = (coordinates[0] ^ coordinates[dimension]) & lower_bits;
+        coordinates[0] ^= exchanged_bits;
+        coordinates[dimension] ^= exchanged_bits;
+      }
+    }
+  }
+
+  // Gray encode
+  for (auto dimension = size_t{1}; dimension < dimension_count; ++dimension) {
+    coordinates[dimension] ^= coordinates[dimension - 1];
+  }
+  auto flipped_bits = uint32_t{0};
+  for (auto bit = most_significant_bit; bit > 1; bit >>= 1) {
+    if (coordinates[dimension_count - 1] & bit) flipped_bits ^= bit - 1;
+  }
+  for (auto& coordinate : coordinates) {
+    coordinate ^= flipped_bits;
+  }
+
+  return z_order_key(coordinates, bits_per_dimension);
+}
+
+void ClusteringPlugin::_clustering_loop() {
+  const auto clustering_specs = _clustering_setting->clustering_specs();
+
+  // Forget the tables that have been removed from the setting, so that setting their spec again reclusters them
+  for (auto applied_iter = _applied_clustering_specs.begin(); applied_iter != _applied_clustering_specs.end();) {
+    if (clustering_specs.contains(applied_iter->first)) {
+      ++applied_iter;
+    } else {
+      applied_iter = _applied_clustering_specs.erase(applied_iter);
+    }
+  }
+
+  for (const auto& [table_name, clustering_spec] : clustering_specs) {
+    const auto applied_iter = _applied_clustering_specs.find(table_name);
+    if (applied_iter != _applied_clustering_specs.end() && applied_iter->second == clustering_spec) continue;
+
+    auto& storage_manager = Hyrise::get().storage_manager;
+    if (!storage_manager.has_table(table_name)) continue;
+    const auto table = storage_manager.get_table(table_name);
+
+    // Unknown columns are reported once, the clustering is retried when the spec changes
+    auto column_ids = std::vector<ColumnID>{};
+    const auto column_names = table->column_names();
+    for (const auto& column_name : clustering_spec.column_names) {
+      const auto iter = std::find(column_names.cbegin(), column_names.cend(), column_name);
+      if (iter == column_names.cend()) break;
+      column_ids.emplace_back(static_cast<ColumnID::base_type>(std::distance(column_names.cbegin(), iter)));
+    }
+
+    _applied_clustering_specs[table_name] = clustering_spec;
+    if (column_ids.size() != clustering_spec.column_names.size()) {
+      Hyrise::get().log_manager.add_message("ClusteringPlugin", "Table " + table_name + " lacks a clustering column",
+                                            LogLevel::Warning);
+      continue;
+    }
+
+    if (table->uses_mvcc() != UseMvcc::Yes) {
+      Hyrise::get().log_manager.add_message("ClusteringPlugin", "Table " + table_name + " does not use MVCC",
+                                            LogLevel::Warning);
+      continue;
+    }
+
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    const auto clustered_chunk_ids = _cluster_table(table_name, clustering_spec.type, column_ids, transaction_context);
+    if (!clustered_chunk_ids) {
+      // Transaction conflict, try again in the next run
+      _applied_clustering_specs.erase(table_name);
+      continue;
+    }
+
+    _chunk_rewriter.queue_physical_delete(table, *clustered_chunk_ids);
+
+    std::ostringstream message;
+    message << "Clustered " << clustered_chunk_ids->size() << " chunk(s) of " << table_name;
+    Hyrise::get().log_manager.add_message("ClusteringPlugin", message.str(), LogLevel::Info);
+  }
+}
+
+std::optional<std::vector<ChunkID>> ClusteringPlugin::_cluster_table(
+    const std::string& table_name, const ClusteringType type, const std::vector<ColumnID>& column_ids,
+    const std::shared_ptr<TransactionContext>& transaction_context) {
+  Assert(!column_ids.empty(), "Expected at least one clustering column");
+  const auto table = Hyrise::get().storage_manager.get_table(table_name);
+  const auto column_count = table->column_count();
+
+  // Cluster the immutable chunks only, Inserts might still write to the mutable ones
+  auto chunk_ids = std::vector<ChunkID>{};
+  auto chunk_encoding_spec = ChunkEncodingSpec{};
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk || chunk->is_mutable() || chunk->get_cleanup_commit_id()) continue;
+
+    chunk_ids.emplace_back(chunk_id);
+    if (chunk_encoding_spec.empty()) {
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        chunk_encoding_spec.emplace_back(get_segment_encoding_spec(chunk->get_segment(column_id)));
+      }
+    }
+  }
+
+  if (chunk_ids.empty()) return chunk_ids;
+
+  // Reinsert the valid rows in the order of the clustering
+  const auto order_rows = [&](const std::shared_ptr<AbstractOperator>& validate) -> std::shared_ptr<AbstractOperator> {
+    if (type == ClusteringType::Sorted) {
+      auto sort_definitions = std::vector<SortColumnDefinition>{};
+      for (const auto column_id : column_ids) {
+        sort_definitions.emplace_back(column_id, SortMode::Ascending);
+      }
+      return std::make_shared<Sort>(validate, sort_definitions, table->target_chunk_size());
+    }
+
+    // Order the rows by their position on the curve
+    const auto validated_table = validate->get_output();
+    const auto dimension_count = static_cast<uint32_t>(column_ids.size());
+    Assert(dimension_count <= 64, "Too many clustering columns");
+    const auto bits_per_dimension = std::min(uint32_t{32}, 64 / dimension_count);
+
+    auto coordinates_per_column = std::vector<std::vector<uint32_t>>{};
+    for (const auto column_id : column_ids) {
+      coordinates_per_column.emplace_back(scaled_ranks(*validated_table, column_id, bits_per_dimension));
+    }
+
+    const auto row_count = validated_table->row_count();
+    auto keys = std::vector<uint64_t>(row_count);
+    auto coordinates = std::vector<uint32_t>(dimension_count);
+    for (auto row_index = size_t{0}; row_index < row_count; ++row_index) {
+      for (auto dimension = uint32_t{0}; dimension < dimension_count; ++dimension) {
+        coordinates[dimension] = coordinates_per_column[dimension][row_index];
+      }
+      keys[row_index] = type == ClusteringType::ZOrder ? z_order_key(coordinates, bits_per_dimension)
+                                                       : hilbert_key(coordinates, bits_per_dimension);
+    }
+
+    auto row_indices = std::vector<size_t>(row_count);
+    std::iota(row_indices.begin(), row_indices.end(), size_t{0});
+    std::stable_sort(row_indices.begin(), row_indices.end(),
+                     [&](const size_t lhs, const size_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    // All segments of a chunk of the Validate output share the same PosList and referenced table
+    auto referenced_table = std::shared_ptr<const Table>{};
+    auto row_ids = std::vector<RowID>{};
+    row_ids.reserve(row_count);
+    const auto validated_chunk_count = validated_table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < validated_chunk_count; ++chunk_id) {
+      const auto reference_segment = std::static_pointer_cast<const ReferenceSegment>(
+          validated_table->get_chunk(chunk_id)->get_segment(ColumnID{0}));
+      DebugAssert(!referenced_table || referenced_table == reference_segment->referenced_table(),
+                  "Expected all chunks to reference the same table");
+      referenced_table = reference_segment->referenced_table();
+      for (const auto& row_id : *reference_segment->pos_list()) {
+        row_ids.emplace_back(row_id);
+      }
+    }
+
+    auto clustered_table = std::make_shared<Table>(validated_table->column_definitions(), TableType::References);
+    const auto target_chunk_size = size_t{table->target_chunk_size()};
+    for (auto begin_index = size_t{0}; begin_index < row_count; begin_index += target_chunk_size) {
+      const auto end_index = std::min(begin_index + target_chunk_size, row_count);
+      auto pos_list = std::make_shared<RowIDPosList>();
+      pos_list->reserve(end_index - begin_index);
+      for (auto index = begin_index; index < end_index; ++index) {
+        pos_list->emplace_back(row_ids[row_indices[index]]);
+      }
+
+      auto segments = Segments{};
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        segments.emplace_back(std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list));
+      }
+      clustered_table->append_chunk(segments);
+    }
+
+    return std::make_shared<TableWrapper>(clustered_table);
+  };
+
+  if (!ChunkRewriter::rewrite_chunks(table_name, chunk_ids, order_rows, transaction_context)) return std::nullopt;
+
+  auto sorted_by = std::optional<SortColumnDefinition>{};
+  if (type == ClusteringType::Sorted) sorted_by = SortColumnDefinition{column_ids.front(), SortMode::Ascending};
+  _finalize_fresh_chunks(table, ChunkID{chunk_count - 1}, transaction_context->commit_id(), sorted_by,
+                         chunk_encoding_spec);
+
+  return chunk_ids;
+}
+
+size_t ClusteringPlugin::_finalize_fresh_chunks(const std::shared_ptr<Table>& table, const ChunkID first_chunk_id,
+                                                const CommitID commit_id,
+                                                const std::optional<SortColumnDefinition>& sorted_by,
+                                                const ChunkEncodingSpec& chunk_encoding_spec) {
+  auto fresh_chunks = std::vector<std::shared_ptr<Chunk>>{};
+
+  {
+    // The fresh chunks contain the rows of this transaction only. No other Insert writes to them, as the last one is
+    // either full or followed by an empty chunk. The first fresh chunk might be the previously empty last chunk. The
+    // DeltaMergePlugin finalizes chunks while holding the append mutex, too, so that a chunk is finalized only once.
+    // Chunks it has finalized already keep its encoding.
+    const auto append_lock = table->acquire_append_mutex();
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = first_chunk_id; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk || !chunk->is_mutable() || chunk->size() == 0) continue;
+
+      const auto& mvcc_data = chunk->mvcc_data();
+      const auto chunk_size = chunk->size();
+      auto is_fresh_chunk = true;
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        if (mvcc_data->get_begin_cid(chunk_offset) != commit_id) {
+          is_fresh_chunk = false;
+          break;
+        }
+      }
+      if (!is_fresh_chunk) continue;
+
+      chunk->finalize();
+      fresh_chunks.emplace_back(chunk);
+    }
+  }
+
+  const auto column_data_types = table->column_data_types();
+  for (const auto& chunk : fresh_chunks) {
+    if (sorted_by) chunk->set_individually_sorted_by(*sorted_by);
+    ChunkEncoder::encode_chunk(chunk, column_data_types, chunk_encoding_spec);
+  }
+
+  return fresh_chunks.size();
+}
+
+EXPORT_PLUGIN(ClusteringPlugin)
+
+}  // namespace opossum
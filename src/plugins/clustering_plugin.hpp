@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+#include "hyrise.hpp"
+#include "storage/chunk.hpp"
+#include "storage/encoding_type.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/chunk_rewriter.hpp"
+#include "utils/pausable_loop_thread.hpp"
+#include "utils/settings/abstract_synchronized_setting.hpp"
+
+namespace opossum {
+
+/*
+ * Sorted: rows are sorted by the columns (lexicographically), chunks are marked as sorted by the first column.
+ * ZOrder/Hilbert: rows are ordered along a space-filling curve over the columns, so that every chunk covers a compact
+ * region of the columns' value space. Hilbert curves have no jumps between distant regions, Z-order curves are
+ * cheaper to compute.
+ */
+enum class ClusteringType { Sorted, ZOrder, Hilbert };
+
+struct ClusteringSpec {
+  ClusteringType type;
+  std::vector<std::string> column_names;
+};
+
+bool operator==(const ClusteringSpec& lhs, const ClusteringSpec& rhs);
+
+/*
+ * Semicolon-separated list of `table_name:type:column_name,...` entries, where type is one of sorted, zorder, and
+ * hilbert, e.g., `lineitem:zorder:l_shipdate,l_discount;orders:sorted:o_orderdate`. As all settings, it can be changed
+ * via SQL: UPDATE meta_settings SET value = '...' WHERE name = 'ClusteringPlugin.clustering'
+ * A table is clustered whenever its entry is added or changed. To recluster a table, e.g., after loading more data,
+ * remove its entry and set it again once the plugin has run.
+ */
+class ClusteringSetting : public AbstractSynchronizedSetting {
+ public:
+  ClusteringSetting();
+
+  const std::string& description() const final;
+
+  std::map<std::string, ClusteringSpec> clustering_specs() const;
+
+ protected:
+  void _validate(const std::string& value) const final;
+};
+
+/*
+ * The ChunkPruningRule can only skip chunks whose pruning statistics exclude a predicate's values, which rarely
+ * happens if the values of a column are spread over all chunks. This plugin reorganizes the tables given in the
+ * ClusteringSetting whenever their entry is added or changed, so that range predicates on the clustering columns prune
+ * most of the chunks.
+ *
+ * In one transaction, the valid rows of all immutable chunks are deleted and reinserted into fresh chunks in the
+ * order of the clustering. Rows in mutable chunks are not clustered, as concurrent Inserts might still write to these
+ * chunks. The fresh chunks are finalized and encoded like the previous chunks of the table, which generates their
+ * pruning statistics. Like in the MvccDeletePlugin, the previous chunks are removed physically once no transaction can
+ * see them anymore.
+ *
+ * For the space-filling curves, the values of every column are replaced by their rank among the column's distinct
+ * values, so that columns of any data type and with skewed values contribute equally.
+ */
+class ClusteringPlugin : public AbstractPlugin {
+  friend class ClusteringPluginTest;
+
+ public:
+  std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  /**
+   * IDLE_DELAY_CLUSTERING: sleep after checking all tables for changed clustering specs
+   * IDLE_DELAY_PHYSICAL_DELETE: sleep after execution of physical delete
+   */
+  constexpr static std::chrono::milliseconds IDLE_DELAY_CLUSTERING = std::chrono::milliseconds(1000);
+  constexpr static std::chrono::milliseconds IDLE_DELAY_PHYSICAL_DELETE = std::chrono::milliseconds(1000);
+
+  // Returns the position of the point on the curve. The coordinates must be smaller than 2^bits_per_dimension, and
+  // bits_per_dimension * coordinates.size() must not exceed 64.
+  static uint64_t z_order_key(const std::vector<uint32_t>& coordinates, uint32_t bits_per_dimension);
+  static uint64_t hilbert_key(std::vector<uint32_t> coordinates, uint32_t bits_per_dimension);
+
+ private:
+  void _clustering_loop();
+
+  // Returns the IDs of the clustered chunks, which have been deleted logically, or std::nullopt on a conflict
+  static std::optional<std::vector<ChunkID>> _cluster_table(
+      const std::string& table_name, ClusteringType type, const std::vector<ColumnID>& column_ids,
+      const std::shared_ptr<TransactionContext>& transaction_context);
+
+  // Finalizes and encodes the chunks from first_chunk_id on whose rows have all been inserted with the commit ID.
+  // Returns the number of finalized chunks.
+  static size_t _finalize_fresh_chunks(const std::shared_ptr<Table>& table, ChunkID first_chunk_id, CommitID commit_id,
+                                       const std::optional<SortColumnDefinition>& sorted_by,
+                                       const ChunkEncodingSpec& chunk_encoding_spec);
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_clustering, _loop_thread_physical_delete;
+
+  std::shared_ptr<ClusteringSetting> _clustering_setting;
+
+  // Specs that have been applied to the tables
+  std::map<std::string, ClusteringSpec> _applied_clustering_specs;
+
+  ChunkRewriter _chunk_rewriter;
+};
+
+}  // namespace opossum
@@ -0,0 +1,242 @@
+#include "delta_merge_plugin.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+#include "operators/sort.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Splits the setting's value into (table name, column name) pairs. Returns std::nullopt if an entry is malformed.
+std::optional<std::vector<std::pair<std::string, std::string>>> parse_sort_columns(const std::string& value) {
+  auto sort_columns = std::vector<std::pair<std::string, std::string>>{};
+  if (value.empty()) return sort_columns;
+
+  auto entry_begin = size_t{0};
+  while (entry_begin <= value.size()) {
+    const auto entry_end = std::min(value.find(',', entry_begin), value.size());
+    const auto entry = value.substr(entry_begin, entry_end - entry_begin);
+    const auto separator = entry.find('.');
+    if (separator == std::string::npos || separator == 0 || separator + 1 == entry.size()) return std::nullopt;
+
+    sort_columns.emplace_back(entry.substr(0, separator), entry.substr(separator + 1));
+    entry_begin = entry_end + 1;
+  }
+
+  return sort_columns;
+}
+
+// Same order as produced by the Sort operator for SortMode::Ascending and checked by
+// Chunk::set_individually_sorted_by.
+bool is_sorted_ascending(const AbstractSegment& segment) {
+  auto is_sorted = true;
+  segment_with_iterators(segment, [&](auto begin, auto end) {
+    is_sorted = std::is_sorted(begin, end, [](const auto& left, const auto& right) {
+      if (right.is_null()) return false;
+      if (left.is_null()) return true;
+      return left.value() < right.value();
+    });
+  });
+  return is_sorted;
+}
+
+}  // namespace
+
+namespace opossum {
+
+DeltaMergeSortColumnsSetting::DeltaMergeSortColumnsSetting()
+    : AbstractSynchronizedSetting("DeltaMergePlugin.sort_columns") {}
+
+const std::string& DeltaMergeSortColumnsSetting::description() const {
+  static const auto description =
+      std::string{"Comma-separated list of table_name.column_name, the merged chunks of the tables are sorted by"};
+  return description;
+}
+
+std::optional<std::string> DeltaMergeSortColumnsSetting::sort_column_name(const std::string& table_name) const {
+  const auto sort_columns = parse_sort_columns(_current_value());
+  for (const auto& [sort_table_name, column_name] : *sort_columns) {
+    if (sort_table_name == table_name) return column_name;
+  }
+  return std::nullopt;
+}
+
+void DeltaMergeSortColumnsSetting::_validate(const std::string& value) const {
+  Assert(parse_sort_columns(value), "Sort columns must be given as table_name.column_name, separated by commas.");
+}
+
+std::string DeltaMergePlugin::description() const { return "Delta merge plugin"; }
+
+void DeltaMergePlugin::start() {
+  _sort_columns_setting = std::make_shared<DeltaMergeSortColumnsSetting>();
+  _sort_columns_setting->register_at_settings_manager();
+
+  _loop_thread_merge = std::make_unique<PausableLoopThread>(IDLE_DELAY_MERGE, [&](size_t) { _merge_loop(); });
+
+  _loop_thread_physical_delete = std::make_unique<PausableLoopThread>(
+      IDLE_DELAY_PHYSICAL_DELETE, [&](size_t) { _chunk_rewriter.delete_chunks_physically(); });
+}
+
+void DeltaMergePlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_merge.reset();
+  _loop_thread_physical_delete.reset();
+  _chunk_rewriter.clear_physical_delete_queue();
+
+  _sort_columns_setting->unregister_at_settings_manager();
+  _sort_columns_setting.reset();
+}
+
+void DeltaMergePlugin::_merge_loop() {
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    if (table->empty() || table->uses_mvcc() != UseMvcc::Yes) continue;
+
+    const auto sort_column_id = _sort_column_id(table_name, *table);
+    const auto finalized_chunk_count = _finalize_chunks(table, sort_column_id);
+
+    const auto chunk_ids = _merge_candidates(table);
+    auto merged_chunk_count = size_t{0};
+    if (!chunk_ids.empty()) {
+      auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+      if (_try_merge(table_name, chunk_ids, sort_column_id, transaction_context)) {
+        _chunk_rewriter.queue_physical_delete(table, chunk_ids);
+        merged_chunk_count = chunk_ids.size();
+      }
+    }
+
+    if (finalized_chunk_count == 0 && merged_chunk_count == 0) continue;
+
+    std::ostringstream message;
+    message << "Finalized and encoded " << finalized_chunk_count << " chunk(s), merged " << merged_chunk_count
+            << " chunk(s) of " << table_name;
+    Hyrise::get().log_manager.add_message("DeltaMergePlugin", message.str(), LogLevel::Info);
+  }
+}
+
+size_t DeltaMergePlugin::_finalize_chunks(const std::shared_ptr<Table>& table,
+                                          const std::optional<ColumnID>& sort_column_id) {
+  auto finalized_chunks = std::vector<std::shared_ptr<Chunk>>{};
+
+  {
+    // Insert allocates rows in the last chunk while holding the append mutex, so chunks that are full or followed by
+    // another chunk do not get new rows anymore.
+    const auto append_lock = table->acquire_append_mutex();
+    const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+    const auto chunk_count = table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk || !chunk->is_mutable() || chunk->size() == 0) continue;
+
+      const auto chunk_size = chunk->size();
+      if (chunk_id + 1 == chunk_count && chunk_size < table->target_chunk_size()) continue;
+
+      // The values of uncommitted Inserts might still be written. Committing Inserts set their begin_cids before
+      // their values are read by RedoLogRecord::add_insert, which expects ValueSegments. Thus, only chunks whose rows
+      // are visible (i.e., their transactions have committed completely) are finalized. Rolled back rows have a
+      // begin_cid of 0.
+      const auto& mvcc_data = chunk->mvcc_data();
+      auto has_pending_inserts = false;
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        if (mvcc_data->get_begin_cid(chunk_offset) > last_commit_id) {
+          has_pending_inserts = true;
+          break;
+        }
+      }
+      if (has_pending_inserts) continue;
+
+      chunk->finalize();
+      finalized_chunks.emplace_back(chunk);
+    }
+  }
+
+  const auto column_data_types = table->column_data_types();
+  for (const auto& chunk : finalized_chunks) {
+    if (sort_column_id && is_sorted_ascending(*chunk->get_segment(*sort_column_id))) {
+      chunk->set_individually_sorted_by(SortColumnDefinition{*sort_column_id, SortMode::Ascending});
+    }
+
+    // The EncodingAdvisorPlugin, if loaded, might choose better encodings for the segments later on
+    ChunkEncoder::encode_chunk(chunk, column_data_types);
+  }
+
+  return finalized_chunks.size();
+}
+
+std::vector<ChunkID> DeltaMergePlugin::_merge_candidates(const std::shared_ptr<Table>& table) {
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  const auto target_chunk_size = static_cast<double>(table->target_chunk_size());
+
+  auto chunk_ids = std::vector<ChunkID>{};
+  auto has_many_invalidated_rows = false;
+
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk || chunk->is_mutable() || chunk->get_cleanup_commit_id()) continue;
+
+    const auto chunk_size = chunk->size();
+    const auto invalid_row_count = chunk->invalid_row_count();
+    const auto many_invalidated_rows = MERGE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS <=
+                                       static_cast<double>(invalid_row_count) / static_cast<double>(chunk_size);
+    const auto few_valid_rows =
+        static_cast<double>(chunk_size - invalid_row_count) < MERGE_THRESHOLD_PERCENTAGE_VALID_ROWS * target_chunk_size;
+    if (!many_invalidated_rows && !few_valid_rows) continue;
+
+    // Only merge chunks that have not been modified recently, as they are likely to be modified again
+    auto highest_commit_id = CommitID{0};
+    const auto& mvcc_data = chunk->mvcc_data();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      highest_commit_id = std::max(highest_commit_id, mvcc_data->get_begin_cid(chunk_offset));
+      const auto end_commit_id = mvcc_data->get_end_cid(chunk_offset);
+      if (end_commit_id != MvccData::MAX_COMMIT_ID) {
+        highest_commit_id = std::max(highest_commit_id, end_commit_id);
+      }
+    }
+    if (highest_commit_id + MERGE_THRESHOLD_LAST_COMMIT > last_commit_id) continue;
+
+    chunk_ids.emplace_back(chunk_id);
+    has_many_invalidated_rows |= many_invalidated_rows;
+  }
+
+  // Merging a single chunk with few valid rows would only move it to the end of the table
+  if (chunk_ids.size() < 2 && !has_many_invalidated_rows) return {};
+
+  return chunk_ids;
+}
+
+bool DeltaMergePlugin::_try_merge(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                  const std::optional<ColumnID>& sort_column_id,
+                                  const std::shared_ptr<TransactionContext>& transaction_context) {
+  // Without a sort column, the reinserted rows keep their order
+  auto order_rows = ChunkRewriter::OrderRows{};
+  if (sort_column_id) {
+    const auto target_chunk_size = Hyrise::get().storage_manager.get_table(table_name)->target_chunk_size();
+    const auto sort_definition = SortColumnDefinition{*sort_column_id, SortMode::Ascending};
+    order_rows = [=](const std::shared_ptr<AbstractOperator>& validate) -> std::shared_ptr<AbstractOperator> {
+      return std::make_shared<Sort>(validate, std::vector<SortColumnDefinition>{sort_definition}, target_chunk_size);
+    };
+  }
+
+  return ChunkRewriter::rewrite_chunks(table_name, chunk_ids, order_rows, transaction_context);
+}
+
+std::optional<ColumnID> DeltaMergePlugin::_sort_column_id(const std::string& table_name, const Table& table) const {
+  const auto column_name = _sort_columns_setting->sort_column_name(table_name);
+  if (!column_name) return std::nullopt;
+
+  const auto column_names = table.column_names();
+  const auto iter = std::find(column_names.cbegin(), column_names.cend(), *column_name);
+  if (iter == column_names.cend()) return std::nullopt;
+
+  return ColumnID{static_cast<ColumnID::base_type>(std::distance(column_names.cbegin(), iter))};
+}
+
+EXPORT_PLUGIN(DeltaMergePlugin)
+
+}  // namespace opossum
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+#include "hyrise.hpp"
+#include "storage/chunk.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/chunk_rewriter.hpp"
+#include "utils/pausable_loop_thread.hpp"
+#include "utils/settings/abstract_synchronized_setting.hpp"
+
+namespace opossum {
+
+/*
+ * Comma-separated list of `table_name.column_name` entries. The DeltaMergePlugin sorts the merged chunks of these
+ * tables by the given column (ascending, NULLs first). Chunks of other tables keep the order of their rows.
+ */
+class DeltaMergeSortColumnsSetting : public AbstractSynchronizedSetting {
+ public:
+  DeltaMergeSortColumnsSetting();
+
+  const std::string& description() const final;
+
+  // Returns the name of the column by which the chunks of the table are sorted, if any
+  std::optional<std::string> sort_column_name(const std::string& table_name) const;
+
+ protected:
+  void _validate(const std::string& value) const final;
+};
+
+/*
+ * Rows inserted into a table end up in mutable chunks with unencoded ValueSegments, and deleted rows stay in their
+ * chunk until the chunk is rewritten. Over time, tables that are filled by single Inserts become much slower to scan
+ * than tables that were bulk-loaded and encoded. This plugin merges the inserted rows into the main part of the table
+ * in the background:
+ *
+ * 1. Finalize: chunks that are full (or not the last chunk anymore) and whose Inserts have all committed or rolled
+ *    back are finalized and encoded, which also generates their pruning statistics. If the rows of such a chunk are
+ *    already sorted by the table's sort column (see DeltaMergeSortColumnsSetting), the chunk is marked as sorted.
+ * 2. Merge: cold chunks with many invalidated rows or with few valid rows are merged. In one transaction, their
+ *    valid rows are deleted, optionally sorted, and reinserted into fresh chunks. The next run finalizes, marks, and
+ *    encodes these chunks. Like the MvccDeletePlugin, the merged chunks are removed physically once no transaction
+ *    can see them anymore.
+ */
+class DeltaMergePlugin : public AbstractPlugin {
+  friend class ClusteringPluginTest;
+  friend class DeltaMergePluginTest;
+
+ public:
+  std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  /**
+   * MERGE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS: the percentage of invalidated rows of a chunk from which on it is
+   * merged (even if it is the only chunk to merge)
+   * MERGE_THRESHOLD_PERCENTAGE_VALID_ROWS: chunks with fewer valid rows (relative to the target chunk size) are merged
+   * with other such chunks
+   * MERGE_THRESHOLD_LAST_COMMIT: the number of commits that must have passed since a chunk was last modified
+   * IDLE_DELAY_MERGE: sleep after finalizing and merging the chunks of all tables
+   * IDLE_DELAY_PHYSICAL_DELETE: sleep after execution of physical delete
+   */
+  constexpr static double MERGE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS = 0.3;
+  constexpr static double MERGE_THRESHOLD_PERCENTAGE_VALID_ROWS = 0.5;
+  constexpr static CommitID MERGE_THRESHOLD_LAST_COMMIT = CommitID{100};
+  constexpr static std::chrono::milliseconds IDLE_DELAY_MERGE = std::chrono::milliseconds(1000);
+  constexpr static std::chrono::milliseconds IDLE_DELAY_PHYSICAL_DELETE = std::chrono::milliseconds(1000);
+
+ private:
+  void _merge_loop();
+
+  // Returns the number of finalized chunks
+  static size_t _finalize_chunks(const std::shared_ptr<Table>& table, const std::optional<ColumnID>& sort_column_id);
+
+  // Returns the sorted IDs of the chunks that should be merged, or an empty vector if merging does not pay off
+  static std::vector<ChunkID> _merge_candidates(const std::shared_ptr<Table>& table);
+
+  static bool _try_merge(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                         const std::optional<ColumnID>& sort_column_id,
+                         const std::shared_ptr<TransactionContext>& transaction_context);
+
+  std::optional<ColumnID> _sort_column_id(const std::string& table_name, const Table& table) const;
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_merge, _loop_thread_physical_delete;
+
+  std::shared_ptr<DeltaMergeSortColumnsSetting> _sort_columns_setting;
+
+  ChunkRewriter _chunk_rewriter;
+};
+
+}  // namespace opossum
@@ -0,0 +1,399 @@
+#include "encoding_advisor_plugin.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "constant_mappings.hpp"
+#include "resolve_type.hpp"
+#include "storage/base_dictionary_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/segment_encoding_exception.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/segment_iterables/any_segment_iterable.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns nullptr if the encoding cannot represent the segment (see SegmentEncodingException). Other errors, such as
+// failed assertions, are passed on.
+std::shared_ptr<AbstractSegment> try_encode_segment(const std::shared_ptr<AbstractSegment>& segment,
+                                                    const DataType data_type,
+                                                    const SegmentEncodingSpec& encoding_spec) {
+  try {
+    return ChunkEncoder::encode_segment(segment, data_type, encoding_spec);
+  } catch (const SegmentEncodingException&) {
+    return nullptr;
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+EncodingAdvisorMemoryBudgetSetting::EncodingAdvisorMemoryBudgetSetting()
+    : AbstractSynchronizedSetting("EncodingAdvisorPlugin.memory_budget") {}
+
+const std::string& EncodingAdvisorMemoryBudgetSetting::description() const {
+  static const auto description =
+      std::string{"Memory budget in bytes for all segments of immutable chunks, empty for their current size"};
+  return description;
+}
+
+std::optional<size_t> EncodingAdvisorMemoryBudgetSetting::memory_budget() const {
+  const auto value = _current_value();
+  if (value.empty()) return std::nullopt;
+  return std::stoull(value);
+}
+
+void EncodingAdvisorMemoryBudgetSetting::_validate(const std::string& value) const {
+  Assert(std::all_of(value.cbegin(), value.cend(), [](const auto character) { return std::isdigit(character); }),
+         "Memory budget must be empty or a number of bytes.");
+}
+
+MetaEncodingAdvisorTable::MetaEncodingAdvisorTable(const EncodingAdvisorPlugin& plugin)
+    : AbstractMetaTable(TableColumnDefinitions{{"table_name", DataType::String, false},
+                                               {"chunk_id", DataType::Int, false},
+                                               {"column_id", DataType::Int, false},
+                                               {"column_name", DataType::String, false},
+                                               {"previous_encoding_type", DataType::String, false},
+                                               {"encoding_type", DataType::String, false},
+                                               {"previous_size_in_bytes", DataType::Long, false},
+                                               {"estimated_size_in_bytes", DataType::Long, false},
+                                               {"sequential_accesses", DataType::Long, false},
+                                               {"random_accesses", DataType::Long, false},
+                                               {"estimated_access_cost", DataType::Double, false}}),
+      _plugin(plugin) {}
+
+const std::string& MetaEncodingAdvisorTable::name() const {
+  static const auto name = std::string{"encoding_advisor"};
+  return name;
+}
+
+std::shared_ptr<Table> MetaEncodingAdvisorTable::_on_generate() const {
+  auto output_table = std::make_shared<Table>(_column_definitions, TableType::Data, std::nullopt, UseMvcc::Yes);
+
+  for (const auto& decision : _plugin.decisions()) {
+    output_table->append({pmr_string{decision.table_name}, static_cast<int32_t>(decision.chunk_id),
+                          static_cast<int32_t>(decision.column_id), pmr_string{decision.column_name},
+                          pmr_string{encoding_type_to_string.left.at(decision.previous_encoding_type)},
+                          pmr_string{encoding_type_to_string.left.at(decision.encoding_type)},
+                          static_cast<int64_t>(decision.previous_size), static_cast<int64_t>(decision.estimated_size),
+                          static_cast<int64_t>(decision.sequential_accesses),
+                          static_cast<int64_t>(decision.random_accesses), decision.estimated_access_cost});
+  }
+
+  return output_table;
+}
+
+std::string EncodingAdvisorPlugin::description() const { return "Encoding advisor plugin"; }
+
+void EncodingAdvisorPlugin::start() {
+  _memory_budget_setting = std::make_shared<EncodingAdvisorMemoryBudgetSetting>();
+  _memory_budget_setting->register_at_settings_manager();
+
+  _meta_table = std::make_shared<MetaEncodingAdvisorTable>(*this);
+  Hyrise::get().meta_table_manager.add_table(_meta_table);
+
+  _loop_thread_advise = std::make_unique<PausableLoopThread>(IDLE_DELAY_ADVISE, [&](size_t) { _advise_loop(); });
+}
+
+void EncodingAdvisorPlugin::stop() {
+  // Call destructor of PausableLoopThread to terminate its thread
+  _loop_thread_advise.reset();
+
+  // The meta table and the setting must not outlive the plugin, which is unloaded after it is stopped
+  Hyrise::get().meta_table_manager.remove_table(_meta_table->name());
+  _meta_table.reset();
+  _memory_budget_setting->unregister_at_settings_manager();
+  _memory_budget_setting.reset();
+
+  std::lock_guard<std::mutex> lock(_decisions_mutex);
+  _decisions.clear();
+}
+
+std::vector<EncodingAdvisorPlugin::EncodingDecision> EncodingAdvisorPlugin::decisions() const {
+  std::lock_guard<std::mutex> lock(_decisions_mutex);
+  return _decisions;
+}
+
+EncodingAdvisorPlugin::AccessCosts EncodingAdvisorPlugin::access_costs(const EncodingType encoding_type) {
+  switch (encoding_type) {
+    case EncodingType::Unencoded:
+      return {1.0, 1.0};
+    case EncodingType::Dictionary:
+    case EncodingType::FrameOfReference:
+      return {1.5, 2.0};
+    case EncodingType::FixedStringDictionary:
+    case EncodingType::ALP:
+      return {2.0, 2.5};
+    case EncodingType::RunLength:
+      return {1.5, 8.0};
+    case EncodingType::FSST:
+      return {4.0, 16.0};
+    case EncodingType::Delta:
+      return {2.0, 32.0};
+    case EncodingType::LZ4:
+      return {8.0, 64.0};
+  }
+  Fail("Unhandled encoding type");
+}
+
+void EncodingAdvisorPlugin::_advise_loop() {
+  // An exception would terminate the loop thread and, thus, the server. Failed runs are retried in the next iteration.
+  auto reencoded_segment_count = size_t{0};
+  try {
+    reencoded_segment_count = _advise(_memory_budget_setting->memory_budget());
+  } catch (const std::exception& exception) {
+    Hyrise::get().log_manager.add_message("EncodingAdvisorPlugin",
+                                          std::string{"Advising encodings failed: "} + exception.what(),
+                                          LogLevel::Warning);
+    return;
+  }
+  if (reencoded_segment_count == 0) return;
+
+  Hyrise::get().log_manager.add_message(
+      "EncodingAdvisorPlugin", "Re-encoded " + std::to_string(reencoded_segment_count) + " segments", LogLevel::Info);
+}
+
+size_t EncodingAdvisorPlugin::_advise(const std::optional<size_t>& memory_budget) {
+  struct SegmentCandidates {
+    std::shared_ptr<Chunk> chunk;
+    std::shared_ptr<AbstractSegment> segment;
+    DataType data_type;
+    EncodingDecision decision;
+    std::vector<Candidate> candidates;
+    size_t chosen_candidate_index;
+  };
+
+  auto segments = std::vector<SegmentCandidates>{};
+  auto memory_usage = size_t{0};
+
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    const auto chunk_count = table->chunk_count();
+    const auto column_count = table->column_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      // Skip physically deleted chunks and chunks that are still being filled
+      if (!chunk || chunk->is_mutable()) continue;
+
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        const auto segment = chunk->get_segment(column_id);
+        const auto data_type = table->column_data_type(column_id);
+
+        const auto& access_counter = segment->access_counter;
+        const uint64_t sequential_accesses = access_counter[SegmentAccessCounter::AccessType::Sequential] +
+                                             access_counter[SegmentAccessCounter::AccessType::Monotonic];
+        const uint64_t random_accesses = access_counter[SegmentAccessCounter::AccessType::Random] +
+                                         access_counter[SegmentAccessCounter::AccessType::Point];
+
+        const auto previous_size = segment->memory_usage(MemoryUsageCalculationMode::Sampled);
+        memory_usage += previous_size;
+
+        auto decision = EncodingDecision{table_name,
+                                         chunk_id,
+                                         column_id,
+                                         table->column_name(column_id),
+                                         get_segment_encoding_spec(segment).encoding_type,
+                                         EncodingType::Unencoded,
+                                         previous_size,
+                                         size_t{0},
+                                         sequential_accesses,
+                                         random_accesses,
+                                         0.0};
+        auto candidates = _estimate_candidates(segment, data_type, previous_size, sequential_accesses, random_accesses);
+        segments.push_back(SegmentCandidates{chunk, segment, data_type, std::move(decision), std::move(candidates), 0});
+      }
+    }
+  }
+
+  // Start with the smallest candidate of every segment. Then, greedily apply the upgrades to the next larger (and
+  // cheaper) candidate of a segment that have the highest access cost saving per additional byte, as long as they fit
+  // into the memory budget.
+  const auto available_memory = memory_budget.value_or(memory_usage);
+  auto estimated_memory_usage = size_t{0};
+  for (const auto& segment_candidates : segments) {
+    estimated_memory_usage += segment_candidates.candidates.front().estimated_size;
+  }
+
+  using Upgrade = std::pair<double, size_t>;  // Access cost saving per byte, segment index
+  auto upgrades = std::priority_queue<Upgrade>{};
+
+  const auto additional_size_of_upgrade = [&](const size_t segment_index) {
+    const auto& segment_candidates = segments[segment_index];
+    const auto& candidates = segment_candidates.candidates;
+    const auto chosen_candidate_index = segment_candidates.chosen_candidate_index;
+    return candidates[chosen_candidate_index + 1].estimated_size - candidates[chosen_candidate_index].estimated_size;
+  };
+
+  const auto add_upgrade = [&](const size_t segment_index) {
+    const auto& segment_candidates = segments[segment_index];
+    const auto& candidates = segment_candidates.candidates;
+    const auto chosen_candidate_index = segment_candidates.chosen_candidate_index;
+    if (chosen_candidate_index + 1 == candidates.size()) return;
+
+    const auto access_cost_saving = candidates[chosen_candidate_index].estimated_access_cost -
+                                    candidates[chosen_candidate_index + 1].estimated_access_cost;
+    upgrades.emplace(access_cost_saving / static_cast<double>(additional_size_of_upgrade(segment_index)),
+                     segment_index);
+  };
+
+  for (auto segment_index = size_t{0}; segment_index < segments.size(); ++segment_index) {
+    add_upgrade(segment_index);
+  }
+
+  while (!upgrades.empty()) {
+    const auto segment_index = upgrades.top().second;
+    upgrades.pop();
+
+    // Further upgrades of this segment are even larger, so they do not fit either
+    const auto additional_size = additional_size_of_upgrade(segment_index);
+    if (estimated_memory_usage + additional_size > available_memory) continue;
+
+    estimated_memory_usage += additional_size;
+    ++segments[segment_index].chosen_candidate_index;
+    add_upgrade(segment_index);
+  }
+
+  auto decisions = std::vector<EncodingDecision>{};
+  decisions.reserve(segments.size());
+  auto reencoded_segment_count = size_t{0};
+  for (auto& segment_candidates : segments) {
+    const auto& candidate = segment_candidates.candidates[segment_candidates.chosen_candidate_index];
+    auto& decision = segment_candidates.decision;
+    decision.encoding_type = candidate.encoding_type;
+    decision.estimated_size = candidate.estimated_size;
+    decision.estimated_access_cost = candidate.estimated_access_cost;
+
+    if (decision.encoding_type != decision.previous_encoding_type) {
+      // Keep the accesses, so that the next run does not consider the segment as unused. The counters are copied
+      // before encoding, as the encoder reads the segment, too.
+      const auto& segment = segment_candidates.segment;
+      const auto access_counter = segment->access_counter;
+      const auto encoded_segment =
+          try_encode_segment(segment, segment_candidates.data_type, SegmentEncodingSpec{decision.encoding_type});
+      if (encoded_segment) {
+        encoded_segment->access_counter = access_counter;
+        segment_candidates.chunk->replace_segment(decision.column_id, encoded_segment);
+        ++reencoded_segment_count;
+      } else {
+        // The sample could be encoded, but the entire segment cannot. The segment keeps its encoding.
+        segment->access_counter = access_counter;
+        decision.encoding_type = decision.previous_encoding_type;
+        decision.estimated_size = decision.previous_size;
+      }
+    }
+
+    decisions.push_back(std::move(decision));
+  }
+
+  std::lock_guard<std::mutex> lock(_decisions_mutex);
+  _decisions = std::move(decisions);
+
+  return reencoded_segment_count;
+}
+
+std::vector<EncodingAdvisorPlugin::Candidate> EncodingAdvisorPlugin::_estimate_candidates(
+    const std::shared_ptr<AbstractSegment>& segment, const DataType data_type, const size_t current_size,
+    const uint64_t sequential_accesses, const uint64_t random_accesses) {
+  const auto current_encoding_type = get_segment_encoding_spec(segment).encoding_type;
+  const auto estimate_access_cost = [&](const EncodingType encoding_type) {
+    const auto costs = access_costs(encoding_type);
+    return static_cast<double>(sequential_accesses) * costs.sequential +
+           static_cast<double>(random_accesses) * costs.random;
+  };
+
+  const auto segment_size = segment->size();
+  if (segment_size == 0) {
+    return {Candidate{current_encoding_type, current_size, estimate_access_cost(current_encoding_type)}};
+  }
+
+  auto candidates = std::vector<Candidate>{};
+  resolve_data_type(data_type, [&](const auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    auto sample_positions = std::make_shared<RowIDPosList>();
+    sample_positions->guarantee_single_chunk();
+    if (segment_size <= SAMPLE_RUN_COUNT * SAMPLE_RUN_LENGTH) {
+      sample_positions->reserve(segment_size);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment_size; ++chunk_offset) {
+        sample_positions->emplace_back(RowID{ChunkID{0}, chunk_offset});
+      }
+    } else {
+      sample_positions->reserve(SAMPLE_RUN_COUNT * SAMPLE_RUN_LENGTH);
+      const auto run_distance = segment_size / SAMPLE_RUN_COUNT;
+      for (auto run_index = ChunkOffset{0}; run_index < SAMPLE_RUN_COUNT; ++run_index) {
+        for (auto run_offset = ChunkOffset{0}; run_offset < SAMPLE_RUN_LENGTH; ++run_offset) {
+          sample_positions->emplace_back(RowID{ChunkID{0}, run_index * run_distance + run_offset});
+        }
+      }
+    }
+
+    auto values = pmr_vector<ColumnDataType>{};
+    auto null_values = pmr_vector<bool>{};
+    values.reserve(sample_positions->size());
+    null_values.reserve(sample_positions->size());
+    const auto iterable = create_any_segment_iterable<ColumnDataType>(*segment);
+    iterable.for_each(sample_positions, [&](const auto& position) {
+      values.emplace_back(position.is_null() ? ColumnDataType{} : position.value());
+      null_values.emplace_back(position.is_null());
+    });
+
+    // Reading the sample is counted as accesses to the segment. They are not caused by queries and must not influence
+    // later decisions.
+    auto& access_counter = segment->access_counter;
+    access_counter[SegmentAccessCounter::access_type(*sample_positions)] -= sample_positions->size();
+    if (std::dynamic_pointer_cast<const BaseDictionarySegment>(segment)) {
+      access_counter[SegmentAccessCounter::AccessType::Dictionary] -= sample_positions->size();
+    }
+
+    const auto sample_segment =
+        std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+    const auto scale = static_cast<double>(segment_size) / static_cast<double>(sample_positions->size());
+
+    for (const auto encoding_type : all_encoding_types) {
+      if (!encoding_supports_data_type(encoding_type, data_type)) continue;
+
+      // The size of the current encoding is known and does not have to be estimated
+      auto estimated_size = current_size;
+      if (encoding_type != current_encoding_type) {
+        // Encodings that cannot represent the sample are not considered
+        const auto encoded_sample = try_encode_segment(sample_segment, data_type, SegmentEncodingSpec{encoding_type});
+        if (!encoded_sample) continue;
+
+        const auto sample_size = encoded_sample->memory_usage(MemoryUsageCalculationMode::Full);
+        estimated_size = static_cast<size_t>(static_cast<double>(sample_size) * scale);
+      }
+
+      candidates.push_back(Candidate{encoding_type, estimated_size, estimate_access_cost(encoding_type)});
+    }
+  });
+
+  // Only keep candidates for which no other candidate is both smaller and cheaper to access. On ties, the current
+  // encoding is preferred, so that segments are not re-encoded without a benefit.
+  std::sort(candidates.begin(), candidates.end(), [&](const auto& lhs, const auto& rhs) {
+    return std::make_tuple(lhs.estimated_size, lhs.estimated_access_cost, lhs.encoding_type != current_encoding_type) <
+           std::make_tuple(rhs.estimated_size, rhs.estimated_access_cost, rhs.encoding_type != current_encoding_type);
+  });
+
+  auto pareto_optimal_candidates = std::vector<Candidate>{};
+  for (const auto& candidate : candidates) {
+    if (pareto_optimal_candidates.empty() ||
+        candidate.estimated_access_cost < pareto_optimal_candidates.back().estimated_access_cost) {
+      pareto_optimal_candidates.push_back(candidate);
+    }
+  }
+
+  return pareto_optimal_candidates;
+}
+
+EXPORT_PLUGIN(EncodingAdvisorPlugin)
+
+}  // namespace opossum
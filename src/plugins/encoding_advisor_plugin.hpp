@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest_prod.h"
+#include "hyrise.hpp"
+#include "storage/encoding_type.hpp"
+#include "utils/abstract_plugin.hpp"
+#include "utils/meta_tables/abstract_meta_table.hpp"
+#include "utils/pausable_loop_thread.hpp"
+#include "utils/settings/abstract_synchronized_setting.hpp"
+
+namespace opossum {
+
+class EncodingAdvisorPlugin;
+
+/*
+ * The memory budget (in bytes) for all segments of immutable chunks. If it is empty, the current size of the segments
+ * is used in every run of the EncodingAdvisorPlugin, i.e., the plugin never increases the memory consumption.
+ */
+class EncodingAdvisorMemoryBudgetSetting : public AbstractSynchronizedSetting {
+ public:
+  EncodingAdvisorMemoryBudgetSetting();
+
+  const std::string& description() const final;
+
+  std::optional<size_t> memory_budget() const;
+
+ protected:
+  void _validate(const std::string& value) const final;
+};
+
+/*
+ * Shows the decisions of the last run of the EncodingAdvisorPlugin, one row per segment.
+ */
+class MetaEncodingAdvisorTable : public AbstractMetaTable {
+ public:
+  explicit MetaEncodingAdvisorTable(const EncodingAdvisorPlugin& plugin);
+
+  const std::string& name() const final;
+
+ protected:
+  std::shared_ptr<Table> _on_generate() const final;
+
+  const EncodingAdvisorPlugin& _plugin;
+};
+
+/*
+ * Periodically chooses the encoding of every segment of immutable chunks based on its data and on how queries access
+ * it (see SegmentAccessCounter). Instead of one encoding per column or data type, as with the EncodingConfig of the
+ * benchmarks, every segment gets the encoding that suits its values and its access pattern.
+ *
+ * For each candidate encoding, the size of a segment is estimated by encoding a sample of it, which consists of a few
+ * runs of consecutive values, so that properties like sortedness or runs are kept. The access cost is estimated from
+ * the segment's sequential and random accesses and the relative cost of such an access for the encoding (see
+ * access_costs()). Starting with the smallest encoding of every segment, the plugin greedily applies the upgrades
+ * with the highest cost saving per additional byte until the memory budget is exhausted (see
+ * EncodingAdvisorMemoryBudgetSetting). Segments whose encoding changes are re-encoded and replaced online, queries
+ * that already hold the previous segment keep using it.
+ */
+class EncodingAdvisorPlugin : public AbstractPlugin {
+  friend class EncodingAdvisorPluginTest;
+
+ public:
+  struct AccessCosts {
+    double sequential;
+    double random;
+  };
+
+  struct EncodingDecision {
+    std::string table_name;
+    ChunkID chunk_id;
+    ColumnID column_id;
+    std::string column_name;
+    EncodingType previous_encoding_type;
+    EncodingType encoding_type;
+    size_t previous_size;
+    size_t estimated_size;
+    uint64_t sequential_accesses;
+    uint64_t random_accesses;
+    double estimated_access_cost;
+  };
+
+  std::string description() const final;
+
+  void start() final;
+
+  void stop() final;
+
+  // Returns the decisions of the last run
+  std::vector<EncodingDecision> decisions() const;
+
+  // Relative costs of accessing a single value with the given encoding, based on how much work its iterators do per
+  // value. Random accesses of RunLength, LZ4, FSST, and Delta segments have to search or decode more than one value.
+  static AccessCosts access_costs(EncodingType encoding_type);
+
+  /**
+   * IDLE_DELAY_ADVISE: sleep between two runs
+   * SAMPLE_RUN_COUNT, SAMPLE_RUN_LENGTH: number and length of the runs of consecutive values that form the sample
+   * used to estimate the size of a segment
+   */
+  constexpr static std::chrono::milliseconds IDLE_DELAY_ADVISE = std::chrono::milliseconds(60'000);
+  constexpr static ChunkOffset SAMPLE_RUN_COUNT = 8;
+  constexpr static ChunkOffset SAMPLE_RUN_LENGTH = 512;
+
+ private:
+  struct Candidate {
+    EncodingType encoding_type;
+    size_t estimated_size;
+    double estimated_access_cost;
+  };
+
+  void _advise_loop();
+
+  // Chooses and applies the encodings of all segments of immutable chunks. Returns the number of re-encoded segments.
+  size_t _advise(const std::optional<size_t>& memory_budget);
+
+  // Returns the Pareto-optimal candidates of the segment, ordered by increasing size and decreasing access cost
+  static std::vector<Candidate> _estimate_candidates(const std::shared_ptr<AbstractSegment>& segment,
+                                                     DataType data_type, size_t current_size,
+                                                     uint64_t sequential_accesses, uint64_t random_accesses);
+
+  std::unique_ptr<PausableLoopThread> _loop_thread_advise;
+
+  std::shared_ptr<EncodingAdvisorMemoryBudgetSetting> _memory_budget_setting;
+  std::shared_ptr<MetaEncodingAdvisorTable> _meta_table;
+
+  mutable std::mutex _decisions_mutex;
+  std::vector<EncodingDecision> _decisions;
+};
+
+}  // namespace opossum
@@ -1,9 +1,6 @@
 #include "mvcc_delete_plugin.hpp"
 
-#include "operators/get_table.hpp"
 #include "operators/table_wrapper.hpp"
-#include "operators/update.hpp"
-#include "operators/validate.hpp"
 #include "storage/pos_lists/row_id_pos_list.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
@@ -16,15 +13,15 @@ void MvccDeletePlugin::start() {
   _loop_thread_logical_delete =
       std::make_unique<PausableLoopThread>(IDLE_DELAY_LOGICAL_DELETE, [&](size_t) { _logical_delete_loop(); });
 
-  _loop_thread_physical_delete =
-      std::make_unique<PausableLoopThread>(IDLE_DELAY_PHYSICAL_DELETE, [&](size_t) { _physical_delete_loop(); });
+  _loop_thread_physical_delete = std::make_unique<PausableLoopThread>(
+      IDLE_DELAY_PHYSICAL_DELETE, [&](size_t) { _chunk_rewriter.delete_chunks_physically(); });
 }
 
 void MvccDeletePlugin::stop() {
   // Call destructor of PausableLoopThread to terminate its thread
   _loop_thread_logical_delete.reset();
   _loop_thread_physical_delete.reset();
-  _physical_delete_queue = {};
+  _chunk_rewriter.clear_physical_delete_queue();
 }
 
 /**
@@ -79,8 +76,7 @@ void MvccDeletePlugin::_logical_delete_loop() {
           DebugAssert(table->get_chunk(chunk_id)->get_cleanup_commit_id(),
                       "Chunk needs to be deleted logically before deleting it physically.");
 
-          std::lock_guard<std::mutex> lock(_physical_delete_queue_mutex);
-          _physical_delete_queue.emplace(table, chunk_id);
+          _chunk_rewriter.queue_physical_delete(table, {chunk_id});
           saved_memory += chunk_memory;
           num_chunks++;
         }
@@ -96,36 +92,6 @@ void MvccDeletePlugin::_logical_delete_loop() {
   }
 }
 
-/**
- * This function processes the physical-delete-queue until its empty.
- */
-void MvccDeletePlugin::_physical_delete_loop() {
-  std::lock_guard<std::mutex> lock(_physical_delete_queue_mutex);
-
-  if (!_physical_delete_queue.empty()) {
-    TableAndChunkID table_and_chunk_id = _physical_delete_queue.front();
-    const auto& table = table_and_chunk_id.first;
-    const auto& chunk = table->get_chunk(table_and_chunk_id.second);
-
-    DebugAssert(chunk != nullptr, "Chunk does not exist. Physical Delete can not be applied.");
-
-    if (chunk->get_cleanup_commit_id().has_value()) {
-      // Check whether there are still active transactions that might use the chunk
-      bool conflicting_transactions = false;
-      auto lowest_snapshot_commit_id = Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
-
-      if (lowest_snapshot_commit_id.has_value()) {
-        conflicting_transactions = chunk->get_cleanup_commit_id().value() > lowest_snapshot_commit_id.value();
-      }
-
-      if (!conflicting_transactions) {
-        _delete_chunk_physically(table, table_and_chunk_id.second);
-        _physical_delete_queue.pop();
-      }
-    }
-  }
-}
-
 bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const ChunkID chunk_id,
                                            const std::shared_ptr<TransactionContext>& transaction_context) {
   const auto& table = Hyrise::get().storage_manager.get_table(table_name);
@@ -135,49 +101,9 @@ bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const
   Assert(chunk_id < (table->chunk_count() - 1),
          "MVCC Logical Delete should not be applied on the last/current mutable chunk.");
 
-  // Create temporary referencing table that contains the given chunk only
-  //   Include all ChunksIDs of current table except chunk_id for pruning in GetTable
-  std::vector<ChunkID> excluded_chunk_ids(table->chunk_count() - 1);
-  std::iota(excluded_chunk_ids.begin(), excluded_chunk_ids.begin() + chunk_id, 0);
-  std::iota(excluded_chunk_ids.begin() + chunk_id, excluded_chunk_ids.end(), chunk_id + 1);
-
-  auto get_table = std::make_shared<GetTable>(table_name, excluded_chunk_ids, std::vector<ColumnID>());
-  get_table->set_transaction_context(transaction_context);
-  get_table->execute();
-
-  // Validate temporary table
-  auto validate = std::make_shared<Validate>(get_table);
-  validate->set_transaction_context(transaction_context);
-  validate->execute();
-
-  // Use Update operator to delete and re-insert valid records in chunk
-  // Pass validate into Update operator twice since data will not be changed.
-  auto update = std::make_shared<Update>(table_name, validate, validate);
-  update->set_transaction_context(transaction_context);
-  update->execute();
-
-  // Check for success
-  if (update->execute_failed()) {
-    // Transaction conflict. Usually, the OperatorTask would call rollback, but as we executed Update directly, that is
-    // our job.
-    transaction_context->rollback(RollbackReason::Conflict);
-    return false;
-  }
-
-  transaction_context->commit();
-  // Mark chunk as logically deleted
-  chunk->set_cleanup_commit_id(transaction_context->commit_id());
-  return true;
-}
-
-void MvccDeletePlugin::_delete_chunk_physically(const std::shared_ptr<Table>& table, const ChunkID chunk_id) {
-  const auto& chunk = table->get_chunk(chunk_id);
-
-  Assert(chunk->get_cleanup_commit_id().has_value(),
-         "The cleanup commit id of the chunk is not set. This should have been done by the logical delete.");
-
-  // Usage checks have been passed. Apply physical delete now.
-  table->remove_chunk(chunk_id);
+  // Delete and reinsert the valid rows of the chunk into the last chunk of the table
+  return ChunkRewriter::rewrite_chunks(table_name, {chunk_id}, {}, transaction_context,
+                                       InsertChunkAllocation::LastChunk);
 }
 
 EXPORT_PLUGIN(MvccDeletePlugin)
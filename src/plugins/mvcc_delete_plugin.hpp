@@ -1,15 +1,14 @@
 #pragma once
 
 #include <algorithm>
-#include <mutex>
 #include <numeric>
-#include <queue>
 #include <thread>
 
 #include "gtest/gtest_prod.h"
 #include "hyrise.hpp"
 #include "storage/chunk.hpp"
 #include "utils/abstract_plugin.hpp"
+#include "utils/chunk_rewriter.hpp"
 #include "utils/pausable_loop_thread.hpp"
 #include "utils/singleton.hpp"
 
@@ -52,19 +51,14 @@ class MvccDeletePlugin : public AbstractPlugin {
   constexpr static std::chrono::milliseconds IDLE_DELAY_PHYSICAL_DELETE = std::chrono::milliseconds(1000);
 
  private:
-  using TableAndChunkID = std::pair<const std::shared_ptr<Table>, ChunkID>;
-
   void _logical_delete_loop();
-  void _physical_delete_loop();
 
   static bool _try_logical_delete(const std::string& table_name, ChunkID chunk_id,
                                   const std::shared_ptr<TransactionContext>& transaction_context);
-  static void _delete_chunk_physically(const std::shared_ptr<Table>& table, ChunkID chunk_id);
 
   std::unique_ptr<PausableLoopThread> _loop_thread_logical_delete, _loop_thread_physical_delete;
 
-  std::mutex _physical_delete_queue_mutex;
-  std::queue<TableAndChunkID> _physical_delete_queue;
+  ChunkRewriter _chunk_rewriter;
 };
 
 }  // namespace opossum
@@ -8,6 +8,9 @@
 
 #include "expression/expression_functional.hpp"
 #include "logical_query_plan/mock_node.hpp"
+#include "operators/get_table.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
 #include "sql/sql_plan_cache.hpp"
 #include "statistics/attribute_statistics.hpp"
 #include "statistics/statistics_objects/abstract_statistics_object.hpp"
@@ -231,4 +234,37 @@ std::shared_ptr<const Table> to_simple_reference_table(const std::shared_ptr<con
   return table_out;
 }
 
+std::shared_ptr<AbstractOperator> validate_table(const std::string& table_name,
+                                                 const std::shared_ptr<TransactionContext>& transaction_context) {
+  auto get_table = std::make_shared<GetTable>(table_name);
+  get_table->set_transaction_context(transaction_context);
+  get_table->execute();
+
+  auto validate = std::make_shared<Validate>(get_table);
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+  return validate;
+}
+
+uint64_t visible_row_count(const std::string& table_name) {
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  return validate_table(table_name, transaction_context)->get_output()->row_count();
+}
+
+void insert_rows(const std::string& table_name, const std::vector<std::vector<AllTypeVariant>>& rows,
+                 const std::shared_ptr<TransactionContext>& transaction_context,
+                 const InsertChunkAllocation chunk_allocation) {
+  const auto target_table = Hyrise::get().storage_manager.get_table(table_name);
+  auto values_to_insert = std::make_shared<Table>(target_table->column_definitions(), TableType::Data);
+  for (const auto& row : rows) {
+    values_to_insert->append(row);
+  }
+
+  auto table_wrapper = std::make_shared<TableWrapper>(values_to_insert);
+  table_wrapper->execute();
+  auto insert = std::make_shared<Insert>(table_name, table_wrapper, chunk_allocation);
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+}
+
 }  // namespace opossum
@@ -12,6 +12,7 @@
 #include "hyrise.hpp"
 #include "logical_query_plan/mock_node.hpp"
 #include "operators/abstract_operator.hpp"
+#include "operators/insert.hpp"
 #include "operators/table_scan.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_plan_cache.hpp"
@@ -93,6 +94,18 @@ bool compare_files(const std::string& original_file, const std::string& created_
 // where necessary.
 std::shared_ptr<const Table> to_simple_reference_table(const std::shared_ptr<const Table>& table);
 
+// Utilities for tests on MVCC tables. validate_table returns the executed Validate over a GetTable of the table.
+std::shared_ptr<AbstractOperator> validate_table(const std::string& table_name,
+                                                 const std::shared_ptr<TransactionContext>& transaction_context);
+
+// Returns the number of rows of the table that are visible to a new transaction
+uint64_t visible_row_count(const std::string& table_name);
+
+// Inserts the rows into the table within the transaction, which is not committed
+void insert_rows(const std::string& table_name, const std::vector<std::vector<AllTypeVariant>>& rows,
+                 const std::shared_ptr<TransactionContext>& transaction_context,
+                 InsertChunkAllocation chunk_allocation = InsertChunkAllocation::LastChunk);
+
 const SegmentEncodingSpec all_segment_encoding_specs[]{
     SegmentEncodingSpec{EncodingType::Unencoded},
     SegmentEncodingSpec{EncodingType::Dictionary, VectorCompressionType::FixedWidthInteger},
@@ -101,5 +114,11 @@ const SegmentEncodingSpec all_segment_encoding_specs[]{
     SegmentEncodingSpec{EncodingType::FixedStringDictionary, VectorCompressionType::BitPacking},
     SegmentEncodingSpec{EncodingType::FrameOfReference},
     SegmentEncodingSpec{EncodingType::LZ4},
-    SegmentEncodingSpec{EncodingType::RunLength}};
+    SegmentEncodingSpec{EncodingType::RunLength},
+    SegmentEncodingSpec{EncodingType::FSST, VectorCompressionType::FixedWidthInteger},
+    SegmentEncodingSpec{EncodingType::FSST, VectorCompressionType::BitPacking},
+    SegmentEncodingSpec{EncodingType::Delta, VectorCompressionType::FixedWidthInteger},
+    SegmentEncodingSpec{EncodingType::Delta, VectorCompressionType::BitPacking},
+    SegmentEncodingSpec{EncodingType::ALP, VectorCompressionType::FixedWidthInteger},
+    SegmentEncodingSpec{EncodingType::ALP, VectorCompressionType::BitPacking}};
 }  // namespace opossum
@@ -0,0 +1,198 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/evaluation/expression_compiler.hpp"
+#include "expression/evaluation/expression_evaluator.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/load_table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class ExpressionCompilerTest : public BaseTest {
+ public:
+  void SetUp() override {
+    table_a = load_table("resources/test_data/tbl/expression_evaluator/input_a.tbl", 4);
+    a = PQPColumnExpression::from_table(*table_a, "a");
+    b = PQPColumnExpression::from_table(*table_a, "b");
+    c = PQPColumnExpression::from_table(*table_a, "c");
+    d = PQPColumnExpression::from_table(*table_a, "d");
+    e = PQPColumnExpression::from_table(*table_a, "e");
+    f = PQPColumnExpression::from_table(*table_a, "f");
+    s1 = PQPColumnExpression::from_table(*table_a, "s1");
+    s2 = PQPColumnExpression::from_table(*table_a, "s2");
+    s3 = PQPColumnExpression::from_table(*table_a, "s3");
+  }
+
+  // Compiles the expression and checks that its results are equal to those of the ExpressionEvaluator for all chunks
+  void expect_equal_to_evaluator(const std::shared_ptr<AbstractExpression>& expression) {
+    expect_equal_to_evaluator(expression, table_a);
+  }
+
+  void expect_equal_to_evaluator(const std::shared_ptr<AbstractExpression>& expression,
+                                 const std::shared_ptr<Table>& table) {
+    SCOPED_TRACE(expression->description(AbstractExpression::DescriptionMode::ColumnName));
+
+    const auto compiled_expression = compiler.compile(expression);
+    ASSERT_TRUE(compiled_expression);
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      auto evaluator = ExpressionEvaluator{table, chunk_id};
+
+      const auto expected_segment = evaluator.evaluate_expression_to_segment(*expression);
+      const auto segment = compiled_expression->evaluate_to_segment(*table, chunk_id);
+      ASSERT_EQ(segment->data_type(), expected_segment->data_type());
+      EXPECT_EQ(segment->is_nullable(), expected_segment->is_nullable());
+      ASSERT_EQ(segment->size(), expected_segment->size());
+
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+        const auto value = (*segment)[chunk_offset];
+        const auto expected_value = (*expected_segment)[chunk_offset];
+        EXPECT_EQ(variant_is_null(value), variant_is_null(expected_value));
+        if (!variant_is_null(value) && !variant_is_null(expected_value)) {
+          EXPECT_EQ(value, expected_value);
+        }
+      }
+
+      if (expression->data_type() == ExpressionEvaluator::DataTypeBool) {
+        EXPECT_EQ(compiled_expression->evaluate_to_pos_list(*table, chunk_id),
+                  evaluator.evaluate_expression_to_pos_list(*expression));
+      }
+    }
+  }
+
+  ExpressionCompiler compiler;
+  std::shared_ptr<Table> table_a;
+  std::shared_ptr<PQPColumnExpression> a, b, c, d, e, f, s1, s2, s3;
+};
+
+TEST_F(ExpressionCompilerTest, Arithmetics) {
+  expect_equal_to_evaluator(add_(a, b));
+  expect_equal_to_evaluator(sub_(e, c));
+  expect_equal_to_evaluator(mul_(f, add_(a, 3)));
+  expect_equal_to_evaluator(div_(c, b));
+  expect_equal_to_evaluator(div_(a, 0));
+  expect_equal_to_evaluator(div_(e, sub_(a, 2)));
+  expect_equal_to_evaluator(mod_(d, 3));
+  expect_equal_to_evaluator(mod_(f, a));
+  expect_equal_to_evaluator(add_(c, null_()));
+  expect_equal_to_evaluator(unary_minus_(e));
+  expect_equal_to_evaluator(cast_(mul_(a, 2.5), DataType::Int));
+}
+
+TEST_F(ExpressionCompilerTest, Predicates) {
+  expect_equal_to_evaluator(equals_(c, 33));
+  expect_equal_to_evaluator(not_equals_(a, e));
+  expect_equal_to_evaluator(less_than_(s1, s2));
+  expect_equal_to_evaluator(greater_than_equals_(f, c));
+  expect_equal_to_evaluator(between_inclusive_(c, 33, 34));
+  expect_equal_to_evaluator(between_exclusive_(a, 1, d));
+  expect_equal_to_evaluator(in_(a, list_(1, 3, "hello")));
+  expect_equal_to_evaluator(in_(c, list_(1, null_())));
+  expect_equal_to_evaluator(not_in_(s3, list_("abcd", "hello")));
+  expect_equal_to_evaluator(in_(a, list_("hello")));
+  expect_equal_to_evaluator(like_(s1, "%a%"));
+  expect_equal_to_evaluator(like_(s3, "xyz%"));
+  expect_equal_to_evaluator(not_like_(s3, "%lol"));
+  expect_equal_to_evaluator(like_(s1, "%e%o%"));
+  expect_equal_to_evaluator(like_(s1, "H_llo"));
+  expect_equal_to_evaluator(is_null_(c));
+  expect_equal_to_evaluator(is_not_null_(s3));
+  expect_equal_to_evaluator(is_null_(add_(c, a)));
+}
+
+TEST_F(ExpressionCompilerTest, Logical) {
+  expect_equal_to_evaluator(and_(greater_than_(a, 1), less_than_(c, 35)));
+  expect_equal_to_evaluator(or_(is_null_(c), equals_(s1, "a")));
+  expect_equal_to_evaluator(or_(equals_(c, 33), like_(s3, "%o%")));
+  expect_equal_to_evaluator(and_(equals_(c, 34), null_()));
+  expect_equal_to_evaluator(or_(equals_(c, 34), null_()));
+}
+
+TEST_F(ExpressionCompilerTest, Case) {
+  expect_equal_to_evaluator(case_(greater_than_(c, 33), a, e));
+  expect_equal_to_evaluator(case_(is_null_(s3), s1, s3));
+  expect_equal_to_evaluator(case_(equals_(a, 1), div_(b, 0), case_(equals_(a, 2), c, null_())));
+}
+
+TEST_F(ExpressionCompilerTest, MultipleBlocks) {
+  // Chunks are evaluated in blocks of 1'024 rows. Check chunks with multiple and partially filled blocks, and blocks in
+  // which only some operands of AND and only one branch of CASE are evaluated.
+  const auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"x", DataType::Int, true}, {"y", DataType::Int, false}}, TableType::Data, 2'500);
+  for (auto row = int32_t{0}; row < 6'000; ++row) {
+    table->append({row % 7 == 0 ? NULL_VALUE : AllTypeVariant{row}, row % 100});
+  }
+
+  const auto x = PQPColumnExpression::from_table(*table, "x");
+  const auto y = PQPColumnExpression::from_table(*table, "y");
+
+  expect_equal_to_evaluator(add_(x, y), table);
+  expect_equal_to_evaluator(div_(x, y), table);
+  expect_equal_to_evaluator(and_(greater_than_(x, 100), less_than_(y, 50)), table);
+  expect_equal_to_evaluator(and_(less_than_(x, 2'000), and_(is_not_null_(x), greater_than_(y, 10))), table);
+  expect_equal_to_evaluator(or_(less_than_(x, 1'200), is_null_(x)), table);
+  expect_equal_to_evaluator(in_(y, list_(1, 20, 300)), table);
+  expect_equal_to_evaluator(case_(less_than_(x, 3'000), x, y), table);
+  expect_equal_to_evaluator(case_(less_than_(y, 100), y, x), table);
+}
+
+TEST_F(ExpressionCompilerTest, UnsupportedExpressions) {
+  EXPECT_FALSE(compiler.compile(concat_(s1, s2)));
+  EXPECT_FALSE(compiler.compile(like_(s1, s2)));
+  EXPECT_FALSE(compiler.compile(and_(greater_than_(a, 1), equals_(substr_(s1, 1, 2), "He"))));
+  EXPECT_FALSE(compiler.compile(cast_(a, DataType::String)));
+}
+
+TEST_F(ExpressionCompilerTest, Cache) {
+  const auto compiled_expression = compiler.compile(add_(a, b));
+  EXPECT_EQ(compiler.compile(add_(a, b)), compiled_expression);
+  EXPECT_NE(compiler.compile(add_(a, c)), compiled_expression);
+  EXPECT_FALSE(compiler.compile(concat_(s1, s2)));
+  EXPECT_EQ(compiler.cache_size(), 3);
+
+  // a + c is the least recently used expression when a + d is compiled
+  auto small_compiler = ExpressionCompiler{2};
+  const auto small_compiled_expression = small_compiler.compile(add_(a, b));
+  const auto evicted_expression = small_compiler.compile(add_(a, c));
+  EXPECT_EQ(small_compiler.compile(add_(a, b)), small_compiled_expression);
+  small_compiler.compile(add_(a, d));
+  EXPECT_EQ(small_compiler.cache_size(), 2);
+  EXPECT_EQ(small_compiler.compile(add_(a, b)), small_compiled_expression);
+  EXPECT_NE(small_compiler.compile(add_(a, c)), evicted_expression);
+}
+
+TEST_F(ExpressionCompilerTest, TableScanAndProjection) {
+  const auto table_wrapper = std::make_shared<TableWrapper>(table_a);
+  table_wrapper->execute();
+
+  const auto predicate = or_(equals_(c, 33), like_(s3, "%o%"));
+  const auto expressions = expression_vector(a, add_(c, e), case_(is_null_(s3), s1, s3));
+
+  const auto expected_scan = std::make_shared<TableScan>(table_wrapper, predicate);
+  expected_scan->execute();
+  const auto expected_projection = std::make_shared<Projection>(expected_scan, expressions);
+  expected_projection->execute();
+
+  Hyrise::get().expression_compiler = std::make_shared<ExpressionCompiler>();
+
+  const auto table_scan = std::make_shared<TableScan>(table_wrapper, predicate);
+  EXPECT_EQ(table_scan->create_impl()->description(), "CompiledExpression");
+  table_scan->execute();
+  const auto projection = std::make_shared<Projection>(table_scan, expressions);
+  projection->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(projection->get_output(), expected_projection->get_output());
+}
+
+}  // namespace opossum
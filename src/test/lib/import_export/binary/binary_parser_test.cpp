@@ -1,3 +1,5 @@
+#include <cstdio>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -6,6 +8,8 @@
 
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
+#include "import_export/binary/binary_writer.hpp"
+#include "memory/mapped_pages_memory_resource.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 
@@ -422,4 +426,54 @@ TEST_F(BinaryParserTest, SortColumnDefinitions) {
   EXPECT_TRUE(table->get_chunk(ChunkID{2})->individually_sorted_by().empty());
 }
 
+TEST_F(BinaryParserTest, PageAlignedLayout) {
+  const auto filename = test_data_path + "page_aligned_layout.bin";
+
+  // The chunks are large enough for their buffers to be aligned to pages.
+  const auto chunk_size = ChunkOffset{40'000};
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Int, false);
+  column_definitions.emplace_back("b", DataType::String, true);
+
+  auto expected_table = std::make_shared<Table>(column_definitions, TableType::Data, chunk_size);
+  for (auto row = int32_t{0}; row < 2 * static_cast<int32_t>(chunk_size); ++row) {
+    expected_table->append({row, row % 7 == 0 ? AllTypeVariant{} : AllTypeVariant{pmr_string{std::to_string(row)}}});
+  }
+  expected_table->last_chunk()->finalize();
+  ChunkEncoder::encode_chunks(expected_table, {ChunkID{1}}, SegmentEncodingSpec{EncodingType::Dictionary});
+
+  BinaryWriter::write(*expected_table, filename, BinaryFileLayout::PageAligned);
+  auto table = BinaryParser::parse(filename);
+  std::remove(filename.c_str());
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+
+  const auto value_segment =
+      std::dynamic_pointer_cast<ValueSegment<int32_t>>(table->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  const auto dictionary_segment =
+      std::dynamic_pointer_cast<DictionarySegment<int32_t>>(table->get_chunk(ChunkID{1})->get_segment(ColumnID{0}));
+  ASSERT_TRUE(value_segment);
+  ASSERT_TRUE(dictionary_segment);
+
+  // The pages can only be mapped if the OS uses the page size of the file format.
+  if (MappedPagesMemoryResource::page_size() == BINARY_FILE_PAGE_SIZE) {
+    EXPECT_EQ(value_segment->values().get_allocator().resource(), &MappedPagesMemoryResource::get());
+    EXPECT_EQ(dictionary_segment->dictionary()->get_allocator().resource(), &MappedPagesMemoryResource::get());
+  }
+}
+
+TEST_F(BinaryParserTest, UnknownLayout) {
+  const auto filename = test_data_path + "unknown_layout.bin";
+  {
+    auto file = std::ofstream{filename, std::ios::binary};
+    const auto marker = PAGE_ALIGNED_BINARY_FILE_MARKER;
+    const auto layout = uint8_t{42};
+    file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+    file.write(reinterpret_cast<const char*>(&layout), sizeof(layout));
+  }
+
+  EXPECT_THROW(BinaryParser::parse(filename), std::logic_error);
+  std::remove(filename.c_str());
+}
+
 }  // namespace opossum
@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <fstream>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -7,9 +8,11 @@
 
 #include "base_test.hpp"
 
+#include "import_export/binary/binary_parser.hpp"
 #include "import_export/binary/binary_writer.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/abstract_encoded_segment.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/table.hpp"
@@ -262,6 +265,70 @@ TEST_F(BinaryWriterTest, LZ4MultipleBlocks) {
   EXPECT_TRUE(compare_files(reference_filename, filename));
 }
 
+TEST_F(BinaryWriterTest, FSSTSegmentRoundTrip) {
+  // No reference file exists for FSST, so the written file is parsed again and compared to the original table
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::String, true);
+  column_definitions.emplace_back("b", DataType::String, false);
+
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data, 100);
+  for (auto index = 0; index < 250; ++index) {
+    const auto value = pmr_string{"http://www.example.com/page_"} + pmr_string{std::to_string(index)};
+    table->append({index % 7 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{value}, pmr_string{""}});
+  }
+
+  table->last_chunk()->finalize();
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::FSST, VectorCompressionType::BitPacking});
+  BinaryWriter::write(*table, filename);
+
+  const auto parsed_table = BinaryParser::parse(filename);
+  EXPECT_TABLE_EQ_ORDERED(parsed_table, table);
+
+  const auto& parsed_segment = parsed_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+  const auto encoded_segment = std::dynamic_pointer_cast<AbstractEncodedSegment>(parsed_segment);
+  ASSERT_TRUE(encoded_segment);
+  EXPECT_EQ(encoded_segment->encoding_type(), EncodingType::FSST);
+}
+
+TEST_F(BinaryWriterTest, NumericSegmentsRoundTrip) {
+  // No reference files exist for Delta, ALP, and 64-bit FrameOfReference segments
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Long, true);
+  column_definitions.emplace_back("b", DataType::Int, false);
+  column_definitions.emplace_back("c", DataType::Double, true);
+  column_definitions.emplace_back("d", DataType::Float, false);
+
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data, 300);
+  for (auto index = 0; index < 700; ++index) {
+    // Some values do not fit into the frame of their block and are stored as exceptions
+    const auto long_value =
+        index % 97 == 5 ? std::numeric_limits<int64_t>::min() : int64_t{10'000'000'000} + index * int64_t{3};
+    const auto double_value = index % 50 == 0 ? 1.0 / 3.0 : index * 0.25;
+    table->append({index % 7 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{long_value}, 1'000 - index * index,
+                   index % 11 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{double_value},
+                   static_cast<float>(index) / 10.0f});
+  }
+
+  table->last_chunk()->finalize();
+  const auto chunk_encoding_spec =
+      ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::FrameOfReference, VectorCompressionType::BitPacking},
+                        SegmentEncodingSpec{EncodingType::Delta, VectorCompressionType::FixedWidthInteger},
+                        SegmentEncodingSpec{EncodingType::ALP, VectorCompressionType::BitPacking},
+                        SegmentEncodingSpec{EncodingType::ALP, VectorCompressionType::FixedWidthInteger}};
+  ChunkEncoder::encode_all_chunks(table, chunk_encoding_spec);
+  BinaryWriter::write(*table, filename);
+
+  const auto parsed_table = BinaryParser::parse(filename);
+  EXPECT_TABLE_EQ_ORDERED(parsed_table, table);
+
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    const auto& parsed_segment = parsed_table->get_chunk(ChunkID{0})->get_segment(column_id);
+    const auto encoded_segment = std::dynamic_pointer_cast<AbstractEncodedSegment>(parsed_segment);
+    ASSERT_TRUE(encoded_segment);
+    EXPECT_EQ(encoded_segment->encoding_type(), chunk_encoding_spec[column_id].encoding_type);
+  }
+}
+
 TEST_F(BinaryWriterTest, SortColumnDefinitions) {
   TableColumnDefinitions column_definitions;
   column_definitions.emplace_back("a", DataType::Int, false);
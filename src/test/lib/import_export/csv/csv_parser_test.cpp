@@ -5,6 +5,7 @@
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/base_dictionary_segment.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -304,4 +305,25 @@ TEST_F(CsvParserTest, FinalizedChunks) {
   EXPECT_FALSE(table->get_chunk(ChunkID{2})->is_mutable());
 }
 
+TEST_F(CsvParserTest, EncodedChunks) {
+  const auto table = CsvParser::parse("resources/test_data/csv/float_int_large.csv", ChunkOffset{20}, std::nullopt,
+                                      SegmentEncodingSpec{EncodingType::Dictionary});
+  EXPECT_TABLE_EQ_ORDERED(table, CsvParser::parse("resources/test_data/csv/float_int_large.csv", ChunkOffset{20}));
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    EXPECT_FALSE(chunk->is_mutable());
+    for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+      EXPECT_TRUE(std::dynamic_pointer_cast<const BaseDictionarySegment>(chunk->get_segment(column_id)));
+    }
+  }
+}
+
+TEST_F(CsvParserTest, EncodingNotSupportedByDataType) {
+  const auto table = CsvParser::parse("resources/test_data/csv/string.csv", Chunk::DEFAULT_SIZE, std::nullopt,
+                                      SegmentEncodingSpec{EncodingType::FrameOfReference});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const ValueSegment<pmr_string>>(
+      table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+}
+
 }  // namespace opossum
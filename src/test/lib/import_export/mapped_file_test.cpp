@@ -0,0 +1,44 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "import_export/mapped_file.hpp"
+
+namespace opossum {
+
+class MappedFileTest : public BaseTest {
+ protected:
+  void SetUp() override { std::remove(filename.c_str()); }
+
+  void TearDown() override { std::remove(filename.c_str()); }
+
+  const std::string filename = test_data_path + "mapped_file_test.txt";
+};
+
+TEST_F(MappedFileTest, MapsFileContent) {
+  {
+    auto file = std::ofstream{filename};
+    file << "first line\nsecond line";
+  }
+
+  const auto mapped_file = MappedFile{filename};
+  mapped_file.advise_sequential_access();
+  EXPECT_EQ(mapped_file.size(), 22);
+  EXPECT_EQ(mapped_file.view(), "first line\nsecond line");
+}
+
+TEST_F(MappedFileTest, EmptyFile) {
+  { auto file = std::ofstream{filename}; }
+
+  const auto mapped_file = MappedFile{filename};
+  EXPECT_EQ(mapped_file.size(), 0);
+  EXPECT_TRUE(mapped_file.view().empty());
+}
+
+TEST_F(MappedFileTest, MissingFile) {
+  EXPECT_THROW(MappedFile{"this_file_does_not_exist"}, std::logic_error);
+}
+
+}  // namespace opossum
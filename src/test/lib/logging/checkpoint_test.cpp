@@ -0,0 +1,134 @@
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "logging/checkpoint.hpp"
+#include "storage/base_dictionary_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class CheckpointTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove_all(directory);
+
+    table = load_table("resources/test_data/tbl/int_float.tbl", ChunkOffset{2});
+    Hyrise::get().storage_manager.add_table("table_a", table);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory); }
+
+  static std::shared_ptr<const Table> select_all() {
+    auto pipeline = SQLPipelineBuilder{std::string{"SELECT * FROM table_a"}}.create_pipeline();
+    return pipeline.get_result_table().second;
+  }
+
+  std::shared_ptr<Table> table;
+  const std::filesystem::path directory = test_data_path + "checkpoint_test";
+};
+
+TEST_F(CheckpointTest, WriteAndLoad) {
+  ChunkEncoder::encode_chunks(table, {ChunkID{0}}, SegmentEncodingSpec{EncodingType::Dictionary});
+  table->get_chunk(ChunkID{0})->set_individually_sorted_by(SortColumnDefinition{ColumnID{0}, SortMode::Descending});
+
+  auto pipeline = SQLPipelineBuilder{std::string{"DELETE FROM table_a WHERE a = 12345"}}.create_pipeline();
+  pipeline.get_result_table();
+
+  const auto expected_table = select_all();
+  const auto snapshot_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  Checkpoint{}.write(directory, snapshot_commit_id);
+
+  EXPECT_TRUE(std::filesystem::exists(directory / Checkpoint::MANIFEST_FILE_NAME));
+  EXPECT_FALSE(std::filesystem::exists(directory.string() + ".tmp"));
+
+  Hyrise::reset();
+  EXPECT_EQ(Checkpoint::load(directory), snapshot_commit_id);
+
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+
+  // The physical layout is preserved, including encodings and sort orders.
+  const auto loaded_table = Hyrise::get().storage_manager.get_table("table_a");
+  ASSERT_EQ(loaded_table->chunk_count(), table->chunk_count());
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    const auto loaded_chunk = loaded_table->get_chunk(chunk_id);
+    EXPECT_EQ(loaded_chunk->size(), chunk->size());
+    EXPECT_EQ(loaded_chunk->is_mutable(), chunk->is_mutable());
+    EXPECT_EQ(loaded_chunk->invalid_row_count(), chunk->invalid_row_count());
+  }
+  EXPECT_EQ(loaded_table->get_chunk(ChunkID{0})->individually_sorted_by(),
+            table->get_chunk(ChunkID{0})->individually_sorted_by());
+  EXPECT_TRUE(std::dynamic_pointer_cast<const BaseDictionarySegment>(
+      loaded_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+}
+
+TEST_F(CheckpointTest, UncommittedRowsAreNotVisible) {
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto pipeline = SQLPipelineBuilder{std::string{"INSERT INTO table_a VALUES (1, 2.0)"}}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+
+  const auto expected_table = select_all();
+  Checkpoint{}.write(directory, Hyrise::get().transaction_manager.last_commit_id());
+  transaction_context->rollback(RollbackReason::User);
+
+  Hyrise::reset();
+  Checkpoint::load(directory);
+
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+  EXPECT_EQ(Hyrise::get().storage_manager.get_table("table_a")->row_count(), table->row_count());
+}
+
+TEST_F(CheckpointTest, RemovedChunks) {
+  // Delete all rows of the first chunk so that it can be removed.
+  auto pipeline = SQLPipelineBuilder{std::string{"DELETE FROM table_a WHERE a = 12345 OR a = 123"}}.create_pipeline();
+  pipeline.get_result_table();
+  ASSERT_EQ(table->get_chunk(ChunkID{0})->invalid_row_count(), 2);
+  table->remove_chunk(ChunkID{0});
+
+  const auto expected_table = select_all();
+  Checkpoint{}.write(directory, Hyrise::get().transaction_manager.last_commit_id());
+
+  Hyrise::reset();
+  Checkpoint::load(directory);
+
+  const auto loaded_table = Hyrise::get().storage_manager.get_table("table_a");
+  EXPECT_EQ(loaded_table->chunk_count(), table->chunk_count());
+  EXPECT_FALSE(loaded_table->get_chunk(ChunkID{0}));
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+}
+
+TEST_F(CheckpointTest, UnchangedChunksAreNotWrittenAgain) {
+  const auto second_directory = std::filesystem::path{test_data_path + "checkpoint_test_2"};
+  std::filesystem::remove_all(second_directory);
+
+  auto checkpoint = Checkpoint{};
+  checkpoint.write(directory, Hyrise::get().transaction_manager.last_commit_id());
+
+  // Deleting rows only changes the MVCC data, which is stored in the manifest. Re-encoding changes the segments.
+  auto pipeline = SQLPipelineBuilder{std::string{"DELETE FROM table_a WHERE a = 12345"}}.create_pipeline();
+  pipeline.get_result_table();
+  ChunkEncoder::encode_chunks(table, {ChunkID{1}}, SegmentEncodingSpec{EncodingType::RunLength});
+
+  const auto expected_table = select_all();
+  checkpoint.write(second_directory, Hyrise::get().transaction_manager.last_commit_id());
+
+  EXPECT_EQ(std::filesystem::hard_link_count(second_directory / "0_0.bin"), 2);
+  EXPECT_EQ(std::filesystem::hard_link_count(second_directory / "0_1.bin"), 1);
+
+  // Removing the previous checkpoint does not affect the new one.
+  std::filesystem::remove_all(directory);
+  Hyrise::reset();
+  Checkpoint::load(second_directory);
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+
+  std::filesystem::remove_all(second_directory);
+}
+
+}  // namespace opossum
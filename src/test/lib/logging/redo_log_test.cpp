@@ -0,0 +1,147 @@
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "logging/redo_log.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class RedoLogTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove_all(directory);
+
+    auto column_definitions = TableColumnDefinitions{};
+    column_definitions.emplace_back("a", DataType::Int, false);
+    column_definitions.emplace_back("b", DataType::String, true);
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{3}, UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table("table_a", table);
+
+    execute("INSERT INTO table_a VALUES (1, 'one'), (2, NULL)");
+  }
+
+  void TearDown() override {
+    Hyrise::get().redo_log = nullptr;
+    std::filesystem::remove_all(directory);
+  }
+
+  static void execute(const std::string& sql) {
+    auto pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    const auto [status, _] = pipeline.get_result_table();
+    ASSERT_EQ(status, SQLPipelineStatus::Success);
+  }
+
+  static std::shared_ptr<const Table> select_all() {
+    auto pipeline = SQLPipelineBuilder{std::string{"SELECT * FROM table_a"}}.create_pipeline();
+    return pipeline.get_result_table().second;
+  }
+
+  // Simulates a restart of the database: the in-memory state is lost, only the log directory remains.
+  void restart_and_recover() {
+    Hyrise::reset();
+    Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+    Hyrise::get().redo_log->recover();
+  }
+
+  const std::filesystem::path directory = test_data_path + "redo_log_test";
+};
+
+TEST_F(RedoLogTest, RecoversCheckpointAndLoggedTransactions) {
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+  Hyrise::get().redo_log->checkpoint();
+
+  // Fill the mutable chunk, append new chunks, and delete rows of the checkpointed and of the logged data.
+  execute("INSERT INTO table_a VALUES (3, 'three'), (4, 'four'), (5, NULL)");
+  execute("DELETE FROM table_a WHERE a = 1");
+  execute("UPDATE table_a SET b = 'FOUR' WHERE a = 4");
+
+  const auto expected_table = select_all();
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+
+  restart_and_recover();
+
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), last_commit_id);
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+
+  // The recovered database accepts and logs new transactions.
+  execute("INSERT INTO table_a VALUES (6, 'six')");
+  const auto expected_table_after_insert = select_all();
+
+  restart_and_recover();
+
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table_after_insert);
+}
+
+TEST_F(RedoLogTest, RolledBackTransactionsAreNotRecovered) {
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+  Hyrise::get().redo_log->checkpoint();
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto pipeline = SQLPipelineBuilder{std::string{"INSERT INTO table_a VALUES (7, 'seven')"}}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+  transaction_context->rollback(RollbackReason::User);
+
+  execute("INSERT INTO table_a VALUES (8, 'eight')");
+  const auto expected_table = select_all();
+
+  restart_and_recover();
+
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+  EXPECT_EQ(select_all()->row_count(), 3);
+}
+
+TEST_F(RedoLogTest, TornRecordIsIgnored) {
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+  Hyrise::get().redo_log->checkpoint();
+
+  execute("INSERT INTO table_a VALUES (3, 'three')");
+  const auto expected_table = select_all();
+
+  Hyrise::get().redo_log = nullptr;
+
+  // Append the beginning of a record as it would be left behind by a crash during a write.
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if (!entry.is_regular_file()) continue;
+    const auto torn_record = std::array<char, 6>{0x40, 0x00, 0x00, 0x00, 0x12, 0x34};
+    auto log_file = std::ofstream{entry.path(), std::ios::binary | std::ios::app};
+    log_file.write(torn_record.data(), torn_record.size());
+  }
+
+  restart_and_recover();
+
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+}
+
+TEST_F(RedoLogTest, CheckpointRemovesObsoleteLogFiles) {
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+  execute("INSERT INTO table_a VALUES (3, 'three')");
+  Hyrise::get().redo_log->checkpoint();
+  execute("INSERT INTO table_a VALUES (4, 'four')");
+  Hyrise::get().redo_log->checkpoint();
+
+  auto log_file_count = size_t{0};
+  auto checkpoint_count = size_t{0};
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    const auto file_name = entry.path().filename().string();
+    if (file_name.starts_with(RedoLog::LOG_FILE_PREFIX)) ++log_file_count;
+    if (file_name.starts_with(RedoLog::CHECKPOINT_PREFIX)) ++checkpoint_count;
+  }
+
+  // Only the log file opened by the last checkpoint and the last checkpoint remain.
+  EXPECT_EQ(log_file_count, 1);
+  EXPECT_EQ(checkpoint_count, 1);
+
+  const auto expected_table = select_all();
+  restart_and_recover();
+  EXPECT_TABLE_EQ_UNORDERED(select_all(), expected_table);
+}
+
+}  // namespace opossum
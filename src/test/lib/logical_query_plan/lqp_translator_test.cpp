@@ -50,6 +50,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_all.hpp"
 #include "operators/union_positions.hpp"
 #include "storage/chunk_encoder.hpp"
@@ -748,6 +749,29 @@ TEST_F(LQPTranslatorTest, LimitNode) {
   EXPECT_EQ(*limit_op->row_count_expression(), *value_(2));
 }
 
+TEST_F(LQPTranslatorTest, LimitOnSortNode) {
+  const auto sort_modes = std::vector<SortMode>({SortMode::Descending, SortMode::Ascending});
+
+  // clang-format off
+  const auto lqp =
+  LimitNode::make(value_(5),
+    SortNode::make(expression_vector(int_float_b, int_float_a), sort_modes,
+      int_float_node));
+  // clang-format on
+
+  const auto top_k = std::dynamic_pointer_cast<const TopK>(LQPTranslator{}.translate_node(lqp));
+  ASSERT_TRUE(top_k);
+  EXPECT_EQ(*top_k->row_count_expression(), *value_(5));
+
+  ASSERT_EQ(top_k->sort_definitions().size(), 2u);
+  EXPECT_EQ(top_k->sort_definitions().at(0).column, ColumnID{1});
+  EXPECT_EQ(top_k->sort_definitions().at(0).sort_mode, SortMode::Descending);
+  EXPECT_EQ(top_k->sort_definitions().at(1).column, ColumnID{0});
+  EXPECT_EQ(top_k->sort_definitions().at(1).sort_mode, SortMode::Ascending);
+
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(top_k->left_input()));
+}
+
 TEST_F(LQPTranslatorTest, DiamondShapeSimple) {
   /**
    * Test that
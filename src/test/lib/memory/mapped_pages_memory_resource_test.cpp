@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "import_export/mapped_file.hpp"
+#include "memory/mapped_pages_memory_resource.hpp"
+
+namespace opossum {
+
+class MappedPagesMemoryResourceTest : public BaseTest {
+ protected:
+  void SetUp() override { std::remove(filename.c_str()); }
+
+  void TearDown() override { std::remove(filename.c_str()); }
+
+  const std::string filename = test_data_path + "mapped_pages_memory_resource_test.bin";
+};
+
+TEST_F(MappedPagesMemoryResourceTest, AllocatesPageAlignedBuffers) {
+  auto& resource = MappedPagesMemoryResource::get();
+  auto values = pmr_vector<int32_t>(1'000, PolymorphicAllocator<int32_t>{&resource});
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(values.data()) % MappedPagesMemoryResource::page_size(), 0);
+
+  std::iota(values.begin(), values.end(), 0);
+  values.resize(100'000, 7);
+  EXPECT_EQ(values[999], 999);
+  EXPECT_EQ(values[99'999], 7);
+}
+
+TEST_F(MappedPagesMemoryResourceTest, MapsFilePages) {
+  const auto page_size = MappedPagesMemoryResource::page_size();
+  const auto value_count = 3 * page_size / sizeof(int32_t);
+
+  // The values start at the second page of the file.
+  auto file_values = std::vector<int32_t>(page_size / sizeof(int32_t) + value_count);
+  std::iota(file_values.begin(), file_values.end(), 0);
+  {
+    auto file = std::ofstream{filename, std::ios::binary};
+    file.write(reinterpret_cast<const char*>(file_values.data()), file_values.size() * sizeof(int32_t));
+  }
+
+  auto& resource = MappedPagesMemoryResource::get();
+  auto values = pmr_vector<int32_t>(value_count, PolymorphicAllocator<int32_t>{&resource});
+  {
+    const auto mapped_file = MappedFile{filename};
+    resource.map_file_pages(values.data(), value_count * sizeof(int32_t), mapped_file.file_descriptor(), page_size);
+  }
+
+  // The mapping outlives the MappedFile and writes do not reach the file.
+  EXPECT_EQ(values.front(), static_cast<int32_t>(page_size / sizeof(int32_t)));
+  EXPECT_EQ(values.back(), file_values.back());
+  values.front() = -1;
+
+  const auto mapped_file = MappedFile{filename};
+  EXPECT_EQ(reinterpret_cast<const int32_t*>(mapped_file.data())[page_size / sizeof(int32_t)],
+            file_values[page_size / sizeof(int32_t)]);
+}
+
+TEST_F(MappedPagesMemoryResourceTest, RejectsUnalignedFileOffsets) {
+  {
+    auto file = std::ofstream{filename, std::ios::binary};
+    file << "unaligned";
+  }
+
+  auto& resource = MappedPagesMemoryResource::get();
+  auto values = pmr_vector<char>(9, PolymorphicAllocator<char>{&resource});
+  const auto mapped_file = MappedFile{filename};
+  EXPECT_THROW(resource.map_file_pages(values.data(), 8, mapped_file.file_descriptor(), 1), std::logic_error);
+}
+
+}  // namespace opossum
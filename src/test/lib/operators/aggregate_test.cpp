@@ -2,6 +2,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <random>
 #include <set>
 #include <string>
 #include <utility>
@@ -10,6 +11,7 @@
 #include "base_test.hpp"
 
 #include "expression/aggregate_expression.hpp"
+#include "hyrise.hpp"
 #include "operators/abstract_read_only_operator.hpp"
 #include "operators/aggregate_hash.hpp"
 #include "operators/aggregate_sort.hpp"
@@ -18,6 +20,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
@@ -894,4 +897,133 @@ TYPED_TEST(OperatorsAggregateTest, StringVariations) {
   EXPECT_EQ(values_sorted, result_values_sorted);
 }
 
+class OperatorsAggregateHashTest : public BaseTest {};
+
+TEST_F(OperatorsAggregateHashTest, ManyGroupsInManyChunks) {
+  // The groups are pre-aggregated per chunk and merged in multiple radix partitions. Compare the results of all
+  // aggregate functions with those of the AggregateSort for a sparse integer key, a dense integer key (which uses
+  // immediate keys), a string key, and multiple GROUP BY columns.
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto row_count = 100'000;
+  const auto column_definitions = TableColumnDefinitions{{"sparse", DataType::Int, false},
+                                                         {"dense", DataType::Int, false},
+                                                         {"string", DataType::String, false},
+                                                         {"long", DataType::Long, true},
+                                                         {"double", DataType::Double, false}};
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{1'000});
+
+  auto random_engine = std::mt19937{42};
+  auto key_distribution = std::uniform_int_distribution<int32_t>{0, 40'000};
+  auto value_distribution = std::uniform_int_distribution<int64_t>{-1'000, 1'000};
+  for (auto row_id = 0; row_id < row_count; ++row_id) {
+    const auto key = key_distribution(random_engine);
+    const auto value = value_distribution(random_engine);
+    const auto long_value = value % 7 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{value};
+    table->append({key * 7, (row_id * 3) % 40'000, pmr_string{"key" + std::to_string(key % 5'000)}, long_value,
+                   static_cast<double>(value) / 100.0});
+  }
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto long_column = pqp_column_(ColumnID{3}, DataType::Long, true, "long");
+  const auto double_column = pqp_column_(ColumnID{4}, DataType::Double, false, "double");
+  const auto string_column = pqp_column_(ColumnID{2}, DataType::String, false, "string");
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      min_(long_column),
+      max_(string_column),
+      sum_(double_column),
+      avg_(long_column),
+      count_(long_column),
+      count_distinct_(long_column),
+      std::make_shared<AggregateExpression>(AggregateFunction::Count,
+                                            pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*")),
+      standard_deviation_sample_(double_column)};
+
+  for (const auto& groupby_column_ids :
+       std::vector<std::vector<ColumnID>>{{ColumnID{0}}, {ColumnID{1}}, {ColumnID{2}}, {ColumnID{0}, ColumnID{2}}}) {
+    const auto aggregate_hash = std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby_column_ids);
+    aggregate_hash->execute();
+    const auto aggregate_sort = std::make_shared<AggregateSort>(table_wrapper, aggregates, groupby_column_ids);
+    aggregate_sort->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(aggregate_hash->get_output(), aggregate_sort->get_output());
+  }
+
+  // DISTINCT
+  const auto aggregate_hash = std::make_shared<AggregateHash>(
+      table_wrapper, std::vector<std::shared_ptr<AggregateExpression>>{}, std::vector<ColumnID>{ColumnID{0}});
+  aggregate_hash->execute();
+  const auto aggregate_sort = std::make_shared<AggregateSort>(
+      table_wrapper, std::vector<std::shared_ptr<AggregateExpression>>{}, std::vector<ColumnID>{ColumnID{0}});
+  aggregate_sort->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate_hash->get_output(), aggregate_sort->get_output());
+}
+
+TEST_F(OperatorsAggregateHashTest, SpillToDisk) {
+  // With a tiny memory budget, the partial results are spilled to one file per partition and merged from there. The
+  // results must match those of an AggregateHash without a budget.
+  const auto column_definitions = TableColumnDefinitions{{"sparse", DataType::Int, false},
+                                                         {"dense", DataType::Int, false},
+                                                         {"string", DataType::String, false},
+                                                         {"long", DataType::Long, true}};
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{1'000});
+
+  auto random_engine = std::mt19937{42};
+  auto key_distribution = std::uniform_int_distribution<int32_t>{0, 5'000};
+  auto value_distribution = std::uniform_int_distribution<int64_t>{-1'000, 1'000};
+  for (auto row_id = 0; row_id < 20'000; ++row_id) {
+    const auto key = key_distribution(random_engine);
+    const auto value = value_distribution(random_engine);
+    const auto long_value = value % 7 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{value};
+    table->append({key * 7, row_id % 5'000, pmr_string{"key" + std::to_string(key % 2'000)}, long_value});
+  }
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto long_column = pqp_column_(ColumnID{3}, DataType::Long, true, "long");
+  const auto string_column = pqp_column_(ColumnID{2}, DataType::String, false, "string");
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      min_(string_column), sum_(long_column), count_distinct_(long_column), standard_deviation_sample_(long_column)};
+
+  const auto memory_budget = size_t{16'384};
+  for (const auto& groupby_column_ids :
+       std::vector<std::vector<ColumnID>>{{ColumnID{0}}, {ColumnID{1}}, {ColumnID{2}}, {ColumnID{0}, ColumnID{2}}}) {
+    const auto expected = std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby_column_ids);
+    expected->execute();
+    const auto aggregate_hash =
+        std::make_shared<AggregateHash>(table_wrapper, aggregates, groupby_column_ids, memory_budget);
+    aggregate_hash->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(aggregate_hash->get_output(), expected->get_output());
+
+    const auto& performance_data =
+        static_cast<const AggregateHash::PerformanceData&>(*aggregate_hash->performance_data);
+    EXPECT_GT(performance_data.spilled_partition_count, 1);
+    EXPECT_GT(performance_data.spilled_bytes, 0);
+
+    // Every merged partition is written to its own chunk
+    EXPECT_GT(aggregate_hash->get_output()->chunk_count(), 1);
+    EXPECT_EQ(expected->get_output()->chunk_count(), 1);
+
+    // Without a budget, nothing is spilled
+    const auto& expected_performance_data =
+        static_cast<const AggregateHash::PerformanceData&>(*expected->performance_data);
+    EXPECT_EQ(expected_performance_data.spilled_partition_count, 0);
+  }
+
+  // DISTINCT
+  const auto expected = std::make_shared<AggregateHash>(
+      table_wrapper, std::vector<std::shared_ptr<AggregateExpression>>{}, std::vector<ColumnID>{ColumnID{2}});
+  expected->execute();
+  const auto aggregate_hash =
+      std::make_shared<AggregateHash>(table_wrapper, std::vector<std::shared_ptr<AggregateExpression>>{},
+                                      std::vector<ColumnID>{ColumnID{2}}, memory_budget);
+  aggregate_hash->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate_hash->get_output(), expected->get_output());
+}
+
 }  // namespace opossum
@@ -137,6 +137,40 @@ TEST_F(OperatorsInsertTest, CompressedChunks) {
   EXPECT_EQ(table->row_count(), 13u);
 }
 
+TEST_F(OperatorsInsertTest, FreshChunks) {
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                       ChunkOffset{4}, UseMvcc::Yes);
+  table->append({1});
+  table->append({2});
+  table->append({3});
+  Hyrise::get().storage_manager.add_table("target", table);
+
+  // 3 Rows
+  Hyrise::get().storage_manager.add_table("source", load_table("resources/test_data/tbl/int.tbl"));
+
+  const auto insert = [](const InsertChunkAllocation chunk_allocation) {
+    auto get_table = std::make_shared<GetTable>("source");
+    get_table->execute();
+
+    auto insert = std::make_shared<Insert>("target", get_table, chunk_allocation);
+    auto context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    insert->set_transaction_context(context);
+    insert->execute();
+    context->commit();
+  };
+
+  // The fresh chunk is appended although the last chunk has space left. The following Insert does not write to the
+  // fresh chunk either.
+  insert(InsertChunkAllocation::FreshChunks);
+  insert(InsertChunkAllocation::LastChunk);
+
+  ASSERT_EQ(table->chunk_count(), 3u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->size(), 3u);
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->size(), 3u);
+  EXPECT_EQ(table->get_chunk(ChunkID{2})->size(), 3u);
+  EXPECT_EQ(table->row_count(), 9u);
+}
+
 TEST_F(OperatorsInsertTest, Rollback) {
   auto table_name = "test3";
 
@@ -0,0 +1,45 @@
+#include <functional>
+
+#include "base_test.hpp"
+
+#include "operators/join_hash/bloom_filter.hpp"
+
+namespace opossum {
+
+class BloomFilterTest : public BaseTest {};
+
+TEST_F(BloomFilterTest, Size) {
+  EXPECT_TRUE(BloomFilter{}.empty());
+  EXPECT_EQ(BloomFilter{}.size(), 0);
+
+  // The size is rounded up to a power of two and clamped
+  EXPECT_EQ(BloomFilter{0}.size(), BloomFilter::MIN_SIZE);
+  EXPECT_EQ(BloomFilter{1'000}.size(), 8'192);
+  EXPECT_EQ(BloomFilter{1'024}.size(), 1'024 * BloomFilter::BITS_PER_VALUE);
+  EXPECT_EQ(BloomFilter{size_t{1} << 30}.size(), BloomFilter::MAX_SIZE);
+  EXPECT_FALSE(BloomFilter{0}.empty());
+}
+
+TEST_F(BloomFilterTest, InsertAndContains) {
+  const auto value_count = 10'000;
+  auto bloom_filter = BloomFilter{value_count};
+
+  const auto hash_function = std::hash<int32_t>{};
+  for (auto value = 0; value < value_count; ++value) {
+    bloom_filter.insert(hash_function(value * 2));
+  }
+
+  // No false negatives
+  for (auto value = 0; value < value_count; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(hash_function(value * 2)));
+  }
+
+  // Few false positives, even though the hash function is the identity for integers
+  auto false_positive_count = 0;
+  for (auto value = 0; value < value_count; ++value) {
+    false_positive_count += bloom_filter.contains(hash_function(value * 2 + 1));
+  }
+  EXPECT_LT(false_positive_count, value_count / 20);
+}
+
+}  // namespace opossum
@@ -160,21 +160,33 @@ TEST_F(JoinHashStepsTest, MaterializeAndBuildWithKeepNulls) {
 TEST_F(JoinHashStepsTest, MaterializeOutputBloomFilter) {
   {
     std::vector<std::vector<size_t>> histograms;  // Ignored in this test
-    BloomFilter bloom_filter;
+    BloomFilter bloom_filter{100};
 
     materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0}, histograms, 1,
                                        bloom_filter);
 
-    // For all input values, their position in the bloom filter should be correctly set to true
+    // All input values should be contained in the Bloom filter
     for (auto value : std::vector<int>{0, 6, 7, 9, 13, 18}) {
-      EXPECT_TRUE(bloom_filter[value]);
+      EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(value)));
+    }
 
-      // Set to false for easier checking of the values that should be false
-      bloom_filter[value] = false;
+    // Whether a specific value that was not inserted is a false positive depends on the hash function. With six values
+    // in a filter of BloomFilter::MIN_SIZE bits, the false positive rate should be far below one percent, though.
+    auto false_positive_count = size_t{0};
+    for (auto value = 1'000; value < 11'000; ++value) {
+      false_positive_count += bloom_filter.contains(std::hash<int>{}(value));
     }
+    EXPECT_LT(false_positive_count, 100);
+  }
+
+  {
+    // An empty Bloom filter is not filled
+    std::vector<std::vector<size_t>> histograms;  // Ignored in this test
+    BloomFilter bloom_filter;
 
-    // All other slots should be false
-    EXPECT_EQ(bloom_filter, BloomFilter{BLOOM_FILTER_SIZE});
+    materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0}, histograms, 1,
+                                       bloom_filter);
+    EXPECT_TRUE(bloom_filter.empty());
   }
 }
 
@@ -184,9 +196,9 @@ TEST_F(JoinHashStepsTest, MaterializeInputBloomFilter) {
     BloomFilter output_bloom_filter;
 
     // Fill input_bloom_filter
-    BloomFilter input_bloom_filter(BLOOM_FILTER_SIZE);
+    BloomFilter input_bloom_filter{100};
     for (auto value : std::vector<int>{6, 7, 9}) {
-      input_bloom_filter[value] = true;
+      input_bloom_filter.insert(std::hash<int>{}(value));
     }
 
     auto container = materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
@@ -210,6 +222,21 @@ TEST_F(JoinHashStepsTest, MaterializeInputBloomFilter) {
   }
 }
 
+TEST_F(JoinHashStepsTest, BloomFilterPassRate) {
+  const auto& table = *_table_with_nulls_and_zeros->get_output();
+
+  BloomFilter bloom_filter{100};
+  for (auto value : std::vector<int>{0, 6, 7, 9, 13, 18}) {
+    bloom_filter.insert(std::hash<int>{}(value));
+  }
+  EXPECT_EQ((bloom_filter_pass_rate<int, int>(table, ColumnID{0}, bloom_filter)), 1.0);
+
+  // Three out of the nine non-NULL values are 7. NULL values are not sampled.
+  BloomFilter selective_bloom_filter{100};
+  selective_bloom_filter.insert(std::hash<int>{}(7));
+  EXPECT_DOUBLE_EQ((bloom_filter_pass_rate<int, int>(table, ColumnID{0}, selective_bloom_filter)), 3.0 / 9.0);
+}
+
 TEST_F(JoinHashStepsTest, MaterializeInputHistograms) {
   {
     std::vector<std::vector<size_t>> histograms;
@@ -279,14 +306,48 @@ TEST_F(JoinHashStepsTest, RadixClusteringOfNulls) {
   }
 }
 
+TEST_F(JoinHashStepsTest, RadixClusteringRespectsBloomFilter) {
+  const size_t radix_bit_count = 1;
+  std::vector<std::vector<size_t>> histograms;
+  BloomFilter output_bloom_filter;  // Ignored in this test
+
+  BloomFilter input_bloom_filter{100};
+  for (auto value : std::vector<int>{7, 9}) {
+    input_bloom_filter.insert(std::hash<int>{}(value));
+  }
+
+  const auto materialized = materialize_input<int, int, true>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
+                                                              histograms, radix_bit_count, output_bloom_filter);
+  const auto radix_cluster_result =
+      partition_by_radix<int, int, true>(materialized, histograms, radix_bit_count, input_bloom_filter);
+
+  // Values that are not contained in the Bloom filter are dropped, NULL values are kept
+  auto values = std::vector<int>{};
+  auto null_value_count = size_t{0};
+  for (const auto& partition : radix_cluster_result) {
+    ASSERT_EQ(partition.null_values.size(), partition.elements.size());
+    for (auto element_idx = size_t{0}; element_idx < partition.elements.size(); ++element_idx) {
+      if (partition.null_values[element_idx]) {
+        ++null_value_count;
+      } else {
+        values.emplace_back(partition.elements[element_idx].value);
+      }
+    }
+  }
+  std::sort(values.begin(), values.end());
+
+  EXPECT_EQ(values, std::vector<int>({7, 7, 7, 9, 9}));
+  EXPECT_EQ(null_value_count, 2);
+}
+
 TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter) {
   std::vector<std::vector<size_t>> histograms;  // Ignored in this test
   BloomFilter output_bloom_filter;              // Ignored in this test
 
   // Fill input_bloom_filter
-  BloomFilter input_bloom_filter(BLOOM_FILTER_SIZE);
+  BloomFilter input_bloom_filter{100};
   for (auto value : std::vector<int>{6, 7, 9}) {
-    input_bloom_filter[value] = true;
+    input_bloom_filter.insert(std::hash<int>{}(value));
   }
 
   auto container = materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
@@ -305,6 +366,37 @@ TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter) {
   EXPECT_FALSE(hash_table->contains(18));
 }
 
+TEST_F(JoinHashStepsTest, SplitProbePartitions) {
+  // Seven partitions with 1'000 elements, one heavy partition with 100'000 elements, and an empty partition
+  auto radix_container = RadixContainer<int>(9);
+  for (auto partition_idx = size_t{0}; partition_idx < 7; ++partition_idx) {
+    radix_container[partition_idx].elements.resize(1'000);
+  }
+  radix_container[8].elements.resize(100'000);
+
+  const auto probe_ranges = split_probe_partitions(radix_container);
+
+  // The average size of the non-empty partitions is 13'375. Only the heavy partition exceeds four times that size. It
+  // is split into eight ranges.
+  ASSERT_EQ(probe_ranges.size(), 15);
+  for (auto range_idx = size_t{0}; range_idx < 7; ++range_idx) {
+    EXPECT_EQ(probe_ranges[range_idx].partition_idx, range_idx);
+    EXPECT_EQ(probe_ranges[range_idx].begin, 0);
+    EXPECT_EQ(probe_ranges[range_idx].end, 1'000);
+  }
+
+  auto expected_begin = size_t{0};
+  for (auto range_idx = size_t{7}; range_idx < probe_ranges.size(); ++range_idx) {
+    EXPECT_EQ(probe_ranges[range_idx].partition_idx, 8);
+    EXPECT_EQ(probe_ranges[range_idx].begin, expected_begin);
+    EXPECT_LE(probe_ranges[range_idx].end - probe_ranges[range_idx].begin, 13'375);
+    expected_begin = probe_ranges[range_idx].end;
+  }
+  EXPECT_EQ(expected_begin, 100'000);
+
+  EXPECT_TRUE(split_probe_partitions(RadixContainer<int>(4)).empty());
+}
+
 TEST_F(JoinHashStepsTest, ThrowWhenNoNullValuesArePassed) {
   if (!HYRISE_DEBUG) GTEST_SKIP();
 
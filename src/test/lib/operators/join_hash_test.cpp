@@ -1,7 +1,11 @@
 #include "base_test.hpp"
 
+#include "hyrise.hpp"
+#include "operators/get_table.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/operator_task.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -108,6 +112,99 @@ TEST_F(OperatorsJoinHashTest, DeepCopy) {
   EXPECT_NE(join_operator_copy->right_input(), nullptr);
 }
 
+TEST_F(OperatorsJoinHashTest, PushDownBloomFilters) {
+  Hyrise::get().storage_manager.add_table("int_int", load_table("resources/test_data/tbl/int_int_shuffled.tbl", 7));
+
+  const auto reducer_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+  reducer_table->append({4});
+  reducer_table->append({10});
+  reducer_table->append({11});
+
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+
+  {
+    // The Bloom filter of the reducer is applied in the scan of the semi join's left input
+    const auto scan = create_table_scan(std::make_shared<GetTable>("int_int"), ColumnID{1},
+                                        PredicateCondition::GreaterThan, 100);
+    const auto reducer = std::make_shared<TableWrapper>(reducer_table);
+    const auto semi_join = std::make_shared<JoinHash>(scan, reducer, JoinMode::Semi, primary_predicate);
+
+    JoinHash::push_down_bloom_filters(semi_join);
+    EXPECT_EQ(scan->runtime_bloom_filter_source(), reducer);
+
+    const auto copied_semi_join = semi_join->deep_copy();
+    const auto copied_scan = std::dynamic_pointer_cast<TableScan>(copied_semi_join->mutable_left_input());
+    ASSERT_TRUE(copied_scan);
+    EXPECT_EQ(copied_scan->runtime_bloom_filter_source(), copied_semi_join->mutable_right_input());
+
+    const auto& [tasks, root_operator_task] = OperatorTask::make_tasks_from_operator(semi_join);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+    EXPECT_EQ(semi_join->get_output()->row_count(), 4u);
+    const auto& performance_data = dynamic_cast<TableScan::PerformanceData&>(*scan->performance_data);
+    EXPECT_TRUE(performance_data.runtime_bloom_filter_applied);
+    EXPECT_EQ(performance_data.num_rows_pruned_by_runtime_bloom_filter.load(), 8u);
+  }
+
+  {
+    // Outer joins keep the rows without a join partner
+    const auto scan = create_table_scan(std::make_shared<GetTable>("int_int"), ColumnID{1},
+                                        PredicateCondition::GreaterThan, 100);
+    const auto left_join = std::make_shared<JoinHash>(scan, std::make_shared<TableWrapper>(reducer_table),
+                                                      JoinMode::Left, primary_predicate);
+
+    JoinHash::push_down_bloom_filters(left_join);
+    EXPECT_FALSE(scan->runtime_bloom_filter_source());
+  }
+
+  {
+    // The scan's output is consumed by another operator that requires all rows
+    const auto scan = create_table_scan(std::make_shared<GetTable>("int_int"), ColumnID{1},
+                                        PredicateCondition::GreaterThan, 100);
+    const auto other_consumer = create_table_scan(scan, ColumnID{0}, PredicateCondition::GreaterThan, 0);
+    const auto semi_join = std::make_shared<JoinHash>(scan, std::make_shared<TableWrapper>(reducer_table),
+                                                      JoinMode::Semi, primary_predicate);
+
+    JoinHash::push_down_bloom_filters(semi_join);
+    EXPECT_FALSE(scan->runtime_bloom_filter_source());
+  }
+}
+
+TEST_F(OperatorsJoinHashTest, SkewedProbeSide) {
+  // Most rows of the probe side share the same key. The partition holding this key is split across several jobs.
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}};
+  const auto probe_table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{10'000});
+  for (auto row_idx = 0; row_idx < 50'000; ++row_idx) {
+    probe_table->append({0});
+  }
+  for (auto value = 1; value <= 10'000; ++value) {
+    probe_table->append({value});
+  }
+
+  const auto build_table = std::make_shared<Table>(column_definitions, TableType::Data);
+  for (auto value = 0; value < 100; ++value) {
+    build_table->append({value});
+  }
+
+  const auto probe_input = std::make_shared<TableWrapper>(probe_table);
+  const auto build_input = std::make_shared<TableWrapper>(build_table);
+  probe_input->execute();
+  build_input->execute();
+
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+  const auto join = std::make_shared<JoinHash>(probe_input, build_input, JoinMode::Inner, primary_predicate,
+                                               std::vector<OperatorJoinPredicate>{}, 3);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 50'099);
+
+  const auto& performance_data = dynamic_cast<const JoinHash::PerformanceData&>(*join->performance_data);
+  EXPECT_FALSE(performance_data.left_input_is_build_side);
+  EXPECT_GE(performance_data.skewed_probe_partition_count, 1);
+  EXPECT_GT(performance_data.probe_range_count, 8);
+}
+
 TEST_F(OperatorsJoinHashTest, RadixBitCalculation) {
   // Simple tests to check that side switching and zero-sizes work.
   EXPECT_EQ(JoinHash::calculate_radix_bits(1, 0, JoinMode::Inner), 0ul);
@@ -58,4 +58,93 @@ TEST_F(OperatorsJoinNestedLoopTest, DeepCopy) {
   EXPECT_NE(join_operator_copy->right_input(), nullptr);
 }
 
+TEST_F(OperatorsJoinNestedLoopTest, BlockedJoinSpanningSeveralBlocks) {
+  // The inputs are larger than JoinNestedLoop::BLOCK_SIZE, so that the blocked join compares several blocks
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+  const auto left_table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{1'500});
+  const auto right_table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{700});
+  for (auto value = 0; value < 3'000; ++value) {
+    left_table->append({value % 7 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{value % 1'000}});
+  }
+  for (auto value = 0; value < 2'000; ++value) {
+    right_table->append({value % 5 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{value % 500}});
+  }
+
+  // Determine the expected number of matches by comparing all pairs
+  auto expected_inner_row_count = size_t{0};
+  auto expected_semi_row_count = size_t{0};
+  for (auto left_value = 0; left_value < 3'000; ++left_value) {
+    if (left_value % 7 == 0) {
+      continue;
+    }
+    auto match_count = size_t{0};
+    for (auto right_value = 0; right_value < 2'000; ++right_value) {
+      if (right_value % 5 != 0 && left_value % 1'000 < right_value % 500) {
+        ++match_count;
+      }
+    }
+    expected_inner_row_count += match_count;
+    expected_semi_row_count += match_count > 0 ? 1 : 0;
+  }
+
+  const auto left_input = std::make_shared<TableWrapper>(left_table);
+  const auto right_input = std::make_shared<TableWrapper>(right_table);
+  left_input->never_clear_output();
+  right_input->never_clear_output();
+  left_input->execute();
+  right_input->execute();
+
+  const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::LessThan};
+  const auto join_row_count = [&](const JoinMode mode) {
+    const auto join = std::make_shared<JoinNestedLoop>(left_input, right_input, mode, primary_predicate);
+    join->execute();
+    return join->get_output()->row_count();
+  };
+
+  EXPECT_EQ(join_row_count(JoinMode::Inner), expected_inner_row_count);
+  EXPECT_EQ(join_row_count(JoinMode::Semi), expected_semi_row_count);
+  EXPECT_EQ(join_row_count(JoinMode::AntiNullAsFalse), 3'000 - expected_semi_row_count);
+  EXPECT_EQ(join_row_count(JoinMode::Left), expected_inner_row_count + (3'000 - expected_semi_row_count));
+}
+
+TEST_F(OperatorsJoinNestedLoopTest, BandJoin) {
+  // `a.x >= b.lower AND a.x < b.upper` is evaluated IEJoin-style
+  const auto left_table = std::make_shared<Table>(TableColumnDefinitions{{"x", DataType::Int, true}}, TableType::Data,
+                                                  ChunkOffset{100});
+  const auto right_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"lower", DataType::Int, false}, {"upper", DataType::Int, true}}, TableType::Data,
+      ChunkOffset{30});
+  for (auto value = 0; value < 1'000; ++value) {
+    left_table->append({value % 11 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{value % 300}});
+  }
+  for (auto value = 0; value < 100; ++value) {
+    right_table->append({value * 3, value % 9 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{value * 3 + value}});
+  }
+
+  auto expected_row_count = size_t{0};
+  for (auto left_value = 0; left_value < 1'000; ++left_value) {
+    for (auto right_value = 0; right_value < 100; ++right_value) {
+      if (left_value % 11 != 0 && right_value % 9 != 0 && left_value % 300 >= right_value * 3 &&
+          left_value % 300 < right_value * 3 + right_value) {
+        ++expected_row_count;
+      }
+    }
+  }
+
+  const auto left_input = std::make_shared<TableWrapper>(left_table);
+  const auto right_input = std::make_shared<TableWrapper>(right_table);
+  left_input->execute();
+  right_input->execute();
+
+  const auto primary_predicate =
+      OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::GreaterThanEquals};
+  const auto secondary_predicates =
+      std::vector<OperatorJoinPredicate>{{{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThan}};
+  const auto join = std::make_shared<JoinNestedLoop>(left_input, right_input, JoinMode::Inner, primary_predicate,
+                                                     secondary_predicates);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), expected_row_count);
+}
+
 }  // namespace opossum
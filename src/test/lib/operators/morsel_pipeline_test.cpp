@@ -0,0 +1,159 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "operators/get_table.hpp"
+#include "operators/morsel_pipeline.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/union_all.hpp"
+#include "operators/validate.hpp"
+#include "scheduler/operator_task.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/reference_segment.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsMorselPipelineTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Four chunks, one of which does not contain any row with a > 200
+    table = load_table("resources/test_data/tbl/int_float4.tbl", 2);
+    Hyrise::get().storage_manager.add_table("table_a", table);
+
+    a = PQPColumnExpression::from_table(*table, "a");
+    b = PQPColumnExpression::from_table(*table, "b");
+
+    // Operators only hold a weak_ptr to their transaction context
+    transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  }
+
+  static std::shared_ptr<const Table> execute(const std::shared_ptr<AbstractOperator>& pqp) {
+    const auto& [tasks, root_operator_task] = OperatorTask::make_tasks_from_operator(pqp);
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+    return pqp->get_output();
+  }
+
+  static std::shared_ptr<const Table> execute_morsels(MorselPipeline& pipeline,
+                                                      const std::shared_ptr<TransactionContext>& transaction_context) {
+    return pipeline._on_execute(transaction_context);
+  }
+
+  // GetTable -> Validate -> TableScan(a > `value`) -> Projection(a, b + 1)
+  std::shared_ptr<AbstractOperator> create_pqp(const int32_t value) {
+    const auto get_table = std::make_shared<GetTable>("table_a");
+    const auto validate = std::make_shared<Validate>(get_table);
+    const auto table_scan = std::make_shared<TableScan>(validate, greater_than_(a, value));
+    const auto projection = std::make_shared<Projection>(table_scan, expression_vector(a, add_(b, 1)));
+    projection->set_transaction_context_recursively(transaction_context);
+    return projection;
+  }
+
+  std::shared_ptr<Table> table;
+  std::shared_ptr<PQPColumnExpression> a, b;
+  std::shared_ptr<TransactionContext> transaction_context;
+};
+
+TEST_F(OperatorsMorselPipelineTest, FusesChain) {
+  const auto pipeline = MorselPipeline::fuse_pipelines(create_pqp(200));
+  ASSERT_EQ(pipeline->type(), OperatorType::MorselPipeline);
+  EXPECT_EQ(pipeline->left_input()->type(), OperatorType::GetTable);
+
+  const auto& operators = static_cast<const MorselPipeline&>(*pipeline).operators();
+  ASSERT_EQ(operators.size(), 3);
+  EXPECT_EQ(operators[0]->type(), OperatorType::Validate);
+  EXPECT_EQ(operators[1]->type(), OperatorType::TableScan);
+  EXPECT_EQ(operators[2]->type(), OperatorType::Projection);
+}
+
+TEST_F(OperatorsMorselPipelineTest, DoesNotFuseOperatorsWithMultipleConsumers) {
+  const auto get_table = std::make_shared<GetTable>("table_a");
+  const auto table_scan_a = std::make_shared<TableScan>(get_table, greater_than_(a, 200));
+  const auto table_scan_b = std::make_shared<TableScan>(table_scan_a, less_than_(b, 800));
+  const auto union_all = std::make_shared<UnionAll>(table_scan_b, table_scan_a);
+
+  const auto fused_pqp = MorselPipeline::fuse_pipelines(union_all);
+  ASSERT_EQ(fused_pqp->type(), OperatorType::UnionAll);
+  EXPECT_EQ(fused_pqp->left_input()->type(), OperatorType::TableScan);
+  EXPECT_EQ(fused_pqp->left_input()->left_input(), fused_pqp->right_input());
+
+  const auto expected_result = execute(union_all);
+  EXPECT_TABLE_EQ_UNORDERED(execute(fused_pqp), expected_result);
+}
+
+TEST_F(OperatorsMorselPipelineTest, ResultEqualsOperatorAtATimeExecution) {
+  const auto expected_result = execute(create_pqp(200));
+  const auto result = execute(MorselPipeline::fuse_pipelines(create_pqp(200)));
+  EXPECT_TABLE_EQ_ORDERED(result, expected_result);
+
+  // The newly generated column of each morsel's Projection is stored in a separate table. All segments of the output
+  // column must reference the same table nonetheless.
+  ASSERT_EQ(result->type(), TableType::References);
+  ASSERT_GT(result->chunk_count(), 1);
+  const auto referenced_table = [&](const ChunkID chunk_id) {
+    const auto& segment = static_cast<const ReferenceSegment&>(*result->get_chunk(chunk_id)->get_segment(ColumnID{1}));
+    return segment.referenced_table();
+  };
+  for (auto chunk_id = ChunkID{1}; chunk_id < result->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(referenced_table(chunk_id), referenced_table(ChunkID{0}));
+  }
+}
+
+TEST_F(OperatorsMorselPipelineTest, EmptyResult) {
+  const auto expected_result = execute(create_pqp(1'000'000));
+  const auto result = execute(MorselPipeline::fuse_pipelines(create_pqp(1'000'000)));
+  EXPECT_EQ(result->row_count(), 0);
+  EXPECT_EQ(result->column_definitions(), expected_result->column_definitions());
+}
+
+TEST_F(OperatorsMorselPipelineTest, NoOutputIfTransactionIsAborted) {
+  // The transaction is aborted while the pipeline is executed, e.g., because a Delete in another part of the PQP ran
+  // into a conflict. The morsels' operators are not executed then, and no partial result must be returned.
+  const auto pipeline = std::static_pointer_cast<MorselPipeline>(MorselPipeline::fuse_pipelines(create_pqp(200)));
+  ASSERT_EQ(pipeline->type(), OperatorType::MorselPipeline);
+  pipeline->mutable_left_input()->execute();
+
+  transaction_context->rollback(RollbackReason::Conflict);
+  EXPECT_EQ(execute_morsels(*pipeline, transaction_context), nullptr);
+}
+
+TEST_F(OperatorsMorselPipelineTest, ExcludedChunks) {
+  const auto get_table = std::make_shared<GetTable>("table_a");
+  const auto table_scan = std::make_shared<TableScan>(get_table, greater_than_(a, 200));
+  table_scan->excluded_chunk_ids = {ChunkID{0}, ChunkID{3}};
+  const auto projection = std::make_shared<Projection>(table_scan, expression_vector(b));
+
+  const auto pipeline = MorselPipeline::fuse_pipelines(projection);
+  ASSERT_EQ(pipeline->type(), OperatorType::MorselPipeline);
+
+  const auto result = execute(pipeline);
+  const auto expected_result = std::make_shared<Table>(TableColumnDefinitions{{"b", DataType::Float, false}},
+                                                       TableType::Data);
+  expected_result->append({456.7f});
+  expected_result->append({800.0f});
+  EXPECT_TABLE_EQ_ORDERED(result, expected_result);
+}
+
+TEST_F(OperatorsMorselPipelineTest, SQLPipeline) {
+  // The Projection's output is consumed by a join, which requires the segments of a column to reference the same table
+  const auto sql = std::string{
+      "SELECT t1.a, t2.c FROM table_a t1, (SELECT a, b + 1 AS c FROM table_a WHERE a > 200) t2 WHERE t1.a = t2.a"};
+
+  const auto [expected_status, expected_result] = SQLPipelineBuilder{sql}.create_pipeline().get_result_table();
+  ASSERT_EQ(expected_status, SQLPipelineStatus::Success);
+
+  auto pipeline = SQLPipelineBuilder{sql}.with_morsel_pipelining().create_pipeline();
+  const auto [status, result] = pipeline.get_result_table();
+  ASSERT_EQ(status, SQLPipelineStatus::Success);
+  EXPECT_TABLE_EQ_UNORDERED(result, expected_result);
+}
+
+}  // namespace opossum
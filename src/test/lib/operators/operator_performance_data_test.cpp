@@ -10,6 +10,7 @@
 #include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_hash/bloom_filter.hpp"
 #include "operators/join_index.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
@@ -232,6 +233,14 @@ TEST_F(OperatorPerformanceDataTest, JoinHashBloomFilterReductions) {
   EXPECT_EQ(inner_perf.hash_tables_position_count, 3ul);           // positions 1,2,3
   EXPECT_TRUE(inner_perf.left_input_is_build_side);
 
+  // The build side is materialized first. Its Bloom filter is applied to the probe side, where 4 of 14 values pass.
+  // The probe side's Bloom filter is applied in build(), where 3 of 4 values pass.
+  EXPECT_EQ(inner_perf.build_side_bloom_filter_size, BloomFilter::MIN_SIZE);
+  EXPECT_EQ(inner_perf.probe_side_bloom_filter_size, BloomFilter::MIN_SIZE);
+  EXPECT_TRUE(inner_perf.build_side_bloom_filter_applied);
+  EXPECT_TRUE(inner_perf.probe_side_bloom_filter_applied);
+  EXPECT_FALSE(inner_perf.probe_side_bloom_filter_applied_in_clustering);
+
   // Semi join case: We check that no positions are stored (see explanation for "AllPositions" mode in hash map).
   // Further, we force the larger input to be the build side. As we first materialize the smaller side (i.e., the probe
   // side in this case) and create the initial bloom filter with that, there will be no reduction due to bloom
@@ -247,6 +256,23 @@ TEST_F(OperatorPerformanceDataTest, JoinHashBloomFilterReductions) {
   EXPECT_EQ(semi_perf.hash_tables_distinct_value_count, 2ul);
   EXPECT_FALSE(semi_perf.hash_tables_position_count);
   EXPECT_FALSE(semi_perf.left_input_is_build_side);
+
+  // As the probe side is materialized first, no Bloom filter is built for the build side
+  EXPECT_EQ(semi_perf.build_side_bloom_filter_size, 0);
+  EXPECT_EQ(semi_perf.probe_side_bloom_filter_size, BloomFilter::MIN_SIZE);
+  EXPECT_FALSE(semi_perf.build_side_bloom_filter_applied);
+  EXPECT_TRUE(semi_perf.probe_side_bloom_filter_applied);
+
+  // For left outer joins, all probe side values are kept. Thus, no Bloom filter is built for the build side.
+  const auto left_join = std::make_shared<JoinHash>(
+      table_wrapper_b, table_wrapper_a, JoinMode::Left,
+      OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+  left_join->execute();
+
+  const auto& left_perf = dynamic_cast<JoinHash::PerformanceData&>(*left_join->performance_data);
+  EXPECT_EQ(left_perf.probe_side_materialized_value_count, table_b->row_count());
+  EXPECT_EQ(left_perf.build_side_bloom_filter_size, 0);
+  EXPECT_FALSE(left_perf.build_side_bloom_filter_applied);
 }
 
 // Check that steps of IndexJoin (indexed chunks/unindexed chunks) are executed as expected.
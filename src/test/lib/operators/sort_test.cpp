@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+
 #include "base_test.hpp"
 
+#include "hyrise.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 
 namespace opossum {
 
@@ -154,6 +160,105 @@ INSTANTIATE_TEST_SUITE_P(Variations, SortTest,
                          sort_test_formatter);
 // clang-format on
 
+TEST_F(SortTest, DataTypesAndManyChunks) {
+  // Sorts a table that is large enough to be merged in multiple partitions. The float and string columns have few
+  // distinct values, so that ties are broken by the following columns. The strings share a prefix that is longer than
+  // the string prefix in the normalized keys.
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Long, false},
+                                                         {"b", DataType::Float, true},
+                                                         {"c", DataType::Double, false},
+                                                         {"d", DataType::String, true}};
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{1'000});
+
+  const auto floats = std::vector<AllTypeVariant>{NULL_VALUE, -1.5f, -0.0f, 0.0f, 2.5f};
+  const auto strings = std::vector<AllTypeVariant>{NULL_VALUE, pmr_string{"common prefix"}, pmr_string{"common"},
+                                                   pmr_string{"common prefix 2"}, pmr_string{"common prefiy"}};
+  auto random_engine = std::mt19937{};
+  auto value_distribution = std::uniform_int_distribution<int64_t>{-20, 20};
+  auto index_distribution = std::uniform_int_distribution<size_t>{0, 4};
+  auto rows = std::vector<std::vector<AllTypeVariant>>(140'000);
+  for (auto& row : rows) {
+    row = {value_distribution(random_engine) * 1'000'000'000'000, floats[index_distribution(random_engine)],
+           static_cast<double>(value_distribution(random_engine)) / 4, strings[index_distribution(random_engine)]};
+    table->append(row);
+  }
+  table->last_chunk()->finalize();
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto sort_definition_sets = std::vector<std::vector<SortColumnDefinition>>{
+      {SortColumnDefinition{ColumnID{1}, SortMode::Ascending},
+       SortColumnDefinition{ColumnID{3}, SortMode::Descending},
+       SortColumnDefinition{ColumnID{0}, SortMode::Ascending}},
+      {SortColumnDefinition{ColumnID{3}, SortMode::Ascending},
+       SortColumnDefinition{ColumnID{2}, SortMode::Descending}},
+      {SortColumnDefinition{ColumnID{0}, SortMode::Descending},
+       SortColumnDefinition{ColumnID{2}, SortMode::Ascending}}};
+
+  for (const auto& sort_definitions : sort_definition_sets) {
+    // Determine the expected order with a stable sort on the rows
+    auto row_ids = std::vector<size_t>(rows.size());
+    std::iota(row_ids.begin(), row_ids.end(), size_t{0});
+    std::stable_sort(row_ids.begin(), row_ids.end(), [&](const auto lhs, const auto rhs) {
+      for (const auto& sort_definition : sort_definitions) {
+        const auto& lhs_value = rows[lhs][sort_definition.column];
+        const auto& rhs_value = rows[rhs][sort_definition.column];
+        if (variant_is_null(lhs_value) || variant_is_null(rhs_value)) {
+          if (variant_is_null(lhs_value) != variant_is_null(rhs_value)) return variant_is_null(lhs_value);
+          continue;
+        }
+        if (lhs_value == rhs_value) continue;
+        return (lhs_value < rhs_value) == (sort_definition.sort_mode == SortMode::Ascending);
+      }
+      return false;
+    });
+
+    const auto expected_table = std::make_shared<Table>(column_definitions, TableType::Data);
+    for (const auto row_id : row_ids) {
+      expected_table->append(rows[row_id]);
+    }
+
+    auto sort = Sort{table_wrapper, sort_definitions};
+    sort.execute();
+    EXPECT_TABLE_EQ_ORDERED(sort.get_output(), expected_table);
+  }
+}
+
+TEST_F(SortTest, ExternalSort) {
+  // With a tiny memory budget, every input chunk is sorted on its own and spilled as a sorted run
+  const auto sort_definitions = std::vector<SortColumnDefinition>{
+      SortColumnDefinition{ColumnID{0}, SortMode::Ascending}, SortColumnDefinition{ColumnID{1}, SortMode::Descending}};
+  auto sort = Sort{input_table_wrapper, sort_definitions, Chunk::DEFAULT_SIZE, Sort::ForceMaterialization::No, 1};
+  sort.execute();
+
+  EXPECT_TABLE_EQ_ORDERED(sort.get_output(), load_table("resources/test_data/tbl/sort/a_asc_b_desc.tbl"));
+
+  const auto& performance_data = static_cast<const Sort::PerformanceData&>(*sort.performance_data);
+  EXPECT_EQ(performance_data.spilled_run_count, input_table->chunk_count());
+  // Each spilled row consists of its key (a NULL byte and four bytes per column) and its RowID
+  EXPECT_EQ(performance_data.spilled_bytes, input_table->row_count() * (2 * 5 + sizeof(RowID)));
+
+  // A budget that fits two chunks at a time leads to fewer runs with the same result. The string column is compared on
+  // its values when the prefixes in the keys are equal.
+  const auto string_sort_definitions = std::vector<SortColumnDefinition>{
+      SortColumnDefinition{ColumnID{2}, SortMode::Descending}, SortColumnDefinition{ColumnID{0}, SortMode::Ascending}};
+  auto expected_sort = Sort{input_table_wrapper, string_sort_definitions};
+  expected_sort.execute();
+
+  auto spilling_sort = Sort{input_table_wrapper, string_sort_definitions, Chunk::DEFAULT_SIZE,
+                            Sort::ForceMaterialization::No, 1'500};
+  spilling_sort.execute();
+  EXPECT_TABLE_EQ_ORDERED(spilling_sort.get_output(), expected_sort.get_output());
+  EXPECT_EQ(static_cast<const Sort::PerformanceData&>(*spilling_sort.performance_data).spilled_run_count, 2);
+
+  // Without spilling, nothing is reported
+  EXPECT_EQ(static_cast<const Sort::PerformanceData&>(*expected_sort.performance_data).spilled_run_count, 0);
+}
+
 TEST_F(SortTest, JoinProducesReferences) {
   // Even though not all columns in a join result refer to the same table, the output should use references
   const auto right_wrapper = std::make_shared<TableWrapper>(load_table("resources/test_data/tbl/int3.tbl"));
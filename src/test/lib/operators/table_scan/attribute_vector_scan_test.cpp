@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "operators/table_scan/attribute_vector_scan.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+
+namespace opossum {
+
+class AttributeVectorScanTest : public BaseTestWithParam<VectorCompressionType> {
+ protected:
+  // Checks that scan_attribute_vector() finds the same rows as a naive scan over the uncompressed value IDs. The
+  // largest value ID of the vector is used as the null_value_id.
+  void expect_equal_to_naive_scan(const size_t size, const uint32_t max_value_id) {
+    SCOPED_TRACE(std::to_string(size) + " rows, max value ID " + std::to_string(max_value_id));
+
+    auto random_engine = std::mt19937{size};
+    auto distribution = std::uniform_int_distribution<uint32_t>{0, max_value_id};
+    auto value_ids = pmr_vector<uint32_t>(size);
+    for (auto& value_id : value_ids) {
+      value_id = distribution(random_engine);
+    }
+
+    const auto vector = compress_vector(value_ids, GetParam(), {}, {max_value_id});
+    const auto null_value_id = ValueID{max_value_id};
+
+    const auto ranges = std::vector<std::pair<uint32_t, uint32_t>>{
+        {0, 0}, {0, 1}, {0, max_value_id / 2}, {max_value_id / 3, max_value_id / 3 + 1}, {0, max_value_id}};
+
+    for (const auto& [begin_value_id, end_value_id] : ranges) {
+      for (const auto invert : {false, true}) {
+        SCOPED_TRACE(std::to_string(begin_value_id) + " - " + std::to_string(end_value_id) + (invert ? " inv" : ""));
+
+        auto expected_matches = pmr_vector<ChunkOffset>{};
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < size; ++chunk_offset) {
+          const auto value_id = value_ids[chunk_offset];
+          const auto in_range = value_id >= begin_value_id && value_id < end_value_id;
+          if (in_range != invert && value_id != null_value_id) {
+            expected_matches.emplace_back(chunk_offset);
+          }
+        }
+
+        // Matches are appended to existing ones
+        auto matches = pmr_vector<ChunkOffset>{INVALID_CHUNK_OFFSET};
+        scan_attribute_vector(*vector, ValueID{begin_value_id}, ValueID{end_value_id}, invert, null_value_id, matches);
+
+        ASSERT_EQ(matches.size(), expected_matches.size() + 1);
+        EXPECT_EQ(matches.front(), INVALID_CHUNK_OFFSET);
+        EXPECT_TRUE(std::equal(expected_matches.cbegin(), expected_matches.cend(), matches.cbegin() + 1));
+      }
+    }
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(VectorCompressionTypes, AttributeVectorScanTest,
+                         ::testing::Values(VectorCompressionType::FixedWidthInteger,
+                                           VectorCompressionType::BitPacking));
+
+TEST_P(AttributeVectorScanTest, EmptyVector) { expect_equal_to_naive_scan(0, 10); }
+
+TEST_P(AttributeVectorScanTest, SmallVectors) {
+  // Fewer rows than a block, exactly one block, and a block plus a remainder
+  expect_equal_to_naive_scan(17, 3);
+  expect_equal_to_naive_scan(64, 200);
+  expect_equal_to_naive_scan(100, 1);
+}
+
+TEST_P(AttributeVectorScanTest, BitWidths) {
+  // Covers all widths of FixedWidthIntegerVectors and a selection of the BitPackingVector's bit widths, including
+  // those where value IDs span two words
+  for (const auto max_value_id :
+       {1u, 2u, 6u, 100u, 255u, 256u, 1'000u, 65'535u, 100'000u, 5'000'000u, 2'000'000'000u}) {
+    expect_equal_to_naive_scan(1'000, max_value_id);
+  }
+}
+
+TEST_P(AttributeVectorScanTest, WordAlignedEnd) {
+  // With 32 bits per value, the data ends exactly at a word boundary, so the last block cannot be read block-wise
+  expect_equal_to_naive_scan(128, 4'000'000'000u);
+  expect_equal_to_naive_scan(1'024, 65'535u);
+}
+
+}  // namespace opossum
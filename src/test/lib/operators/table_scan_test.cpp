@@ -256,7 +256,7 @@ auto table_scan_test_formatter = [](const ::testing::TestParamInfo<EncodingType>
 
 INSTANTIATE_TEST_SUITE_P(EncodingTypes, OperatorsTableScanTest,
                          ::testing::Values(EncodingType::Unencoded, EncodingType::Dictionary, EncodingType::RunLength,
-                                           EncodingType::FrameOfReference),
+                                           EncodingType::FrameOfReference, EncodingType::Delta),
                          table_scan_test_formatter);
 
 TEST_P(OperatorsTableScanTest, DoubleScan) {
@@ -867,6 +867,52 @@ TEST_P(OperatorsTableScanTest, ScanWithExcludedFirstChunk) {
   ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{1}, expected);
 }
 
+TEST_P(OperatorsTableScanTest, RuntimeBloomFilter) {
+  const auto create_source = [](const std::vector<int32_t>& values) {
+    const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}}, TableType::Data);
+    for (const auto value : values) {
+      table->append({value});
+    }
+    table->append({NULL_VALUE});
+
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    return table_wrapper;
+  };
+
+  const auto column_a = get_column_expression(_int_int_compressed, ColumnID{0});
+
+  {
+    // Only the rows with a value in the source pass the filter
+    const auto source = create_source({4, 10, 11});
+    const auto scan = std::make_shared<TableScan>(_int_int_compressed, greater_than_equals_(column_a, 0));
+    scan->set_runtime_bloom_filter(source, ColumnID{0}, ColumnID{0});
+    EXPECT_EQ(scan->runtime_bloom_filter_source(), source);
+    scan->execute();
+
+    ASSERT_COLUMN_EQ(scan->get_output(), ColumnID{0}, {10, 4, 10, 4});
+
+    const auto& performance_data = dynamic_cast<TableScan::PerformanceData&>(*scan->performance_data);
+    EXPECT_EQ(performance_data.runtime_bloom_filter_size, BloomFilter::MIN_SIZE);
+    EXPECT_TRUE(performance_data.runtime_bloom_filter_applied);
+    EXPECT_EQ(performance_data.num_rows_pruned_by_runtime_bloom_filter.load(), 10u);
+  }
+
+  {
+    // Most values pass the filter, so it is not applied
+    const auto source = create_source({0, 2, 4, 6, 8, 10, 12});
+    const auto scan = std::make_shared<TableScan>(_int_int_compressed, greater_than_equals_(column_a, 4));
+    scan->set_runtime_bloom_filter(source, ColumnID{0}, ColumnID{0});
+    scan->execute();
+
+    EXPECT_EQ(scan->get_output()->row_count(), 10u);
+
+    const auto& performance_data = dynamic_cast<TableScan::PerformanceData&>(*scan->performance_data);
+    EXPECT_FALSE(performance_data.runtime_bloom_filter_applied);
+    EXPECT_EQ(performance_data.num_rows_pruned_by_runtime_bloom_filter.load(), 0u);
+  }
+}
+
 TEST_P(OperatorsTableScanTest, BinaryScanOnNullable) {
   auto predicates = std::vector<std::tuple<ColumnID, PredicateCondition, AllTypeVariant, std::vector<AllTypeVariant>>>{
       {ColumnID{0}, PredicateCondition::Equals, 1234, {1234}},
@@ -0,0 +1,110 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class TopKTest : public BaseTest {
+ public:
+  static void SetUpTestCase() {
+    // Small chunks, so that the candidates of multiple chunks have to be merged
+    input_table = load_table("resources/test_data/tbl/sort/input.tbl", 7);
+    input_table_wrapper = std::make_shared<TableWrapper>(input_table);
+    input_table_wrapper->never_clear_output();
+    input_table_wrapper->execute();
+  }
+
+ protected:
+  // Checks that the TopK's result is equal to that of a Sort followed by a Limit
+  void expect_equal_to_sort_and_limit(const std::shared_ptr<AbstractOperator>& input,
+                                      const std::vector<SortColumnDefinition>& sort_definitions,
+                                      const int64_t row_count) {
+    SCOPED_TRACE(std::to_string(row_count) + " rows");
+
+    const auto sort = std::make_shared<Sort>(input, sort_definitions);
+    sort->execute();
+    const auto limit = std::make_shared<Limit>(sort, value_(row_count));
+    limit->execute();
+
+    const auto top_k = std::make_shared<TopK>(input, sort_definitions, value_(row_count));
+    top_k->execute();
+
+    EXPECT_TABLE_EQ_ORDERED(top_k->get_output(), limit->get_output());
+    if (row_count > 0) {
+      EXPECT_EQ(top_k->get_output()->type(), TableType::References);
+    }
+  }
+
+  static inline std::shared_ptr<Table> input_table;
+  static inline std::shared_ptr<AbstractOperator> input_table_wrapper;
+};
+
+TEST_F(TopKTest, SingleColumn) {
+  for (const auto row_count : {0, 1, 5, 20, 50, 100}) {
+    expect_equal_to_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{0}, SortMode::Ascending}},
+                                   row_count);
+    expect_equal_to_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{2}, SortMode::Descending}},
+                                   row_count);
+  }
+}
+
+TEST_F(TopKTest, NullsAndTies) {
+  // Column b contains NULLs and duplicates, so that the secondary sort column and the row order decide
+  for (const auto row_count : {1, 3, 10, 30}) {
+    expect_equal_to_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{1}, SortMode::Ascending}},
+                                   row_count);
+    expect_equal_to_sort_and_limit(input_table_wrapper, {SortColumnDefinition{ColumnID{1}, SortMode::Descending}},
+                                   row_count);
+    expect_equal_to_sort_and_limit(input_table_wrapper,
+                                   {SortColumnDefinition{ColumnID{1}, SortMode::Descending},
+                                    SortColumnDefinition{ColumnID{2}, SortMode::Ascending}},
+                                   row_count);
+    expect_equal_to_sort_and_limit(input_table_wrapper,
+                                   {SortColumnDefinition{ColumnID{2}, SortMode::Ascending},
+                                    SortColumnDefinition{ColumnID{1}, SortMode::Descending},
+                                    SortColumnDefinition{ColumnID{0}, SortMode::Descending}},
+                                   row_count);
+  }
+}
+
+TEST_F(TopKTest, ReferenceInput) {
+  const auto a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+  const auto table_scan = std::make_shared<TableScan>(input_table_wrapper, greater_than_(a, 10));
+  table_scan->execute();
+
+  for (const auto row_count : {0, 4, 40}) {
+    expect_equal_to_sort_and_limit(table_scan,
+                                   {SortColumnDefinition{ColumnID{1}, SortMode::Ascending},
+                                    SortColumnDefinition{ColumnID{0}, SortMode::Descending}},
+                                   row_count);
+  }
+}
+
+TEST_F(TopKTest, EmptyInput) {
+  const auto table_scan = std::make_shared<TableScan>(input_table_wrapper, equals_(1, 2));
+  table_scan->execute();
+
+  expect_equal_to_sort_and_limit(table_scan, {SortColumnDefinition{ColumnID{0}, SortMode::Ascending}}, 10);
+}
+
+TEST_F(TopKTest, Description) {
+  const auto top_k = std::make_shared<TopK>(
+      input_table_wrapper,
+      std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}, SortMode::Ascending},
+                                        SortColumnDefinition{ColumnID{2}, SortMode::Descending}},
+      value_(int64_t{3}));
+  EXPECT_EQ(top_k->description(DescriptionMode::SingleLine), "TopK Rows: 3 Sort: 0 Ascending 2 Descending");
+}
+
+}  // namespace opossum
@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <memory>
+#include <random>
+#include <set>
 #include <utility>
 
 #include "base_test.hpp"
@@ -307,4 +310,150 @@ TEST_F(UnionPositionsTest, MultipleShuffledPosList) {
                             load_table("resources/test_data/tbl/union_positions_multiple_shuffled_pos_list.tbl"));
 }
 
+TEST_F(UnionPositionsTest, SingleReferencedTableWithNullRowIDs) {
+  /**
+   * Both inputs reference only 10_ints, so that the union is computed using bitmaps. The RowIDs are emitted in order
+   * and a NULL_ROW_ID is emitted once.
+   */
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+
+  const auto pos_list_left = std::make_shared<RowIDPosList>(
+      RowIDPosList{RowID{ChunkID{2}, ChunkOffset{1}}, NULL_ROW_ID, RowID{ChunkID{0}, ChunkOffset{2}}});
+  const auto table_left = std::make_shared<Table>(column_definitions, TableType::References);
+  table_left->append_chunk(Segments{std::make_shared<ReferenceSegment>(_table_10_ints, ColumnID{0}, pos_list_left)});
+
+  const auto pos_list_right_0 = std::make_shared<RowIDPosList>(RowIDPosList{RowID{ChunkID{0}, ChunkOffset{2}}});
+  const auto pos_list_right_1 =
+      std::make_shared<RowIDPosList>(RowIDPosList{RowID{ChunkID{3}, ChunkOffset{0}}, NULL_ROW_ID});
+  const auto table_right = std::make_shared<Table>(column_definitions, TableType::References);
+  table_right->append_chunk(
+      Segments{std::make_shared<ReferenceSegment>(_table_10_ints, ColumnID{0}, pos_list_right_0)});
+  table_right->append_chunk(
+      Segments{std::make_shared<ReferenceSegment>(_table_10_ints, ColumnID{0}, pos_list_right_1)});
+
+  const auto table_wrapper_left_op = std::make_shared<TableWrapper>(table_left);
+  const auto table_wrapper_right_op = std::make_shared<TableWrapper>(table_right);
+  const auto set_union_op = std::make_shared<UnionPositions>(table_wrapper_left_op, table_wrapper_right_op);
+  execute_all({table_wrapper_left_op, table_wrapper_right_op, set_union_op});
+
+  const auto& output = set_union_op->get_output();
+  ASSERT_EQ(output->chunk_count(), 1);
+  const auto segment =
+      std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{0}));
+  const auto expected_pos_list = RowIDPosList{RowID{ChunkID{0}, ChunkOffset{2}}, RowID{ChunkID{2}, ChunkOffset{1}},
+                                              RowID{ChunkID{3}, ChunkOffset{0}}, NULL_ROW_ID};
+  EXPECT_EQ(*std::dynamic_pointer_cast<const RowIDPosList>(segment->pos_list()), expected_pos_list);
+}
+
+TEST_F(UnionPositionsTest, MultipleReferencedTablesManyChunks) {
+  /**
+   * The rows of each chunk are sorted separately and merged afterwards. Use an odd number of chunks, so that a run is
+   * left over in some of the merge rounds.
+   */
+  auto random_engine = std::mt19937{17};
+  auto chunk_id_distribution = std::uniform_int_distribution<ChunkID::base_type>{0, 2};
+  auto chunk_offset_distribution = std::uniform_int_distribution<ChunkOffset>{0, 2};
+  const auto random_row_id = [&]() {
+    return RowID{ChunkID{chunk_id_distribution(random_engine)}, ChunkOffset{chunk_offset_distribution(random_engine)}};
+  };
+
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}};
+  auto expected_rows = std::set<std::pair<RowID, RowID>>{};
+
+  const auto create_input = [&](const size_t chunk_count) {
+    const auto table = std::make_shared<Table>(column_definitions, TableType::References);
+    for (auto chunk_idx = size_t{0}; chunk_idx < chunk_count; ++chunk_idx) {
+      const auto pos_list_a = std::make_shared<RowIDPosList>();
+      const auto pos_list_b = std::make_shared<RowIDPosList>();
+      for (auto row_idx = 0; row_idx < 7; ++row_idx) {
+        pos_list_a->emplace_back(random_row_id());
+        pos_list_b->emplace_back(random_row_id());
+        expected_rows.emplace(pos_list_a->back(), pos_list_b->back());
+      }
+      table->append_chunk(Segments{std::make_shared<ReferenceSegment>(_table_10_ints, ColumnID{0}, pos_list_a),
+                                   std::make_shared<ReferenceSegment>(_table_10_ints, ColumnID{0}, pos_list_b)});
+    }
+    return std::make_shared<TableWrapper>(table);
+  };
+
+  const auto table_wrapper_left_op = create_input(5);
+  const auto table_wrapper_right_op = create_input(3);
+  const auto set_union_op = std::make_shared<UnionPositions>(table_wrapper_left_op, table_wrapper_right_op);
+  execute_all({table_wrapper_left_op, table_wrapper_right_op, set_union_op});
+
+  // Rows that occur multiple times, within one input or in both, are emitted once
+  auto actual_rows = std::vector<std::pair<RowID, RowID>>{};
+  const auto& output = set_union_op->get_output();
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto chunk = output->get_chunk(chunk_id);
+    const auto pos_list_a =
+        std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}))->pos_list();
+    const auto pos_list_b =
+        std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{1}))->pos_list();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+      actual_rows.emplace_back((*pos_list_a)[chunk_offset], (*pos_list_b)[chunk_offset]);
+    }
+  }
+
+  EXPECT_TRUE(std::is_sorted(actual_rows.begin(), actual_rows.end()));
+  EXPECT_EQ(actual_rows.size(), expected_rows.size());
+  const auto actual_row_set = std::set<std::pair<RowID, RowID>>(actual_rows.begin(), actual_rows.end());
+  EXPECT_EQ(actual_row_set, expected_rows);
+}
+
+TEST_F(UnionPositionsTest, DuplicateRowIDsWithAndWithoutBitmaps) {
+  /**
+   * The same inputs, which contain duplicates within each input and NULL_ROW_IDs, are unioned once for a small
+   * referenced table (so that bitmaps are used) and once for a large one (so that the inputs are sorted and merged).
+   * Both must emit every RowID once.
+   */
+  const auto pos_list_left = RowIDPosList{RowID{ChunkID{2}, ChunkOffset{5}}, RowID{ChunkID{0}, ChunkOffset{1}},
+                                          NULL_ROW_ID, RowID{ChunkID{0}, ChunkOffset{1}}, NULL_ROW_ID};
+  const auto pos_list_right = RowIDPosList{RowID{ChunkID{3}, ChunkOffset{3}}, RowID{ChunkID{2}, ChunkOffset{5}},
+                                           RowID{ChunkID{3}, ChunkOffset{3}}, RowID{ChunkID{0}, ChunkOffset{1}}};
+  const auto input_row_count = pos_list_left.size() + pos_list_right.size();
+
+  const auto union_positions = [&](const ChunkOffset referenced_chunk_size) {
+    const auto referenced_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}},
+                                                          TableType::Data, referenced_chunk_size);
+    for (auto row_idx = ChunkOffset{0}; row_idx < 4 * referenced_chunk_size; ++row_idx) {
+      referenced_table->append({static_cast<int32_t>(row_idx)});
+    }
+
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+    const auto create_input = [&](const RowIDPosList& pos_list) {
+      const auto table = std::make_shared<Table>(column_definitions, TableType::References);
+      const auto pos_list_copy = std::make_shared<RowIDPosList>(pos_list.begin(), pos_list.end());
+      table->append_chunk(Segments{std::make_shared<ReferenceSegment>(referenced_table, ColumnID{0}, pos_list_copy)});
+      return std::make_shared<TableWrapper>(table);
+    };
+
+    const auto table_wrapper_left_op = create_input(pos_list_left);
+    const auto table_wrapper_right_op = create_input(pos_list_right);
+    const auto set_union_op = std::make_shared<UnionPositions>(table_wrapper_left_op, table_wrapper_right_op);
+    execute_all({table_wrapper_left_op, table_wrapper_right_op, set_union_op});
+
+    auto row_ids = RowIDPosList{};
+    const auto& output = set_union_op->get_output();
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto segment =
+          std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(chunk_id)->get_segment(ColumnID{0}));
+      for (const auto& row_id : *segment->pos_list()) {
+        row_ids.emplace_back(row_id);
+      }
+    }
+    return row_ids;
+  };
+
+  const auto small_chunk_size = ChunkOffset{10};
+  const auto large_chunk_size = ChunkOffset{1'000};
+  ASSERT_GE(input_row_count, 4 * small_chunk_size / UnionPositions::BITMAP_MIN_DENSITY);
+  ASSERT_LT(input_row_count, 4 * large_chunk_size / UnionPositions::BITMAP_MIN_DENSITY);
+
+  const auto expected_row_ids = RowIDPosList{RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{2}, ChunkOffset{5}},
+                                             RowID{ChunkID{3}, ChunkOffset{3}}, NULL_ROW_ID};
+  EXPECT_EQ(union_positions(small_chunk_size), expected_row_ids);
+  EXPECT_EQ(union_positions(large_chunk_size), expected_row_ids);
+}
+
 }  // namespace opossum
@@ -0,0 +1,128 @@
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "scheduler/admission_control.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+
+namespace opossum {
+
+class AdmissionControlTest : public BaseTest {
+ protected:
+  static void wait_until_admitted(const AdmissionControl& admission_control, const size_t admitted_query_count) {
+    while (admission_control.admitted_query_count() != admitted_query_count) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+TEST_F(AdmissionControlTest, AdmitsUpToLimit) {
+  auto admission_control = AdmissionControl{2};
+  EXPECT_EQ(admission_control.max_concurrent_queries(), 2);
+
+  admission_control.admit(SchedulePriority::Default);
+  admission_control.admit(SchedulePriority::Low);
+  EXPECT_EQ(admission_control.admitted_query_count(), 2);
+
+  auto admitted = std::atomic_bool{false};
+  auto waiting_query = std::thread([&]() {
+    admission_control.admit(SchedulePriority::Default);
+    admitted = true;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(admitted);
+
+  admission_control.release();
+  waiting_query.join();
+  EXPECT_TRUE(admitted);
+  EXPECT_EQ(admission_control.admitted_query_count(), 2);
+
+  admission_control.release();
+  admission_control.release();
+  EXPECT_EQ(admission_control.admitted_query_count(), 0);
+}
+
+TEST_F(AdmissionControlTest, HighPriorityBypassesLimit) {
+  auto admission_control = AdmissionControl{1};
+  admission_control.admit(SchedulePriority::Default);
+  admission_control.admit(SchedulePriority::High);
+  EXPECT_EQ(admission_control.admitted_query_count(), 2);
+}
+
+TEST_F(AdmissionControlTest, GuardReleasesOnException) {
+  const auto admission_control = std::make_shared<AdmissionControl>(1);
+
+  const auto execute_failing_query = [&]() {
+    const auto admission_guard = AdmissionGuard{admission_control, SchedulePriority::Default};
+    EXPECT_EQ(admission_control->admitted_query_count(), 1);
+    throw std::runtime_error("Query failed");
+  };
+  EXPECT_THROW(execute_failing_query(), std::runtime_error);
+  EXPECT_EQ(admission_control->admitted_query_count(), 0);
+
+  // Without an AdmissionControl, the guard does nothing
+  const auto admission_guard = AdmissionGuard{nullptr, SchedulePriority::Default};
+}
+
+TEST_F(AdmissionControlTest, DefaultPriorityIsAdmittedBeforeLowPriority) {
+  auto admission_control = AdmissionControl{1};
+  admission_control.admit(SchedulePriority::Default);
+
+  auto admission_order = std::vector<SchedulePriority>{};
+  auto admission_order_mutex = std::mutex{};
+  const auto admit_and_record = [&](const SchedulePriority priority) {
+    admission_control.admit(priority);
+    {
+      std::lock_guard<std::mutex> lock(admission_order_mutex);
+      admission_order.emplace_back(priority);
+    }
+    admission_control.release();
+  };
+
+  auto low_priority_query = std::thread(admit_and_record, SchedulePriority::Low);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  auto default_priority_query = std::thread(admit_and_record, SchedulePriority::Default);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  admission_control.release();
+  low_priority_query.join();
+  default_priority_query.join();
+
+  const auto expected_order = std::vector<SchedulePriority>{SchedulePriority::Default, SchedulePriority::Low};
+  EXPECT_EQ(admission_order, expected_order);
+}
+
+TEST_F(AdmissionControlTest, WaitingWorkerExecutesOtherTasks) {
+  // With a single worker, a query that waits for admission from within a task must not block the worker. Otherwise,
+  // the admitted query's task would never be executed.
+  Hyrise::get().topology.use_default_topology(1);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  auto admission_control = AdmissionControl{1};
+  admission_control.admit(SchedulePriority::Default);
+
+  auto admitted_query_task = std::make_shared<JobTask>([&]() { admission_control.release(); });
+  auto waiting_query_task = std::make_shared<JobTask>([&]() {
+    admission_control.admit(SchedulePriority::Default);
+    admission_control.release();
+  });
+
+  waiting_query_task->schedule();
+  admitted_query_task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(
+      std::vector<std::shared_ptr<AbstractTask>>{waiting_query_task, admitted_query_task});
+  EXPECT_EQ(admission_control.admitted_query_count(), 0);
+
+  Hyrise::get().scheduler()->finish();
+}
+
+}  // namespace opossum
@@ -290,4 +290,76 @@ TEST_F(SchedulerTest, SingleWorkerGuaranteeProgress) {
   Hyrise::get().scheduler()->finish();
 }
 
+TEST_F(SchedulerTest, BasicTestWithWorkerDeques) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(true));
+
+  std::atomic_uint32_t counter{0};
+
+  increment_counter_in_subtasks(counter);
+
+  Hyrise::get().scheduler()->finish();
+
+  ASSERT_EQ(counter, 30u);
+
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+}
+
+TEST_F(SchedulerTest, DiamondDependenciesWithWorkerDeques) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(true));
+
+  std::atomic_uint32_t counter{0};
+
+  // Schedule the tasks from within a worker so that they are pushed to its deque.
+  auto task = std::make_shared<JobTask>([&]() { stress_diamond_dependencies(counter); });
+  task->schedule();
+
+  Hyrise::get().scheduler()->finish();
+
+  ASSERT_EQ(counter, 7u);
+}
+
+TEST_F(SchedulerTest, SingleWorkerGuaranteeProgressWithWorkerDeques) {
+  Hyrise::get().topology.use_default_topology(1);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>(true));
+
+  auto task_done = false;
+  auto task = std::make_shared<JobTask>([&task_done]() {
+    auto subtask = std::make_shared<JobTask>([&task_done]() { task_done = true; });
+
+    subtask->schedule();
+    Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{subtask});
+  });
+
+  task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{task});
+  EXPECT_TRUE(task_done);
+
+  Hyrise::get().scheduler()->finish();
+}
+
+TEST_F(SchedulerTest, LowPriorityIsInheritedBySubtasks) {
+  Hyrise::get().topology.use_default_topology(2);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  auto subtask = std::make_shared<JobTask>([]() {});
+  auto high_priority_subtask = std::make_shared<JobTask>([]() {}, SchedulePriority::High);
+  auto task = std::make_shared<JobTask>(
+      [&]() {
+        subtask->schedule();
+        high_priority_subtask->schedule();
+        Hyrise::get().scheduler()->wait_for_tasks(
+            std::vector<std::shared_ptr<AbstractTask>>{subtask, high_priority_subtask});
+      },
+      SchedulePriority::Low);
+
+  task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{task});
+  EXPECT_EQ(subtask->priority(), SchedulePriority::Low);
+  EXPECT_EQ(high_priority_subtask->priority(), SchedulePriority::High);
+
+  Hyrise::get().scheduler()->finish();
+}
+
 }  // namespace opossum
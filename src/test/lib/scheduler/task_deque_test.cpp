@@ -0,0 +1,114 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "scheduler/job_task.hpp"
+#include "scheduler/task_deque.hpp"
+
+namespace opossum {
+
+class TaskDequeTest : public BaseTest {
+ protected:
+  static std::vector<std::shared_ptr<AbstractTask>> create_tasks(const size_t count) {
+    auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto task_id = size_t{0}; task_id < count; ++task_id) {
+      tasks.emplace_back(std::make_shared<JobTask>([]() {}));
+    }
+    return tasks;
+  }
+};
+
+TEST_F(TaskDequeTest, OwnerPopsInLifoOrderThievesStealInFifoOrder) {
+  auto deque = TaskDeque{NodeID{0}};
+  EXPECT_TRUE(deque.empty());
+  EXPECT_FALSE(deque.pop());
+  EXPECT_FALSE(deque.steal());
+
+  const auto tasks = create_tasks(4);
+  for (const auto& task : tasks) {
+    deque.push(task);
+  }
+  EXPECT_FALSE(deque.empty());
+
+  EXPECT_EQ(deque.pop(), tasks[3]);
+  EXPECT_EQ(deque.steal(), tasks[0]);
+  EXPECT_EQ(deque.pop(), tasks[2]);
+  EXPECT_EQ(deque.steal(), tasks[1]);
+  EXPECT_FALSE(deque.pop());
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(TaskDequeTest, Grow) {
+  auto deque = TaskDeque{NodeID{0}, 2};
+
+  const auto tasks = create_tasks(100);
+  for (const auto& task : tasks) {
+    deque.push(task);
+  }
+
+  EXPECT_EQ(deque.steal(), tasks.front());
+  for (auto task_id = tasks.size() - 1; task_id > 0; --task_id) {
+    EXPECT_EQ(deque.pop(), tasks[task_id]);
+  }
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(TaskDequeTest, ConcurrentStealing) {
+  // Every task must be removed from the deque exactly once, no matter whether it is popped or stolen.
+  constexpr auto TASK_COUNT = size_t{10'000};
+  constexpr auto THIEF_COUNT = size_t{4};
+
+  auto deque = TaskDeque{NodeID{0}, 4};
+  const auto tasks = create_tasks(TASK_COUNT);
+
+  auto removal_count = std::vector<std::atomic_uint32_t>(TASK_COUNT);
+  auto removed_tasks = std::atomic<size_t>{0};
+  auto index_by_task = std::unordered_map<const AbstractTask*, size_t>{};
+  for (auto task_id = size_t{0}; task_id < TASK_COUNT; ++task_id) {
+    index_by_task.emplace(tasks[task_id].get(), task_id);
+  }
+  const auto task_index = [&](const std::shared_ptr<AbstractTask>& task) { return index_by_task.at(task.get()); };
+
+  auto thieves = std::vector<std::thread>{};
+  for (auto thief_id = size_t{0}; thief_id < THIEF_COUNT; ++thief_id) {
+    thieves.emplace_back([&]() {
+      while (removed_tasks < TASK_COUNT) {
+        const auto task = deque.steal();
+        if (!task) continue;
+        ++removal_count[task_index(task)];
+        ++removed_tasks;
+      }
+    });
+  }
+
+  for (auto task_id = size_t{0}; task_id < TASK_COUNT; ++task_id) {
+    deque.push(tasks[task_id]);
+    if (task_id % 3 == 0) {
+      const auto task = deque.pop();
+      if (!task) continue;
+      ++removal_count[task_index(task)];
+      ++removed_tasks;
+    }
+  }
+
+  while (removed_tasks < TASK_COUNT) {
+    const auto task = deque.pop();
+    if (!task) continue;
+    ++removal_count[task_index(task)];
+    ++removed_tasks;
+  }
+
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  for (const auto& count : removal_count) {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+}  // namespace opossum
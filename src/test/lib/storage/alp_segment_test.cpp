@@ -0,0 +1,141 @@
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "all_type_variant.hpp"
+#include "storage/alp_segment.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/create_iterable_from_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageALPSegmentTest : public BaseTest {
+ protected:
+  template <typename T>
+  std::shared_ptr<ALPSegment<T>> compress(const std::shared_ptr<ValueSegment<T>>& segment) {
+    auto encoded_segment =
+        ChunkEncoder::encode_segment(segment, data_type_from_type<T>(), SegmentEncodingSpec{EncodingType::ALP});
+    return std::dynamic_pointer_cast<ALPSegment<T>>(encoded_segment);
+  }
+};
+
+TEST_F(StorageALPSegmentTest, EncodeDecimals) {
+  // Prices with two decimal places
+  auto value_segment = std::make_shared<ValueSegment<double>>();
+  const auto row_count = ALPSegment<double>::block_size + 100;
+  for (auto index = size_t{0}; index < row_count; ++index) {
+    value_segment->append(static_cast<double>(1'000 + index % 1'000) / 100.0);
+  }
+  auto alp_segment = compress(value_segment);
+  ASSERT_TRUE(alp_segment);
+
+  EXPECT_EQ(alp_segment->size(), row_count);
+  EXPECT_EQ(alp_segment->exponent(), 2u);
+  EXPECT_EQ(alp_segment->block_minima(), pmr_vector<int64_t>({1'000, 1'048}));
+  EXPECT_TRUE(alp_segment->exception_positions().empty());
+  EXPECT_FALSE(alp_segment->null_values());
+
+  const auto decompressed_values = alp_segment->decompress();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    EXPECT_EQ(alp_segment->get_typed_value(chunk_offset), value_segment->get_typed_value(chunk_offset));
+    EXPECT_EQ(decompressed_values[chunk_offset], *value_segment->get_typed_value(chunk_offset));
+  }
+}
+
+TEST_F(StorageALPSegmentTest, Exceptions) {
+  auto value_segment = std::make_shared<ValueSegment<float>>(true);
+  value_segment->append(1.5f);
+  value_segment->append(std::numeric_limits<float>::infinity());
+  value_segment->append(NULL_VALUE);
+  value_segment->append(-0.0f);
+  value_segment->append(2.25f);
+  value_segment->append(std::nanf(""));
+  value_segment->append(3e30f);
+  auto alp_segment = compress(value_segment);
+  ASSERT_TRUE(alp_segment);
+
+  EXPECT_EQ(alp_segment->exponent(), 2u);
+  EXPECT_EQ(alp_segment->exception_positions(), pmr_vector<ChunkOffset>({1, 3, 5, 6}));
+  ASSERT_TRUE(alp_segment->null_values());
+  EXPECT_EQ(*alp_segment->null_values(), pmr_vector<bool>({false, false, true, false, false, false, false}));
+
+  EXPECT_EQ(alp_segment->get_typed_value(ChunkOffset{0}), 1.5f);
+  EXPECT_EQ(alp_segment->get_typed_value(ChunkOffset{1}), std::numeric_limits<float>::infinity());
+  EXPECT_FALSE(alp_segment->get_typed_value(ChunkOffset{2}));
+  EXPECT_TRUE(std::signbit(*alp_segment->get_typed_value(ChunkOffset{3})));
+  EXPECT_EQ((*alp_segment)[ChunkOffset{4}], AllTypeVariant{2.25f});
+  EXPECT_TRUE(std::isnan(*alp_segment->get_typed_value(ChunkOffset{5})));
+  EXPECT_EQ(alp_segment->get_typed_value(ChunkOffset{6}), 3e30f);
+
+  const auto decompressed_values = alp_segment->decompress();
+  EXPECT_EQ(decompressed_values[4], 2.25f);
+  EXPECT_TRUE(std::isnan(decompressed_values[5]));
+}
+
+TEST_F(StorageALPSegmentTest, RoundTrip) {
+  // Values that are not decimals with few digits have to be stored as exceptions, but must be decoded exactly
+  auto value_segment = std::make_shared<ValueSegment<double>>();
+  for (auto index = 1; index < 500; ++index) {
+    value_segment->append(index % 2 ? 1.0 / index : index * 0.1);
+  }
+  auto alp_segment = compress(value_segment);
+  ASSERT_TRUE(alp_segment);
+
+  auto values = std::vector<double>{};
+  create_iterable_from_segment<double>(*alp_segment).for_each([&](const auto& position) {
+    values.push_back(position.value());
+  });
+  ASSERT_EQ(values.size(), value_segment->size());
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < values.size(); ++chunk_offset) {
+    EXPECT_EQ(values[chunk_offset], *value_segment->get_typed_value(chunk_offset));
+  }
+}
+
+TEST_F(StorageALPSegmentTest, IterateWithPositionFilter) {
+  auto value_segment = std::make_shared<ValueSegment<float>>(true);
+  value_segment->append(0.5f);
+  value_segment->append(NULL_VALUE);
+  value_segment->append(-7.25f);
+  value_segment->append(std::numeric_limits<float>::max());
+  auto alp_segment = compress(value_segment);
+  ASSERT_TRUE(alp_segment);
+
+  auto position_filter = std::make_shared<RowIDPosList>();
+  position_filter->guarantee_single_chunk();
+  position_filter->emplace_back(RowID{ChunkID{0}, ChunkOffset{3}});
+  position_filter->emplace_back(RowID{ChunkID{0}, ChunkOffset{1}});
+  position_filter->emplace_back(RowID{ChunkID{0}, ChunkOffset{2}});
+
+  auto values = std::vector<std::optional<float>>{};
+  create_iterable_from_segment<float>(*alp_segment).for_each(position_filter, [&](const auto& position) {
+    values.push_back(position.is_null() ? std::nullopt : std::optional<float>{position.value()});
+  });
+  EXPECT_EQ(values, std::vector<std::optional<float>>({std::numeric_limits<float>::max(), std::nullopt, -7.25f}));
+}
+
+TEST_F(StorageALPSegmentTest, CopyUsingAllocator) {
+  auto value_segment = std::make_shared<ValueSegment<double>>(true);
+  value_segment->append(4.5);
+  value_segment->append(NULL_VALUE);
+  value_segment->append(std::numeric_limits<double>::infinity());
+  auto alp_segment = compress(value_segment);
+
+  const auto copied_abstract_segment = alp_segment->copy_using_allocator(PolymorphicAllocator<size_t>{});
+  const auto copied_segment = std::dynamic_pointer_cast<ALPSegment<double>>(copied_abstract_segment);
+  ASSERT_TRUE(copied_segment);
+  EXPECT_EQ(copied_segment->size(), 3u);
+  EXPECT_EQ(copied_segment->exponent(), alp_segment->exponent());
+  EXPECT_EQ(copied_segment->exception_values(), alp_segment->exception_values());
+  EXPECT_EQ(copied_segment->null_values(), alp_segment->null_values());
+  EXPECT_EQ(copied_segment->get_typed_value(ChunkOffset{0}), 4.5);
+}
+
+}  // namespace opossum
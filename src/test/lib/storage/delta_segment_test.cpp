@@ -0,0 +1,174 @@
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "all_type_variant.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/create_iterable_from_segment.hpp"
+#include "storage/delta_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageDeltaSegmentTest : public BaseTest {
+ protected:
+  template <typename T>
+  std::shared_ptr<DeltaSegment<T>> compress(const std::shared_ptr<ValueSegment<T>>& segment) {
+    auto encoded_segment =
+        ChunkEncoder::encode_segment(segment, data_type_from_type<T>(), SegmentEncodingSpec{EncodingType::Delta});
+    return std::dynamic_pointer_cast<DeltaSegment<T>>(encoded_segment);
+  }
+};
+
+TEST_F(StorageDeltaSegmentTest, CompressSortedSegment) {
+  // Timestamps in microseconds with a fixed interval are encoded with a single minimum delta and zero offsets
+  auto value_segment = std::make_shared<ValueSegment<int64_t>>();
+  const auto row_count = DeltaSegment<int64_t>::block_size * 2 + 5;
+  for (auto index = int64_t{0}; index < row_count; ++index) {
+    value_segment->append(int64_t{1'600'000'000'000'000} + index * 1'000'000);
+  }
+  auto delta_segment = compress(value_segment);
+  ASSERT_TRUE(delta_segment);
+
+  EXPECT_EQ(delta_segment->size(), row_count);
+  EXPECT_EQ(delta_segment->block_bases().size(), 3u);
+  EXPECT_EQ(delta_segment->block_minimum_deltas(), pmr_vector<int64_t>(3, 1'000'000));
+  EXPECT_FALSE(delta_segment->null_values());
+  resolve_compressed_vector_type(delta_segment->offset_values(), [&](const auto& offset_values) {
+    for (auto offset_it = offset_values.cbegin(); offset_it != offset_values.cend(); ++offset_it) {
+      EXPECT_EQ(*offset_it, 0u);
+    }
+  });
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    EXPECT_EQ(delta_segment->get_typed_value(chunk_offset), value_segment->get_typed_value(chunk_offset));
+  }
+}
+
+TEST_F(StorageDeltaSegmentTest, CompressNullableSegment) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>(true);
+  value_segment->append(NULL_VALUE);
+  value_segment->append(17);
+  value_segment->append(NULL_VALUE);
+  value_segment->append(12);
+  value_segment->append(20);
+  auto delta_segment = compress(value_segment);
+  ASSERT_TRUE(delta_segment);
+
+  ASSERT_TRUE(delta_segment->null_values());
+  EXPECT_EQ(*delta_segment->null_values(), pmr_vector<bool>({true, false, true, false, false}));
+
+  // Leading null values take the first non-null value, other null values repeat the previous value
+  EXPECT_EQ(delta_segment->block_bases().front(), 17);
+  EXPECT_EQ(delta_segment->block_minimum_deltas().front(), -5);
+
+  EXPECT_FALSE(delta_segment->get_typed_value(ChunkOffset{0}));
+  EXPECT_EQ(delta_segment->get_typed_value(ChunkOffset{1}), 17);
+  EXPECT_FALSE(delta_segment->get_typed_value(ChunkOffset{2}));
+  EXPECT_EQ((*delta_segment)[ChunkOffset{3}], AllTypeVariant{12});
+  EXPECT_EQ((*delta_segment)[ChunkOffset{4}], AllTypeVariant{20});
+}
+
+TEST_F(StorageDeltaSegmentTest, ExtremeValues) {
+  // The differences of these values do not fit into int32_t, but their deltas modulo 2^32 do
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  value_segment->append(std::numeric_limits<int32_t>::min());
+  value_segment->append(std::numeric_limits<int32_t>::max());
+  value_segment->append(std::numeric_limits<int32_t>::min());
+  value_segment->append(0);
+  auto delta_segment = compress(value_segment);
+  ASSERT_TRUE(delta_segment);
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_segment->size(); ++chunk_offset) {
+    EXPECT_EQ(delta_segment->get_typed_value(chunk_offset), value_segment->get_typed_value(chunk_offset));
+  }
+}
+
+TEST_F(StorageDeltaSegmentTest, FullRangeInt64Values) {
+  // Deltas that do not fit into the frame of the block's minimum delta are stored as exceptions
+  auto value_segment = std::make_shared<ValueSegment<int64_t>>(true);
+  for (const auto value : {AllTypeVariant{int64_t{0}}, AllTypeVariant{int64_t{5}},
+                           AllTypeVariant{std::numeric_limits<int64_t>::max()}, NULL_VALUE,
+                           AllTypeVariant{std::numeric_limits<int64_t>::min()}, AllTypeVariant{int64_t{0}},
+                           AllTypeVariant{int64_t{10}}, AllTypeVariant{int64_t{15}}}) {
+    value_segment->append(value);
+  }
+  for (auto index = int64_t{0}; index < DeltaSegment<int64_t>::block_size; ++index) {
+    value_segment->append((index % 2 == 0 ? 1 : -1) * index * 10'000'000'000'000'000);
+  }
+  auto delta_segment = compress(value_segment);
+  ASSERT_TRUE(delta_segment);
+
+  // The small deltas of the first block (-15 to 10) share a frame, the jumps to and from the extreme values do not
+  EXPECT_EQ(delta_segment->block_minimum_deltas().front(), -15);
+  ASSERT_GE(delta_segment->exception_positions().size(), 2u);
+  EXPECT_EQ(delta_segment->exception_positions()[0], 2u);
+  EXPECT_EQ(delta_segment->exception_positions()[1], 5u);
+  EXPECT_EQ(delta_segment->exception_values()[0], std::numeric_limits<int64_t>::max());
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_segment->size(); ++chunk_offset) {
+    EXPECT_EQ(delta_segment->get_typed_value(chunk_offset), value_segment->get_typed_value(chunk_offset));
+  }
+
+  auto chunk_offset = ChunkOffset{0};
+  create_iterable_from_segment<int64_t>(*delta_segment).for_each([&](const auto& position) {
+    EXPECT_EQ(position.is_null(), value_segment->is_null(chunk_offset));
+    if (!position.is_null()) {
+      EXPECT_EQ(position.value(), value_segment->get(chunk_offset));
+    }
+    ++chunk_offset;
+  });
+  EXPECT_EQ(chunk_offset, value_segment->size());
+}
+
+TEST_F(StorageDeltaSegmentTest, IterateWithPositionFilter) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>();
+  const auto row_count = DeltaSegment<int32_t>::block_size * 3;
+  for (auto index = int32_t{0}; index < static_cast<int32_t>(row_count); ++index) {
+    value_segment->append(index * index % 1'000);
+  }
+  auto delta_segment = compress(value_segment);
+  ASSERT_TRUE(delta_segment);
+
+  // Positions are not sorted, so that the iterator has to restart decoding at the beginning of a block
+  auto position_filter = std::make_shared<RowIDPosList>();
+  position_filter->guarantee_single_chunk();
+  for (const auto chunk_offset : {300u, 5u, 6u, 200u, 129u, 128u, 383u, 0u}) {
+    position_filter->emplace_back(RowID{ChunkID{0}, ChunkOffset{chunk_offset}});
+  }
+
+  auto values = std::vector<int32_t>{};
+  create_iterable_from_segment<int32_t>(*delta_segment).for_each(position_filter, [&](const auto& position) {
+    EXPECT_FALSE(position.is_null());
+    values.push_back(position.value());
+  });
+
+  auto expected_values = std::vector<int32_t>{};
+  for (const auto& row_id : *position_filter) {
+    expected_values.push_back(*value_segment->get_typed_value(row_id.chunk_offset));
+  }
+  EXPECT_EQ(values, expected_values);
+}
+
+TEST_F(StorageDeltaSegmentTest, CopyUsingAllocator) {
+  auto value_segment = std::make_shared<ValueSegment<int32_t>>(true);
+  value_segment->append(4);
+  value_segment->append(NULL_VALUE);
+  value_segment->append(8);
+  auto delta_segment = compress(value_segment);
+
+  const auto copied_abstract_segment = delta_segment->copy_using_allocator(PolymorphicAllocator<size_t>{});
+  const auto copied_segment = std::dynamic_pointer_cast<DeltaSegment<int32_t>>(copied_abstract_segment);
+  ASSERT_TRUE(copied_segment);
+  EXPECT_EQ(copied_segment->size(), 3u);
+  EXPECT_EQ(copied_segment->block_bases(), delta_segment->block_bases());
+  EXPECT_EQ(copied_segment->null_values(), delta_segment->null_values());
+  EXPECT_EQ(copied_segment->get_typed_value(ChunkOffset{2}), 8);
+}
+
+}  // namespace opossum
@@ -1,4 +1,5 @@
 #include <cctype>
+#include <limits>
 #include <memory>
 #include <sstream>
 
@@ -732,4 +733,54 @@ TEST_F(EncodedSegmentTest, FrameOfReference) {
   EXPECT_FALSE(for_segment_no_nulls->null_values());
 }
 
+// The value range of int64_t blocks might exceed the range of the uint32_t offsets. The values that do not fit into the
+// frame are stored as exceptions.
+TEST_F(EncodedSegmentTest, FrameOfReferenceFullRangeInt64) {
+  constexpr auto frame_size = int64_t{std::numeric_limits<uint32_t>::max()};
+  const auto value_segment = std::make_shared<ValueSegment<int64_t>>(true);
+  for (const auto value : {AllTypeVariant{int64_t{10}}, AllTypeVariant{int64_t{20}},
+                           AllTypeVariant{std::numeric_limits<int64_t>::max()}, NULL_VALUE,
+                           AllTypeVariant{std::numeric_limits<int64_t>::min()}, AllTypeVariant{int64_t{30}},
+                           AllTypeVariant{10 + frame_size}, AllTypeVariant{11 + frame_size}}) {
+    value_segment->append(value);
+  }
+
+  const auto encoded_segment =
+      this->_encode_segment(value_segment, DataType::Long, SegmentEncodingSpec{EncodingType::FrameOfReference});
+  const auto for_segment = std::dynamic_pointer_cast<const FrameOfReferenceSegment<int64_t>>(encoded_segment);
+  ASSERT_TRUE(for_segment);
+
+  // The frame starting at 10 contains the most values
+  EXPECT_EQ(for_segment->block_minima(), pmr_vector<int64_t>{10});
+  EXPECT_EQ(for_segment->exception_positions(), pmr_vector<ChunkOffset>({2, 4, 7}));
+  EXPECT_EQ(for_segment->exception_values(),
+            pmr_vector<int64_t>({std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(),
+                                 11 + frame_size}));
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < value_segment->size(); ++chunk_offset) {
+    EXPECT_EQ(for_segment->get_typed_value(chunk_offset), value_segment->get_typed_value(chunk_offset));
+  }
+
+  auto chunk_offset = ChunkOffset{0};
+  create_iterable_from_segment<int64_t>(*for_segment).for_each([&](const auto& position) {
+    EXPECT_EQ(position.is_null(), value_segment->is_null(chunk_offset));
+    if (!position.is_null()) {
+      EXPECT_EQ(position.value(), value_segment->get(chunk_offset));
+    }
+    ++chunk_offset;
+  });
+  EXPECT_EQ(chunk_offset, value_segment->size());
+
+  auto position_filter = std::make_shared<RowIDPosList>();
+  position_filter->guarantee_single_chunk();
+  for (const auto filtered_chunk_offset : {7u, 2u, 0u, 6u}) {
+    position_filter->emplace_back(RowID{ChunkID{0}, ChunkOffset{filtered_chunk_offset}});
+  }
+  auto values = std::vector<int64_t>{};
+  create_iterable_from_segment<int64_t>(*for_segment).for_each(position_filter, [&](const auto& position) {
+    values.push_back(position.value());
+  });
+  EXPECT_EQ(values, std::vector<int64_t>({11 + frame_size, std::numeric_limits<int64_t>::max(), 10, 10 + frame_size}));
+}
+
 }  // namespace opossum
@@ -0,0 +1,153 @@
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "all_type_variant.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/fsst_segment.hpp"
+#include "storage/fsst_segment/fsst_encoder.hpp"
+#include "storage/fsst_segment/fsst_symbol_table.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class StorageFSSTSegmentTest : public BaseTest {
+ protected:
+  std::shared_ptr<FSSTSegment<pmr_string>> compress(const std::shared_ptr<ValueSegment<pmr_string>>& segment) {
+    auto encoded_segment =
+        ChunkEncoder::encode_segment(segment, DataType::String, SegmentEncodingSpec{EncodingType::FSST});
+    return std::dynamic_pointer_cast<FSSTSegment<pmr_string>>(encoded_segment);
+  }
+
+  std::shared_ptr<ValueSegment<pmr_string>> vs_str = std::make_shared<ValueSegment<pmr_string>>(true);
+};
+
+TEST_F(StorageFSSTSegmentTest, CompressNullableStringSegment) {
+  vs_str->append("Alex");
+  vs_str->append("Peter");
+  vs_str->append("Ralf");
+  vs_str->append("");
+  vs_str->append(NULL_VALUE);
+  vs_str->append("Anna");
+  auto fsst_segment = compress(vs_str);
+  ASSERT_TRUE(fsst_segment);
+
+  EXPECT_EQ(fsst_segment->size(), 6u);
+  EXPECT_EQ(fsst_segment->offsets().size(), 7u);
+
+  const auto& null_values = fsst_segment->null_values();
+  ASSERT_TRUE(null_values);
+  EXPECT_EQ(*null_values, pmr_vector<bool>({false, false, false, false, true, false}));
+
+  // Empty strings and null values have no codes
+  EXPECT_TRUE(fsst_segment->compressed_value(ChunkOffset{3}).empty());
+  EXPECT_TRUE(fsst_segment->compressed_value(ChunkOffset{4}).empty());
+
+  EXPECT_EQ(fsst_segment->get_typed_value(ChunkOffset{0}), pmr_string{"Alex"});
+  EXPECT_EQ(fsst_segment->get_typed_value(ChunkOffset{3}), pmr_string{""});
+  EXPECT_FALSE(fsst_segment->get_typed_value(ChunkOffset{4}));
+  EXPECT_EQ((*fsst_segment)[ChunkOffset{4}], AllTypeVariant{NULL_VALUE});
+  EXPECT_EQ((*fsst_segment)[ChunkOffset{5}], AllTypeVariant{pmr_string{"Anna"}});
+
+  const auto decompressed_data = fsst_segment->decompress();
+  EXPECT_EQ(decompressed_data, std::vector<pmr_string>({"Alex", "Peter", "Ralf", "", "", "Anna"}));
+}
+
+TEST_F(StorageFSSTSegmentTest, HandleOptionalNullValues) {
+  auto empty_segment = compress(vs_str);
+  EXPECT_EQ(empty_segment->size(), 0u);
+  EXPECT_FALSE(empty_segment->null_values());
+  EXPECT_TRUE(empty_segment->symbol_table().symbols().empty());
+
+  vs_str->append("Alex");
+  vs_str->append("Peter");
+  auto fsst_segment = compress(vs_str);
+  EXPECT_FALSE(fsst_segment->null_values());
+}
+
+TEST_F(StorageFSSTSegmentTest, CompressRepetitiveStrings) {
+  constexpr auto row_count = size_t{1000};
+  for (auto index = size_t{0}; index < row_count; ++index) {
+    vs_str->append(pmr_string{"https://www.hyrise.org/"} + pmr_string{std::to_string(index % 100)});
+  }
+  auto fsst_segment = compress(vs_str);
+
+  // The common prefix is covered by (mostly eight-byte) symbols, so the codes are much smaller than the strings
+  EXPECT_LT(fsst_segment->compressed_values().size(), row_count * 10);
+
+  for (auto index = size_t{0}; index < row_count; ++index) {
+    EXPECT_EQ(fsst_segment->get_typed_value(static_cast<ChunkOffset>(index)), vs_str->get_typed_value(index));
+  }
+}
+
+TEST_F(StorageFSSTSegmentTest, CompressedEquality) {
+  vs_str->append("Hyrise");
+  vs_str->append("Hyrise is a database");
+  vs_str->append("Hyrise");
+  vs_str->append("Hyris");
+  auto fsst_segment = compress(vs_str);
+
+  // Codes are equal iff the strings are equal
+  EXPECT_EQ(fsst_segment->compressed_value(ChunkOffset{0}), fsst_segment->compressed_value(ChunkOffset{2}));
+  EXPECT_NE(fsst_segment->compressed_value(ChunkOffset{0}), fsst_segment->compressed_value(ChunkOffset{1}));
+  EXPECT_NE(fsst_segment->compressed_value(ChunkOffset{0}), fsst_segment->compressed_value(ChunkOffset{3}));
+
+  // Strings that were not part of the segment are compressed with the same table
+  auto codes = pmr_vector<char>{};
+  fsst_segment->symbol_table().compress("Hyrise", codes);
+  EXPECT_EQ(std::string_view(codes.data(), codes.size()), fsst_segment->compressed_value(ChunkOffset{0}));
+}
+
+TEST_F(StorageFSSTSegmentTest, StartsWith) {
+  vs_str->append("Hyrise is a database");
+  vs_str->append("Hyrise");
+  vs_str->append("Hy");
+  vs_str->append("Postgres");
+  vs_str->append("");
+  auto fsst_segment = compress(vs_str);
+  const auto& symbol_table = fsst_segment->symbol_table();
+
+  EXPECT_TRUE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{0}), "Hyrise"));
+  EXPECT_TRUE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{0}), "Hyrise is a"));
+  EXPECT_TRUE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{1}), "Hyrise"));
+  EXPECT_TRUE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{1}), "Hyr"));
+  EXPECT_FALSE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{2}), "Hyrise"));
+  EXPECT_FALSE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{3}), "Hyrise"));
+  EXPECT_FALSE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{4}), "H"));
+
+  // Every string starts with the empty prefix
+  EXPECT_TRUE(symbol_table.starts_with(fsst_segment->compressed_value(ChunkOffset{4}), ""));
+}
+
+TEST_F(StorageFSSTSegmentTest, SymbolTableOrder) {
+  auto symbols = pmr_vector<FSSTSymbolTable::Symbol>(2);
+  symbols[0] = {'b', 'c'};
+  symbols[1] = {'a'};
+  auto symbol_lengths = pmr_vector<uint8_t>{2, 1};
+
+  // Symbols have to be sorted by their first byte
+  EXPECT_THROW(FSSTSymbolTable(std::move(symbols), std::move(symbol_lengths)), std::logic_error);
+}
+
+TEST_F(StorageFSSTSegmentTest, CopyUsingAllocator) {
+  vs_str->append("Alex");
+  vs_str->append(NULL_VALUE);
+  vs_str->append("Alexander");
+  auto fsst_segment = compress(vs_str);
+
+  const auto copied_abstract_segment = fsst_segment->copy_using_allocator(PolymorphicAllocator<size_t>{});
+  const auto copied_segment = std::dynamic_pointer_cast<FSSTSegment<pmr_string>>(copied_abstract_segment);
+  ASSERT_TRUE(copied_segment);
+  EXPECT_EQ(copied_segment->size(), 3u);
+  EXPECT_EQ(copied_segment->decompress(), fsst_segment->decompress());
+  EXPECT_EQ(copied_segment->null_values(), fsst_segment->null_values());
+  EXPECT_EQ(copied_segment->symbol_table().symbol_lengths(), fsst_segment->symbol_table().symbol_lengths());
+}
+
+}  // namespace opossum
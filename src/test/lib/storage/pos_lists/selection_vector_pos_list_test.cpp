@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "storage/pos_lists/selection_vector_pos_list.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class SelectionVectorPosListTest : public BaseTest {};
+
+TEST_F(SelectionVectorPosListTest, Access) {
+  const auto pos_list = SelectionVectorPosList{ChunkID{3}, pmr_vector<ChunkOffset>{1, 4, 5}};
+
+  EXPECT_TRUE(pos_list.references_single_chunk());
+  EXPECT_EQ(pos_list.common_chunk_id(), ChunkID{3});
+  EXPECT_EQ(pos_list.size(), 3);
+  EXPECT_FALSE(pos_list.empty());
+  EXPECT_EQ(pos_list[1], (RowID{ChunkID{3}, ChunkOffset{4}}));
+
+  const auto expected_pos_list = RowIDPosList{RowID{ChunkID{3}, ChunkOffset{1}}, RowID{ChunkID{3}, ChunkOffset{4}},
+                                              RowID{ChunkID{3}, ChunkOffset{5}}};
+  EXPECT_TRUE(std::equal(pos_list.cbegin(), pos_list.cend(), expected_pos_list.cbegin(), expected_pos_list.cend()));
+
+  // Half the size of a RowIDPosList
+  EXPECT_EQ(pos_list.memory_usage(MemoryUsageCalculationMode::Full), 3 * sizeof(ChunkOffset));
+
+  EXPECT_TRUE(SelectionVectorPosList(ChunkID{0}, pmr_vector<ChunkOffset>{}).empty());
+}
+
+TEST_F(SelectionVectorPosListTest, CreatedByTableScan) {
+  const auto table = load_table("resources/test_data/tbl/int_float.tbl", 3);
+  const auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+  const auto table_scan = std::make_shared<TableScan>(table_wrapper, greater_than_(a, 1'000));
+  table_scan->execute();
+
+  // Scanning a scan result works on the SelectionVectorPosList of the referenced chunk
+  const auto second_table_scan = std::make_shared<TableScan>(table_scan, greater_than_(a, 1'234));
+  second_table_scan->execute();
+
+  for (const auto& scan : {table_scan, second_table_scan}) {
+    const auto& output_table = scan->get_output();
+    ASSERT_EQ(output_table->chunk_count(), 1);
+
+    const auto segment = output_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+    const auto& reference_segment = static_cast<const ReferenceSegment&>(*segment);
+    const auto pos_list = std::dynamic_pointer_cast<const SelectionVectorPosList>(reference_segment.pos_list());
+    ASSERT_TRUE(pos_list);
+    EXPECT_EQ(pos_list->common_chunk_id(), ChunkID{0});
+  }
+
+  auto values = std::vector<int32_t>{};
+  segment_iterate<int32_t>(*second_table_scan->get_output()->get_chunk(ChunkID{0})->get_segment(ColumnID{0}),
+                           [&](const auto& position) { values.emplace_back(position.value()); });
+  EXPECT_EQ(values, std::vector<int32_t>{12'345});
+}
+
+}  // namespace opossum
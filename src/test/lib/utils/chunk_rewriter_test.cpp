@@ -0,0 +1,85 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "operators/delete.hpp"
+#include "operators/sort.hpp"
+#include "storage/table.hpp"
+#include "utils/chunk_rewriter.hpp"
+
+namespace opossum {
+
+class ChunkRewriterTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                     ChunkOffset{4}, UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table(_table_name, _table);
+
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    insert_rows(_table_name, {{1}, {2}, {3}, {4}, {5}, {6}}, transaction_context);
+    transaction_context->commit();
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  const std::string _table_name{"table_a"};
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(ChunkRewriterTest, RewritesChunks) {
+  const auto order_rows = [](const std::shared_ptr<AbstractOperator>& validate) -> std::shared_ptr<AbstractOperator> {
+    const auto sort_definition = SortColumnDefinition{ColumnID{0}, SortMode::Descending};
+    return std::make_shared<Sort>(validate, std::vector<SortColumnDefinition>{sort_definition});
+  };
+
+  auto old_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_TRUE(ChunkRewriter::rewrite_chunks(_table_name, {ChunkID{0}}, order_rows, transaction_context));
+
+  EXPECT_EQ(_table->get_chunk(ChunkID{0})->get_cleanup_commit_id(), transaction_context->commit_id());
+  EXPECT_FALSE(_table->get_chunk(ChunkID{1})->get_cleanup_commit_id());
+  EXPECT_EQ(visible_row_count(_table_name), 6u);
+
+  // The rows of the first chunk are reinserted into a fresh chunk in the given order
+  ASSERT_EQ(_table->chunk_count(), 3u);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 6u), 4);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 9u), 1);
+
+  // The rewritten chunk is still visible to the old transaction
+  auto chunk_rewriter = ChunkRewriter{};
+  chunk_rewriter.queue_physical_delete(_table, {ChunkID{0}});
+  chunk_rewriter.delete_chunks_physically();
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0}));
+  EXPECT_EQ(validate_table(_table_name, old_transaction_context)->get_output()->row_count(), 6u);
+
+  old_transaction_context = nullptr;
+  chunk_rewriter.delete_chunks_physically();
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0}));
+  EXPECT_EQ(visible_row_count(_table_name), 6u);
+}
+
+TEST_F(ChunkRewriterTest, RollsBackOnConflict) {
+  // Another transaction deletes all rows but has not committed yet
+  auto conflicting_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto delete_op = std::make_shared<Delete>(validate_table(_table_name, conflicting_transaction_context));
+  delete_op->set_transaction_context(conflicting_transaction_context);
+  delete_op->execute();
+  ASSERT_FALSE(delete_op->execute_failed());
+
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_FALSE(ChunkRewriter::rewrite_chunks(_table_name, {ChunkID{0}}, {}, transaction_context));
+  EXPECT_EQ(transaction_context->phase(), TransactionPhase::RolledBackAfterConflict);
+
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0})->get_cleanup_commit_id());
+  EXPECT_EQ(_table->chunk_count(), 2u);
+
+  conflicting_transaction_context->rollback(RollbackReason::User);
+  EXPECT_EQ(visible_row_count(_table_name), 6u);
+}
+
+}  // namespace opossum
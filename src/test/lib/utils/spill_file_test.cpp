@@ -0,0 +1,48 @@
+#include <filesystem>
+#include <numeric>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "utils/spill_file.hpp"
+
+namespace opossum {
+
+class SpillFileTest : public BaseTest {};
+
+TEST_F(SpillFileTest, WriteAndRead) {
+  auto values = std::vector<uint64_t>(1'000);
+  std::iota(values.begin(), values.end(), uint64_t{17});
+
+  auto path = std::filesystem::path{};
+  {
+    auto spill_file = SpillFile{};
+    path = spill_file.path();
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    spill_file.write(values.data(), 600 * sizeof(uint64_t));
+    spill_file.write(values.data() + 600, 400 * sizeof(uint64_t));
+    EXPECT_EQ(spill_file.size(), 1'000 * sizeof(uint64_t));
+    spill_file.finish_writing();
+
+    // Reading stops at the end of the file
+    auto read_values = std::vector<uint64_t>(1'200);
+    EXPECT_EQ(spill_file.read(read_values.data(), 700 * sizeof(uint64_t)), 700 * sizeof(uint64_t));
+    EXPECT_EQ(spill_file.read(read_values.data() + 700, 500 * sizeof(uint64_t)), 300 * sizeof(uint64_t));
+    EXPECT_EQ(spill_file.read(read_values.data(), sizeof(uint64_t)), 0);
+
+    read_values.resize(1'000);
+    EXPECT_EQ(read_values, values);
+  }
+
+  // The file is removed with the SpillFile
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(SpillFileTest, UniquePaths) {
+  const auto spill_file_a = SpillFile{};
+  const auto spill_file_b = SpillFile{};
+  EXPECT_NE(spill_file_a.path(), spill_file_b.path());
+}
+
+}  // namespace opossum
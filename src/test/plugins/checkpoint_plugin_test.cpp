@@ -0,0 +1,75 @@
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+#include "base_test.hpp"
+
+#include "../../plugins/checkpoint_plugin.hpp"
+#include "hyrise.hpp"
+#include "logging/redo_log.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class CheckpointPluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    std::filesystem::remove_all(directory);
+    Hyrise::get().storage_manager.add_table("table_a", load_table("resources/test_data/tbl/int_float.tbl", 2));
+  }
+
+  void TearDown() override {
+    Hyrise::reset();
+    std::filesystem::remove_all(directory);
+  }
+
+ protected:
+  static void _checkpoint_loop(CheckpointPlugin& plugin) { plugin._checkpoint_loop(); }
+
+  static std::optional<CommitID> _last_checkpoint_commit_id(const CheckpointPlugin& plugin) {
+    return plugin._last_checkpoint_commit_id;
+  }
+
+  size_t _checkpoint_count() const {
+    auto checkpoint_count = size_t{0};
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+      if (entry.path().filename().string().starts_with(RedoLog::CHECKPOINT_PREFIX)) ++checkpoint_count;
+    }
+    return checkpoint_count;
+  }
+
+  const std::filesystem::path directory = test_data_path + "checkpoint_plugin_test";
+};
+
+TEST_F(CheckpointPluginTest, WritesCheckpointOnlyIfRedoLogIsSet) {
+  auto plugin = CheckpointPlugin{};
+  _checkpoint_loop(plugin);
+  EXPECT_FALSE(std::filesystem::exists(directory));
+
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+  _checkpoint_loop(plugin);
+  EXPECT_EQ(_checkpoint_count(), 1);
+  EXPECT_EQ(_last_checkpoint_commit_id(plugin), Hyrise::get().transaction_manager.last_commit_id());
+}
+
+TEST_F(CheckpointPluginTest, SkipsCheckpointWithoutNewCommits) {
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory);
+
+  auto plugin = CheckpointPlugin{};
+  _checkpoint_loop(plugin);
+  const auto checkpoint_path = directory / (RedoLog::CHECKPOINT_PREFIX +
+                                            std::to_string(Hyrise::get().transaction_manager.last_commit_id()));
+  const auto write_time = std::filesystem::last_write_time(checkpoint_path / Checkpoint::MANIFEST_FILE_NAME);
+
+  _checkpoint_loop(plugin);
+  EXPECT_EQ(std::filesystem::last_write_time(checkpoint_path / Checkpoint::MANIFEST_FILE_NAME), write_time);
+
+  auto pipeline = SQLPipelineBuilder{std::string{"DELETE FROM table_a WHERE a = 123"}}.create_pipeline();
+  pipeline.get_result_table();
+
+  _checkpoint_loop(plugin);
+  EXPECT_FALSE(std::filesystem::exists(checkpoint_path));
+  EXPECT_EQ(_checkpoint_count(), 1);
+}
+
+}  // namespace opossum
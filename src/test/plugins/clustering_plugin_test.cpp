@@ -0,0 +1,237 @@
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "../../plugins/clustering_plugin.hpp"
+#include "../../plugins/delta_merge_plugin.hpp"
+#include "hyrise.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class ClusteringPluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // A 64x64 grid of (a, b) in random order, so that every chunk covers almost all values of both columns
+    _table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}},
+                                     TableType::Data, _chunk_size, UseMvcc::Yes);
+    for (auto row = uint32_t{0}; row < _chunk_size * _chunk_size; ++row) {
+      const auto position = static_cast<int32_t>((row * 2'654'435'761u) % (_chunk_size * _chunk_size));
+      _table->append({position / 64, position % 64});
+    }
+    _table->last_chunk()->finalize();
+    ChunkEncoder::encode_all_chunks(_table);
+    Hyrise::get().storage_manager.add_table(_table_name, _table);
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  static std::optional<std::vector<ChunkID>> _cluster_table(const std::string& table_name, const ClusteringType type,
+                                                            const std::vector<ColumnID>& column_ids) {
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    return ClusteringPlugin::_cluster_table(table_name, type, column_ids, transaction_context);
+  }
+
+  static size_t _finalize_fresh_chunks(const std::shared_ptr<Table>& table, const ChunkID first_chunk_id,
+                                       const CommitID commit_id) {
+    return ClusteringPlugin::_finalize_fresh_chunks(table, first_chunk_id, commit_id, std::nullopt,
+                                                    ChunkEncodingSpec{2, SegmentEncodingSpec{EncodingType::LZ4}});
+  }
+
+  static size_t _delta_merge_finalize_chunks(const std::shared_ptr<Table>& table) {
+    return DeltaMergePlugin::_finalize_chunks(table, std::nullopt);
+  }
+
+  static void _clustering_loop(ClusteringPlugin& plugin, const std::shared_ptr<ClusteringSetting>& setting) {
+    plugin._clustering_setting = setting;
+    plugin._clustering_loop();
+  }
+
+  // Returns the number of current chunks that cannot be pruned for `a < a_upper AND b < b_upper`
+  size_t _unpruned_chunk_count(const int32_t a_upper, const int32_t b_upper) const {
+    auto unpruned_chunk_count = size_t{0};
+    const auto chunk_count = _table->chunk_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = _table->get_chunk(chunk_id);
+      if (!chunk || chunk->get_cleanup_commit_id() || chunk->size() == 0) continue;
+
+      const auto& pruning_statistics = chunk->pruning_statistics();
+      EXPECT_TRUE(pruning_statistics);
+      const auto can_prune = [&](const ColumnID column_id, const int32_t upper) {
+        const auto& statistics = static_cast<const AttributeStatistics<int32_t>&>(*(*pruning_statistics)[column_id]);
+        return statistics.range_filter->does_not_contain(PredicateCondition::LessThan, upper);
+      };
+      if (!can_prune(ColumnID{0}, a_upper) && !can_prune(ColumnID{1}, b_upper)) ++unpruned_chunk_count;
+    }
+    return unpruned_chunk_count;
+  }
+
+  static constexpr auto _chunk_size = ChunkOffset{64};
+  const std::string _table_name{"clustering_table"};
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(ClusteringPluginTest, ZOrderKey) {
+  EXPECT_EQ(ClusteringPlugin::z_order_key({0b00, 0b00}, 2), 0b0000u);
+  EXPECT_EQ(ClusteringPlugin::z_order_key({0b01, 0b00}, 2), 0b0010u);
+  EXPECT_EQ(ClusteringPlugin::z_order_key({0b00, 0b01}, 2), 0b0001u);
+  EXPECT_EQ(ClusteringPlugin::z_order_key({0b10, 0b11}, 2), 0b1101u);
+}
+
+TEST_F(ClusteringPluginTest, HilbertKey) {
+  // Consecutive positions on the curve are neighbors
+  auto points = std::vector<std::vector<uint32_t>>(64);
+  for (auto x = uint32_t{0}; x < 8; ++x) {
+    for (auto y = uint32_t{0}; y < 8; ++y) {
+      const auto key = ClusteringPlugin::hilbert_key({x, y}, 3);
+      ASSERT_LT(key, 64u);
+      EXPECT_TRUE(points[key].empty());
+      points[key] = {x, y};
+    }
+  }
+
+  for (auto key = size_t{1}; key < points.size(); ++key) {
+    const auto distance = std::abs(static_cast<int32_t>(points[key][0]) - static_cast<int32_t>(points[key - 1][0])) +
+                          std::abs(static_cast<int32_t>(points[key][1]) - static_cast<int32_t>(points[key - 1][1]));
+    EXPECT_EQ(distance, 1);
+  }
+}
+
+TEST_F(ClusteringPluginTest, ClustersOnZOrderCurve) {
+  EXPECT_EQ(_unpruned_chunk_count(8, 8), 64u);
+
+  const auto clustered_chunk_ids = _cluster_table(_table_name, ClusteringType::ZOrder, {ColumnID{0}, ColumnID{1}});
+  ASSERT_TRUE(clustered_chunk_ids);
+  EXPECT_EQ(clustered_chunk_ids->size(), 64u);
+  EXPECT_EQ(visible_row_count(_table_name), 4096u);
+
+  // Every chunk covers an 8x8 block of the grid
+  EXPECT_EQ(_unpruned_chunk_count(8, 8), 1u);
+  EXPECT_EQ(_unpruned_chunk_count(32, 32), 16u);
+  EXPECT_EQ(_unpruned_chunk_count(64, 8), 8u);
+
+  // The fresh chunks keep the encoding of the table
+  const auto chunk = _table->last_chunk();
+  EXPECT_FALSE(chunk->is_mutable());
+  EXPECT_TRUE(chunk->individually_sorted_by().empty());
+  EXPECT_EQ(get_segment_encoding_spec(chunk->get_segment(ColumnID{0})).encoding_type, EncodingType::Dictionary);
+}
+
+TEST_F(ClusteringPluginTest, ClustersOnHilbertCurve) {
+  const auto clustered_chunk_ids = _cluster_table(_table_name, ClusteringType::Hilbert, {ColumnID{0}, ColumnID{1}});
+  ASSERT_TRUE(clustered_chunk_ids);
+  EXPECT_EQ(visible_row_count(_table_name), 4096u);
+
+  EXPECT_EQ(_unpruned_chunk_count(8, 8), 1u);
+  EXPECT_EQ(_unpruned_chunk_count(32, 32), 16u);
+  EXPECT_EQ(_unpruned_chunk_count(64, 8), 8u);
+}
+
+TEST_F(ClusteringPluginTest, ClustersSorted) {
+  const auto clustered_chunk_ids = _cluster_table(_table_name, ClusteringType::Sorted, {ColumnID{1}, ColumnID{0}});
+  ASSERT_TRUE(clustered_chunk_ids);
+  EXPECT_EQ(visible_row_count(_table_name), 4096u);
+
+  // Every chunk contains a single value of b
+  EXPECT_EQ(_unpruned_chunk_count(64, 8), 8u);
+  EXPECT_EQ(_unpruned_chunk_count(8, 64), 64u);
+
+  const auto chunk = _table->last_chunk();
+  ASSERT_EQ(chunk->individually_sorted_by().size(), 1u);
+  EXPECT_EQ(chunk->individually_sorted_by().front(), SortColumnDefinition(ColumnID{1}, SortMode::Ascending));
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, _table->row_count() - 1), 63);
+}
+
+TEST_F(ClusteringPluginTest, FreshChunksFinalizedByDeltaMerge) {
+  // The DeltaMergePlugin might finalize the fresh chunks before the ClusteringPlugin does and vice versa. Each chunk
+  // must be finalized only once.
+  const auto chunk_ids_from = [](const ChunkID first_chunk_id) {
+    auto chunk_ids = std::vector<ChunkID>(64);
+    std::iota(chunk_ids.begin(), chunk_ids.end(), first_chunk_id);
+    return chunk_ids;
+  };
+
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  ASSERT_TRUE(ChunkRewriter::rewrite_chunks(_table_name, chunk_ids_from(ChunkID{0}), {}, transaction_context));
+  EXPECT_EQ(_table->chunk_count(), 128u);
+
+  EXPECT_EQ(_delta_merge_finalize_chunks(_table), 64u);
+  EXPECT_EQ(_finalize_fresh_chunks(_table, ChunkID{64}, transaction_context->commit_id()), 0u);
+  EXPECT_EQ(get_segment_encoding_spec(_table->last_chunk()->get_segment(ColumnID{0})).encoding_type,
+            EncodingType::Dictionary);
+
+  transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  ASSERT_TRUE(ChunkRewriter::rewrite_chunks(_table_name, chunk_ids_from(ChunkID{64}), {}, transaction_context));
+  EXPECT_EQ(_finalize_fresh_chunks(_table, ChunkID{128}, transaction_context->commit_id()), 64u);
+  EXPECT_EQ(_delta_merge_finalize_chunks(_table), 0u);
+  EXPECT_EQ(get_segment_encoding_spec(_table->last_chunk()->get_segment(ColumnID{0})).encoding_type,
+            EncodingType::LZ4);
+  EXPECT_EQ(visible_row_count(_table_name), 4096u);
+}
+
+TEST_F(ClusteringPluginTest, ClusteringSetting) {
+  auto plugin = ClusteringPlugin{};
+  const auto setting = std::make_shared<ClusteringSetting>();
+  EXPECT_TRUE(setting->clustering_specs().empty());
+
+  EXPECT_THROW(setting->set("clustering_table:zorder"), std::logic_error);
+  EXPECT_THROW(setting->set("clustering_table:rtree:a,b"), std::logic_error);
+  EXPECT_THROW(setting->set("clustering_table:zorder:a,"), std::logic_error);
+  EXPECT_THROW(setting->set("clustering_table:zorder:a;clustering_table:sorted:b"), std::logic_error);
+
+  // Unknown tables and columns are skipped
+  setting->set("clustering_table:hilbert:a,c;unknown_table:sorted:a");
+  _clustering_loop(plugin, setting);
+  EXPECT_EQ(_table->chunk_count(), 64u);
+
+  setting->set("clustering_table:hilbert:a,b;unknown_table:sorted:a");
+  const auto specs = setting->clustering_specs();
+  ASSERT_EQ(specs.size(), 2u);
+  EXPECT_EQ(specs.at("clustering_table").type, ClusteringType::Hilbert);
+  EXPECT_EQ(specs.at("clustering_table").column_names, std::vector<std::string>({"a", "b"}));
+
+  _clustering_loop(plugin, setting);
+  EXPECT_EQ(_table->chunk_count(), 128u);
+  EXPECT_EQ(_unpruned_chunk_count(8, 8), 1u);
+
+  // The table is clustered again only if its spec changes
+  _clustering_loop(plugin, setting);
+  EXPECT_EQ(_table->chunk_count(), 128u);
+
+  // Removing the spec and setting it again reclusters the table
+  setting->set("");
+  _clustering_loop(plugin, setting);
+  EXPECT_EQ(_table->chunk_count(), 128u);
+
+  setting->set("clustering_table:hilbert:a,b");
+  _clustering_loop(plugin, setting);
+  EXPECT_EQ(_table->chunk_count(), 192u);
+  EXPECT_EQ(visible_row_count(_table_name), 4096u);
+}
+
+TEST_F(ClusteringPluginTest, SettingViaSQL) {
+  auto plugin = ClusteringPlugin{};
+  plugin.start();
+
+  auto pipeline = SQLPipelineBuilder{std::string{"UPDATE meta_settings SET value = 'clustering_table:zorder:a,b' "
+                                                 "WHERE name = 'ClusteringPlugin.clustering'"}}
+                      .create_pipeline();
+  pipeline.get_result_table();
+  EXPECT_EQ(Hyrise::get().settings_manager.get_setting("ClusteringPlugin.clustering")->get(),
+            "clustering_table:zorder:a,b");
+
+  plugin.stop();
+  EXPECT_FALSE(Hyrise::get().settings_manager.has_setting("ClusteringPlugin.clustering"));
+}
+
+}  // namespace opossum
@@ -0,0 +1,233 @@
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "../../plugins/delta_merge_plugin.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "logging/redo_log.hpp"
+#include "operators/delete.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class DeltaMergePluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    _table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                     ChunkOffset{4}, UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table(_table_name, _table);
+
+    Hyrise::get().storage_manager.add_table(
+        "dummy", std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                         ChunkOffset{100}, UseMvcc::Yes));
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  static size_t _finalize_chunks(const std::shared_ptr<Table>& table, const std::optional<ColumnID>& sort_column_id) {
+    return DeltaMergePlugin::_finalize_chunks(table, sort_column_id);
+  }
+
+  static std::vector<ChunkID> _merge_candidates(const std::shared_ptr<Table>& table) {
+    return DeltaMergePlugin::_merge_candidates(table);
+  }
+
+  static bool _try_merge(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                         const std::optional<ColumnID>& sort_column_id) {
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    return DeltaMergePlugin::_try_merge(table_name, chunk_ids, sort_column_id, transaction_context);
+  }
+
+  static void _queue_physical_delete(DeltaMergePlugin& plugin, const std::shared_ptr<Table>& table,
+                                     const ChunkID chunk_id) {
+    plugin._chunk_rewriter.queue_physical_delete(table, {chunk_id});
+  }
+
+  static void _delete_chunks_physically(DeltaMergePlugin& plugin) { plugin._chunk_rewriter.delete_chunks_physically(); }
+
+  void _insert(const std::vector<int32_t>& values,
+               const InsertChunkAllocation chunk_allocation = InsertChunkAllocation::LastChunk) const {
+    auto rows = std::vector<std::vector<AllTypeVariant>>{};
+    for (const auto value : values) {
+      rows.push_back({value});
+    }
+
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    insert_rows(_table_name, rows, transaction_context, chunk_allocation);
+    transaction_context->commit();
+  }
+
+  void _delete_values_less_than_or_equal_to(const int32_t value) const {
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    const auto validate = validate_table(_table_name, transaction_context);
+
+    const auto column_a = pqp_column_(ColumnID{0}, DataType::Int, false, "a");
+    auto table_scan = std::make_shared<TableScan>(validate, less_than_equals_(column_a, value));
+    table_scan->execute();
+
+    auto delete_op = std::make_shared<Delete>(table_scan);
+    delete_op->set_transaction_context(transaction_context);
+    delete_op->execute();
+    transaction_context->commit();
+  }
+
+  // To increase the global last commit ID, transactions need to execute read-write operators
+  static void _make_chunks_cold() {
+    for (auto transaction_idx = CommitID{0}; transaction_idx < DeltaMergePlugin::MERGE_THRESHOLD_LAST_COMMIT;
+         ++transaction_idx) {
+      auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+      insert_rows("dummy", {{1}}, transaction_context);
+      transaction_context->commit();
+    }
+  }
+
+  const std::string _table_name{"delta_merge_table"};
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(DeltaMergePluginTest, FinalizesAndEncodesChunks) {
+  _insert({4, 3, 2, 1, 5, 6});
+
+  // The first chunk is full, the second one is still used for insertions
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 1u);
+  const auto chunk = _table->get_chunk(ChunkID{0});
+  EXPECT_FALSE(chunk->is_mutable());
+  EXPECT_EQ(get_segment_encoding_spec(chunk->get_segment(ColumnID{0})).encoding_type, EncodingType::Dictionary);
+  EXPECT_TRUE(chunk->pruning_statistics());
+  EXPECT_TRUE(chunk->individually_sorted_by().empty());
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1})->is_mutable());
+
+  // The second chunk is full, but the values of the Insert might still be written
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  insert_rows(_table_name, {{7}, {8}}, transaction_context);
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 0u);
+
+  transaction_context->commit();
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 1u);
+  const auto sorted_chunk = _table->get_chunk(ChunkID{1});
+  EXPECT_FALSE(sorted_chunk->is_mutable());
+  ASSERT_EQ(sorted_chunk->individually_sorted_by().size(), 1u);
+  EXPECT_EQ(sorted_chunk->individually_sorted_by().front(), SortColumnDefinition(ColumnID{0}, SortMode::Ascending));
+
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 0u);
+}
+
+TEST_F(DeltaMergePluginTest, DoesNotFinalizeChunksOfInsertsBeingLogged) {
+  _insert({1, 2, 3});
+
+  // The group commit delay holds back the record until the RedoLog is destroyed
+  const auto directory = std::filesystem::path{test_data_path + "delta_merge_plugin_test"};
+  Hyrise::get().redo_log = std::make_shared<RedoLog>(directory, std::chrono::hours{1});
+
+  auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  insert_rows(_table_name, {{4}}, transaction_context);
+  auto committed = std::promise<void>{};
+  transaction_context->commit_async([&committed](TransactionID) { committed.set_value(); });
+
+  // The begin_cids are set, but the transaction is not visible until its record is durable. Concurrently committing
+  // Inserts might still log the values of the chunk, so it must not be encoded yet.
+  EXPECT_NE(_table->get_chunk(ChunkID{0})->mvcc_data()->get_begin_cid(ChunkOffset{3}), MvccData::MAX_COMMIT_ID);
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 0u);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->is_mutable());
+
+  // Destroying the RedoLog flushes the pending record
+  Hyrise::get().redo_log = nullptr;
+  committed.get_future().wait();
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 1u);
+  EXPECT_EQ(visible_row_count(_table_name), 4u);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST_F(DeltaMergePluginTest, MergesChunksWithManyInvalidatedRows) {
+  _insert({4, 3, 2, 1, 5, 6, 7, 8});
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 2u);
+  _delete_values_less_than_or_equal_to(2);
+
+  // The chunks have been modified recently
+  EXPECT_TRUE(_merge_candidates(_table).empty());
+
+  // Only the first chunk has invalidated rows
+  _make_chunks_cold();
+  const auto chunk_ids = _merge_candidates(_table);
+  EXPECT_EQ(chunk_ids, std::vector<ChunkID>{ChunkID{0}});
+
+  auto plugin = DeltaMergePlugin{};
+  auto old_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_TRUE(_try_merge(_table_name, chunk_ids, ColumnID{0}));
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0})->get_cleanup_commit_id());
+  EXPECT_EQ(visible_row_count(_table_name), 6u);
+
+  // The valid rows are sorted and reinserted into a fresh chunk, which is followed by an empty one
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 8u), 3);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 9u), 4);
+  EXPECT_EQ(_table->get_chunk(ChunkID{3})->size(), 0u);
+
+  EXPECT_EQ(_finalize_chunks(_table, ColumnID{0}), 1u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{2})->individually_sorted_by().size(), 1u);
+
+  // The merged chunk is still visible to the old transaction
+  _queue_physical_delete(plugin, _table, ChunkID{0});
+  _delete_chunks_physically(plugin);
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0}));
+
+  old_transaction_context = nullptr;
+  _delete_chunks_physically(plugin);
+  EXPECT_FALSE(_table->get_chunk(ChunkID{0}));
+  EXPECT_EQ(visible_row_count(_table_name), 6u);
+}
+
+TEST_F(DeltaMergePluginTest, MergesChunksWithFewValidRows) {
+  _insert({2}, InsertChunkAllocation::FreshChunks);
+  EXPECT_EQ(_finalize_chunks(_table, std::nullopt), 1u);
+
+  // Merging a single chunk with few valid rows does not pay off
+  _make_chunks_cold();
+  EXPECT_TRUE(_merge_candidates(_table).empty());
+
+  _insert({1}, InsertChunkAllocation::FreshChunks);
+  EXPECT_EQ(_finalize_chunks(_table, std::nullopt), 1u);
+  _make_chunks_cold();
+  const auto chunk_ids = _merge_candidates(_table);
+  EXPECT_EQ(chunk_ids, std::vector<ChunkID>({ChunkID{0}, ChunkID{1}}));
+
+  // Without a sort column, the rows keep their order
+  EXPECT_TRUE(_try_merge(_table_name, chunk_ids, std::nullopt));
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{2})->size(), 2u);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 2u), 2);
+  EXPECT_EQ(_table->get_value<int32_t>(ColumnID{0}, 3u), 1);
+  EXPECT_EQ(visible_row_count(_table_name), 2u);
+}
+
+TEST_F(DeltaMergePluginTest, SortColumnsSetting) {
+  auto setting = DeltaMergeSortColumnsSetting{};
+  EXPECT_EQ(setting.get(), "");
+  EXPECT_FALSE(setting.sort_column_name("table_a"));
+
+  setting.set("table_a.column_a,table_b.column_b");
+  EXPECT_EQ(setting.sort_column_name("table_a"), "column_a");
+  EXPECT_EQ(setting.sort_column_name("table_b"), "column_b");
+  EXPECT_FALSE(setting.sort_column_name("table_c"));
+
+  EXPECT_THROW(setting.set("table_a"), std::logic_error);
+  EXPECT_THROW(setting.set("table_a.column_a,"), std::logic_error);
+  EXPECT_THROW(setting.set(".column_a"), std::logic_error);
+  EXPECT_EQ(setting.get(), "table_a.column_a,table_b.column_b");
+}
+
+}  // namespace opossum
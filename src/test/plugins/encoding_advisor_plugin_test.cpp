@@ -0,0 +1,181 @@
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "../../plugins/encoding_advisor_plugin.hpp"
+#include "hyrise.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class EncodingAdvisorPluginTest : public BaseTest {
+ public:
+  void SetUp() override {
+    // Two immutable chunks and a mutable one
+    _table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, true}}, TableType::Data,
+        ChunkOffset{1'000}, UseMvcc::Yes);
+    for (auto row = int32_t{0}; row < 2'500; ++row) {
+      const auto value = pmr_string{"v" + std::to_string(row % 7)};
+      _table->append({row, row % 10 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{value}});
+    }
+    Hyrise::get().storage_manager.add_table("table_a", _table);
+  }
+
+  void TearDown() override { Hyrise::reset(); }
+
+ protected:
+  static size_t _advise(EncodingAdvisorPlugin& plugin, const std::optional<size_t>& memory_budget) {
+    return plugin._advise(memory_budget);
+  }
+
+  EncodingType _encoding_type(const ChunkID chunk_id, const ColumnID column_id) const {
+    return get_segment_encoding_spec(_table->get_chunk(chunk_id)->get_segment(column_id)).encoding_type;
+  }
+
+  size_t _memory_usage() const {
+    auto memory_usage = size_t{0};
+    for (const auto chunk_id : {ChunkID{0}, ChunkID{1}}) {
+      memory_usage += _table->get_chunk(chunk_id)->memory_usage(MemoryUsageCalculationMode::Sampled);
+    }
+    return memory_usage;
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(EncodingAdvisorPluginTest, CompressesUnaccessedSegments) {
+  auto plugin = EncodingAdvisorPlugin{};
+  const auto memory_usage = _memory_usage();
+
+  EXPECT_EQ(_advise(plugin, std::nullopt), 4u);
+  EXPECT_LT(_memory_usage(), memory_usage);
+
+  for (const auto chunk_id : {ChunkID{0}, ChunkID{1}}) {
+    for (const auto column_id : {ColumnID{0}, ColumnID{1}}) {
+      EXPECT_NE(_encoding_type(chunk_id, column_id), EncodingType::Unencoded);
+
+      // Reading the sample is not counted as accesses
+      const auto& access_counter = _table->get_chunk(chunk_id)->get_segment(column_id)->access_counter;
+      EXPECT_EQ(access_counter, SegmentAccessCounter{});
+    }
+  }
+
+  // The mutable chunk is not re-encoded
+  EXPECT_EQ(_encoding_type(ChunkID{2}, ColumnID{0}), EncodingType::Unencoded);
+
+  const auto decisions = plugin.decisions();
+  ASSERT_EQ(decisions.size(), 4u);
+  EXPECT_EQ(decisions[0].table_name, "table_a");
+  EXPECT_EQ(decisions[0].chunk_id, ChunkID{0});
+  EXPECT_EQ(decisions[0].column_name, "a");
+  EXPECT_EQ(decisions[0].previous_encoding_type, EncodingType::Unencoded);
+  EXPECT_EQ(decisions[0].encoding_type, _encoding_type(ChunkID{0}, ColumnID{0}));
+
+  // A second run keeps the encodings
+  EXPECT_EQ(_advise(plugin, std::nullopt), 0u);
+}
+
+TEST_F(EncodingAdvisorPluginTest, PrefersFastEncodingsForAccessedSegments) {
+  ChunkEncoder::encode_chunks(_table, {ChunkID{0}, ChunkID{1}}, SegmentEncodingSpec{EncodingType::LZ4});
+  const auto segment = _table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+  segment->access_counter[SegmentAccessCounter::AccessType::Random] = 1'000'000;
+
+  auto plugin = EncodingAdvisorPlugin{};
+  _advise(plugin, std::numeric_limits<size_t>::max());
+
+  // Unencoded segments are the cheapest to access, all others are not accessed and should be as small as possible
+  EXPECT_EQ(_encoding_type(ChunkID{0}, ColumnID{0}), EncodingType::Unencoded);
+  EXPECT_NE(_encoding_type(ChunkID{1}, ColumnID{0}), EncodingType::Unencoded);
+  EXPECT_EQ(_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})->access_counter, segment->access_counter);
+
+  const auto decisions = plugin.decisions();
+  ASSERT_EQ(decisions.size(), 4u);
+  EXPECT_EQ(decisions[0].previous_encoding_type, EncodingType::LZ4);
+  EXPECT_EQ(decisions[0].random_accesses, 1'000'000u);
+  EXPECT_DOUBLE_EQ(decisions[0].estimated_access_cost,
+                   1'000'000 * EncodingAdvisorPlugin::access_costs(EncodingType::Unencoded).random);
+}
+
+TEST_F(EncodingAdvisorPluginTest, RespectsMemoryBudget) {
+  for (const auto column_id : {ColumnID{0}, ColumnID{1}}) {
+    _table->get_chunk(ChunkID{0})->get_segment(column_id)->access_counter[SegmentAccessCounter::AccessType::Random] =
+        1'000'000;
+  }
+
+  // Without a budget, every segment gets its smallest encoding, even though it is accessed
+  auto plugin = EncodingAdvisorPlugin{};
+  _advise(plugin, size_t{0});
+  auto minimum_memory_usage = size_t{0};
+  for (const auto& decision : plugin.decisions()) {
+    EXPECT_NE(decision.encoding_type, EncodingType::Unencoded);
+    minimum_memory_usage += decision.estimated_size;
+  }
+
+  // With some more memory, the accessed segments can be upgraded
+  const auto memory_budget = minimum_memory_usage + 8'000;
+  _advise(plugin, memory_budget);
+  auto estimated_memory_usage = size_t{0};
+  for (const auto& decision : plugin.decisions()) {
+    estimated_memory_usage += decision.estimated_size;
+  }
+  EXPECT_GT(estimated_memory_usage, minimum_memory_usage);
+  EXPECT_LE(estimated_memory_usage, memory_budget);
+}
+
+TEST_F(EncodingAdvisorPluginTest, EncodesValuesOutsideOfTheSample) {
+  // The values at offsets 600 and 601 are not part of the sample, which suggests a small value range
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Long, false}}, TableType::Data,
+                                             ChunkOffset{5'000}, UseMvcc::Yes);
+  for (auto row = int64_t{0}; row < 5'000; ++row) {
+    if (row == 600 || row == 601) {
+      table->append({row == 600 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max()});
+      continue;
+    }
+    table->append({row});
+  }
+  table->get_chunk(ChunkID{0})->finalize();
+  Hyrise::get().storage_manager.add_table("table_b", table);
+
+  auto plugin = EncodingAdvisorPlugin{};
+  EXPECT_NO_THROW(_advise(plugin, std::nullopt));
+
+  const auto segment = table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+  EXPECT_NE(get_segment_encoding_spec(segment).encoding_type, EncodingType::Unencoded);
+  EXPECT_EQ((*segment)[ChunkOffset{599}], AllTypeVariant{int64_t{599}});
+  EXPECT_EQ((*segment)[ChunkOffset{600}], AllTypeVariant{std::numeric_limits<int64_t>::min()});
+  EXPECT_EQ((*segment)[ChunkOffset{601}], AllTypeVariant{std::numeric_limits<int64_t>::max()});
+  EXPECT_EQ((*segment)[ChunkOffset{4'999}], AllTypeVariant{int64_t{4'999}});
+}
+
+TEST_F(EncodingAdvisorPluginTest, MetaTableAndSetting) {
+  auto plugin = EncodingAdvisorPlugin{};
+  plugin.start();
+
+  auto& meta_table_manager = Hyrise::get().meta_table_manager;
+  ASSERT_TRUE(meta_table_manager.has_table("meta_encoding_advisor"));
+  EXPECT_EQ(meta_table_manager.generate_table("meta_encoding_advisor")->row_count(), 0u);
+
+  const auto setting = Hyrise::get().settings_manager.get_setting("EncodingAdvisorPlugin.memory_budget");
+  EXPECT_EQ(setting->get(), "");
+  EXPECT_THROW(setting->set("1 GB"), std::logic_error);
+  setting->set("1000000");
+  EXPECT_EQ(std::static_pointer_cast<EncodingAdvisorMemoryBudgetSetting>(setting)->memory_budget(), 1'000'000u);
+
+  _advise(plugin, std::nullopt);
+  const auto meta_table = meta_table_manager.generate_table("meta_encoding_advisor");
+  EXPECT_EQ(meta_table->row_count(), 4u);
+  EXPECT_EQ(meta_table->get_value<pmr_string>(ColumnID{0}, 0), pmr_string{"table_a"});
+  EXPECT_EQ(meta_table->get_value<pmr_string>(ColumnID{4}, 0), pmr_string{"Unencoded"});
+
+  plugin.stop();
+  EXPECT_FALSE(meta_table_manager.has_table("meta_encoding_advisor"));
+  EXPECT_FALSE(Hyrise::get().settings_manager.has_setting("EncodingAdvisorPlugin.memory_budget"));
+}
+
+}  // namespace opossum
@@ -65,8 +65,9 @@ class MvccDeletePluginTest : public BaseTest {
                                   std::shared_ptr<TransactionContext> transaction_context) {
     return MvccDeletePlugin::_try_logical_delete(table_name, chunk_id, transaction_context);
   }
-  static void _delete_chunk_physically(const std::string& table_name, ChunkID chunk_id) {
-    MvccDeletePlugin::_delete_chunk_physically(Hyrise::get().storage_manager.get_table(table_name), chunk_id);
+  static void _delete_chunk_physically(MvccDeletePlugin& plugin, const std::string& table_name, ChunkID chunk_id) {
+    plugin._chunk_rewriter.queue_physical_delete(Hyrise::get().storage_manager.get_table(table_name), {chunk_id});
+    plugin._chunk_rewriter.delete_chunks_physically();
   }
 
   static int _get_int_value_from_table(const std::shared_ptr<const Table>& table, const ChunkID chunk_id,
@@ -203,7 +204,8 @@ TEST_F(MvccDeletePluginTest, PhysicalDelete) {
   EXPECT_TRUE(table->get_chunk(ChunkID{0})->get_cleanup_commit_id());
 
   // --- run physical delete
-  _delete_chunk_physically(_table_name, chunk_to_delete_id);
+  auto plugin = MvccDeletePlugin{};
+  _delete_chunk_physically(plugin, _table_name, chunk_to_delete_id);
 
   // --- check post-conditions
   EXPECT_TRUE(table->get_chunk(chunk_to_delete_id) == nullptr);